@@ -77,11 +77,18 @@
 	if ((AI::frame_counter & ((1 << (4 - _settings_game.difficulty.competitor_speed)) - 1)) != 0) return;
 
 	Backup<CompanyID> cur_company(_current_company, FILE_LINE);
+	/* Opcodes one AI leaves unused, e.g. because it is sleeping or waiting
+	 * for a command result, are handed to the next AI in line instead of
+	 * being thrown away, so busy AIs are throttled less while the others
+	 * are idle. The surplus only depends on the deterministic execution of
+	 * the scripts themselves, so every network client computes the same
+	 * budgets. */
+	SQInteger surplus = 0;
 	for (const Company *c : Company::Iterate()) {
 		if (c->is_ai) {
 			PerformanceMeasurer framerate((PerformanceElement)(PFE_AI0 + c->index));
 			cur_company.Change(c->index);
-			c->ai_instance->GameLoop();
+			surplus = c->ai_instance->GameLoop(_settings_game.script.script_max_opcode_till_suspend + surplus);
 			/* Occasionally collect garbage; every 255 ticks do one company.
 			 * Effectively collecting garbage once every two months per AI. */
 			if ((AI::frame_counter & 255) == 0 && (CompanyID)GB(AI::frame_counter, 8, 4) == c->index) {
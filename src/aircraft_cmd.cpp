@@ -1804,28 +1804,16 @@ static bool AirportMove(Aircraft *v, const AirportFTAClass *apc)
 
 	v->previous_pos = v->pos; // save previous location
 
-	/* there is only one choice to move to */
-	if (current->next == nullptr) {
-		if (AirportSetBlocks(v, current, apc)) {
-			v->pos = current->next_position;
+	/* take the precomputed choice for our heading */
+	const AirportFTA *transition = apc->GetTransition(v->pos, v->state);
+	if (transition != nullptr) {
+		if (AirportSetBlocks(v, transition, apc)) {
+			v->pos = transition->next_position;
 			UpdateAircraftCache(v);
 		} // move to next position
 		return false;
 	}
 
-	/* there are more choices to choose from, choose the one that
-	 * matches our heading */
-	do {
-		if (v->state == current->heading || current->heading == TO_ALL) {
-			if (AirportSetBlocks(v, current, apc)) {
-				v->pos = current->next_position;
-				UpdateAircraftCache(v);
-			} // move to next position
-			return false;
-		}
-		current = current->next;
-	} while (current != nullptr);
-
 	Debug(misc, 0, "[Ap] cannot move further on Airport! (pos {} state {}) for vehicle {}", v->pos, v->state, v->index);
 	NOT_REACHED();
 }
@@ -67,6 +67,7 @@ AIRPORT_GENERIC(dummy, nullptr, 0, AirportFTAClass::ALL, 0)
 
 static uint16 AirportGetNofElements(const AirportFTAbuildup *apFA);
 static AirportFTA *AirportBuildAutomata(uint nofelements, const AirportFTAbuildup *apFA);
+static const AirportFTA **AirportBuildTransitionTable(uint nofelements, const AirportFTA *layout);
 
 
 /**
@@ -127,6 +128,7 @@ AirportFTAClass::AirportFTAClass(
 {
 	/* Build the state machine itself */
 	this->layout = AirportBuildAutomata(this->nofelements, apFA);
+	this->transitions = AirportBuildTransitionTable(this->nofelements, this->layout);
 }
 
 AirportFTAClass::~AirportFTAClass()
@@ -140,6 +142,7 @@ AirportFTAClass::~AirportFTAClass()
 		}
 	}
 	free(layout);
+	free(transitions);
 }
 
 /**
@@ -199,6 +202,34 @@ static AirportFTA *AirportBuildAutomata(uint nofelements, const AirportFTAbuildu
 	return FAutomata;
 }
 
+/**
+ * Compile the per heading transition lookup table of an airport state automata.
+ * AirportMove() takes the only choice of a position unconditionally and
+ * otherwise picks the first choice that matches the aircraft's heading or goes
+ * everywhere; precompute that choice for every heading so the per tick
+ * movement code does not have to scan the choice lists.
+ * @param nofelements The number of elements in the FTA.
+ * @param layout The constructed FTA.
+ * @return Table of nofelements * (MAX_HEADINGS + 1) precomputed transitions.
+ */
+static const AirportFTA **AirportBuildTransitionTable(uint nofelements, const AirportFTA *layout)
+{
+	const AirportFTA **table = MallocT<const AirportFTA *>(nofelements * (MAX_HEADINGS + 1));
+
+	for (uint i = 0; i < nofelements; i++) {
+		for (uint heading = 0; heading <= MAX_HEADINGS; heading++) {
+			const AirportFTA *choice = &layout[i];
+			if (choice->next != nullptr) {
+				while (choice != nullptr && choice->heading != heading && choice->heading != TO_ALL) {
+					choice = choice->next;
+				}
+			}
+			table[i * (MAX_HEADINGS + 1) + heading] = choice;
+		}
+	}
+	return table;
+}
+
 /**
  * Get the finite state machine of an airport type.
  * @param airport_type %Airport type to query FTA from. @see AirportTypes
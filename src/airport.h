@@ -173,8 +173,22 @@ public:
 		return &moving_data[position];
 	}
 
+	/**
+	 * Get the transition to take from a position for a heading.
+	 * @param position Element number the aircraft is at.
+	 * @param heading Heading the aircraft is going for.
+	 * @return The transition to take, or \c nullptr if the FTA has none for this heading.
+	 */
+	const struct AirportFTA *GetTransition(byte position, byte heading) const
+	{
+		assert(position < nofelements);
+		assert(heading <= MAX_HEADINGS);
+		return transitions[position * (MAX_HEADINGS + 1) + heading];
+	}
+
 	const AirportMovingData *moving_data; ///< Movement data.
 	struct AirportFTA *layout;            ///< state machine for airport
+	const struct AirportFTA **transitions; ///< transition per (position, heading), precomputed from #layout
 	const byte *terminals;                ///< %Array with the number of terminal groups, followed by the number of terminals in each group.
 	const byte num_helipads;              ///< Number of helipads on this airport. When 0 helicopters will go to normal terminals.
 	Flags flags;                          ///< Flags for this airport type.
@@ -10,6 +10,7 @@
 #include "stdafx.h"
 #include "core/alloc_func.hpp"
 #include "core/smallvec_type.hpp"
+#include "date_func.h"
 #include "tile_cmd.h"
 #include "viewport_func.h"
 #include "framerate_type.h"
@@ -19,6 +20,27 @@
 /** The table/list with animated tiles. */
 std::vector<TileIndex> _animated_tiles;
 
+/**
+ * NOSAVE: Animation speed per animated tile, aligned with #_animated_tiles.
+ * A tile with speed \c s only changes frames when <tt>_tick_counter %
+ * (1 << s) == 0</tt>, so the animation loop does not have to call its
+ * animation proc on the other ticks. 0 means "call the proc every tick";
+ * that is also the safe default for tiles whose speed is not known (yet),
+ * e.g. because the NewGRF determines it with a callback.
+ */
+static std::vector<uint8> _animated_tile_speeds;
+
+/** The index of the tile #AnimateAnimatedTiles is currently animating. */
+static size_t _current_animated_tile;
+
+/** Realign the speed table with the tile table, e.g. after loading a game. */
+static void SyncAnimatedTileSpeeds()
+{
+	if (_animated_tile_speeds.size() != _animated_tiles.size()) {
+		_animated_tile_speeds.assign(_animated_tiles.size(), 0);
+	}
+}
+
 /**
  * Removes the given tile from the animated tile table.
  * @param tile the tile to remove
@@ -27,7 +49,9 @@ void DeleteAnimatedTile(TileIndex tile)
 {
 	auto to_remove = std::find(_animated_tiles.begin(), _animated_tiles.end(), tile);
 	if (to_remove != _animated_tiles.end()) {
+		SyncAnimatedTileSpeeds();
 		/* The order of the remaining elements must stay the same, otherwise the animation loop may miss a tile. */
+		_animated_tile_speeds.erase(_animated_tile_speeds.begin() + (to_remove - _animated_tiles.begin()));
 		_animated_tiles.erase(to_remove);
 		MarkTileDirtyByTile(tile);
 	}
@@ -41,7 +65,27 @@ void DeleteAnimatedTile(TileIndex tile)
 void AddAnimatedTile(TileIndex tile)
 {
 	MarkTileDirtyByTile(tile);
-	include(_animated_tiles, tile);
+	SyncAnimatedTileSpeeds();
+	if (std::find(_animated_tiles.begin(), _animated_tiles.end(), tile) == _animated_tiles.end()) {
+		_animated_tiles.push_back(tile);
+		_animated_tile_speeds.push_back(0);
+	}
+}
+
+/**
+ * Set the animation speed of an animated tile, so that the animation loop can
+ * skip the tile on the ticks its frame cannot change anyway.
+ * Only has an effect on the tile currently being animated: the animation procs
+ * call this while they determine the speed, and anywhere else the list index
+ * of the tile is not known.
+ * @param tile the animated tile
+ * @param speed the tile's animation speed
+ */
+void SetAnimatedTileSpeed(TileIndex tile, uint8 speed)
+{
+	if (_current_animated_tile < _animated_tiles.size() && _animated_tiles[_current_animated_tile] == tile) {
+		_animated_tile_speeds[_current_animated_tile] = speed;
+	}
 }
 
 /**
@@ -51,10 +95,16 @@ void AnimateAnimatedTiles()
 {
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
 
-	const TileIndex *ti = _animated_tiles.data();
-	while (ti < _animated_tiles.data() + _animated_tiles.size()) {
-		const TileIndex curr = *ti;
-		AnimateTile(curr);
+	SyncAnimatedTileSpeeds();
+
+	for (_current_animated_tile = 0; _current_animated_tile < _animated_tiles.size();) {
+		const TileIndex curr = _animated_tiles[_current_animated_tile];
+		/* Skipping a tile here matches the early-out its animation proc would
+		 * do itself; tiles with an unknown speed have speed 0 and get called
+		 * every tick. */
+		if (_tick_counter % (1ULL << _animated_tile_speeds[_current_animated_tile]) == 0) {
+			AnimateTile(curr);
+		}
 		/* During the AnimateTile call, DeleteAnimatedTile could have been called,
 		 * deleting an element we've already processed and pushing the rest one
 		 * slot to the left. We can detect this by checking whether the index
@@ -64,7 +114,7 @@ void AnimateAnimatedTiles()
 		 *       deleted during the same AnimateTile call, but no code seems to
 		 *       be doing this anyway.
 		 */
-		if (*ti == curr) ++ti;
+		if (_current_animated_tile < _animated_tiles.size() && _animated_tiles[_current_animated_tile] == curr) ++_current_animated_tile;
 	}
 }
 
@@ -74,4 +124,6 @@ void AnimateAnimatedTiles()
 void InitializeAnimatedTiles()
 {
 	_animated_tiles.clear();
+	_animated_tile_speeds.clear();
+	_current_animated_tile = 0;
 }
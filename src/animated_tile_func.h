@@ -14,6 +14,7 @@
 
 void AddAnimatedTile(TileIndex tile);
 void DeleteAnimatedTile(TileIndex tile);
+void SetAnimatedTileSpeed(TileIndex tile, uint8 speed);
 void AnimateAnimatedTiles();
 void InitializeAnimatedTiles();
 
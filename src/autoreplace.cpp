@@ -14,12 +14,33 @@
 #include "core/bitmath_func.hpp"
 #include "core/pool_func.hpp"
 
+#include <map>
+
 #include "safeguards.h"
 
 /** The pool of autoreplace "orders". */
 EngineRenewPool _enginerenew_pool("EngineRenew");
 INSTANTIATE_POOL_METHODS(EngineRenew)
 
+/**
+ * Cached results of replacement lookups. Each lookup walks the replacement
+ * list with a group hierarchy check per entry, and the same lookups are
+ * repeated for every vehicle that visits a depot. The cached engine and
+ * "replace when old" flag are keyed on the replacement list, the engine and
+ * the group; the cache is flushed whenever the replacement rules or the
+ * group hierarchy change.
+ */
+static std::map<std::tuple<EngineRenewList, EngineID, GroupID>, std::pair<EngineID, bool>> _replacement_cache;
+
+/**
+ * Flush the cached replacement lookups, e.g. because the replacement rules
+ * or the group hierarchy changed.
+ */
+void InvalidateEngineReplacementCache()
+{
+	_replacement_cache.clear();
+}
+
 /**
  * Retrieves the EngineRenew that specifies the replacement of the given
  * engine type from the given renewlist
@@ -51,6 +72,7 @@ void RemoveAllEngineReplacement(EngineRenewList *erl)
 		er = next;
 	}
 	*erl = nullptr; // Empty list
+	InvalidateEngineReplacementCache();
 }
 
 /**
@@ -64,13 +86,17 @@ void RemoveAllEngineReplacement(EngineRenewList *erl)
  */
 EngineID EngineReplacement(EngineRenewList erl, EngineID engine, GroupID group, bool *replace_when_old)
 {
-	const EngineRenew *er = GetEngineReplacement(erl, engine, group);
-	if (er == nullptr && (group == DEFAULT_GROUP || (Group::IsValidID(group) && !HasBit(Group::Get(group)->flags, GroupFlags::GF_REPLACE_PROTECTION)))) {
-		/* We didn't find anything useful in the vehicle's own group so we will try ALL_GROUP */
-		er = GetEngineReplacement(erl, engine, ALL_GROUP);
+	auto [it, inserted] = _replacement_cache.emplace(std::piecewise_construct, std::forward_as_tuple(erl, engine, group), std::forward_as_tuple());
+	if (inserted) {
+		const EngineRenew *er = GetEngineReplacement(erl, engine, group);
+		if (er == nullptr && (group == DEFAULT_GROUP || (Group::IsValidID(group) && !HasBit(Group::Get(group)->flags, GroupFlags::GF_REPLACE_PROTECTION)))) {
+			/* We didn't find anything useful in the vehicle's own group so we will try ALL_GROUP */
+			er = GetEngineReplacement(erl, engine, ALL_GROUP);
+		}
+		it->second = er == nullptr ? std::make_pair(INVALID_ENGINE, false) : std::make_pair(er->to, er->replace_when_old);
 	}
-	if (replace_when_old != nullptr) *replace_when_old = er == nullptr ? false : er->replace_when_old;
-	return er == nullptr ? INVALID_ENGINE : er->to;
+	if (replace_when_old != nullptr) *replace_when_old = it->second.second;
+	return it->second.first;
 }
 
 /**
@@ -91,6 +117,7 @@ CommandCost AddEngineReplacement(EngineRenewList *erl, EngineID old_engine, Engi
 		if (flags & DC_EXEC) {
 			er->to = new_engine;
 			er->replace_when_old = replace_when_old;
+			InvalidateEngineReplacementCache();
 		}
 		return CommandCost();
 	}
@@ -105,6 +132,7 @@ CommandCost AddEngineReplacement(EngineRenewList *erl, EngineID old_engine, Engi
 		/* Insert before the first element */
 		er->next = (EngineRenew *)(*erl);
 		*erl = (EngineRenewList)er;
+		InvalidateEngineReplacementCache();
 	}
 
 	return CommandCost();
@@ -134,6 +162,7 @@ CommandCost RemoveEngineReplacement(EngineRenewList *erl, EngineID engine, Group
 					prev->next = er->next;
 				}
 				delete er;
+				InvalidateEngineReplacementCache();
 			}
 			return CommandCost();
 		}
@@ -22,6 +22,7 @@ static FBlitter_32bppAnim iFBlitter_32bppAnim;
 Blitter_32bppAnim::~Blitter_32bppAnim()
 {
 	free(this->anim_alloc);
+	free(this->anim_spans);
 }
 
 template <BlitterMode mode>
@@ -259,6 +260,9 @@ void Blitter_32bppAnim::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomL
 		return;
 	}
 
+	/* The blit may write palette-animated pixels anywhere in its rectangle. */
+	this->ExtendAnimSpans(bp->dst, bp->left, bp->top, bp->width, bp->height);
+
 	switch (mode) {
 		default: NOT_REACHED();
 		case BM_NORMAL:       Draw<BM_NORMAL>      (bp, zoom); return;
@@ -269,6 +273,29 @@ void Blitter_32bppAnim::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomL
 	}
 }
 
+void Blitter_32bppAnim::DrawBatch(Blitter::BlitterParams *bp, uint count, BlitterMode mode, ZoomLevel zoom)
+{
+	if (_screen_disable_anim) {
+		/* This means our output is not to the screen, so we can't be doing any animation stuff, so use our parent DrawBatch() */
+		Blitter_32bppOptimized::DrawBatch(bp, count, mode, zoom);
+		return;
+	}
+
+	/* The blits may write palette-animated pixels anywhere in their rectangles. */
+	for (uint i = 0; i < count; i++) {
+		this->ExtendAnimSpans(bp[i].dst, bp[i].left, bp[i].top, bp[i].width, bp[i].height);
+	}
+
+	switch (mode) {
+		default: NOT_REACHED();
+		case BM_NORMAL:       for (uint i = 0; i < count; i++) Draw<BM_NORMAL>      (&bp[i], zoom); return;
+		case BM_COLOUR_REMAP: for (uint i = 0; i < count; i++) Draw<BM_COLOUR_REMAP>(&bp[i], zoom); return;
+		case BM_TRANSPARENT:  for (uint i = 0; i < count; i++) Draw<BM_TRANSPARENT> (&bp[i], zoom); return;
+		case BM_CRASH_REMAP:  for (uint i = 0; i < count; i++) Draw<BM_CRASH_REMAP> (&bp[i], zoom); return;
+		case BM_BLACK_REMAP:  for (uint i = 0; i < count; i++) Draw<BM_BLACK_REMAP> (&bp[i], zoom); return;
+	}
+}
+
 void Blitter_32bppAnim::DrawColourMappingRect(void *dst, int width, int height, PaletteID pal)
 {
 	if (_screen_disable_anim) {
@@ -318,6 +345,7 @@ void Blitter_32bppAnim::SetPixel(void *video, int x, int y, uint8 colour)
 	if (_screen_disable_anim) return;
 
 	this->anim_buf[this->ScreenToAnimOffset((uint32 *)video) + x + y * this->anim_buf_pitch] = colour | (DEFAULT_BRIGHTNESS << 8);
+	if (colour >= PALETTE_ANIM_START) this->ExtendAnimSpans(video, x, y, 1, 1);
 }
 
 void Blitter_32bppAnim::DrawLine(void *video, int x, int y, int x2, int y2, int screen_width, int screen_height, uint8 colour, int width, int dash)
@@ -329,6 +357,17 @@ void Blitter_32bppAnim::DrawLine(void *video, int x, int y, int x2, int y2, int
 			*((Colour *)video + x + y * _screen.pitch) = c;
 		});
 	} else {
+		if (colour >= PALETTE_ANIM_START) {
+			/* Cover the bounding box of the line, including its width. */
+			int span_left   = Clamp(std::min(x, x2) - width, 0, screen_width);
+			int span_right  = Clamp(std::max(x, x2) + width + 1, 0, screen_width);
+			int span_top    = Clamp(std::min(y, y2) - width, 0, screen_height);
+			int span_bottom = Clamp(std::max(y, y2) + width + 1, 0, screen_height);
+			if (span_left < span_right && span_top < span_bottom) {
+				this->ExtendAnimSpans(video, span_left, span_top, span_right - span_left, span_bottom - span_top);
+			}
+		}
+
 		uint16 * const offset_anim_buf = this->anim_buf + this->ScreenToAnimOffset((uint32 *)video);
 		const uint16 anim_colour = colour | (DEFAULT_BRIGHTNESS << 8);
 		this->DrawLineGeneric(x, y, x2, y2, screen_width, screen_height, width, dash, [&](int x, int y) {
@@ -349,6 +388,8 @@ void Blitter_32bppAnim::DrawRect(void *video, int width, int height, uint8 colou
 	Colour colour32 = LookupColourInPalette(colour);
 	uint16 *anim_line = this->ScreenToAnimOffset((uint32 *)video) + this->anim_buf;
 
+	if (colour >= PALETTE_ANIM_START) this->ExtendAnimSpans(video, 0, 0, width, height);
+
 	do {
 		Colour *dst = (Colour *)video;
 		uint16 *anim = anim_line;
@@ -373,6 +414,9 @@ void Blitter_32bppAnim::CopyFromBuffer(void *video, const void *src, int width,
 	const uint32 *usrc = (const uint32 *)src;
 	uint16 *anim_line = this->ScreenToAnimOffset((uint32 *)video) + this->anim_buf;
 
+	/* The copied-back buffer may contain palette-animated pixels. */
+	this->ExtendAnimSpans(video, 0, 0, width, height);
+
 	for (; height > 0; height--) {
 		/* We need to keep those for palette animation. */
 		Colour *dst_pal = dst;
@@ -433,6 +477,23 @@ void Blitter_32bppAnim::ScrollBuffer(void *video, int &left, int &top, int &widt
 	assert(video >= _screen.dst_ptr && video <= (uint32 *)_screen.dst_ptr + _screen.width + _screen.height * _screen.pitch);
 	uint16 *dst, *src;
 
+	/* Move the animated-pixel spans of the scrolled rows along. The old span of
+	 * a destination row is merged in rather than replaced: the spans only have
+	 * to stay a superset of the animated pixels, and PaletteAnimate() tightens
+	 * them again on the next animation tick. */
+	auto merge_scrolled_span = [&](int dst_y, int src_y) {
+		AnimSpan src_span = this->anim_spans[src_y];
+		if (src_span.start >= src_span.end) return;
+		int start = Clamp(src_span.start + scroll_x, left, left + width);
+		int end   = Clamp(src_span.end   + scroll_x, left, left + width);
+		if (start < end) this->ExtendAnimSpan(dst_y, start, end);
+	};
+	if (scroll_y > 0) {
+		for (int y = top + height - 1; y >= top + scroll_y; y--) merge_scrolled_span(y, y - scroll_y);
+	} else {
+		for (int y = top; y < top + height + scroll_y; y++) merge_scrolled_span(y, y - scroll_y);
+	}
+
 	/* We need to scroll the anim-buffer too */
 	if (scroll_y > 0) {
 		dst = this->anim_buf + left + (top + height - 1) * this->anim_buf_pitch;
@@ -493,26 +554,39 @@ void Blitter_32bppAnim::PaletteAnimate(const Palette &palette)
 	 *  Especially when going between toyland and non-toyland. */
 	assert(this->palette.first_dirty == PALETTE_ANIM_START || this->palette.first_dirty == 0);
 
-	const uint16 *anim = this->anim_buf;
-	Colour *dst = (Colour *)_screen.dst_ptr;
+	/* Only walk the spans that might contain animated pixels; the rest of the
+	 * anim buffer is known to be static. While at it, tighten every span to
+	 * the animated pixels actually found, so spans widened by drawing static
+	 * content are rescanned only once. */
+	for (int y = 0; y < this->anim_buf_height; y++) {
+		AnimSpan &span = this->anim_spans[y];
+		if (span.start >= span.end) continue;
+
+		const uint16 *anim = this->anim_buf + y * this->anim_buf_pitch + span.start;
+		Colour *dst = (Colour *)_screen.dst_ptr + y * _screen.pitch + span.start;
 
-	/* Let's walk the anim buffer and try to find the pixels */
-	const int width = this->anim_buf_width;
-	const int pitch_offset = _screen.pitch - width;
-	const int anim_pitch_offset = this->anim_buf_pitch - width;
-	for (int y = this->anim_buf_height; y != 0 ; y--) {
-		for (int x = width; x != 0 ; x--) {
+		int first = -1;
+		int last = -1;
+		for (int x = span.start; x < span.end; x++) {
 			uint16 value = *anim;
 			uint8 colour = GB(value, 0, 8);
 			if (colour >= PALETTE_ANIM_START) {
 				/* Update this pixel */
 				*dst = this->AdjustBrightness(LookupColourInPalette(colour), GB(value, 8, 8));
+				if (first < 0) first = x;
+				last = x;
 			}
 			dst++;
 			anim++;
 		}
-		dst += pitch_offset;
-		anim += anim_pitch_offset;
+
+		if (first < 0) {
+			span.start = 0;
+			span.end = 0;
+		} else {
+			span.start = first;
+			span.end = last + 1;
+		}
 	}
 
 	/* Make sure the backend redraws the whole screen */
@@ -530,10 +604,13 @@ void Blitter_32bppAnim::PostResize()
 			_screen.pitch != this->anim_buf_pitch) {
 		/* The size of the screen changed; we can assume we can wipe all data from our buffer */
 		free(this->anim_alloc);
+		free(this->anim_spans);
 		this->anim_buf_width = _screen.width;
 		this->anim_buf_height = _screen.height;
 		this->anim_buf_pitch = (_screen.width + 7) & ~7;
 		this->anim_alloc = CallocT<uint16>(this->anim_buf_pitch * this->anim_buf_height + 8);
+		/* All zeroes means all spans are empty, matching the wiped anim buffer. */
+		this->anim_spans = CallocT<AnimSpan>(this->anim_buf_height);
 
 		/* align buffer to next 16 byte boundary */
 		this->anim_buf = reinterpret_cast<uint16 *>((reinterpret_cast<uintptr_t>(this->anim_alloc) + 0xF) & (~0xF));
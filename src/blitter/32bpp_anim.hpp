@@ -15,8 +15,15 @@
 /** The optimised 32 bpp blitter with palette animation. */
 class Blitter_32bppAnim : public Blitter_32bppOptimized {
 protected:
+	/** Horizontal span of a row of the animation buffer that may contain palette-animated pixels. */
+	struct AnimSpan {
+		uint16 start; ///< First x coordinate of the span.
+		uint16 end;   ///< One past the last x coordinate of the span; \c start >= \c end means no animated pixels.
+	};
+
 	uint16 *anim_buf;    ///< In this buffer we keep track of the 8bpp indexes so we can do palette animation
 	void *anim_alloc;    ///< The raw allocated buffer, not necessarily aligned correctly
+	AnimSpan *anim_spans; ///< Per screen row, the span PaletteAnimate() has to rescan; a superset of the animated pixels.
 	int anim_buf_width;  ///< The width of the animation buffer.
 	int anim_buf_height; ///< The height of the animation buffer.
 	int anim_buf_pitch;  ///< The pitch of the animation buffer (width rounded up to 16 byte boundary).
@@ -26,6 +33,7 @@ public:
 	Blitter_32bppAnim() :
 		anim_buf(nullptr),
 		anim_alloc(nullptr),
+		anim_spans(nullptr),
 		anim_buf_width(0),
 		anim_buf_height(0),
 		anim_buf_pitch(0)
@@ -36,6 +44,7 @@ public:
 	~Blitter_32bppAnim();
 
 	void Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom) override;
+	void DrawBatch(Blitter::BlitterParams *bp, uint count, BlitterMode mode, ZoomLevel zoom) override;
 	void DrawColourMappingRect(void *dst, int width, int height, PaletteID pal) override;
 	void SetPixel(void *video, int x, int y, uint8 colour) override;
 	void DrawLine(void *video, int x, int y, int x2, int y2, int screen_width, int screen_height, uint8 colour, int width, int dash) override;
@@ -68,6 +77,44 @@ public:
 		return across + (lines * this->anim_buf_pitch);
 	}
 
+	/**
+	 * Widen the animated-pixel span of a row, so PaletteAnimate() rescans it.
+	 * @param y Row of the animation buffer.
+	 * @param start First x coordinate written to.
+	 * @param end One past the last x coordinate written to.
+	 */
+	inline void ExtendAnimSpan(int y, int start, int end)
+	{
+		AnimSpan &span = this->anim_spans[y];
+		if (span.start >= span.end) {
+			span.start = start;
+			span.end = end;
+		} else {
+			span.start = std::min<int>(span.start, start);
+			span.end = std::max<int>(span.end, end);
+		}
+	}
+
+	/**
+	 * Widen the animated-pixel spans of all rows of a rectangle that may have
+	 * received palette-animated pixels. The spans are tightened again to the
+	 * pixels actually found by the next PaletteAnimate().
+	 * @param video Pointer into the screen buffer to the top-left of the rectangle.
+	 * @param left Left edge of the rectangle, relative to \a video.
+	 * @param top Top edge of the rectangle, relative to \a video.
+	 * @param width Width of the rectangle.
+	 * @param height Height of the rectangle.
+	 */
+	inline void ExtendAnimSpans(const void *video, int left, int top, int width, int height)
+	{
+		int offset = this->ScreenToAnimOffset((const uint32 *)video);
+		int x = offset % this->anim_buf_pitch + left;
+		int y = offset / this->anim_buf_pitch + top;
+		for (int i = 0; i < height; i++) {
+			this->ExtendAnimSpan(y + i, x, x + width);
+		}
+	}
+
 	template <BlitterMode mode> void Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom);
 };
 
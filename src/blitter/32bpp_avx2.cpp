@@ -0,0 +1,239 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file 32bpp_avx2.cpp Implementation of the AVX2 32 bpp blitter. */
+
+#ifdef WITH_SSE
+
+#include "../stdafx.h"
+#include "../zoom_func.h"
+#include "../settings_type.h"
+#include "32bpp_avx2.hpp"
+#include <immintrin.h>
+
+#include "../safeguards.h"
+
+/** Instantiation of the AVX2 32bpp blitter factory. */
+static FBlitter_32bppAVX2 iFBlitter_32bppAVX2;
+
+/* 256 bit analogs of the masks from 32bpp_sse_type.h; in-lane shuffles repeat per 128 bit lane. */
+#define ALPHA_CONTROL_MASK_256 _mm256_setr_epi8( 6,  7,  6,  7,  6,  7, -1, -1, 14, 15, 14, 15, 14, 15, -1, -1, \
+                                                 6,  7,  6,  7,  6,  7, -1, -1, 14, 15, 14, 15, 14, 15, -1, -1)
+#define PACK_LOW_CONTROL_MASK_256 _mm256_setr_epi8( 0,  2,  4,  6,  8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1, \
+                                                    0,  2,  4,  6,  8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1)
+#define TRANSPARENT_NOM_BASE_256 _mm256_set1_epi16(256)
+#define ALPHA_AND_MASK_256 _mm256_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1)
+
+/**
+ * Alpha blend 4 pixels at once; the 256 bit pendant of AlphaBlendTwoPixels().
+ * @param src The 4 source pixels.
+ * @param dst The 4 destination pixels.
+ * @return The 4 blended pixels.
+ */
+GNU_TARGET("avx2")
+static inline __m128i AlphaBlendFourPixels(__m128i src, __m128i dst)
+{
+	__m256i srcABCD = _mm256_cvtepu8_epi16(src); // VPMOVZXBW, expand each uint8 into uint16
+	__m256i dstABCD = _mm256_cvtepu8_epi16(dst);
+
+	__m256i alphaMaskABCD = _mm256_cmpgt_epi16(srcABCD, _mm256_setzero_si256()); // (alpha > 0) ? 0xFFFF : 0
+	__m256i alphaABCD = _mm256_sub_epi16(srcABCD, alphaMaskABCD);                // if (alpha > 0) a++;
+	alphaABCD = _mm256_shuffle_epi8(alphaABCD, ALPHA_CONTROL_MASK_256);          // put alpha in front of each rgb
+
+	srcABCD = _mm256_sub_epi16(srcABCD, dstABCD);     //    (r - Cr)
+	srcABCD = _mm256_mullo_epi16(srcABCD, alphaABCD); // a*(r - Cr)
+	srcABCD = _mm256_srli_epi16(srcABCD, 8);          // a*(r - Cr)/256
+	srcABCD = _mm256_add_epi16(srcABCD, dstABCD);     // a*(r - Cr)/256 + Cr
+
+	alphaMaskABCD = _mm256_and_si256(alphaMaskABCD, ALPHA_AND_MASK_256); // set non alpha fields to 0
+	srcABCD = _mm256_or_si256(srcABCD, alphaMaskABCD);                   // set alpha fields to 0xFFFF if src alpha was > 0
+
+	srcABCD = _mm256_shuffle_epi8(srcABCD, PACK_LOW_CONTROL_MASK_256); // pack 2 pixels in the low half of each lane
+	srcABCD = _mm256_permute4x64_epi64(srcABCD, 0x08);                 // VPERMQ, gather both halves in the low lane
+	return _mm256_castsi256_si128(srcABCD);
+}
+
+/**
+ * Darken 4 pixels at once; the 256 bit pendant of DarkenTwoPixels().
+ * @param src The 4 source pixels.
+ * @param dst The 4 destination pixels.
+ * @return The 4 darkened pixels.
+ */
+GNU_TARGET("avx2")
+static inline __m128i DarkenFourPixels(__m128i src, __m128i dst)
+{
+	__m256i srcABCD = _mm256_cvtepu8_epi16(src);
+	__m256i dstABCD = _mm256_cvtepu8_epi16(dst);
+	__m256i alphaABCD = _mm256_shuffle_epi8(srcABCD, ALPHA_CONTROL_MASK_256);
+	alphaABCD = _mm256_srli_epi16(alphaABCD, 2); // Reduce to 64 levels of shades so the max value fits in 16 bits.
+	__m256i nom = _mm256_sub_epi16(TRANSPARENT_NOM_BASE_256, alphaABCD);
+	dstABCD = _mm256_mullo_epi16(dstABCD, nom);
+	dstABCD = _mm256_srli_epi16(dstABCD, 8);
+	dstABCD = _mm256_shuffle_epi8(dstABCD, PACK_LOW_CONTROL_MASK_256);
+	dstABCD = _mm256_permute4x64_epi64(dstABCD, 0x08);
+	return _mm256_castsi256_si128(dstABCD);
+}
+
+/**
+ * Draws a sprite to a (screen) buffer. It is templated to allow faster operation.
+ * Only the modes that benefit from wider vectors are implemented here; the
+ * remap modes fall back to the SSE4 code path in the dispatcher below.
+ *
+ * @tparam mode blitter mode
+ * @param bp further blitting parameters
+ * @param zoom zoom level at which we are drawing
+ */
+IGNORE_UNINITIALIZED_WARNING_START
+template <BlitterMode mode, Blitter_32bppSSE_Base::ReadMode read_mode, bool translucent>
+GNU_TARGET("avx2")
+inline void Blitter_32bppAVX2::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
+{
+	Colour *dst_line = (Colour *) bp->dst + bp->top * bp->pitch + bp->left;
+	int effective_width = bp->width;
+
+	/* Find where to start reading in the source sprite. */
+	const SpriteData * const sd = (const SpriteData *) bp->sprite;
+	const SpriteInfo * const si = &sd->infos[zoom];
+	const Colour *src_rgba_line = (const Colour *) ((const byte *) &sd->data[si->sprite_offset] + bp->skip_top * si->sprite_line_size);
+
+	if (read_mode != RM_WITH_MARGIN) src_rgba_line += bp->skip_left;
+
+	for (int y = bp->height; y != 0; y--) {
+		Colour *dst = dst_line;
+		const Colour *src = src_rgba_line + META_LENGTH;
+
+		if (read_mode == RM_WITH_MARGIN) {
+			src += src_rgba_line[0].data;
+			dst += src_rgba_line[0].data;
+			const int width_diff = si->sprite_width - bp->width;
+			effective_width = bp->width - (int) src_rgba_line[0].data;
+			const int delta_diff = (int) src_rgba_line[1].data - width_diff;
+			const int new_width = effective_width - delta_diff;
+			effective_width = delta_diff > 0 ? new_width : effective_width;
+			if (effective_width <= 0) goto next_line;
+		}
+
+		switch (mode) {
+			default: {
+				if (!translucent) {
+					for (uint x = (uint) effective_width; x > 0; x--) {
+						if (src->a) *dst = *src;
+						src++;
+						dst++;
+					}
+					break;
+				}
+
+				uint x = (uint) effective_width;
+				while (x >= 8) {
+					/* Blend 8 pixels per iteration as two independent blocks of 4,
+					 * so loads and ALU work of both blocks can overlap. */
+					__m128i srcABCD = _mm_loadu_si128((const __m128i *) src);
+					__m128i dstABCD = _mm_loadu_si128((__m128i *) dst);
+					__m128i srcEFGH = _mm_loadu_si128((const __m128i *) (src + 4));
+					__m128i dstEFGH = _mm_loadu_si128((__m128i *) (dst + 4));
+					_mm_storeu_si128((__m128i *) dst, AlphaBlendFourPixels(srcABCD, dstABCD));
+					_mm_storeu_si128((__m128i *) (dst + 4), AlphaBlendFourPixels(srcEFGH, dstEFGH));
+					src += 8;
+					dst += 8;
+					x -= 8;
+				}
+				if (x >= 4) {
+					__m128i srcABCD = _mm_loadu_si128((const __m128i *) src);
+					__m128i dstABCD = _mm_loadu_si128((__m128i *) dst);
+					_mm_storeu_si128((__m128i *) dst, AlphaBlendFourPixels(srcABCD, dstABCD));
+					src += 4;
+					dst += 4;
+					x -= 4;
+				}
+				while (x > 0) {
+					__m128i srcABCD = _mm_cvtsi32_si128(src->data);
+					__m128i dstABCD = _mm_cvtsi32_si128(dst->data);
+					dst->data = _mm_cvtsi128_si32(AlphaBlendFourPixels(srcABCD, dstABCD));
+					src++;
+					dst++;
+					x--;
+				}
+				break;
+			}
+
+			case BM_TRANSPARENT: {
+				/* Make the current colour a bit more black, so it looks like this image is transparent. */
+				uint x = (uint) bp->width;
+				while (x >= 8) {
+					__m128i srcABCD = _mm_loadu_si128((const __m128i *) src);
+					__m128i dstABCD = _mm_loadu_si128((__m128i *) dst);
+					__m128i srcEFGH = _mm_loadu_si128((const __m128i *) (src + 4));
+					__m128i dstEFGH = _mm_loadu_si128((__m128i *) (dst + 4));
+					_mm_storeu_si128((__m128i *) dst, DarkenFourPixels(srcABCD, dstABCD));
+					_mm_storeu_si128((__m128i *) (dst + 4), DarkenFourPixels(srcEFGH, dstEFGH));
+					src += 8;
+					dst += 8;
+					x -= 8;
+				}
+				if (x >= 4) {
+					__m128i srcABCD = _mm_loadu_si128((const __m128i *) src);
+					__m128i dstABCD = _mm_loadu_si128((__m128i *) dst);
+					_mm_storeu_si128((__m128i *) dst, DarkenFourPixels(srcABCD, dstABCD));
+					src += 4;
+					dst += 4;
+					x -= 4;
+				}
+				while (x > 0) {
+					__m128i srcABCD = _mm_cvtsi32_si128(src->data);
+					__m128i dstABCD = _mm_cvtsi32_si128(dst->data);
+					dst->data = _mm_cvtsi128_si32(DarkenFourPixels(srcABCD, dstABCD));
+					src++;
+					dst++;
+					x--;
+				}
+				break;
+			}
+		}
+
+next_line:
+		src_rgba_line = (const Colour *) ((const byte *) src_rgba_line + si->sprite_line_size);
+		dst_line += bp->pitch;
+	}
+}
+IGNORE_UNINITIALIZED_WARNING_STOP
+
+/**
+ * Draws a sprite to a (screen) buffer. Calls adequate templated function.
+ *
+ * @param bp further blitting parameters
+ * @param mode blitter mode
+ * @param zoom zoom level at which we are drawing
+ */
+void Blitter_32bppAVX2::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
+{
+	switch (mode) {
+		default: {
+bm_normal:
+			if (bp->skip_left != 0 || bp->width <= MARGIN_NORMAL_THRESHOLD) {
+				Draw<BM_NORMAL, RM_WITH_SKIP, true>(bp, zoom);
+			} else if (((const Blitter_32bppSSE_Base::SpriteData *) bp->sprite)->flags & SF_TRANSLUCENT) {
+				Draw<BM_NORMAL, RM_WITH_MARGIN, true>(bp, zoom);
+			} else {
+				Draw<BM_NORMAL, RM_WITH_MARGIN, false>(bp, zoom);
+			}
+			return;
+		}
+		case BM_COLOUR_REMAP:
+			if (((const Blitter_32bppSSE_Base::SpriteData *) bp->sprite)->flags & SF_NO_REMAP) goto bm_normal;
+			/* Remapping is dominated by palette table lookups; wider vectors do not help there. */
+			Blitter_32bppSSE4::Draw(bp, mode, zoom);
+			return;
+		case BM_TRANSPARENT: Draw<BM_TRANSPARENT, RM_NONE, true>(bp, zoom); return;
+		case BM_CRASH_REMAP:
+		case BM_BLACK_REMAP:
+			Blitter_32bppSSE4::Draw(bp, mode, zoom);
+			return;
+	}
+}
+
+#endif /* WITH_SSE */
@@ -272,6 +272,35 @@ void Blitter_32bppOptimized::Draw(Blitter::BlitterParams *bp, BlitterMode mode,
 	this->Draw<false>(bp, mode, zoom);
 }
 
+template <bool Tpal_to_rgb>
+void Blitter_32bppOptimized::DrawBatch(Blitter::BlitterParams *bp, uint count, BlitterMode mode, ZoomLevel zoom)
+{
+	switch (mode) {
+		default: NOT_REACHED();
+		case BM_NORMAL:       for (uint i = 0; i < count; i++) Draw<BM_NORMAL, Tpal_to_rgb>      (&bp[i], zoom); return;
+		case BM_COLOUR_REMAP: for (uint i = 0; i < count; i++) Draw<BM_COLOUR_REMAP, Tpal_to_rgb>(&bp[i], zoom); return;
+		case BM_TRANSPARENT:  for (uint i = 0; i < count; i++) Draw<BM_TRANSPARENT, Tpal_to_rgb> (&bp[i], zoom); return;
+		case BM_CRASH_REMAP:  for (uint i = 0; i < count; i++) Draw<BM_CRASH_REMAP, Tpal_to_rgb> (&bp[i], zoom); return;
+		case BM_BLACK_REMAP:  for (uint i = 0; i < count; i++) Draw<BM_BLACK_REMAP, Tpal_to_rgb> (&bp[i], zoom); return;
+	}
+}
+
+template void Blitter_32bppOptimized::DrawBatch<true>(Blitter::BlitterParams *bp, uint count, BlitterMode mode, ZoomLevel zoom);
+template void Blitter_32bppOptimized::DrawBatch<false>(Blitter::BlitterParams *bp, uint count, BlitterMode mode, ZoomLevel zoom);
+
+/**
+ * Draws a batch of sprites to a (screen) buffer, resolving the drawing mode only once.
+ *
+ * @param bp blitting parameters of each of the sprites
+ * @param count number of sprites in the batch
+ * @param mode blitter mode
+ * @param zoom zoom level at which we are drawing
+ */
+void Blitter_32bppOptimized::DrawBatch(Blitter::BlitterParams *bp, uint count, BlitterMode mode, ZoomLevel zoom)
+{
+	this->DrawBatch<false>(bp, count, mode, zoom);
+}
+
 template <bool Tpal_to_rgb> Sprite *Blitter_32bppOptimized::EncodeInternal(const SpriteLoader::Sprite *sprite, AllocatorProc *allocator)
 {
 	/* streams of pixels (a, r, g, b channels)
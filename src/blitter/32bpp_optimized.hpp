@@ -22,6 +22,7 @@ public:
 	};
 
 	void Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom) override;
+	void DrawBatch(Blitter::BlitterParams *bp, uint count, BlitterMode mode, ZoomLevel zoom) override;
 	Sprite *Encode(const SpriteLoader::Sprite *sprite, AllocatorProc *allocator) override;
 
 	const char *GetName() override { return "32bpp-optimized"; }
@@ -30,6 +31,7 @@ public:
 
 protected:
 	template <bool Tpal_to_rgb> void Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom);
+	template <bool Tpal_to_rgb> void DrawBatch(Blitter::BlitterParams *bp, uint count, BlitterMode mode, ZoomLevel zoom);
 	template <bool Tpal_to_rgb> Sprite *EncodeInternal(const SpriteLoader::Sprite *sprite, AllocatorProc *allocator);
 };
 
@@ -98,7 +98,7 @@ public:
 /** Factory for the SSE2 32 bpp blitter (without palette animation). */
 class FBlitter_32bppSSE2 : public BlitterFactory {
 public:
-	FBlitter_32bppSSE2() : BlitterFactory("32bpp-sse2", "32bpp SSE2 Blitter (no palette animation)", HasCPUIDFlag(1, 3, 26)) {}
+	FBlitter_32bppSSE2() : BlitterFactory("32bpp-sse2", "32bpp SSE2 Blitter (no palette animation)", HasCPUFeature(CPUF_SSE2)) {}
 	Blitter *CreateInstance() override { return new Blitter_32bppSSE2(); }
 };
 
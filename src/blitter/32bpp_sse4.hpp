@@ -38,7 +38,7 @@ public:
 /** Factory for the SSE4 32 bpp blitter (without palette animation). */
 class FBlitter_32bppSSE4: public BlitterFactory {
 public:
-	FBlitter_32bppSSE4() : BlitterFactory("32bpp-sse4", "32bpp SSE4 Blitter (no palette animation)", HasCPUIDFlag(1, 2, 19)) {}
+	FBlitter_32bppSSE4() : BlitterFactory("32bpp-sse4", "32bpp SSE4 Blitter (no palette animation)", HasCPUFeature(CPUF_SSE41)) {}
 	Blitter *CreateInstance() override { return new Blitter_32bppSSE4(); }
 };
 
@@ -38,7 +38,7 @@ public:
 /** Factory for the SSSE3 32 bpp blitter (without palette animation). */
 class FBlitter_32bppSSSE3: public BlitterFactory {
 public:
-	FBlitter_32bppSSSE3() : BlitterFactory("32bpp-ssse3", "32bpp SSSE3 Blitter (no palette animation)", HasCPUIDFlag(1, 2, 9)) {}
+	FBlitter_32bppSSSE3() : BlitterFactory("32bpp-ssse3", "32bpp SSSE3 Blitter (no palette animation)", HasCPUFeature(CPUF_SSSE3)) {}
 	Blitter *CreateInstance() override { return new Blitter_32bppSSSE3(); }
 };
 
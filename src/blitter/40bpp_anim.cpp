@@ -328,6 +328,34 @@ void Blitter_40bppAnim::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomL
 	}
 }
 
+/**
+ * Draws a batch of sprites to a (screen) buffer, resolving the drawing mode only once.
+ *
+ * @param bp blitting parameters of each of the sprites
+ * @param count number of sprites in the batch
+ * @param mode blitter mode
+ * @param zoom zoom level at which we are drawing
+ */
+void Blitter_40bppAnim::DrawBatch(Blitter::BlitterParams *bp, uint count, BlitterMode mode, ZoomLevel zoom)
+{
+	assert(_screen.dst_ptr != nullptr);
+
+	if (_screen_disable_anim || VideoDriver::GetInstance()->GetAnimBuffer() == nullptr) {
+		/* This means our output is not to the screen, so we can't be doing any animation stuff, so use our parent DrawBatch() */
+		Blitter_32bppOptimized::DrawBatch<true>(bp, count, mode, zoom);
+		return;
+	}
+
+	switch (mode) {
+		default: NOT_REACHED();
+		case BM_NORMAL:       for (uint i = 0; i < count; i++) Draw<BM_NORMAL>      (&bp[i], zoom); return;
+		case BM_COLOUR_REMAP: for (uint i = 0; i < count; i++) Draw<BM_COLOUR_REMAP>(&bp[i], zoom); return;
+		case BM_TRANSPARENT:  for (uint i = 0; i < count; i++) Draw<BM_TRANSPARENT> (&bp[i], zoom); return;
+		case BM_CRASH_REMAP:  for (uint i = 0; i < count; i++) Draw<BM_CRASH_REMAP> (&bp[i], zoom); return;
+		case BM_BLACK_REMAP:  for (uint i = 0; i < count; i++) Draw<BM_BLACK_REMAP> (&bp[i], zoom); return;
+	}
+}
+
 void Blitter_40bppAnim::DrawColourMappingRect(void *dst, int width, int height, PaletteID pal)
 {
 	if (_screen_disable_anim) {
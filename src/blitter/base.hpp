@@ -68,6 +68,20 @@ public:
 	 */
 	virtual void Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom) = 0;
 
+	/**
+	 * Draw a batch of images to the screen that all share the same mode and zoom level.
+	 *  The sprites must be drawn in the given order. Blitters can override this to
+	 *  resolve the drawing mode once for the whole batch instead of per sprite.
+	 * @param bp    Blitting parameters of each of the sprites to draw.
+	 * @param count Number of sprites in the batch.
+	 * @param mode  The mode to draw all the sprites in.
+	 * @param zoom  The zoom level to draw all the sprites at.
+	 */
+	virtual void DrawBatch(Blitter::BlitterParams *bp, uint count, BlitterMode mode, ZoomLevel zoom)
+	{
+		for (uint i = 0; i < count; i++) this->Draw(&bp[i], mode, zoom);
+	}
+
 	/**
 	 * Draw a colourtable to the screen. This is: the colour of the screen is read
 	 *  and is looked-up in the palette to match a new colour, which then is put
@@ -188,8 +188,8 @@ static bool EngineReliabilitySorter(const GUIEngineListItem &a, const GUIEngineL
  */
 static bool EngineCostSorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	Money va = Engine::Get(a.engine_id)->GetCost();
-	Money vb = Engine::Get(b.engine_id)->GetCost();
+	Money va = GetEngineSortCacheEntry(a.engine_id).cost;
+	Money vb = GetEngineSortCacheEntry(b.engine_id).cost;
 	int r = ClampToI32(va - vb);
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -205,8 +205,8 @@ static bool EngineCostSorter(const GUIEngineListItem &a, const GUIEngineListItem
  */
 static bool EngineSpeedSorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	int va = Engine::Get(a.engine_id)->GetDisplayMaxSpeed();
-	int vb = Engine::Get(b.engine_id)->GetDisplayMaxSpeed();
+	int va = GetEngineSortCacheEntry(a.engine_id).max_speed;
+	int vb = GetEngineSortCacheEntry(b.engine_id).max_speed;
 	int r = va - vb;
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -222,8 +222,8 @@ static bool EngineSpeedSorter(const GUIEngineListItem &a, const GUIEngineListIte
  */
 static bool EnginePowerSorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	int va = Engine::Get(a.engine_id)->GetPower();
-	int vb = Engine::Get(b.engine_id)->GetPower();
+	int va = GetEngineSortCacheEntry(a.engine_id).power;
+	int vb = GetEngineSortCacheEntry(b.engine_id).power;
 	int r = va - vb;
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -239,8 +239,8 @@ static bool EnginePowerSorter(const GUIEngineListItem &a, const GUIEngineListIte
  */
 static bool EngineTractiveEffortSorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	int va = Engine::Get(a.engine_id)->GetDisplayMaxTractiveEffort();
-	int vb = Engine::Get(b.engine_id)->GetDisplayMaxTractiveEffort();
+	int va = GetEngineSortCacheEntry(a.engine_id).tractive_effort;
+	int vb = GetEngineSortCacheEntry(b.engine_id).tractive_effort;
 	int r = va - vb;
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -256,8 +256,8 @@ static bool EngineTractiveEffortSorter(const GUIEngineListItem &a, const GUIEngi
  */
 static bool EngineRunningCostSorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	Money va = Engine::Get(a.engine_id)->GetRunningCost();
-	Money vb = Engine::Get(b.engine_id)->GetRunningCost();
+	Money va = GetEngineSortCacheEntry(a.engine_id).running_cost;
+	Money vb = GetEngineSortCacheEntry(b.engine_id).running_cost;
 	int r = ClampToI32(va - vb);
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -273,12 +273,12 @@ static bool EngineRunningCostSorter(const GUIEngineListItem &a, const GUIEngineL
  */
 static bool EnginePowerVsRunningCostSorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	const Engine *e_a = Engine::Get(a.engine_id);
-	const Engine *e_b = Engine::Get(b.engine_id);
-	uint p_a = e_a->GetPower();
-	uint p_b = e_b->GetPower();
-	Money r_a = e_a->GetRunningCost();
-	Money r_b = e_b->GetRunningCost();
+	const EngineSortCacheEntry &e_a = GetEngineSortCacheEntry(a.engine_id);
+	const EngineSortCacheEntry &e_b = GetEngineSortCacheEntry(b.engine_id);
+	uint p_a = e_a.power;
+	uint p_b = e_b.power;
+	Money r_a = e_a.running_cost;
+	Money r_b = e_b.running_cost;
 	/* Check if running cost is zero in one or both engines.
 	 * If only one of them is zero then that one has higher value,
 	 * else if both have zero cost then compare powers. */
@@ -315,11 +315,8 @@ static bool EnginePowerVsRunningCostSorter(const GUIEngineListItem &a, const GUI
  */
 static bool TrainEngineCapacitySorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	const RailVehicleInfo *rvi_a = RailVehInfo(a.engine_id);
-	const RailVehicleInfo *rvi_b = RailVehInfo(b.engine_id);
-
-	int va = GetTotalCapacityOfArticulatedParts(a.engine_id) * (rvi_a->railveh_type == RAILVEH_MULTIHEAD ? 2 : 1);
-	int vb = GetTotalCapacityOfArticulatedParts(b.engine_id) * (rvi_b->railveh_type == RAILVEH_MULTIHEAD ? 2 : 1);
+	int va = GetEngineSortCacheEntry(a.engine_id).capacity;
+	int vb = GetEngineSortCacheEntry(b.engine_id).capacity;
 	int r = va - vb;
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -354,8 +351,8 @@ static bool TrainEnginesThenWagonsSorter(const GUIEngineListItem &a, const GUIEn
  */
 static bool RoadVehEngineCapacitySorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	int va = GetTotalCapacityOfArticulatedParts(a.engine_id);
-	int vb = GetTotalCapacityOfArticulatedParts(b.engine_id);
+	int va = GetEngineSortCacheEntry(a.engine_id).capacity;
+	int vb = GetEngineSortCacheEntry(b.engine_id).capacity;
 	int r = va - vb;
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -373,11 +370,8 @@ static bool RoadVehEngineCapacitySorter(const GUIEngineListItem &a, const GUIEng
  */
 static bool ShipEngineCapacitySorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	const Engine *e_a = Engine::Get(a.engine_id);
-	const Engine *e_b = Engine::Get(b.engine_id);
-
-	int va = e_a->GetDisplayDefaultCapacity();
-	int vb = e_b->GetDisplayDefaultCapacity();
+	int va = GetEngineSortCacheEntry(a.engine_id).capacity;
+	int vb = GetEngineSortCacheEntry(b.engine_id).capacity;
 	int r = va - vb;
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -395,13 +389,12 @@ static bool ShipEngineCapacitySorter(const GUIEngineListItem &a, const GUIEngine
  */
 static bool AircraftEngineCargoSorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	const Engine *e_a = Engine::Get(a.engine_id);
-	const Engine *e_b = Engine::Get(b.engine_id);
+	const EngineSortCacheEntry &e_a = GetEngineSortCacheEntry(a.engine_id);
+	const EngineSortCacheEntry &e_b = GetEngineSortCacheEntry(b.engine_id);
 
-	uint16 mail_a, mail_b;
-	int va = e_a->GetDisplayDefaultCapacity(&mail_a);
-	int vb = e_b->GetDisplayDefaultCapacity(&mail_b);
-	int r = va - vb;
+	uint16 mail_a = e_a.mail_capacity;
+	uint16 mail_b = e_b.mail_capacity;
+	int r = (int)e_a.capacity - (int)e_b.capacity;
 
 	if (r == 0) {
 		/* The planes have the same passenger capacity. Check mail capacity instead */
@@ -423,8 +416,8 @@ static bool AircraftEngineCargoSorter(const GUIEngineListItem &a, const GUIEngin
  */
 static bool AircraftRangeSorter(const GUIEngineListItem &a, const GUIEngineListItem &b)
 {
-	uint16 r_a = Engine::Get(a.engine_id)->GetRange();
-	uint16 r_b = Engine::Get(b.engine_id)->GetRange();
+	uint16 r_a = GetEngineSortCacheEntry(a.engine_id).range;
+	uint16 r_b = GetEngineSortCacheEntry(b.engine_id).range;
 
 	int r = r_a - r_b;
 
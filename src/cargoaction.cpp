@@ -207,6 +207,7 @@ bool StationCargoReroute::operator()(CargoPacket *cp)
 	 * this might insert the packet between range.first and range.second (which might be end())
 	 * This is why we check for GetKey above to avoid infinite loops. */
 	this->destination->packets.Insert(next, cp_new);
+	this->destination->bucket_counts[next] += cp_new->Count();
 	return cp_new == cp;
 }
 
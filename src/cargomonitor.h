@@ -15,7 +15,7 @@
 #include "industry.h"
 #include "town.h"
 #include "core/overflowsafe_type.hpp"
-#include <map>
+#include <unordered_map>
 
 struct Station;
 
@@ -29,8 +29,12 @@ struct Station;
  */
 typedef uint32 CargoMonitorID; ///< Type of the cargo monitor number.
 
-/** Map type for storing and updating active cargo monitor numbers and their amounts. */
-typedef std::map<CargoMonitorID, OverflowSafeInt32> CargoMonitorMap;
+/**
+ * Map type for storing and updating active cargo monitor numbers and their amounts.
+ * It is keyed on the packed monitor number and consulted for every monitored
+ * delivery, so it hashes instead of walking an ordered tree.
+ */
+typedef std::unordered_map<CargoMonitorID, OverflowSafeInt32> CargoMonitorMap;
 
 extern CargoMonitorMap _cargo_pickups;
 extern CargoMonitorMap _cargo_deliveries;
@@ -26,6 +26,7 @@ INSTANTIATE_POOL_METHODS(CargoPacket)
  */
 CargoPacket::CargoPacket()
 {
+	this->age_epoch   = 0;
 	this->source_type = ST_INDUSTRY;
 	this->source_id   = INVALID_SOURCE;
 }
@@ -45,6 +46,7 @@ CargoPacket::CargoPacket(StationID source, TileIndex source_xy, uint16 count, So
 	feeder_share(0),
 	count(count),
 	days_in_transit(0),
+	age_epoch(0),
 	source_id(source_id),
 	source(source),
 	source_xy(source_xy),
@@ -72,6 +74,7 @@ CargoPacket::CargoPacket(uint16 count, byte days_in_transit, StationID source, T
 		feeder_share(feeder_share),
 		count(count),
 		days_in_transit(days_in_transit),
+		age_epoch(0),
 		source_id(source_id),
 		source(source),
 		source_xy(source_xy),
@@ -92,6 +95,7 @@ CargoPacket *CargoPacket::Split(uint new_size)
 
 	Money fs = this->FeederShare(new_size);
 	CargoPacket *cp_new = new CargoPacket(new_size, this->days_in_transit, this->source, this->source_xy, this->loaded_at_xy, fs, this->source_type, this->source_id);
+	cp_new->age_epoch = this->age_epoch;
 	this->feeder_share -= fs;
 	this->count -= new_size;
 	return cp_new;
@@ -333,6 +337,7 @@ void VehicleCargoList::PopCargo(Taction action)
 void VehicleCargoList::RemoveFromCache(const CargoPacket *cp, uint count)
 {
 	this->feeder_share -= cp->FeederShare(count);
+	this->cargo_days_in_transit -= (this->age_epoch - cp->age_epoch) * count;
 	this->Parent::RemoveFromCache(cp, count);
 }
 
@@ -344,6 +349,10 @@ void VehicleCargoList::RemoveFromCache(const CargoPacket *cp, uint count)
 void VehicleCargoList::AddToCache(const CargoPacket *cp)
 {
 	this->feeder_share += cp->feeder_share;
+	/* Aging the packet has not yet caught up with is part of its age; packets
+	 * freshly joining the list have no lag, but InvalidateCache() re-adds
+	 * packets that may have been aboard for a while. */
+	this->cargo_days_in_transit += (this->age_epoch - cp->age_epoch) * cp->count;
 	this->Parent::AddToCache(cp);
 }
 
@@ -353,10 +362,11 @@ void VehicleCargoList::AddToCache(const CargoPacket *cp)
  * @param action MoveToAction of the packet (for updating the counts).
  * @param count Amount of cargo to be removed.
  */
-void VehicleCargoList::RemoveFromMeta(const CargoPacket *cp, MoveToAction action, uint count)
+void VehicleCargoList::RemoveFromMeta(CargoPacket *cp, MoveToAction action, uint count)
 {
 	assert(count <= this->action_counts[action]);
 	this->AssertCountConsistency();
+	this->NormalizeAge(cp);
 	this->RemoveFromCache(cp, count);
 	this->action_counts[action] -= count;
 	this->AssertCountConsistency();
@@ -367,9 +377,12 @@ void VehicleCargoList::RemoveFromMeta(const CargoPacket *cp, MoveToAction action
  * @param cp Packet to be added.
  * @param action MoveToAction of the packet.
  */
-void VehicleCargoList::AddToMeta(const CargoPacket *cp, MoveToAction action)
+void VehicleCargoList::AddToMeta(CargoPacket *cp, MoveToAction action)
 {
 	this->AssertCountConsistency();
+	/* The packet arrives with its age folded into days_in_transit; from here
+	 * on it ages by lagging behind this list's aging epoch. */
+	cp->age_epoch = this->age_epoch;
 	this->AddToCache(cp);
 	this->action_counts[action] += cp->count;
 	this->AssertCountConsistency();
@@ -377,17 +390,36 @@ void VehicleCargoList::AddToMeta(const CargoPacket *cp, MoveToAction action)
 
 /**
  * Ages the all cargo in this list.
+ * Instead of touching every packet this just advances the list's aging epoch;
+ * a packet's age is the difference between that epoch and the epoch it joined
+ * at, and is folded into the packet by NormalizeAge() when it is needed.
  */
 void VehicleCargoList::AgeCargo()
 {
-	for (ConstIterator it(this->packets.begin()); it != this->packets.end(); it++) {
-		CargoPacket *cp = *it;
-		/* If we're at the maximum, then we can't increase no more. */
-		if (cp->days_in_transit == 0xFF) continue;
+	this->age_epoch++;
+	this->cargo_days_in_transit += this->count;
+}
 
-		cp->days_in_transit++;
-		this->cargo_days_in_transit += cp->count;
+/**
+ * Folds the aging a packet has accumulated since joining this list into its
+ * days_in_transit, applying the usual cap of 255. Must be called before the
+ * packet's age is read or before it leaves the list.
+ * @param cp Packet to be updated. Must be part of this list.
+ */
+void VehicleCargoList::NormalizeAge(CargoPacket *cp)
+{
+	uint32 lag = this->age_epoch - cp->age_epoch;
+	if (lag == 0) return;
+
+	uint age = cp->days_in_transit + lag;
+	if (age > 0xFF) {
+		/* The cache tracks the age without the cap; drop the excess now that
+		 * the packet is known to have reached it. */
+		this->cargo_days_in_transit -= (age - 0xFF) * cp->count;
+		age = 0xFF;
 	}
+	cp->days_in_transit = (byte)age;
+	cp->age_epoch = this->age_epoch;
 }
 
 /**
@@ -470,11 +502,11 @@ bool VehicleCargoList::Stage(bool accepted, StationID current_station, StationID
 			action = MTA_TRANSFER;
 			/* We cannot send the cargo to any of the possible next hops and
 			 * also not to the current station. */
-			FlowStatMap::const_iterator flow_it(ge->flows.find(cp->source));
-			if (flow_it == ge->flows.end()) {
+			const FlowStat *flow = ge->flows.FindFlows(cp->source);
+			if (flow == nullptr) {
 				cargo_next = INVALID_STATION;
 			} else {
-				FlowStat new_shares = flow_it->second;
+				FlowStat new_shares = *flow;
 				new_shares.ChangeShare(current_station, INT_MIN);
 				StationIDStack excluded = next_station;
 				while (!excluded.IsEmpty() && !new_shares.GetShares()->empty()) {
@@ -493,17 +525,17 @@ bool VehicleCargoList::Stage(bool accepted, StationID current_station, StationID
 				cp->source = ge->flows.begin()->first;
 			}
 			bool restricted = false;
-			FlowStatMap::const_iterator flow_it(ge->flows.find(cp->source));
-			if (flow_it == ge->flows.end()) {
+			const FlowStat *flow = ge->flows.FindFlows(cp->source);
+			if (flow == nullptr) {
 				cargo_next = INVALID_STATION;
 			} else {
-				cargo_next = flow_it->second.GetViaWithRestricted(restricted);
+				cargo_next = flow->GetViaWithRestricted(restricted);
 			}
 			action = VehicleCargoList::ChooseAction(cp, cargo_next, current_station, accepted, next_station);
 			if (restricted && action == MTA_TRANSFER) {
 				/* If the flow is restricted we can't transfer to it. Choose an
 				 * unrestricted one instead. */
-				cargo_next = flow_it->second.GetVia();
+				cargo_next = flow->GetVia();
 				action = VehicleCargoList::ChooseAction(cp, cargo_next, current_station, accepted, next_station);
 			}
 		}
@@ -518,6 +550,8 @@ bool VehicleCargoList::Stage(bool accepted, StationID current_station, StationID
 				break;
 			case MTA_TRANSFER:
 				this->packets.push_front(cp);
+				/* The transfer payment depends on the packet's current age. */
+				this->NormalizeAge(cp);
 				/* Add feeder share here to allow reusing field for next station. */
 				share = payment->PayTransfer(cp, cp->count);
 				cp->AddFeederShare(share);
@@ -691,15 +725,74 @@ void StationCargoList::Append(CargoPacket *cp, StationID next)
 {
 	assert(cp != nullptr);
 	this->AddToCache(cp);
+	this->bucket_counts[next] += cp->count;
 
 	StationCargoPacketMap::List &list = this->packets[next];
-	for (StationCargoPacketMap::List::reverse_iterator it(list.rbegin());
-			it != list.rend(); it++) {
-		if (StationCargoList::TryMerge(*it, cp)) return;
-	}
 
-	/* The packet could not be merged with another one */
+	/* Merging with the most recently appended packet catches the common case of
+	 * cargo arriving from the same source in consecutive ticks. Scanning the
+	 * whole list on every append is too expensive for busy stations, so the
+	 * remaining combinations are left to MergePackets(). */
+	if (!list.empty() && StationCargoList::TryMerge(list.back(), cp)) return;
+
 	list.push_back(cp);
+	this->merge_pending = true;
+}
+
+/**
+ * Coalesce mergable packets that Append() did not merge.
+ * Append() only compares against the last packet of a list; this pass catches
+ * the remaining combinations in one sweep over each list, keeping the relative
+ * order of the surviving packets. Called once per station tick.
+ */
+void StationCargoList::MergePackets()
+{
+	if (!this->merge_pending) return;
+	this->merge_pending = false;
+
+	StationCargoPacketMap::Map &lists = this->packets;
+	for (auto &item : lists) {
+		StationCargoPacketMap::List &list = item.second;
+		if (list.size() < 2) continue;
+
+		/* Key of mergable packets; must cover the same fields as AreMergable(). */
+		typedef std::tuple<TileIndex, byte, SourceType, SourceID> MergeKey;
+		std::map<MergeKey, CargoPacket *> merge_into;
+		for (StationCargoPacketMap::ListIterator it = list.begin(); it != list.end();) {
+			CargoPacket *cp = *it;
+			auto res = merge_into.emplace(MergeKey(cp->source_xy, cp->days_in_transit, cp->source_type, cp->source_id), cp);
+			if (!res.second && StationCargoList::TryMerge(res.first->second, cp)) {
+				it = list.erase(it);
+			} else {
+				/* A packet that is too full to merge into stops being a target; later ones take over. */
+				res.first->second = cp;
+				++it;
+			}
+		}
+	}
+}
+
+/**
+ * Update the per next hop totals to reflect removal of some cargo.
+ * @param next Next hop the cargo was waiting for.
+ * @param count Amount of cargo removed from that next hop's packets.
+ */
+void StationCargoList::RemoveFromBucket(StationID next, uint count)
+{
+	StationCargoAmountMap::iterator it = this->bucket_counts.find(next);
+	assert(it != this->bucket_counts.end() && it->second >= count);
+	it->second -= count;
+	if (it->second == 0) this->bucket_counts.erase(it);
+}
+
+/** Invalidates the cached data and rebuilds it. */
+void StationCargoList::InvalidateCache()
+{
+	this->bucket_counts.clear();
+	for (ConstIterator it(this->packets.begin()); it != this->packets.end(); it++) {
+		this->bucket_counts[it.GetKey()] += (*it)->count;
+	}
+	this->Parent::InvalidateCache();
 }
 
 /**
@@ -721,9 +814,14 @@ bool StationCargoList::ShiftCargo(Taction &action, StationID next)
 	for (Iterator it(range.first); it != range.second && it.GetKey() == next;) {
 		if (action.MaxMove() == 0) return false;
 		CargoPacket *cp = *it;
+		uint count = cp->Count();
 		if (action(cp)) {
+			this->RemoveFromBucket(next, count);
 			it = this->packets.erase(it);
 		} else {
+			/* The action may still have split the packet and moved part of it. */
+			uint moved = count - cp->Count();
+			if (moved > 0) this->RemoveFromBucket(next, moved);
 			return false;
 		}
 	}
@@ -787,6 +885,7 @@ uint StationCargoList::Truncate(uint max_move, StationCargoAmountMap *cargo_per_
 			if (cp->count > diff) {
 				if (diff > 0) {
 					this->RemoveFromCache(cp, diff);
+					this->RemoveFromBucket(it.GetKey(), diff);
 					cp->Reduce(diff);
 					moved += diff;
 				}
@@ -798,6 +897,7 @@ uint StationCargoList::Truncate(uint max_move, StationCargoAmountMap *cargo_per_
 					++it;
 				}
 			} else {
+				this->RemoveFromBucket(it.GetKey(), cp->count);
 				it = this->packets.erase(it);
 				if (do_count && loop > 0) {
 					(*cargo_per_source)[cp->source] -= cp->count;
@@ -44,7 +44,8 @@ struct CargoPacket : CargoPacketPool::PoolItem<&_cargopacket_pool> {
 private:
 	Money feeder_share;     ///< Value of feeder pickup to be paid for on delivery of cargo.
 	uint16 count;           ///< The amount of cargo in this packet.
-	byte days_in_transit;   ///< Amount of days this packet has been in transit.
+	byte days_in_transit;   ///< Amount of days this packet has been in transit, as of the last time it was folded; see VehicleCargoList::NormalizeAge().
+	uint32 age_epoch;       ///< Aging epoch of the holding vehicle's cargo list when this packet last joined it or had its age folded.
 	SourceType source_type; ///< Type of \c source_id.
 	SourceID source_id;     ///< Index of source, INVALID_SOURCE if unknown/invalid.
 	StationID source;       ///< The station where the cargo came from first.
@@ -127,6 +128,10 @@ public:
 	 * Gets the number of days this cargo has been in transit.
 	 * This number isn't really in days, but in 2.5 days (CARGO_AGING_TICKS = 185 ticks) and
 	 * it is capped at 255.
+	 * While the packet is held by a vehicle the aging since it was loaded is
+	 * kept in the cargo list's aging epoch; callers that need the current age
+	 * of such a packet must let the list fold it first, see
+	 * VehicleCargoList::NormalizeAge().
 	 * @return Length this cargo has been in transit.
 	 */
 	inline byte DaysInTransit() const
@@ -273,6 +278,7 @@ protected:
 
 	Money feeder_share;                     ///< Cache for the feeder share.
 	uint action_counts[NUM_MOVE_TO_ACTION]; ///< Counts of cargo to be transferred, delivered, kept and loaded.
+	uint32 age_epoch;                       ///< Number of aging steps this list has performed; packets age by lagging behind it, see AgeCargo().
 
 	template<class Taction>
 	void ShiftCargo(Taction action);
@@ -294,8 +300,10 @@ protected:
 	void AddToCache(const CargoPacket *cp);
 	void RemoveFromCache(const CargoPacket *cp, uint count);
 
-	void AddToMeta(const CargoPacket *cp, MoveToAction action);
-	void RemoveFromMeta(const CargoPacket *cp, MoveToAction action, uint count);
+	void AddToMeta(CargoPacket *cp, MoveToAction action);
+	void RemoveFromMeta(CargoPacket *cp, MoveToAction action, uint count);
+
+	void NormalizeAge(CargoPacket *cp);
 
 	static MoveToAction ChooseAction(const CargoPacket *cp, StationID cargo_next,
 			StationID current_station, bool accepted, StationIDStack next_station);
@@ -434,6 +442,7 @@ public:
 	{
 		return cp1->source_xy    == cp2->source_xy &&
 				cp1->days_in_transit == cp2->days_in_transit &&
+				cp1->age_epoch       == cp2->age_epoch &&
 				cp1->source_type     == cp2->source_type &&
 				cp1->source_id       == cp2->source_id &&
 				cp1->loaded_at_xy    == cp2->loaded_at_xy;
@@ -452,6 +461,10 @@ protected:
 	typedef CargoList<StationCargoList, StationCargoPacketMap> Parent;
 
 	uint reserved_count; ///< Amount of cargo being reserved for loading.
+	bool merge_pending = false; ///< NOSAVE: Whether Append() skipped possible merges since the last MergePackets().
+	StationCargoAmountMap bucket_counts; ///< NOSAVE: Amount of waiting cargo per next hop, maintained incrementally.
+
+	void RemoveFromBucket(StationID next, uint count);
 
 public:
 	/** The super class ought to know what it's doing. */
@@ -476,6 +489,8 @@ public:
 	uint ShiftCargo(Taction action, StationIDStack next, bool include_invalid);
 
 	void Append(CargoPacket *cp, StationID next);
+	void MergePackets();
+	void InvalidateCache();
 
 	/**
 	 * Check for cargo headed for a specific station.
@@ -510,6 +525,27 @@ public:
 		return this->count;
 	}
 
+	/**
+	 * Returns sum of cargo available for loading that wants to travel via the
+	 * given next hop, without walking that next hop's packets.
+	 * @param next Next hop to get the amount for.
+	 * @return Amount of cargo for that next hop.
+	 */
+	inline uint AvailableViaCount(StationID next) const
+	{
+		StationCargoAmountMap::const_iterator it = this->bucket_counts.find(next);
+		return it == this->bucket_counts.end() ? 0 : it->second;
+	}
+
+	/**
+	 * Returns the amounts of cargo available for loading per next hop.
+	 * @return Map of next hop to amount of cargo for it.
+	 */
+	inline const StationCargoAmountMap &AvailableCounts() const
+	{
+		return this->bucket_counts;
+	}
+
 	/**
 	 * Returns sum of cargo reserved for loading onto vehicles.
 	 * @return Cargo reserved for loading.
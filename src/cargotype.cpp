@@ -76,6 +76,36 @@ void SetupCargoForClimate(LandscapeID l)
 			}
 		}
 	}
+
+	for (CargoID i = 0; i < lengthof(CargoSpec::array); i++) {
+		CargoSpec::Get(i)->InitTimeFactors();
+	}
+}
+
+/**
+ * Build the lookup table of payment time factors from the transit day curve
+ * parameters. Has to be called again whenever #transit_days changes.
+ */
+void CargoSpec::InitTimeFactors()
+{
+	static const int MIN_TIME_FACTOR = 31;
+	static const int MAX_TIME_FACTOR = 255;
+
+	/*
+	 * The time factor is calculated based on the time it took
+	 * (transit_days) compared two cargo-depending values. The
+	 * range is divided into three parts:
+	 *
+	 *  - constant for fast transits
+	 *  - linear decreasing with time with a slope of -1 for medium transports
+	 *  - linear decreasing with time with a slope of -2 for slow transports
+	 *
+	 */
+	for (uint transit_days = 0; transit_days < lengthof(this->time_factors); transit_days++) {
+		const int days_over_days1 = std::max<int>(transit_days - this->transit_days[0], 0);
+		const int days_over_days2 = std::max<int>(days_over_days1 - this->transit_days[1], 0);
+		this->time_factors[transit_days] = std::max(MAX_TIME_FACTOR - days_over_days1 - days_over_days2, MIN_TIME_FACTOR);
+	}
 }
 
 /**
@@ -82,6 +82,13 @@ struct CargoSpec {
 
 	Money current_payment;
 
+	/**
+	 * Payment time factor for every possible time in transit, derived from
+	 * #transit_days. Precomputed so the delivery payment calculation is a
+	 * table read; see InitTimeFactors().
+	 */
+	byte time_factors[256];
+
 	/**
 	 * Determines index of this cargospec
 	 * @return index (in the CargoSpec::array array)
@@ -123,6 +130,8 @@ struct CargoSpec {
 
 	SpriteID GetCargoIcon() const;
 
+	void InitTimeFactors();
+
 	inline uint64 WeightOfNUnits(uint32 n) const
 	{
 		return n * this->weight / 16u;
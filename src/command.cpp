@@ -307,6 +307,47 @@ bool CommandHelperBase::InternalExecutePrepTest(CommandFlags cmd_flags, TileInde
 	return true;
 }
 
+/**
+ * Determine whether a #CMD_SINGLE_PASS command may skip its test run.
+ * That is the case when it is going to be executed here and now, i.e. when
+ * it is neither a mere estimate nor still to be sent to the server.
+ * @param estimate_only Is this just cost estimation?
+ * @param network_command Does this command come from the network?
+ * @return True when the test run can be skipped.
+ */
+bool CommandHelperBase::InternalExecuteSkipTest(bool estimate_only, bool network_command)
+{
+	return !estimate_only && !(_networking && !_generating_world && !network_command);
+}
+
+/**
+ * Prepare for the single-pass execution of a #CMD_SINGLE_PASS command proc call.
+ * Such commands do not change any state before all of their checks have passed,
+ * so they can enter command mode directly without a preceding test run.
+ * @param cmd_flags Command flags.
+ * @param[in,out] cur_company Backup of current company at start of command execution.
+ * @return True if the execution can go ahead, false on error.
+ */
+bool CommandHelperBase::InternalExecutePrepExec(CommandFlags cmd_flags, Backup<CompanyID> &cur_company)
+{
+	/* Always execute server and spectator commands as spectator */
+	bool exec_as_spectator = (cmd_flags & (CMD_SPECTATOR | CMD_SERVER)) != 0;
+
+	/* If the company isn't valid it may only do server command or start a new company!
+	 * The server will ditch any server commands a client sends to it, so effectively
+	 * this guards the server from executing functions for an invalid company. */
+	if (_game_mode == GM_NORMAL && !exec_as_spectator && !Company::IsValidID(_current_company) && !(_current_company == OWNER_DEITY && (cmd_flags & CMD_DEITY) != 0)) {
+		return false;
+	}
+
+	if (exec_as_spectator) cur_company.Change(COMPANY_SPECTATOR);
+
+	/* Prepare for command execution. */
+	_cleared_object_areas.clear();
+	BasePersistentStorageArray::SwitchMode(PSM_ENTER_COMMAND);
+	return true;
+}
+
 /**
  * Validate result of test run and prepare for real execution.
  * @param cmd_flags Command flags.
@@ -329,7 +370,7 @@ std::tuple<bool, bool, bool> CommandHelperBase::InternalExecuteValidateTestAndPr
 	 * (unless it's a command where the test and
 	 * execution phase might return different costs)
 	 * we bail out here. */
-	bool test_and_exec_can_differ = (cmd_flags & CMD_NO_TEST) != 0;
+	bool test_and_exec_can_differ = (cmd_flags & (CMD_NO_TEST | CMD_SINGLE_PASS)) != 0;
 	if (res.Failed() || estimate_only || (!test_and_exec_can_differ && !CheckCompanyHasMoney(res))) {
 		return { true, !_networking || _generating_world || network_command, false };
 	}
@@ -376,7 +417,7 @@ CommandCost CommandHelperBase::InternalExecuteProcessResult(Commands cmd, Comman
 	 * return of the command. Otherwise we can check whether the
 	 * test and execution have yielded the same result,
 	 * i.e. cost and error state are the same. */
-	bool test_and_exec_can_differ = (cmd_flags & CMD_NO_TEST) != 0;
+	bool test_and_exec_can_differ = (cmd_flags & (CMD_NO_TEST | CMD_SINGLE_PASS)) != 0;
 	if (!test_and_exec_can_differ) {
 		assert(res_test.GetCost() == res_exec.GetCost() && res_test.Failed() == res_exec.Failed()); // sanity check
 	} else if (res_exec.Failed()) {
@@ -436,7 +477,7 @@ uint32 CommandCost::textref_stack[16];
  */
 void CommandCost::UseTextRefStack(const GRFFile *grffile, uint num_registers)
 {
-	extern TemporaryStorageArray<int32, 0x110> _temp_store;
+	extern thread_local TemporaryStorageArray<int32, 0x110> _temp_store;
 
 	assert(num_registers < lengthof(textref_stack));
 	this->textref_stack_grffile = grffile;
@@ -100,6 +100,8 @@ protected:
 	static std::tuple<bool, bool, bool> InternalPostBefore(Commands cmd, CommandFlags flags, TileIndex tile, StringID err_message, bool network_command);
 	static void InternalPostResult(const CommandCost &res, TileIndex tile, bool estimate_only, bool only_sending, StringID err_message, bool my_cmd);
 	static bool InternalExecutePrepTest(CommandFlags cmd_flags, TileIndex tile, Backup<CompanyID> &cur_company);
+	static bool InternalExecuteSkipTest(bool estimate_only, bool network_command);
+	static bool InternalExecutePrepExec(CommandFlags cmd_flags, Backup<CompanyID> &cur_company);
 	static std::tuple<bool, bool, bool> InternalExecuteValidateTestAndPrepExec(CommandCost &res, CommandFlags cmd_flags, bool estimate_only, bool network_command, Backup<CompanyID> &cur_company);
 	static CommandCost InternalExecuteProcessResult(Commands cmd, CommandFlags cmd_flags, const CommandCost &res_test, const CommandCost &res_exec, Money extra_cash, TileIndex tile, Backup<CompanyID> &cur_company);
 	static void LogCommandExecution(Commands cmd, StringID err_message, TileIndex tile, const CommandDataBuffer &args, bool failed);
@@ -386,6 +388,31 @@ protected:
 		}
 
 		Backup<CompanyID> cur_company(_current_company, FILE_LINE);
+
+		if constexpr ((cmd_flags & CMD_SINGLE_PASS) != 0) {
+			/* The command changes no state before all of its checks have passed
+			 * and costs nothing, so unless this is an estimate or the command
+			 * still has to travel to the server there is no need for a test run. */
+			if (InternalExecuteSkipTest(estimate_only, network_command)) {
+				if (!InternalExecutePrepExec(cmd_flags, cur_company)) {
+					cur_company.Trash();
+					return MakeResult(CMD_ERROR);
+				}
+
+				if (_debug_desync_level >= 1) LogCommandExecution(Tcmd, err_message, tile, EndianBufferWriter<CommandDataBuffer>::FromValue(args), false);
+
+				DoCommandFlag exec_flags = CommandFlagsToDCFlags(cmd_flags);
+				Tret res = std::apply(CommandTraits<Tcmd>::proc, std::tuple_cat(std::make_tuple(exec_flags | DC_EXEC), args));
+
+				if constexpr (std::is_same_v<Tret, CommandCost>) {
+					return InternalExecuteProcessResult(Tcmd, cmd_flags, res, res, Money{}, tile, cur_company);
+				} else {
+					std::get<0>(res) = InternalExecuteProcessResult(Tcmd, cmd_flags, ExtractCommandCost(res), ExtractCommandCost(res), ExtractAdditionalMoney(res), tile, cur_company);
+					return res;
+				}
+			}
+		}
+
 		if (!InternalExecutePrepTest(cmd_flags, tile, cur_company)) {
 			cur_company.Trash();
 			return MakeResult(CMD_ERROR);
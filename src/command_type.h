@@ -386,6 +386,8 @@ enum CommandFlags {
 	CMD_DEITY     = 0x100, ///< the command may be executed by COMPANY_DEITY
 	CMD_STR_CTRL  = 0x200, ///< the command's string may contain control strings
 	CMD_NO_EST    = 0x400, ///< the command is never estimated.
+	CMD_NO_DUPLICATE = 0x800, ///< executing the command twice with the same arguments is never intended; repeats may be dropped while one is in flight to the server.
+	CMD_SINGLE_PASS  = 0x1000, ///< the command is free of cost and does not change any state before all of its checks have passed; it is executed once instead of as a test run plus execution run.
 };
 DECLARE_ENUM_AS_BIT_SET(CommandFlags)
 
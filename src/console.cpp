@@ -15,7 +15,11 @@
 #include "debug.h"
 #include "console_func.h"
 #include "settings_type.h"
+#include "thread.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <stdarg.h>
 
 #include "safeguards.h"
@@ -23,6 +27,89 @@
 static const uint ICON_TOKEN_COUNT = 20;     ///< Maximum number of tokens in one command
 static const uint ICON_MAX_RECURSE = 10;     ///< Maximum number of recursion
 
+/** Maximum number of lines the console output queue may hold; beyond it the oldest lines are dropped. */
+static const size_t MAX_QUEUED_CONSOLE_LINES = 1024;
+
+static std::mutex _console_output_mutex;                ///< Mutex to guard the queue of console output lines.
+static std::condition_variable _console_output_cv;      ///< Signalled when lines are queued or the output thread has to stop.
+static std::deque<std::string> _console_output_queue;   ///< Lines waiting to be written to stdout by the output thread.
+static uint _console_output_dropped = 0;                ///< Number of lines dropped because the queue was full.
+static bool _console_output_active = false;             ///< Whether the console output thread is running.
+static bool _console_output_stop = false;               ///< Tell the console output thread to drain the queue and stop.
+static std::thread _console_output_thread;              ///< The thread writing the queued console output.
+
+/** Write the queued console output to stdout until told to stop. */
+static void ConsoleOutputThread()
+{
+	std::deque<std::string> batch;
+	std::unique_lock<std::mutex> lock(_console_output_mutex);
+	for (;;) {
+		_console_output_cv.wait(lock, []() { return _console_output_stop || !_console_output_queue.empty(); });
+		bool stop = _console_output_stop;
+		batch.swap(_console_output_queue);
+		uint dropped = _console_output_dropped;
+		_console_output_dropped = 0;
+
+		lock.unlock();
+		for (const std::string &line : batch) {
+			fputs(line.c_str(), stdout);
+		}
+		if (dropped != 0) fprintf(stdout, "[console] %u line(s) of output dropped; terminal too slow\n", dropped);
+		fflush(stdout);
+		batch.clear();
+		lock.lock();
+
+		if (stop && _console_output_queue.empty()) return;
+	}
+}
+
+/**
+ * Write a line of console output to stdout. When the output thread runs the
+ * line is merely queued, so a stalled or slow terminal cannot block the game
+ * thread; once the queue is full the oldest lines are dropped instead.
+ * @param line The line to write, including the trailing newline.
+ */
+static void IConsoleWriteStdout(std::string &&line)
+{
+	{
+		std::lock_guard<std::mutex> lock(_console_output_mutex);
+		if (_console_output_active) {
+			if (_console_output_queue.size() >= MAX_QUEUED_CONSOLE_LINES) {
+				_console_output_queue.pop_front();
+				_console_output_dropped++;
+			}
+			_console_output_queue.push_back(std::move(line));
+			_console_output_cv.notify_one();
+			return;
+		}
+	}
+
+	fputs(line.c_str(), stdout);
+	fflush(stdout);
+}
+
+/** Start the thread that performs the actual writing of console output. */
+void IConsoleStartAsyncOutput()
+{
+	std::lock_guard<std::mutex> lock(_console_output_mutex);
+	if (_console_output_active) return;
+	_console_output_stop = false;
+	_console_output_active = StartNewThread(&_console_output_thread, "ottd:console", &ConsoleOutputThread);
+}
+
+/** Stop the console output thread after draining the pending lines. */
+void IConsoleStopAsyncOutput()
+{
+	{
+		std::lock_guard<std::mutex> lock(_console_output_mutex);
+		if (!_console_output_active) return;
+		_console_output_active = false;
+		_console_output_stop = true;
+	}
+	_console_output_cv.notify_one();
+	_console_output_thread.join();
+}
+
 /* console parser */
 /* static */ IConsole::CommandList &IConsole::Commands()
 {
@@ -114,8 +201,7 @@ void IConsolePrint(TextColour colour_code, const std::string &string)
 
 	if (_network_dedicated) {
 		NetworkAdminConsole("console", str);
-		fprintf(stdout, "%s%s\n", GetLogPrefix(), str);
-		fflush(stdout);
+		IConsoleWriteStdout(fmt::format("{}{}\n", GetLogPrefix(), str));
 		IConsoleWriteToLogFile(str);
 		free(str); // free duplicated string since it's not used anymore
 		return;
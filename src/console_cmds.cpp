@@ -31,9 +31,11 @@
 #include "window_func.h"
 #include "date_func.h"
 #include "company_func.h"
+#include "company_base.h"
 #include "gamelog.h"
 #include "ai/ai.hpp"
 #include "ai/ai_config.hpp"
+#include "ai/ai_instance.hpp"
 #include "newgrf.h"
 #include "newgrf_profiling.h"
 #include "console_func.h"
@@ -41,6 +43,8 @@
 #include "road.h"
 #include "rail.h"
 #include "game/game.hpp"
+#include "game/game_instance.hpp"
+#include "core/pool_type.hpp"
 #include "table/strings.h"
 #include "walltime_func.h"
 #include "company_cmd.h"
@@ -1071,6 +1075,7 @@ DEF_CONSOLE_CMD(ConReturn)
 extern bool CloseConsoleLogIfActive();
 extern const std::vector<GRFFile *> &GetAllGRFFiles();
 extern void ConPrintFramerate(); // framerate_gui.cpp
+extern void ConDumpFramerate(); // framerate_gui.cpp
 extern void ShowFramerateWindow();
 
 DEF_CONSOLE_CMD(ConScript)
@@ -2349,6 +2354,17 @@ DEF_CONSOLE_CMD(ConFramerate)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConFramerateDump)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Dump frame rate and tick time percentiles in a machine-readable format.");
+		return true;
+	}
+
+	ConDumpFramerate();
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConFramerateWindow)
 {
 	if (argc == 0) {
@@ -2365,6 +2381,36 @@ DEF_CONSOLE_CMD(ConFramerateWindow)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConMemStats)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Show the memory usage of the object pools and the running scripts.");
+		return true;
+	}
+
+	IConsolePrint(CC_DEFAULT, "{:24} {:>10} {:>10} {:>10} {:>10} {:>10} {:>12}", "Pool", "Items", "Peak", "Capacity", "Item KiB", "Ovh. KiB", "Allocations");
+	size_t total_bytes = 0;
+	for (const PoolBase *pool : *PoolBase::GetPools()) {
+		PoolStats stats = pool->GetStats();
+		IConsolePrint(CC_DEFAULT, "{:24} {:>10} {:>10} {:>10} {:>10} {:>10} {:>12}", stats.name,
+				stats.items, stats.peak_items, stats.capacity,
+				(stats.item_bytes + 1023) / 1024, (stats.overhead_bytes + 1023) / 1024, stats.total_allocs);
+		total_bytes += stats.item_bytes + stats.overhead_bytes;
+	}
+	IConsolePrint(CC_DEFAULT, "Total pool memory: {} KiB.", (total_bytes + 1023) / 1024);
+
+	if (Game::GetInstance() != nullptr) {
+		IConsolePrint(CC_DEFAULT, "Game script: {} KiB.", (Game::GetInstance()->GetAllocatedMemory() + 1023) / 1024);
+	}
+	for (const Company *c : Company::Iterate()) {
+		if (c->is_ai && c->ai_instance != nullptr) {
+			IConsolePrint(CC_DEFAULT, "AI of company {}: {} KiB.", (uint)c->index + 1, (c->ai_instance->GetAllocatedMemory() + 1023) / 1024);
+		}
+	}
+
+	return true;
+}
+
 static void ConDumpRoadTypes()
 {
 	IConsolePrint(CC_DEFAULT, "  Flags:");
@@ -2651,7 +2697,9 @@ void IConsoleStdLibRegister()
 	IConsoleDebugLibRegister();
 #endif
 	IConsole::CmdRegister("fps",                     ConFramerate);
+	IConsole::CmdRegister("fps_dump",                ConFramerateDump);
 	IConsole::CmdRegister("fps_wnd",                 ConFramerateWindow);
+	IConsole::CmdRegister("memstats",                ConMemStats);
 
 	/* NewGRF development stuff */
 	IConsole::CmdRegister("reload_newgrfs",          ConNewGRFReload,     ConHookNewGRFDeveloperTool);
@@ -20,6 +20,8 @@ extern IConsoleModes _iconsole_mode;
 void IConsoleInit();
 void IConsoleFree();
 void IConsoleClose();
+void IConsoleStartAsyncOutput();
+void IConsoleStopAsyncOutput();
 
 /* console output */
 void IConsolePrint(TextColour colour_code, const std::string &string);
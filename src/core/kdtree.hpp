@@ -51,6 +51,7 @@ class Kdtree {
 	size_t root;                   ///< Index of root node
 	TxyFunc xyfunc;                ///< Functor to extract a coordinate from an element
 	size_t unbalanced;             ///< Number approximating how unbalanced the tree might be
+	size_t generation;             ///< Number of mutations the tree has seen, used to invalidate external caches
 
 	/** Create one new node in the tree, return its index in the pool */
 	size_t AddNode(const T &element)
@@ -97,8 +98,8 @@ class Kdtree {
 		}
 	}
 
-	/** Rebuild the tree with all existing elements, optionally adding or removing one more */
-	bool Rebuild(const T *include_element, const T *exclude_element)
+	/** Rebuild the tree with all existing elements, optionally removing one */
+	bool Rebuild(const T *exclude_element)
 	{
 		size_t initial_count = this->Count();
 		if (initial_count < 8) return false; // arbitrary value for "not worth rebalancing"
@@ -107,10 +108,6 @@ class Kdtree {
 		std::vector<T> elements = this->FreeSubtree(this->root);
 		elements.push_back(root_element);
 
-		if (include_element != nullptr) {
-			elements.push_back(*include_element);
-			initial_count++;
-		}
 		if (exclude_element != nullptr) {
 			typename std::vector<T>::iterator removed = std::remove(elements.begin(), elements.end(), *exclude_element);
 			elements.erase(removed, elements.end());
@@ -122,29 +119,71 @@ class Kdtree {
 		return true;
 	}
 
-	/** Insert one element in the tree somewhere below node_idx */
-	void InsertRecursive(const T &element, size_t node_idx, int level)
+	/** Count the number of elements in the sub-tree rooted at the given node */
+	size_t CountSubtree(size_t node_idx) const
 	{
-		/* Dimension index of current level */
-		int dim = level % 2;
-		/* Node reference */
-		node &n = this->nodes[node_idx];
+		if (node_idx == INVALID_NODE) return 0;
+		const node &n = this->nodes[node_idx];
+		return CountSubtree(n.left) + CountSubtree(n.right) + 1;
+	}
 
-		/* Coordinate of element splitting at this node */
-		CoordT nc = this->xyfunc(n.element, dim);
-		/* Coordinate of the new element */
-		CoordT ec = this->xyfunc(element, dim);
-		/* Which side to insert on */
-		size_t &next = (ec < nc) ? n.left : n.right;
-
-		if (next == INVALID_NODE) {
-			/* New leaf */
-			size_t newidx = this->AddNode(element);
-			/* Vector may have been reallocated at this point, n and next are invalid */
-			node &nn = this->nodes[node_idx];
-			if (ec < nc) nn.left = newidx; else nn.right = newidx;
-		} else {
-			this->InsertRecursive(element, next, level + 1);
+	/** Depth an insert may reach before the tree is considered out of balance */
+	int MaxAllowedDepth() const
+	{
+		/* An alpha-weight-balanced tree with alpha = 2/3 is at most
+		 * log(count) base 1.5 deep; a deeper insertion path must contain
+		 * a scapegoat node. */
+		int depth = 0;
+		for (size_t c = this->Count(); c > 1; c = c * 2 / 3) depth++;
+		return depth;
+	}
+
+	/** Rebuild just the sub-tree rooted at the given node, return the index of its new root */
+	size_t RebuildSubtree(size_t node_idx, int level)
+	{
+		T node_element = this->nodes[node_idx].element;
+		std::vector<T> elements = this->FreeSubtree(node_idx);
+		elements.push_back(node_element);
+		this->free_list.push_back(node_idx);
+		return this->BuildSubtree(elements.begin(), elements.end(), level);
+	}
+
+	/**
+	 * Walk an overlong insertion path back towards the root and rebuild the
+	 * deepest ancestor whose children are too far out of balance, the
+	 * "scapegoat". Only that sub-tree is reconstructed, so a single insert
+	 * never pauses to rebuild the entire tree.
+	 * @param path Node indices from the root down to the newly inserted node.
+	 */
+	void RebalanceAfterInsert(const std::vector<size_t> &path)
+	{
+		size_t child_size = 1;
+		for (size_t i = path.size() - 1; i > 0; i--) {
+			size_t parent_idx = path[i - 1];
+			const node &parent = this->nodes[parent_idx];
+			size_t sibling = (parent.left == path[i]) ? parent.right : parent.left;
+			size_t parent_size = child_size + this->CountSubtree(sibling) + 1;
+
+			/* A child carrying more than an alpha = 2/3 share of its
+			 * parent's sub-tree makes the parent the scapegoat. The root
+			 * is used as a fallback in case rounding hid the scapegoat. */
+			if (child_size * 3 > parent_size * 2 || i == 1) {
+				int level = (int)i - 1;
+				size_t new_subtree = this->RebuildSubtree(parent_idx, level);
+				if (level == 0) {
+					this->root = new_subtree;
+				} else {
+					node &grandparent = this->nodes[path[i - 2]];
+					if (grandparent.left == parent_idx) {
+						grandparent.left = new_subtree;
+					} else {
+						grandparent.right = new_subtree;
+					}
+				}
+				return;
+			}
+
+			child_size = parent_size;
 		}
 	}
 
@@ -352,7 +391,14 @@ class Kdtree {
 
 public:
 	/** Construct a new Kdtree with the given xyfunc */
-	Kdtree(TxyFunc xyfunc) : root(INVALID_NODE), xyfunc(xyfunc), unbalanced(0) { }
+	Kdtree(TxyFunc xyfunc) : root(INVALID_NODE), xyfunc(xyfunc), unbalanced(0), generation(0) { }
+
+	/**
+	 * Get the generation of the tree's contents. The generation changes with
+	 * every mutation, so callers caching query results can compare generations
+	 * to learn whether their cache is still valid.
+	 */
+	size_t Generation() const { return this->generation; }
 
 	/**
 	 * Clear and rebuild the tree from a new sequence of elements,
@@ -366,6 +412,7 @@ public:
 		this->nodes.clear();
 		this->free_list.clear();
 		this->unbalanced = 0;
+		this->generation++;
 		if (begin == end) return;
 		this->nodes.reserve(end - begin);
 
@@ -381,6 +428,7 @@ public:
 		this->nodes.clear();
 		this->free_list.clear();
 		this->unbalanced = 0;
+		this->generation++;
 		return;
 	}
 
@@ -389,25 +437,53 @@ public:
 	 */
 	void Rebuild()
 	{
-		this->Rebuild(nullptr, nullptr);
+		this->Rebuild(nullptr);
 	}
 
 	/**
 	 * Insert a single element in the tree.
-	 * Repeatedly inserting single elements may cause the tree to become unbalanced.
+	 * If the insert makes the tree too deep, the smallest out-of-balance
+	 * sub-tree on the insertion path is rebuilt.
 	 * Undefined behaviour if the element already exists in the tree.
 	 */
 	void Insert(const T &element)
 	{
+		this->generation++;
 		if (this->Count() == 0) {
 			this->root = this->AddNode(element);
-		} else {
-			if (!this->IsUnbalanced() || !this->Rebuild(&element, nullptr)) {
-				this->InsertRecursive(element, this->root, 0);
-				this->IncrementUnbalanced();
+			return;
+		}
+
+		/* Descend iteratively, recording the path for rebalancing afterwards */
+		std::vector<size_t> path;
+		size_t node_idx = this->root;
+		int level = 0;
+		for (;;) {
+			path.push_back(node_idx);
+			node &n = this->nodes[node_idx];
+
+			/* Coordinate of element splitting at this node */
+			CoordT nc = this->xyfunc(n.element, level % 2);
+			/* Coordinate of the new element */
+			CoordT ec = this->xyfunc(element, level % 2);
+			/* Which side to insert on */
+			size_t next = (ec < nc) ? n.left : n.right;
+
+			if (next == INVALID_NODE) {
+				/* New leaf */
+				size_t newidx = this->AddNode(element);
+				/* Vector may have been reallocated at this point, n is invalid */
+				node &nn = this->nodes[node_idx];
+				if (ec < nc) nn.left = newidx; else nn.right = newidx;
+				path.push_back(newidx);
+				break;
 			}
-			CheckInvariant();
+			node_idx = next;
+			level++;
 		}
+
+		if ((int)path.size() - 1 > this->MaxAllowedDepth()) this->RebalanceAfterInsert(path);
+		CheckInvariant();
 	}
 
 	/**
@@ -420,7 +496,8 @@ public:
 	{
 		size_t count = this->Count();
 		if (count == 0) return;
-		if (!this->IsUnbalanced() || !this->Rebuild(nullptr, &element)) {
+		this->generation++;
+		if (!this->IsUnbalanced() || !this->Rebuild(&element)) {
 			/* If the removed element is the root node, this modifies this->root */
 			this->root = this->RemoveRecursive(element, this->root, 0);
 			this->IncrementUnbalanced();
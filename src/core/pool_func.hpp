@@ -35,12 +35,13 @@ DEFINE_POOL_METHOD(inline)::Pool(const char *name) :
 		first_free(0),
 		first_unused(0),
 		items(0),
+		peak_items(0),
+		total_allocs(0),
 #ifdef WITH_ASSERT
 		checked(0),
 #endif /* WITH_ASSERT */
 		cleaning(false),
-		data(nullptr),
-		alloc_cache(nullptr)
+		data(nullptr)
 { }
 
 /**
@@ -58,10 +59,13 @@ DEFINE_POOL_METHOD(inline void)::ResizeFor(size_t index)
 
 	this->data = ReallocT(this->data, new_size);
 	MemSetT(this->data + this->size, 0, new_size - this->size);
+	this->used_bitmap.resize((new_size + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS);
+	this->slot_class.resize(new_size);
 
 	this->size = new_size;
 }
 
+
 /**
  * Searches for first free index
  * @return first free index, NO_FREE_ITEM on failure
@@ -70,9 +74,25 @@ DEFINE_POOL_METHOD(inline size_t)::FindFirstFree()
 {
 	size_t index = this->first_free;
 
-	for (; index < this->first_unused; index++) {
-		if (this->data[index] == nullptr) return index;
+	/* Check a whole word of the occupancy bitmap for a zero bit at once. The
+	 * bits at first_unused and above are never set, so the search cannot
+	 * find a different index than the plain scan would. */
+	while (index < this->first_unused) {
+		size_t offset = index % BITMAP_WORD_BITS;
+		uint64 free = ~(this->used_bitmap[index / BITMAP_WORD_BITS] >> offset);
+		/* The shift pulled in zero bits at the top which the inversion turned
+		 * into phantom free bits; mask them off so a fully occupied remainder
+		 * of the word moves the search on instead of landing on the boundary. */
+		if (offset != 0) free &= ~(uint64)0 >> offset;
+		if (free != 0) {
+			index += FindFirstBit(free);
+			break;
+		}
+		index = (index / BITMAP_WORD_BITS + 1) * BITMAP_WORD_BITS;
 	}
+	index = std::min(index, this->first_unused);
+
+	if (index < this->first_unused) return index;
 
 	if (index < this->size) {
 		return index;
@@ -104,22 +124,32 @@ DEFINE_POOL_METHOD(inline void *)::AllocateItem(size_t size, size_t index)
 
 	this->first_unused = std::max(this->first_unused, index + 1);
 	this->items++;
+	this->peak_items = std::max(this->peak_items, this->items);
+	this->total_allocs++;
+	SetBit(this->used_bitmap[index / BITMAP_WORD_BITS], index % BITMAP_WORD_BITS);
+
+	uint8 class_index;
+	SizeClass &sc = this->GetSizeClass(size, class_index);
 
 	Titem *item;
-	if (Tcache && this->alloc_cache != nullptr) {
-		assert(sizeof(Titem) == size);
-		item = (Titem *)this->alloc_cache;
-		this->alloc_cache = this->alloc_cache->next;
+	if (sc.free_list != nullptr) {
+		item = (Titem *)sc.free_list;
+		sc.free_list = sc.free_list->next;
 		if (Tzero) {
 			/* Explicitly casting to (void *) prevents a clang warning -
 			 * we are actually memsetting a (not-yet-constructed) object */
-			memset((void *)item, 0, sizeof(Titem));
+			memset((void *)item, 0, sc.item_size);
 		}
-	} else if (Tzero) {
-		item = (Titem *)CallocT<byte>(size);
 	} else {
-		item = (Titem *)MallocT<byte>(size);
+		if (sc.next_unused == Tgrowth_step) {
+			/* Newest slab is full, add a fresh one */
+			sc.slabs.push_back(Tzero ? CallocT<byte>(Tgrowth_step * sc.item_size) : MallocT<byte>(Tgrowth_step * sc.item_size));
+			sc.next_unused = 0;
+		}
+		item = (Titem *)(sc.slabs.back() + sc.next_unused * sc.item_size);
+		sc.next_unused++;
 	}
+	this->slot_class[index] = class_index;
 	this->data[index] = item;
 	item->index = (Tindex)(uint)index;
 	return item;
@@ -170,7 +200,7 @@ DEFINE_POOL_METHOD(void *)::GetNew(size_t size, size_t index)
 }
 
 /**
- * Deallocates memory used by this index and marks item as free
+ * Returns this index' slot to its slab and marks item as free
  * @param index item to deallocate
  * @pre unit is allocated (non-nullptr)
  * @note 'delete nullptr' doesn't cause call of this function, so it is safe
@@ -179,14 +209,12 @@ DEFINE_POOL_METHOD(void)::FreeItem(size_t index)
 {
 	assert(index < this->size);
 	assert(this->data[index] != nullptr);
-	if (Tcache) {
-		AllocCache *ac = (AllocCache *)this->data[index];
-		ac->next = this->alloc_cache;
-		this->alloc_cache = ac;
-	} else {
-		free(this->data[index]);
-	}
+	SizeClass &sc = this->size_classes[this->slot_class[index]];
+	AllocCache *ac = (AllocCache *)this->data[index];
+	ac->next = sc.free_list;
+	sc.free_list = ac;
 	this->data[index] = nullptr;
+	ClrBit(this->used_bitmap[index / BITMAP_WORD_BITS], index % BITMAP_WORD_BITS);
 	this->first_free = std::min(this->first_free, index);
 	this->items--;
 	if (!this->cleaning) Titem::PostDestructor(index);
@@ -201,17 +229,40 @@ DEFINE_POOL_METHOD(void)::CleanPool()
 	}
 	assert(this->items == 0);
 	free(this->data);
+	this->used_bitmap.clear();
+	this->used_bitmap.shrink_to_fit();
+	this->slot_class.clear();
+	this->slot_class.shrink_to_fit();
 	this->first_unused = this->first_free = this->size = 0;
 	this->data = nullptr;
 	this->cleaning = false;
 
-	if (Tcache) {
-		while (this->alloc_cache != nullptr) {
-			AllocCache *ac = this->alloc_cache;
-			this->alloc_cache = ac->next;
-			free(ac);
-		}
+	for (SizeClass &sc : this->size_classes) {
+		for (byte *slab : sc.slabs) free(slab);
+	}
+	this->size_classes.clear();
+	this->size_classes.shrink_to_fit();
+}
+
+/**
+ * Reports how much memory this pool and its items occupy.
+ * @return usage statistics of this pool.
+ */
+DEFINE_POOL_METHOD(PoolStats)::GetStats() const
+{
+	PoolStats stats{};
+	stats.name = this->name;
+	stats.items = this->items;
+	stats.peak_items = this->peak_items;
+	stats.capacity = this->size;
+	stats.max_size = Tmax_size;
+	stats.total_allocs = this->total_allocs;
+	for (const SizeClass &sc : this->size_classes) {
+		stats.item_bytes += sc.slabs.size() * Tgrowth_step * sc.item_size;
 	}
+	stats.overhead_bytes = this->size * sizeof(Titem *) + this->used_bitmap.capacity() * sizeof(uint64) +
+			this->slot_class.capacity() * sizeof(uint8) + this->size_classes.capacity() * sizeof(SizeClass);
+	return stats;
 }
 
 #undef DEFINE_POOL_METHOD
@@ -225,6 +276,7 @@ DEFINE_POOL_METHOD(void)::CleanPool()
 	template void * name ## Pool::GetNew(size_t size); \
 	template void * name ## Pool::GetNew(size_t size, size_t index); \
 	template void name ## Pool::FreeItem(size_t index); \
-	template void name ## Pool::CleanPool();
+	template void name ## Pool::CleanPool(); \
+	template PoolStats name ## Pool::GetStats() const;
 
 #endif /* POOL_FUNC_HPP */
@@ -11,7 +11,9 @@
 #define POOL_TYPE_HPP
 
 #include "smallvec_type.hpp"
+#include "bitmath_func.hpp"
 #include "enum_type.hpp"
+#include "math_func.hpp"
 
 /** Various types of a pool. */
 enum PoolType {
@@ -26,6 +28,18 @@ DECLARE_ENUM_AS_BIT_SET(PoolType)
 
 typedef std::vector<struct PoolBase *> PoolVector; ///< Vector of pointers to PoolBase
 
+/** Memory usage statistics of a single pool; see PoolBase::GetStats(). */
+struct PoolStats {
+	const char *name;      ///< Name of the pool.
+	size_t items;          ///< Number of items currently in use.
+	size_t peak_items;     ///< Highest number of items in use at the same time.
+	size_t capacity;       ///< Number of indexes the pool can currently address.
+	size_t max_size;       ///< Hard limit on the number of items.
+	size_t item_bytes;     ///< Bytes allocated to the slabs the items live in.
+	size_t overhead_bytes; ///< Bytes allocated to book-keeping (index table, occupancy bitmap, size classes).
+	uint64 total_allocs;   ///< Number of item allocations since the pool was created.
+};
+
 /** Base class for base of all pools. */
 struct PoolBase {
 	const PoolType type; ///< Type of this pool.
@@ -58,6 +72,12 @@ struct PoolBase {
 	 */
 	virtual void CleanPool() = 0;
 
+	/**
+	 * Virtual method that reports the memory usage of the pool.
+	 * @return usage statistics of this pool.
+	 */
+	virtual PoolStats GetStats() const = 0;
+
 private:
 	/**
 	 * Dummy private copy constructor to prevent compilers from
@@ -73,9 +93,8 @@ private:
  * @tparam Tgrowth_step Size of growths; if the pool is full increase the size by this amount
  * @tparam Tmax_size    Maximum size of the pool
  * @tparam Tpool_type   Type of this pool
- * @tparam Tcache       Whether to perform 'alloc' caching, i.e. don't actually free/malloc just reuse the memory
+ * @tparam Tcache       Unused; kept for compatibility of the template signature. Freed items are always reused via the pool's slabs.
  * @tparam Tzero        Whether to zero the memory
- * @warning when Tcache is enabled *all* instances of this pool's item must be of the same size.
  */
 template <class Titem, typename Tindex, size_t Tgrowth_step, size_t Tmax_size, PoolType Tpool_type = PT_NORMAL, bool Tcache = false, bool Tzero = true>
 struct Pool : PoolBase {
@@ -84,12 +103,16 @@ struct Pool : PoolBase {
 
 	static constexpr size_t MAX_SIZE = Tmax_size; ///< Make template parameter accessible from outside
 
+	static constexpr size_t BITMAP_WORD_BITS = 64; ///< Number of indexes tracked per word of #used_bitmap.
+
 	const char * const name; ///< Name of this pool
 
 	size_t size;         ///< Current allocated size
 	size_t first_free;   ///< No item with index lower than this is free (doesn't say anything about this one!)
 	size_t first_unused; ///< This and all higher indexes are free (doesn't say anything about first_unused-1 !)
 	size_t items;        ///< Number of used indexes (non-nullptr)
+	size_t peak_items;   ///< Highest number of used indexes at the same time
+	uint64 total_allocs; ///< Number of item allocations since the pool was created
 #ifdef WITH_ASSERT
 	size_t checked;      ///< Number of items we checked for
 #endif /* WITH_ASSERT */
@@ -97,8 +120,11 @@ struct Pool : PoolBase {
 
 	Titem **data;        ///< Pointer to array of pointers to Titem
 
+	std::vector<uint64> used_bitmap; ///< Occupancy bitmap with one bit per index; a set bit means the index is in use.
+
 	Pool(const char *name);
 	virtual void CleanPool();
+	virtual PoolStats GetStats() const;
 
 	/**
 	 * Returns Titem with given index
@@ -122,6 +148,22 @@ struct Pool : PoolBase {
 		return index < this->first_unused && this->Get(index) != nullptr;
 	}
 
+	/**
+	 * Finds the first used index at or after the given index, skipping whole
+	 * words of free indexes in the occupancy bitmap at once.
+	 * @param index index to start the search at
+	 * @return first used index at or after \a index, or first_unused if there is none
+	 */
+	inline size_t FindNextUsed(size_t index) const
+	{
+		while (index < this->first_unused) {
+			uint64 word = this->used_bitmap[index / BITMAP_WORD_BITS] >> (index % BITMAP_WORD_BITS);
+			if (word != 0) return index + FindFirstBit(word);
+			index = (index / BITMAP_WORD_BITS + 1) * BITMAP_WORD_BITS;
+		}
+		return this->first_unused;
+	}
+
 	/**
 	 * Tests whether we can allocate 'n' items
 	 * @param n number of items we want to allocate
@@ -162,7 +204,8 @@ struct Pool : PoolBase {
 		size_t index;
 		void ValidateIndex()
 		{
-			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index))) this->index++;
+			this->index = T::FindNextUsed(this->index);
+			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index))) this->index = T::FindNextUsed(this->index + 1);
 			if (this->index >= T::GetPoolSize()) this->index = T::Pool::MAX_SIZE;
 		}
 	};
@@ -207,7 +250,8 @@ struct Pool : PoolBase {
 		F filter;
 		void ValidateIndex()
 		{
-			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index) && this->filter(this->index))) this->index++;
+			this->index = T::FindNextUsed(this->index);
+			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index) && this->filter(this->index))) this->index = T::FindNextUsed(this->index + 1);
 			if (this->index >= T::GetPoolSize()) this->index = T::Pool::MAX_SIZE;
 		}
 	};
@@ -360,6 +404,17 @@ struct Pool : PoolBase {
 			return Tpool->first_unused;
 		}
 
+		/**
+		 * Finds the first used index at or after the given index.
+		 * Useful when iterating over all pool items.
+		 * @param index index to start the search at
+		 * @return first used index at or after \a index, or GetPoolSize() if there is none
+		 */
+		static inline size_t FindNextUsed(size_t index)
+		{
+			return Tpool->FindNextUsed(index);
+		}
+
 		/**
 		 * Returns number of valid items in the pool
 		 * @return number of valid items in the pool
@@ -390,16 +445,54 @@ private:
 	static const size_t NO_FREE_ITEM = MAX_UVALUE(size_t); ///< Constant to indicate we can't allocate any more items
 
 	/**
-	 * Helper struct to cache 'freed' PoolItems so we
-	 * do not need to allocate them again.
+	 * Helper struct to link 'freed' PoolItems so their slab
+	 * slots can be handed out again.
 	 */
 	struct AllocCache {
 		/** The next in our 'cache' */
 		AllocCache *next;
 	};
 
-	/** Cache of freed pointers */
-	AllocCache *alloc_cache;
+	/**
+	 * Book-keeping of one allocation size of this pool's items.
+	 * Items of the same size are carved from shared contiguous slabs owned
+	 * by the pool, so iterating the pool touches sequential memory instead
+	 * of chasing individually heap-allocated items.
+	 */
+	struct SizeClass {
+		size_t item_size;          ///< Size in bytes of each slot in this class' slabs
+		size_t next_unused;        ///< Number of slots handed out from the newest slab
+		AllocCache *free_list;     ///< Freed slots available for reuse
+		std::vector<byte *> slabs; ///< Memory slabs owned by this class, each holding #Tgrowth_step slots
+	};
+
+	std::vector<SizeClass> size_classes; ///< All allocation sizes seen for this pool's items
+	std::vector<uint8> slot_class;       ///< Size class each index' item was allocated from, indexed like #data
+
+	/**
+	 * Finds or creates the size class for items of the given size
+	 * @param size size of item being allocated
+	 * @param class_index set to the index of the returned size class
+	 * @return size class whose slabs hold slots of (at least) \a size bytes
+	 */
+	inline SizeClass &GetSizeClass(size_t size, uint8 &class_index)
+	{
+		/* Keep all slots of a class equally sized and properly aligned, so
+		 * slightly different item sizes share slabs. */
+		size_t item_size = Align(size, alignof(std::max_align_t));
+
+		for (size_t i = 0; i < this->size_classes.size(); i++) {
+			if (this->size_classes[i].item_size == item_size) {
+				class_index = (uint8)i;
+				return this->size_classes[i];
+			}
+		}
+
+		assert(this->size_classes.size() < UINT8_MAX);
+		class_index = (uint8)this->size_classes.size();
+		this->size_classes.push_back(SizeClass{ item_size, Tgrowth_step, nullptr, {} });
+		return this->size_classes.back();
+	}
 
 	void *AllocateItem(size_t size, size_t index);
 	void ResizeFor(size_t index);
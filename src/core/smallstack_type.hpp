@@ -11,44 +11,84 @@
 #define SMALLSTACK_TYPE_HPP
 
 #include "smallvec_type.hpp"
+#include <atomic>
 #include <mutex>
 
 /**
  * A simplified pool which stores values instead of pointers and doesn't
  * redefine operator new/delete. It also never zeroes memory and always reuses
  * it.
+ *
+ * The pool is split into independently locked shards and all items of one
+ * stack chain live in the same shard. A stack operation thus only takes its
+ * own shard's lock, so concurrent threads working on unrelated stacks don't
+ * serialize on one global mutex.
  */
 template<typename Titem, typename Tindex, Tindex Tgrowth_step, Tindex Tmax_size>
 class SimplePool {
 public:
-	inline SimplePool() : first_unused(0), first_free(0) {}
+	static const uint NUM_SHARDS = 4; ///< Number of independently locked shards in the pool.
+
+	inline SimplePool() {}
+
+	/**
+	 * Get the shard the item with the given index lives in.
+	 * Indexes are interleaved over the shards, so the whole of [0, Tmax_size)
+	 * stays addressable regardless of how allocations spread over shards.
+	 * @param index Index of the item.
+	 * @return Shard the item lives in.
+	 */
+	static inline uint GetShard(Tindex index) { return index % NUM_SHARDS; }
+
+	/**
+	 * Get the shard a thread should allocate new stack chains from. Threads
+	 * spread round-robin over the shards, so parallel workers tend to push
+	 * to different shards.
+	 * @return Shard index preferred by the current thread.
+	 */
+	static inline uint GetPreferredShard()
+	{
+		static std::atomic<uint> next_shard(0);
+		static thread_local uint shard = next_shard++ % NUM_SHARDS;
+		return shard;
+	}
+
+	/**
+	 * Get the mutex guarding the shard of the given index. We don't lock the
+	 * mutex in the pool methods as the SmallStack isn't necessarily in a
+	 * consistent state after each method.
+	 * @param index Index of an item in the shard to be locked.
+	 * @return Mutex.
+	 */
+	inline std::mutex &GetMutex(Tindex index) { return this->shards[GetShard(index)].mutex; }
 
 	/**
-	 * Get the mutex. We don't lock the mutex in the pool methods as the
-	 * SmallStack isn't necessarily in a consistent state after each method.
+	 * Get the mutex guarding the given shard.
+	 * @param shard Shard to be locked.
 	 * @return Mutex.
 	 */
-	inline std::mutex &GetMutex() { return this->mutex; }
+	inline std::mutex &GetShardMutex(uint shard) { return this->shards[shard].mutex; }
 
 	/**
 	 * Get the item at position index.
 	 * @return Item at index.
 	 */
-	inline Titem &Get(Tindex index) { return this->data[index]; }
+	inline Titem &Get(Tindex index) { return this->shards[GetShard(index)].data[index / NUM_SHARDS]; }
 
 	/**
-	 * Create a new item and return its index.
-	 * @return Index of new item.
+	 * Create a new item in the given shard and return its index.
+	 * @param shard_id Shard to allocate the item in.
+	 * @return Index of new item, Tmax_size if the shard is full.
 	 */
-	inline Tindex Create()
+	inline Tindex Create(uint shard_id)
 	{
-		Tindex index = this->FindFirstFree();
-		if (index < Tmax_size) {
-			this->data[index].valid = true;
-			this->first_free = index + 1;
-			this->first_unused = std::max(this->first_unused, this->first_free);
-		}
-		return index;
+		Shard &shard = this->shards[shard_id];
+		Tindex local = this->FindFirstFree(shard_id);
+		if (local >= shard.data.size()) return Tmax_size;
+		shard.data[local].valid = true;
+		shard.first_free = local + 1;
+		shard.first_unused = std::max(shard.first_unused, shard.first_free);
+		return (Tindex)((uint)local * NUM_SHARDS + shard_id);
 	}
 
 	/**
@@ -57,34 +97,41 @@ public:
 	 */
 	inline void Destroy(Tindex index)
 	{
-		this->data[index].valid = false;
-		this->first_free = std::min(this->first_free, index);
+		Shard &shard = this->shards[GetShard(index)];
+		Tindex local = index / NUM_SHARDS;
+		shard.data[local].valid = false;
+		shard.first_free = std::min(shard.first_free, local);
 	}
 
 private:
 
-	inline Tindex FindFirstFree()
+	struct SimplePoolPoolItem : public Titem {
+		bool valid;
+	};
+
+	/** One independently locked part of the pool. */
+	struct Shard {
+		Tindex first_unused = 0; ///< Lowest local index that was never used yet.
+		Tindex first_free = 0;   ///< Local index to start searching for free slots at.
+		std::mutex mutex;        ///< Mutex guarding this shard's items.
+		std::vector<SimplePoolPoolItem> data; ///< Storage of this shard's items.
+	};
+
+	inline Tindex FindFirstFree(uint shard_id)
 	{
-		Tindex index = this->first_free;
-		for (; index < this->first_unused; index++) {
-			if (!this->data[index].valid) return index;
+		Shard &shard = this->shards[shard_id];
+		Tindex index = shard.first_free;
+		for (; index < shard.first_unused; index++) {
+			if (!shard.data[index].valid) return index;
 		}
 
-		if (index >= this->data.size() && index < Tmax_size) {
-			this->data.resize(index + 1);
+		if (index >= shard.data.size() && (uint)index * NUM_SHARDS + shard_id < Tmax_size) {
+			shard.data.resize(index + 1);
 		}
 		return index;
 	}
 
-	struct SimplePoolPoolItem : public Titem {
-		bool valid;
-	};
-
-	Tindex first_unused;
-	Tindex first_free;
-
-	std::mutex mutex;
-	std::vector<SimplePoolPoolItem> data;
+	Shard shards[NUM_SHARDS];
 };
 
 /**
@@ -122,10 +169,11 @@ struct SmallStackItem {
  * 5. You can choose your own index type, so that you can align it with your
  *    value type. E.G. value types of 16 bits length like to be combined with
  *    index types of the same length.
- * 6. All accesses to the underlying pool are guarded by a mutex and atomic in
- *    the sense that the mutex stays locked until the pool has reacquired a
- *    consistent state. This means that even though a common data structure is
- *    used the SmallStack is still reentrant.
+ * 6. All accesses to the underlying pool are guarded by a per-shard mutex and
+ *    atomic in the sense that the mutex stays locked until the pool has
+ *    reacquired a consistent state. All items of one chain live in the same
+ *    shard, so each operation only needs its own shard's lock and stacks in
+ *    different shards can be used concurrently without contention.
  * @tparam Titem Value type to be used.
  * @tparam Tindex Index type to use for the pool.
  * @tparam Tinvalid Invalid item to keep at the bottom of each stack.
@@ -193,8 +241,11 @@ public:
 	inline void Push(const Titem &item)
 	{
 		if (this->value != Tinvalid) {
-			std::lock_guard<std::mutex> lock(SmallStack::GetPool().GetMutex());
-			Tindex new_item = SmallStack::GetPool().Create();
+			/* Extend an existing chain in its own shard so the whole chain
+			 * stays behind one lock; new chains go to this thread's shard. */
+			uint shard = (this->next != Tmax_size) ? SmallStackPool::GetShard(this->next) : SmallStackPool::GetPreferredShard();
+			std::lock_guard<std::mutex> lock(SmallStack::GetPool().GetShardMutex(shard));
+			Tindex new_item = SmallStack::GetPool().Create(shard);
 			if (new_item != Tmax_size) {
 				PooledSmallStack &pushed = SmallStack::GetPool().Get(new_item);
 				pushed.value = this->value;
@@ -216,7 +267,7 @@ public:
 		if (this->next == Tmax_size) {
 			this->value = Tinvalid;
 		} else {
-			std::lock_guard<std::mutex> lock(SmallStack::GetPool().GetMutex());
+			std::lock_guard<std::mutex> lock(SmallStack::GetPool().GetMutex(this->next));
 			PooledSmallStack &popped = SmallStack::GetPool().Get(this->next);
 			this->value = popped.value;
 			if (popped.branch_count == 0) {
@@ -255,7 +306,7 @@ public:
 	{
 		if (item == Tinvalid || item == this->value) return true;
 		if (this->next != Tmax_size) {
-			std::lock_guard<std::mutex> lock(SmallStack::GetPool().GetMutex());
+			std::lock_guard<std::mutex> lock(SmallStack::GetPool().GetMutex(this->next));
 			const SmallStack *in_list = this;
 			do {
 				in_list = static_cast<const SmallStack *>(
@@ -279,7 +330,7 @@ protected:
 	inline void Branch()
 	{
 		if (this->next != Tmax_size) {
-			std::lock_guard<std::mutex> lock(SmallStack::GetPool().GetMutex());
+			std::lock_guard<std::mutex> lock(SmallStack::GetPool().GetMutex(this->next));
 			++(SmallStack::GetPool().Get(this->next).branch_count);
 		}
 	}
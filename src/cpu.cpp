@@ -9,6 +9,7 @@
 
 #include "stdafx.h"
 #include "core/bitmath_func.hpp"
+#include "cpu.h"
 
 #include "safeguards.h"
 
@@ -115,6 +116,11 @@ void ottd_cpuid(int info[4], int type)
 {
 	__cpuid(info, type);
 }
+
+void ottd_cpuidex(int info[4], int type, int subtype)
+{
+	__cpuidex(info, type, subtype);
+}
 #elif defined(__x86_64__) || defined(__i386)
 void ottd_cpuid(int info[4], int type)
 {
@@ -143,6 +149,26 @@ void ottd_cpuid(int info[4], int type)
 	);
 #endif /* i386 PIC */
 }
+
+void ottd_cpuidex(int info[4], int type, int subtype)
+{
+#if defined(__i386) && defined(__PIC__)
+	/* See ottd_cpuid() for the reasoning behind the ebx juggling. */
+	__asm__ __volatile__ (
+			"xchgl %%ebx, %1 \n\t"
+			"cpuid           \n\t"
+			"xchgl %%ebx, %1 \n\t"
+			: "=a" (info[0]), "=r" (info[1]), "=c" (info[2]), "=d" (info[3])
+			: "a" (type), "c" (subtype)
+	);
+#else
+	__asm__ __volatile__ (
+			"cpuid           \n\t"
+			: "=a" (info[0]), "=b" (info[1]), "=c" (info[2]), "=d" (info[3])
+			: "a" (type), "c" (subtype)
+	);
+#endif /* i386 PIC */
+}
 #elif defined(__e2k__) /* MCST Elbrus 2000*/
 void ottd_cpuid(int info[4], int type)
 {
@@ -161,11 +187,21 @@ void ottd_cpuid(int info[4], int type)
 #endif
 	}
 }
+
+void ottd_cpuidex(int info[4], int type, int subtype)
+{
+	info[0] = info[1] = info[2] = info[3] = 0;
+}
 #else
 void ottd_cpuid(int info[4], int type)
 {
 	info[0] = info[1] = info[2] = info[3] = 0;
 }
+
+void ottd_cpuidex(int info[4], int type, int subtype)
+{
+	info[0] = info[1] = info[2] = info[3] = 0;
+}
 #endif
 
 bool HasCPUIDFlag(uint type, uint index, uint bit)
@@ -178,3 +214,33 @@ bool HasCPUIDFlag(uint type, uint index, uint bit)
 	ottd_cpuid(cpu_info, type);
 	return HasBit(cpu_info[index], bit);
 }
+
+bool HasCPUIDFlagEx(uint type, uint subtype, uint index, uint bit)
+{
+	int cpu_info[4] = {-1};
+	ottd_cpuid(cpu_info, 0);
+	uint max_info_type = cpu_info[0];
+	if (max_info_type < type) return false;
+
+	ottd_cpuidex(cpu_info, type, subtype);
+	return HasBit(cpu_info[index], bit);
+}
+
+/**
+ * Check whether the current CPU supports the given feature.
+ * The CPUID lookups are done once and cached, so this is also suitable
+ * for resolving function variants in hot code.
+ * @param feature The feature to check for.
+ * @return True when the feature is supported.
+ */
+bool HasCPUFeature(CPUFeature feature)
+{
+	static const bool features[CPUF_END] = {
+		HasCPUIDFlag(1, 3, 26), // CPUF_SSE2
+		HasCPUIDFlag(1, 2, 9),  // CPUF_SSSE3
+		HasCPUIDFlag(1, 2, 19), // CPUF_SSE41
+		HasCPUIDFlag(1, 2, 27) && HasCPUIDFlag(1, 2, 28) && HasCPUIDFlagEx(7, 0, 1, 5), // CPUF_AVX2; OSXSAVE + AVX + AVX2
+	};
+	assert(feature < CPUF_END);
+	return features[feature];
+}
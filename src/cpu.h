@@ -23,6 +23,14 @@ uint64 ottd_rdtsc();
  */
 void ottd_cpuid(int info[4], int type);
 
+/**
+ * Get the CPUID information from the CPU, for types with sub-leaves.
+ * @param info    The retrieved info. All zeros on architectures without CPUID.
+ * @param type    The information this instruction should retrieve.
+ * @param subtype The sub-leaf of the information to retrieve.
+ */
+void ottd_cpuidex(int info[4], int type, int subtype);
+
 /**
  * Check whether the current CPU has the given flag.
  * @param type  The type to be passing to cpuid (usually 1).
@@ -32,4 +40,45 @@ void ottd_cpuid(int info[4], int type);
  */
 bool HasCPUIDFlag(uint type, uint index, uint bit);
 
+/**
+ * Check whether the current CPU has the given flag, for types with sub-leaves.
+ * @param type    The type to be passing to cpuid (e.g. 7 for extended features).
+ * @param subtype The sub-leaf to be passing to cpuid.
+ * @param index   The index in the returned info array.
+ * @param bit     The bit index that needs to be set.
+ * @return The value of the bit, or false when there is no CPUID or the type is not available.
+ */
+bool HasCPUIDFlagEx(uint type, uint subtype, uint index, uint bit);
+
+/** CPU features that code can be specialised for at runtime. */
+enum CPUFeature {
+	CPUF_SSE2,  ///< Streaming SIMD Extensions 2.
+	CPUF_SSSE3, ///< Supplemental Streaming SIMD Extensions 3.
+	CPUF_SSE41, ///< Streaming SIMD Extensions 4.1.
+	CPUF_AVX2,  ///< Advanced Vector Extensions 2, including OS support for the wider registers.
+	CPUF_END,   ///< Number of known CPU features.
+};
+
+bool HasCPUFeature(CPUFeature feature);
+
+/**
+ * Select the best available variant of a function for the current CPU.
+ * The candidates are tried in the given order, so list the most capable
+ * variant first. Resolve once at startup and store the result, e.g.:
+ *
+ *   static const auto fill = SelectCPUVariant<FillProc>({{ CPUF_AVX2, &FillAVX2 }, { CPUF_SSE2, &FillSSE2 }}, &FillScalar);
+ *
+ * @param variants Pairs of required CPU feature and function variant.
+ * @param fallback Variant to use when no candidate is supported.
+ * @return The first supported variant, or the fallback.
+ */
+template <typename Tfunc>
+Tfunc SelectCPUVariant(std::initializer_list<std::pair<CPUFeature, Tfunc>> variants, Tfunc fallback)
+{
+	for (const auto &variant : variants) {
+		if (HasCPUFeature(variant.first)) return variant.second;
+	}
+	return fallback;
+}
+
 #endif /* CPU_H */
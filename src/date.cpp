@@ -233,13 +233,12 @@ static void OnNewMonth()
 	}
 
 	SetWindowClassesDirty(WC_CHEATS);
-	CompaniesMonthlyLoop();
 	EnginesMonthlyLoop();
-	TownsMonthlyLoop();
-	IndustryMonthlyLoop();
 	SubsidyMonthlyLoop();
-	StationMonthlyLoop();
 	if (_network_server) NetworkServerMonthlyLoop();
+
+	/* The expensive monthly pool sweeps (companies, towns, industries and
+	 * stations) run spread over the following ticks; see RunDeferredDateEvents(). */
 }
 
 /**
@@ -257,12 +256,45 @@ static void OnNewDay()
 	IndustryDailyLoop();
 
 	SetWindowWidgetDirty(WC_STATUS_BAR, 0, WID_S_LEFT);
-	EnginesDailyLoop();
 
 	/* Refresh after possible snowline change */
 	SetWindowClassesDirty(WC_TOWN_VIEW);
 }
 
+/**
+ * Runs the deferred daily and monthly procedures, one per tick, on the ticks
+ * following a day boundary. Spreading the pool sweeps flattens the periodic
+ * tick spike the combined sweeps used to cause.
+ *
+ * The schedule is derived purely from #_date and #_date_fract, which are part
+ * of the savegame; a client joining mid-day therefore resumes it in lockstep
+ * with the server.
+ */
+static void RunDeferredDateEvents()
+{
+	static_assert(DAY_TICKS > 5); // the deferred slots below must fit within one day
+
+	if (_date_fract == 1) {
+		EnginesDailyLoop();
+		return;
+	}
+
+	if (_date_fract < 2 || _date_fract > 5) return;
+
+	/* The monthly sweeps are scheduled on the first day of the month. */
+	YearMonthDay ymd;
+	ConvertDateToYMD(_date, &ymd);
+	if (ymd.day != 1) return;
+
+	switch (_date_fract) {
+		case 2: CompaniesMonthlyLoop(); break;
+		case 3: TownsMonthlyLoop();     break;
+		case 4: IndustryMonthlyLoop(); break;
+		case 5: StationMonthlyLoop();  break;
+		default: NOT_REACHED();
+	}
+}
+
 /**
  * Increases the tick counter, increases date  and possibly calls
  * procedures that have to be called daily, monthly or yearly.
@@ -275,7 +307,10 @@ void IncreaseDate()
 	if (_game_mode == GM_MENU) return;
 
 	_date_fract++;
-	if (_date_fract < DAY_TICKS) return;
+	if (_date_fract < DAY_TICKS) {
+		RunDeferredDateEvents();
+		return;
+	}
 	_date_fract = 0;
 
 	/* increase day counter */
@@ -14,6 +14,8 @@
 #include "string_func.h"
 #include "fileio_func.h"
 #include "settings_type.h"
+#include "thread.h"
+#include <condition_variable>
 #include <mutex>
 
 #if defined(_WIN32)
@@ -37,6 +39,94 @@ std::mutex _debug_remote_console_mutex; ///< Mutex to guard the queue of debug m
 std::vector<QueuedDebugItem> _debug_remote_console_queue; ///< Queue for debug messages to be passed to NetworkAdminConsole or IConsolePrint.
 std::vector<QueuedDebugItem> _debug_remote_console_queue_spare; ///< Spare queue to swap with _debug_remote_console_queue.
 
+/** A formatted debug line queued for the writer thread. */
+struct QueuedDebugLine {
+	FILE *file;       ///< Stream to write the line to; \c nullptr means stderr.
+	std::string line; ///< The fully formatted line, including the trailing newline.
+};
+
+static std::mutex _debug_writer_mutex;                  ///< Mutex to guard the queue of lines for the writer thread.
+static std::condition_variable _debug_writer_cv;        ///< Signalled when lines are queued or the writer has to stop.
+static std::vector<QueuedDebugLine> _debug_writer_queue; ///< Lines waiting to be written by the writer thread.
+static bool _debug_writer_active = false;               ///< Whether the writer thread is running.
+static bool _debug_writer_stop = false;                 ///< Tell the writer thread to drain the queue and stop.
+static std::thread _debug_writer_thread;                ///< The thread writing the queued debug lines.
+
+/** Write the queued debug lines to their streams until told to stop. */
+static void DebugWriterThread()
+{
+	std::vector<QueuedDebugLine> batch;
+	std::unique_lock<std::mutex> lock(_debug_writer_mutex);
+	for (;;) {
+		_debug_writer_cv.wait(lock, []() { return _debug_writer_stop || !_debug_writer_queue.empty(); });
+		bool stop = _debug_writer_stop;
+		batch.swap(_debug_writer_queue);
+
+		lock.unlock();
+		FILE *to_flush = nullptr;
+		for (const QueuedDebugLine &item : batch) {
+			if (item.file == nullptr) {
+				fputs(item.line.c_str(), stderr);
+			} else {
+				/* Flush log files once per batch instead of once per line. */
+				if (to_flush != nullptr && to_flush != item.file) fflush(to_flush);
+				fputs(item.line.c_str(), item.file);
+				to_flush = item.file;
+			}
+		}
+		if (to_flush != nullptr) fflush(to_flush);
+		batch.clear();
+		lock.lock();
+
+		if (stop && _debug_writer_queue.empty()) return;
+	}
+}
+
+/**
+ * Hand a formatted debug line to the writer thread, so the calling thread
+ * does not wait for the actual (flushed) write. Before the thread is started
+ * and after it is stopped the line is written synchronously instead.
+ * @param file Stream to write the line to; \c nullptr means stderr.
+ * @param line The line to write, including the trailing newline.
+ */
+static void DebugWriteLine(FILE *file, std::string &&line)
+{
+	{
+		std::lock_guard<std::mutex> lock(_debug_writer_mutex);
+		if (_debug_writer_active) {
+			_debug_writer_queue.push_back({ file, std::move(line) });
+			_debug_writer_cv.notify_one();
+			return;
+		}
+	}
+
+	FILE *f = file == nullptr ? stderr : file;
+	fputs(line.c_str(), f);
+	if (file != nullptr) fflush(file);
+}
+
+/** Start the thread that performs the actual writing of debug lines. */
+void DebugStartWriterThread()
+{
+	std::lock_guard<std::mutex> lock(_debug_writer_mutex);
+	if (_debug_writer_active) return;
+	_debug_writer_stop = false;
+	_debug_writer_active = StartNewThread(&_debug_writer_thread, "ottd:debug", &DebugWriterThread);
+}
+
+/** Stop the debug writer thread after draining the pending lines. */
+void DebugStopWriterThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(_debug_writer_mutex);
+		if (!_debug_writer_active) return;
+		_debug_writer_active = false;
+		_debug_writer_stop = true;
+	}
+	_debug_writer_cv.notify_one();
+	_debug_writer_thread.join();
+}
+
 int _debug_driver_level;
 int _debug_grf_level;
 int _debug_map_level;
@@ -132,19 +222,16 @@ void DebugPrint(const char *level, const std::string &message)
 		static FILE *f = FioFOpenFile("commands-out.log", "wb", AUTOSAVE_DIR);
 		if (f == nullptr) return;
 
-		fprintf(f, "%s%s\n", GetLogPrefix(), message.c_str());
-		fflush(f);
+		DebugWriteLine(f, fmt::format("{}{}\n", GetLogPrefix(), message));
 #ifdef RANDOM_DEBUG
 	} else if (strcmp(level, "random") == 0) {
 		static FILE *f = FioFOpenFile("random-out.log", "wb", AUTOSAVE_DIR);
 		if (f == nullptr) return;
 
-		fprintf(f, "%s\n", message.c_str());
-		fflush(f);
+		DebugWriteLine(f, fmt::format("{}\n", message));
 #endif
 	} else {
-		std::string msg = fmt::format("{}dbg: [{}] {}\n", GetLogPrefix(), level, message);
-		fputs(msg.c_str(), stderr);
+		DebugWriteLine(nullptr, fmt::format("{}dbg: [{}] {}\n", GetLogPrefix(), level, message));
 
 		if (_debug_remote_console.load()) {
 			/* Only add to the queue when there is at least one consumer of the data. */
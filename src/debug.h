@@ -28,13 +28,23 @@
  * 6.. - extremely detailed spamming
  */
 
+/**
+ * Maximum debug level that is compiled into the binary. Debug() calls with a
+ * higher level are removed at compile time, their formatting included; the
+ * default keeps all levels. Performance sensitive builds can define a lower
+ * cap from the build system.
+ */
+#ifndef MAX_DEBUG_LEVEL
+#define MAX_DEBUG_LEVEL 10
+#endif
+
 /**
  * Ouptut a line of debugging information.
  * @param name The category of debug information.
  * @param level The maximum debug level this message should be shown at. When the debug level for this category is set lower, then the message will not be shown.
  * @param format_string The formatting string of the message.
  */
-#define Debug(name, level, format_string, ...) if ((level) == 0 || _debug_ ## name ## _level >= (level)) DebugPrint(#name, fmt::format(FMT_STRING(format_string), ## __VA_ARGS__))
+#define Debug(name, level, format_string, ...) if ((level) == 0 || ((level) <= MAX_DEBUG_LEVEL && _debug_ ## name ## _level >= (level))) DebugPrint(#name, fmt::format(FMT_STRING(format_string), ## __VA_ARGS__))
 void DebugPrint(const char *level, const std::string &message);
 
 extern int _debug_driver_level;
@@ -125,4 +135,7 @@ const char *GetLogPrefix();
 void DebugSendRemoteMessages();
 void DebugReconsiderSendRemoteMessages();
 
+void DebugStartWriterThread();
+void DebugStopWriterThread();
+
 #endif /* DEBUG_H */
@@ -9,12 +9,15 @@
 
 #include "stdafx.h"
 #include "depot_base.h"
+#include "depot_func.h"
 #include "order_backup.h"
 #include "order_func.h"
 #include "window_func.h"
 #include "core/pool_func.hpp"
+#include "core/kdtree.hpp"
 #include "vehicle_gui.h"
 #include "vehiclelist.h"
+#include <map>
 
 #include "safeguards.h"
 
@@ -22,11 +25,64 @@
 DepotPool _depot_pool("Depot");
 INSTANTIATE_POOL_METHODS(Depot)
 
+static inline uint16 Kdtree_DepotXYFunc(DepotID did, int dim) { return (dim == 0) ? TileX(Depot::Get(did)->xy) : TileY(Depot::Get(did)->xy); }
+typedef Kdtree<DepotID, decltype(&Kdtree_DepotXYFunc), uint16, int> DepotKdtree;
+
+/**
+ * The k-d trees over the depot positions, one per owner and vehicle type,
+ * built on demand and dropped whenever a depot is added, removed or changes
+ * owner. Rebuilding is cheap compared to the queries saved, as depots come
+ * and go far less often than vehicles look for one.
+ */
+static std::map<uint, DepotKdtree> _depot_kdtrees;
+
+/** Make the key of the k-d tree holding the depots of the given owner and vehicle type. */
+static inline uint DepotKdtreeKey(Owner owner, VehicleType type)
+{
+	return owner << 2 | type;
+}
+
+/** Drop all depot k-d trees; they are rebuilt on the next query. */
+void InvalidateDepotKdtrees()
+{
+	_depot_kdtrees.clear();
+}
+
+/**
+ * Find the depot of the given owner and vehicle type closest to a tile,
+ * measured in Manhattan distance. This only preselects a candidate; whether
+ * the depot can actually be reached is for the caller (or its pathfinder)
+ * to decide.
+ * @param tile  Tile to search from.
+ * @param owner Owner the depot must belong to.
+ * @param type  Vehicle type the depot must serve.
+ * @return Tile of the closest depot, or INVALID_TILE if the owner has no such depot.
+ */
+TileIndex FindClosestDepotCandidate(TileIndex tile, Owner owner, VehicleType type)
+{
+	auto it = _depot_kdtrees.find(DepotKdtreeKey(owner, type));
+	if (it == _depot_kdtrees.end()) {
+		std::vector<DepotID> depots;
+		for (const Depot *d : Depot::Iterate()) {
+			/* It can happen there is no depot here anymore (TTO/TTD savegames) */
+			if (!IsDepotTile(d->xy) || GetDepotIndex(d->xy) != d->index) continue;
+			if (GetTileOwner(d->xy) == owner && GetDepotVehicleType(d->xy) == type) depots.push_back(d->index);
+		}
+		it = _depot_kdtrees.emplace(DepotKdtreeKey(owner, type), DepotKdtree(&Kdtree_DepotXYFunc)).first;
+		it->second.Build(depots.begin(), depots.end());
+	}
+
+	if (it->second.Count() == 0) return INVALID_TILE;
+	return Depot::Get(it->second.FindNearest(TileX(tile), TileY(tile)))->xy;
+}
+
 /**
  * Clean up a depot
  */
 Depot::~Depot()
 {
+	InvalidateDepotKdtrees();
+
 	if (CleaningPool()) return;
 
 	if (!IsDepotTile(this->xy) || GetDepotIndex(this->xy) != this->index) {
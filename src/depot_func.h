@@ -11,11 +11,15 @@
 #define DEPOT_FUNC_H
 
 #include "vehicle_type.h"
+#include "company_type.h"
 #include "slope_func.h"
 
 void ShowDepotWindow(TileIndex tile, VehicleType type);
 void InitDepotWindowBlockSizes();
 
+TileIndex FindClosestDepotCandidate(TileIndex tile, Owner owner, VehicleType type);
+void InvalidateDepotKdtrees();
+
 void DeleteDepotHighlightOfVehicle(const Vehicle *v);
 
 /**
@@ -32,6 +32,7 @@
 #include "vehicle_func.h"
 #include "sound_func.h"
 #include "autoreplace_func.h"
+#include "depot_func.h"
 #include "company_gui.h"
 #include "signs_base.h"
 #include "subsidy_base.h"
@@ -51,6 +52,7 @@
 #include "company_cmd.h"
 #include "economy_cmd.h"
 #include "vehicle_cmd.h"
+#include "state_checksum.h"
 
 #include "table/strings.h"
 #include "table/pricebase.h"
@@ -103,50 +105,61 @@ static PriceMultipliers _price_base_multiplier;
 
 extern int GetAmountOwnedBy(const Company *c, Owner owner);
 
+/** Per-company asset totals for the company value and performance rating. */
+struct CompanyAssetTotals {
+	uint stations;            ///< Facilities over all stations of the company.
+	uint serviced_stations;   ///< Facilities over the stations that were recently loaded or unloaded at.
+	uint profitable_vehicles; ///< Primary vehicles that made a profit last year.
+	Money min_profit;         ///< Lowest profit last year of the primary vehicles older than two years.
+	bool min_profit_set;      ///< Whether #min_profit is valid, i.e. such a vehicle exists.
+	Money vehicle_value;      ///< Value of all vehicles, already scaled for the company value.
+};
+
 /**
- * Calculate the value of the company. That is the value of all
- * assets (vehicles, stations, shares) and money minus the loan,
- * except when including_loan is \c false which is useful when
- * we want to calculate the value for bankruptcy.
- * @param c the company to get the value of.
- * @param including_loan include the loan in the company value.
- * @return the value of the company.
+ * Gather the asset totals of all companies in a single pass over the station
+ * and vehicle pools, so they do not have to be rescanned for every company.
+ * @param[out] totals The totals, indexed by company index.
  */
-Money CalculateCompanyValue(const Company *c, bool including_loan)
+static void GatherCompanyAssetTotals(CompanyAssetTotals *totals)
 {
-	Money owned_shares_value = 0;
-
-	for (const Company *co : Company::Iterate()) {
-		int shares_owned = GetAmountOwnedBy(co, c->index);
-
-		if (shares_owned > 0) owned_shares_value += (CalculateCompanyValueExcludingShares(co) / 4) * shares_owned;
-	}
-
-	return owned_shares_value + CalculateCompanyValueExcludingShares(c);
-}
-
-Money CalculateCompanyValueExcludingShares(const Company *c, bool including_loan)
-{
-	Owner owner = c->index;
-
-	uint num = 0;
+	for (uint i = 0; i < MAX_COMPANIES; i++) totals[i] = {};
 
 	for (const Station *st : Station::Iterate()) {
-		if (st->owner == owner) num += CountBits((byte)st->facilities);
+		if (!Company::IsValidID(st->owner)) continue;
+		uint facilities = CountBits((byte)st->facilities);
+		totals[st->owner].stations += facilities;
+		/* Only count stations that are actually serviced for the rating. */
+		if (st->time_since_load <= 20 || st->time_since_unload <= 20) totals[st->owner].serviced_stations += facilities;
 	}
 
-	Money value = num * _price[PR_STATION_VALUE] * 25;
-
 	for (const Vehicle *v : Vehicle::Iterate()) {
-		if (v->owner != owner) continue;
+		if (!Company::IsValidID(v->owner)) continue;
+		CompanyAssetTotals &t = totals[v->owner];
 
 		if (v->type == VEH_TRAIN ||
 				v->type == VEH_ROAD ||
 				(v->type == VEH_AIRCRAFT && Aircraft::From(v)->IsNormalAircraft()) ||
 				v->type == VEH_SHIP) {
-			value += v->value * 3 >> 1;
+			t.vehicle_value += v->value * 3 >> 1;
+		}
+
+		if (IsCompanyBuildableVehicleType(v->type) && v->IsPrimaryVehicle()) {
+			if (v->profit_last_year > 0) t.profitable_vehicles++; // For the vehicle score only count profitable vehicles
+			if (v->age > 730 && (!t.min_profit_set || t.min_profit > v->profit_last_year)) {
+				/* Remember the vehicle with the lowest amount of profit */
+				t.min_profit = v->profit_last_year;
+				t.min_profit_set = true;
+			}
 		}
 	}
+}
+
+/** As CalculateCompanyValueExcludingShares(), but with the asset totals already gathered. */
+static Money CalculateCompanyValueExcludingShares(const Company *c, const CompanyAssetTotals *totals, bool including_loan)
+{
+	Money value = totals[c->index].stations * _price[PR_STATION_VALUE] * 25;
+
+	value += totals[c->index].vehicle_value;
 
 	/* Add real money value */
 	if (including_loan) value -= c->current_loan;
@@ -155,15 +168,55 @@ Money CalculateCompanyValueExcludingShares(const Company *c, bool including_loan
 	return std::max<Money>(value, 1);
 }
 
+/** As CalculateCompanyValue(), but with the asset totals already gathered. */
+static Money CalculateCompanyValue(const Company *c, const CompanyAssetTotals *totals, bool including_loan)
+{
+	Money owned_shares_value = 0;
+
+	for (const Company *co : Company::Iterate()) {
+		int shares_owned = GetAmountOwnedBy(co, c->index);
+
+		if (shares_owned > 0) owned_shares_value += (CalculateCompanyValueExcludingShares(co, totals, true) / 4) * shares_owned;
+	}
+
+	return owned_shares_value + CalculateCompanyValueExcludingShares(c, totals, including_loan);
+}
+
+/**
+ * Calculate the value of the company. That is the value of all
+ * assets (vehicles, stations, shares) and money minus the loan,
+ * except when including_loan is \c false which is useful when
+ * we want to calculate the value for bankruptcy.
+ * @param c the company to get the value of.
+ * @param including_loan include the loan in the company value.
+ * @return the value of the company.
+ */
+Money CalculateCompanyValue(const Company *c, bool including_loan)
+{
+	CompanyAssetTotals totals[MAX_COMPANIES];
+	GatherCompanyAssetTotals(totals);
+
+	return CalculateCompanyValue(c, totals, including_loan);
+}
+
+Money CalculateCompanyValueExcludingShares(const Company *c, bool including_loan)
+{
+	CompanyAssetTotals totals[MAX_COMPANIES];
+	GatherCompanyAssetTotals(totals);
+
+	return CalculateCompanyValueExcludingShares(c, totals, including_loan);
+}
+
 /**
  * if update is set to true, the economy is updated with this score
  *  (also the house is updated, should only be true in the on-tick event)
  * @param update the economy with calculated score
  * @param c company been evaluated
+ * @param totals asset totals of all companies
  * @return actual score of this company
  *
  */
-int UpdateCompanyRatingAndValue(Company *c, bool update)
+static int UpdateCompanyRatingAndValue(Company *c, bool update, const CompanyAssetTotals *totals)
 {
 	Owner owner = c->index;
 	int score = 0;
@@ -172,27 +225,11 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 
 	/* Count vehicles */
 	{
-		Money min_profit = 0;
-		bool min_profit_first = true;
-		uint num = 0;
-
-		for (const Vehicle *v : Vehicle::Iterate()) {
-			if (v->owner != owner) continue;
-			if (IsCompanyBuildableVehicleType(v->type) && v->IsPrimaryVehicle()) {
-				if (v->profit_last_year > 0) num++; // For the vehicle score only count profitable vehicles
-				if (v->age > 730) {
-					/* Find the vehicle with the lowest amount of profit */
-					if (min_profit_first || min_profit > v->profit_last_year) {
-						min_profit = v->profit_last_year;
-						min_profit_first = false;
-					}
-				}
-			}
-		}
+		Money min_profit = totals[owner].min_profit_set ? totals[owner].min_profit : Money(0);
 
 		min_profit >>= 8; // remove the fract part
 
-		_score_part[owner][SCORE_VEHICLES] = num;
+		_score_part[owner][SCORE_VEHICLES] = totals[owner].profitable_vehicles;
 		/* Don't allow negative min_profit to show */
 		if (min_profit > 0) {
 			_score_part[owner][SCORE_MIN_PROFIT] = min_profit;
@@ -201,12 +238,7 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 
 	/* Count stations */
 	{
-		uint num = 0;
-		for (const Station *st : Station::Iterate()) {
-			/* Only count stations that are actually serviced */
-			if (st->owner == owner && (st->time_since_load <= 20 || st->time_since_unload <= 20)) num += CountBits((byte)st->facilities);
-		}
-		_score_part[owner][SCORE_STATIONS] = num;
+		_score_part[owner][SCORE_STATIONS] = totals[owner].serviced_stations;
 	}
 
 	/* Generate statistics depending on recent income statistics */
@@ -284,13 +316,22 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 	if (update) {
 		c->old_economy[0].performance_history = score;
 		UpdateCompanyHQ(c->location_of_HQ, score);
-		c->old_economy[0].company_value = CalculateCompanyValue(c);
+		c->old_economy[0].company_value = CalculateCompanyValue(c, totals, true);
 	}
 
 	SetWindowDirty(WC_PERFORMANCE_DETAIL, 0);
 	return score;
 }
 
+/** As UpdateCompanyRatingAndValue() above, gathering the asset totals itself. */
+int UpdateCompanyRatingAndValue(Company *c, bool update)
+{
+	CompanyAssetTotals totals[MAX_COMPANIES];
+	GatherCompanyAssetTotals(totals);
+
+	return UpdateCompanyRatingAndValue(c, update, totals);
+}
+
 /**
  * Change the ownership of all the items of a company.
  * @param old_owner The company that gets removed.
@@ -493,6 +534,9 @@ void ChangeOwnershipOfCompanyItems(Owner old_owner, Owner new_owner)
 			ChangeTileOwner(tile, old_owner, new_owner);
 		} while (++tile != Map::Size());
 
+		/* The depots changed owner together with their tiles. */
+		InvalidateDepotKdtrees();
+
 		if (new_owner != INVALID_OWNER) {
 			/* Update all signals because there can be new segment that was owned by two companies
 			 * and signals were not propagated
@@ -692,6 +736,11 @@ static void CompaniesGenStatistics()
 	/* Only run the economic statics and update company stats every 3rd month (1st of quarter). */
 	if (!HasBit(1 << 0 | 1 << 3 | 1 << 6 | 1 << 9, _cur_month)) return;
 
+	/* The ratings and company values below all derive from the same station
+	 * and vehicle scans; gather the totals once instead of per company. */
+	CompanyAssetTotals totals[MAX_COMPANIES];
+	GatherCompanyAssetTotals(totals);
+
 	for (Company *c : Company::Iterate()) {
 		/* Drop the oldest history off the end */
 		std::copy_backward(c->old_economy, c->old_economy + MAX_HISTORY_QUARTERS - 1, c->old_economy + MAX_HISTORY_QUARTERS);
@@ -700,7 +749,7 @@ static void CompaniesGenStatistics()
 
 		if (c->num_valid_stat_ent != MAX_HISTORY_QUARTERS) c->num_valid_stat_ent++;
 
-		UpdateCompanyRatingAndValue(c, true);
+		UpdateCompanyRatingAndValue(c, true, totals);
 		if (c->block_preview != 0) c->block_preview--;
 	}
 
@@ -999,25 +1048,8 @@ Money GetTransportedGoodsIncome(uint num_pieces, uint dist, byte transit_days, C
 		}
 	}
 
-	static const int MIN_TIME_FACTOR = 31;
-	static const int MAX_TIME_FACTOR = 255;
-
-	const int days1 = cs->transit_days[0];
-	const int days2 = cs->transit_days[1];
-	const int days_over_days1 = std::max(   transit_days - days1, 0);
-	const int days_over_days2 = std::max(days_over_days1 - days2, 0);
-
-	/*
-	 * The time factor is calculated based on the time it took
-	 * (transit_days) compared two cargo-depending values. The
-	 * range is divided into three parts:
-	 *
-	 *  - constant for fast transits
-	 *  - linear decreasing with time with a slope of -1 for medium transports
-	 *  - linear decreasing with time with a slope of -2 for slow transports
-	 *
-	 */
-	const int time_factor = std::max(MAX_TIME_FACTOR - days_over_days1 - days_over_days2, MIN_TIME_FACTOR);
+	/* The three-part transit time curve is precomputed per cargo type; see CargoSpec::InitTimeFactors(). */
+	const int time_factor = cs->time_factors[transit_days];
 
 	return BigMulS(dist * time_factor * num_pieces, cs->current_payment, 21);
 }
@@ -1099,6 +1131,8 @@ static Money DeliverGoods(int num_pieces, CargoID cargo_type, StationID dest, Ti
 
 	Station *st = Station::Get(dest);
 
+	_state_checksums.UpdateCargo(dest ^ (uint32)cargo_type << 16 ^ num_pieces);
+
 	/* Give the goods to the industry. */
 	uint accepted_ind = DeliverGoodsToIndustry(st, cargo_type, num_pieces, src_type == ST_INDUSTRY ? src : INVALID_INDUSTRY, company->index);
 
@@ -1613,8 +1647,10 @@ static void UpdateLoadUnloadTicks(Vehicle *front, const Station *st, int ticks)
 /**
  * Loads/unload the vehicle if possible.
  * @param front the vehicle to be (un)loaded
+ * @return Whether the waiting cargo of the station changed, so the caller can
+ *         batch the station invalidations over all vehicles loading there.
  */
-static void LoadUnloadVehicle(Vehicle *front)
+static bool LoadUnloadVehicle(Vehicle *front)
 {
 	assert(front->current_order.IsType(OT_LOADING));
 
@@ -1632,14 +1668,14 @@ static void LoadUnloadVehicle(Vehicle *front)
 	}
 
 	/* We have not waited enough time till the next round of loading/unloading */
-	if (front->load_unload_ticks != 0) return;
+	if (front->load_unload_ticks != 0) return false;
 
 	if (front->type == VEH_TRAIN && (!IsTileType(front->tile, MP_STATION) || GetStationIndex(front->tile) != st->index)) {
 		/* The train reversed in the station. Take the "easy" way
 		 * out and let the train just leave as it always did. */
 		SetBit(front->vehicle_flags, VF_LOADING_FINISHED);
 		front->load_unload_ticks = 1;
-		return;
+		return false;
 	}
 
 	int new_load_unload_ticks = 0;
@@ -1912,11 +1948,8 @@ static void LoadUnloadVehicle(Vehicle *front)
 		SetWindowDirty(WC_VEHICLE_DETAILS, front->index);
 		front->MarkDirty();
 	}
-	if (dirty_station) {
-		st->MarkTilesDirty(true);
-		SetWindowDirty(WC_STATION_VIEW, last_visited);
-		InvalidateWindowData(WC_STATION_LIST, last_visited);
-	}
+
+	return dirty_station;
 }
 
 /**
@@ -1951,12 +1984,22 @@ void LoadUnloadStation(Station *st)
 	 */
 	if (last_loading == nullptr) return;
 
+	/* The station invalidations are batched over all loading vehicles;
+	 * marking all station tiles dirty once per consist adds up quickly
+	 * on stations with many platforms. */
+	bool dirty_station = false;
 	for (iter = st->loading_vehicles.begin(); iter != st->loading_vehicles.end(); ++iter) {
 		Vehicle *v = *iter;
-		if (!(v->vehstatus & (VS_STOPPED | VS_CRASHED))) LoadUnloadVehicle(v);
+		if (!(v->vehstatus & (VS_STOPPED | VS_CRASHED))) dirty_station |= LoadUnloadVehicle(v);
 		if (v == last_loading) break;
 	}
 
+	if (dirty_station) {
+		st->MarkTilesDirty(true);
+		SetWindowDirty(WC_STATION_VIEW, st->index);
+		InvalidateWindowData(WC_STATION_LIST, st->index);
+	}
+
 	/* Call the production machinery of industries */
 	for (Industry *iid : _cargo_delivery_destinations) {
 		TriggerIndustryProduction(iid);
@@ -63,10 +63,69 @@
 #include "company_base.h"
 #include "newgrf_railtype.h"
 
+#include <mutex>
+#include <unordered_map>
+
 #include "table/elrail_data.h"
 
 #include "safeguards.h"
 
+/** A catenary sprite of a tile, as it is passed to AddSortableSpriteToDraw(). */
+struct CachedCatenarySprite {
+	SpriteID image;  ///< Sprite to draw.
+	int x;           ///< X position of the sprite.
+	int y;           ///< Y position of the sprite.
+	int x_size;      ///< X extent of the bounding box.
+	int y_size;      ///< Y extent of the bounding box.
+	int z_size;      ///< Z extent of the bounding box.
+	int z;           ///< Z position of the sprite.
+	int bb_offset_x; ///< Bounding box extent relative to the sprite X position.
+	int bb_offset_y; ///< Bounding box extent relative to the sprite Y position.
+};
+
+/**
+ * Cached catenary sprites of the drawn tiles. Deriving the wire and pylon
+ * positions from the surrounding track layout is expensive, while the result
+ * only changes when one of the surrounding tiles changes; the cache entries
+ * are dropped from MarkTileDirtyByTile() when that happens.
+ */
+static std::unordered_map<uint32, std::vector<CachedCatenarySprite>> _catenary_cache;
+
+/** Protects #_catenary_cache; viewport sprite collection draws tiles from several threads at once. */
+static std::mutex _catenary_cache_mutex;
+
+/** Number of cached tiles above which the catenary cache is flushed. */
+static const size_t CATENARY_CACHE_MAX_SIZE = 1 << 16;
+
+/**
+ * Forget the cached catenary sprites of the tiles around a changed tile.
+ * The catenary of a tile depends on the tracks and slopes of the neighbouring
+ * tiles, whose wires are in turn masked based on their own neighbours, so all
+ * tiles within a distance of two may be affected by the change.
+ * @param tile The tile that changed.
+ */
+void NotifyRailCatenaryTileChange(TileIndex tile)
+{
+	std::lock_guard<std::mutex> lock(_catenary_cache_mutex);
+	if (_catenary_cache.empty()) return;
+
+	int x = TileX(tile);
+	int y = TileY(tile);
+	for (int dx = -2; dx <= 2; dx++) {
+		for (int dy = abs(dx) - 2; dy <= 2 - abs(dx); dy++) {
+			if (!IsInsideMM(x + dx, 0, Map::SizeX()) || !IsInsideMM(y + dy, 0, Map::SizeY())) continue;
+			_catenary_cache.erase(TileXY(x + dx, y + dy));
+		}
+	}
+}
+
+/** Forget all cached catenary sprites. */
+void ClearRailCatenaryCache()
+{
+	std::lock_guard<std::mutex> lock(_catenary_cache_mutex);
+	_catenary_cache.clear();
+}
+
 /**
  * Get the tile location group of a tile.
  * @param t The tile to get the tile location group of.
@@ -272,10 +331,11 @@ void DrawRailCatenaryOnTunnel(const TileInfo *ti)
 }
 
 /**
- * Draws wires and, if required, pylons on a given tile
- * @param ti The Tileinfo to draw the tile for
+ * Computes the wires and, if required, pylons of a given tile.
+ * @param ti The Tileinfo of the tile to compute the catenary for
+ * @param sprites Container to store the computed sprites in
  */
-static void DrawRailCatenaryRailway(const TileInfo *ti)
+static void BuildRailCatenaryCache(const TileInfo *ti, std::vector<CachedCatenarySprite> &sprites)
 {
 	/* Pylons are placed on a tile edge, so we need to take into account
 	 * the track configuration of 2 adjacent tiles. trackconfig[0] stores the
@@ -438,8 +498,8 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 						continue; // No neighbour, go looking for a better position
 					}
 
-					AddSortableSpriteToDraw(pylon_base + pylon_sprites[temp], PAL_NONE, x, y, 1, 1, BB_HEIGHT_UNDER_BRIDGE,
-						elevation, IsTransparencySet(TO_CATENARY), -1, -1);
+					sprites.push_back({pylon_base + pylon_sprites[temp], (int)x, (int)y, 1, 1, BB_HEIGHT_UNDER_BRIDGE,
+						elevation, -1, -1});
 
 					break; // We already have drawn a pylon, bail out
 				}
@@ -490,9 +550,44 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 		 * Also note that the result of GetSlopePixelZ() is very special for bridge-ramps, so we round the result up or
 		 * down to the nearest full height change.
 		 */
-		AddSortableSpriteToDraw(wire_base + sss->image_offset, PAL_NONE, ti->x + sss->x_offset, ti->y + sss->y_offset,
+		sprites.push_back({wire_base + sss->image_offset, ti->x + sss->x_offset, ti->y + sss->y_offset,
 			sss->x_size, sss->y_size, sss->z_size, (GetSlopePixelZ(ti->x + sss->x_offset, ti->y + sss->y_offset) + 4) / 8 * 8 + sss->z_offset,
-			IsTransparencySet(TO_CATENARY));
+			0, 0});
+	}
+}
+
+/**
+ * Draws wires and, if required, pylons on a given tile
+ * @param ti The Tileinfo to draw the tile for
+ */
+static void DrawRailCatenaryRailway(const TileInfo *ti)
+{
+	std::vector<CachedCatenarySprite> sprites;
+	bool cached = false;
+	{
+		std::lock_guard<std::mutex> lock(_catenary_cache_mutex);
+		if (_catenary_cache.size() >= CATENARY_CACHE_MAX_SIZE) _catenary_cache.clear();
+
+		auto it = _catenary_cache.find(ti->tile);
+		if (it != _catenary_cache.end()) {
+			/* Copy the sprites out; holding a reference into the map while
+			 * other threads insert into or flush it would not be safe. */
+			sprites = it->second;
+			cached = true;
+		}
+	}
+
+	if (!cached) {
+		/* Deriving the sprites only reads the map, so it runs outside the
+		 * lock; at worst two threads derive the same tile and one copy wins. */
+		BuildRailCatenaryCache(ti, sprites);
+		std::lock_guard<std::mutex> lock(_catenary_cache_mutex);
+		_catenary_cache.emplace(ti->tile, sprites);
+	}
+
+	bool transparent = IsTransparencySet(TO_CATENARY);
+	for (const CachedCatenarySprite &ccs : sprites) {
+		AddSortableSpriteToDraw(ccs.image, PAL_NONE, ccs.x, ccs.y, ccs.x_size, ccs.y_size, ccs.z_size, ccs.z, transparent, ccs.bb_offset_x, ccs.bb_offset_y);
 	}
 }
 
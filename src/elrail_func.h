@@ -36,6 +36,9 @@ void DrawRailCatenary(const TileInfo *ti);
 void DrawRailCatenaryOnTunnel(const TileInfo *ti);
 void DrawRailCatenaryOnBridge(const TileInfo *ti);
 
+void NotifyRailCatenaryTileChange(TileIndex tile);
+void ClearRailCatenaryCache();
+
 void SettingsDisableElrail(int32 new_value); ///< _settings_game.disable_elrail callback
 
 #endif /* ELRAIL_FUNC_H */
@@ -26,6 +26,8 @@
 #include "engine_cmd.h"
 #include "zoom_func.h"
 
+#include <unordered_map>
+
 #include "widgets/engine_widget.h"
 
 #include "table/strings.h"
@@ -319,6 +321,55 @@ void DrawVehicleEngine(int left, int right, int preferred_x, int y, EngineID eng
 	}
 }
 
+/** Resolved properties per engine; only valid during a single sort run. */
+static std::unordered_map<EngineID, EngineSortCacheEntry> _engine_sort_cache;
+
+/**
+ * Get the expensive properties of an engine for the engine list sorters.
+ * Resolving them goes through the NewGRF callback machinery, which is too
+ * slow to do for every comparison; instead they are resolved once per engine
+ * per sort run. The values may change over time (inflation, date based
+ * callbacks), so the cache is dropped when the next sort starts.
+ * @param engine The engine to get the properties of.
+ * @return The resolved properties.
+ */
+const EngineSortCacheEntry &GetEngineSortCacheEntry(EngineID engine)
+{
+	auto it = _engine_sort_cache.find(engine);
+	if (it != _engine_sort_cache.end()) return it->second;
+
+	const Engine *e = Engine::Get(engine);
+	EngineSortCacheEntry entry{};
+	entry.cost = e->GetCost();
+	entry.running_cost = e->GetRunningCost();
+	entry.max_speed = e->GetDisplayMaxSpeed();
+	switch (e->type) {
+		case VEH_TRAIN:
+			entry.power = e->GetPower();
+			entry.tractive_effort = e->GetDisplayMaxTractiveEffort();
+			entry.capacity = GetTotalCapacityOfArticulatedParts(engine) * (RailVehInfo(engine)->railveh_type == RAILVEH_MULTIHEAD ? 2 : 1);
+			break;
+
+		case VEH_ROAD:
+			entry.power = e->GetPower();
+			entry.tractive_effort = e->GetDisplayMaxTractiveEffort();
+			entry.capacity = GetTotalCapacityOfArticulatedParts(engine);
+			break;
+
+		case VEH_SHIP:
+			entry.capacity = e->GetDisplayDefaultCapacity();
+			break;
+
+		case VEH_AIRCRAFT:
+			entry.capacity = e->GetDisplayDefaultCapacity(&entry.mail_capacity);
+			entry.range = e->GetRange();
+			break;
+
+		default: NOT_REACHED();
+	}
+	return _engine_sort_cache.emplace(engine, entry).first->second;
+}
+
 /**
  * Sort all items using quick sort and given 'CompareItems' function
  * @param el list to be sorted
@@ -327,6 +378,7 @@ void DrawVehicleEngine(int left, int right, int preferred_x, int y, EngineID eng
 void EngList_Sort(GUIEngineList *el, EngList_SortTypeFunction compare)
 {
 	if (el->size() < 2) return;
+	_engine_sort_cache.clear();
 	std::sort(el->begin(), el->end(), compare);
 }
 
@@ -342,6 +394,7 @@ void EngList_SortPartial(GUIEngineList *el, EngList_SortTypeFunction compare, si
 	if (num_items < 2) return;
 	assert(begin < el->size());
 	assert(begin + num_items <= el->size());
+	_engine_sort_cache.clear();
 	std::sort(el->begin() + begin, el->begin() + begin + num_items, compare);
 }
 
@@ -30,6 +30,20 @@ struct GUIEngineListItem {
 
 typedef GUIList<GUIEngineListItem, CargoID> GUIEngineList;
 
+/** Expensive properties of an engine, resolved once per engine per sort run for the engine list sorters. */
+struct EngineSortCacheEntry {
+	Money cost;           ///< Purchase cost.
+	Money running_cost;   ///< Yearly running cost.
+	uint max_speed;       ///< Maximum speed for display purposes.
+	uint power;           ///< Power; zero for ships and aircraft.
+	uint tractive_effort; ///< Tractive effort for display purposes; zero for ships and aircraft.
+	uint capacity;        ///< Capacity, including articulated parts and both heads of multiheaded train engines.
+	uint16 mail_capacity; ///< Secondary (mail) capacity; only set for aircraft.
+	uint16 range;         ///< Range; only set for aircraft.
+};
+
+const EngineSortCacheEntry &GetEngineSortCacheEntry(EngineID engine);
+
 typedef bool EngList_SortTypeFunction(const GUIEngineListItem&, const GUIEngineListItem&); ///< argument type for #EngList_Sort.
 void EngList_Sort(GUIEngineList *el, EngList_SortTypeFunction compare);
 void EngList_SortPartial(GUIEngineList *el, EngList_SortTypeFunction compare, size_t begin, size_t num_items);
@@ -126,6 +126,37 @@ bool FileExists(const std::string &filename)
 	return access(OTTD2FS(filename).c_str(), 0) == 0;
 }
 
+/**
+ * Get the modification time of the given file.
+ * @param filename the file to look at.
+ * @return Modification time as seconds since the epoch, or 0 when it could not be determined.
+ */
+uint64 FioGetFileModificationTime(const std::string &filename)
+{
+#if defined(_WIN32)
+	/* Use GetFileTime rather than stat to work around an obscure MSVC bug that affects Windows XP. */
+	uint64 mtime = 0;
+	HANDLE fh = CreateFile(OTTD2FS(filename).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+	if (fh != INVALID_HANDLE_VALUE) {
+		FILETIME ft;
+		if (GetFileTime(fh, nullptr, nullptr, &ft) != 0) {
+			ULARGE_INTEGER ft_int64;
+			ft_int64.HighPart = ft.dwHighDateTime;
+			ft_int64.LowPart = ft.dwLowDateTime;
+
+			/* Convert from hectonanoseconds since 01/01/1601 to seconds since 01/01/1970 */
+			mtime = ft_int64.QuadPart / 10000000ULL - 11644473600ULL;
+		}
+		CloseHandle(fh);
+	}
+	return mtime;
+#else
+	struct stat sb;
+	if (stat(OTTD2FS(filename).c_str(), &sb) != 0) return 0;
+	return (uint64)sb.st_mtime;
+#endif
+}
+
 /**
  * Close a file in a safe way.
  */
@@ -1033,6 +1064,8 @@ void DeterminePaths(const char *exe, bool only_local_path)
 	_private_file = config_dir + "private.cfg";
 	extern std::string _secrets_file;
 	_secrets_file = config_dir + "secrets.cfg";
+	extern std::string _grf_md5_cache_file;
+	_grf_md5_cache_file = config_dir + "grfcache.cfg";
 
 #ifdef USE_XDG
 	if (config_dir == config_home) {
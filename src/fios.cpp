@@ -23,6 +23,7 @@
 #include <functional>
 #include <optional>
 #include <charconv>
+#include <unordered_set>
 
 #ifndef _WIN32
 # include <unistd.h>
@@ -261,6 +262,8 @@ bool FiosDelete(const char *name)
 
 typedef FiosType fios_getlist_callback_proc(SaveLoadOperation fop, const std::string &filename, const char *ext, char *title, const char *last);
 
+static fios_getlist_callback_proc *FiosPrepareFileList(AbstractFileType abstract_filetype, SaveLoadOperation fop, Subdirectory &subdir);
+
 /**
  * Scanner to scan for a particular type of FIOS file.
  */
@@ -268,6 +271,7 @@ class FiosFileScanner : public FileScanner {
 	SaveLoadOperation fop;   ///< The kind of file we are looking for.
 	fios_getlist_callback_proc *callback_proc; ///< Callback to check whether the file may be added
 	FileList &file_list;     ///< Destination of the found files.
+	std::unordered_set<std::string> seen; ///< Names already in the list, to skip duplicates from overlapping search paths.
 public:
 	/**
 	 * Create the scanner
@@ -300,9 +304,7 @@ bool FiosFileScanner::AddFile(const std::string &filename, size_t basepath_lengt
 	FiosType type = this->callback_proc(this->fop, filename, ext.c_str(), fios_title, lastof(fios_title));
 	if (type == FIOS_TYPE_INVALID) return false;
 
-	for (const auto &fios : file_list) {
-		if (filename == fios.name) return false;
-	}
+	if (!this->seen.insert(filename).second) return false;
 
 	FiosItem *fios = &file_list.emplace_back();
 #ifdef _WIN32
@@ -350,75 +352,95 @@ bool FiosFileScanner::AddFile(const std::string &filename, size_t basepath_lengt
 
 
 /**
- * Fill the list of the files in a directory, according to some arbitrary rule.
+ * Collect the directories and files for a file list. This is the part of
+ * building a file list that touches the file system, and therefore the
+ * slow part; it composes no translated strings and may run on any thread.
+ * The resulting list must be handed to FinishFileList() before use.
  * @param fop Purpose of collecting the list.
  * @param callback_proc The function that is called where you need to do the filtering.
  * @param subdir The directory from where to start (global) searching.
+ * @param path The directory to list subdirectories and (for NO_DIRECTORY) files of.
  * @param file_list Destination of the found files.
  */
-static void FiosGetFileList(SaveLoadOperation fop, fios_getlist_callback_proc *callback_proc, Subdirectory subdir, FileList &file_list)
+static void ScanFileList(SaveLoadOperation fop, fios_getlist_callback_proc *callback_proc, Subdirectory subdir, const std::string &path, FileList &file_list)
 {
 	struct stat sb;
 	struct dirent *dirent;
 	DIR *dir;
 	FiosItem *fios;
-	size_t sort_start;
 	char d_name[sizeof(fios->name)];
 
 	file_list.clear();
 
-	assert(_fios_path != nullptr);
-
 	/* A parent directory link exists if we are not in the root directory */
-	if (!FiosIsRoot(_fios_path->c_str())) {
+	if (!FiosIsRoot(path.c_str())) {
 		fios = &file_list.emplace_back();
 		fios->type = FIOS_TYPE_PARENT;
 		fios->mtime = 0;
 		strecpy(fios->name, "..", lastof(fios->name));
-		SetDParamStr(0, "..");
-		GetString(fios->title, STR_SAVELOAD_PARENT_DIRECTORY, lastof(fios->title));
+		fios->title[0] = '\0'; // Filled in by FinishFileList.
 	}
 
 	/* Show subdirectories */
-	if ((dir = ttd_opendir(_fios_path->c_str())) != nullptr) {
+	if ((dir = ttd_opendir(path.c_str())) != nullptr) {
 		while ((dirent = readdir(dir)) != nullptr) {
 			strecpy(d_name, FS2OTTD(dirent->d_name).c_str(), lastof(d_name));
 
 			/* found file must be directory, but not '.' or '..' */
-			if (FiosIsValidFile(_fios_path->c_str(), dirent, &sb) && S_ISDIR(sb.st_mode) &&
+			if (FiosIsValidFile(path.c_str(), dirent, &sb) && S_ISDIR(sb.st_mode) &&
 					(!FiosIsHiddenFile(dirent) || strncasecmp(d_name, PERSONAL_DIR, strlen(d_name)) == 0) &&
 					strcmp(d_name, ".") != 0 && strcmp(d_name, "..") != 0) {
 				fios = &file_list.emplace_back();
 				fios->type = FIOS_TYPE_DIR;
 				fios->mtime = 0;
 				strecpy(fios->name, d_name, lastof(fios->name));
-				std::string dirname = std::string(d_name) + PATHSEP;
-				SetDParamStr(0, dirname);
-				GetString(fios->title, STR_SAVELOAD_DIRECTORY, lastof(fios->title));
-				StrMakeValidInPlace(fios->title, lastof(fios->title));
+				fios->title[0] = '\0'; // Filled in by FinishFileList.
 			}
 		}
 		closedir(dir);
 	}
 
-	/* Sort the subdirs always by name, ascending, remember user-sorting order */
-	{
-		SortingBits order = _savegame_sort_order;
-		_savegame_sort_order = SORT_BY_NAME | SORT_ASCENDING;
-		std::sort(file_list.begin(), file_list.end());
-		_savegame_sort_order = order;
-	}
-
-	/* This is where to start sorting for the filenames */
-	sort_start = file_list.size();
-
 	/* Show files */
 	FiosFileScanner scanner(fop, callback_proc, file_list);
 	if (subdir == NO_DIRECTORY) {
-		scanner.Scan(nullptr, _fios_path->c_str(), false);
+		scanner.Scan(nullptr, path.c_str(), false);
 	} else {
 		scanner.Scan(nullptr, subdir, true, true);
 	}
+}
+
+/**
+ * Turn a scanned file list into a displayable one: compose the translated
+ * titles of the directory entries, sort the list and append the drives.
+ * Must run on the game thread.
+ * @param file_list The list to finish, as produced by ScanFileList().
+ */
+void FinishFileList(FileList &file_list)
+{
+	/* The parent and subdirectory entries are at the front of the list. */
+	size_t sort_start = 0;
+	for (FiosItem &fios : file_list) {
+		if (fios.type == FIOS_TYPE_PARENT) {
+			SetDParamStr(0, "..");
+			GetString(fios.title, STR_SAVELOAD_PARENT_DIRECTORY, lastof(fios.title));
+		} else if (fios.type == FIOS_TYPE_DIR) {
+			std::string dirname = std::string(fios.name) + PATHSEP;
+			SetDParamStr(0, dirname);
+			GetString(fios.title, STR_SAVELOAD_DIRECTORY, lastof(fios.title));
+			StrMakeValidInPlace(fios.title, lastof(fios.title));
+		} else {
+			break;
+		}
+		sort_start++;
+	}
+
+	/* Sort the subdirs always by name, ascending, remember user-sorting order */
+	{
+		SortingBits order = _savegame_sort_order;
+		_savegame_sort_order = SORT_BY_NAME | SORT_ASCENDING;
+		std::sort(file_list.begin(), file_list.begin() + sort_start);
+		_savegame_sort_order = order;
+	}
 
 	std::sort(file_list.begin() + sort_start, file_list.end());
 
@@ -428,6 +450,21 @@ static void FiosGetFileList(SaveLoadOperation fop, fios_getlist_callback_proc *c
 	file_list.shrink_to_fit();
 }
 
+/**
+ * Fill the list of the files in a directory, according to some arbitrary rule.
+ * @param fop Purpose of collecting the list.
+ * @param callback_proc The function that is called where you need to do the filtering.
+ * @param subdir The directory from where to start (global) searching.
+ * @param file_list Destination of the found files.
+ */
+static void FiosGetFileList(SaveLoadOperation fop, fios_getlist_callback_proc *callback_proc, Subdirectory subdir, FileList &file_list)
+{
+	assert(_fios_path != nullptr);
+
+	ScanFileList(fop, callback_proc, subdir, *_fios_path, file_list);
+	FinishFileList(file_list);
+}
+
 /**
  * Get the title of a file, which (if exists) is stored in a file named
  * the same as the data file but with '.title' added to it.
@@ -497,13 +534,9 @@ FiosType FiosGetSavegameListCallback(SaveLoadOperation fop, const std::string &f
  */
 void FiosGetSavegameList(SaveLoadOperation fop, FileList &file_list)
 {
-	static std::optional<std::string> fios_save_path;
-
-	if (!fios_save_path) fios_save_path = FioFindDirectory(SAVE_DIR);
-
-	_fios_path = &(*fios_save_path);
-
-	FiosGetFileList(fop, &FiosGetSavegameListCallback, NO_DIRECTORY, file_list);
+	Subdirectory subdir;
+	fios_getlist_callback_proc *callback_proc = FiosPrepareFileList(FT_SAVEGAME, fop, subdir);
+	FiosGetFileList(fop, callback_proc, subdir, file_list);
 }
 
 /**
@@ -546,16 +579,9 @@ static FiosType FiosGetScenarioListCallback(SaveLoadOperation fop, const std::st
  */
 void FiosGetScenarioList(SaveLoadOperation fop, FileList &file_list)
 {
-	static std::optional<std::string> fios_scn_path;
-
-	/* Copy the default path on first run or on 'New Game' */
-	if (!fios_scn_path) fios_scn_path = FioFindDirectory(SCENARIO_DIR);
-
-	_fios_path = &(*fios_scn_path);
-
-	std::string base_path = FioFindDirectory(SCENARIO_DIR);
-	Subdirectory subdir = (fop == SLO_LOAD && base_path == *_fios_path) ? SCENARIO_DIR : NO_DIRECTORY;
-	FiosGetFileList(fop, &FiosGetScenarioListCallback, subdir, file_list);
+	Subdirectory subdir;
+	fios_getlist_callback_proc *callback_proc = FiosPrepareFileList(FT_SCENARIO, fop, subdir);
+	FiosGetFileList(fop, callback_proc, subdir, file_list);
 }
 
 static FiosType FiosGetHeightmapListCallback(SaveLoadOperation fop, const std::string &file, const char *ext, char *title, const char *last)
@@ -607,15 +633,88 @@ static FiosType FiosGetHeightmapListCallback(SaveLoadOperation fop, const std::s
  */
 void FiosGetHeightmapList(SaveLoadOperation fop, FileList &file_list)
 {
-	static std::optional<std::string> fios_hmap_path;
+	Subdirectory subdir;
+	fios_getlist_callback_proc *callback_proc = FiosPrepareFileList(FT_HEIGHTMAP, fop, subdir);
+	FiosGetFileList(fop, callback_proc, subdir, file_list);
+}
+
+/**
+ * Determine the search path, search mode and filter callback for listing
+ * the given kind of files, and make #_fios_path point at that search path.
+ * @param abstract_filetype Kind of files to list.
+ * @param fop Purpose of collecting the list.
+ * @param subdir Set to the directory to search in; #NO_DIRECTORY to only scan #_fios_path.
+ * @return The callback that decides which files make the list.
+ */
+static fios_getlist_callback_proc *FiosPrepareFileList(AbstractFileType abstract_filetype, SaveLoadOperation fop, Subdirectory &subdir)
+{
+	switch (abstract_filetype) {
+		case FT_SAVEGAME: {
+			static std::optional<std::string> fios_save_path;
+
+			if (!fios_save_path) fios_save_path = FioFindDirectory(SAVE_DIR);
+
+			_fios_path = &(*fios_save_path);
+
+			subdir = NO_DIRECTORY;
+			return &FiosGetSavegameListCallback;
+		}
+
+		case FT_SCENARIO: {
+			static std::optional<std::string> fios_scn_path;
+
+			/* Copy the default path on first run or on 'New Game' */
+			if (!fios_scn_path) fios_scn_path = FioFindDirectory(SCENARIO_DIR);
+
+			_fios_path = &(*fios_scn_path);
+
+			std::string base_path = FioFindDirectory(SCENARIO_DIR);
+			subdir = (fop == SLO_LOAD && base_path == *_fios_path) ? SCENARIO_DIR : NO_DIRECTORY;
+			return &FiosGetScenarioListCallback;
+		}
+
+		case FT_HEIGHTMAP: {
+			static std::optional<std::string> fios_hmap_path;
+
+			if (!fios_hmap_path) fios_hmap_path = FioFindDirectory(HEIGHTMAP_DIR);
+
+			_fios_path = &(*fios_hmap_path);
+
+			std::string base_path = FioFindDirectory(HEIGHTMAP_DIR);
+			subdir = base_path == *_fios_path ? HEIGHTMAP_DIR : NO_DIRECTORY;
+			return &FiosGetHeightmapListCallback;
+		}
+
+		default: NOT_REACHED();
+	}
+}
+
+/**
+ * Build a file list on a worker of the shared pool, so the dialog it is
+ * shown in does not freeze while a huge or slow directory is being read.
+ * Once the returned job is done, the list must be handed to
+ * FinishFileList() on the game thread before use.
+ * @param abstract_filetype Kind of files to collect.
+ * @param fop Purpose of the collection, either #SLO_LOAD or #SLO_SAVE.
+ * @param result The list to build; must be kept alive until the job is done.
+ * @return Handle of the scanning job; invalid when no job could be started.
+ */
+JobHandle BuildFileListAsync(AbstractFileType abstract_filetype, SaveLoadOperation fop, std::shared_ptr<FileList> result)
+{
+	if (abstract_filetype == FT_NONE) {
+		result->clear();
+		return {};
+	}
 
-	if (!fios_hmap_path) fios_hmap_path = FioFindDirectory(HEIGHTMAP_DIR);
+	assert(fop == SLO_LOAD || fop == SLO_SAVE);
 
-	_fios_path = &(*fios_hmap_path);
+	Subdirectory subdir;
+	fios_getlist_callback_proc *callback_proc = FiosPrepareFileList(abstract_filetype, fop, subdir);
+	std::string path = *_fios_path;
 
-	std::string base_path = FioFindDirectory(HEIGHTMAP_DIR);
-	Subdirectory subdir = base_path == *_fios_path ? HEIGHTMAP_DIR : NO_DIRECTORY;
-	FiosGetFileList(fop, &FiosGetHeightmapListCallback, subdir, file_list);
+	return SubmitJob([fop, callback_proc, subdir, path, result]() {
+		ScanFileList(fop, callback_proc, subdir, path, *result);
+	}, "ottd:fiosscan");
 }
 
 /**
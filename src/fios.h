@@ -12,6 +12,7 @@
 
 #include "gfx_type.h"
 #include "company_base.h"
+#include "jobpool.h"
 #include "newgrf_config.h"
 #include "network/core/tcp_content_type.h"
 
@@ -116,6 +117,9 @@ void FiosGetSavegameList(SaveLoadOperation fop, FileList &file_list);
 void FiosGetScenarioList(SaveLoadOperation fop, FileList &file_list);
 void FiosGetHeightmapList(SaveLoadOperation fop, FileList &file_list);
 
+JobHandle BuildFileListAsync(AbstractFileType abstract_filetype, SaveLoadOperation fop, std::shared_ptr<FileList> result);
+void FinishFileList(FileList &file_list);
+
 const char *FiosBrowseTo(const FiosItem *item);
 
 StringID FiosGetDescText(const char **path, uint64 *total_free);
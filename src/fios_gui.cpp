@@ -288,6 +288,9 @@ private:
 	QueryString filter_editbox; ///< Filter editbox;
 	std::vector<bool> fios_items_shown; ///< Map of the filtered out fios items
 
+	std::shared_ptr<FileList> scan_result; ///< File list being collected in the background, or \c nullptr.
+	JobHandle scan_job;                    ///< Handle of the job collecting #scan_result.
+
 	static void SaveGameConfirmationCallback(Window *w, bool confirmed)
 	{
 		/* File name has already been written to _file_to_saveload */
@@ -831,7 +834,19 @@ public:
 				if (!gui_scope) break;
 
 				_fios_path_changed = true;
-				this->fios_items.BuildFileList(this->abstract_filetype, this->fop);
+
+				/* Collect the list in the background; directories with many
+				 * files, or on slow network storage, must not freeze the GUI.
+				 * OnRealtimeTick picks the result up. */
+				this->scan_result = std::make_shared<FileList>();
+				this->scan_job = BuildFileListAsync(this->abstract_filetype, this->fop, this->scan_result);
+				if (this->scan_job.IsValid()) {
+					this->fios_items.clear();
+				} else {
+					/* No worker could be started; scan right here. */
+					this->scan_result = nullptr;
+					this->fios_items.BuildFileList(this->abstract_filetype, this->fop);
+				}
 				this->vscroll->SetCount((uint)this->fios_items.size());
 				this->selected = nullptr;
 				_load_check_data.Clear();
@@ -906,6 +921,24 @@ public:
 			this->InvalidateData(SLIWD_FILTER_CHANGES);
 		}
 	}
+
+	void OnRealtimeTick(uint delta_ms) override
+	{
+		if (this->scan_result == nullptr || !this->scan_job.IsDone()) return;
+
+		/* The background scan has finished; take over its list. */
+		this->fios_items = std::move(*this->scan_result);
+		this->scan_result = nullptr;
+		this->scan_job = JobHandle();
+		FinishFileList(this->fios_items);
+
+		this->vscroll->SetCount((uint)this->fios_items.size());
+		this->selected = nullptr;
+		_load_check_data.Clear();
+		this->OnInvalidateData(SLIWD_FILTER_CHANGES);
+		this->OnInvalidateData(SLIWD_SELECTION_CHANGES);
+		this->SetDirty();
+	}
 };
 
 /** Load game/scenario */
@@ -25,7 +25,7 @@ static const int ASCII_LETTERSTART = 32; ///< First printable ASCII letter.
  * Create a new sprite font cache.
  * @param fs The font size to create the cache for.
  */
-SpriteFontCache::SpriteFontCache(FontSize fs) : FontCache(fs), glyph_to_spriteid_map(nullptr)
+SpriteFontCache::SpriteFontCache(FontSize fs) : FontCache(fs), glyph_to_spriteid_map(nullptr), glyph_cache(nullptr)
 {
 	this->InitializeUnicodeGlyphMap();
 	this->height = ScaleGUITrad(FontCache::GetDefaultFontHeight(this->fs));
@@ -38,6 +38,7 @@ SpriteFontCache::SpriteFontCache(FontSize fs) : FontCache(fs), glyph_to_spriteid
 SpriteFontCache::~SpriteFontCache()
 {
 	this->ClearGlyphToSpriteMap();
+	this->ClearGlyphCache();
 }
 
 SpriteID SpriteFontCache::GetUnicodeGlyph(WChar key)
@@ -51,6 +52,9 @@ void SpriteFontCache::SetUnicodeGlyph(WChar key, SpriteID sprite)
 	if (this->glyph_to_spriteid_map == nullptr) this->glyph_to_spriteid_map = CallocT<SpriteID*>(256);
 	if (this->glyph_to_spriteid_map[GB(key, 8, 8)] == nullptr) this->glyph_to_spriteid_map[GB(key, 8, 8)] = CallocT<SpriteID>(256);
 	this->glyph_to_spriteid_map[GB(key, 8, 8)][GB(key, 0, 8)] = sprite;
+
+	/* Glyphs that fell back to '?' may resolve differently now; start over. */
+	this->ClearGlyphCache();
 }
 
 void SpriteFontCache::InitializeUnicodeGlyphMap()
@@ -102,25 +106,58 @@ void SpriteFontCache::ClearGlyphToSpriteMap()
 	this->glyph_to_spriteid_map = nullptr;
 }
 
+/**
+ * Clear the resolved glyph cache.
+ */
+void SpriteFontCache::ClearGlyphCache()
+{
+	if (this->glyph_cache == nullptr) return;
+
+	for (uint i = 0; i < 256; i++) {
+		free(this->glyph_cache[i]);
+	}
+	free(this->glyph_cache);
+	this->glyph_cache = nullptr;
+}
+
 void SpriteFontCache::ClearFontCache()
 {
 	Layouter::ResetFontCache(this->fs);
+	this->ClearGlyphCache();
 	this->height = ScaleGUITrad(FontCache::GetDefaultFontHeight(this->fs));
 	this->ascender = (this->height - ScaleSpriteTrad(FontCache::GetDefaultFontHeight(this->fs))) / 2;
 }
 
+/**
+ * Get the resolved sprite and width of a glyph, resolving it on first use.
+ * Resolving a glyph means applying the '?' fallback and measuring the sprite,
+ * so drawing and laying out runs of text only costs a table lookup per glyph.
+ * @param key Glyph to look up.
+ * @return The cached glyph information.
+ */
+SpriteFontCache::GlyphEntry *SpriteFontCache::GetGlyphEntry(GlyphID key)
+{
+	if (this->glyph_cache == nullptr) this->glyph_cache = CallocT<GlyphEntry*>(256);
+	if (this->glyph_cache[GB(key, 8, 8)] == nullptr) this->glyph_cache[GB(key, 8, 8)] = CallocT<GlyphEntry>(256);
+
+	GlyphEntry *entry = &this->glyph_cache[GB(key, 8, 8)][GB(key, 0, 8)];
+	if (entry->sprite == 0) {
+		SpriteID sprite = this->GetUnicodeGlyph(key);
+		if (sprite == 0) sprite = this->GetUnicodeGlyph('?');
+		entry->sprite = sprite;
+		entry->width = SpriteExists(sprite) ? GetSprite(sprite, ST_FONT)->width + ScaleSpriteTrad(this->fs != FS_NORMAL ? 1 : 0) : 0;
+	}
+	return entry;
+}
+
 const Sprite *SpriteFontCache::GetGlyph(GlyphID key)
 {
-	SpriteID sprite = this->GetUnicodeGlyph(key);
-	if (sprite == 0) sprite = this->GetUnicodeGlyph('?');
-	return GetSprite(sprite, ST_FONT);
+	return GetSprite(this->GetGlyphEntry(key)->sprite, ST_FONT);
 }
 
 uint SpriteFontCache::GetGlyphWidth(GlyphID key)
 {
-	SpriteID sprite = this->GetUnicodeGlyph(key);
-	if (sprite == 0) sprite = this->GetUnicodeGlyph('?');
-	return SpriteExists(sprite) ? GetSprite(sprite, ST_FONT)->width + ScaleSpriteTrad(this->fs != FS_NORMAL ? 1 : 0) : 0;
+	return this->GetGlyphEntry(key)->width;
 }
 
 bool SpriteFontCache::GetDrawGlyphShadow()
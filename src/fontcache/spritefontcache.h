@@ -16,10 +16,19 @@
 /** Font cache for fonts that are based on a freetype font. */
 class SpriteFontCache : public FontCache {
 private:
+	/** Resolved glyph; the '?' fallback has already been applied. */
+	struct GlyphEntry {
+		SpriteID sprite; ///< Sprite to draw for the glyph, or 0 if not resolved yet.
+		byte width;      ///< Width of the glyph.
+	};
+
 	SpriteID **glyph_to_spriteid_map; ///< Mapping of glyphs to sprite IDs.
+	GlyphEntry **glyph_cache;         ///< Resolved glyphs, indexed like #glyph_to_spriteid_map.
 	SpriteID GetUnicodeGlyph(WChar key);
+	GlyphEntry *GetGlyphEntry(GlyphID key);
 
 	void ClearGlyphToSpriteMap();
+	void ClearGlyphCache();
 public:
 	SpriteFontCache(FontSize fs);
 	~SpriteFontCache();
@@ -49,20 +49,68 @@ void TrueTypeFontCache::ClearFontCache()
 	for (int i = 0; i < 256; i++) {
 		if (this->glyph_to_sprite[i] == nullptr) continue;
 
-		for (int j = 0; j < 256; j++) {
-			if (this->glyph_to_sprite[i][j].duplicate) continue;
-			free(this->glyph_to_sprite[i][j].sprite);
-		}
-
 		free(this->glyph_to_sprite[i]);
 	}
 
 	free(this->glyph_to_sprite);
 	this->glyph_to_sprite = nullptr;
 
+	/* The glyph sprites themselves are owned by the arenas. */
+	this->glyph_arenas.clear();
+	this->glyph_arena_used = 0;
+
 	Layouter::ResetFontCache(this->fs);
 }
 
+/**
+ * Allocate storage for an encoded glyph sprite.
+ * The glyphs are packed into larger blocks so that the glyphs of a font
+ * end up adjacent in memory; the blocks are freed in ClearFontCache().
+ * @param size The number of bytes to allocate.
+ * @return Pointer to the storage for the sprite.
+ */
+void *TrueTypeFontCache::AllocateGlyphMemory(size_t size)
+{
+	size = Align(size, alignof(std::max_align_t));
+
+	if (size >= GLYPH_ARENA_SIZE) {
+		/* An oversized glyph gets a block of its own; make sure the next glyph starts a fresh block. */
+		this->glyph_arenas.emplace_back(new byte[size]);
+		this->glyph_arena_used = GLYPH_ARENA_SIZE;
+		return this->glyph_arenas.back().get();
+	}
+
+	if (this->glyph_arenas.empty() || this->glyph_arena_used + size > GLYPH_ARENA_SIZE) {
+		this->glyph_arenas.emplace_back(new byte[GLYPH_ARENA_SIZE]);
+		this->glyph_arena_used = 0;
+	}
+
+	void *ptr = this->glyph_arenas.back().get() + this->glyph_arena_used;
+	this->glyph_arena_used += size;
+	return ptr;
+}
+
+/** Font cache that AllocateGlyphSprite() allocates from, as Blitter::Encode() cannot pass a context to its allocator. */
+static TrueTypeFontCache *_glyph_allocator = nullptr;
+
+/* static */ void *TrueTypeFontCache::AllocateGlyphSprite(size_t size)
+{
+	return _glyph_allocator->AllocateGlyphMemory(size);
+}
+
+/**
+ * Encode a rendered glyph into a sprite owned by this font cache.
+ * @param sprite The rendered glyph.
+ * @return The encoded sprite, allocated from the glyph arenas.
+ */
+Sprite *TrueTypeFontCache::EncodeGlyphSprite(const SpriteLoader::Sprite &sprite)
+{
+	_glyph_allocator = this;
+	Sprite *spr = BlitterFactory::GetCurrentBlitter()->Encode(&sprite, AllocateGlyphSprite);
+	_glyph_allocator = nullptr;
+	return spr;
+}
+
 
 TrueTypeFontCache::GlyphEntry *TrueTypeFontCache::GetGlyphPtr(GlyphID key)
 {
@@ -146,7 +194,7 @@ const Sprite *TrueTypeFontCache::GetGlyph(GlyphID key)
 				builtin_questionmark_data
 			};
 
-			Sprite *spr = BlitterFactory::GetCurrentBlitter()->Encode(&builtin_questionmark, SimpleSpriteAlloc);
+			Sprite *spr = this->EncodeGlyphSprite(builtin_questionmark);
 			assert(spr != nullptr);
 			GlyphEntry new_glyph;
 			new_glyph.sprite = spr;
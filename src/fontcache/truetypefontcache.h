@@ -35,9 +35,20 @@ protected:
 	struct GlyphEntry {
 		Sprite *sprite; ///< The loaded sprite.
 		byte width;     ///< The width of the glyph.
-		bool duplicate; ///< Whether this glyph entry is a duplicate, i.e. may this be freed?
+		bool duplicate; ///< Whether this glyph entry is a duplicate of another entry.
 	};
 
+	static constexpr size_t GLYPH_ARENA_SIZE = 16384; ///< Size of the memory blocks glyph sprites are packed into.
+
+	/**
+	 * Backing memory of the encoded glyph sprites. Glyphs are packed into
+	 * these blocks instead of being allocated individually, so the glyphs
+	 * of a font end up adjacent in memory and drawing a run of text stays
+	 * cache friendly.
+	 */
+	std::vector<std::unique_ptr<byte[]>> glyph_arenas;
+	size_t glyph_arena_used = 0; ///< Number of used bytes in the last arena block.
+
 	/**
 	 * The glyph cache. This is structured to reduce memory consumption.
 	 * 1) There is a 'segment' table for each font size.
@@ -56,6 +67,10 @@ protected:
 	GlyphEntry *GetGlyphPtr(GlyphID key);
 	void SetGlyphPtr(GlyphID key, const GlyphEntry *glyph, bool duplicate = false);
 
+	void *AllocateGlyphMemory(size_t size);
+	static void *AllocateGlyphSprite(size_t size);
+	Sprite *EncodeGlyphSprite(const SpriteLoader::Sprite &sprite);
+
 	virtual const void *InternalGetFontTable(uint32 tag, size_t &length) = 0;
 	virtual const Sprite *InternalGetGlyph(GlyphID key, bool aa) = 0;
 
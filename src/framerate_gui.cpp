@@ -27,6 +27,7 @@
 #include "widgets/framerate_widget.h"
 
 #include <atomic>
+#include <functional>
 #include <mutex>
 #include <vector>
 
@@ -144,6 +145,33 @@ namespace {
 			return sumtime * 1000 / count / TIMESTAMP_PRECISION;
 		}
 
+		/**
+		 * Get a percentile of the cycle processing time over a number of data points.
+		 * @param count      Number of most recent data points to consider.
+		 * @param percentile Percentile to get, e.g. 50 for the median or 99 for the one-percent worst case.
+		 */
+		double GetPercentileDurationMilliseconds(int count, int percentile)
+		{
+			count = std::min(count, this->num_valid);
+
+			int first_point = this->prev_index - count;
+			if (first_point < 0) first_point += NUM_FRAMERATE_POINTS;
+
+			/* Collect durations, skipping invalid points */
+			TimingMeasurement valid[NUM_FRAMERATE_POINTS];
+			int num = 0;
+			for (int i = first_point; i < first_point + count; i++) {
+				auto d = this->durations[i % NUM_FRAMERATE_POINTS];
+				if (d != INVALID_DURATION) valid[num++] = d;
+			}
+
+			if (num == 0) return 0;
+
+			int index = std::min(num - 1, num * percentile / 100);
+			std::nth_element(valid, valid + index, valid + num);
+			return (double)valid[index] * 1000 / TIMESTAMP_PRECISION;
+		}
+
 		/** Get current rate of a performance element, based on approximately the past one second of data */
 		double GetRate()
 		{
@@ -1101,6 +1129,84 @@ void ConPrintFramerate()
 	}
 }
 
+/**
+ * Produce all performance measurements in a machine-readable form.
+ * The elements are named by stable identifiers instead of the display strings
+ * and every element is a single line of key=value pairs. Times are in
+ * milliseconds over the whole measurement buffer.
+ * @param print Function each produced line is handed to.
+ */
+static void DumpFramerate(std::function<void(const std::string &)> print)
+{
+	static const char *ELEMENT_KEYS[PFE_MAX] = {
+		"gameloop",
+		"gl_economy",
+		"gl_trains",
+		"gl_roadvehs",
+		"gl_ships",
+		"gl_aircraft",
+		"gl_landscape",
+		"gl_linkgraph",
+		"drawing",
+		"drawing_viewport",
+		"video",
+		"sound",
+		"allscripts",
+		"gamescript",
+	};
+	char ai_key_buf[16];
+
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		auto &pf = _pf_data[e];
+		if (pf.num_valid == 0) continue;
+		const char *key;
+		if (e < PFE_AI0) {
+			key = ELEMENT_KEYS[e];
+		} else {
+			seprintf(ai_key_buf, lastof(ai_key_buf), "ai%d", e - PFE_AI0 + 1);
+			key = ai_key_buf;
+		}
+		print(fmt::format("{} samples={} rate={:.2f} p50={:.3f} p95={:.3f} p99={:.3f}",
+			key,
+			pf.num_valid,
+			pf.GetRate(),
+			pf.GetPercentileDurationMilliseconds(NUM_FRAMERATE_POINTS, 50),
+			pf.GetPercentileDurationMilliseconds(NUM_FRAMERATE_POINTS, 95),
+			pf.GetPercentileDurationMilliseconds(NUM_FRAMERATE_POINTS, 99)));
+	}
+}
+
+/**
+ * Print all performance measurements in a machine-readable form to the console.
+ * This is meant for scraping from dedicated servers via rcon or the admin port.
+ */
+void ConDumpFramerate()
+{
+	bool printed_anything = false;
+
+	DumpFramerate([&printed_anything](const std::string &line) {
+		IConsolePrint(CC_DEFAULT, line);
+		printed_anything = true;
+	});
+
+	if (!printed_anything) {
+		IConsolePrint(CC_ERROR, "No performance measurements have been taken yet.");
+	}
+}
+
+/**
+ * Write all performance measurements in a machine-readable form to a stream.
+ * The benchmark mode of the null video driver uses this, as no console is
+ * attached there to print to.
+ * @param stream The stream to write the measurements to.
+ */
+void DumpFramerate(FILE *stream)
+{
+	DumpFramerate([stream](const std::string &line) {
+		fprintf(stream, "%s\n", line.c_str());
+	});
+}
+
 /**
  * This drains the PFE_SOUND measurement data queue into _pf_data.
  * PFE_SOUND measurements are made by the mixer thread and so cannot be stored
@@ -122,5 +122,6 @@ public:
 
 void ShowFramerateWindow();
 void ProcessPendingPerformanceMeasurements();
+void DumpFramerate(FILE *stream);
 
 #endif /* FRAMERATE_TYPE_H */
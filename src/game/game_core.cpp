@@ -45,7 +45,7 @@
 
 	Backup<CompanyID> cur_company(_current_company, FILE_LINE);
 	cur_company.Change(OWNER_DEITY);
-	Game::instance->GameLoop();
+	Game::instance->GameLoop(_settings_game.script.script_max_opcode_till_suspend);
 	cur_company.Restore();
 
 	/* Occasionally collect garbage */
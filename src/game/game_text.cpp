@@ -152,14 +152,15 @@ struct TranslationWriter : LanguageWriter {
 		/* Nothing to do. */
 	}
 
-	void WriteLength(uint length)
+	void WriteIndex(const uint32 *offsets, uint count)
 	{
-		/* We don't write the length. */
+		/* We don't write the offset table. */
 	}
 
 	void Write(const byte *buffer, size_t length)
 	{
-		this->strings.emplace_back((const char *)buffer, length);
+		/* Drop the terminating zero; the strings are stored in std::strings. */
+		this->strings.emplace_back((const char *)buffer, length - 1);
 	}
 };
 
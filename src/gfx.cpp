@@ -29,6 +29,8 @@
 #include "table/sprites.h"
 #include "table/control_codes.h"
 
+#include <vector>
+
 #include "safeguards.h"
 
 byte _dirkeys;        ///< 1 = left, 2 = up, 4 = right, 8 = down
@@ -51,10 +53,13 @@ PauseMode _pause_mode;
 Palette _cur_palette;
 
 static byte _stringwidth_table[FS_END][224]; ///< Cache containing width of often used characters. @see GetCharacterWidth()
-DrawPixelInfo *_cur_dpi;
+/** The current drawing context; thread-local so viewport sprite collection can run on worker threads. */
+thread_local DrawPixelInfo *_cur_dpi;
 byte _colour_gradient[COLOUR_END][8];
 
-static std::recursive_mutex _palette_mutex; ///< To coordinate access to _cur_palette.
+static std::atomic<Palette *> _pending_palette{nullptr}; ///< Palette snapshot awaiting pick-up by the video driver; a lock-free single-slot hand-over from the game side to the draw side.
+static int _pending_first_dirty = 0; ///< First dirty element of the snapshot in #_pending_palette.
+static int _pending_count_dirty = 0; ///< Number of dirty elements of the snapshot in #_pending_palette.
 
 static void GfxMainBlitterViewport(const Sprite *sprite, int x, int y, BlitterMode mode, const SubSprite *sub = nullptr, SpriteID sprite_id = SPR_CURSOR_MOUSE);
 static void GfxMainBlitter(const Sprite *sprite, int x, int y, BlitterMode mode, const SubSprite *sub = nullptr, SpriteID sprite_id = SPR_CURSOR_MOUSE, ZoomLevel zoom = ZOOM_LVL_NORMAL);
@@ -66,21 +71,21 @@ int _gui_scale      = MIN_INTERFACE_SCALE; ///< GUI scale, 100 is 100%.
 int _gui_scale_cfg;                        ///< GUI scale in config.
 
 /**
- * The rect for repaint.
+ * The coalesced list of screen areas that need repainting.
  *
- * This rectangle defines the area which should be repaint by the video driver.
+ * Overlapping and touching areas are merged on insertion, so the list holds
+ * the union of the actual damage instead of one bounding box around it.
  *
  * @ingroup dirty
  */
-static Rect _invalid_rect;
+static std::vector<Rect> _dirty_rects;
+
+/** Maximum number of separately tracked damage rectangles; when exceeded the cheapest pair is merged. */
+static const size_t MAX_DIRTY_RECTS = 32;
+
 static const byte *_colour_remap_ptr;
 static byte _string_colourremap[3]; ///< Recoloursprite for stringdrawing. The grf loader ensures that #ST_FONT sprites only use colours 0 to 2.
 
-static const uint DIRTY_BLOCK_HEIGHT   = 8;
-static const uint DIRTY_BLOCK_WIDTH    = 64;
-
-static uint _dirty_bytes_per_line = 0;
-static byte *_dirty_blocks = nullptr;
 extern uint _dirty_block_colour;
 
 void GfxScroll(int left, int top, int width, int height, int xo, int yo)
@@ -889,8 +894,7 @@ int DrawStringMultiLine(int left, int right, int top, int bottom, StringID str,
  */
 Dimension GetStringBoundingBox(const char *str, FontSize start_fontsize)
 {
-	Layouter layout(str, INT32_MAX, TC_FROMSTRING, start_fontsize);
-	return layout.GetBounds();
+	return Layouter::GetCachedStringBounds(str, start_fontsize);
 }
 
 /**
@@ -1020,6 +1024,20 @@ static BlitterMode GetBlitterMode(PaletteID pal)
 	}
 }
 
+/**
+ * Whether this is one of the company colour recolourings, i.e. one of the
+ * few recolour tables that is applied to many sprites over and over again.
+ * For these it pays off to cache pre-remapped sprite variants, so they can
+ * be drawn with the plain blit path; see GetRemappedSprite().
+ * @param pal The palette to check.
+ * @return True when the palette is a company colour map.
+ */
+static bool IsCompanyColourPalette(PaletteID pal)
+{
+	return IsInsideMM(pal, PALETTE_RECOLOUR_START, PALETTE_RECOLOUR_START + COLOUR_END) ||
+			IsInsideMM(pal, SPR_2CCMAP_BASE, SPR_2CCMAP_BASE + TWOCCMAP_SPRITE_COUNT);
+}
+
 /**
  * Draw a sprite in a viewport.
  * @param img  Image number to draw
@@ -1037,6 +1055,10 @@ void DrawSpriteViewport(SpriteID img, PaletteID pal, int x, int y, const SubSpri
 	} else if (pal != PAL_NONE) {
 		if (HasBit(pal, PALETTE_TEXT_RECOLOUR)) {
 			SetColourRemap((TextColour)GB(pal, 0, PALETTE_WIDTH));
+		} else if (IsCompanyColourPalette(GB(pal, 0, PALETTE_WIDTH))) {
+			/* The recolouring is baked into the cached variant, so the plain path can draw it. */
+			GfxMainBlitterViewport(GetRemappedSprite(real_sprite, GB(pal, 0, PALETTE_WIDTH)), x, y, BM_NORMAL, sub, real_sprite);
+			return;
 		} else {
 			_colour_remap_ptr = GetNonSprite(GB(pal, 0, PALETTE_WIDTH), ST_RECOLOUR) + 1;
 		}
@@ -1064,6 +1086,10 @@ void DrawSprite(SpriteID img, PaletteID pal, int x, int y, const SubSprite *sub,
 	} else if (pal != PAL_NONE) {
 		if (HasBit(pal, PALETTE_TEXT_RECOLOUR)) {
 			SetColourRemap((TextColour)GB(pal, 0, PALETTE_WIDTH));
+		} else if (IsCompanyColourPalette(GB(pal, 0, PALETTE_WIDTH))) {
+			/* The recolouring is baked into the cached variant, so the plain path can draw it. */
+			GfxMainBlitter(GetRemappedSprite(real_sprite, GB(pal, 0, PALETTE_WIDTH)), x, y, BM_NORMAL, sub, real_sprite, zoom);
+			return;
 		} else {
 			_colour_remap_ptr = GetNonSprite(GB(pal, 0, PALETTE_WIDTH), ST_RECOLOUR) + 1;
 		}
@@ -1073,6 +1099,43 @@ void DrawSprite(SpriteID img, PaletteID pal, int x, int y, const SubSprite *sub,
 	}
 }
 
+static std::vector<Blitter::BlitterParams> _sprite_batch; ///< Sprite draws deferred by GfxStartSpriteBatch().
+static BlitterMode _sprite_batch_mode;                    ///< The blitter mode all deferred draws share.
+static ZoomLevel _sprite_batch_zoom;                      ///< The zoom level all deferred draws share.
+static bool _sprite_batch_active = false;                 ///< Whether sprite draws to the screen are currently being deferred.
+
+/**
+ * Hand all deferred sprite draws to the blitter at once. This must be called
+ * before anything a queued draw depends on changes, e.g. before the sprite
+ * cache frees sprite data that may still be referenced by the queue.
+ */
+void GfxFlushSpriteBatch()
+{
+	if (_sprite_batch.empty()) return;
+
+	BlitterFactory::GetCurrentBlitter()->DrawBatch(_sprite_batch.data(), (uint)_sprite_batch.size(), _sprite_batch_mode, _sprite_batch_zoom);
+	_sprite_batch.clear();
+}
+
+/**
+ * Start deferring sprite draws to the screen, so runs of consecutive draws
+ * with the same blitter mode can be handed to the blitter as single batches.
+ * The draws reach the blitter in their original order, at the latest when
+ * GfxEndSpriteBatch() is called.
+ */
+void GfxStartSpriteBatch()
+{
+	assert(!_sprite_batch_active);
+	_sprite_batch_active = true;
+}
+
+/** Stop deferring sprite draws and draw any still queued sprites. */
+void GfxEndSpriteBatch()
+{
+	GfxFlushSpriteBatch();
+	_sprite_batch_active = false;
+}
+
 /**
  * The code for setting up the blitter mode and sprite information before finally drawing the sprite.
  * @param sprite The sprite to draw.
@@ -1200,6 +1263,15 @@ static void GfxBlitter(const Sprite * const sprite, int x, int y, BlitterMode mo
 		}
 	}
 
+	if (!SCALED_XY && _sprite_batch_active && dst == nullptr) {
+		/* Queue the draw; a batch cannot mix modes or zoom levels, so draw what is queued first. */
+		if (!_sprite_batch.empty() && (mode != _sprite_batch_mode || zoom != _sprite_batch_zoom)) GfxFlushSpriteBatch();
+		_sprite_batch_mode = mode;
+		_sprite_batch_zoom = zoom;
+		_sprite_batch.push_back(bp);
+		return;
+	}
+
 	BlitterFactory::GetCurrentBlitter()->Draw(&bp, mode, zoom);
 }
 
@@ -1280,11 +1352,42 @@ void DoPaletteAnimations();
 
 void GfxInitPalettes()
 {
-	std::lock_guard<std::recursive_mutex> lock(_palette_mutex);
 	memcpy(&_cur_palette, &_palette, sizeof(_cur_palette));
+	_cur_palette.first_dirty = 0;
+	_cur_palette.count_dirty = 256;
 	DoPaletteAnimations();
 }
 
+/**
+ * Hand the accumulated changes to #_cur_palette over to the video driver.
+ *
+ * The hand-over spot is a lock-free single-slot mailbox: a snapshot that the
+ * draw side has not picked up yet is simply replaced by a newer one, so the
+ * game side never blocks on the drawing of a frame. All writers of
+ * #_cur_palette are serialised by the game state lock, making this a
+ * single-producer single-consumer exchange.
+ */
+static void PublishPalette()
+{
+	if (_cur_palette.count_dirty == 0) return;
+
+	if (_pending_palette.load(std::memory_order_relaxed) != nullptr) {
+		/* The draw side did not pick up the previous snapshot yet; the new
+		 * snapshot has to cover the dirty range of that one as well. */
+		int first = std::min(_cur_palette.first_dirty, _pending_first_dirty);
+		int last = std::max(_cur_palette.first_dirty + _cur_palette.count_dirty, _pending_first_dirty + _pending_count_dirty);
+		_cur_palette.first_dirty = first;
+		_cur_palette.count_dirty = last - first;
+	}
+
+	_pending_first_dirty = _cur_palette.first_dirty;
+	_pending_count_dirty = _cur_palette.count_dirty;
+
+	delete _pending_palette.exchange(new Palette(_cur_palette), std::memory_order_acq_rel);
+
+	_cur_palette.count_dirty = 0;
+}
+
 /**
  * Copy the current palette if the palette was updated.
  * Used by video-driver to get a current up-to-date version of the palette,
@@ -1296,19 +1399,19 @@ void GfxInitPalettes()
  */
 bool CopyPalette(Palette &local_palette, bool force_copy)
 {
-	std::lock_guard<std::recursive_mutex> lock(_palette_mutex);
-
-	if (!force_copy && _cur_palette.count_dirty == 0) return false;
-
-	local_palette = _cur_palette;
-	_cur_palette.count_dirty = 0;
+	Palette *pending = _pending_palette.exchange(nullptr, std::memory_order_acquire);
+	if (pending != nullptr) {
+		local_palette = *pending;
+		delete pending;
+	}
 
 	if (force_copy) {
 		local_palette.first_dirty = 0;
 		local_palette.count_dirty = 256;
+		return true;
 	}
 
-	return true;
+	return pending != nullptr;
 }
 
 #define EXTR(p, q) (((uint16)(palette_animation_counter * (p)) * (q)) >> 16)
@@ -1316,8 +1419,6 @@ bool CopyPalette(Palette &local_palette, bool force_copy)
 
 void DoPaletteAnimations()
 {
-	std::lock_guard<std::recursive_mutex> lock(_palette_mutex);
-
 	/* Animation counter for the palette animation. */
 	static int palette_animation_counter = 0;
 	palette_animation_counter += 8;
@@ -1423,6 +1524,8 @@ void DoPaletteAnimations()
 			_cur_palette.count_dirty = PALETTE_ANIM_SIZE;
 		}
 	}
+
+	PublishPalette();
 }
 
 /**
@@ -1507,12 +1610,9 @@ void GetBroadestDigit(uint *front, uint *next, FontSize size)
 
 void ScreenSizeChanged()
 {
-	_dirty_bytes_per_line = CeilDiv(_screen.width, DIRTY_BLOCK_WIDTH);
-	_dirty_blocks = ReallocT<byte>(_dirty_blocks, static_cast<size_t>(_dirty_bytes_per_line) * CeilDiv(_screen.height, DIRTY_BLOCK_HEIGHT));
-
-	/* check the dirty rect */
-	if (_invalid_rect.right >= _screen.width) _invalid_rect.right = _screen.width;
-	if (_invalid_rect.bottom >= _screen.height) _invalid_rect.bottom = _screen.height;
+	/* The old damage rectangles are meaningless for the new dimensions. */
+	_dirty_rects.clear();
+	MarkWholeScreenDirty();
 
 	/* screen size changed and the old bitmap is invalid now, so we don't want to undraw it */
 	_cursor.visible = false;
@@ -1628,7 +1728,7 @@ void RedrawScreenRect(int left, int top, int right, int bottom)
 }
 
 /**
- * Repaints the rectangle blocks which are marked as 'dirty'.
+ * Repaints the areas which are marked as 'dirty'.
  *
  * @see AddDirtyBlock
  *
@@ -1636,84 +1736,23 @@ void RedrawScreenRect(int left, int top, int right, int bottom)
  */
 void DrawDirtyBlocks()
 {
-	byte *b = _dirty_blocks;
-	const int w = Align(_screen.width,  DIRTY_BLOCK_WIDTH);
-	const int h = Align(_screen.height, DIRTY_BLOCK_HEIGHT);
-	int x;
-	int y;
-
-	y = 0;
-	do {
-		x = 0;
-		do {
-			if (*b != 0) {
-				int left;
-				int top;
-				int right = x + DIRTY_BLOCK_WIDTH;
-				int bottom = y;
-				byte *p = b;
-				int h2;
-
-				/* First try coalescing downwards */
-				do {
-					*p = 0;
-					p += _dirty_bytes_per_line;
-					bottom += DIRTY_BLOCK_HEIGHT;
-				} while (bottom != h && *p != 0);
-
-				/* Try coalescing to the right too. */
-				h2 = (bottom - y) / DIRTY_BLOCK_HEIGHT;
-				assert(h2 > 0);
-				p = b;
-
-				while (right != w) {
-					byte *p2 = ++p;
-					int i = h2;
-					/* Check if a full line of dirty flags is set. */
-					do {
-						if (!*p2) goto no_more_coalesc;
-						p2 += _dirty_bytes_per_line;
-					} while (--i != 0);
-
-					/* Wohoo, can combine it one step to the right!
-					 * Do that, and clear the bits. */
-					right += DIRTY_BLOCK_WIDTH;
-
-					i = h2;
-					p2 = p;
-					do {
-						*p2 = 0;
-						p2 += _dirty_bytes_per_line;
-					} while (--i != 0);
-				}
-				no_more_coalesc:
-
-				left = x;
-				top = y;
+	if (_dirty_rects.empty()) return;
 
-				if (left   < _invalid_rect.left  ) left   = _invalid_rect.left;
-				if (top    < _invalid_rect.top   ) top    = _invalid_rect.top;
-				if (right  > _invalid_rect.right ) right  = _invalid_rect.right;
-				if (bottom > _invalid_rect.bottom) bottom = _invalid_rect.bottom;
+	/* Drawing can mark new areas dirty (e.g. windows invalidating
+	 * themselves from OnPaint()); handle those next frame. */
+	std::vector<Rect> rects;
+	rects.swap(_dirty_rects);
 
-				if (left < right && top < bottom) {
-					RedrawScreenRect(left, top, right, bottom);
-				}
-
-			}
-		} while (b++, (x += DIRTY_BLOCK_WIDTH) != w);
-	} while (b += -(int)(w / DIRTY_BLOCK_WIDTH) + _dirty_bytes_per_line, (y += DIRTY_BLOCK_HEIGHT) != h);
+	for (const Rect &r : rects) {
+		RedrawScreenRect(r.left, r.top, r.right, r.bottom);
+	}
 
 	++_dirty_block_colour;
-	_invalid_rect.left = w;
-	_invalid_rect.top = h;
-	_invalid_rect.right = 0;
-	_invalid_rect.bottom = 0;
 }
 
 /**
- * Extend the internal _invalid_rect rectangle to contain the rectangle
- * defined by the given parameters. Note the point (0,0) is top left.
+ * Add the rectangle defined by the given parameters to the damage list.
+ * Note the point (0,0) is top left.
  *
  * @param left The left edge of the rectangle
  * @param top The top edge of the rectangle
@@ -1725,10 +1764,6 @@ void DrawDirtyBlocks()
  */
 void AddDirtyBlock(int left, int top, int right, int bottom)
 {
-	byte *b;
-	int width;
-	int height;
-
 	if (left < 0) left = 0;
 	if (top < 0) top = 0;
 	if (right > _screen.width) right = _screen.width;
@@ -1736,28 +1771,59 @@ void AddDirtyBlock(int left, int top, int right, int bottom)
 
 	if (left >= right || top >= bottom) return;
 
-	if (left   < _invalid_rect.left  ) _invalid_rect.left   = left;
-	if (top    < _invalid_rect.top   ) _invalid_rect.top    = top;
-	if (right  > _invalid_rect.right ) _invalid_rect.right  = right;
-	if (bottom > _invalid_rect.bottom) _invalid_rect.bottom = bottom;
-
-	left /= DIRTY_BLOCK_WIDTH;
-	top  /= DIRTY_BLOCK_HEIGHT;
-
-	b = _dirty_blocks + top * _dirty_bytes_per_line + left;
-
-	width  = ((right  - 1) / DIRTY_BLOCK_WIDTH)  - left + 1;
-	height = ((bottom - 1) / DIRTY_BLOCK_HEIGHT) - top  + 1;
-
-	assert(width > 0 && height > 0);
-
-	do {
-		int i = width;
+	Rect r = {left, top, right, bottom};
+
+	/* Merge overlapping and touching rectangles into the new one; their
+	 * union redraws fewer pixels than drawing the overlap repeatedly.
+	 * Growing the rectangle can make it reach others, so restart the
+	 * scan after every merge until nothing is absorbed any more. */
+	for (size_t i = 0; i < _dirty_rects.size();) {
+		const Rect &o = _dirty_rects[i];
+		if (r.left <= o.right && o.left <= r.right && r.top <= o.bottom && o.top <= r.bottom) {
+			r.left   = std::min(r.left,   o.left);
+			r.top    = std::min(r.top,    o.top);
+			r.right  = std::max(r.right,  o.right);
+			r.bottom = std::max(r.bottom, o.bottom);
+			_dirty_rects.erase(_dirty_rects.begin() + i);
+			i = 0;
+		} else {
+			i++;
+		}
+	}
 
-		do b[--i] = 0xFF; while (i != 0);
+	_dirty_rects.push_back(r);
+
+	/* Keep the list small; merge the pair whose union covers the fewest
+	 * extra pixels when there are too many disjoint areas. */
+	if (_dirty_rects.size() > MAX_DIRTY_RECTS) {
+		size_t best_a = 0;
+		size_t best_b = 1;
+		int64 best_waste = INT64_MAX;
+		for (size_t a = 0; a < _dirty_rects.size(); a++) {
+			for (size_t b = a + 1; b < _dirty_rects.size(); b++) {
+				const Rect &ra = _dirty_rects[a];
+				const Rect &rb = _dirty_rects[b];
+				int64 union_area = (int64)(std::max(ra.right, rb.right) - std::min(ra.left, rb.left)) *
+						(std::max(ra.bottom, rb.bottom) - std::min(ra.top, rb.top));
+				int64 waste = union_area
+						- (int64)(ra.right - ra.left) * (ra.bottom - ra.top)
+						- (int64)(rb.right - rb.left) * (rb.bottom - rb.top);
+				if (waste < best_waste) {
+					best_waste = waste;
+					best_a = a;
+					best_b = b;
+				}
+			}
+		}
 
-		b += _dirty_bytes_per_line;
-	} while (--height != 0);
+		Rect &ra = _dirty_rects[best_a];
+		const Rect &rb = _dirty_rects[best_b];
+		ra.left   = std::min(ra.left,   rb.left);
+		ra.top    = std::min(ra.top,    rb.top);
+		ra.right  = std::max(ra.right,  rb.right);
+		ra.bottom = std::max(ra.bottom, rb.bottom);
+		_dirty_rects.erase(_dirty_rects.begin() + best_b);
+	}
 }
 
 /**
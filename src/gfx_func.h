@@ -95,6 +95,10 @@ void DrawSprite(SpriteID img, PaletteID pal, int x, int y, const SubSprite *sub
 void DrawSpriteIgnorePadding(SpriteID img, PaletteID pal, const Rect &r, bool clicked, StringAlignment align); /* widget.cpp */
 std::unique_ptr<uint32[]> DrawSpriteToRgbaBuffer(SpriteID spriteId, ZoomLevel zoom = ZOOM_LVL_GUI);
 
+void GfxStartSpriteBatch();
+void GfxFlushSpriteBatch();
+void GfxEndSpriteBatch();
+
 int DrawString(int left, int right, int top, const char *str, TextColour colour = TC_FROMSTRING, StringAlignment align = SA_LEFT, bool underline = false, FontSize fontsize = FS_NORMAL);
 int DrawString(int left, int right, int top, const std::string &str, TextColour colour = TC_FROMSTRING, StringAlignment align = SA_LEFT, bool underline = false, FontSize fontsize = FS_NORMAL);
 int DrawString(int left, int right, int top, StringID str, TextColour colour = TC_FROMSTRING, StringAlignment align = SA_LEFT, bool underline = false, FontSize fontsize = FS_NORMAL);
@@ -211,7 +215,7 @@ int GetCharacterHeight(FontSize size);
 /** Height of characters in the large (#FS_MONO) font. @note Some characters may be oversized. */
 #define FONT_HEIGHT_MONO  (GetCharacterHeight(FS_MONO))
 
-extern DrawPixelInfo *_cur_dpi;
+extern thread_local DrawPixelInfo *_cur_dpi;
 
 /**
  * Checks if a Colours value is valid.
@@ -689,7 +689,6 @@ Layouter::Layouter(const char *str, int maxw, TextColour colour, FontSize fontsi
 			/* Line is in cache */
 			str = lineend + 1;
 			state = line.state_after;
-			line.layout->Reflow();
 		} else {
 			/* Line is new, layout it */
 			FontState old_state = state;
@@ -736,11 +735,22 @@ Layouter::Layouter(const char *str, int maxw, TextColour colour, FontSize fontsi
 			}
 		}
 
-		/* Move all lines into a local cache so we can reuse them later on more easily. */
-		for (;;) {
-			auto l = line.layout->NextLine(maxw);
-			if (l == nullptr) break;
-			this->push_back(std::move(l));
+		/* Break the paragraph into lines, or reuse the result of an earlier
+		 * layout of the same paragraph at the same width. */
+		if (line.cached_width != maxw || line.cached_layout.empty()) {
+			line.layout->Reflow();
+			line.cached_layout.clear();
+			line.cached_width = maxw;
+			for (;;) {
+				auto l = line.layout->NextLine(maxw);
+				if (l == nullptr) break;
+				line.cached_layout.push_back(std::move(l));
+			}
+		}
+
+		/* The lines remain owned by the line cache; we only reference them. */
+		for (const auto &l : line.cached_layout) {
+			this->push_back(l.get());
 		}
 	} while (c != '\0');
 }
@@ -906,12 +916,49 @@ Layouter::LineCacheItem &Layouter::GetCachedParagraphLayout(const char *str, siz
 	return (*linecache)[key];
 }
 
+Layouter::BoundsCache *Layouter::boundscache;
+
+/**
+ * Get the bounding box of a string, memoised across calls.
+ *
+ * Window (re)initialisation measures the same captions, labels and button
+ * texts on every open. The bounds of a string only depend on its text and
+ * the font, so the resulting dimension is cached; keying on the resolved
+ * text makes a language change produce new keys by itself. The cache is
+ * emptied together with the line cache, which covers font and zoom changes.
+ * @param str The string to measure.
+ * @param start_fontsize Font size to start the text with.
+ * @return The dimensions of the string.
+ */
+/* static */ Dimension Layouter::GetCachedStringBounds(const char *str, FontSize start_fontsize)
+{
+	if (boundscache == nullptr) {
+		/* Create boundscache on first access to avoid trouble with initialisation order of static variables. */
+		boundscache = new BoundsCache();
+	}
+
+	if (auto match = boundscache->find(BoundsCacheQuery{start_fontsize, std::string_view{str}});
+		match != boundscache->end()) {
+		return match->second;
+	}
+
+	Layouter layout(str, INT32_MAX, TC_FROMSTRING, start_fontsize);
+	Dimension d = layout.GetBounds();
+
+	BoundsCacheKey key;
+	key.fontsize = start_fontsize;
+	key.str.assign(str);
+	(*boundscache)[key] = d;
+	return d;
+}
+
 /**
  * Clear line cache.
  */
 void Layouter::ResetLineCache()
 {
 	if (linecache != nullptr) linecache->clear();
+	if (boundscache != nullptr) boundscache->clear();
 }
 
 /**
@@ -923,4 +970,5 @@ void Layouter::ReduceLineCache()
 		/* TODO LRU cache would be fancy, but not exactly necessary */
 		if (linecache->size() > 4096) ResetLineCache();
 	}
+	if (boundscache != nullptr && boundscache->size() > 4096) boundscache->clear();
 }
@@ -150,7 +150,7 @@ public:
  *
  * It also accounts for the memory allocations and frees.
  */
-class Layouter : public std::vector<std::unique_ptr<const ParagraphLayouter::Line>> {
+class Layouter : public std::vector<const ParagraphLayouter::Line *> {
 	const char *string; ///< Pointer to the original string.
 
 	/** Key into the linecache */
@@ -188,7 +188,10 @@ public:
 		FontState state_after;     ///< Font state after the line.
 		ParagraphLayouter *layout; ///< Layout of the line.
 
-		LineCacheItem() : buffer(nullptr), layout(nullptr) {}
+		int cached_width;          ///< Width for which the line breaking was done.
+		std::vector<std::unique_ptr<const ParagraphLayouter::Line>> cached_layout; ///< Cached results of line breaking for #cached_width.
+
+		LineCacheItem() : buffer(nullptr), layout(nullptr), cached_width(0) {}
 		~LineCacheItem() { delete layout; free(buffer); }
 	};
 private:
@@ -197,6 +200,33 @@ private:
 
 	static LineCacheItem &GetCachedParagraphLayout(const char *str, size_t len, const FontState &state);
 
+	/** Key into the string bounding box cache */
+	struct BoundsCacheKey {
+		FontSize fontsize; ///< Font size the string was measured with.
+		std::string str;   ///< Measured string (including colour and font size codes).
+	};
+
+	struct BoundsCacheQuery {
+		FontSize fontsize;    ///< Font size the string is to be measured with.
+		std::string_view str; ///< String to measure (including colour and font size codes).
+	};
+
+	/** Comparator for std::map */
+	struct BoundsCacheCompare {
+		using is_transparent = void; ///< Enable map queries with various key types
+
+		/** Comparison operator for BoundsCacheKey and BoundsCacheQuery */
+		template <typename Key1, typename Key2>
+		bool operator()(const Key1 &lhs, const Key2 &rhs) const
+		{
+			if (lhs.fontsize != rhs.fontsize) return lhs.fontsize < rhs.fontsize;
+			return lhs.str < rhs.str;
+		}
+	};
+
+	typedef std::map<BoundsCacheKey, Dimension, BoundsCacheCompare> BoundsCache;
+	static BoundsCache *boundscache;
+
 	typedef SmallMap<TextColour, Font *> FontColourMap;
 	static FontColourMap fonts[FS_END];
 public:
@@ -204,6 +234,7 @@ public:
 
 	Layouter(const char *str, int maxw = INT32_MAX, TextColour colour = TC_FROMSTRING, FontSize fontsize = FS_NORMAL);
 	Dimension GetBounds();
+	static Dimension GetCachedStringBounds(const char *str, FontSize start_fontsize);
 	Point GetCharPosition(const char *ch) const;
 	const char *GetCharAtPosition(int x) const;
 
@@ -196,6 +196,21 @@ protected:
 	byte colours[GRAPH_MAX_DATASETS];
 	OverflowSafeInt64 cost[GRAPH_MAX_DATASETS][GRAPH_NUM_MONTHS]; ///< Stored costs for the last #GRAPH_NUM_MONTHS months
 
+	/* The axis scaling only changes when the data or the size of the graph
+	 * changes, so it is cached between paints. */
+	mutable ValuesInterval cached_interval;  ///< Cached interval of the graph data.
+	mutable uint cached_label_width;         ///< Cached width of the y axis labels.
+	mutable uint64 cached_excluded_data;     ///< Bitmask of excluded datasets the cache was computed for.
+	mutable int cached_num_hori_lines;       ///< Number of horizontal lines the cache was computed for; 0 when the cache is not valid.
+
+	/**
+	 * Invalidate the cached axis scaling, e.g. because the graph data changed.
+	 */
+	void InvalidateCachedInterval()
+	{
+		this->cached_num_hori_lines = 0;
+	}
+
 	/**
 	 * Get the interval that contains the graph's data. Excluded data is ignored to show smaller values in
 	 * better detail when disabling higher ones.
@@ -309,9 +324,15 @@ protected:
 		int resize = (r.bottom - r.top - 160) / (2 * ScaleGUITrad(MIN_GRID_PIXEL_SIZE));
 		if (resize > 0) num_hori_lines += resize;
 
-		interval = GetValuesInterval(num_hori_lines);
+		if (num_hori_lines != this->cached_num_hori_lines || this->excluded_data != this->cached_excluded_data) {
+			this->cached_interval = GetValuesInterval(num_hori_lines);
+			this->cached_label_width = GetYLabelWidth(this->cached_interval, num_hori_lines);
+			this->cached_num_hori_lines = num_hori_lines;
+			this->cached_excluded_data = this->excluded_data;
+		}
+		interval = this->cached_interval;
 
-		int label_width = GetYLabelWidth(interval, num_hori_lines);
+		int label_width = this->cached_label_width;
 
 		r.left += label_width;
 
@@ -479,6 +500,7 @@ protected:
 		SetWindowDirty(WC_GRAPH_LEGEND, 0);
 		this->num_vert_lines = 24;
 		this->graph_widget = widget;
+		this->InvalidateCachedInterval();
 	}
 
 	void InitializeWindow(WindowNumber number)
@@ -490,6 +512,12 @@ protected:
 	}
 
 public:
+	void OnInit() override
+	{
+		/* The fonts may have changed, so the labels have to be measured again. */
+		this->InvalidateCachedInterval();
+	}
+
 	void UpdateWidgetSize(int widget, Dimension *size, const Dimension &padding, Dimension *fill, Dimension *resize) override
 	{
 		if (widget != this->graph_widget) return;
@@ -610,6 +638,7 @@ public:
 		}
 
 		this->num_dataset = numd;
+		this->InvalidateCachedInterval();
 	}
 };
 
@@ -898,6 +927,8 @@ struct PaymentRatesGraphWindow : BaseGraphWindow {
 
 	void OnInit() override
 	{
+		BaseGraphWindow::OnInit();
+
 		/* Width of the legend blob. */
 		this->legend_width = (FONT_HEIGHT_SMALL - ScaleGUITrad(1)) * 8 / 5;
 	}
@@ -1045,6 +1076,7 @@ struct PaymentRatesGraphWindow : BaseGraphWindow {
 			i++;
 		}
 		this->num_dataset = i;
+		this->InvalidateCachedInterval();
 	}
 };
 
@@ -80,16 +80,19 @@ void GroundVehicle<T, Type>::CargoChanged()
 {
 	assert(this->First() == this);
 	uint32 weight = 0;
+	int64 incl = 0;
 
 	for (T *u = T::From(this); u != nullptr; u = u->Next()) {
 		uint32 current_weight = u->GetWeight();
 		weight += current_weight;
 		/* Slope steepness is in percent, result in N. */
 		u->gcache.cached_slope_resistance = current_weight * u->GetSlopeSteepness() * 100;
+		incl += u->GetPartSlopeResistance();
 	}
 
-	/* Store consist weight in cache. */
+	/* Store consist weight and total slope resistance in cache. */
 	this->gcache.cached_weight = std::max(1u, weight);
+	this->gcache.cached_total_slope_resistance = incl;
 	/* Friction in bearings and other mechanical parts is 0.1% of the weight (result in N). */
 	this->gcache.cached_axle_resistance = 10 * weight;
 
@@ -32,6 +32,7 @@ struct GroundVehicleCache {
 	uint32 cached_slope_resistance; ///< Resistance caused by weight when this vehicle part is at a slope.
 	uint32 cached_max_te;           ///< Maximum tractive effort of consist (valid only for the first engine).
 	uint16 cached_axle_resistance;  ///< Resistance caused by the axles of the vehicle (valid only for the first engine).
+	int64 cached_total_slope_resistance; ///< Signed sum of the slope resistance of all parts currently at a slope (valid only for the first engine).
 
 	/* Cached acceleration values, recalculated on load and each time a vehicle is added to/removed from the consist. */
 	uint16 cached_max_track_speed;  ///< Maximum consist speed (in internal units) limited by track type (valid only for the first engine).
@@ -104,28 +105,60 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 			ClrBit(v->gv_flags, GVF_GOINGUP_BIT);
 			ClrBit(v->gv_flags, GVF_GOINGDOWN_BIT);
 		}
+		this->gcache.cached_total_slope_resistance = 0;
 		return this->Vehicle::Crash(flooded);
 	}
 
 	/**
-	 * Calculates the total slope resistance for this vehicle.
+	 * Gets the slope resistance this vehicle part contributes at its current inclination.
+	 * @return Signed slope resistance of this part.
+	 */
+	inline int64 GetPartSlopeResistance() const
+	{
+		if (HasBit(this->gv_flags, GVF_GOINGUP_BIT)) return this->gcache.cached_slope_resistance;
+		if (HasBit(this->gv_flags, GVF_GOINGDOWN_BIT)) return -(int64)this->gcache.cached_slope_resistance;
+		return 0;
+	}
+
+	/**
+	 * Calculates the total slope resistance of the consist by walking all parts.
+	 * Only meant for refreshing #GroundVehicleCache::cached_total_slope_resistance;
+	 * use GetSlopeResistance() everywhere else.
 	 * @return Slope resistance.
 	 */
-	inline int64 GetSlopeResistance() const
+	inline int64 CalcTotalSlopeResistance() const
 	{
 		int64 incl = 0;
 
 		for (const T *u = T::From(this); u != nullptr; u = u->Next()) {
-			if (HasBit(u->gv_flags, GVF_GOINGUP_BIT)) {
-				incl += u->gcache.cached_slope_resistance;
-			} else if (HasBit(u->gv_flags, GVF_GOINGDOWN_BIT)) {
-				incl -= u->gcache.cached_slope_resistance;
-			}
+			incl += u->GetPartSlopeResistance();
 		}
 
 		return incl;
 	}
 
+	/**
+	 * Gets the total slope resistance for this vehicle.
+	 * The cached sum is kept up to date whenever a part changes inclination.
+	 * @return Slope resistance.
+	 */
+	inline int64 GetSlopeResistance() const
+	{
+		assert(this->gcache.cached_total_slope_resistance == this->CalcTotalSlopeResistance());
+		return this->gcache.cached_total_slope_resistance;
+	}
+
+	/**
+	 * Clears the inclination flags of this vehicle part, keeping the cached
+	 * total slope resistance of the consist in sync.
+	 */
+	inline void ClearInclination()
+	{
+		T::From(this)->First()->gcache.cached_total_slope_resistance -= this->GetPartSlopeResistance();
+		ClrBit(this->gv_flags, GVF_GOINGUP_BIT);
+		ClrBit(this->gv_flags, GVF_GOINGDOWN_BIT);
+	}
+
 	/**
 	 * Updates vehicle's Z position and inclination.
 	 * Used when the vehicle entered given tile.
@@ -135,8 +168,7 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	inline void UpdateZPositionAndInclination()
 	{
 		this->z_pos = GetSlopePixelZ(this->x_pos, this->y_pos);
-		ClrBit(this->gv_flags, GVF_GOINGUP_BIT);
-		ClrBit(this->gv_flags, GVF_GOINGDOWN_BIT);
+		this->ClearInclination();
 
 		if (T::From(this)->TileMayHaveSlopedTrack()) {
 			/* To check whether the current tile is sloped, and in which
@@ -147,6 +179,7 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 
 			if (middle_z != this->z_pos) {
 				SetBit(this->gv_flags, (middle_z > this->z_pos) ? GVF_GOINGUP_BIT : GVF_GOINGDOWN_BIT);
+				T::From(this)->First()->gcache.cached_total_slope_resistance += this->GetPartSlopeResistance();
 			}
 		}
 	}
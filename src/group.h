@@ -25,9 +25,13 @@ extern GroupPool _group_pool; ///< Pool of groups.
 struct GroupStatistics {
 	Money profit_last_year;                 ///< Sum of profits for all vehicles.
 	Money profit_last_year_min_age;         ///< Sum of profits for vehicles considered for profit statistics.
+	Money profit_last_year_min_age_total;   ///< As #profit_last_year_min_age, but including the sub-groups.
 	uint16 *num_engines;                    ///< Caches the number of engines of each type the company owns.
+	uint16 *num_engines_total;              ///< As #num_engines, but including the sub-groups.
 	uint16 num_vehicle;                     ///< Number of vehicles.
+	uint16 num_vehicle_total;               ///< As #num_vehicle, but including the sub-groups.
 	uint16 num_vehicle_min_age;             ///< Number of vehicles considered for profit statistics;
+	uint16 num_vehicle_min_age_total;       ///< As #num_vehicle_min_age, but including the sub-groups.
 	bool autoreplace_defined;               ///< Are any autoreplace rules set?
 	bool autoreplace_finished;              ///< Have all autoreplacement finished?
 
@@ -41,7 +45,9 @@ struct GroupStatistics {
 		this->profit_last_year = 0;
 
 		this->num_vehicle_min_age = 0;
+		this->num_vehicle_min_age_total = 0;
 		this->profit_last_year_min_age = 0;
+		this->profit_last_year_min_age_total = 0;
 	}
 
 	void ClearAutoreplace()
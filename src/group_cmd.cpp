@@ -30,11 +30,13 @@ INSTANTIATE_POOL_METHODS(Group)
 GroupStatistics::GroupStatistics()
 {
 	this->num_engines = CallocT<uint16>(Engine::GetPoolSize());
+	this->num_engines_total = CallocT<uint16>(Engine::GetPoolSize());
 }
 
 GroupStatistics::~GroupStatistics()
 {
 	free(this->num_engines);
+	free(this->num_engines_total);
 }
 
 /**
@@ -43,13 +45,18 @@ GroupStatistics::~GroupStatistics()
 void GroupStatistics::Clear()
 {
 	this->num_vehicle = 0;
+	this->num_vehicle_total = 0;
 	this->profit_last_year = 0;
 	this->num_vehicle_min_age = 0;
+	this->num_vehicle_min_age_total = 0;
 	this->profit_last_year_min_age = 0;
+	this->profit_last_year_min_age_total = 0;
 
 	/* This is also called when NewGRF change. So the number of engines might have changed. Reallocate. */
 	free(this->num_engines);
 	this->num_engines = CallocT<uint16>(Engine::GetPoolSize());
+	free(this->num_engines_total);
+	this->num_engines_total = CallocT<uint16>(Engine::GetPoolSize());
 }
 
 /**
@@ -124,6 +131,24 @@ void GroupStatistics::Clear()
 	}
 }
 
+/**
+ * Apply \a handler to the statistics of the group \a id_g and of all its
+ * parent groups, i.e. of every group whose sub-group totals include \a id_g.
+ * @param company Owner of the group.
+ * @param id_g    GroupID of the group, or #DEFAULT_GROUP.
+ * @param type    VehicleType of the vehicles in the group.
+ * @param handler Function applying the update to one #GroupStatistics.
+ */
+template <class Thandler>
+static void UpdateTotals(CompanyID company, GroupID id_g, VehicleType type, Thandler handler)
+{
+	while (id_g != INVALID_GROUP) {
+		handler(GroupStatistics::Get(company, id_g, type));
+		if (!Group::IsValidID(id_g)) break;
+		id_g = Group::Get(id_g)->parent;
+	}
+}
+
 /**
  * Update num_vehicle when adding or removing a vehicle.
  * @param v Vehicle to count.
@@ -135,18 +160,30 @@ void GroupStatistics::Clear()
 
 	GroupStatistics &stats_all = GroupStatistics::GetAllGroup(v);
 	GroupStatistics &stats = GroupStatistics::Get(v);
+	bool min_age = v->age > VEHICLE_PROFIT_MIN_AGE;
 
 	stats_all.num_vehicle += delta;
+	stats_all.num_vehicle_total += delta;
 	stats_all.profit_last_year += v->GetDisplayProfitLastYear() * delta;
 	stats.num_vehicle += delta;
 	stats.profit_last_year += v->GetDisplayProfitLastYear() * delta;
 
-	if (v->age > VEHICLE_PROFIT_MIN_AGE) {
+	if (min_age) {
 		stats_all.num_vehicle_min_age += delta;
+		stats_all.num_vehicle_min_age_total += delta;
 		stats_all.profit_last_year_min_age += v->GetDisplayProfitLastYear() * delta;
+		stats_all.profit_last_year_min_age_total += v->GetDisplayProfitLastYear() * delta;
 		stats.num_vehicle_min_age += delta;
 		stats.profit_last_year_min_age += v->GetDisplayProfitLastYear() * delta;
 	}
+
+	UpdateTotals(v->owner, v->group_id, v->type, [&](GroupStatistics &stats_total) {
+		stats_total.num_vehicle_total += delta;
+		if (min_age) {
+			stats_total.num_vehicle_min_age_total += delta;
+			stats_total.profit_last_year_min_age_total += v->GetDisplayProfitLastYear() * delta;
+		}
+	});
 }
 
 /**
@@ -157,8 +194,15 @@ void GroupStatistics::Clear()
 /* static */ void GroupStatistics::CountEngine(const Vehicle *v, int delta)
 {
 	assert(delta == 1 || delta == -1);
-	GroupStatistics::GetAllGroup(v).num_engines[v->engine_type] += delta;
+
+	GroupStatistics &stats_all = GroupStatistics::GetAllGroup(v);
+	stats_all.num_engines[v->engine_type] += delta;
+	stats_all.num_engines_total[v->engine_type] += delta;
 	GroupStatistics::Get(v).num_engines[v->engine_type] += delta;
+
+	UpdateTotals(v->owner, v->group_id, v->type, [&](GroupStatistics &stats_total) {
+		stats_total.num_engines_total[v->engine_type] += delta;
+	});
 }
 
 /**
@@ -182,9 +226,16 @@ void GroupStatistics::Clear()
 	GroupStatistics &stats = GroupStatistics::Get(v);
 
 	stats_all.num_vehicle_min_age++;
+	stats_all.num_vehicle_min_age_total++;
 	stats_all.profit_last_year_min_age += v->GetDisplayProfitLastYear();
+	stats_all.profit_last_year_min_age_total += v->GetDisplayProfitLastYear();
 	stats.num_vehicle_min_age++;
 	stats.profit_last_year_min_age += v->GetDisplayProfitLastYear();
+
+	UpdateTotals(v->owner, v->group_id, v->type, [&](GroupStatistics &stats_total) {
+		stats_total.num_vehicle_min_age_total++;
+		stats_total.profit_last_year_min_age_total += v->GetDisplayProfitLastYear();
+	});
 }
 
 /**
@@ -255,9 +306,11 @@ static inline void UpdateNumEngineGroup(const Vehicle *v, GroupID old_g, GroupID
 	if (old_g != new_g) {
 		/* Decrease the num engines in the old group */
 		GroupStatistics::Get(v->owner, old_g, v->type).num_engines[v->engine_type]--;
+		UpdateTotals(v->owner, old_g, v->type, [&](GroupStatistics &stats_total) { stats_total.num_engines_total[v->engine_type]--; });
 
 		/* Increase the num engines in the new group */
 		GroupStatistics::Get(v->owner, new_g, v->type).num_engines[v->engine_type]++;
+		UpdateTotals(v->owner, new_g, v->type, [&](GroupStatistics &stats_total) { stats_total.num_engines_total[v->engine_type]++; });
 	}
 }
 
@@ -394,6 +447,9 @@ CommandCost CmdDeleteGroup(DoCommandFlag flags, GroupID group_id)
 		CloseWindowById(WC_REPLACE_VEHICLE, g->vehicle_type);
 		delete g;
 
+		/* The index of the deleted group may be reused later on. */
+		InvalidateEngineReplacementCache();
+
 		InvalidateWindowData(GetWindowClassForVehicleType(vt), VehicleListIdentifier(VL_GROUP_LIST, vt, _current_company).Pack());
 		InvalidateWindowData(WC_COMPANY_COLOUR, _current_company, vt);
 	}
@@ -445,7 +501,28 @@ CommandCost CmdAlterGroup(DoCommandFlag flags, AlterGroupMode mode, GroupID grou
 		}
 
 		if (flags & DC_EXEC) {
+			GroupID old_parent = g->parent;
 			g->parent = (pg == nullptr) ? INVALID_GROUP : pg->index;
+
+			if (old_parent != g->parent) {
+				/* Move the accumulated totals of this sub-tree from the old parent chain to the new one. */
+				auto move_totals = [g](GroupID id_g, int sign) {
+					UpdateTotals(g->owner, id_g, g->vehicle_type, [&](GroupStatistics &stats_total) {
+						stats_total.num_vehicle_total += sign * g->statistics.num_vehicle_total;
+						stats_total.num_vehicle_min_age_total += sign * g->statistics.num_vehicle_min_age_total;
+						stats_total.profit_last_year_min_age_total += sign * g->statistics.profit_last_year_min_age_total;
+						for (uint i = 0; i < Engine::GetPoolSize(); i++) {
+							stats_total.num_engines_total[i] += sign * g->statistics.num_engines_total[i];
+						}
+					});
+				};
+				if (old_parent != INVALID_GROUP) move_totals(old_parent, -1);
+				if (g->parent != INVALID_GROUP) move_totals(g->parent, +1);
+			}
+
+			/* Replacements of a parent group also apply to its children. */
+			InvalidateEngineReplacementCache();
+
 			GroupStatistics::UpdateAutoreplace(g->owner);
 
 			if (g->livery.in_use == 0) {
@@ -692,6 +769,9 @@ CommandCost CmdSetGroupFlag(DoCommandFlag flags, GroupID group_id, GroupFlags fl
 	if (flags & DC_EXEC) {
 		SetGroupFlag(g, flag, value, recursive);
 
+		/* The replace protection flag determines whether ALL_GROUP replacements apply. */
+		InvalidateEngineReplacementCache();
+
 		SetWindowDirty(GetWindowClassForVehicleType(g->vehicle_type), VehicleListIdentifier(VL_GROUP_LIST, g->vehicle_type, _current_company).Pack());
 		InvalidateWindowData(WC_REPLACE_VEHICLE, g->vehicle_type);
 	}
@@ -774,12 +854,8 @@ void UpdateTrainGroupID(Train *v)
  */
 uint GetGroupNumEngines(CompanyID company, GroupID id_g, EngineID id_e)
 {
-	uint count = 0;
 	const Engine *e = Engine::Get(id_e);
-	for (const Group *g : Group::Iterate()) {
-		if (g->parent == id_g) count += GetGroupNumEngines(company, g->index, id_e);
-	}
-	return count + GroupStatistics::Get(company, id_g, e->type).num_engines[id_e];
+	return GroupStatistics::Get(company, id_g, e->type).num_engines_total[id_e];
 }
 
 /**
@@ -792,11 +868,7 @@ uint GetGroupNumEngines(CompanyID company, GroupID id_g, EngineID id_e)
  */
 uint GetGroupNumVehicle(CompanyID company, GroupID id_g, VehicleType type)
 {
-	uint count = 0;
-	for (const Group *g : Group::Iterate()) {
-		if (g->parent == id_g) count += GetGroupNumVehicle(company, g->index, type);
-	}
-	return count + GroupStatistics::Get(company, id_g, type).num_vehicle;
+	return GroupStatistics::Get(company, id_g, type).num_vehicle_total;
 }
 
 /**
@@ -809,11 +881,7 @@ uint GetGroupNumVehicle(CompanyID company, GroupID id_g, VehicleType type)
  */
 uint GetGroupNumVehicleMinAge(CompanyID company, GroupID id_g, VehicleType type)
 {
-	uint count = 0;
-	for (const Group *g : Group::Iterate()) {
-		if (g->parent == id_g) count += GetGroupNumVehicleMinAge(company, g->index, type);
-	}
-	return count + GroupStatistics::Get(company, id_g, type).num_vehicle_min_age;
+	return GroupStatistics::Get(company, id_g, type).num_vehicle_min_age_total;
 }
 
 /**
@@ -826,11 +894,7 @@ uint GetGroupNumVehicleMinAge(CompanyID company, GroupID id_g, VehicleType type)
  */
 Money GetGroupProfitLastYearMinAge(CompanyID company, GroupID id_g, VehicleType type)
 {
-	Money sum = 0;
-	for (const Group *g : Group::Iterate()) {
-		if (g->parent == id_g) sum += GetGroupProfitLastYearMinAge(company, g->index, type);
-	}
-	return sum + GroupStatistics::Get(company, id_g, type).profit_last_year_min_age;
+	return GroupStatistics::Get(company, id_g, type).profit_last_year_min_age_total;
 }
 
 void RemoveAllGroupsForCompany(const CompanyID company)
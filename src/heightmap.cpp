@@ -74,57 +74,55 @@ static inline byte RGBToGrayscale(byte red, byte green, byte blue)
 
 /**
  * The PNG Heightmap loader.
+ * Builds the lookup table to convert palette indices to grayscale values.
  */
-static void ReadHeightmapPNGImageData(byte *map, png_structp png_ptr, png_infop info_ptr)
+static void ReadHeightmapPNGPalette(png_structp png_ptr, png_infop info_ptr, byte *gray_palette)
 {
-	uint x, y;
-	byte gray_palette[256];
-	png_bytep *row_pointers = nullptr;
-	bool has_palette = png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE;
-	uint channels = png_get_channels(png_ptr, info_ptr);
+	int i;
+	int palette_size;
+	png_color *palette;
+	bool all_gray = true;
 
 	/* Get palette and convert it to grayscale */
-	if (has_palette) {
-		int i;
-		int palette_size;
-		png_color *palette;
-		bool all_gray = true;
-
-		png_get_PLTE(png_ptr, info_ptr, &palette, &palette_size);
-		for (i = 0; i < palette_size && (palette_size != 16 || all_gray); i++) {
-			all_gray &= palette[i].red == palette[i].green && palette[i].red == palette[i].blue;
-			gray_palette[i] = RGBToGrayscale(palette[i].red, palette[i].green, palette[i].blue);
-		}
+	png_get_PLTE(png_ptr, info_ptr, &palette, &palette_size);
+	for (i = 0; i < palette_size && (palette_size != 16 || all_gray); i++) {
+		all_gray &= palette[i].red == palette[i].green && palette[i].red == palette[i].blue;
+		gray_palette[i] = RGBToGrayscale(palette[i].red, palette[i].green, palette[i].blue);
+	}
 
-		/**
-		 * For a non-gray palette of size 16 we assume that
-		 * the order of the palette determines the height;
-		 * the first entry is the sea (level 0), the second one
-		 * level 1, etc.
-		 */
-		if (palette_size == 16 && !all_gray) {
-			for (i = 0; i < palette_size; i++) {
-				gray_palette[i] = 256 * i / palette_size;
-			}
+	/**
+	 * For a non-gray palette of size 16 we assume that
+	 * the order of the palette determines the height;
+	 * the first entry is the sea (level 0), the second one
+	 * level 1, etc.
+	 */
+	if (palette_size == 16 && !all_gray) {
+		for (i = 0; i < palette_size; i++) {
+			gray_palette[i] = 256 * i / palette_size;
 		}
 	}
+}
 
-	row_pointers = png_get_rows(png_ptr, info_ptr);
+/**
+ * Convert a single row of decoded PNG image data to 8-bit grayscale.
+ * @param pixel        Destination for \a width converted pixels.
+ * @param width        Width of the image in pixels.
+ * @param channels     Number of channels per pixel in the decoded row.
+ * @param has_palette  Whether the image is palette based.
+ * @param gray_palette Palette index to grayscale lookup table.
+ * @param row          The decoded row of image data.
+ */
+static void ReadHeightmapPNGRow(byte *pixel, uint width, uint channels, bool has_palette, const byte *gray_palette, const png_byte *row)
+{
+	for (uint x = 0; x < width; x++) {
+		uint x_offset = x * channels;
 
-	/* Read the raw image data and convert in 8-bit grayscale */
-	for (x = 0; x < png_get_image_width(png_ptr, info_ptr); x++) {
-		for (y = 0; y < png_get_image_height(png_ptr, info_ptr); y++) {
-			byte *pixel = &map[y * png_get_image_width(png_ptr, info_ptr) + x];
-			uint x_offset = x * channels;
-
-			if (has_palette) {
-				*pixel = gray_palette[row_pointers[y][x_offset]];
-			} else if (channels == 3) {
-				*pixel = RGBToGrayscale(row_pointers[y][x_offset + 0],
-						row_pointers[y][x_offset + 1], row_pointers[y][x_offset + 2]);
-			} else {
-				*pixel = row_pointers[y][x_offset];
-			}
+		if (has_palette) {
+			*pixel++ = gray_palette[row[x_offset]];
+		} else if (channels == 3) {
+			*pixel++ = RGBToGrayscale(row[x_offset], row[x_offset + 1], row[x_offset + 2]);
+		} else {
+			*pixel++ = row[x_offset];
 		}
 	}
 }
@@ -139,6 +137,9 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 	FILE *fp;
 	png_structp png_ptr = nullptr;
 	png_infop info_ptr  = nullptr;
+	byte *volatile row = nullptr;          // Single-row buffer for sequentially read images.
+	byte *volatile image_data = nullptr;   // Whole-image buffer, only needed for interlaced images.
+	png_bytep *volatile row_pointers = nullptr;
 
 	fp = FioFOpenFile(filename, "rb", HEIGHTMAP_DIR);
 	if (fp == nullptr) {
@@ -156,6 +157,9 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 	info_ptr = png_create_info_struct(png_ptr);
 	if (info_ptr == nullptr || setjmp(png_jmpbuf(png_ptr))) {
 		ShowErrorMessage(STR_ERROR_PNGMAP, STR_ERROR_PNGMAP_MISC, WL_ERROR);
+		free(row);
+		free(image_data);
+		free(row_pointers);
 		fclose(fp);
 		png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
 		return false;
@@ -163,10 +167,14 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 
 	png_init_io(png_ptr, fp);
 
-	/* Allocate memory and read image, without alpha or 16-bit samples
-	 * (result is either 8-bit indexed/grayscale or 24-bit RGB) */
+	/* Read the image header and set up the transforms to strip alpha and
+	 * 16-bit samples (rows are either 8-bit indexed/grayscale or 24-bit RGB) */
+	png_read_info(png_ptr, info_ptr);
 	png_set_packing(png_ptr);
-	png_read_png(png_ptr, info_ptr, PNG_TRANSFORM_PACKING | PNG_TRANSFORM_STRIP_ALPHA | PNG_TRANSFORM_STRIP_16, nullptr);
+	png_set_strip_alpha(png_ptr);
+	png_set_strip_16(png_ptr);
+	int passes = png_set_interlace_handling(png_ptr);
+	png_read_update_info(png_ptr, info_ptr);
 
 	/* Maps of wrong colour-depth are not used.
 	 * (this should have been taken care of by stripping alpha and 16-bit samples on load) */
@@ -188,8 +196,42 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 	}
 
 	if (map != nullptr) {
+		byte gray_palette[256];
+		bool has_palette = png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE;
+		uint channels = png_get_channels(png_ptr, info_ptr);
+		size_t rowbytes = png_get_rowbytes(png_ptr, info_ptr);
+
+		if (has_palette) ReadHeightmapPNGPalette(png_ptr, info_ptr, gray_palette);
+
 		*map = MallocT<byte>(static_cast<size_t>(width) * height);
-		ReadHeightmapPNGImageData(*map, png_ptr, info_ptr);
+
+		if (passes == 1) {
+			/* Stream the image data row by row and convert it to 8-bit grayscale
+			 * on the fly, so only a single decoded row is in memory at a time. */
+			row = MallocT<byte>(rowbytes);
+			for (uint i = 0; i < height; i++) {
+				png_read_row(png_ptr, row, nullptr);
+				ReadHeightmapPNGRow(*map + static_cast<size_t>(i) * width, width, channels, has_palette, gray_palette, row);
+			}
+		} else {
+			/* Interlaced image; libpng fills the rows over multiple passes,
+			 * so all of them have to be kept in memory until the end. */
+			image_data = MallocT<byte>(rowbytes * height);
+			row_pointers = MallocT<png_bytep>(height);
+			for (uint i = 0; i < height; i++) row_pointers[i] = image_data + static_cast<size_t>(i) * rowbytes;
+			png_read_image(png_ptr, row_pointers);
+
+			for (uint i = 0; i < height; i++) {
+				ReadHeightmapPNGRow(*map + static_cast<size_t>(i) * width, width, channels, has_palette, gray_palette, row_pointers[i]);
+			}
+		}
+
+		free(row);
+		row = nullptr;
+		free(image_data);
+		image_data = nullptr;
+		free(row_pointers);
+		row_pointers = nullptr;
 	}
 
 	*x = width;
@@ -200,6 +200,7 @@ Industry::~Industry()
 
 	for (Station *st : this->stations_near) {
 		st->RemoveIndustryToDeliver(this);
+		st->acceptance_dirty = true;
 	}
 }
 
@@ -1125,7 +1126,12 @@ static void ChopLumberMillTrees(Industry *i)
 	}
 }
 
-static void ProduceIndustryGoods(Industry *i)
+/**
+ * Advance the tick counter of an industry and play its ambient sound.
+ * @param i Industry to tick.
+ * @return True if the industry is due for its 256 ticks production step.
+ */
+static bool ProduceIndustryGoods(Industry *i)
 {
 	const IndustrySpec *indsp = GetIndustrySpec(i->type);
 
@@ -1147,49 +1153,55 @@ static void ProduceIndustryGoods(Industry *i)
 
 	i->counter--;
 
-	/* produce some cargo */
-	if ((i->counter % INDUSTRY_PRODUCE_TICKS) == 0) {
-		if (HasBit(indsp->callback_mask, CBM_IND_PRODUCTION_256_TICKS)) IndustryProductionCallback(i, 1);
-
-		IndustryBehaviour indbehav = indsp->behaviour;
-		for (size_t j = 0; j < lengthof(i->produced_cargo_waiting); j++) {
-			i->produced_cargo_waiting[j] = std::min(0xffff, i->produced_cargo_waiting[j] + i->production_rate[j]);
-		}
+	return (i->counter % INDUSTRY_PRODUCE_TICKS) == 0;
+}
 
-		if ((indbehav & INDUSTRYBEH_PLANT_FIELDS) != 0) {
-			uint16 cb_res = CALLBACK_FAILED;
-			if (HasBit(indsp->callback_mask, CBM_IND_SPECIAL_EFFECT)) {
-				cb_res = GetIndustryCallback(CBID_INDUSTRY_SPECIAL_EFFECT, Random(), 0, i, i->type, i->location.tile);
-			}
+/**
+ * Run the 256 ticks production step of an industry. The production callback,
+ * if any, must have been run by the caller beforehand.
+ * @param i     Industry to produce cargo for.
+ * @param indsp Spec of the industry.
+ */
+static void ProduceIndustryGoodsStep(Industry *i, const IndustrySpec *indsp)
+{
+	IndustryBehaviour indbehav = indsp->behaviour;
+	for (size_t j = 0; j < lengthof(i->produced_cargo_waiting); j++) {
+		i->produced_cargo_waiting[j] = std::min(0xffff, i->produced_cargo_waiting[j] + i->production_rate[j]);
+	}
 
-			bool plant;
-			if (cb_res != CALLBACK_FAILED) {
-				plant = ConvertBooleanCallback(indsp->grf_prop.grffile, CBID_INDUSTRY_SPECIAL_EFFECT, cb_res);
-			} else {
-				plant = Chance16(1, 8);
-			}
+	if ((indbehav & INDUSTRYBEH_PLANT_FIELDS) != 0) {
+		uint16 cb_res = CALLBACK_FAILED;
+		if (HasBit(indsp->callback_mask, CBM_IND_SPECIAL_EFFECT)) {
+			cb_res = GetIndustryCallback(CBID_INDUSTRY_SPECIAL_EFFECT, Random(), 0, i, i->type, i->location.tile);
+		}
 
-			if (plant) PlantRandomFarmField(i);
+		bool plant;
+		if (cb_res != CALLBACK_FAILED) {
+			plant = ConvertBooleanCallback(indsp->grf_prop.grffile, CBID_INDUSTRY_SPECIAL_EFFECT, cb_res);
+		} else {
+			plant = Chance16(1, 8);
 		}
-		if ((indbehav & INDUSTRYBEH_CUT_TREES) != 0) {
-			uint16 cb_res = CALLBACK_FAILED;
-			if (HasBit(indsp->callback_mask, CBM_IND_SPECIAL_EFFECT)) {
-				cb_res = GetIndustryCallback(CBID_INDUSTRY_SPECIAL_EFFECT, Random(), 1, i, i->type, i->location.tile);
-			}
 
-			bool cut;
-			if (cb_res != CALLBACK_FAILED) {
-				cut = ConvertBooleanCallback(indsp->grf_prop.grffile, CBID_INDUSTRY_SPECIAL_EFFECT, cb_res);
-			} else {
-				cut = ((i->counter % INDUSTRY_CUT_TREE_TICKS) == 0);
-			}
+		if (plant) PlantRandomFarmField(i);
+	}
+	if ((indbehav & INDUSTRYBEH_CUT_TREES) != 0) {
+		uint16 cb_res = CALLBACK_FAILED;
+		if (HasBit(indsp->callback_mask, CBM_IND_SPECIAL_EFFECT)) {
+			cb_res = GetIndustryCallback(CBID_INDUSTRY_SPECIAL_EFFECT, Random(), 1, i, i->type, i->location.tile);
+		}
 
-			if (cut) ChopLumberMillTrees(i);
+		bool cut;
+		if (cb_res != CALLBACK_FAILED) {
+			cut = ConvertBooleanCallback(indsp->grf_prop.grffile, CBID_INDUSTRY_SPECIAL_EFFECT, cb_res);
+		} else {
+			cut = ((i->counter % INDUSTRY_CUT_TREE_TICKS) == 0);
 		}
 
-		TriggerIndustry(i, INDUSTRY_TRIGGER_INDUSTRY_TICK);
-		StartStopIndustryTileAnimation(i, IAT_INDUSTRY_TICK);
+		if (cut) ChopLumberMillTrees(i);
 	}
+
+	TriggerIndustry(i, INDUSTRY_TRIGGER_INDUSTRY_TICK);
+	StartStopIndustryTileAnimation(i, IAT_INDUSTRY_TICK);
 }
 
 void OnTick_Industry()
@@ -1207,8 +1219,33 @@ void OnTick_Industry()
 
 	if (_game_mode == GM_EDITOR) return;
 
+	static std::vector<Industry *> due;
+	due.clear();
+
 	for (Industry *i : Industry::Iterate()) {
-		ProduceIndustryGoods(i);
+		if (ProduceIndustryGoods(i)) due.push_back(i);
+	}
+
+	/* Run the production steps grouped by industry type, so the production
+	 * callback resolver is set up once per type instead of once per industry. */
+	std::sort(due.begin(), due.end(), [](const Industry *a, const Industry *b) {
+		return a->type != b->type ? a->type < b->type : a->index < b->index;
+	});
+
+	std::unique_ptr<IndustriesResolverObject> object;
+	IndustryType last_type = INVALID_INDUSTRYTYPE;
+	for (Industry *i : due) {
+		const IndustrySpec *indsp = GetIndustrySpec(i->type);
+		if (HasBit(indsp->callback_mask, CBM_IND_PRODUCTION_256_TICKS)) {
+			if (i->type != last_type) {
+				object.reset(new IndustriesResolverObject(i->location.tile, i, i->type));
+				last_type = i->type;
+			} else {
+				object->Retarget(i->location.tile, i);
+			}
+			IndustryProductionCallback(i, 1, *object);
+		}
+		ProduceIndustryGoodsStep(i, indsp);
 	}
 }
 
@@ -1719,6 +1756,7 @@ static void PopulateStationsNearby(Industry *ind)
 		ind->stations_near.insert(ind->neutral_station);
 		ind->neutral_station->industries_near.clear();
 		ind->neutral_station->industries_near.insert(IndustryListEntry{0, ind});
+		ind->neutral_station->acceptance_dirty = true;
 		return;
 	}
 
@@ -1726,6 +1764,7 @@ static void PopulateStationsNearby(Industry *ind)
 		if (!IsTileType(tile, MP_INDUSTRY) || GetIndustryIndex(tile) != ind->index) return false;
 		ind->stations_near.insert(st);
 		st->AddIndustryToDeliver(ind, tile);
+		st->acceptance_dirty = true;
 		return false;
 	});
 }
@@ -2254,9 +2293,20 @@ static uint GetNumberOfIndustries()
  */
 static Industry *PlaceIndustry(IndustryType type, IndustryAvailabilityCallType creation_type, bool try_hard)
 {
+	const IndustrySpec *indspec = GetIndustrySpec(type);
+
+	/* The built-in location check only depends on the tile, and rejects the
+	 * bulk of the candidate tiles for terrain bound industry types like
+	 * forests and farms, so run it before the full set of placement checks.
+	 * It is not used by industry types with a location callback. */
+	bool quick_check = !HasBit(indspec->callback_mask, CBM_IND_LOCATION);
+
 	uint tries = try_hard ? 10000u : 2000u;
 	for (; tries > 0; tries--) {
-		Industry *ind = CreateNewIndustry(RandomTile(), type, creation_type);
+		TileIndex tile = RandomTile();
+		if (quick_check && _check_new_industry_procs[indspec->check_proc](tile).Failed()) continue;
+
+		Industry *ind = CreateNewIndustry(tile, type, creation_type);
 		if (ind != nullptr) return ind;
 	}
 	return nullptr;
@@ -44,6 +44,7 @@
 #include "table/strings.h"
 
 #include <bitset>
+#include <unordered_map>
 
 #include "safeguards.h"
 
@@ -1320,6 +1321,9 @@ protected:
 	GUIIndustryList industries;
 	Scrollbar *vscroll;
 
+	/** Formatted row text per industry, filled lazily for the rows that get drawn. */
+	mutable std::unordered_map<IndustryID, std::string> industry_text_cache;
+
 	CargoID cargo_filter[NUM_CARGO + 2];        ///< Available cargo filters; CargoID or CF_ANY or CF_NONE
 	StringID cargo_filter_texts[NUM_CARGO + 3]; ///< Texts for filter_cargo, terminated by INVALID_STRING_ID
 	byte produced_cargo_filter_criteria;        ///< Selected produced cargo filter index
@@ -1347,6 +1351,8 @@ protected:
 			this->industries.SetFilterState(is_filtering_necessary);
 			this->industries.SetFilterType(0);
 			this->industries.ForceRebuild();
+			/* The filtered cargo is moved to the front of each row. */
+			this->industry_text_cache.clear();
 		}
 	}
 
@@ -1423,7 +1429,14 @@ protected:
 		this->industries.Filter(filter);
 
 		IndustryDirectoryWindow::produced_cargo_filter = this->cargo_filter[this->produced_cargo_filter_criteria];
-		this->industries.Sort();
+		if (this->industries.SortType() == 0 && StrNatSortKeysSupported()) {
+			/* Sorting by name collates per comparison; extract each industry's collation key once instead. */
+			this->industries.SortByKey([](const Industry * const &i) {
+				return std::make_pair(StrNatSortKey(i->GetCachedName()), i->index);
+			});
+		} else {
+			this->industries.Sort();
+		}
 
 		this->vscroll->SetCount((uint)this->industries.size()); // Update scrollbar as well.
 
@@ -1609,6 +1622,22 @@ protected:
 		}
 	}
 
+	/**
+	 * Get the formatted text to draw for the given industry, from the cache
+	 * when possible. The NewGRF cargo suffix callbacks and the string
+	 * formatting only run for industries that are not in the cache yet.
+	 * @param i the industry to get the text for.
+	 * @return the formatted text.
+	 */
+	const std::string &GetIndustryText(const Industry *i) const
+	{
+		auto it = this->industry_text_cache.find(i->index);
+		if (it == this->industry_text_cache.end()) {
+			it = this->industry_text_cache.emplace(i->index, GetString(this->GetIndustryString(i))).first;
+		}
+		return it->second;
+	}
+
 public:
 	IndustryDirectoryWindow(WindowDesc *desc, WindowNumber number) : Window(desc)
 	{
@@ -1674,7 +1703,7 @@ public:
 							tc = TC_GREY | TC_FORCED;
 						}
 					}
-					DrawString(ir, this->GetIndustryString(this->industries[i]), tc);
+					DrawString(ir, this->GetIndustryText(this->industries[i]), tc);
 
 					ir.top += this->resize.step_height;
 					if (++n == this->vscroll->GetCapacity()) break; // max number of industries in 1 window
@@ -1709,7 +1738,7 @@ public:
 			case WID_ID_INDUSTRY_LIST: {
 				Dimension d = GetStringBoundingBox(STR_INDUSTRY_DIRECTORY_NONE);
 				for (uint i = 0; i < this->industries.size(); i++) {
-					d = maxdim(d, GetStringBoundingBox(this->GetIndustryString(this->industries[i])));
+					d = maxdim(d, GetStringBoundingBox(this->GetIndustryText(this->industries[i])));
 				}
 				resize->height = d.height;
 				d.height *= 5;
@@ -1762,6 +1791,8 @@ public:
 			case WID_ID_DROPDOWN_CRITERIA: {
 				if (this->industries.SortType() != index) {
 					this->industries.SetSortType(index);
+					/* The sort criteria also orders the cargoes within each row. */
+					this->industry_text_cache.clear();
 					this->BuildSortIndustriesList();
 				}
 				break;
@@ -1805,6 +1836,9 @@ public:
 	 */
 	void OnInvalidateData(int data = 0, bool gui_scope = true) override
 	{
+		/* Industries or their production changed; the cached row texts are stale. */
+		this->industry_text_cache.clear();
+
 		switch (data) {
 			case IDIWD_FORCE_REBUILD:
 				/* This needs to be done in command-scope to enforce rebuilding before resorting invalid data */
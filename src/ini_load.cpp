@@ -8,11 +8,11 @@
 /** @file ini_load.cpp Definition of the #IniLoadFile class, related to reading and storing '*.ini' files. */
 
 #include "stdafx.h"
-#include "core/alloc_func.hpp"
-#include "core/mem_func.hpp"
 #include "ini_type.h"
 #include "string_func.h"
 
+#include <vector>
+
 #include "safeguards.h"
 
 /**
@@ -216,67 +216,68 @@ void IniLoadFile::LoadFromDisk(const std::string &filename, Subdirectory subdir)
 {
 	assert(this->last_group == &this->group);
 
-	char buffer[1024];
 	IniGroup *group = nullptr;
-
-	char *comment = nullptr;
-	uint comment_size = 0;
-	uint comment_alloc = 0;
+	std::string comment;
 
 	size_t end;
 	FILE *in = this->OpenFile(filename, subdir, &end);
 	if (in == nullptr) return;
 
-	end += ftell(in);
+	/* Read the whole file in one go and parse the lines in place; this saves
+	 * the buffered per-line reads and the file position bookkeeping, and the
+	 * file might start at an offset within a tar. */
+	std::vector<char> contents(end + 1);
+	size_t read = fread(contents.data(), 1, end, in);
+	fclose(in);
+	contents[read] = '\0';
+
+	char *pos = contents.data();
+	char * const file_end = pos + read;
 
 	/* for each line in the file */
-	while ((size_t)ftell(in) < end && fgets(buffer, sizeof(buffer), in)) {
+	while (pos < file_end) {
+		char *line = pos;
+		char *eol = std::find(pos, file_end, '\n');
+		pos = eol + 1;
+		*eol = '\0';
+
 		char c, *s;
 		/* trim whitespace from the left side */
-		for (s = buffer; *s == ' ' || *s == '\t'; s++) {}
+		for (s = line; *s == ' ' || *s == '\t'; s++) {}
 
 		/* trim whitespace from right side. */
-		char *e = s + strlen(s);
-		while (e > s && ((c = e[-1]) == '\n' || c == '\r' || c == ' ' || c == '\t')) e--;
+		char *e = eol;
+		while (e > s && ((c = e[-1]) == '\r' || c == ' ' || c == '\t')) e--;
 		*e = '\0';
 
 		/* Skip comments and empty lines outside IGT_SEQUENCE groups. */
 		if ((group == nullptr || group->type != IGT_SEQUENCE) && (*s == '#' || *s == ';' || *s == '\0')) {
-			uint ns = comment_size + (e - s + 1);
-			uint a = comment_alloc;
 			/* add to comment */
-			if (ns > a) {
-				a = std::max(a, 128U);
-				do a *= 2; while (a < ns);
-				comment = ReallocT(comment, comment_alloc = a);
-			}
-			uint pos = comment_size;
-			comment_size += (e - s + 1);
-			comment[pos + e - s] = '\n'; // comment newline
-			memcpy(comment + pos, s, e - s); // copy comment contents
+			comment.append(s, e - s);
+			comment += '\n';
 			continue;
 		}
 
 		/* it's a group? */
 		if (s[0] == '[') {
 			if (e[-1] != ']') {
-				this->ReportFileError("ini: invalid group name '", buffer, "'");
+				this->ReportFileError("ini: invalid group name '", line, "'");
 			} else {
 				e--;
 			}
 			s++; // skip [
 			group = new IniGroup(this, std::string(s, e - s));
-			if (comment_size != 0) {
-				group->comment.assign(comment, comment_size);
-				comment_size = 0;
+			if (!comment.empty()) {
+				group->comment = std::move(comment);
+				comment.clear();
 			}
 		} else if (group != nullptr) {
 			if (group->type == IGT_SEQUENCE) {
 				/* A sequence group, use the line as item name without further interpretation. */
-				IniItem *item = new IniItem(group, std::string(buffer, e - buffer));
-				if (comment_size) {
-					item->comment.assign(comment, comment_size);
-					comment_size = 0;
+				IniItem *item = new IniItem(group, std::string(line, e - line));
+				if (!comment.empty()) {
+					item->comment = std::move(comment);
+					comment.clear();
 				}
 				continue;
 			}
@@ -292,9 +293,9 @@ void IniLoadFile::LoadFromDisk(const std::string &filename, Subdirectory subdir)
 
 			/* it's an item in an existing group */
 			IniItem *item = new IniItem(group, std::string(s, t - s));
-			if (comment_size != 0) {
-				item->comment.assign(comment, comment_size);
-				comment_size = 0;
+			if (!comment.empty()) {
+				item->comment = std::move(comment);
+				comment.clear();
 			}
 
 			/* find start of parameter */
@@ -316,16 +317,10 @@ void IniLoadFile::LoadFromDisk(const std::string &filename, Subdirectory subdir)
 			}
 		} else {
 			/* it's an orphan item */
-			this->ReportFileError("ini: '", buffer, "' outside of group");
+			this->ReportFileError("ini: '", line, "' outside of group");
 		}
 	}
 
-	if (comment_size > 0) {
-		this->comment.assign(comment, comment_size);
-		comment_size = 0;
-	}
-
-	free(comment);
-	fclose(in);
+	if (!comment.empty()) this->comment = std::move(comment);
 }
 
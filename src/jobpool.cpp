@@ -0,0 +1,185 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file jobpool.cpp Implementation of the shared worker pool for background jobs. */
+
+#include "stdafx.h"
+#include "jobpool.h"
+#include "thread.h"
+#include <atomic>
+#include <condition_variable>
+#include <vector>
+
+#include "safeguards.h"
+
+/** Shared state of a job submitted to the worker pool. */
+struct PoolJob {
+	std::function<void()> proc;          ///< Payload of the job.
+	const char *name;                    ///< Name for the thread while the job runs.
+	JobPriority priority;                ///< Scheduling priority of the job.
+	std::shared_ptr<PoolJob> dependency; ///< Job that has to finish before this one runs, or \c nullptr.
+	std::atomic<bool> claimed{false};    ///< Whether some thread claimed the job for execution.
+	bool done = false;                   ///< Whether the job has finished; protected by #_jobpool_mutex.
+};
+
+static std::mutex _jobpool_mutex;                            ///< Protects the queue, the worker administration and the done flags.
+static std::condition_variable _jobpool_pending;             ///< Signalled when a job is queued or the pool shuts down.
+static std::condition_variable _jobpool_done;                ///< Signalled when a job has finished.
+static std::vector<std::shared_ptr<PoolJob>> _jobpool_queue; ///< Jobs waiting for a worker.
+static std::vector<std::thread> _jobpool_workers;            ///< Worker threads of the pool.
+static uint _jobpool_idle = 0;                               ///< Number of workers waiting for work.
+static bool _jobpool_shutdown = false;                       ///< Workers exit when this is set.
+
+static void JoinJob(const std::shared_ptr<PoolJob> &job);
+
+/**
+ * Run a claimed job on the calling thread and mark it as done.
+ * @param job Job to run; must have been claimed by the caller.
+ */
+static void RunJob(const std::shared_ptr<PoolJob> &job)
+{
+	/* Jobs wait for their dependency themselves; JoinJob executes a
+	 * dependency that has not started yet right here, so dependency
+	 * chains cannot deadlock however small the pool is. */
+	if (job->dependency != nullptr) {
+		JoinJob(job->dependency);
+		job->dependency = nullptr;
+	}
+
+	job->proc();
+
+	std::lock_guard<std::mutex> lock(_jobpool_mutex);
+	job->done = true;
+	_jobpool_done.notify_all();
+}
+
+/**
+ * Wait until the given job has finished. A job that no worker picked up
+ * yet is "stolen" and executed on the calling thread instead of waiting
+ * for a worker to become free.
+ * @param job Job to wait for.
+ */
+static void JoinJob(const std::shared_ptr<PoolJob> &job)
+{
+	if (!job->claimed.exchange(true)) {
+		RunJob(job);
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(_jobpool_mutex);
+	_jobpool_done.wait(lock, [&job]() { return job->done; });
+}
+
+/** Main loop of a pool worker thread. */
+static void JobPoolWorker()
+{
+	std::unique_lock<std::mutex> lock(_jobpool_mutex);
+	for (;;) {
+		_jobpool_idle++;
+		_jobpool_pending.wait(lock, []() { return _jobpool_shutdown || !_jobpool_queue.empty(); });
+		_jobpool_idle--;
+		if (_jobpool_shutdown) return;
+
+		/* Take the oldest job with the highest priority. */
+		auto best = _jobpool_queue.begin();
+		for (auto it = best + 1; it != _jobpool_queue.end(); ++it) {
+			if ((*it)->priority > (*best)->priority) best = it;
+		}
+		std::shared_ptr<PoolJob> job = *best;
+		_jobpool_queue.erase(best);
+
+		lock.unlock();
+		if (!job->claimed.exchange(true)) {
+			SetCurrentThreadName(job->name);
+			RunJob(job);
+			SetCurrentThreadName("ottd:jobpool");
+		}
+		lock.lock();
+	}
+}
+
+/**
+ * Has the job finished?
+ * @return True when the job is done or the handle refers to no job.
+ */
+bool JobHandle::IsDone() const
+{
+	if (this->job == nullptr) return true;
+	std::lock_guard<std::mutex> lock(_jobpool_mutex);
+	return this->job->done;
+}
+
+/**
+ * Wait until the job has finished and detach the handle from it.
+ * When no worker has started the job yet it is run on the calling thread.
+ */
+void JobHandle::Join()
+{
+	if (this->job == nullptr) return;
+	JoinJob(this->job);
+	this->job = nullptr;
+}
+
+/**
+ * Submit a job to the shared worker pool.
+ * Worker threads are started on demand, up to one less than the number of
+ * cores of the machine so the main thread keeps a core for itself.
+ * @param proc       Payload to run.
+ * @param name       Name for the thread while the job runs.
+ * @param priority   Scheduling priority of the job.
+ * @param dependency Job that has to finish before this one runs.
+ * @return Handle to the job, or an invalid handle if no worker thread could
+ *         be started at all; in that case nothing has been run and the
+ *         caller has to do the work itself.
+ */
+JobHandle SubmitJob(std::function<void()> &&proc, const char *name, JobPriority priority, JobHandle dependency)
+{
+	auto job = std::make_shared<PoolJob>();
+	job->proc = std::move(proc);
+	job->name = name;
+	job->priority = priority;
+	job->dependency = std::move(dependency.job);
+
+	std::lock_guard<std::mutex> lock(_jobpool_mutex);
+	if (_jobpool_shutdown) return {};
+
+	if (_jobpool_idle == 0) {
+		uint num_cores = std::thread::hardware_concurrency();
+		uint max_workers = num_cores <= 1 ? 1 : num_cores - 1;
+		if (_jobpool_workers.size() < max_workers) {
+			_jobpool_workers.emplace_back();
+			if (!StartNewThread(&_jobpool_workers.back(), "ottd:jobpool", &JobPoolWorker)) _jobpool_workers.pop_back();
+		}
+	}
+	if (_jobpool_workers.empty()) return {};
+
+	_jobpool_queue.push_back(job);
+	_jobpool_pending.notify_one();
+
+	JobHandle handle;
+	handle.job = std::move(job);
+	return handle;
+}
+
+/** Stop all worker threads and run any job that is still queued. */
+void StopJobPool()
+{
+	std::vector<std::thread> workers;
+	std::vector<std::shared_ptr<PoolJob>> queue;
+	{
+		std::lock_guard<std::mutex> lock(_jobpool_mutex);
+		_jobpool_shutdown = true;
+		_jobpool_pending.notify_all();
+		workers.swap(_jobpool_workers);
+		queue.swap(_jobpool_queue);
+	}
+
+	for (std::thread &worker : workers) worker.join();
+	for (const std::shared_ptr<PoolJob> &job : queue) {
+		if (!job->claimed.exchange(true)) RunJob(job);
+	}
+}
@@ -0,0 +1,48 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file jobpool.h Shared worker pool for background jobs. */
+
+#ifndef JOBPOOL_H
+#define JOBPOOL_H
+
+#include <functional>
+#include <memory>
+
+/** Scheduling priority of a background job; higher priorities are started first. */
+enum JobPriority : byte {
+	JOB_PRIORITY_LOW,    ///< Work that may be delayed arbitrarily.
+	JOB_PRIORITY_NORMAL, ///< Default priority for background work.
+	JOB_PRIORITY_HIGH,   ///< Work with a deadline, e.g. link graph jobs.
+};
+
+struct PoolJob;
+
+/**
+ * Handle to a job submitted to the shared worker pool.
+ * A default-constructed handle refers to no job and is considered done.
+ */
+class JobHandle {
+	std::shared_ptr<PoolJob> job; ///< Shared state of the job, or \c nullptr.
+
+	friend JobHandle SubmitJob(std::function<void()> &&proc, const char *name, JobPriority priority, JobHandle dependency);
+
+public:
+	/**
+	 * Is this handle attached to a job?
+	 * @return True when the handle refers to a submitted job.
+	 */
+	bool IsValid() const { return this->job != nullptr; }
+
+	bool IsDone() const;
+	void Join();
+};
+
+JobHandle SubmitJob(std::function<void()> &&proc, const char *name, JobPriority priority = JOB_PRIORITY_NORMAL, JobHandle dependency = {});
+void StopJobPool();
+
+#endif /* JOBPOOL_H */
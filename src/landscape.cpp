@@ -91,6 +91,9 @@ extern const byte _slope_to_sprite_offset[32] = {
  */
 static SnowLine *_snow_line = nullptr;
 
+static Date _snow_line_date = INVALID_DATE; ///< Date #_snow_line_height was computed for.
+static byte _snow_line_height;              ///< Variable snow line height looked up for #_snow_line_date.
+
 /**
  * Map 2D viewport or smallmap coordinate to 3D world or tile coordinate.
  * Function takes into account height of tiles and foundations.
@@ -586,6 +589,8 @@ void DoClearSquare(TileIndex tile)
 	MakeClear(tile, CLEAR_GRASS, _generating_world ? 3 : 0);
 	MarkTileDirtyByTile(tile);
 	if (remove) RemoveDockingTile(tile);
+
+	ClearNeighbourNonFloodingStates(tile);
 }
 
 /**
@@ -638,6 +643,7 @@ void SetSnowLine(byte table[SNOW_LINE_MONTHS][SNOW_LINE_DAYS])
 {
 	_snow_line = CallocT<SnowLine>(1);
 	_snow_line->lowest_value = 0xFF;
+	_snow_line_date = INVALID_DATE;
 	memcpy(_snow_line->table, table, sizeof(_snow_line->table));
 
 	for (uint i = 0; i < SNOW_LINE_MONTHS; i++) {
@@ -657,9 +663,17 @@ byte GetSnowLine()
 {
 	if (_snow_line == nullptr) return _settings_game.game_creation.snow_line_height;
 
-	YearMonthDay ymd;
-	ConvertDateToYMD(_date, &ymd);
-	return _snow_line->table[ymd.month][ymd.day];
+	/* On arctic maps every clear, tree, road and rail tile loop invocation
+	 * queries the snow line, so don't redo the date conversion until the
+	 * date changes. The cached value is derived from the date and the table
+	 * only and thus stays in sync across network clients. */
+	if (_snow_line_date != _date) {
+		YearMonthDay ymd;
+		ConvertDateToYMD(_date, &ymd);
+		_snow_line_date = _date;
+		_snow_line_height = _snow_line->table[ymd.month][ymd.day];
+	}
+	return _snow_line_height;
 }
 
 /**
@@ -799,6 +813,19 @@ std::tuple<CommandCost, Money> CmdClearArea(DoCommandFlag flags, TileIndex tile,
 
 TileIndex _cur_tileloop_tile;
 
+/**
+ * Prefetch the map data of a tile into the processor cache.
+ * @param tile Tile to prefetch.
+ */
+static inline void PrefetchTileData(TileIndex tile)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(&_mb[tile]);
+	__builtin_prefetch(&_m[tile]);
+	__builtin_prefetch(&_me[tile]);
+#endif
+}
+
 /**
  * Gradually iterate over all tiles on the map, calling their TileLoopProcs once every 256 ticks.
  */
@@ -825,6 +852,18 @@ void RunTileLoop()
 	/* The LFSR cannot have a zeroed state. */
 	assert(tile != 0);
 
+	/* The procs cannot be run in parallel or out of order: they draw from the
+	 * shared Random() stream and modify neighbouring tiles (flooding, town
+	 * growth), so the LFSR sequence is part of the simulation. The pseudorandom
+	 * walk does however touch memory in an unpredictable pattern, so run the
+	 * LFSR a few steps ahead of the loop and prefetch the tile data. */
+	static const uint LOOKAHEAD = 8;
+	TileIndex prefetch = tile;
+	for (uint i = 0; i < LOOKAHEAD; i++) {
+		PrefetchTileData(prefetch);
+		prefetch = (prefetch >> 1) ^ (-(int32)(prefetch & 1) & feedback);
+	}
+
 	/* Manually update tile 0 every 256 ticks - the LFSR never iterates over it itself.  */
 	if (_tick_counter % 256 == 0) {
 		_tile_type_procs[GetTileType(0)]->tile_loop_proc(0);
@@ -834,6 +873,9 @@ void RunTileLoop()
 	while (count--) {
 		_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
 
+		PrefetchTileData(prefetch);
+		prefetch = (prefetch >> 1) ^ (-(int32)(prefetch & 1) & feedback);
+
 		/* Get the next tile in sequence using a Galois LFSR. */
 		tile = (tile >> 1) ^ (-(int32)(tile & 1) & feedback);
 	}
@@ -1340,23 +1382,27 @@ static void BuildRiver(TileIndex begin, TileIndex end, TileIndex spring, bool ma
 {
 	River_UserData user_data = { spring, main_river };
 
-	AyStar finder = {};
-	finder.CalculateG = River_CalculateG;
-	finder.CalculateH = River_CalculateH;
-	finder.GetNeighbours = River_GetNeighbours;
-	finder.EndNodeCheck = River_EndNodeCheck;
-	finder.FoundEndNode = River_FoundEndNode;
+	/* The finder is reused for all rivers of the map; its internal memory
+	 * is bulk-reset between the searches instead of reallocated. */
+	static AyStar finder = {};
+	static bool first_init = true;
+	if (first_init) {
+		first_init = false;
+		finder.CalculateG = River_CalculateG;
+		finder.CalculateH = River_CalculateH;
+		finder.GetNeighbours = River_GetNeighbours;
+		finder.EndNodeCheck = River_EndNodeCheck;
+		finder.FoundEndNode = River_FoundEndNode;
+		finder.Init(River_Hash, 1 << RIVER_HASH_SIZE);
+	}
 	finder.user_target = &end;
 	finder.user_data = &user_data;
 
-	finder.Init(River_Hash, 1 << RIVER_HASH_SIZE);
-
 	AyStarNode start;
 	start.tile = begin;
 	start.direction = INVALID_TRACKDIR;
 	finder.AddStartNode(&start, 0);
 	finder.Main();
-	finder.Free();
 }
 
 /**
@@ -20,7 +20,13 @@ static const uint8 CASE_GENDER_LEN = 16; ///< The (maximum) length of a case/gen
 static const uint8 MAX_NUM_GENDERS =  8; ///< Maximum number of supported genders.
 static const uint8 MAX_NUM_CASES   = 16; ///< Maximum number of supported cases.
 
-/** Header of a language file. */
+/**
+ * Header of a language file.
+ *
+ * The header is followed by an offset table holding one little endian uint32
+ * per string, relative to the start of the string data, which in turn is
+ * followed by the zero terminated encoded strings themselves.
+ */
 struct LanguagePackHeader {
 	static const uint32 IDENT = 0x474E414C; ///< Identifier for OpenTTD language files, big endian for "LANG"
 
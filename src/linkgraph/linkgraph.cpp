@@ -10,6 +10,7 @@
 #include "../stdafx.h"
 #include "../core/pool_func.hpp"
 #include "linkgraph.h"
+#include "refresh.h"
 
 #include "../safeguards.h"
 
@@ -17,6 +18,8 @@
 LinkGraphPool _link_graph_pool("LinkGraph");
 INSTANTIATE_POOL_METHODS(LinkGraph)
 
+/* static */ const LinkGraph::BaseEdge LinkGraph::empty_edge = {0, 0, 0, INVALID_DATE, INVALID_DATE, INVALID_NODE, INVALID_NODE};
+
 /**
  * Create a node or clear it.
  * @param xy Location of the associated station.
@@ -35,13 +38,14 @@ inline void LinkGraph::BaseNode::Init(TileIndex xy, StationID st, uint demand)
 /**
  * Create an edge.
  */
-inline void LinkGraph::BaseEdge::Init()
+void LinkGraph::BaseEdge::Init()
 {
 	this->capacity = 0;
 	this->usage = 0;
 	this->travel_time_sum = 0;
 	this->last_unrestricted_update = INVALID_DATE;
 	this->last_restricted_update = INVALID_DATE;
+	this->dest_node = INVALID_NODE;
 	this->next_edge = INVALID_NODE;
 }
 
@@ -53,11 +57,13 @@ inline void LinkGraph::BaseEdge::Init()
 void LinkGraph::ShiftDates(int interval)
 {
 	this->last_compression += interval;
+	this->last_change += interval;
+	this->last_job_spawn += interval;
+	InvalidateLinkRefreshMemo();
 	for (NodeID node1 = 0; node1 < this->Size(); ++node1) {
 		BaseNode &source = this->nodes[node1];
 		if (source.last_update != INVALID_DATE) source.last_update += interval;
-		for (NodeID node2 = 0; node2 < this->Size(); ++node2) {
-			BaseEdge &edge = this->edges[node1][node2];
+		for (BaseEdge &edge : this->edges[node1]) {
 			if (edge.last_unrestricted_update != INVALID_DATE) edge.last_unrestricted_update += interval;
 			if (edge.last_restricted_update != INVALID_DATE) edge.last_restricted_update += interval;
 		}
@@ -67,10 +73,12 @@ void LinkGraph::ShiftDates(int interval)
 void LinkGraph::Compress()
 {
 	this->last_compression = (_date + this->last_compression) / 2;
+	this->MarkChanged();
+	/* Compression scales edge capacities down, so repeating a refresh becomes meaningful again. */
+	InvalidateLinkRefreshMemo();
 	for (NodeID node1 = 0; node1 < this->Size(); ++node1) {
 		this->nodes[node1].supply /= 2;
-		for (NodeID node2 = 0; node2 < this->Size(); ++node2) {
-			BaseEdge &edge = this->edges[node1][node2];
+		for (BaseEdge &edge : this->edges[node1]) {
 			if (edge.capacity > 0) {
 				uint new_capacity = std::max(1U, edge.capacity / 2);
 				if (edge.capacity < (1 << 16)) {
@@ -91,6 +99,7 @@ void LinkGraph::Compress()
  */
 void LinkGraph::Merge(LinkGraph *other)
 {
+	this->MarkChanged();
 	Date age = _date - this->last_compression + 1;
 	Date other_age = _date - other->last_compression + 1;
 	NodeID first = this->Size();
@@ -100,23 +109,16 @@ void LinkGraph::Merge(LinkGraph *other)
 		this->nodes[new_node].supply = LinkGraph::Scale(other->nodes[node1].supply, age, other_age);
 		st->goods[this->cargo].link_graph = this->index;
 		st->goods[this->cargo].node = new_node;
-		for (NodeID node2 = 0; node2 < node1; ++node2) {
-			BaseEdge &forward = this->edges[new_node][first + node2];
-			BaseEdge &backward = this->edges[first + node2][new_node];
-			forward = other->edges[node1][node2];
-			backward = other->edges[node2][node1];
-			forward.capacity = LinkGraph::Scale(forward.capacity, age, other_age);
-			forward.usage = LinkGraph::Scale(forward.usage, age, other_age);
-			forward.travel_time_sum = LinkGraph::Scale(forward.travel_time_sum, age, other_age);
-			if (forward.next_edge != INVALID_NODE) forward.next_edge += first;
-			backward.capacity = LinkGraph::Scale(backward.capacity, age, other_age);
-			backward.usage = LinkGraph::Scale(backward.usage, age, other_age);
-			backward.travel_time_sum = LinkGraph::Scale(backward.travel_time_sum, age, other_age);
-			if (backward.next_edge != INVALID_NODE) backward.next_edge += first;
+		/* Copy the other node's edges wholesale; shifting all destinations by
+		 * "first" keeps the vector sorted. */
+		EdgeVector &new_edges = this->edges[new_node];
+		new_edges = other->edges[node1];
+		for (BaseEdge &edge : new_edges) {
+			edge.dest_node += first;
+			edge.capacity = LinkGraph::Scale(edge.capacity, age, other_age);
+			edge.usage = LinkGraph::Scale(edge.usage, age, other_age);
+			edge.travel_time_sum = LinkGraph::Scale(edge.travel_time_sum, age, other_age);
 		}
-		BaseEdge &new_start = this->edges[new_node][new_node];
-		new_start = other->edges[node1][node1];
-		if (new_start.next_edge != INVALID_NODE) new_start.next_edge += first;
 	}
 	delete other;
 }
@@ -129,38 +131,30 @@ void LinkGraph::RemoveNode(NodeID id)
 {
 	assert(id < this->Size());
 
+	this->MarkChanged();
 	NodeID last_node = this->Size() - 1;
 	for (NodeID i = 0; i <= last_node; ++i) {
 		(*this)[i].RemoveEdge(id);
-		BaseEdge *node_edges = this->edges[i];
-		NodeID prev = i;
-		NodeID next = node_edges[i].next_edge;
-		while (next != INVALID_NODE) {
-			if (next == last_node) {
-				node_edges[prev].next_edge = id;
-				break;
-			}
-			prev = next;
-			next = node_edges[prev].next_edge;
+		/* The last node is moved to the removed node's ID below, so retarget
+		 * edges pointing at it and restore the sort order. */
+		BaseEdge *edge = LinkGraph::FindEdge(this->edges[i], last_node);
+		if (edge != nullptr) {
+			edge->dest_node = id;
+			std::sort(this->edges[i].begin(), this->edges[i].end());
 		}
-		node_edges[id] = node_edges[last_node];
 	}
 	Station::Get(this->nodes[last_node].station)->goods[this->cargo].node = id;
 	/* Erase node by swapping with the last element. Node index is referenced
 	 * directly from station goods entries so the order and position must remain. */
 	this->nodes[id] = this->nodes.back();
 	this->nodes.pop_back();
-	this->edges.EraseColumn(id);
-	/* Not doing EraseRow here, as having the extra invalid row doesn't hurt
-	 * and removing it would trigger a lot of memmove. The data has already
-	 * been copied around in the loop above. */
+	std::swap(this->edges[id], this->edges.back());
+	this->edges.pop_back();
 }
 
 /**
- * Add a node to the component and create empty edges associated with it. Set
- * the station's last_component to this component. Calculate the distances to all
- * other nodes. The distances to _all_ nodes are important as the demand
- * calculator relies on their availability.
+ * Add a node to the component and an empty edge vector to go with it. Set
+ * the station's last_component to this component.
  * @param st New node's station.
  * @return New node's ID.
  */
@@ -168,24 +162,13 @@ NodeID LinkGraph::AddNode(const Station *st)
 {
 	const GoodsEntry &good = st->goods[this->cargo];
 
+	this->MarkChanged();
 	NodeID new_node = this->Size();
 	this->nodes.emplace_back();
-	/* Avoid reducing the height of the matrix as that is expensive and we
-	 * most likely will increase it again later which is again expensive. */
-	this->edges.Resize(new_node + 1U, std::max(new_node + 1U, this->edges.Height()));
+	this->edges.emplace_back();
 
 	this->nodes[new_node].Init(st->xy, st->index,
 			HasBit(good.status, GoodsEntry::GES_ACCEPTANCE));
-
-	BaseEdge *new_edges = this->edges[new_node];
-
-	/* Reset the first edge starting at the new node */
-	new_edges[new_node].next_edge = INVALID_NODE;
-
-	for (NodeID i = 0; i <= new_node; ++i) {
-		new_edges[i].Init();
-		this->edges[i][new_node].Init();
-	}
 	return new_node;
 }
 
@@ -200,15 +183,17 @@ NodeID LinkGraph::AddNode(const Station *st)
 void LinkGraph::Node::AddEdge(NodeID to, uint capacity, uint usage, uint32 travel_time, EdgeUpdateMode mode)
 {
 	assert(this->index != to);
-	BaseEdge &edge = this->edges[to];
-	BaseEdge &first = this->edges[this->index];
+	assert(LinkGraph::FindEdge(this->edges, to) == nullptr);
+	BaseEdge edge;
+	edge.Init();
+	edge.dest_node = to;
 	edge.capacity = capacity;
 	edge.usage = usage;
 	edge.travel_time_sum = static_cast<uint64>(travel_time) * capacity;
-	edge.next_edge = first.next_edge;
-	first.next_edge = to;
 	if (mode & EUM_UNRESTRICTED)  edge.last_unrestricted_update = _date;
 	if (mode & EUM_RESTRICTED) edge.last_restricted_update = _date;
+	this->edges.insert(std::upper_bound(this->edges.begin(), this->edges.end(), edge), edge);
+	this->graph->MarkChanged();
 }
 
 /**
@@ -222,10 +207,12 @@ void LinkGraph::Node::UpdateEdge(NodeID to, uint capacity, uint usage, uint32 tr
 {
 	assert(capacity > 0);
 	assert(usage <= capacity);
-	if (this->edges[to].capacity == 0) {
+	BaseEdge *edge = LinkGraph::FindEdge(this->edges, to);
+	if (edge == nullptr) {
 		this->AddEdge(to, capacity, usage, travel_time, mode);
 	} else {
-		(*this)[to].Update(capacity, usage, travel_time, mode);
+		Edge(*edge).Update(capacity, usage, travel_time, mode);
+		this->graph->MarkChanged();
 	}
 }
 
@@ -236,26 +223,10 @@ void LinkGraph::Node::UpdateEdge(NodeID to, uint capacity, uint usage, uint32 tr
 void LinkGraph::Node::RemoveEdge(NodeID to)
 {
 	if (this->index == to) return;
-	BaseEdge &edge = this->edges[to];
-	edge.capacity = 0;
-	edge.last_unrestricted_update = INVALID_DATE;
-	edge.last_restricted_update = INVALID_DATE;
-	edge.usage = 0;
-	edge.travel_time_sum = 0;
-
-	NodeID prev = this->index;
-	NodeID next = this->edges[this->index].next_edge;
-	while (next != INVALID_NODE) {
-		if (next == to) {
-			/* Will be removed, skip it. */
-			this->edges[prev].next_edge = edge.next_edge;
-			edge.next_edge = INVALID_NODE;
-			break;
-		} else {
-			prev = next;
-			next = this->edges[next].next_edge;
-		}
-	}
+	BaseEdge *edge = LinkGraph::FindEdge(this->edges, to);
+	if (edge == nullptr) return;
+	this->edges.erase(this->edges.begin() + (edge - this->edges.data()));
+	this->graph->MarkChanged();
 }
 
 /**
@@ -298,19 +269,15 @@ void LinkGraph::Edge::Update(uint capacity, uint usage, uint32 travel_time, Edge
 }
 
 /**
- * Resize the component and fill it with empty nodes and edges. Used when
- * loading from save games. The component is expected to be empty before.
+ * Resize the component and fill it with empty nodes. Used when loading from
+ * save games. The component is expected to be empty before.
  * @param size New size of the component.
  */
 void LinkGraph::Init(uint size)
 {
 	assert(this->Size() == 0);
-	this->edges.Resize(size, size);
 	this->nodes.resize(size);
+	this->edges.resize(size);
 
-	for (uint i = 0; i < size; ++i) {
-		this->nodes[i].Init();
-		BaseEdge *column = this->edges[i];
-		for (uint j = 0; j < size; ++j) column[j].Init();
-	}
+	for (uint i = 0; i < size; ++i) this->nodes[i].Init();
 }
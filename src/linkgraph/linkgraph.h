@@ -12,7 +12,6 @@
 
 #include "../core/pool_type.hpp"
 #include "../core/smallmap_type.hpp"
-#include "../core/smallmatrix_type.hpp"
 #include "../station_base.h"
 #include "../cargotype.h"
 #include "../date_func.h"
@@ -54,10 +53,9 @@ public:
 	};
 
 	/**
-	 * An edge in the link graph. Corresponds to a link between two stations or at
-	 * least the distance between them. Edges from one node to itself contain the
-	 * ID of the opposite Node of the first active edge (i.e. not just distance) in
-	 * the column as next_edge.
+	 * An edge in the link graph. Corresponds to a link between two stations.
+	 * The edges of a node are stored in a vector sorted by destination, so only
+	 * the links that actually exist take up memory.
 	 */
 	struct BaseEdge {
 		uint capacity;                 ///< Capacity of the link.
@@ -65,10 +63,17 @@ public:
 		uint64 travel_time_sum;        ///< Sum of the travel times of the link, in ticks.
 		Date last_unrestricted_update; ///< When the unrestricted part of the link was last updated.
 		Date last_restricted_update;   ///< When the restricted part of the link was last updated.
-		NodeID next_edge;              ///< Destination of next valid edge starting at the same source node.
+		NodeID dest_node;              ///< Destination of the link.
+		NodeID next_edge;              ///< Only valid during save/load, to encode the edge chains of the savegame format.
 		void Init();
+
+		/** Sort edges by destination; the order of a node's edge vector. */
+		bool operator<(const BaseEdge &other) const { return this->dest_node < other.dest_node; }
 	};
 
+	typedef std::vector<BaseNode> NodeVector;
+	typedef std::vector<BaseEdge> EdgeVector;
+
 	/**
 	 * Wrapper for an edge (const or not) allowing retrieval, but no modification.
 	 * @tparam Tedge Actual edge class, may be "const BaseEdge" or just "BaseEdge".
@@ -125,15 +130,15 @@ public:
 
 	/**
 	 * Wrapper for a node (const or not) allowing retrieval, but no modification.
-	 * @tparam Tedge Actual node class, may be "const BaseNode" or just "BaseNode".
-	 * @tparam Tedge Actual edge class, may be "const BaseEdge" or just "BaseEdge".
+	 * @tparam Tnode Actual node class, may be "const BaseNode" or just "BaseNode".
+	 * @tparam Tedges Actual edge vector class, may be "const EdgeVector" or just "EdgeVector".
 	 */
-	template<typename Tnode, typename Tedge>
+	template<typename Tnode, typename Tedges>
 	class NodeWrapper {
 	protected:
-		Tnode &node;  ///< Node being wrapped.
-		Tedge *edges; ///< Outgoing edges for wrapped node.
-		NodeID index; ///< ID of wrapped node.
+		Tnode &node;   ///< Node being wrapped.
+		Tedges &edges; ///< Outgoing edges of the wrapped node, sorted by destination.
+		NodeID index;  ///< ID of wrapped node.
 
 	public:
 
@@ -143,7 +148,7 @@ public:
 		 * @param edges Outgoing edges for node to be wrapped.
 		 * @param index ID of node to be wrapped.
 		 */
-		NodeWrapper(Tnode &node, Tedge *edges, NodeID index) : node(node),
+		NodeWrapper(Tnode &node, Tedges &edges, NodeID index) : node(node),
 			edges(edges), index(index) {}
 
 		/**
@@ -178,17 +183,15 @@ public:
 	};
 
 	/**
-	 * Base class for iterating across outgoing edges of a node. Only the real
-	 * edges (those with capacity) are iterated. The ones with only distance
-	 * information are skipped.
+	 * Base class for iterating across outgoing edges of a node, in order of
+	 * destination node.
 	 * @tparam Tedge Actual edge class. May be "BaseEdge" or "const BaseEdge".
 	 * @tparam Titer Actual iterator class.
 	 */
 	template <class Tedge, class Tedge_wrapper, class Titer>
 	class BaseEdgeIterator {
 	protected:
-		Tedge *base;    ///< Array of edges being iterated.
-		NodeID current; ///< Current offset in edges array.
+		Tedge *pos; ///< Current position in the node's edge vector.
 
 		/**
 		 * A "fake" pointer to enable operator-> on temporaries. As the objects
@@ -215,13 +218,9 @@ public:
 	public:
 		/**
 		 * Constructor.
-		 * @param base Array of edges to be iterated.
-		 * @param current ID of current node (to locate the first edge).
+		 * @param pos Position in the node's edge vector to start iterating at.
 		 */
-		BaseEdgeIterator (Tedge *base, NodeID current) :
-			base(base),
-			current(current == INVALID_NODE ? current : base[current].next_edge)
-		{}
+		BaseEdgeIterator (Tedge *pos) : pos(pos) {}
 
 		/**
 		 * Prefix-increment.
@@ -229,7 +228,7 @@ public:
 		 */
 		Titer &operator++()
 		{
-			this->current = this->base[this->current].next_edge;
+			++this->pos;
 			return static_cast<Titer &>(*this);
 		}
 
@@ -240,7 +239,7 @@ public:
 		Titer operator++(int)
 		{
 			Titer ret(static_cast<Titer &>(*this));
-			this->current = this->base[this->current].next_edge;
+			++this->pos;
 			return ret;
 		}
 
@@ -249,12 +248,12 @@ public:
 		 * child class.
 		 * @tparam Tother Class of other iterator.
 		 * @param other Instance of other iterator.
-		 * @return If the iterators have the same edge array and current node.
+		 * @return If the iterators are at the same position.
 		 */
 		template<class Tother>
 		bool operator==(const Tother &other)
 		{
-			return this->base == other.base && this->current == other.current;
+			return this->pos == other.pos;
 		}
 
 		/**
@@ -262,12 +261,12 @@ public:
 		 * may be of a child class.
 		 * @tparam Tother Class of other iterator.
 		 * @param other Instance of other iterator.
-		 * @return If either the edge arrays or the current nodes differ.
+		 * @return If the iterators are at different positions.
 		 */
 		template<class Tother>
 		bool operator!=(const Tother &other)
 		{
-			return this->base != other.base || this->current != other.current;
+			return this->pos != other.pos;
 		}
 
 		/**
@@ -276,7 +275,7 @@ public:
 		 */
 		std::pair<NodeID, Tedge_wrapper> operator*() const
 		{
-			return std::pair<NodeID, Tedge_wrapper>(this->current, Tedge_wrapper(this->base[this->current]));
+			return std::pair<NodeID, Tedge_wrapper>(this->pos->dest_node, Tedge_wrapper(*this->pos));
 		}
 
 		/**
@@ -316,11 +315,10 @@ public:
 	public:
 		/**
 		 * Constructor.
-		 * @param edges Array of edges to be iterated over.
-		 * @param current ID of current edge's end node.
+		 * @param pos Position in the node's edge vector to start iterating at.
 		 */
-		ConstEdgeIterator(const BaseEdge *edges, NodeID current) :
-			BaseEdgeIterator<const BaseEdge, ConstEdge, ConstEdgeIterator>(edges, current) {}
+		ConstEdgeIterator(const BaseEdge *pos) :
+			BaseEdgeIterator<const BaseEdge, ConstEdge, ConstEdgeIterator>(pos) {}
 	};
 
 	/**
@@ -331,18 +329,17 @@ public:
 	public:
 		/**
 		 * Constructor.
-		 * @param edges Array of edges to be iterated over.
-		 * @param current ID of current edge's end node.
+		 * @param pos Position in the node's edge vector to start iterating at.
 		 */
-		EdgeIterator(BaseEdge *edges, NodeID current) :
-			BaseEdgeIterator<BaseEdge, Edge, EdgeIterator>(edges, current) {}
+		EdgeIterator(BaseEdge *pos) :
+			BaseEdgeIterator<BaseEdge, Edge, EdgeIterator>(pos) {}
 	};
 
 	/**
 	 * Constant node class. Only retrieval operations are allowed on both the
 	 * node itself and its edges.
 	 */
-	class ConstNode : public NodeWrapper<const BaseNode, const BaseEdge> {
+	class ConstNode : public NodeWrapper<const BaseNode, const EdgeVector> {
 	public:
 		/**
 		 * Constructor.
@@ -350,34 +347,41 @@ public:
 		 * @param node ID of the node.
 		 */
 		ConstNode(const LinkGraph *lg, NodeID node) :
-			NodeWrapper<const BaseNode, const BaseEdge>(lg->nodes[node], lg->edges[node], node)
+			NodeWrapper<const BaseNode, const EdgeVector>(lg->nodes[node], lg->edges[node], node)
 		{}
 
 		/**
 		 * Get a ConstEdge. This is not a reference as the wrapper objects are
-		 * not actually persistent.
+		 * not actually persistent. If there is no edge to the given node an
+		 * empty edge (no capacity, never updated) is returned.
 		 * @param to ID of end node of edge.
 		 * @return Constant edge wrapper.
 		 */
-		ConstEdge operator[](NodeID to) const { return ConstEdge(this->edges[to]); }
+		ConstEdge operator[](NodeID to) const
+		{
+			const BaseEdge *edge = LinkGraph::FindEdge(this->edges, to);
+			return ConstEdge(edge != nullptr ? *edge : LinkGraph::empty_edge);
+		}
 
 		/**
-		 * Get an iterator pointing to the start of the edges array.
+		 * Get an iterator pointing to the start of the edges vector.
 		 * @return Constant edge iterator.
 		 */
-		ConstEdgeIterator Begin() const { return ConstEdgeIterator(this->edges, this->index); }
+		ConstEdgeIterator Begin() const { return ConstEdgeIterator(this->edges.data()); }
 
 		/**
-		 * Get an iterator pointing beyond the end of the edges array.
+		 * Get an iterator pointing beyond the end of the edges vector.
 		 * @return Constant edge iterator.
 		 */
-		ConstEdgeIterator End() const { return ConstEdgeIterator(this->edges, INVALID_NODE); }
+		ConstEdgeIterator End() const { return ConstEdgeIterator(this->edges.data() + this->edges.size()); }
 	};
 
 	/**
 	 * Updatable node class. The node itself as well as its edges can be modified.
 	 */
-	class Node : public NodeWrapper<BaseNode, BaseEdge> {
+	class Node : public NodeWrapper<BaseNode, EdgeVector> {
+	protected:
+		LinkGraph *graph; ///< Link graph the node belongs to, for change tracking.
 	public:
 		/**
 		 * Constructor.
@@ -385,28 +389,33 @@ public:
 		 * @param node ID of the node.
 		 */
 		Node(LinkGraph *lg, NodeID node) :
-			NodeWrapper<BaseNode, BaseEdge>(lg->nodes[node], lg->edges[node], node)
+			NodeWrapper<BaseNode, EdgeVector>(lg->nodes[node], lg->edges[node], node), graph(lg)
 		{}
 
 		/**
 		 * Get an Edge. This is not a reference as the wrapper objects are not
-		 * actually persistent.
+		 * actually persistent. The edge has to exist.
 		 * @param to ID of end node of edge.
 		 * @return Edge wrapper.
 		 */
-		Edge operator[](NodeID to) { return Edge(this->edges[to]); }
+		Edge operator[](NodeID to)
+		{
+			BaseEdge *edge = LinkGraph::FindEdge(this->edges, to);
+			assert(edge != nullptr);
+			return Edge(*edge);
+		}
 
 		/**
-		 * Get an iterator pointing to the start of the edges array.
+		 * Get an iterator pointing to the start of the edges vector.
 		 * @return Edge iterator.
 		 */
-		EdgeIterator Begin() { return EdgeIterator(this->edges, this->index); }
+		EdgeIterator Begin() { return EdgeIterator(this->edges.data()); }
 
 		/**
-		 * Get an iterator pointing beyond the end of the edges array.
-		 * @return Constant edge iterator.
+		 * Get an iterator pointing beyond the end of the edges vector.
+		 * @return Edge iterator.
 		 */
-		EdgeIterator End() { return EdgeIterator(this->edges, INVALID_NODE); }
+		EdgeIterator End() { return EdgeIterator(this->edges.data() + this->edges.size()); }
 
 		/**
 		 * Update the node's supply and set last_update to the current date.
@@ -416,6 +425,7 @@ public:
 		{
 			this->node.supply += supply;
 			this->node.last_update = _date;
+			this->graph->MarkChanged();
 		}
 
 		/**
@@ -425,6 +435,7 @@ public:
 		void UpdateLocation(TileIndex xy)
 		{
 			this->node.xy = xy;
+			this->graph->MarkChanged();
 		}
 
 		/**
@@ -434,6 +445,7 @@ public:
 		void SetDemand(uint demand)
 		{
 			this->node.demand = demand;
+			this->graph->MarkChanged();
 		}
 
 		void AddEdge(NodeID to, uint capacity, uint usage, uint32 time, EdgeUpdateMode mode);
@@ -441,9 +453,6 @@ public:
 		void RemoveEdge(NodeID to);
 	};
 
-	typedef std::vector<BaseNode> NodeVector;
-	typedef SmallMatrix<BaseEdge> EdgeMatrix;
-
 	/** Minimum effective distance for timeout calculation. */
 	static const uint MIN_TIMEOUT_DISTANCE = 32;
 
@@ -466,13 +475,31 @@ public:
 		return val > 0 ? std::max(1U, val * target_age / orig_age) : 0;
 	}
 
+	/**
+	 * Find the edge to the given destination in a node's sorted edge vector.
+	 * @tparam Tedges Edge vector class, may be "const EdgeVector" or just "EdgeVector".
+	 * @param edges Edge vector to be searched.
+	 * @param dest ID of the destination node.
+	 * @return Pointer to the edge, or nullptr if the node has no edge to dest.
+	 */
+	template <typename Tedges>
+	inline static auto FindEdge(Tedges &edges, NodeID dest) -> decltype(edges.data())
+	{
+		auto it = std::lower_bound(edges.begin(), edges.end(), dest,
+				[](const BaseEdge &edge, NodeID dest) { return edge.dest_node < dest; });
+		return it != edges.end() && it->dest_node == dest ? &*it : nullptr;
+	}
+
+	/** Edge to return when querying a connection that doesn't exist. */
+	static const BaseEdge empty_edge;
+
 	/** Bare constructor, only for save/load. */
-	LinkGraph() : cargo(INVALID_CARGO), last_compression(0) {}
+	LinkGraph() : cargo(INVALID_CARGO), last_compression(0), last_change(0), last_job_spawn(0) {}
 	/**
 	 * Real constructor.
 	 * @param cargo Cargo the link graph is about.
 	 */
-	LinkGraph(CargoID cargo) : cargo(cargo), last_compression(_date) {}
+	LinkGraph(CargoID cargo) : cargo(cargo), last_compression(_date), last_change(_date), last_job_spawn(0) {}
 
 	void Init(uint size);
 	void ShiftDates(int interval);
@@ -519,6 +546,25 @@ public:
 	 */
 	inline CargoID Cargo() const { return this->cargo; }
 
+	/**
+	 * Remember that the graph's nodes or edges have been modified, so the
+	 * flows of the last solved job may no longer match the graph.
+	 */
+	inline void MarkChanged() { this->last_change = _date; }
+
+	/**
+	 * Remember that a job has been spawned for the current state of the graph.
+	 */
+	inline void MarkJobSpawned() { this->last_job_spawn = _date; }
+
+	/**
+	 * Check if the graph has been modified since the last job was spawned for
+	 * it. If it hasn't, a new job would calculate exactly the same flows as
+	 * the last one, so it can be skipped.
+	 * @return If a new job needs to be spawned for this graph.
+	 */
+	inline bool NeedsCalculation() const { return this->last_change >= this->last_job_spawn; }
+
 	/**
 	 * Scale a value to its monthly equivalent, based on last compression.
 	 * @param base Value to be scaled.
@@ -542,8 +588,10 @@ protected:
 
 	CargoID cargo;         ///< Cargo of this component's link graph.
 	Date last_compression; ///< Last time the capacities and supplies were compressed.
-	NodeVector nodes;      ///< Nodes in the component.
-	EdgeMatrix edges;      ///< Edges in the component.
+	Date last_change;      ///< Last time the nodes or edges were modified.
+	Date last_job_spawn;   ///< Last time a job was spawned for this graph.
+	NodeVector nodes;                ///< Nodes in the component.
+	std::vector<EdgeVector> edges;   ///< Outgoing edges of each node, sorted by destination.
 };
 
 #endif /* LINKGRAPH_H */
@@ -51,19 +51,9 @@ const uint8 LinkGraphOverlay::LINK_COLOURS[][12] = {
 };
 
 /**
- * Get a DPI for the widget we will be drawing to.
- * @param dpi DrawPixelInfo to fill with the desired dimensions.
- */
-void LinkGraphOverlay::GetWidgetDpi(DrawPixelInfo *dpi) const
-{
-	const NWidgetBase *wi = this->window->GetWidget<NWidgetBase>(this->widget_id);
-	dpi->left = dpi->top = 0;
-	dpi->width = wi->current_x;
-	dpi->height = wi->current_y;
-}
-
-/**
- * Rebuild the cache and recalculate which links and stations to be shown.
+ * Rebuild the cache of links and stations to be shown. The cache does not
+ * depend on the visible area; the draw functions clip against the area they
+ * are given, so scrolling does not require a rebuild.
  */
 void LinkGraphOverlay::RebuildCache()
 {
@@ -71,14 +61,9 @@ void LinkGraphOverlay::RebuildCache()
 	this->cached_stations.clear();
 	if (this->company_mask == 0) return;
 
-	DrawPixelInfo dpi;
-	this->GetWidgetDpi(&dpi);
-
 	for (const Station *sta : Station::Iterate()) {
 		if (sta->rect.IsEmpty()) continue;
 
-		Point pta = this->GetStationMiddle(sta);
-
 		StationID from = sta->index;
 		StationLinkMap &seen_links = this->cached_links[from];
 
@@ -103,15 +88,11 @@ void LinkGraphOverlay::RebuildCache()
 				if (stb->owner != OWNER_NONE && sta->owner != OWNER_NONE && !HasBit(this->company_mask, stb->owner)) continue;
 				if (stb->rect.IsEmpty()) continue;
 
-				if (!this->IsLinkVisible(pta, this->GetStationMiddle(stb), &dpi)) continue;
-
 				this->AddLinks(sta, stb);
 				seen_links[to]; // make sure it is created and marked as seen
 			}
 		}
-		if (this->IsPointVisible(pta, &dpi)) {
-			this->cached_stations.push_back(std::make_pair(from, supply));
-		}
+		this->cached_stations.push_back(std::make_pair(from, supply));
 	}
 }
 
@@ -55,12 +55,15 @@ void LinkGraphJob::EraseFlows(NodeID from)
 }
 
 /**
- * Spawn a thread if possible and run the link graph job in the thread. If
- * that's not possible run the job right now in the current thread.
+ * Submit the link graph job to the shared worker pool. If no worker thread
+ * is available run the job right now in the current thread. The job has a
+ * deadline (#join_date), so it is submitted with high priority to keep it
+ * ahead of less urgent background work.
  */
 void LinkGraphJob::SpawnThread()
 {
-	if (!StartNewThread(&this->thread, "ottd:linkgraph", &(LinkGraphSchedule::Run), this)) {
+	this->job_handle = SubmitJob([this]() { LinkGraphSchedule::Run(this); }, "ottd:linkgraph", JOB_PRIORITY_HIGH);
+	if (!this->job_handle.IsValid()) {
 		/* Of course this will hang a bit.
 		 * On the other hand, if you want to play games which make this hang noticeably
 		 * on a platform without threads then you'll probably get other problems first.
@@ -73,13 +76,11 @@ void LinkGraphJob::SpawnThread()
 }
 
 /**
- * Join the calling thread with this job's thread if threading is enabled.
+ * Join the calling thread with this job if threading is enabled.
  */
 void LinkGraphJob::JoinThread()
 {
-	if (this->thread.joinable()) {
-		this->thread.join();
-	}
+	this->job_handle.Join();
 }
 
 /**
@@ -127,16 +128,18 @@ LinkGraphJob::~LinkGraphJob()
 			if (from[it->first].Flow() == 0) continue;
 			StationID to = (*this)[it->first].Station();
 			Station *st2 = Station::GetIfValid(to);
+			/* Use const nodes below so a removed edge resolves to the empty
+			 * edge instead of being an error. */
 			if (st2 == nullptr || st2->goods[this->Cargo()].link_graph != this->link_graph.index ||
 					st2->goods[this->Cargo()].node != it->first ||
-					(*lg)[node_id][it->first].LastUpdate() == INVALID_DATE) {
+					LinkGraph::ConstNode(lg, node_id)[it->first].LastUpdate() == INVALID_DATE) {
 				/* Edge has been removed. Delete flows. */
 				StationIDStack erased = flows.DeleteFlows(to);
 				/* Delete old flows for source stations which have been deleted
 				 * from the new flows. This avoids flow cycles between old and
 				 * new flows. */
 				while (!erased.IsEmpty()) ge.flows.erase(erased.Pop());
-			} else if ((*lg)[node_id][it->first].LastUnrestrictedUpdate() == INVALID_DATE) {
+			} else if (LinkGraph::ConstNode(lg, node_id)[it->first].LastUnrestrictedUpdate() == INVALID_DATE) {
 				/* Edge is fully restricted. */
 				flows.RestrictFlows(to);
 			}
@@ -10,7 +10,8 @@
 #ifndef LINKGRAPHJOB_H
 #define LINKGRAPHJOB_H
 
-#include "../thread.h"
+#include "../jobpool.h"
+#include "../core/smallmatrix_type.hpp"
 #include "linkgraph.h"
 #include <list>
 #include <atomic>
@@ -58,7 +59,7 @@ private:
 protected:
 	const LinkGraph link_graph;       ///< Link graph to by analyzed. Is copied when job is started and mustn't be modified later.
 	const LinkGraphSettings settings; ///< Copy of _settings_game.linkgraph at spawn time.
-	std::thread thread;               ///< Thread the job is running in or a default-constructed thread if it's running in the main thread.
+	JobHandle job_handle;             ///< Handle of the pool job, or an invalid handle if the job ran in the main thread.
 	Date join_date;                   ///< Date when the job is to be joined.
 	NodeAnnotationVector nodes;       ///< Extra node data necessary for link graph calculation.
 	EdgeAnnotationMatrix edges;       ///< Extra edge data necessary for link graph calculation.
@@ -146,16 +147,15 @@ public:
 	 * Iterator for job edges.
 	 */
 	class EdgeIterator : public LinkGraph::BaseEdgeIterator<const LinkGraph::BaseEdge, Edge, EdgeIterator> {
-		EdgeAnnotation *base_anno; ///< Array of annotations to be (indirectly) iterated.
+		EdgeAnnotation *base_anno; ///< Annotations of the iterated node, indexed by destination.
 	public:
 		/**
 		 * Constructor.
-		 * @param base Array of edges to be iterated.
-		 * @param base_anno Array of annotations to be iterated.
-		 * @param current Start offset of iteration.
+		 * @param pos Position in the node's edge vector to start iterating at.
+		 * @param base_anno Annotations of the iterated node, indexed by destination.
 		 */
-		EdgeIterator(const LinkGraph::BaseEdge *base, EdgeAnnotation *base_anno, NodeID current) :
-				LinkGraph::BaseEdgeIterator<const LinkGraph::BaseEdge, Edge, EdgeIterator>(base, current),
+		EdgeIterator(const LinkGraph::BaseEdge *pos, EdgeAnnotation *base_anno) :
+				LinkGraph::BaseEdgeIterator<const LinkGraph::BaseEdge, Edge, EdgeIterator>(pos),
 				base_anno(base_anno) {}
 
 		/**
@@ -165,7 +165,7 @@ public:
 		 */
 		std::pair<NodeID, Edge> operator*() const
 		{
-			return std::pair<NodeID, Edge>(this->current, Edge(this->base[this->current], this->base_anno[this->current]));
+			return std::pair<NodeID, Edge>(this->pos->dest_node, Edge(*this->pos, this->base_anno[this->pos->dest_node]));
 		}
 
 		/**
@@ -200,25 +200,29 @@ public:
 
 		/**
 		 * Retrieve an edge starting at this node. Mind that this returns an
-		 * object, not a reference.
+		 * object, not a reference. If the link graph has no edge to the given
+		 * node the annotation is wrapped together with an empty edge; demand
+		 * can exist between nodes without a link between them.
 		 * @param to Remote end of the edge.
 		 * @return Edge between this node and "to".
 		 */
-		Edge operator[](NodeID to) const { return Edge(this->edges[to], this->edge_annos[to]); }
+		Edge operator[](NodeID to) const
+		{
+			const LinkGraph::BaseEdge *edge = LinkGraph::FindEdge(this->edges, to);
+			return Edge(edge != nullptr ? *edge : LinkGraph::empty_edge, this->edge_annos[to]);
+		}
 
 		/**
-		 * Iterator for the "begin" of the edge array. Only edges with capacity
-		 * are iterated. The others are skipped.
+		 * Iterator for the "begin" of the edge vector.
 		 * @return Iterator pointing to the first edge.
 		 */
-		EdgeIterator Begin() const { return EdgeIterator(this->edges, this->edge_annos, index); }
+		EdgeIterator Begin() const { return EdgeIterator(this->edges.data(), this->edge_annos); }
 
 		/**
-		 * Iterator for the "end" of the edge array. Only edges with capacity
-		 * are iterated. The others are skipped.
+		 * Iterator for the "end" of the edge vector.
 		 * @return Iterator pointing beyond the last edge.
 		 */
-		EdgeIterator End() const { return EdgeIterator(this->edges, this->edge_annos, INVALID_NODE); }
+		EdgeIterator End() const { return EdgeIterator(this->edges.data() + this->edges.size(), this->edge_annos); }
 
 		/**
 		 * Get amount of supply that hasn't been delivered, yet.
@@ -9,6 +9,7 @@
 
 #include "../stdafx.h"
 #include "linkgraphschedule.h"
+#include "refresh.h"
 #include "init.h"
 #include "demands.h"
 #include "mcf.h"
@@ -35,7 +36,10 @@ void LinkGraphSchedule::SpawnNext()
 	if (this->schedule.empty()) return;
 	LinkGraph *next = this->schedule.front();
 	LinkGraph *first = next;
-	while (next->Size() < 2) {
+	/* Skip graphs that are too small to route anything as well as graphs that
+	 * haven't changed since their last job; re-solving those would only
+	 * reproduce the flows the last job already calculated. */
+	while (next->Size() < 2 || !next->NeedsCalculation()) {
 		this->schedule.splice(this->schedule.end(), this->schedule, this->schedule.begin());
 		next = this->schedule.front();
 		if (next == first) return;
@@ -44,6 +48,7 @@ void LinkGraphSchedule::SpawnNext()
 	this->schedule.pop_front();
 	if (LinkGraphJob::CanAllocateItem()) {
 		LinkGraphJob *job = new LinkGraphJob(*next);
+		next->MarkJobSpawned();
 		job->SpawnThread();
 		this->running.push_back(job);
 	} else {
@@ -125,6 +130,8 @@ void LinkGraphSchedule::SpawnAll()
 	}
 	instance.running.clear();
 	instance.schedule.clear();
+	/* The game is being cleared; drop refreshes memoized for its order lists. */
+	InvalidateLinkRefreshMemo();
 }
 
 /**
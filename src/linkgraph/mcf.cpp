@@ -2,13 +2,24 @@
 
 #include "../stdafx.h"
 #include "../core/math_func.hpp"
+#include "../thread.h"
 #include "mcf.h"
+#include <atomic>
 #include <set>
 
 #include "../safeguards.h"
 
 typedef std::map<NodeID, Path *> PathViaMap;
 
+/**
+ * Number of source nodes whose path trees are calculated concurrently per
+ * batch. The trees of a batch are all calculated against the flow state at
+ * the start of the batch and applied in source order afterwards, so the
+ * result is independent of the number of threads actually available. Keep
+ * this constant; changing it changes the solver's output.
+ */
+static const uint MCF_SOURCE_BATCH_SIZE = 16;
+
 /**
  * Distance-based annotation for use in the Dijkstra algorithm. This is close
  * to the original meaning of "annotation" in this context. Paths are rated
@@ -88,8 +99,8 @@ public:
 };
 
 /**
- * Iterator class for getting the edges in the order of their next_edge
- * members.
+ * Iterator class for getting the real edges of a node in the order of their
+ * destinations.
  */
 class GraphEdgeIterator {
 private:
@@ -104,7 +115,7 @@ public:
 	 * @param job Job to iterate on.
 	 */
 	GraphEdgeIterator(LinkGraphJob &job) : job(job),
-		i(nullptr, nullptr, INVALID_NODE), end(nullptr, nullptr, INVALID_NODE)
+		i(nullptr, nullptr), end(nullptr, nullptr)
 	{}
 
 	/**
@@ -306,6 +317,43 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 	}
 }
 
+/**
+ * Calculate the path trees for a batch of source nodes, distributing the
+ * Dijkstra invocations over a pool of worker threads. All trees are built
+ * against the flow state as it is when this method is called; the caller is
+ * expected to apply the flow pushes sequentially afterwards. The workers pull
+ * sources from a shared counter, so an idle worker automatically takes over
+ * remaining work. If no threads can be started the batch is calculated in the
+ * calling thread, with identical results.
+ * @tparam Tannotation Annotation to be used.
+ * @tparam Tedge_iterator Iterator to be used for getting outgoing edges.
+ * @param sources Nodes to calculate path trees for.
+ * @param trees Container for the resulting trees, one per source.
+ */
+template<class Tannotation, class Tedge_iterator>
+void MultiCommodityFlow::DijkstraBatch(const std::vector<NodeID> &sources, std::vector<PathVector> &trees)
+{
+	trees.resize(sources.size());
+	std::atomic<size_t> next_source(0);
+
+	auto worker = [&]() {
+		for (;;) {
+			size_t index = next_source.fetch_add(1, std::memory_order_relaxed);
+			if (index >= sources.size()) return;
+			this->Dijkstra<Tannotation, Tedge_iterator>(sources[index], trees[index]);
+		}
+	};
+
+	uint max_threads = std::min<uint>(static_cast<uint>(sources.size()), std::thread::hardware_concurrency());
+	std::vector<std::thread> threads;
+	for (uint i = 1; i < max_threads; ++i) {
+		std::thread thread;
+		if (StartNewThread(&thread, "ottd:mcf", decltype(worker)(worker))) threads.push_back(std::move(thread));
+	}
+	worker();
+	for (std::thread &thread : threads) thread.join();
+}
+
 /**
  * Clean up paths that lead nowhere and the root path.
  * @param source_id ID of the root node.
@@ -499,43 +547,53 @@ bool MCF1stPass::EliminateCycles()
  */
 MCF1stPass::MCF1stPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 {
-	PathVector paths;
 	uint16 size = job.Size();
 	uint accuracy = job.Settings().accuracy;
 	bool more_loops;
 	std::vector<bool> finished_sources(size);
+	std::vector<NodeID> batch;
+	std::vector<PathVector> trees;
 
 	do {
 		more_loops = false;
+		std::vector<NodeID> pending;
 		for (NodeID source = 0; source < size; ++source) {
-			if (finished_sources[source]) continue;
-
-			/* First saturate the shortest paths. */
-			this->Dijkstra<DistanceAnnotation, GraphEdgeIterator>(source, paths);
-
-			bool source_demand_left = false;
-			for (NodeID dest = 0; dest < size; ++dest) {
-				Edge edge = job[source][dest];
-				if (edge.UnsatisfiedDemand() > 0) {
-					Path *path = paths[dest];
-					assert(path != nullptr);
-					/* Generally only allow paths that don't exceed the
-					 * available capacity. But if no demand has been assigned
-					 * yet, make an exception and allow any valid path *once*. */
-					if (path->GetFreeCapacity() > 0 && this->PushFlow(edge, path,
-							accuracy, this->max_saturation) > 0) {
-						/* If a path has been found there is a chance we can
-						 * find more. */
-						more_loops = more_loops || (edge.UnsatisfiedDemand() > 0);
-					} else if (edge.UnsatisfiedDemand() == edge.Demand() &&
-							path->GetFreeCapacity() > INT_MIN) {
-						this->PushFlow(edge, path, accuracy, UINT_MAX);
+			if (!finished_sources[source]) pending.push_back(source);
+		}
+		for (size_t first = 0; first < pending.size(); first += MCF_SOURCE_BATCH_SIZE) {
+			/* Calculate the shortest path trees for a whole batch of sources
+			 * in parallel, then push flow along them in source order. */
+			batch.assign(pending.begin() + first, pending.begin() + std::min(first + MCF_SOURCE_BATCH_SIZE, pending.size()));
+			this->DijkstraBatch<DistanceAnnotation, GraphEdgeIterator>(batch, trees);
+
+			for (size_t index = 0; index < batch.size(); ++index) {
+				NodeID source = batch[index];
+				PathVector &paths = trees[index];
+
+				bool source_demand_left = false;
+				for (NodeID dest = 0; dest < size; ++dest) {
+					Edge edge = job[source][dest];
+					if (edge.UnsatisfiedDemand() > 0) {
+						Path *path = paths[dest];
+						assert(path != nullptr);
+						/* Generally only allow paths that don't exceed the
+						 * available capacity. But if no demand has been assigned
+						 * yet, make an exception and allow any valid path *once*. */
+						if (path->GetFreeCapacity() > 0 && this->PushFlow(edge, path,
+								accuracy, this->max_saturation) > 0) {
+							/* If a path has been found there is a chance we can
+							 * find more. */
+							more_loops = more_loops || (edge.UnsatisfiedDemand() > 0);
+						} else if (edge.UnsatisfiedDemand() == edge.Demand() &&
+								path->GetFreeCapacity() > INT_MIN) {
+							this->PushFlow(edge, path, accuracy, UINT_MAX);
+						}
+						if (edge.UnsatisfiedDemand() > 0) source_demand_left = true;
 					}
-					if (edge.UnsatisfiedDemand() > 0) source_demand_left = true;
 				}
+				finished_sources[source] = !source_demand_left;
+				this->CleanupPaths(source, paths);
 			}
-			finished_sources[source] = !source_demand_left;
-			this->CleanupPaths(source, paths);
 		}
 	} while ((more_loops || this->EliminateCycles()) && !job.IsJobAborted());
 }
@@ -548,32 +606,41 @@ MCF1stPass::MCF1stPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 MCF2ndPass::MCF2ndPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 {
 	this->max_saturation = UINT_MAX; // disable artificial cap on saturation
-	PathVector paths;
 	uint16 size = job.Size();
 	uint accuracy = job.Settings().accuracy;
 	bool demand_left = true;
 	std::vector<bool> finished_sources(size);
+	std::vector<NodeID> batch;
+	std::vector<PathVector> trees;
 	while (demand_left && !job.IsJobAborted()) {
 		demand_left = false;
+		std::vector<NodeID> pending;
 		for (NodeID source = 0; source < size; ++source) {
-			if (finished_sources[source]) continue;
+			if (!finished_sources[source]) pending.push_back(source);
+		}
+		for (size_t first = 0; first < pending.size(); first += MCF_SOURCE_BATCH_SIZE) {
+			batch.assign(pending.begin() + first, pending.begin() + std::min(first + MCF_SOURCE_BATCH_SIZE, pending.size()));
+			this->DijkstraBatch<CapacityAnnotation, FlowEdgeIterator>(batch, trees);
 
-			this->Dijkstra<CapacityAnnotation, FlowEdgeIterator>(source, paths);
+			for (size_t index = 0; index < batch.size(); ++index) {
+				NodeID source = batch[index];
+				PathVector &paths = trees[index];
 
-			bool source_demand_left = false;
-			for (NodeID dest = 0; dest < size; ++dest) {
-				Edge edge = this->job[source][dest];
-				Path *path = paths[dest];
-				if (edge.UnsatisfiedDemand() > 0 && path->GetFreeCapacity() > INT_MIN) {
-					this->PushFlow(edge, path, accuracy, UINT_MAX);
-					if (edge.UnsatisfiedDemand() > 0) {
-						demand_left = true;
-						source_demand_left = true;
+				bool source_demand_left = false;
+				for (NodeID dest = 0; dest < size; ++dest) {
+					Edge edge = this->job[source][dest];
+					Path *path = paths[dest];
+					if (edge.UnsatisfiedDemand() > 0 && path->GetFreeCapacity() > INT_MIN) {
+						this->PushFlow(edge, path, accuracy, UINT_MAX);
+						if (edge.UnsatisfiedDemand() > 0) {
+							demand_left = true;
+							source_demand_left = true;
+						}
 					}
 				}
+				finished_sources[source] = !source_demand_left;
+				this->CleanupPaths(source, paths);
 			}
-			finished_sources[source] = !source_demand_left;
-			this->CleanupPaths(source, paths);
 		}
 	}
 }
@@ -24,6 +24,9 @@ protected:
 	template<class Tannotation, class Tedge_iterator>
 	void Dijkstra(NodeID from, PathVector &paths);
 
+	template<class Tannotation, class Tedge_iterator>
+	void DijkstraBatch(const std::vector<NodeID> &sources, std::vector<PathVector> &trees);
+
 	uint PushFlow(Edge &edge, Path *path, uint accuracy, uint max_saturation);
 
 	void CleanupPaths(NodeID source, PathVector &paths);
@@ -12,11 +12,39 @@
 #include "../station_func.h"
 #include "../engine_base.h"
 #include "../vehicle_func.h"
+#include "../date_func.h"
 #include "refresh.h"
 #include "linkgraph.h"
 
+#include <unordered_map>
+
 #include "../safeguards.h"
 
+/**
+ * Memo of the link refreshes already performed on the current date for one
+ * order list. A signature captures everything the outcome of a run depends
+ * on; a run whose signature was already refreshed today would only repeat
+ * the exact same idempotent EUM_REFRESH edge updates and can be skipped.
+ */
+struct LinkRefreshMemo {
+	Date date = INVALID_DATE;                    ///< Date the stored refreshes were performed.
+	std::vector<std::vector<uint32>> signatures; ///< Signatures of the refreshes performed on that date.
+};
+
+/** Memoized link refreshes, indexed by order list index. */
+static std::unordered_map<uint32, LinkRefreshMemo> _link_refresh_memo;
+
+/**
+ * Forget all memoized link refreshes. To be called whenever a repeated
+ * refresh would no longer be a no-op: when orders are edited or deleted, and
+ * when link graph edges change other than through refreshing (compression,
+ * date shifts, game end).
+ */
+void InvalidateLinkRefreshMemo()
+{
+	_link_refresh_memo.clear();
+}
+
 /**
  * Refresh all links the given vehicle will visit.
  * @param v Vehicle to refresh links for.
@@ -32,10 +60,38 @@
 	const Order *first = v->orders->GetNextDecisionNode(v->GetOrder(v->cur_implicit_order_index), 0);
 	if (first == nullptr) return;
 
+	uint8 flags = v->last_loading_station != INVALID_STATION ? 1 << HAS_CARGO : 0;
+
+	/* Skip the order walk if an identical refresh was already performed today,
+	 * e.g. by another vehicle sharing this order list. Such a run would only
+	 * repeat the same EUM_REFRESH updates, which are idempotent within one
+	 * date. Full loading runs add capacity instead of refreshing it and depend
+	 * on per-vehicle loading state, and runs that may not merge link graphs
+	 * depend on the current graph assignment, so neither is ever skipped. */
+	if (!is_full_loading && allow_merge) {
+		std::vector<uint32> signature;
+		signature.push_back(first->index);
+		signature.push_back(flags);
+		signature.push_back(v->GetDisplayMaxSpeed());
+		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+			signature.push_back(u->engine_type);
+			signature.push_back(u->cargo_type | (u->cargo_subtype << 8) | ((uint32)u->cargo_cap << 16));
+			signature.push_back(u->refit_cap);
+		}
+
+		LinkRefreshMemo &memo = _link_refresh_memo[(uint32)v->orders->index];
+		if (memo.date != _date) {
+			memo.date = _date;
+			memo.signatures.clear();
+		}
+		if (std::find(memo.signatures.begin(), memo.signatures.end(), signature) != memo.signatures.end()) return;
+		memo.signatures.push_back(std::move(signature));
+	}
+
 	HopSet seen_hops;
 	LinkRefresher refresher(v, &seen_hops, allow_merge, is_full_loading);
 
-	refresher.RefreshLinks(first, first, v->last_loading_station != INVALID_STATION ? 1 << HAS_CARGO : 0);
+	refresher.RefreshLinks(first, first, flags);
 }
 
 /**
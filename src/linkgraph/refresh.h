@@ -98,4 +98,6 @@ protected:
 	void RefreshLinks(const Order *cur, const Order *next, uint8 flags, uint num_hops = 0);
 };
 
+void InvalidateLinkRefreshMemo();
+
 #endif /* REFRESH_H */
@@ -27,6 +27,8 @@ extern "C" _CRTIMP void __cdecl _assert(void *, void *, unsigned);
 /* static */ uint Map::size;      ///< The number of tiles on the map
 /* static */ uint Map::tile_mask; ///< _map_size - 1 (to mask the mapsize)
 
+TileBase *_mb = nullptr;     ///< Base Tiles of the map
+TileSlopeCache *_ts = nullptr; ///< Cached slope data of the tiles of the map
 Tile *_m = nullptr;          ///< Tiles of the map
 TileExtended *_me = nullptr; ///< Extended Tiles of the map
 
@@ -56,9 +58,14 @@ TileExtended *_me = nullptr; ///< Extended Tiles of the map
 	Map::size = size_x * size_y;
 	Map::tile_mask = Map::size - 1;
 
+	free(_mb);
+	free(_ts);
 	free(_m);
 	free(_me);
 
+	_mb = CallocT<TileBase>(Map::size);
+	/* All heights are zero, so the all-zero slope cache is up to date. */
+	_ts = CallocT<TileSlopeCache>(Map::size);
 	_m = CallocT<Tile>(Map::size);
 	_me = CallocT<TileExtended>(Map::size);
 }
@@ -15,6 +15,22 @@
 #include "map_type.h"
 #include "direction_func.h"
 
+/**
+ * Pointer to the base tile-array.
+ *
+ * This variable points to the base tile-array which contains the type and
+ * height of the tiles of the map.
+ */
+extern TileBase *_mb;
+
+/**
+ * Pointer to the tile slope cache array.
+ *
+ * This variable points to the array with the cached slope and extreme
+ * heights of the tiles of the map, derived from the corner heights in #_mb.
+ */
+extern TileSlopeCache *_ts;
+
 /**
  * Pointer to the tile-array.
  *
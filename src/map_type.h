@@ -11,12 +11,35 @@
 #define MAP_TYPE_H
 
 /**
- * Data that is stored per tile. Also used TileExtended for this.
+ * The most frequently accessed data that is stored per tile. It is kept in
+ * its own dense array so hot loops that only look at the tile type or height
+ * do not drag the other tile members through the cache.
+ * Look at docs/landscape.html for the exact meaning of the members.
+ */
+struct TileBase {
+	byte type;   ///< The type (bits 4..7), bridges (2..3), rainforest/desert (0..1)
+	byte height; ///< The height of the northern corner.
+};
+
+static_assert(sizeof(TileBase) == 2);
+
+/**
+ * Cached slope data of a tile, derived from the corner heights in #TileBase.
+ * It is kept in its own dense array so the hot slope and height accessors
+ * are a single load instead of four corner lookups; SetTileHeight() keeps
+ * it up to date whenever a corner height changes.
+ */
+struct TileSlopeCache {
+	byte slope; ///< Slope of the tile (a #Slope value, without halftile information).
+	byte min_z; ///< Height of the lowest corner of the tile.
+	byte max_z; ///< Height of the highest corner of the tile.
+};
+
+/**
+ * Data that is stored per tile. Also used TileBase and TileExtended for this.
  * Look at docs/landscape.html for the exact meaning of the members.
  */
 struct Tile {
-	byte   type;        ///< The type (bits 4..7), bridges (2..3), rainforest/desert (0..1)
-	byte   height;      ///< The height of the northern corner.
 	uint16 m2;          ///< Primarily used for indices to towns, industries and stations
 	byte   m1;          ///< Primarily used for ownership information
 	byte   m3;          ///< General purpose
@@ -24,7 +47,7 @@ struct Tile {
 	byte   m5;          ///< General purpose
 };
 
-static_assert(sizeof(Tile) == 8);
+static_assert(sizeof(Tile) == 6);
 
 /**
  * Data that is stored per tile. Also used Tile for this.
@@ -30,9 +30,15 @@
 #include "town_kdtree.h"
 #include "viewport_kdtree.h"
 #include "newgrf_profiling.h"
+#include "autoreplace_func.h"
+#include "elrail_func.h"
+#include "tunnelbridge.h"
+#include "state_checksum.h"
 
 #include "safeguards.h"
 
+StateChecksums _state_checksums; ///< Rolling state hashes for desync detection.
+
 
 extern TileIndex _cur_tileloop_tile;
 extern void MakeNewgameSettingsLive();
@@ -66,6 +72,7 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 	_pause_mode = PM_UNPAUSED;
 	_game_speed = 100;
 	_tick_counter = 0;
+	_state_checksums.Reset();
 	_cur_tileloop_tile = 1;
 	_thd.redsq = INVALID_TILE;
 	if (reset_settings) MakeNewgameSettingsLive();
@@ -80,6 +87,12 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 	LinkGraphSchedule::Clear();
 	PoolBase::Clean(PT_NORMAL);
 
+	/* The replacement lists were freed along with the pools. */
+	InvalidateEngineReplacementCache();
+
+	ClearRailCatenaryCache();
+	ClearBridgeMiddleCache();
+
 	RebuildStationKdtree();
 	RebuildTownKdtree();
 	RebuildViewportKdtree();
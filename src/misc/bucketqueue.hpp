@@ -0,0 +1,193 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file bucketqueue.hpp Bucket based priority queue implementation. */
+
+#ifndef BUCKETQUEUE_HPP
+#define BUCKETQUEUE_HPP
+
+#include <deque>
+#include <vector>
+
+/**
+ * Bucket based priority queue as C++ template.
+ *  Drop-in alternative for CBinaryHeapT for items with integer priorities.
+ *  Items are kept in an array of buckets indexed by their priority, which
+ *  makes both Include() and Shift() O(1) amortized instead of O(log n) as
+ *  long as the priorities behave (nearly) monotonically, as they do for the
+ *  open list of an A-star search with a consistent heuristic.
+ *
+ * @par Usage information:
+ * Item of the bucket queue should provide the method 'int GetCostEstimate()'
+ * returning its priority. Items with priorities in the same bucket are
+ * returned in no particular order, like equal items in the binary heap.
+ *
+ * @par
+ * This queue only holds item pointers. The items are allocated elsewhere.
+ *
+ * @tparam T Type of the items stored in the bucket queue.
+ * @tparam Tgranularity_log2 Number of low priority bits ignored for bucket
+ *         selection. Coarser buckets need less memory for searches spanning
+ *         a wide priority range at the price of not distinguishing items
+ *         whose priorities differ in the lowest bits only.
+ */
+template <class T, int Tgranularity_log2 = 0>
+class CBucketQueueT {
+private:
+	std::deque<std::vector<T *>> buckets; ///< Buckets of items, indexed by priority.
+	int base;                             ///< Bucket key of buckets[0].
+	uint first;                           ///< Index of the first possibly non-empty bucket.
+	uint items;                           ///< Number of items in the queue.
+
+	/**
+	 * Get the bucket key for an item.
+	 * @param item The item.
+	 * @return Bucket key of the item.
+	 */
+	static inline int GetBucketKey(const T *item)
+	{
+		return item->GetCostEstimate() >> Tgranularity_log2;
+	}
+
+	/** Move #first forward to the first non-empty bucket. */
+	inline void SkipEmptyBuckets()
+	{
+		while (this->buckets[this->first].empty()) this->first++;
+	}
+
+public:
+	/**
+	 * Create a bucket queue.
+	 * @param max_items Expected number of items, unused. The signature is
+	 *                  shared with CBinaryHeapT so either can be used as the
+	 *                  priority queue of a node list.
+	 */
+	explicit CBucketQueueT([[maybe_unused]] uint max_items) : base(0), first(0), items(0)
+	{
+	}
+
+	/**
+	 * Get the number of items in the queue.
+	 * @return The number of items.
+	 */
+	inline uint Length() const
+	{
+		return this->items;
+	}
+
+	/**
+	 * Test if the queue is empty.
+	 * @return True if empty.
+	 */
+	inline bool IsEmpty() const
+	{
+		return this->items == 0;
+	}
+
+	/**
+	 * Get the item with the smallest priority.
+	 * @return The item with the smallest priority, or throw assert if empty.
+	 */
+	inline T *Begin()
+	{
+		assert(!this->IsEmpty());
+		this->SkipEmptyBuckets();
+		return this->buckets[this->first].back();
+	}
+
+	/**
+	 * Insert a new item into the queue.
+	 * @param new_item The pointer to the new item.
+	 */
+	inline void Include(T *new_item)
+	{
+		int key = GetBucketKey(new_item);
+		if (this->buckets.empty()) {
+			this->base = key;
+			this->buckets.emplace_back();
+		} else if (key < this->base) {
+			/* Grow the front; can happen when the heuristic is not entirely
+			 * consistent or when an open node is re-inserted with lower cost. */
+			this->buckets.insert(this->buckets.begin(), this->base - key, std::vector<T *>());
+			this->base = key;
+			this->first = 0;
+		} else if (key >= this->base + static_cast<int>(this->buckets.size())) {
+			this->buckets.resize(key - this->base + 1);
+		}
+		uint index = key - this->base;
+		this->buckets[index].push_back(new_item);
+		this->first = std::min(this->first, index);
+		this->items++;
+	}
+
+	/**
+	 * Remove and return the item with the smallest priority.
+	 * @return The pointer to the removed item.
+	 */
+	inline T *Shift()
+	{
+		assert(!this->IsEmpty());
+		this->SkipEmptyBuckets();
+		T *item = this->buckets[this->first].back();
+		this->buckets[this->first].pop_back();
+		this->items--;
+		return item;
+	}
+
+	/**
+	 * Remove the item at the given index from the queue.
+	 * @param index The index of the item as returned by FindIndex().
+	 */
+	inline void Remove(uint index)
+	{
+		assert(index != 0 && index <= this->items);
+		for (std::vector<T *> &bucket : this->buckets) {
+			if (index > bucket.size()) {
+				index -= (uint)bucket.size();
+				continue;
+			}
+			/* Order within a bucket doesn't matter, swap with the last item. */
+			bucket[index - 1] = bucket.back();
+			bucket.pop_back();
+			this->items--;
+			return;
+		}
+		NOT_REACHED();
+	}
+
+	/**
+	 * Search for an item in the queue.
+	 *  Matching is done by comparing address of the item.
+	 * @param item The reference to the item.
+	 * @return The index of the item or zero if not found.
+	 */
+	inline uint FindIndex(const T &item) const
+	{
+		uint index = 1;
+		for (const std::vector<T *> &bucket : this->buckets) {
+			for (size_t i = 0; i < bucket.size(); i++) {
+				if (bucket[i] == &item) return index + (uint)i;
+			}
+			index += (uint)bucket.size();
+		}
+		return 0;
+	}
+
+	/**
+	 * Make the queue empty.
+	 * All remaining items will remain untouched.
+	 */
+	inline void Clear()
+	{
+		this->buckets.clear();
+		this->base = 0;
+		this->first = 0;
+		this->items = 0;
+	}
+};
+
+#endif /* BUCKETQUEUE_HPP */
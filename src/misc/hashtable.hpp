@@ -11,6 +11,7 @@
 #define HASHTABLE_HPP
 
 #include "../core/math_func.hpp"
+#include <vector>
 
 template <class Titem_>
 struct CHashTableSlotT
@@ -254,4 +255,175 @@ public:
 	}
 };
 
+/**
+ * class COpenHashTableT<Titem, Thash_bits> - open addressing variant of
+ *  CHashTableT. Instead of chaining the items through intrusive next
+ *  pointers it keeps a flat array of (hash, pointer) pairs that is probed
+ *  linearly, so a lookup walks consecutive cache lines instead of chasing
+ *  pointers all over the node heap.
+ *
+ *  The table starts with 2^Thash_bits slots and grows when it gets more
+ *  than 3/4 full. Removed items leave tombstones behind; those are purged
+ *  whenever the table is rebuilt.
+ *
+ *  The Titem requirements are the same as for CHashTableT, except that
+ *  GetHashNext()/SetHashNext() are not used.
+ */
+template <class Titem_, int Thash_bits_>
+class COpenHashTableT {
+public:
+	typedef Titem_ Titem;                      // make Titem_ visible from outside of class
+	typedef typename Titem_::Key Tkey;         // make Titem_::Key a property of HashTable
+	static const int Thash_bits = Thash_bits_; // publish num of hash bits
+
+protected:
+	/** single slot of the table */
+	struct Entry {
+		uint32  hash; ///< Mixed hash of the item's key.
+		Titem_ *item; ///< The item, \c nullptr for an empty slot or the tombstone marker.
+	};
+
+	std::vector<Entry> m_entries; ///< Flat slot array; its size is always a power of two.
+	int m_num_items;              ///< Number of items in the table.
+	int m_num_used;               ///< Number of non-empty slots (items plus tombstones).
+
+	/** marker for a slot whose item has been removed */
+	inline static Titem_ *Tombstone()
+	{
+		return reinterpret_cast<Titem_ *>((intptr_t)1);
+	}
+
+	/** static helper - mix the hash of the given key into a full width slot hash */
+	inline static uint32 MixHash(const Tkey &key)
+	{
+		uint32 hash = key.CalcHash();
+		hash -= (hash >> 17); // hash * 131071 / 131072
+		hash -= (hash >> 5);  //   * 31 / 32
+		return hash;
+	}
+
+	/** find the slot the item with the given key lives in, or -1 when not present */
+	inline int FindSlot(const Tkey &key) const
+	{
+		if (this->m_num_items == 0) return -1;
+		uint32 hash = MixHash(key);
+		uint mask = (uint)this->m_entries.size() - 1;
+		for (uint i = hash & mask; ; i = (i + 1) & mask) {
+			const Entry &entry = this->m_entries[i];
+			if (entry.item == nullptr) return -1;
+			if (entry.item != Tombstone() && entry.hash == hash && entry.item->GetKey() == key) return i;
+		}
+	}
+
+	/** insert the item into the slot array, which must have a free slot */
+	inline void InsertEntry(uint32 hash, Titem_ *item)
+	{
+		uint mask = (uint)this->m_entries.size() - 1;
+		uint i = hash & mask;
+		while (this->m_entries[i].item != nullptr && this->m_entries[i].item != Tombstone()) i = (i + 1) & mask;
+		if (this->m_entries[i].item == nullptr) this->m_num_used++;
+		this->m_entries[i].hash = hash;
+		this->m_entries[i].item = item;
+	}
+
+	/** rebuild the slot array with the given size, dropping all tombstones */
+	void Rehash(size_t new_size)
+	{
+		std::vector<Entry> old_entries(new_size);
+		old_entries.swap(this->m_entries);
+		this->m_num_used = 0;
+		for (const Entry &entry : old_entries) {
+			if (entry.item == nullptr || entry.item == Tombstone()) continue;
+			this->InsertEntry(entry.hash, entry.item);
+		}
+		this->m_num_used = this->m_num_items;
+	}
+
+public:
+	/* default constructor */
+	inline COpenHashTableT() : m_num_items(0), m_num_used(0)
+	{
+	}
+
+	/** item count */
+	inline int Count() const
+	{
+		return m_num_items;
+	}
+
+	/** simple clear - forget all items */
+	inline void Clear()
+	{
+		for (Entry &entry : this->m_entries) entry.item = nullptr;
+		this->m_num_items = 0;
+		this->m_num_used = 0;
+	}
+
+	/** const item search */
+	const Titem_ *Find(const Tkey &key) const
+	{
+		int slot = this->FindSlot(key);
+		return slot < 0 ? nullptr : this->m_entries[slot].item;
+	}
+
+	/** non-const item search */
+	Titem_ *Find(const Tkey &key)
+	{
+		int slot = this->FindSlot(key);
+		return slot < 0 ? nullptr : this->m_entries[slot].item;
+	}
+
+	/** non-const item search & optional removal (if found) */
+	Titem_ *TryPop(const Tkey &key)
+	{
+		int slot = this->FindSlot(key);
+		if (slot < 0) return nullptr;
+		Titem_ *item = this->m_entries[slot].item;
+		this->m_entries[slot].item = Tombstone();
+		this->m_num_items--;
+		return item;
+	}
+
+	/** non-const item search & removal */
+	Titem_& Pop(const Tkey &key)
+	{
+		Titem_ *item = this->TryPop(key);
+		assert(item != nullptr);
+		return *item;
+	}
+
+	/** non-const item search & optional removal (if found) */
+	bool TryPop(Titem_ &item)
+	{
+		int slot = this->FindSlot(item.GetKey());
+		if (slot < 0 || this->m_entries[slot].item != &item) return false;
+		this->m_entries[slot].item = Tombstone();
+		this->m_num_items--;
+		return true;
+	}
+
+	/** non-const item search & removal */
+	void Pop(Titem_ &item)
+	{
+		[[maybe_unused]] bool ret = this->TryPop(item);
+		assert(ret);
+	}
+
+	/** add one item */
+	void Push(Titem_ &new_item)
+	{
+		if (this->m_entries.empty()) this->m_entries.resize((size_t)1 << Thash_bits);
+		assert(this->Find(new_item.GetKey()) == nullptr);
+
+		/* Grow when the table gets crowded; a rebuild at the same size is
+		 * enough when most of the used slots are tombstones. */
+		if (this->m_num_used + 1 > (int)this->m_entries.size() * 3 / 4) {
+			this->Rehash(this->m_num_items + 1 > (int)this->m_entries.size() / 2 ? this->m_entries.size() * 2 : this->m_entries.size());
+		}
+
+		this->InsertEntry(MixHash(new_item.GetKey()), &new_item);
+		this->m_num_items++;
+	}
+};
+
 #endif /* HASHTABLE_HPP */
@@ -19,8 +19,8 @@
 #include "mixer.h"
 
 struct MixerChannel {
-	/* pointer to allocated buffer memory */
-	int8 *memory;
+	/* sample buffer, shared with the sound cache */
+	std::shared_ptr<std::vector<byte>> memory;
 
 	/* current position in memory */
 	uint32 pos;
@@ -70,7 +70,7 @@ static void mix_int16(MixerChannel *sc, int16 *buffer, uint samples, uint8 effec
 	sc->samples_left -= samples;
 	assert(samples > 0);
 
-	const int16 *b = (const int16 *)sc->memory + sc->pos;
+	const int16 *b = (const int16 *)sc->memory->data() + sc->pos;
 	uint32 frac_pos = sc->frac_pos;
 	uint32 frac_speed = sc->frac_speed;
 	int volume_left = sc->volume_left * effect_vol / 255;
@@ -97,7 +97,7 @@ static void mix_int16(MixerChannel *sc, int16 *buffer, uint samples, uint8 effec
 	}
 
 	sc->frac_pos = frac_pos;
-	sc->pos = b - (const int16 *)sc->memory;
+	sc->pos = b - (const int16 *)sc->memory->data();
 }
 
 static void mix_int8_to_int16(MixerChannel *sc, int16 *buffer, uint samples, uint8 effect_vol)
@@ -106,7 +106,7 @@ static void mix_int8_to_int16(MixerChannel *sc, int16 *buffer, uint samples, uin
 	sc->samples_left -= samples;
 	assert(samples > 0);
 
-	const int8 *b = sc->memory + sc->pos;
+	const int8 *b = (const int8 *)sc->memory->data() + sc->pos;
 	uint32 frac_pos = sc->frac_pos;
 	uint32 frac_speed = sc->frac_speed;
 	int volume_left = sc->volume_left * effect_vol / 255;
@@ -133,7 +133,7 @@ static void mix_int8_to_int16(MixerChannel *sc, int16 *buffer, uint samples, uin
 	}
 
 	sc->frac_pos = frac_pos;
-	sc->pos = b - sc->memory;
+	sc->pos = b - (const int8 *)sc->memory->data();
 }
 
 static void MxCloseChannel(uint8 channel_index)
@@ -190,12 +190,13 @@ MixerChannel *MxAllocateChannel()
 	uint8 channel_index = FindFirstBit(available);
 
 	MixerChannel *mc = &_channels[channel_index];
-	free(mc->memory);
-	mc->memory = nullptr;
+	/* Release the previous sample buffer here on the game thread; the audio
+	 * thread never frees memory. */
+	mc->memory.reset();
 	return mc;
 }
 
-void MxSetChannelRawSrc(MixerChannel *mc, int8 *mem, size_t size, uint rate, bool is16bit)
+void MxSetChannelRawSrc(MixerChannel *mc, const std::shared_ptr<std::vector<byte>> &mem, size_t size, uint rate, bool is16bit)
 {
 	mc->memory = mem;
 	mc->frac_pos = 0;
@@ -230,6 +231,63 @@ void MxSetChannelVolume(MixerChannel *mc, uint volume, float pan)
 }
 
 
+/**
+ * Get the play rate of the mixer.
+ * @return Sample rate in hertz the mixer mixes at.
+ */
+uint32 MxGetPlayRate()
+{
+	return _play_rate;
+}
+
+/**
+ * Resample sample data to the play rate of the mixer, using the same linear
+ * interpolation the mixing would otherwise do on every playback.
+ * @param in   The sample data, including the padding sample at the end.
+ * @param num  Number of samples in the input.
+ * @param rate Sample rate of the input.
+ * @return The resampled sample data, with the padding the mixer expects.
+ */
+template <typename T>
+static std::shared_ptr<std::vector<byte>> ResampleSoundData(const T *in, size_t num, uint rate)
+{
+	size_t num_out = (size_t)((uint64)num * _play_rate / rate);
+	auto result = std::make_shared<std::vector<byte>>(num_out * sizeof(T) + 2);
+	T *out = (T *)result->data();
+
+	uint32 frac_speed = (rate << 16) / _play_rate;
+	uint32 frac_pos = 0;
+
+	for (size_t i = 0; i < num_out; i++) {
+		*out++ = (T)RateConversion(in, frac_pos);
+		frac_pos += frac_speed;
+		in += frac_pos >> 16;
+		frac_pos &= 0xffff;
+	}
+
+	return result;
+}
+
+/**
+ * Resample raw sound sample data to the play rate of the mixer, so no rate
+ * conversion is needed any more when mixing it.
+ * @param data    The sample data, including the two padding bytes at the end.
+ * @param size    Size of the sample data in bytes, excluding the padding.
+ * @param rate    Sample rate of the data.
+ * @param is16bit Whether the data is 16 bits per sample.
+ * @return The resampled data, or \c nullptr if no resampling is needed.
+ */
+std::shared_ptr<std::vector<byte>> MxResampleSoundData(const byte *data, size_t size, uint rate, bool is16bit)
+{
+	if (rate == _play_rate) return nullptr;
+
+	if (is16bit) {
+		return ResampleSoundData((const int16 *)data, size / 2, rate);
+	} else {
+		return ResampleSoundData((const int8 *)data, size, rate);
+	}
+}
+
 void MxActivateChannel(MixerChannel *mc)
 {
 	uint8 channel_index = mc - _channels;
@@ -24,10 +24,13 @@ bool MxInitialize(uint rate);
 void MxMixSamples(void *buffer, uint samples);
 
 MixerChannel *MxAllocateChannel();
-void MxSetChannelRawSrc(MixerChannel *mc, int8 *mem, size_t size, uint rate, bool is16bit);
+void MxSetChannelRawSrc(MixerChannel *mc, const std::shared_ptr<std::vector<byte>> &mem, size_t size, uint rate, bool is16bit);
 void MxSetChannelVolume(MixerChannel *mc, uint volume, float pan);
 void MxActivateChannel(MixerChannel*);
 
+uint32 MxGetPlayRate();
+std::shared_ptr<std::vector<byte>> MxResampleSoundData(const byte *data, size_t size, uint rate, bool is16bit);
+
 uint32 MxSetMusicSource(MxStreamCallback music_callback);
 
 void SetEffectVolume(uint8 volume);
@@ -116,12 +116,18 @@ void CheckGameCompatibility(NetworkGameInfo &ngi)
 	}
 }
 
+/** Cached serialization of the game info for query responses; empty when not valid. */
+static std::vector<byte> _serialized_game_info;
+
 /**
  * Fill a NetworkServerGameInfo structure with the static content, or things
  * that are so static they can be updated on request from a settings change.
  */
 void FillStaticNetworkServerGameInfo()
 {
+	/* The settings, map or NewGRFs changed; any cached serialization is outdated. */
+	_serialized_game_info.clear();
+
 	_network_game_info.use_password   = !_settings_client.network.server_password.empty();
 	_network_game_info.start_date     = ConvertYMDToDate(_settings_game.game_creation.starting_year, 0, 1);
 	_network_game_info.clients_max    = _settings_client.network.max_clients;
@@ -153,6 +159,39 @@ const NetworkServerGameInfo *GetCurrentNetworkServerGameInfo()
 	return &_network_game_info;
 }
 
+/**
+ * Serialize the current game info to the packet, reusing the result of the
+ * previous serialization when the game info has not changed since then.
+ * The packet must not contain any data yet, as the written payload is kept
+ * to answer the next query with.
+ * @param p the packet to write the data to.
+ */
+void SerializeCurrentNetworkGameInfo(Packet *p)
+{
+	static Date cached_game_date;
+	static byte cached_clients_on;
+	static byte cached_companies_on;
+	static byte cached_spectators_on;
+
+	const NetworkServerGameInfo *info = GetCurrentNetworkServerGameInfo();
+	if (info->game_date != cached_game_date || info->clients_on != cached_clients_on ||
+			info->companies_on != cached_companies_on || info->spectators_on != cached_spectators_on) {
+		_serialized_game_info.clear();
+	}
+
+	if (_serialized_game_info.empty()) {
+		assert(p->Size() == sizeof(PacketSize) + sizeof(PacketType));
+		SerializeNetworkGameInfo(p, info);
+		_serialized_game_info = p->GetWrittenData();
+		cached_game_date     = info->game_date;
+		cached_clients_on    = info->clients_on;
+		cached_companies_on  = info->companies_on;
+		cached_spectators_on = info->spectators_on;
+	} else {
+		p->Send_bytes(_serialized_game_info.data(), _serialized_game_info.data() + _serialized_game_info.size());
+	}
+}
+
 /**
  * Function that is called for every GRFConfig that is read when receiving
  * a NetworkGameInfo. Only grfid and md5sum are set, the rest is zero. This
@@ -138,6 +138,7 @@ void CheckGameCompatibility(NetworkGameInfo &ngi);
 
 void FillStaticNetworkServerGameInfo();
 const NetworkServerGameInfo *GetCurrentNetworkServerGameInfo();
+void SerializeCurrentNetworkGameInfo(Packet *p);
 
 void DeserializeGRFIdentifier(Packet *p, GRFIdentifier *grf);
 void DeserializeGRFIdentifierWithName(Packet *p, NamedGRFIdentifier *grf);
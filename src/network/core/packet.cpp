@@ -211,6 +211,16 @@ size_t Packet::Send_bytes(const byte *begin, const byte *end)
 	return amount;
 }
 
+/**
+ * Get a copy of the data written to the packet so far, i.e. everything
+ * after the size and type header.
+ * @return The written payload.
+ */
+std::vector<byte> Packet::GetWrittenData() const
+{
+	return { this->buffer.begin() + sizeof(PacketSize) + sizeof(PacketType), this->buffer.end() };
+}
+
 /*
  * Receiving commands
  * Again, the next couple of functions are endian-safe
@@ -74,6 +74,7 @@ public:
 	void   Send_string(const std::string_view data);
 	void   Send_buffer(const std::vector<byte> &data);
 	size_t Send_bytes (const byte *begin, const byte *end);
+	std::vector<byte> GetWrittenData() const;
 
 	/* Reading/receiving of packets */
 	bool HasPacketSizeData() const;
@@ -22,7 +22,7 @@
  */
 NetworkTCPSocketHandler::NetworkTCPSocketHandler(SOCKET s) :
 		NetworkSocketHandler(),
-		packet_queue(nullptr), packet_recv(nullptr),
+		packet_queue(nullptr), packet_queue_length(0), packet_recv(nullptr),
 		sock(s), writable(false)
 {
 }
@@ -41,6 +41,7 @@ void NetworkTCPSocketHandler::EmptyPacketQueue()
 	while (this->packet_queue != nullptr) {
 		delete Packet::PopFromQueue(&this->packet_queue);
 	}
+	this->packet_queue_length = 0;
 	delete this->packet_recv;
 	this->packet_recv = nullptr;
 }
@@ -84,6 +85,7 @@ void NetworkTCPSocketHandler::SendPacket(Packet *packet)
 
 	packet->PrepareToSend();
 	Packet::AddToQueue(&this->packet_queue, packet);
+	this->packet_queue_length++;
 }
 
 /**
@@ -129,6 +131,7 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 		if (p->RemainingBytesToTransfer() == 0) {
 			/* Go to the next packet */
 			delete Packet::PopFromQueue(&this->packet_queue);
+			this->packet_queue_length--;
 		} else {
 			return SPS_PARTLY_SENT;
 		}
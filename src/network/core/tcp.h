@@ -32,6 +32,7 @@ enum SendPacketsState {
 class NetworkTCPSocketHandler : public NetworkSocketHandler {
 private:
 	Packet *packet_queue;     ///< Packets that are awaiting delivery
+	uint packet_queue_length; ///< Number of packets in the send queue
 	Packet *packet_recv;      ///< Partially received packet
 
 	void EmptyPacketQueue();
@@ -61,6 +62,13 @@ public:
 	 */
 	bool HasSendQueue() { return this->packet_queue != nullptr; }
 
+	/**
+	 * Get the number of packets waiting in the send queue. Producers of bulk
+	 * data use this to apply backpressure instead of queueing unboundedly.
+	 * @return the number of packets awaiting delivery.
+	 */
+	uint SendQueueLength() const { return this->packet_queue_length; }
+
 	NetworkTCPSocketHandler(SOCKET s = INVALID_SOCKET);
 	~NetworkTCPSocketHandler();
 };
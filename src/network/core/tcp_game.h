@@ -94,7 +94,7 @@ enum PacketGameType {
 
 	/* Sending commands around. */
 	PACKET_CLIENT_COMMAND,               ///< Client executed a command and sends it to the server.
-	PACKET_SERVER_COMMAND,               ///< Server distributes a command to (all) the clients.
+	PACKET_SERVER_COMMAND,               ///< Server distributes a batch of commands for a single frame to (all) the clients.
 
 	/* Human communication! */
 	PACKET_CLIENT_CHAT,                  ///< Client said something that should be distributed.
@@ -345,15 +345,18 @@ protected:
 	virtual NetworkRecvStatus Receive_CLIENT_COMMAND(Packet *p);
 
 	/**
-	 * Sends a DoCommand to the client:
-	 * uint8   ID of the company (0..MAX_COMPANIES-1).
-	 * uint32  ID of the command (see command.h).
-	 * uint32  P1 (free variable used in DoCommand).
-	 * uint32  P2.
-	 * uint32  Tile where this is taking place.
-	 * string  Text.
-	 * uint8   ID of the callback.
+	 * Sends a batch of DoCommands to the client, all to be executed in the
+	 * same frame. The frame is sent once, followed by one or more commands
+	 * up to the end of the packet:
 	 * uint32  Frame of execution.
+	 * For each command:
+	 *   uint8   ID of the company (0..MAX_COMPANIES-1).
+	 *   uint16  ID of the command (see command.h).
+	 *   uint16  ID of the error message.
+	 *   uint32  Tile where this is taking place.
+	 *   buffer  Serialised command data.
+	 *   uint8   ID of the callback.
+	 *   bool    Whether the command came from this client.
 	 * @param p The packet that was just received.
 	 */
 	virtual NetworkRecvStatus Receive_SERVER_COMMAND(Packet *p);
@@ -37,6 +37,7 @@
 #include "../error.h"
 #include "../misc_cmd.h"
 #include <charconv>
+#include <deque>
 #include <sstream>
 #include <iomanip>
 
@@ -76,6 +77,7 @@ uint32 _sync_seed_1;                  ///< Seed to compare during sync checks.
 #ifdef NETWORK_SEND_DOUBLE_SEED
 uint32 _sync_seed_2;                  ///< Second part of the seed.
 #endif
+StateChecksums _sync_state_checksums; ///< State checksums to compare during sync checks.
 uint32 _sync_frame;                   ///< The frame to perform the sync check.
 bool _network_first_time;             ///< Whether we have finished joining or not.
 CompanyMask _network_company_passworded; ///< Bitmask of the password status of all companies.
@@ -622,14 +624,34 @@ static void NetworkInitialize(bool close_admins = true)
 	_network_reconnect = 0;
 }
 
+/** Maximum number of simultaneously open server query connections. */
+static const size_t MAX_PARALLEL_QUERIES = 8;
+/** Number of query connections currently being resolved, connected or waited on. */
+static size_t _pending_queries = 0;
+/** Servers waiting for a free query slot, in request order. */
+static std::deque<std::string> _queued_queries;
+
 /** Non blocking connection to query servers for their game info. */
 class TCPQueryConnecter : TCPServerConnecter {
 private:
 	std::string connection_string;
+	bool slot_released = false; ///< Whether the query slot was released, or handed over to the query socket.
 
 public:
 	TCPQueryConnecter(const std::string &connection_string) : TCPServerConnecter(connection_string, NETWORK_DEFAULT_PORT), connection_string(connection_string) {}
 
+	~TCPQueryConnecter()
+	{
+		if (this->slot_released) return;
+
+		/* The connecter was killed before it could report back, e.g. by
+		 * KillAll(); unmark the server and release the query slot. */
+		NetworkGameList *item = NetworkGameListAddItem(this->connection_string);
+		item->refreshing = false;
+
+		NetworkQueryServerDone();
+	}
+
 	void OnFailure() override
 	{
 		NetworkGameList *item = NetworkGameListAddItem(connection_string);
@@ -637,14 +659,48 @@ public:
 		item->refreshing = false;
 
 		UpdateNetworkGameWindow();
+
+		this->slot_released = true;
+		NetworkQueryServerDone();
 	}
 
 	void OnConnect(SOCKET s) override
 	{
+		/* The query socket releases the slot once it is done with the server. */
+		this->slot_released = true;
 		QueryNetworkGameSocketHandler::QueryServer(s, this->connection_string);
 	}
 };
 
+/**
+ * Actually open the connection to query a server, taking up a query slot.
+ * @param connection_string the address to query.
+ */
+static void NetworkStartQuery(const std::string &connection_string)
+{
+	_pending_queries++;
+	new TCPQueryConnecter(connection_string);
+}
+
+/**
+ * A server query finished, successfully or not; free its slot so a queued
+ * query can be started from the background loop.
+ */
+void NetworkQueryServerDone()
+{
+	assert(_pending_queries > 0);
+	_pending_queries--;
+}
+
+/** Start queued server queries, as far as the free query slots allow. */
+static void NetworkQueryDequeue()
+{
+	while (_pending_queries < MAX_PARALLEL_QUERIES && !_queued_queries.empty()) {
+		NetworkStartQuery(_queued_queries.front());
+		_queued_queries.pop_front();
+	}
+}
+
 /**
  * Query a server to fetch the game-info.
  * @param connection_string the address to query.
@@ -653,11 +709,24 @@ void NetworkQueryServer(const std::string &connection_string)
 {
 	if (!_network_available) return;
 
-	/* Mark the entry as refreshing, so the GUI can show the refresh is pending. */
 	NetworkGameList *item = NetworkGameListAddItem(connection_string);
+
+	/* There is already a query pending or queued for this server. */
+	if (item->refreshing) return;
+
+	/* Mark the entry as refreshing, so the GUI can show the refresh is pending. */
 	item->refreshing = true;
 
-	new TCPQueryConnecter(connection_string);
+	/* Refreshing many servers at once would open a connection to each of
+	 * them at the same time; keep the parallelism bounded and queue the
+	 * rest, so large server lists refresh without exhausting sockets or
+	 * resolver threads. */
+	if (_pending_queries >= MAX_PARALLEL_QUERIES) {
+		_queued_queries.push_back(item->connection_string);
+		return;
+	}
+
+	NetworkStartQuery(item->connection_string);
 }
 
 /**
@@ -1024,10 +1093,35 @@ void NetworkBackgroundLoop()
 	TCPConnecter::CheckCallbacks();
 	NetworkHTTPSocketHandler::HTTPReceive();
 	QueryNetworkGameSocketHandler::SendReceive();
+	NetworkQueryDequeue();
 
 	NetworkBackgroundUDPLoop();
 }
 
+/**
+ * Check whether nothing at all is connected to this server, so an empty
+ * dedicated server may hibernate. Connections that are still in the process
+ * of joining count as connected.
+ * @return True if no game or admin clients are connected.
+ */
+bool NetworkServerWithoutClients()
+{
+	return NetworkClientSocket::GetNumItems() == 0 && ServerNetworkAdminSocketHandler::GetNumItems() == 0;
+}
+
+/**
+ * Run the network part of the main loop for a hibernating dedicated server.
+ * This services the background protocols and accepts incoming connections,
+ * but does not advance the game state.
+ */
+void NetworkHibernateLoop()
+{
+	if (!_network_available) return;
+
+	NetworkBackgroundLoop();
+	if (_networking && NetworkReceive()) NetworkSend();
+}
+
 /* The main loop called from ttd.c
  *  Here we also have to do StateGameLoop if needed! */
 void NetworkGameLoop()
@@ -1063,7 +1157,7 @@ void NetworkGameLoop()
 		while (f != nullptr && !feof(f)) {
 			if (_date == next_date && _date_fract == next_date_fract) {
 				if (cp != nullptr) {
-					NetworkSendCommand(cp->cmd, cp->err_msg, nullptr, cp->company, cp->data);
+					NetworkSendCommand(cp->cmd, cp->err_msg, nullptr, cp->company, cp->tile, cp->data);
 					Debug(desync, 0, "Injecting: {:08x}; {:02x}; {:02x}; {:08x}; {:06x}; {} ({})", _date, _date_fract, (int)_current_company, cp->cmd, cp->tile, FormatArrayAsHex(cp->data), GetCommandName(cp->cmd));
 					delete cp;
 					cp = nullptr;
@@ -1103,18 +1197,20 @@ void NetworkGameLoop()
 				cp = new CommandPacket();
 				int company;
 				uint cmd;
+				uint tile;
 				char buffer[256];
-				int ret = sscanf(p, "%x; %x; %x; %x; %x; %x; %255s", &next_date, &next_date_fract, &company, &cmd, &cp->err_msg, &cp->tile, buffer);
-				assert(ret == 6);
+				int ret = sscanf(p, "%x; %x; %x; %x; %x; %x; %255s", &next_date, &next_date_fract, &company, &cmd, &cp->err_msg, &tile, buffer);
+				assert(ret == 7);
 				cp->company = (CompanyID)company;
 				cp->cmd = (Commands)cmd;
+				cp->tile = (TileIndex)tile;
 
 				/* Parse command data. */
 				std::vector<byte> args;
 				size_t arg_len = strlen(buffer);
 				for (size_t i = 0; i + 1 < arg_len; i += 2) {
 					byte e = 0;
-					std::from_chars(buffer + i, buffer + i + 1, e, 16);
+					std::from_chars(buffer + i, buffer + i + 2, e, 16);
 					args.emplace_back(e);
 				}
 				cp->data = args;
@@ -1149,6 +1245,12 @@ void NetworkGameLoop()
 			Debug(desync, 0, "End of commands.log");
 			fclose(f);
 			f = nullptr;
+
+			/* The replay is over; print the performance measurements gathered
+			 * while re-executing the session, as that is what benchmarking
+			 * runs of a replay are after. */
+			extern void ConPrintFramerate(); // framerate_gui.cpp
+			ConPrintFramerate();
 		}
 #endif /* DEBUG_DUMP_COMMANDS */
 		if (_frame_counter >= _frame_counter_max) {
@@ -1179,6 +1281,7 @@ void NetworkGameLoop()
 #ifdef NETWORK_SEND_DOUBLE_SEED
 		_sync_seed_2 = _random.state[1];
 #endif
+		_sync_state_checksums = _state_checksums;
 
 		NetworkServer_Tick(send_frame);
 	} else {
@@ -385,8 +385,11 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyRemove(CompanyID c
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
-/** Send economic information of all companies. */
-NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyEconomy()
+/**
+ * Send economic information of all companies.
+ * @param only_changed Send only the companies whose economy changed since it was last sent to this admin.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyEconomy(bool only_changed)
 {
 	for (const Company *company : Company::Iterate()) {
 		/* Get the income. */
@@ -395,21 +398,37 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyEconomy()
 			income -= company->yearly_expenses[0][i];
 		}
 
+		CompanyEconomyUpdate update;
+		update.money = company->money;
+		update.current_loan = company->current_loan;
+		update.income = income;
+		update.delivered_cargo = static_cast<uint16>(std::min<uint64>(UINT16_MAX, company->cur_economy.delivered_cargo.GetSum<OverflowSafeInt64>()));
+		for (uint i = 0; i < 2; i++) {
+			update.company_value[i] = company->old_economy[i].company_value;
+			update.performance[i] = company->old_economy[i].performance_history;
+			update.delivered[i] = static_cast<uint16>(std::min<uint64>(UINT16_MAX, company->old_economy[i].delivered_cargo.GetSum<OverflowSafeInt64>()));
+		}
+
+		/* For the periodic updates only send the companies whose data actually changed. */
+		if (only_changed && HasBit(this->economy_cache_valid, company->index) && this->last_economy[company->index] == update) continue;
+		this->last_economy[company->index] = update;
+		SetBit(this->economy_cache_valid, company->index);
+
 		Packet *p = new Packet(ADMIN_PACKET_SERVER_COMPANY_ECONOMY);
 
 		p->Send_uint8(company->index);
 
 		/* Current information. */
-		p->Send_uint64(company->money);
-		p->Send_uint64(company->current_loan);
-		p->Send_uint64(income);
-		p->Send_uint16(static_cast<uint16>(std::min<uint64>(UINT16_MAX, company->cur_economy.delivered_cargo.GetSum<OverflowSafeInt64>())));
+		p->Send_uint64(update.money);
+		p->Send_uint64(update.current_loan);
+		p->Send_uint64(update.income);
+		p->Send_uint16(update.delivered_cargo);
 
 		/* Send stats for the last 2 quarters. */
 		for (uint i = 0; i < 2; i++) {
-			p->Send_uint64(company->old_economy[i].company_value);
-			p->Send_uint16(company->old_economy[i].performance_history);
-			p->Send_uint16(static_cast<uint16>(std::min<uint64>(UINT16_MAX, company->old_economy[i].delivered_cargo.GetSum<OverflowSafeInt64>())));
+			p->Send_uint64(update.company_value[i]);
+			p->Send_uint16(update.performance[i]);
+			p->Send_uint16(update.delivered[i]);
 		}
 
 		this->SendPacket(p);
@@ -419,8 +438,11 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyEconomy()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
-/** Send statistics about the companies. */
-NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats()
+/**
+ * Send statistics about the companies.
+ * @param only_changed Send only the companies whose statistics changed since they were last sent to this admin.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats(bool only_changed)
 {
 	/* Fetch the latest version of the stats. */
 	NetworkCompanyStats company_stats[MAX_COMPANIES];
@@ -428,6 +450,14 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats()
 
 	/* Go through all the companies. */
 	for (const Company *company : Company::Iterate()) {
+		/* For the periodic updates only send the companies whose data actually changed. */
+		if (only_changed && HasBit(this->stats_cache_valid, company->index) &&
+				memcmp(&this->last_company_stats[company->index], &company_stats[company->index], sizeof(NetworkCompanyStats)) == 0) {
+			continue;
+		}
+		this->last_company_stats[company->index] = company_stats[company->index];
+		SetBit(this->stats_cache_valid, company->index);
+
 		Packet *p = new Packet(ADMIN_PACKET_SERVER_COMPANY_STATS);
 
 		/* Send the information. */
@@ -913,6 +943,10 @@ void NetworkAdminCompanyRemove(CompanyID company_id, AdminCompanyRemoveReason bc
 {
 	for (ServerNetworkAdminSocketHandler *as : ServerNetworkAdminSocketHandler::IterateActive()) {
 		as->SendCompanyRemove(company_id, bcrr);
+
+		/* The company index may be reused; do not suppress updates for its successor. */
+		ClrBit(as->economy_cache_valid, company_id);
+		ClrBit(as->stats_cache_valid, company_id);
 	}
 }
 
@@ -1011,11 +1045,11 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 						break;
 
 					case ADMIN_UPDATE_COMPANY_ECONOMY:
-						as->SendCompanyEconomy();
+						as->SendCompanyEconomy(true);
 						break;
 
 					case ADMIN_UPDATE_COMPANY_STATS:
-						as->SendCompanyStats();
+						as->SendCompanyStats(true);
 						break;
 
 					default: NOT_REACHED();
@@ -41,6 +41,31 @@ public:
 	std::chrono::steady_clock::time_point connect_time;      ///< Time of connection.
 	NetworkAddress address;                                  ///< Address of the admin.
 
+	/** Economy data of a company as it was last sent to the admin. */
+	struct CompanyEconomyUpdate {
+		Money money;            ///< Amount of money.
+		Money current_loan;     ///< Amount of the current loan.
+		Money income;           ///< Income of the current year.
+		uint16 delivered_cargo; ///< Delivered cargo of the current quarter.
+		Money company_value[2]; ///< Company value of the last two quarters.
+		uint16 performance[2];  ///< Performance history of the last two quarters.
+		uint16 delivered[2];    ///< Delivered cargo of the last two quarters.
+
+		bool operator==(const CompanyEconomyUpdate &other) const
+		{
+			return this->money == other.money && this->current_loan == other.current_loan && this->income == other.income &&
+					this->delivered_cargo == other.delivered_cargo &&
+					this->company_value[0] == other.company_value[0] && this->company_value[1] == other.company_value[1] &&
+					this->performance[0] == other.performance[0] && this->performance[1] == other.performance[1] &&
+					this->delivered[0] == other.delivered[0] && this->delivered[1] == other.delivered[1];
+		}
+	};
+
+	CompanyEconomyUpdate last_economy[MAX_COMPANIES];       ///< Economy data as last sent, to suppress unchanged periodic updates.
+	NetworkCompanyStats last_company_stats[MAX_COMPANIES];  ///< Company statistics as last sent, to suppress unchanged periodic updates.
+	CompanyMask economy_cache_valid;                        ///< Companies for which #last_economy holds previously sent data.
+	CompanyMask stats_cache_valid;                          ///< Companies for which #last_company_stats holds previously sent data.
+
 	ServerNetworkAdminSocketHandler(SOCKET s);
 	~ServerNetworkAdminSocketHandler();
 
@@ -59,8 +84,8 @@ public:
 	NetworkRecvStatus SendCompanyInfo(const Company *c);
 	NetworkRecvStatus SendCompanyUpdate(const Company *c);
 	NetworkRecvStatus SendCompanyRemove(CompanyID company_id, AdminCompanyRemoveReason bcrr);
-	NetworkRecvStatus SendCompanyEconomy();
-	NetworkRecvStatus SendCompanyStats();
+	NetworkRecvStatus SendCompanyEconomy(bool only_changed = false);
+	NetworkRecvStatus SendCompanyStats(bool only_changed = false);
 
 	NetworkRecvStatus SendChat(NetworkAction action, DestType desttype, ClientID client_id, const std::string &msg, int64 data);
 	NetworkRecvStatus SendRcon(uint16 colour, const std::string_view command);
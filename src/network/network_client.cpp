@@ -270,10 +270,24 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 	if (_sync_frame != 0) {
 		if (_sync_frame == _frame_counter) {
 #ifdef NETWORK_SEND_DOUBLE_SEED
-			if (_sync_seed_1 != _random.state[0] || _sync_seed_2 != _random.state[1]) {
+			bool out_of_sync = _sync_seed_1 != _random.state[0] || _sync_seed_2 != _random.state[1];
 #else
-			if (_sync_seed_1 != _random.state[0]) {
+			bool out_of_sync = _sync_seed_1 != _random.state[0];
 #endif
+			/* The per-subsystem hashes tell which part of the state diverged. */
+			if (_sync_state_checksums.vehicle != _state_checksums.vehicle) {
+				Debug(net, 0, "Vehicle state checksum mismatch");
+				out_of_sync = true;
+			}
+			if (_sync_state_checksums.cargo != _state_checksums.cargo) {
+				Debug(net, 0, "Cargo state checksum mismatch");
+				out_of_sync = true;
+			}
+			if (_sync_state_checksums.town != _state_checksums.town) {
+				Debug(net, 0, "Town state checksum mismatch");
+				out_of_sync = true;
+			}
+			if (out_of_sync) {
 				ShowNetworkError(STR_NETWORK_ERROR_DESYNC);
 				Debug(desync, 1, "sync_err: {:08x}; {:02x}", _date, _date_fract);
 				Debug(net, 0, "Sync error detected");
@@ -859,15 +873,18 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_FRAME(Packet *p
 	/* Test if the server supports this option
 	 *  and if we are at the frame the server is */
 #ifdef NETWORK_SEND_DOUBLE_SEED
-	if (p->CanReadFromPacket(sizeof(uint32) + sizeof(uint32))) {
+	if (p->CanReadFromPacket(5 * sizeof(uint32))) {
 #else
-	if (p->CanReadFromPacket(sizeof(uint32))) {
+	if (p->CanReadFromPacket(4 * sizeof(uint32))) {
 #endif
 		_sync_frame = _frame_counter_server;
 		_sync_seed_1 = p->Recv_uint32();
 #ifdef NETWORK_SEND_DOUBLE_SEED
 		_sync_seed_2 = p->Recv_uint32();
 #endif
+		_sync_state_checksums.vehicle = p->Recv_uint32();
+		_sync_state_checksums.cargo = p->Recv_uint32();
+		_sync_state_checksums.town = p->Recv_uint32();
 	}
 #endif
 	/* Receive the token. */
@@ -895,6 +912,9 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_SYNC(Packet *p)
 #ifdef NETWORK_SEND_DOUBLE_SEED
 	_sync_seed_2 = p->Recv_uint32();
 #endif
+	_sync_state_checksums.vehicle = p->Recv_uint32();
+	_sync_state_checksums.cargo = p->Recv_uint32();
+	_sync_state_checksums.town = p->Recv_uint32();
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -903,17 +923,22 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_COMMAND(Packet
 {
 	if (this->status != STATUS_ACTIVE) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
 
-	CommandPacket cp;
-	const char *err = this->ReceiveCommand(p, &cp);
-	cp.frame    = p->Recv_uint32();
-	cp.my_cmd   = p->Recv_bool();
+	/* The frame of execution is shared by all commands in the packet. */
+	uint32 frame = p->Recv_uint32();
 
-	if (err != nullptr) {
-		IConsolePrint(CC_WARNING, "Dropping server connection due to {}.", err);
-		return NETWORK_RECV_STATUS_MALFORMED_PACKET;
-	}
+	while (p->CanReadFromPacket(1)) {
+		CommandPacket cp;
+		const char *err = this->ReceiveCommand(p, &cp);
+		cp.frame    = frame;
+		cp.my_cmd   = p->Recv_bool();
+
+		if (err != nullptr) {
+			IConsolePrint(CC_WARNING, "Dropping server connection due to {}.", err);
+			return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+		}
 
-	this->incoming_queue.Append(&cp);
+		this->incoming_queue.Append(&cp);
+	}
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -240,6 +240,38 @@ static CommandQueue _local_wait_queue;
 /** Local queue of packets waiting for execution. */
 static CommandQueue _local_execution_queue;
 
+/**
+ * Commands sent to the server that were not executed yet; used to drop
+ * repeated clicks on #CMD_NO_DUPLICATE commands instead of sending the
+ * same command again while the first one is still in flight.
+ * The frame of each entry holds when the entry times out, for the case
+ * the server dropped the command.
+ */
+static std::vector<CommandPacket> _duplicate_guard;
+
+/** Number of frames after which a #_duplicate_guard entry times out. */
+static const uint32 DUPLICATE_GUARD_TIMEOUT = 30;
+
+/**
+ * Check whether an identical command is already on its way to or back from
+ * the server, and if not remember this one until it has been executed.
+ * @param c The command packet about to be sent to the server.
+ * @return True when the command is a duplicate and must not be sent.
+ */
+static bool IsDuplicateCommand(const CommandPacket &c)
+{
+	if (!(GetCommandFlags(c.cmd) & CMD_NO_DUPLICATE)) return false;
+
+	for (const CommandPacket &p : _duplicate_guard) {
+		if (p.cmd == c.cmd && p.company == c.company && p.tile == c.tile && p.data == c.data) return true;
+	}
+
+	CommandPacket guard = c;
+	guard.frame = _frame_counter + DUPLICATE_GUARD_TIMEOUT;
+	_duplicate_guard.push_back(guard);
+	return false;
+}
+
 
 /**
  * Find the callback index of a callback pointer.
@@ -290,25 +322,28 @@ void NetworkSendCommand(Commands cmd, StringID err_message, CommandCallback *cal
 
 	c.frame = 0; // The client can't tell which frame, so just make it 0
 
+	/* Repeated clicks would only make the command execute, and fail, twice. */
+	if (IsDuplicateCommand(c)) return;
+
 	/* Clients send their command to the server and forget all about the packet */
 	MyClient::SendCommand(&c);
 }
 
 /**
- * Sync our local command queue to the command queue of the given
- * socket. This is needed for the case where we receive a command
- * before saving the game for a joining client, but without the
- * execution of those commands. Not syncing those commands means
- * that the client will never get them and as such will be in a
- * desynced state from the time it started with joining.
- * @param cs The client to sync the queue to.
+ * Fill the command backlog of a fresh map snapshot with our local command
+ * queue. This is needed for the case where we receive a command before
+ * saving the game for a joining client, but without the execution of those
+ * commands. Not syncing those commands means that the client will never
+ * get them and as such will be in a desynced state from the time it
+ * started with joining.
+ * @param backlog The backlog to fill.
  */
-void NetworkSyncCommandQueue(NetworkClientSocket *cs)
+void NetworkFillSnapshotBacklog(std::vector<CommandPacket> &backlog)
 {
 	for (CommandPacket *p = _local_execution_queue.Peek(); p != nullptr; p = p->next) {
 		CommandPacket c = *p;
 		c.callback = nullptr;
-		cs->outgoing_queue.Append(&c);
+		backlog.push_back(c);
 	}
 }
 
@@ -321,6 +356,10 @@ void NetworkExecuteLocalCommandQueue()
 
 	CommandQueue &queue = (_network_server ? _local_execution_queue : ClientNetworkGameSocketHandler::my_client->incoming_queue);
 
+	/* Time out guard entries of commands the server may have dropped. */
+	_duplicate_guard.erase(std::remove_if(_duplicate_guard.begin(), _duplicate_guard.end(),
+			[](const CommandPacket &p) { return p.frame <= _frame_counter; }), _duplicate_guard.end());
+
 	CommandPacket *cp;
 	while ((cp = queue.Peek()) != nullptr) {
 		/* The queue is always in order, which means
@@ -340,6 +379,16 @@ void NetworkExecuteLocalCommandQueue()
 		assert(_cmd_dispatch[cp->cmd].Unpack[cb_index] != nullptr);
 		_cmd_dispatch[cp->cmd].Unpack[cb_index](cp);
 
+		/* One of our own commands came back; release its duplicate guard. */
+		if (cp->my_cmd && !_duplicate_guard.empty()) {
+			for (auto it = _duplicate_guard.begin(); it != _duplicate_guard.end(); ++it) {
+				if (it->cmd == cp->cmd && it->company == cp->company && it->tile == cp->tile && it->data == cp->data) {
+					_duplicate_guard.erase(it);
+					break;
+				}
+			}
+		}
+
 		queue.Pop();
 		delete cp;
 	}
@@ -355,6 +404,7 @@ void NetworkFreeLocalCommandQueue()
 {
 	_local_wait_queue.Free();
 	_local_execution_queue.Free();
+	_duplicate_guard.clear();
 }
 
 /**
@@ -380,6 +430,10 @@ static void DistributeCommandPacket(CommandPacket &cp, const NetworkClientSocket
 	cp.callback = (nullptr != owner) ? nullptr : callback;
 	cp.my_cmd = (nullptr == owner);
 	_local_execution_queue.Append(&cp);
+
+	/* Clients that attach later to the map snapshot currently being sent
+	 * have missed this command; record it so they get it when attaching. */
+	NetworkAddCommandToSnapshotBacklog(cp);
 }
 
 /**
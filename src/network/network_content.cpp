@@ -397,101 +397,86 @@ void ClientNetworkContentSocketHandler::DownloadSelectedContentFallback(const Co
 
 /**
  * Determine the full filename of a piece of content information
- * @param ci         the information to get the filename from
- * @param compressed should the filename end with .gz?
+ * @param ci the information to get the filename from
  * @return a statically allocated buffer with the filename or
  *         nullptr when no filename could be made.
  */
-static std::string GetFullFilename(const ContentInfo *ci, bool compressed)
+static std::string GetFullFilename(const ContentInfo *ci)
 {
 	Subdirectory dir = GetContentInfoSubDir(ci->type);
 	if (dir == NO_DIRECTORY) return {};
 
 	std::string buf = FioGetDirectory(SP_AUTODOWNLOAD_DIR, dir);
 	buf += ci->filename;
-	buf += compressed ? ".tar.gz" : ".tar";
+	buf += ".tar";
 
 	return buf;
 }
 
+#if defined(WITH_ZLIB)
+/** The stream decompressing the currently downloaded file while it is received. */
+static z_stream _content_inflate_stream;
+/** Whether the decompression stream has reached the end of the gzip data. */
+static bool _content_inflate_end;
+#endif /* defined(WITH_ZLIB) */
+
 /**
- * Gunzip a given file and remove the .gz if successful.
- * @param ci container with filename
- * @return true if the gunzip completed
+ * Write received data of the currently downloaded file, decompressing
+ * the gzip stream on the fly so no intermediate .gz file is needed.
+ * @param data   The (compressed) data to write.
+ * @param length The number of bytes to write.
+ * @return Whether the data was decompressed and written without error.
  */
-static bool GunzipFile(const ContentInfo *ci)
+bool ClientNetworkContentSocketHandler::WriteFileData(const char *data, size_t length)
 {
-#if defined(WITH_ZLIB)
-	bool ret = true;
-
-	/* Need to open the file with fopen() to support non-ASCII on Windows. */
-	FILE *ftmp = fopen(GetFullFilename(ci, true).c_str(), "rb");
-	if (ftmp == nullptr) return false;
-	/* Duplicate the handle, and close the FILE*, to avoid double-closing the handle later. */
-	int fdup = dup(fileno(ftmp));
-	gzFile fin = gzdopen(fdup, "rb");
-	fclose(ftmp);
+	this->curFileBytes += length;
 
-	FILE *fout = fopen(GetFullFilename(ci, false).c_str(), "wb");
-
-	if (fin == nullptr || fout == nullptr) {
-		ret = false;
-	} else {
-		byte buff[8192];
-		for (;;) {
-			int read = gzread(fin, buff, sizeof(buff));
-			if (read == 0) {
-				/* If gzread() returns 0, either the end-of-file has been
-				 * reached or an underlying read error has occurred.
-				 *
-				 * gzeof() can't be used, because:
-				 * 1.2.5 - it is safe, 1 means 'everything was OK'
-				 * 1.2.3.5, 1.2.4 - 0 or 1 is returned 'randomly'
-				 * 1.2.3.3 - 1 is returned for truncated archive
-				 *
-				 * So we use gzerror(). When proper end of archive
-				 * has been reached, then:
-				 * errnum == Z_STREAM_END in 1.2.3.3,
-				 * errnum == 0 in 1.2.4 and 1.2.5 */
-				int errnum;
-				gzerror(fin, &errnum);
-				if (errnum != 0 && errnum != Z_STREAM_END) ret = false;
-				break;
-			}
-			if (read < 0 || (size_t)read != fwrite(buff, 1, read, fout)) {
-				/* If gzread() returns -1, there was an error in archive */
-				ret = false;
-				break;
-			}
-			/* DO NOT DO THIS! It will fail to detect broken archive with 1.2.3.3!
-			 * if (read < sizeof(buff)) break; */
+#if defined(WITH_ZLIB)
+	byte buff[8192];
+
+	_content_inflate_stream.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(data));
+	_content_inflate_stream.avail_in = (uInt)length;
+	do {
+		/* A valid download ends the gzip stream exactly at the end of the data. */
+		if (_content_inflate_end) return false;
+
+		_content_inflate_stream.next_out = buff;
+		_content_inflate_stream.avail_out = sizeof(buff);
+
+		int r = inflate(&_content_inflate_stream, Z_NO_FLUSH);
+		if (r == Z_STREAM_END) {
+			_content_inflate_end = true;
+		} else if (r != Z_OK) {
+			/* There was an error in the archive. */
+			return false;
 		}
-	}
 
-	if (fin != nullptr) {
-		gzclose(fin);
-	} else if (fdup != -1) {
-		/* Failing gzdopen does not close the passed file descriptor. */
-		close(fdup);
-	}
-	if (fout != nullptr) fclose(fout);
+		size_t towrite = sizeof(buff) - _content_inflate_stream.avail_out;
+		if (towrite != 0 && fwrite(buff, 1, towrite, this->curFile) != towrite) return false;
+	} while (_content_inflate_stream.avail_in != 0 || (_content_inflate_stream.avail_out == 0 && !_content_inflate_end));
 
-	return ret;
+	return true;
 #else
-	NOT_REACHED();
+	return fwrite(data, 1, length, this->curFile) == length;
 #endif /* defined(WITH_ZLIB) */
 }
 
 /**
- * Simple wrapper around fwrite to be able to pass it to Packet's TransferOut.
- * @param file   The file to write data to.
- * @param buffer The buffer to write to the file.
- * @param amount The number of bytes to write.
- * @return The number of bytes that were written.
+ * Close the currently downloaded file, ending the decompression stream.
+ * @return Whether the compressed data was complete, i.e. the gzip stream ended exactly at the end of the download.
  */
-static inline ssize_t TransferOutFWrite(FILE *file, const char *buffer, size_t amount)
+bool ClientNetworkContentSocketHandler::CloseCurFile()
 {
-	return fwrite(buffer, 1, amount, file);
+	fclose(this->curFile);
+	this->curFile = nullptr;
+
+#if defined(WITH_ZLIB)
+	bool complete = _content_inflate_end;
+	inflateEnd(&_content_inflate_stream);
+	return complete;
+#else
+	return false;
+#endif /* defined(WITH_ZLIB) */
 }
 
 bool ClientNetworkContentSocketHandler::Receive_SERVER_CONTENT(Packet *p)
@@ -512,12 +497,14 @@ bool ClientNetworkContentSocketHandler::Receive_SERVER_CONTENT(Packet *p)
 	} else {
 		/* We have a file opened, thus are downloading internal content */
 		size_t toRead = p->RemainingBytesToTransfer();
-		if (toRead != 0 && (size_t)p->TransferOut(TransferOutFWrite, this->curFile) != toRead) {
+		auto transfer = [](ClientNetworkContentSocketHandler *handler, const char *buffer, size_t amount) -> ssize_t {
+			return handler->WriteFileData(buffer, amount) ? (ssize_t)amount : -1;
+		};
+		if (toRead != 0 && (size_t)p->TransferOut(transfer, this) != toRead) {
 			CloseWindowById(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_CONTENT_DOWNLOAD);
 			ShowErrorMessage(STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD, STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD_FILE_NOT_WRITABLE, WL_ERROR);
 			this->CloseConnection();
-			fclose(this->curFile);
-			this->curFile = nullptr;
+			this->CloseCurFile();
 
 			return false;
 		}
@@ -544,13 +531,27 @@ bool ClientNetworkContentSocketHandler::BeforeDownload()
 
 	if (this->curInfo->filesize != 0) {
 		/* The filesize is > 0, so we are going to download it */
-		std::string filename = GetFullFilename(this->curInfo, true);
+		std::string filename = GetFullFilename(this->curInfo);
 		if (filename.empty() || (this->curFile = fopen(filename.c_str(), "wb")) == nullptr) {
 			/* Unless that fails of course... */
 			CloseWindowById(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_CONTENT_DOWNLOAD);
 			ShowErrorMessage(STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD, STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD_FILE_NOT_WRITABLE, WL_ERROR);
 			return false;
 		}
+
+		this->curFileBytes = 0;
+
+#if defined(WITH_ZLIB)
+		/* The content is transferred as gzip; decompress it while it is received. */
+		memset(&_content_inflate_stream, 0, sizeof(_content_inflate_stream));
+		_content_inflate_end = false;
+		if (inflateInit2(&_content_inflate_stream, 16 + MAX_WBITS) != Z_OK) {
+			fclose(this->curFile);
+			this->curFile = nullptr;
+			ShowErrorMessage(STR_CONTENT_ERROR_COULD_NOT_EXTRACT, INVALID_STRING_ID, WL_ERROR);
+			return false;
+		}
+#endif /* defined(WITH_ZLIB) */
 	}
 	return true;
 }
@@ -562,18 +563,13 @@ bool ClientNetworkContentSocketHandler::BeforeDownload()
 void ClientNetworkContentSocketHandler::AfterDownload()
 {
 	/* We read nothing; that's our marker for end-of-stream.
-	 * Now gunzip the tar and make it known. */
-	fclose(this->curFile);
-	this->curFile = nullptr;
-
-	if (GunzipFile(this->curInfo)) {
-		unlink(GetFullFilename(this->curInfo, true).c_str());
-
+	 * The tar was already gunzipped while it was received, so just make it known. */
+	if (this->CloseCurFile()) {
 		Subdirectory sd = GetContentInfoSubDir(this->curInfo->type);
 		if (sd == NO_DIRECTORY) NOT_REACHED();
 
 		TarScanner ts;
-		std::string fname = GetFullFilename(this->curInfo, false);
+		std::string fname = GetFullFilename(this->curInfo);
 		ts.AddFile(sd, fname);
 
 		if (this->curInfo->type == CONTENT_TYPE_BASE_MUSIC) {
@@ -605,11 +601,9 @@ void ClientNetworkContentSocketHandler::OnFailure()
 
 	if (this->curFile != nullptr) {
 		/* Revert the download progress when we are going for the old system. */
-		long size = ftell(this->curFile);
-		if (size > 0) this->OnDownloadProgress(this->curInfo, (int)-size);
+		if (this->curFileBytes > 0) this->OnDownloadProgress(this->curInfo, -(int)this->curFileBytes);
 
-		fclose(this->curFile);
-		this->curFile = nullptr;
+		this->CloseCurFile();
 	}
 }
 
@@ -636,7 +630,7 @@ void ClientNetworkContentSocketHandler::OnReceiveData(const char *data, size_t l
 
 	if (data != nullptr) {
 		/* We have data, so write it to the file. */
-		if (fwrite(data, 1, length, this->curFile) != length) {
+		if (!this->WriteFileData(data, length)) {
 			/* Writing failed somehow, let try via the old method. */
 			this->OnFailure();
 		} else {
@@ -745,6 +739,7 @@ ClientNetworkContentSocketHandler::ClientNetworkContentSocketHandler() :
 	NetworkContentSocketHandler(),
 	http_response_index(-2),
 	curFile(nullptr),
+	curFileBytes(0),
 	curInfo(nullptr),
 	isConnecting(false)
 {
@@ -755,7 +750,7 @@ ClientNetworkContentSocketHandler::ClientNetworkContentSocketHandler() :
 ClientNetworkContentSocketHandler::~ClientNetworkContentSocketHandler()
 {
 	delete this->curInfo;
-	if (this->curFile != nullptr) fclose(this->curFile);
+	if (this->curFile != nullptr) this->CloseCurFile();
 
 	for (ContentInfo *ci : this->infos) delete ci;
 }
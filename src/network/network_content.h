@@ -74,6 +74,7 @@ protected:
 	int http_response_index;                      ///< Where we are, in the response, with handling it
 
 	FILE *curFile;        ///< Currently downloaded file
+	size_t curFileBytes;  ///< Number of (compressed) bytes received for the currently downloaded file
 	ContentInfo *curInfo; ///< Information about the currently downloaded file
 	bool isConnecting;    ///< Whether we're connecting
 	std::chrono::steady_clock::time_point lastActivity;  ///< The last time there was network activity
@@ -96,7 +97,9 @@ protected:
 	void OnReceiveData(const char *data, size_t length) override;
 
 	bool BeforeDownload();
+	bool WriteFileData(const char *data, size_t length);
 	void AfterDownload();
+	bool CloseCurFile();
 
 	void DownloadSelectedContentHTTP(const ContentIDList &content);
 	void DownloadSelectedContentFallback(const ContentIDList &content);
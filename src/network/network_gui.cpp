@@ -27,6 +27,7 @@
 #include "../widgets/dropdown_func.h"
 #include "../querystring_gui.h"
 #include "../sortlist_type.h"
+#include "../string_func.h"
 #include "../company_func.h"
 #include "../command_func.h"
 #include "../core/geometry_func.hpp"
@@ -284,7 +285,7 @@ protected:
 		this->vscroll->SetCount((int)this->servers.size());
 
 		/* Sort the list of network games as requested. */
-		this->servers.Sort();
+		this->SortServerList();
 		this->UpdateListPos();
 	}
 
@@ -357,10 +358,25 @@ protected:
 		return (r != 0) ? r < 0 : NGameClientSorter(b, a);
 	}
 
+	/**
+	 * Sort the server list with the currently selected criteria.
+	 * @return true if the list sequence has been altered
+	 */
+	bool SortServerList()
+	{
+		if (this->servers.SortType() == 0 && StrNatSortKeysSupported()) {
+			/* Sorting by name collates per comparison; extract each server's collation key once instead. */
+			return this->servers.SortByKey([](NetworkGameList * const &item) {
+				return std::make_pair(StrNatSortKey(item->info.server_name.c_str(), true), item->connection_string);
+			});
+		}
+		return this->servers.Sort();
+	}
+
 	/** Sort the server list */
 	void SortNetworkGameList()
 	{
-		if (this->servers.Sort()) this->UpdateListPos();
+		if (this->SortServerList()) this->UpdateListPos();
 	}
 
 	/** Set this->list_pos to match this->server */
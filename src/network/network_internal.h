@@ -16,6 +16,7 @@
 
 #include "../command_type.h"
 #include "../command_func.h"
+#include "../state_checksum.h"
 #include "../misc/endian_buffer.hpp"
 
 #ifdef RANDOM_DEBUG
@@ -78,6 +79,7 @@ extern uint32 _sync_seed_1;
 #ifdef NETWORK_SEND_DOUBLE_SEED
 extern uint32 _sync_seed_2;
 #endif
+extern StateChecksums _sync_state_checksums;
 extern uint32 _sync_frame;
 extern bool _network_first_time;
 /* Vars needed for the join-GUI */
@@ -96,6 +98,7 @@ extern uint8 _network_reconnect;
 extern CompanyMask _network_company_passworded;
 
 void NetworkQueryServer(const std::string &connection_string);
+void NetworkQueryServerDone();
 
 void GetBindAddresses(NetworkAddressList *addresses, uint16 port);
 struct NetworkGameList *NetworkAddServer(const std::string &connection_string, bool manually = true, bool never_expire = false);
@@ -124,7 +127,8 @@ struct CommandPacket {
 void NetworkDistributeCommands();
 void NetworkExecuteLocalCommandQueue();
 void NetworkFreeLocalCommandQueue();
-void NetworkSyncCommandQueue(NetworkClientSocket *cs);
+void NetworkFillSnapshotBacklog(std::vector<CommandPacket> &backlog);
+void NetworkAddCommandToSnapshotBacklog(const CommandPacket &cp);
 void NetworkReplaceCommandClientId(CommandPacket &cp, ClientID client_id);
 
 void ShowNetworkError(StringID error_string);
@@ -11,6 +11,7 @@
 #include "core/game_info.h"
 #include "network_query.h"
 #include "network_gamelist.h"
+#include "network_internal.h"
 #include "../error.h"
 
 #include "table/strings.h"
@@ -36,6 +37,13 @@ bool QueryNetworkGameSocketHandler::CheckConnection()
 
 	/* If there was no response in 5 seconds, terminate the query. */
 	if (lag > std::chrono::seconds(5)) {
+		/* Make sure the server is not shown as eternally refreshing. */
+		NetworkGameList *item = NetworkGameListAddItem(this->connection_string);
+		item->status = NGLS_OFFLINE;
+		item->refreshing = false;
+
+		UpdateNetworkGameWindow();
+
 		this->CloseConnection(NETWORK_RECV_STATUS_CONNECTION_LOST);
 		return false;
 	}
@@ -144,10 +152,9 @@ NetworkRecvStatus QueryNetworkGameSocketHandler::Receive_SERVER_ERROR(Packet *p)
 /* static */ void QueryNetworkGameSocketHandler::SendReceive()
 {
 	for (auto it = QueryNetworkGameSocketHandler::queries.begin(); it != QueryNetworkGameSocketHandler::queries.end(); /* nothing */) {
-		if (!(*it)->Receive()) {
-			it = QueryNetworkGameSocketHandler::queries.erase(it);
-		} else if (!(*it)->CheckConnection()) {
+		if (!(*it)->Receive() || !(*it)->CheckConnection()) {
 			it = QueryNetworkGameSocketHandler::queries.erase(it);
+			NetworkQueryServerDone();
 		} else {
 			it++;
 		}
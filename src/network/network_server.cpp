@@ -55,58 +55,81 @@ INSTANTIATE_POOL_METHODS(NetworkClientSocket)
 /** Instantiate the listen sockets. */
 template SocketList TCPListenHandler<ServerNetworkGameSocketHandler, PACKET_SERVER_FULL, PACKET_SERVER_BANNED>::sockets;
 
-/** Writing a savegame directly to a number of packets. */
-struct PacketWriter : SaveFilter {
-	ServerNetworkGameSocketHandler *cs; ///< Socket we are associated with.
-	Packet *current;                    ///< The packet we're currently writing to.
-	size_t total_size;                  ///< Total size of the compressed savegame.
-	Packet *packets;                    ///< Packet queue of the savegame; send these "slowly" to the client.
-	std::mutex mutex;                   ///< Mutex for making threaded saving safe.
-	std::condition_variable exit_sig;   ///< Signal for threaded destruction of this packet writer.
+struct MapSnapshot;
+
+/** The snapshot of the game currently being sent to joining clients, if any. */
+static MapSnapshot *_map_snapshot = nullptr;
+
+/**
+ * Writing a savegame to a shared buffer that is streamed to joining clients.
+ * The snapshot is taken once and sent to every client that starts joining
+ * while it exists, each with their own offset into the data, so a batch of
+ * joining clients only costs a single savegame.
+ */
+struct MapSnapshot : SaveFilter {
+	/** A block of compressed savegame data. */
+	struct Block {
+		byte *data;  ///< The data of the block.
+		size_t size; ///< The size of the block.
+	};
+
+	std::mutex mutex;                 ///< Mutex for making threaded saving safe.
+	std::condition_variable exit_sig; ///< Signal for threaded destruction of this snapshot.
+	std::vector<Block> blocks;        ///< Compressed savegame data produced so far.
+	size_t total_size;                ///< Total size of the compressed savegame so far.
+	bool finished;                    ///< Whether all savegame data has been produced.
+	int clients;                      ///< Number of clients the snapshot is still being sent to.
+	uint32 frame;                     ///< Frame counter at which the snapshot was taken.
 
 	/**
-	 * Create the packet writer.
-	 * @param cs The socket handler we're making the packets for.
+	 * Commands distributed since the snapshot was taken. A client attaching
+	 * to the snapshot later has missed those, so they are queued on attach
+	 * to let it catch up from the snapshot's frame. Only ever touched by
+	 * the game thread.
 	 */
-	PacketWriter(ServerNetworkGameSocketHandler *cs) : SaveFilter(nullptr), cs(cs), current(nullptr), total_size(0), packets(nullptr)
+	std::vector<CommandPacket> command_backlog;
+
+	MapSnapshot() : SaveFilter(nullptr), total_size(0), finished(false), clients(0), frame(_frame_counter)
 	{
 	}
 
 	/** Make sure everything is cleaned up. */
-	~PacketWriter()
+	~MapSnapshot()
 	{
 		std::unique_lock<std::mutex> lock(this->mutex);
 
-		if (this->cs != nullptr) this->exit_sig.wait(lock);
-
-		/* This must all wait until the Destroy function is called. */
+		/* This must all wait until the last client has detached. */
+		if (this->clients != 0) this->exit_sig.wait(lock);
 
-		while (this->packets != nullptr) {
-			delete Packet::PopFromQueue(&this->packets);
-		}
+		for (Block &block : this->blocks) free(block.data);
+	}
 
-		delete this->current;
+	/** Attach a client this snapshot is (also) to be sent to. */
+	void Attach()
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->clients++;
 	}
 
 	/**
-	 * Begin the destruction of this packet writer. It can happen in two ways:
-	 * in the first case the client disconnected while saving the map. In this
-	 * case the saving has not finished and killed this PacketWriter. In that
-	 * case we simply set cs to nullptr, triggering the appending to fail due to
-	 * the connection problem and eventually triggering the destructor. In the
-	 * second case the destructor is already called, and it is waiting for our
-	 * signal which we will send. Only then the packets will be removed by the
-	 * destructor.
+	 * Detach a client, because its transfer completed or it disconnected.
+	 * Detaching the last client triggers the destruction of the snapshot.
+	 * It can happen in two ways: when the saving has not finished yet, the
+	 * writer notices there is nobody left to save for and aborts, which
+	 * eventually triggers the destructor. Otherwise the destructor is
+	 * already called, and it is waiting for our signal which we will send.
 	 */
-	void Destroy()
+	void Detach()
 	{
 		std::unique_lock<std::mutex> lock(this->mutex);
 
-		this->cs = nullptr;
+		if (--this->clients > 0) return;
 
 		this->exit_sig.notify_all();
 		lock.unlock();
 
+		_map_snapshot = nullptr;
+
 		/* Make sure the saving is completely cancelled. Yes,
 		 * we need to handle the save finish as well as the
 		 * next connection might just be requesting a map. */
@@ -115,93 +138,104 @@ struct PacketWriter : SaveFilter {
 	}
 
 	/**
-	 * Transfer all packets from here to the network's queue while holding
-	 * the lock on our mutex.
-	 * @param socket The network socket to write to.
-	 * @return True iff the last packet of the map has been sent.
+	 * Queue all data produced since the client's last call, packed into
+	 * PACKET_SERVER_MAP_DATA packets, while holding the lock on our mutex.
+	 * @param socket The socket of the client to queue the data for.
+	 * @return True iff the last packet of the map has been queued.
 	 */
 	bool TransferToNetworkQueue(ServerNetworkGameSocketHandler *socket)
 	{
-		/* Unsafe check for the queue being empty or not. */
-		if (this->packets == nullptr) return false;
-
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		while (this->packets != nullptr) {
-			Packet *p = Packet::PopFromQueue(&this->packets);
-			bool last_packet = p->GetPacketType() == PACKET_SERVER_MAP_DONE;
+		if (this->finished && !socket->savegame_size_sent) {
+			/* Fast-track the size to the client. */
+			Packet *p = new Packet(PACKET_SERVER_MAP_SIZE);
+			p->Send_uint32((uint32)this->total_size);
 			socket->SendPacket(p);
-
-			if (last_packet) return true;
+			socket->savegame_size_sent = true;
 		}
 
-		return false;
-	}
-
-	/** Append the current packet to the queue. */
-	void AppendQueue()
-	{
-		if (this->current == nullptr) return;
+		/* Find the block the client's offset points into. */
+		size_t offset = socket->savegame_offset;
+		size_t begin = 0;
+		size_t i = 0;
+		while (i < this->blocks.size() && begin + this->blocks[i].size <= offset) {
+			begin += this->blocks[i].size;
+			i++;
+		}
 
-		Packet::AddToQueue(&this->packets, this->current);
-		this->current = nullptr;
-	}
+		/* Bound the backlog of a client on a slow link; it would otherwise
+		 * collect the whole map in its send queue while the socket drains
+		 * at link speed. The transfer resumes from savegame_offset on the
+		 * next call, once the queue has made room again. */
+		static const uint MAX_QUEUED_MAP_PACKETS = 64;
+
+		Packet *current = nullptr;
+		for (; i < this->blocks.size() && socket->SendQueueLength() < MAX_QUEUED_MAP_PACKETS; begin += this->blocks[i].size, i++) {
+			const byte *buf = this->blocks[i].data + (offset - begin);
+			const byte *bufe = this->blocks[i].data + this->blocks[i].size;
+
+			while (buf != bufe && socket->SendQueueLength() < MAX_QUEUED_MAP_PACKETS) {
+				if (current == nullptr) current = new Packet(PACKET_SERVER_MAP_DATA, TCP_MTU);
+				size_t written = current->Send_bytes(buf, bufe);
+				buf += written;
+				offset += written;
+
+				if (!current->CanWriteToPacket(1)) {
+					socket->SendPacket(current);
+					current = nullptr;
+				}
+			}
+		}
+		if (current != nullptr) socket->SendPacket(current);
+		socket->savegame_offset = offset;
 
-	/** Prepend the current packet to the queue. */
-	void PrependQueue()
-	{
-		if (this->current == nullptr) return;
+		if (this->finished && offset == this->total_size) {
+			socket->SendPacket(new Packet(PACKET_SERVER_MAP_DONE));
+			return true;
+		}
 
-		/* Reversed from AppendQueue so the queue gets added to the current one. */
-		Packet::AddToQueue(&this->current, this->packets);
-		this->packets = this->current;
-		this->current = nullptr;
+		return false;
 	}
 
 	void Write(byte *buf, size_t size) override
 	{
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
-
-		if (this->current == nullptr) this->current = new Packet(PACKET_SERVER_MAP_DATA, TCP_MTU);
-
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		byte *bufe = buf + size;
-		while (buf != bufe) {
-			size_t written = this->current->Send_bytes(buf, bufe);
-			buf += written;
-
-			if (!this->current->CanWriteToPacket(1)) {
-				this->AppendQueue();
-				if (buf != bufe) this->current = new Packet(PACKET_SERVER_MAP_DATA, TCP_MTU);
-			}
-		}
+		/* We want to abort the saving when all receiving clients are gone. */
+		if (this->clients == 0) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
 
+		Block block = { MallocT<byte>(size), size };
+		memcpy(block.data, buf, size);
+		this->blocks.push_back(block);
 		this->total_size += size;
 	}
 
 	void Finish() override
 	{
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
-
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		/* Make sure the last packet is flushed. */
-		this->AppendQueue();
-
-		/* Add a packet stating that this is the end to the queue. */
-		this->current = new Packet(PACKET_SERVER_MAP_DONE);
-		this->AppendQueue();
+		/* We want to abort the saving when all receiving clients are gone. */
+		if (this->clients == 0) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
 
-		/* Fast-track the size to the client. */
-		this->current = new Packet(PACKET_SERVER_MAP_SIZE);
-		this->current->Send_uint32((uint32)this->total_size);
-		this->PrependQueue();
+		this->finished = true;
 	}
 };
 
+/**
+ * Record a just distributed command in the backlog of the map snapshot
+ * currently being sent, if any.
+ * @param cp The command that was distributed.
+ */
+void NetworkAddCommandToSnapshotBacklog(const CommandPacket &cp)
+{
+	if (_map_snapshot == nullptr) return;
+
+	CommandPacket c = cp;
+	c.callback = nullptr;
+	_map_snapshot->command_backlog.push_back(c);
+}
+
 
 /**
  * Create a new socket for the server side of the game connection.
@@ -212,6 +246,7 @@ ServerNetworkGameSocketHandler::ServerNetworkGameSocketHandler(SOCKET s) : Netwo
 	this->status = STATUS_INACTIVE;
 	this->client_id = _network_client_id++;
 	this->receive_limit = _settings_client.network.bytes_per_frame_burst;
+	this->command_tokens = _settings_client.network.commands_per_frame_burst;
 
 	/* The Socket and Info pools need to be the same in size. After all,
 	 * each Socket will be associated with at most one Info object. As
@@ -228,7 +263,7 @@ ServerNetworkGameSocketHandler::~ServerNetworkGameSocketHandler()
 	OrderBackup::ResetUser(this->client_id);
 
 	if (this->savegame != nullptr) {
-		this->savegame->Destroy();
+		this->savegame->Detach();
 		this->savegame = nullptr;
 	}
 }
@@ -272,14 +307,11 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::CloseConnection(NetworkRecvSta
 		}
 	}
 
-	/* If we were transfering a map to this client, stop the savegame creation
-	 * process and queue the next client to receive the map. */
+	/* If we were transfering a map to this client, detach from the snapshot;
+	 * when we were the last client the savegame creation is stopped too. */
 	if (this->status == STATUS_MAP) {
-		/* Ensure the saving of the game is stopped too. */
-		this->savegame->Destroy();
+		this->savegame->Detach();
 		this->savegame = nullptr;
-
-		this->CheckNextClientToSendMap(this);
 	}
 
 	NetworkAdminClientError(this->client_id, NETWORK_ERROR_CONNECTION_LOST);
@@ -357,7 +389,7 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendClientInfo(NetworkClientIn
 NetworkRecvStatus ServerNetworkGameSocketHandler::SendGameInfo()
 {
 	Packet *p = new Packet(PACKET_SERVER_GAME_INFO, TCP_MTU);
-	SerializeNetworkGameInfo(p, GetCurrentNetworkServerGameInfo());
+	SerializeCurrentNetworkGameInfo(p);
 
 	this->SendPacket(p);
 
@@ -511,33 +543,6 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendWait()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
-void ServerNetworkGameSocketHandler::CheckNextClientToSendMap(NetworkClientSocket *ignore_cs)
-{
-	/* Find the best candidate for joining, i.e. the first joiner. */
-	NetworkClientSocket *best = nullptr;
-	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-		if (ignore_cs == new_cs) continue;
-
-		if (new_cs->status == STATUS_MAP_WAIT) {
-			if (best == nullptr || best->GetInfo()->join_date > new_cs->GetInfo()->join_date || (best->GetInfo()->join_date == new_cs->GetInfo()->join_date && best->client_id > new_cs->client_id)) {
-				best = new_cs;
-			}
-		}
-	}
-
-	/* Is there someone else to join? */
-	if (best != nullptr) {
-		/* Let the first start joining. */
-		best->status = STATUS_AUTHORIZED;
-		best->SendMap();
-
-		/* And update the rest. */
-		for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-			if (new_cs->status == STATUS_MAP_WAIT) new_cs->SendWait();
-		}
-	}
-}
-
 /** This sends the map to the client */
 NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 {
@@ -547,35 +552,48 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 	}
 
 	if (this->status == STATUS_AUTHORIZED) {
-		this->savegame = new PacketWriter(this);
+		bool fresh = _map_snapshot == nullptr;
+		if (fresh) {
+			/* Nobody is downloading the map; take a new snapshot of the game. */
+			_map_snapshot = new MapSnapshot();
+			NetworkFillSnapshotBacklog(_map_snapshot->command_backlog);
+		}
+
+		this->savegame = _map_snapshot;
+		this->savegame->Attach();
+		this->savegame_offset = 0;
+		this->savegame_size_sent = false;
 
-		/* Now send the _frame_counter and how many packets are coming */
+		/* Now send the frame the snapshot was taken at. */
 		Packet *p = new Packet(PACKET_SERVER_MAP_BEGIN);
-		p->Send_uint32(_frame_counter);
+		p->Send_uint32(this->savegame->frame);
 		this->SendPacket(p);
 
-		NetworkSyncCommandQueue(this);
+		/* Queue the commands the client needs to catch up from the snapshot's frame. */
+		for (const CommandPacket &backlog_cp : this->savegame->command_backlog) {
+			CommandPacket c = backlog_cp;
+			this->outgoing_queue.Append(&c);
+		}
+
 		this->status = STATUS_MAP;
 		/* Mark the start of download */
 		this->last_frame = _frame_counter;
 		this->last_frame_server = _frame_counter;
 
 		/* Make a dump of the current game */
-		if (SaveWithFilter(this->savegame, true) != SL_OK) usererror("network savedump failed");
+		if (fresh && SaveWithFilter(this->savegame, true) != SL_OK) usererror("network savedump failed");
 	}
 
 	if (this->status == STATUS_MAP) {
 		bool last_packet = this->savegame->TransferToNetworkQueue(this);
 		if (last_packet) {
-			/* Done reading, make sure saving is done as well */
-			this->savegame->Destroy();
+			/* Done sending; detach from the snapshot. */
+			this->savegame->Detach();
 			this->savegame = nullptr;
 
 			/* Set the status to DONE_MAP, no we will wait for the client
 			 *  to send it is ready (maybe that happens like never ;)) */
 			this->status = STATUS_DONE_MAP;
-
-			this->CheckNextClientToSendMap();
 		}
 	}
 	return NETWORK_RECV_STATUS_OKAY;
@@ -598,15 +616,32 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendJoin(ClientID client_id)
 /** Tell the client that they may run to a particular frame. */
 NetworkRecvStatus ServerNetworkGameSocketHandler::SendFrame()
 {
+	/* All clients get the same frame counters; serialize them once per frame
+	 * and copy the bytes for every further client. Only the new-token byte at
+	 * the end of the packet differs per client. */
+	static std::vector<byte> payload;
+	static uint32 payload_frame;
+	static uint32 payload_frame_max;
+
 	Packet *p = new Packet(PACKET_SERVER_FRAME);
-	p->Send_uint32(_frame_counter);
-	p->Send_uint32(_frame_counter_max);
+	if (payload.empty() || payload_frame != _frame_counter || payload_frame_max != _frame_counter_max) {
+		p->Send_uint32(_frame_counter);
+		p->Send_uint32(_frame_counter_max);
 #ifdef ENABLE_NETWORK_SYNC_EVERY_FRAME
-	p->Send_uint32(_sync_seed_1);
+		p->Send_uint32(_sync_seed_1);
 #ifdef NETWORK_SEND_DOUBLE_SEED
-	p->Send_uint32(_sync_seed_2);
+		p->Send_uint32(_sync_seed_2);
 #endif
+		p->Send_uint32(_sync_state_checksums.vehicle);
+		p->Send_uint32(_sync_state_checksums.cargo);
+		p->Send_uint32(_sync_state_checksums.town);
 #endif
+		payload = p->GetWrittenData();
+		payload_frame = _frame_counter;
+		payload_frame_max = _frame_counter_max;
+	} else {
+		p->Send_bytes(payload.data(), payload.data() + payload.size());
+	}
 
 	/* If token equals 0, we need to make a new token and send that. */
 	if (this->last_token == 0) {
@@ -621,30 +656,64 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendFrame()
 /** Request the client to sync. */
 NetworkRecvStatus ServerNetworkGameSocketHandler::SendSync()
 {
+	/* The sync packet is identical for all clients; serialize it once per
+	 * frame and copy the bytes for every further client. */
+	static std::vector<byte> payload;
+	static uint32 payload_frame;
+
 	Packet *p = new Packet(PACKET_SERVER_SYNC);
-	p->Send_uint32(_frame_counter);
-	p->Send_uint32(_sync_seed_1);
+	if (payload.empty() || payload_frame != _frame_counter) {
+		p->Send_uint32(_frame_counter);
+		p->Send_uint32(_sync_seed_1);
 
 #ifdef NETWORK_SEND_DOUBLE_SEED
-	p->Send_uint32(_sync_seed_2);
+		p->Send_uint32(_sync_seed_2);
 #endif
+		p->Send_uint32(_sync_state_checksums.vehicle);
+		p->Send_uint32(_sync_state_checksums.cargo);
+		p->Send_uint32(_sync_state_checksums.town);
+		payload = p->GetWrittenData();
+		payload_frame = _frame_counter;
+	} else {
+		p->Send_bytes(payload.data(), payload.data() + payload.size());
+	}
 	this->SendPacket(p);
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
 /**
- * Send a command to the client to execute.
- * @param cp The command to send.
+ * Send a batch of commands to the client to execute.
+ * Commands for the same frame are coalesced into as few packets as
+ * possible, so the frame and the packet overhead are not repeated for
+ * every single command.
+ * @param commands The commands to send, in order of execution.
  */
-NetworkRecvStatus ServerNetworkGameSocketHandler::SendCommand(const CommandPacket *cp)
+NetworkRecvStatus ServerNetworkGameSocketHandler::SendCommands(const std::vector<const CommandPacket *> &commands)
 {
-	Packet *p = new Packet(PACKET_SERVER_COMMAND);
+	Packet *p = nullptr;
+	uint32 frame = 0;
 
-	this->NetworkGameSocketHandler::SendCommand(p, cp);
-	p->Send_uint32(cp->frame);
-	p->Send_bool  (cp->my_cmd);
+	for (const CommandPacket *cp : commands) {
+		/* Upper bound on the size of this command in the packet; the fixed
+		 * fields take 11 bytes and the data buffer is length-prefixed. */
+		size_t estimate = 13 + cp->data.size();
 
-	this->SendPacket(p);
+		if (p != nullptr && (cp->frame != frame || !p->CanWriteToPacket(estimate))) {
+			this->SendPacket(p);
+			p = nullptr;
+		}
+
+		if (p == nullptr) {
+			p = new Packet(PACKET_SERVER_COMMAND);
+			frame = cp->frame;
+			p->Send_uint32(frame);
+		}
+
+		this->NetworkGameSocketHandler::SendCommand(p, cp);
+		p->Send_bool(cp->my_cmd);
+	}
+
+	if (p != nullptr) this->SendPacket(p);
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
@@ -950,16 +1019,9 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_GETMAP(Packet *
 		return this->SendError(NETWORK_ERROR_NOT_AUTHORIZED);
 	}
 
-	/* Check if someone else is receiving the map */
-	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-		if (new_cs->status == STATUS_MAP) {
-			/* Tell the new client to wait */
-			this->status = STATUS_MAP_WAIT;
-			return this->SendWait();
-		}
-	}
-
-	/* We receive a request to upload the map.. give it to the client! */
+	/* We receive a request to upload the map.. give it to the client!
+	 * When others are already downloading, the client simply attaches to
+	 * the snapshot that is being sent to them. */
 	return this->SendMap();
 }
 
@@ -1071,6 +1133,20 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_COMMAND(Packet
 
 	if (GetCommandFlags(cp.cmd) & CMD_CLIENT_ID) NetworkReplaceCommandClientId(cp, this->client_id);
 
+	if (GetCommandFlags(cp.cmd) & CMD_NO_DUPLICATE) {
+		/* A byte-identical command is still awaiting scheduling; executing
+		 * this one too would only make it run, and fail, twice. */
+		for (const CommandPacket *q = this->incoming_queue.Peek(); q != nullptr; q = q->next) {
+			if (q->cmd == cp.cmd && q->company == cp.company && q->tile == cp.tile && q->data == cp.data) return NETWORK_RECV_STATUS_OKAY;
+		}
+	}
+
+	if (this->command_tokens == 0) {
+		IConsolePrint(CC_WARNING, "Kicking client #{} (IP: {}) due to exceeding the command rate limit.", ci->client_id, this->GetClientIP());
+		return this->SendError(NETWORK_ERROR_TOO_MANY_COMMANDS);
+	}
+	this->command_tokens--;
+
 	this->incoming_queue.Append(&cp);
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -1668,10 +1744,18 @@ void NetworkServerSetCompanyPassword(CompanyID company_id, const std::string &pa
  */
 static void NetworkHandleCommandQueue(NetworkClientSocket *cs)
 {
+	std::vector<const CommandPacket *> commands;
+
 	CommandPacket *cp;
 	while ((cp = cs->outgoing_queue.Pop()) != nullptr) {
-		cs->SendCommand(cp);
-		delete cp;
+		commands.push_back(cp);
+	}
+	if (commands.empty()) return;
+
+	cs->SendCommands(commands);
+
+	for (const CommandPacket *c : commands) {
+		delete c;
 	}
 }
 
@@ -1700,6 +1784,12 @@ void NetworkServer_Tick(bool send_frame)
 		cs->receive_limit = std::min<size_t>(cs->receive_limit + _settings_client.network.bytes_per_frame,
 				_settings_client.network.bytes_per_frame_burst);
 
+		/* The same scheme for commands; tokens accumulate up to the burst
+		 * amount so that e.g. drag-building is not hampered, but a client
+		 * cannot keep the server busy testing a steady command flood. */
+		cs->command_tokens = std::min<uint>(cs->command_tokens + _settings_client.network.commands_per_frame,
+				_settings_client.network.commands_per_frame_burst);
+
 		/* Check if the speed of the client is what we can expect from a client */
 		uint lag = NetworkCalculateLag(cs);
 		switch (cs->status) {
@@ -68,8 +68,11 @@ public:
 	ClientStatus status;         ///< Status of this client
 	CommandQueue outgoing_queue; ///< The command-queue awaiting delivery
 	size_t receive_limit;        ///< Amount of bytes that we can receive at this moment
+	uint command_tokens;         ///< Amount of commands that we still accept from this client at this moment
 
-	struct PacketWriter *savegame; ///< Writer used to write the savegame.
+	struct MapSnapshot *savegame;  ///< Snapshot of the game that is being sent to this client.
+	size_t savegame_offset;        ///< Amount of the snapshot that has been queued for sending to this client.
+	bool savegame_size_sent;       ///< Whether the total size of the snapshot has been sent to this client.
 	NetworkAddress client_address; ///< IP-address of the client (so they can be banned)
 
 	ServerNetworkGameSocketHandler(SOCKET s);
@@ -79,8 +82,6 @@ public:
 	NetworkRecvStatus CloseConnection(NetworkRecvStatus status) override;
 	std::string GetClientName() const;
 
-	void CheckNextClientToSendMap(NetworkClientSocket *ignore_cs = nullptr);
-
 	NetworkRecvStatus SendWait();
 	NetworkRecvStatus SendMap();
 	NetworkRecvStatus SendErrorQuit(ClientID client_id, NetworkErrorCode errorno);
@@ -97,7 +98,7 @@ public:
 	NetworkRecvStatus SendJoin(ClientID client_id);
 	NetworkRecvStatus SendFrame();
 	NetworkRecvStatus SendSync();
-	NetworkRecvStatus SendCommand(const CommandPacket *cp);
+	NetworkRecvStatus SendCommands(const std::vector<const CommandPacket *> &commands);
 	NetworkRecvStatus SendCompanyUpdate();
 	NetworkRecvStatus SendConfigUpdate();
 
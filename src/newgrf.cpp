@@ -48,6 +48,8 @@
 #include "language.h"
 #include "vehicle_base.h"
 #include "road.h"
+#include "thread.h"
+#include <atomic>
 
 #include "table/strings.h"
 #include "table/build_industry.h"
@@ -5169,6 +5171,8 @@ static void NewSpriteGroup(ByteReader *buf)
 				}
 			}
 
+			group->CompileAdjusts();
+
 			break;
 		}
 
@@ -8631,6 +8635,9 @@ void ResetNewGRFData()
 	CleanUpStrings();
 	CleanUpGRFTownNames();
 
+	/* The sprite groups the memoised tile resolutions point to are about to be freed. */
+	TileResolutionCache::ClearAll();
+
 	/* Copy/reset original engine info data */
 	SetupEngines();
 
@@ -9067,6 +9074,8 @@ static void FinaliseCargoArray()
 			cs->quantifier = STR_NEWGRF_INVALID_CARGO_QUANTITY;
 			cs->abbrev = STR_NEWGRF_INVALID_CARGO_ABBREV;
 		}
+		/* NewGRFs may have changed the transit day curve parameters. */
+		cs->InitTimeFactors();
 	}
 }
 
@@ -9877,6 +9886,47 @@ void LoadNewGRF(uint load_index, uint num_baseset)
 		if (c->status != GCS_NOT_FOUND) c->status = GCS_UNKNOWN;
 	}
 
+	/* Open and read all NewGRF files up front with a pool of workers. The
+	 * action decoding below stays strictly in load order, but this way the
+	 * file contents are already resident in memory when it runs, instead of
+	 * each file being read on first use one after the other. */
+	{
+		std::vector<std::pair<const GRFConfig *, Subdirectory>> files;
+		uint num_grfs = 0;
+		uint num_non_static = 0;
+		for (const GRFConfig *c = _grfconfig; c != nullptr; c = c->next) {
+			if (c->status == GCS_DISABLED || c->status == GCS_NOT_FOUND) continue;
+
+			/* Mirror the subdirectory/count bookkeeping of the stage loop below. */
+			Subdirectory subdir = num_grfs < num_baseset ? BASESET_DIR : NEWGRF_DIR;
+			if (!FioCheckFileExists(c->filename, subdir)) continue;
+			if (!HasBit(c->flags, GCF_STATIC) && !HasBit(c->flags, GCF_SYSTEM)) {
+				if (num_non_static == NETWORK_MAX_GRF_COUNT) continue;
+				num_non_static++;
+			}
+			num_grfs++;
+
+			files.emplace_back(c, subdir);
+		}
+
+		std::atomic<size_t> next(0);
+		auto worker = [&]() {
+			for (size_t i = next++; i < files.size(); i = next++) {
+				const GRFConfig *c = files[i].first;
+				PreloadCachedSpriteFile(c->filename, files[i].second, c->palette & GRFP_USE_MASK);
+			}
+		};
+
+		uint threads = std::min<uint>(std::thread::hardware_concurrency(), (uint)files.size());
+		std::vector<std::thread> pool;
+		for (uint i = 1; i < threads; i++) {
+			std::thread t;
+			if (StartNewThread(&t, "ottd:grfpreload", decltype(worker)(worker))) pool.push_back(std::move(t));
+		}
+		worker();
+		for (auto &t : pool) t.join();
+	}
+
 	_cur.spriteid = load_index;
 
 	/* Load newgrf sprites
@@ -47,6 +47,10 @@ struct AnimationBase {
 				if (callback >= 0x100 && spec->grf_prop.grffile->grf_version >= 8) ErrorUnknownCallbackResult(spec->grf_prop.grffile->grfid, Tbase::cb_animation_speed, callback);
 				animation_speed = Clamp(callback & 0xFF, 0, 16);
 			}
+		} else {
+			/* The speed is fixed, so the animation loop can skip the ticks this
+			 * tile cannot change frames on instead of getting here to find out. */
+			SetAnimatedTileSpeed(tile, animation_speed);
 		}
 
 		/* An animation speed of 2 means the animation frame changes 4 ticks, and
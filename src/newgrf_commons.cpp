@@ -775,3 +775,69 @@ void NewGRFSpriteLayout::ProcessRegisters(uint8 resolved_var10, uint32 resolved_
 		if (regs != nullptr) regs++;
 	}
 }
+
+/**
+ * Get the list of all tile resolution caches.
+ * @return The list of caches to clear on NewGRF reload.
+ */
+/* static */ std::vector<TileResolutionCache *> &TileResolutionCache::GetCaches()
+{
+	static std::vector<TileResolutionCache *> caches;
+	return caches;
+}
+
+/** Register the cache, so it gets cleared when the NewGRFs are reloaded. */
+TileResolutionCache::TileResolutionCache()
+{
+	GetCaches().push_back(this);
+}
+
+/** Clear all tile resolution caches; the sprite groups they point into are about to be freed. */
+/* static */ void TileResolutionCache::ClearAll()
+{
+	for (TileResolutionCache *cache : GetCaches()) {
+		cache->Clear();
+	}
+}
+
+/**
+ * Look up the memoised resolution for a tile.
+ * @param tile The tile to look up.
+ * @param key Sub-key for features that resolve multiple chains per tile.
+ * @return The memoised sprite group, or \c nullptr if there is none or the tile's map data changed since it was stored.
+ */
+const SpriteGroup *TileResolutionCache::Get(TileIndex tile, uint8 key) const
+{
+	assert(tile < Map::Size());
+
+	std::lock_guard<std::mutex> lock_guard(this->lock);
+	auto it = this->entries.find(MakeKey(tile, key));
+	if (it == this->entries.end()) return nullptr;
+
+	const Entry &e = it->second;
+	if (e.mb.type != _mb[tile].type || e.mb.height != _mb[tile].height) return nullptr;
+	if (e.m.m1 != _m[tile].m1 || e.m.m2 != _m[tile].m2 || e.m.m3 != _m[tile].m3 || e.m.m4 != _m[tile].m4 || e.m.m5 != _m[tile].m5) return nullptr;
+	if (e.me.m6 != _me[tile].m6 || e.me.m7 != _me[tile].m7 || e.me.m8 != _me[tile].m8) return nullptr;
+
+	return e.group;
+}
+
+/**
+ * Memoise the resolution for a tile.
+ * The caller must only store resolutions that read no state besides the
+ * tile's map data; see ResolverObject::stable_result.
+ * @param tile The tile the resolution belongs to.
+ * @param key Sub-key for features that resolve multiple chains per tile.
+ * @param group The sprite group the resolution yielded.
+ */
+void TileResolutionCache::Set(TileIndex tile, uint8 key, const SpriteGroup *group)
+{
+	assert(tile < Map::Size());
+
+	std::lock_guard<std::mutex> lock_guard(this->lock);
+	Entry &e = this->entries[MakeKey(tile, key)];
+	e.mb = _mb[tile];
+	e.m = _m[tile];
+	e.me = _me[tile];
+	e.group = group;
+}
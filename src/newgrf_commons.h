@@ -19,6 +19,11 @@
 #include "command_type.h"
 #include "direction_type.h"
 #include "company_type.h"
+#include "map_type.h"
+#include "tile_type.h"
+
+#include <mutex>
+#include <unordered_map>
 
 /** Context for tile accesses */
 enum TileContext {
@@ -333,4 +338,61 @@ struct GRFFileProps : GRFFilePropsBase<1> {
 	uint16 override;                      ///< id of the entity been replaced by
 };
 
+struct SpriteGroup;
+
+/**
+ * Per-tile cache of resolved sprite groups for immobile structures (houses,
+ * industry tiles, objects, stations), so redrawing an unchanged tile costs a
+ * lookup instead of walking the VarAction2 chain again.
+ *
+ * Each entry is validated against a snapshot of the tile's map words. Anything
+ * that affects the resolution through the map array, like the construction
+ * stage, the animation frame or rerolled random bits, rewrites those words and
+ * thus makes the stale entry miss. Resolutions that read state not covered by
+ * the snapshot must not be stored; see ResolverObject::stable_result.
+ *
+ * All caches are cleared when the NewGRFs, and with them the sprite groups the
+ * entries point to, are reloaded.
+ */
+struct TileResolutionCache {
+	/** A memoised resolution together with the map state it was made in. */
+	struct Entry {
+		TileBase mb;              ///< Snapshot of the tile's type/height data.
+		Tile m;                   ///< Snapshot of the tile's main map data.
+		TileExtended me;          ///< Snapshot of the tile's extended map data.
+		const SpriteGroup *group; ///< The sprite group the resolution yielded.
+	};
+
+	std::unordered_map<uint64, Entry> entries; ///< Entries, keyed by tile and sub-key.
+	mutable std::mutex lock;                   ///< Viewport sprite collection fills the cache from several threads at once.
+
+	TileResolutionCache();
+
+	const SpriteGroup *Get(TileIndex tile, uint8 key = 0) const;
+	void Set(TileIndex tile, uint8 key, const SpriteGroup *group);
+
+	/** Forget all memoised resolutions. */
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock_guard(this->lock);
+		this->entries.clear();
+	}
+
+	static void ClearAll();
+
+private:
+	static std::vector<TileResolutionCache *> &GetCaches();
+
+	/**
+	 * Combine tile and sub-key into the key the entries are stored under.
+	 * @param tile The tile the resolution belongs to.
+	 * @param key Sub-key for features that resolve multiple chains per tile.
+	 * @return Key into #entries.
+	 */
+	static uint64 MakeKey(TileIndex tile, uint8 key)
+	{
+		return (uint64)key << 32 | tile;
+	}
+};
+
 #endif /* NEWGRF_COMMONS_H */
@@ -26,6 +26,9 @@
 
 #include "fileio_func.h"
 #include "fios.h"
+#include "ini_type.h"
+
+#include <map>
 
 #include "safeguards.h"
 
@@ -320,6 +323,104 @@ size_t GRFGetSizeOfDataSection(FILE *f)
 	return SIZE_MAX;
 }
 
+/** Name of the file the md5sums of scanned NewGRFs are cached in. */
+std::string _grf_md5_cache_file;
+
+/** md5sum of a NewGRF, cached together with the fingerprint of the file it was computed from. */
+struct GRFMD5CacheItem {
+	uint64 mtime;     ///< Modification time of the file when the md5sum was computed.
+	uint64 size;      ///< Size of the file when the md5sum was computed.
+	uint8 md5sum[16]; ///< The md5sum of the file.
+	bool seen;        ///< Whether the file was seen during the current scan.
+};
+
+/** Cached md5sums of NewGRFs, keyed by the path the file was found at. */
+static std::map<std::string, GRFMD5CacheItem> _grf_md5_cache;
+/** Whether #_grf_md5_cache has entries that are not written to disk yet. */
+static bool _grf_md5_cache_modified = false;
+
+/**
+ * Convert a hexadecimal string into an md5sum.
+ * @param str The string to convert; must hold 32 hexadecimal characters.
+ * @param[out] md5sum The md5sum to write to.
+ * @return Whether the conversion was successful.
+ */
+static bool StringToMd5sum(const char *str, uint8 md5sum[16])
+{
+	for (uint i = 0; i < 16; i++) {
+		uint8 res = 0;
+		for (uint j = 0; j < 2; j++) {
+			char c = str[i * 2 + j];
+			res <<= 4;
+			if (c >= '0' && c <= '9') {
+				res += c - '0';
+			} else if (c >= 'a' && c <= 'f') {
+				res += c - 'a' + 10;
+			} else {
+				return false;
+			}
+		}
+		md5sum[i] = res;
+	}
+	return true;
+}
+
+/** Load the md5sums cached from the previous NewGRF scan. */
+static void LoadGRFMD5Cache()
+{
+	_grf_md5_cache.clear();
+	_grf_md5_cache_modified = false;
+
+	IniFile ini{};
+	ini.LoadFromDisk(_grf_md5_cache_file, NO_DIRECTORY);
+
+	const IniGroup *group = ini.GetGroup("md5s", false);
+	if (group == nullptr) return;
+
+	for (const IniItem *item = group->item; item != nullptr; item = item->next) {
+		if (!item->value.has_value()) continue;
+
+		/* Each value has the form "<mtime> <size> <md5sum>". */
+		GRFMD5CacheItem cache_item{};
+		char *end;
+		cache_item.mtime = std::strtoull(item->value->c_str(), &end, 10);
+		if (*end != ' ') continue;
+		cache_item.size = std::strtoull(end + 1, &end, 10);
+		if (*end != ' ') continue;
+		if (!StringToMd5sum(end + 1, cache_item.md5sum)) continue;
+
+		_grf_md5_cache[item->name] = cache_item;
+	}
+}
+
+/**
+ * Save the cached md5sums for the next NewGRF scan. Entries for files
+ * that were not seen during the scan are dropped.
+ */
+static void SaveGRFMD5Cache()
+{
+	for (auto it = _grf_md5_cache.begin(); it != _grf_md5_cache.end(); /* nothing */) {
+		if (!it->second.seen) {
+			it = _grf_md5_cache.erase(it);
+			_grf_md5_cache_modified = true;
+		} else {
+			++it;
+		}
+	}
+
+	if (!_grf_md5_cache_modified) return;
+
+	IniFile ini{};
+	IniGroup *group = ini.GetGroup("md5s");
+	for (const auto &pair : _grf_md5_cache) {
+		char md5string[16 * 2 + 1];
+		md5sumToString(md5string, lastof(md5string), pair.second.md5sum);
+		group->GetItem(pair.first, true)->SetValue(fmt::format("{} {} {}", pair.second.mtime, pair.second.size, md5string));
+	}
+
+	if (ini.SaveToDisk(_grf_md5_cache_file)) _grf_md5_cache_modified = false;
+}
+
 /**
  * Calculate the MD5 sum for a GRF, and store it in the config.
  * @param config GRF to compute.
@@ -333,10 +434,27 @@ static bool CalcGRFMD5Sum(GRFConfig *config, Subdirectory subdir)
 	uint8 buffer[1024];
 	size_t len, size;
 
+	/* Files on disk can be fingerprinted by their modification time and size;
+	 * files inside tars have no usable fingerprint and are always hashed. */
+	std::string full_path = FioFindFullPath(subdir, config->filename);
+	uint64 mtime = full_path.empty() ? 0 : FioGetFileModificationTime(full_path);
+
 	/* open the file */
 	f = FioFOpenFile(config->filename, "rb", subdir, &size);
 	if (f == nullptr) return false;
 
+	if (mtime != 0) {
+		auto it = _grf_md5_cache.find(full_path);
+		if (it != _grf_md5_cache.end() && it->second.mtime == mtime && it->second.size == size) {
+			/* The file did not change since it was last hashed; reuse the cached md5sum. */
+			it->second.seen = true;
+			MemCpyT(config->ident.md5sum, it->second.md5sum, lengthof(it->second.md5sum));
+			FioFCloseFile(f);
+			return true;
+		}
+	}
+	uint64 file_size = size;
+
 	long start = ftell(f);
 	size = std::min(size, GRFGetSizeOfDataSection(f));
 
@@ -354,6 +472,15 @@ static bool CalcGRFMD5Sum(GRFConfig *config, Subdirectory subdir)
 
 	FioFCloseFile(f);
 
+	if (mtime != 0) {
+		GRFMD5CacheItem &item = _grf_md5_cache[full_path];
+		item.mtime = mtime;
+		item.size = file_size;
+		MemCpyT(item.md5sum, config->ident.md5sum, lengthof(item.md5sum));
+		item.seen = true;
+		_grf_md5_cache_modified = true;
+	}
+
 	return true;
 }
 
@@ -600,8 +727,13 @@ public:
 			return 0;
 		}
 
+		LoadGRFMD5Cache();
+
 		GRFFileScanner fs;
 		int ret = fs.Scan(".grf", NEWGRF_DIR);
+
+		SaveGRFMD5Cache();
+
 		/* The number scanned and the number returned may not be the same;
 		 * duplicate NewGRFs and base sets are ignored in the return value. */
 		_settings_client.gui.last_newgrf_count = fs.num_scanned;
@@ -23,6 +23,7 @@
 #include "newgrf_railtype.h"
 #include "newgrf_roadtype.h"
 #include "ship.h"
+#include "viewport_func.h"
 
 #include "safeguards.h"
 
@@ -955,6 +956,20 @@ static uint32 VehicleGetVariable(Vehicle *v, const VehicleScopeResolver *object,
 
 /* virtual */ uint32 VehicleScopeResolver::GetVariable(byte variable, uint32 parameter, bool *available) const
 {
+	/* Only these variables are guaranteed to keep their value until the next
+	 * Vehicle::InvalidateNewGRFCache(); reading anything else makes the
+	 * resolution unsuitable for memoisation (see GetCustomEngineSprite). */
+	switch (variable) {
+		case 0x40: case 0x41: case 0x42: case 0x43:
+		case 0x47: case 0x49: case 0x4D:
+		case 0xC4: case 0xC6: case 0xC7: case 0xF2:
+			break;
+
+		default:
+			this->ro.stable_result = false;
+			break;
+	}
+
 	if (this->v == nullptr) {
 		/* Vehicle does not exist, so we're in a purchase list */
 		switch (variable) {
@@ -1000,6 +1015,10 @@ static uint32 VehicleGetVariable(Vehicle *v, const VehicleScopeResolver *object,
 		return nullptr;
 	}
 
+	/* Loading state and cargo load fraction change without any cache
+	 * being invalidated, so a result selected by them cannot be memoised. */
+	if (!group->loading.empty() || group->loaded.size() > 1) this->stable_result = false;
+
 	bool in_motion = !v->First()->current_order.IsType(OT_LOADING);
 
 	uint totalsets = in_motion ? (uint)group->loaded.size() : (uint)group->loading.size();
@@ -1086,9 +1105,24 @@ VehicleResolverObject::VehicleResolverObject(EngineID engine_type, const Vehicle
 
 void GetCustomEngineSprite(EngineID engine, const Vehicle *v, Direction direction, EngineImageType image_type, VehicleSpriteSeq *result)
 {
+	/* Viewport candidates resolve their sprites every tick and the depot
+	 * window resolves every consist it shows on each repaint; reuse the
+	 * previous result as long as the resolution only read inputs that are
+	 * stable until the next Vehicle::InvalidateNewGRFCache(). A vehicle in
+	 * a depot is hidden from viewports, so the two contexts do not evict
+	 * each other from the single memo slot. The memo is skipped entirely
+	 * while viewport collection runs on multiple threads: a vehicle visible
+	 * in two strips would be resolved, and its memo written, concurrently. */
+	bool cacheable = (image_type == EIT_ON_MAP || image_type == EIT_IN_DEPOT) && v != nullptr && !_viewport_collecting_concurrently;
+	if (cacheable && v->sprite_cache.resolved_seq_valid && v->sprite_cache.resolved_direction == direction && v->sprite_cache.resolved_image_type == image_type) {
+		*result = v->sprite_cache.resolved_seq;
+		return;
+	}
+
 	VehicleResolverObject object(engine, v, VehicleResolverObject::WO_CACHED, false, CBID_NO_CALLBACK);
 	result->Clear();
 
+	bool stable = true;
 	bool sprite_stack = HasBit(EngInfo(engine)->misc_flags, EF_SPRITE_STACK);
 	uint max_stack = sprite_stack ? lengthof(result->seq) : 1;
 	for (uint stack = 0; stack < max_stack; ++stack) {
@@ -1096,6 +1130,7 @@ void GetCustomEngineSprite(EngineID engine, const Vehicle *v, Direction directio
 		object.callback_param1 = image_type | (stack << 8);
 		const SpriteGroup *group = object.Resolve();
 		uint32 reg100 = sprite_stack ? GetRegister(0x100) : 0;
+		if (!object.stable_result) stable = false;
 		if (group != nullptr && group->GetNumResults() != 0) {
 			result->seq[result->count].sprite = group->GetResult() + (direction % group->GetNumResults());
 			result->seq[result->count].pal    = GB(reg100, 0, 16); // zero means default recolouring
@@ -1103,6 +1138,13 @@ void GetCustomEngineSprite(EngineID engine, const Vehicle *v, Direction directio
 		}
 		if (!HasBit(reg100, 31)) break;
 	}
+
+	if (cacheable) {
+		v->sprite_cache.resolved_seq = *result;
+		v->sprite_cache.resolved_direction = direction;
+		v->sprite_cache.resolved_image_type = image_type;
+		v->sprite_cache.resolved_seq_valid = stable;
+	}
 }
 
 
@@ -1119,10 +1161,23 @@ void GetRotorOverrideSprite(EngineID engine, const struct Aircraft *v, EngineIma
 	 * We use 'rotor_in_gui' to replicate when the variables differ.
 	 * But some other variables like 'rotor state' and 'rotor speed' are not available in OpenTTD, while they are in TTDPatch. */
 	bool rotor_in_gui = image_type != EIT_ON_MAP;
+	uint rotor_pos = v == nullptr || rotor_in_gui ? 0 : v->Next()->Next()->state;
+
+	/* SetAircraftPosition refreshes the rotor sprite on every movement tick.
+	 * The rotor vehicle's own memo slot is otherwise unused, so reuse the
+	 * previous resolution as long as the rotor position and the resolver
+	 * inputs are unchanged; see GetCustomEngineSprite for the contract,
+	 * including why the memo is skipped during multi-threaded collection. */
+	Vehicle *rotor = v == nullptr || rotor_in_gui || _viewport_collecting_concurrently ? nullptr : v->Next()->Next();
+	if (rotor != nullptr && rotor->sprite_cache.resolved_seq_valid && rotor->sprite_cache.resolved_direction == (Direction)rotor_pos) {
+		*result = rotor->sprite_cache.resolved_seq;
+		return;
+	}
+
 	VehicleResolverObject object(engine, v, VehicleResolverObject::WO_SELF, rotor_in_gui, CBID_NO_CALLBACK);
 	result->Clear();
-	uint rotor_pos = v == nullptr || rotor_in_gui ? 0 : v->Next()->Next()->state;
 
+	bool stable = true;
 	bool sprite_stack = HasBit(e->info.misc_flags, EF_SPRITE_STACK);
 	uint max_stack = sprite_stack ? lengthof(result->seq) : 1;
 	for (uint stack = 0; stack < max_stack; ++stack) {
@@ -1130,6 +1185,7 @@ void GetRotorOverrideSprite(EngineID engine, const struct Aircraft *v, EngineIma
 		object.callback_param1 = image_type | (stack << 8);
 		const SpriteGroup *group = object.Resolve();
 		uint32 reg100 = sprite_stack ? GetRegister(0x100) : 0;
+		if (!object.stable_result) stable = false;
 		if (group != nullptr && group->GetNumResults() != 0) {
 			result->seq[result->count].sprite = group->GetResult() + (rotor_pos % group->GetNumResults());
 			result->seq[result->count].pal    = GB(reg100, 0, 16); // zero means default recolouring
@@ -1137,6 +1193,13 @@ void GetRotorOverrideSprite(EngineID engine, const struct Aircraft *v, EngineIma
 		}
 		if (!HasBit(reg100, 31)) break;
 	}
+
+	if (rotor != nullptr) {
+		rotor->sprite_cache.resolved_seq = *result;
+		rotor->sprite_cache.resolved_direction = (Direction)rotor_pos;
+		rotor->sprite_cache.resolved_image_type = image_type;
+		rotor->sprite_cache.resolved_seq_valid = stable;
+	}
 }
 
 
@@ -150,6 +150,12 @@ void DecreaseBuildingCount(Town *t, HouseID house_id)
 	return this->not_yet_constructed ? 0 : GetHouseTriggers(this->tile);
 }
 
+/* virtual */ bool HouseScopeResolver::HasStableRandomBits() const
+{
+	/* Constructed houses keep their random bits and triggers in the map array. */
+	return !this->not_yet_constructed;
+}
+
 static uint32 GetNumHouses(HouseID house_id, const Town *town)
 {
 	uint8 map_id_count, town_id_count, map_class_count, town_class_count;
@@ -292,6 +298,19 @@ static uint32 GetDistanceFromNearbyHouse(uint8 parameter, TileIndex tile, HouseI
  */
 /* virtual */ uint32 HouseScopeResolver::GetVariable(byte variable, uint32 parameter, bool *available) const
 {
+	/* Only variables derived from the house tile's own map data are covered by
+	 * the map snapshot validating memoised resolutions (see DrawNewHouseTile);
+	 * town state, the terrain type (snow line!), the date driven age and
+	 * nearby-tile queries can all change without this tile changing. */
+	switch (variable) {
+		case 0x40: case 0x46: case 0x47:
+			break;
+
+		default:
+			this->ro.stable_result = false;
+			break;
+	}
+
 	switch (variable) {
 		/* Construction stage. */
 		case 0x40: return (IsTileType(this->tile, MP_HOUSE) ? GetHouseBuildingStage(this->tile) : 0) | TileHash2Bit(TileX(this->tile), TileY(this->tile)) << 2;
@@ -447,6 +466,9 @@ static void DrawTileLayout(const TileInfo *ti, const TileLayoutSpriteGroup *grou
 	DrawNewGRFTileSeq(ti, dts, TO_HOUSES, stage, palette);
 }
 
+/** Memoised resolutions of the house drawing chains; see #TileResolutionCache. */
+static TileResolutionCache _house_resolution_cache;
+
 void DrawNewHouseTile(TileInfo *ti, HouseID house_id)
 {
 	const HouseSpec *hs = HouseSpec::Get(house_id);
@@ -462,9 +484,19 @@ void DrawNewHouseTile(TileInfo *ti, HouseID house_id)
 		if (draw_old_one) DrawFoundation(ti, FOUNDATION_LEVELED);
 	}
 
-	HouseResolverObject object(house_id, ti->tile, Town::GetByTile(ti->tile));
+	const SpriteGroup *group = _house_resolution_cache.Get(ti->tile);
+	if (group == nullptr) {
+		HouseResolverObject object(house_id, ti->tile, Town::GetByTile(ti->tile));
+		group = object.Resolve();
+
+		/* Memoise the result, unless the resolution read state the map snapshot
+		 * does not cover, or the layout reads registers stored during it. */
+		if (object.stable_result && group != nullptr && group->type == SGT_TILELAYOUT &&
+				!((const TileLayoutSpriteGroup *)group)->dts.NeedsPreprocessing()) {
+			_house_resolution_cache.Set(ti->tile, 0, group);
+		}
+	}
 
-	const SpriteGroup *group = object.Resolve();
 	if (group != nullptr && group->type == SGT_TILELAYOUT) {
 		/* Limit the building stage to the number of stages supplied. */
 		const TileLayoutSpriteGroup *tlgroup = (const TileLayoutSpriteGroup *)group;
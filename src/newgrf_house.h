@@ -45,6 +45,7 @@ struct HouseScopeResolver : public ScopeResolver {
 	uint32 GetRandomBits() const override;
 	uint32 GetVariable(byte variable, uint32 parameter, bool *available) const override;
 	uint32 GetTriggers() const override;
+	bool HasStableRandomBits() const override;
 };
 
 /** Resolver object to be used for houses (feature 07 spritegroups). */
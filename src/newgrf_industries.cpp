@@ -157,6 +157,10 @@ static uint32 GetCountAndDistanceOfClosestInstance(byte param_setID, byte layout
 
 /* virtual */ uint32 IndustriesScopeResolver::GetVariable(byte variable, uint32 parameter, bool *available) const
 {
+	/* Industry state (production, counters, persistent storage, ...) changes
+	 * without invalidating the caches memoising industry tile resolutions. */
+	this->ro.stable_result = false;
+
 	if (this->ro.callback == CBID_INDUSTRY_LOCATION) {
 		/* Variables available during construction check. */
 
@@ -477,6 +481,22 @@ IndustriesResolverObject::~IndustriesResolverObject()
 	delete this->town_scope;
 }
 
+/**
+ * Re-target the resolver at another industry of the same type, keeping the
+ * per-type setup such as the GRF file scope and the root sprite group.
+ * @param tile  %Tile owned by the industry.
+ * @param indus %Industry to resolve for.
+ */
+void IndustriesResolverObject::Retarget(TileIndex tile, Industry *indus)
+{
+	assert(indus->type == this->industries_scope.type);
+	this->industries_scope.tile = tile;
+	this->industries_scope.industry = indus;
+	delete this->town_scope;
+	this->town_scope = nullptr;
+	this->ResetState();
+}
+
 /**
  * Get or create the town scope object associated with the industry.
  * @return The associated town scope, if it exists.
@@ -601,9 +621,21 @@ static int32 DerefIndProd(int field, bool use_register)
  */
 void IndustryProductionCallback(Industry *ind, int reason)
 {
-	const IndustrySpec *spec = GetIndustrySpec(ind->type);
 	IndustriesResolverObject object(ind->location.tile, ind, ind->type);
-	if ((spec->behaviour & INDUSTRYBEH_PRODCALLBACK_RANDOM) != 0) object.callback_param1 = Random();
+	IndustryProductionCallback(ind, reason, object);
+}
+
+/**
+ * Get the industry production callback and apply it to the industry, using a
+ * caller-provided resolver so batched callers can reuse the per-type setup.
+ * @param ind    the industry this callback has to be called for
+ * @param reason the reason it is called (0 = incoming cargo, 1 = periodic tick callback)
+ * @param object resolver targeted at \a ind, see IndustriesResolverObject::Retarget
+ */
+void IndustryProductionCallback(Industry *ind, int reason, IndustriesResolverObject &object)
+{
+	const IndustrySpec *spec = GetIndustrySpec(ind->type);
+	object.callback_param1 = ((spec->behaviour & INDUSTRYBEH_PRODCALLBACK_RANDOM) != 0) ? Random() : 0;
 	int multiplier = 1;
 	if ((spec->behaviour & INDUSTRYBEH_PROD_MULTI_HNDLING) != 0) multiplier = ind->prod_level;
 	object.callback_param2 = reason;
@@ -60,6 +60,19 @@ uint32 GetRelativePosition(TileIndex tile, TileIndex ind_tile)
 
 /* virtual */ uint32 IndustryTileScopeResolver::GetVariable(byte variable, uint32 parameter, bool *available) const
 {
+	/* Only variables derived from the industry tile's own map data are covered
+	 * by the map snapshot validating memoised resolutions (see
+	 * DrawNewIndustryTile); the terrain type (snow line!), town zones and
+	 * nearby-tile queries can all change without this tile changing. */
+	switch (variable) {
+		case 0x40: case 0x43: case 0x44:
+			break;
+
+		default:
+			this->ro.stable_result = false;
+			break;
+	}
+
 	switch (variable) {
 		/* Construction state of the tile: a value between 0 and 3 */
 		case 0x40: return (IsTileType(this->tile, MP_INDUSTRY)) ? GetIndustryConstructionStage(this->tile) : 0;
@@ -115,6 +128,12 @@ uint32 GetRelativePosition(TileIndex tile, TileIndex ind_tile)
 	return GetIndustryTriggers(this->tile);
 }
 
+/* virtual */ bool IndustryTileScopeResolver::HasStableRandomBits() const
+{
+	/* The random bits and triggers of built industry tiles live in the map array. */
+	return this->industry != nullptr && this->industry->index != INVALID_INDUSTRY;
+}
+
 /**
  * Get the associated NewGRF file from the industry graphics.
  * @param gfx Graphics to query.
@@ -187,6 +206,9 @@ uint16 GetIndustryTileCallback(CallbackID callback, uint32 param1, uint32 param2
 	return object.ResolveCallback();
 }
 
+/** Memoised resolutions of the industry tile drawing chains; see #TileResolutionCache. */
+static TileResolutionCache _industry_tile_resolution_cache;
+
 bool DrawNewIndustryTile(TileInfo *ti, Industry *i, IndustryGfx gfx, const IndustryTileSpec *inds)
 {
 	if (ti->tileh != SLOPE_FLAT) {
@@ -200,10 +222,18 @@ bool DrawNewIndustryTile(TileInfo *ti, Industry *i, IndustryGfx gfx, const Indus
 		if (draw_old_one) DrawFoundation(ti, FOUNDATION_LEVELED);
 	}
 
-	IndustryTileResolverObject object(gfx, ti->tile, i);
+	const SpriteGroup *group = _industry_tile_resolution_cache.Get(ti->tile);
+	if (group == nullptr) {
+		IndustryTileResolverObject object(gfx, ti->tile, i);
+		group = object.Resolve();
+		if (group == nullptr || group->type != SGT_TILELAYOUT) return false;
 
-	const SpriteGroup *group = object.Resolve();
-	if (group == nullptr || group->type != SGT_TILELAYOUT) return false;
+		/* Memoise the result, unless the resolution read state the map snapshot
+		 * does not cover, or the layout reads registers stored during it. */
+		if (object.stable_result && !((const TileLayoutSpriteGroup *)group)->dts.NeedsPreprocessing()) {
+			_industry_tile_resolution_cache.Set(ti->tile, 0, group);
+		}
+	}
 
 	/* Limit the building stage to the number of stages supplied. */
 	const TileLayoutSpriteGroup *tlgroup = (const TileLayoutSpriteGroup *)group;
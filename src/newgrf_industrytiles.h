@@ -33,6 +33,7 @@ struct IndustryTileScopeResolver : public ScopeResolver {
 	uint32 GetRandomBits() const override;
 	uint32 GetVariable(byte variable, uint32 parameter, bool *available) const override;
 	uint32 GetTriggers() const override;
+	bool HasStableRandomBits() const override;
 };
 
 /** Resolver for industry tiles. */
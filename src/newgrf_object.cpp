@@ -133,6 +133,12 @@ INSTANTIATE_NEWGRF_CLASS_METHODS(ObjectClass, ObjectSpec, ObjectClassID, OBJECT_
 	return IsValidTile(this->tile) && IsTileType(this->tile, MP_OBJECT) ? GetObjectRandomBits(this->tile) : 0;
 }
 
+/* virtual */ bool ObjectScopeResolver::HasStableRandomBits() const
+{
+	/* The random bits of built objects live in the map array. */
+	return this->obj != nullptr;
+}
+
 /**
  * Make an analysis of a tile and get the object type.
  * @param tile TileIndex of the tile to query
@@ -232,6 +238,20 @@ static uint32 GetCountAndDistanceOfClosestInstance(byte local_id, uint32 grfid,
 /** Used by the resolver to get values for feature 0F deterministic spritegroups. */
 /* virtual */ uint32 ObjectScopeResolver::GetVariable(byte variable, uint32 parameter, bool *available) const
 {
+	/* Only variables derived from the object tile's own map data are covered
+	 * by the map snapshot validating memoised resolutions (see
+	 * DrawNewObjectTile); the terrain type (snow line!), the object colour
+	 * (company liveries!), town distances and nearby-tile queries can all
+	 * change without this tile changing. */
+	switch (variable) {
+		case 0x40: case 0x43: case 0x48:
+			break;
+
+		default:
+			this->ro.stable_result = false;
+			break;
+	}
+
 	/* We get the town from the object, or we calculate the closest
 	 * town if we need to when there's no object. */
 	const Town *t = nullptr;
@@ -443,13 +463,25 @@ static void DrawTileLayout(const TileInfo *ti, const TileLayoutSpriteGroup *grou
  * @param ti   Information about the tile to draw on.
  * @param spec Object spec to draw.
  */
+/** Memoised resolutions of the object drawing chains; see #TileResolutionCache. */
+static TileResolutionCache _object_resolution_cache;
+
 void DrawNewObjectTile(TileInfo *ti, const ObjectSpec *spec)
 {
-	Object *o = Object::GetByTile(ti->tile);
-	ObjectResolverObject object(spec, o, ti->tile);
-
-	const SpriteGroup *group = object.Resolve();
-	if (group == nullptr || group->type != SGT_TILELAYOUT) return;
+	const SpriteGroup *group = _object_resolution_cache.Get(ti->tile);
+	if (group == nullptr) {
+		Object *o = Object::GetByTile(ti->tile);
+		ObjectResolverObject object(spec, o, ti->tile);
+
+		group = object.Resolve();
+		if (group == nullptr || group->type != SGT_TILELAYOUT) return;
+
+		/* Memoise the result, unless the resolution read state the map snapshot
+		 * does not cover, or the layout reads registers stored during it. */
+		if (object.stable_result && !((const TileLayoutSpriteGroup *)group)->dts.NeedsPreprocessing()) {
+			_object_resolution_cache.Set(ti->tile, 0, group);
+		}
+	}
 
 	DrawTileLayout(ti, (const TileLayoutSpriteGroup *)group, spec);
 }
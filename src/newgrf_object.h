@@ -124,6 +124,7 @@ struct ObjectScopeResolver : public ScopeResolver {
 
 	uint32 GetRandomBits() const override;
 	uint32 GetVariable(byte variable, uint32 parameter, bool *available) const override;
+	bool HasStableRandomBits() const override;
 };
 
 /** A resolver object to be used with feature 0F spritegroups. */
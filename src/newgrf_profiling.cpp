@@ -16,6 +16,7 @@
 #include "walltime_func.h"
 
 #include <chrono>
+#include <map>
 
 
 std::vector<NewGRFProfiler> _newgrf_profilers;
@@ -107,10 +108,33 @@ uint32 NewGRFProfiler::Finish()
 
 	uint32 total_microseconds = 0;
 
+	/** Accumulated profiling data of one root sprite group. */
+	struct SpriteTotal {
+		uint32 microseconds = 0; ///< Total time spent resolving from this sprite group.
+		uint32 calls = 0;        ///< Number of resolutions started at this sprite group.
+	};
+	std::map<uint32, SpriteTotal> sprite_totals;
+
 	fputs("Tick,Sprite,Feature,Item,CallbackID,Microseconds,Depth,Result\n", f);
 	for (const Call &c : this->calls) {
 		fprintf(f, OTTD_PRINTF64U ",%u,0x%X,%u,0x%X,%u,%u,%u\n", c.tick, c.root_sprite, c.feat, c.item, (uint)c.cb, c.time, c.subs, c.result);
 		total_microseconds += c.time;
+
+		SpriteTotal &st = sprite_totals[c.root_sprite];
+		st.microseconds += c.time;
+		st.calls++;
+	}
+
+	/* Summarize the hottest sprite groups on the console, so the expensive
+	 * chains of a GRF can be identified without processing the output file. */
+	std::vector<std::pair<uint32, SpriteTotal>> hottest(sprite_totals.begin(), sprite_totals.end());
+	std::sort(hottest.begin(), hottest.end(), [](const std::pair<uint32, SpriteTotal> &a, const std::pair<uint32, SpriteTotal> &b) {
+		return a.second.microseconds > b.second.microseconds;
+	});
+
+	IConsolePrint(CC_DEBUG, "Total: {} microseconds over {} calls. Hottest sprite groups:", total_microseconds, this->calls.size());
+	for (size_t i = 0; i < std::min<size_t>(5, hottest.size()); i++) {
+		IConsolePrint(CC_DEBUG, "  Sprite {}: {} microseconds over {} calls.", hottest[i].first, hottest[i].second.microseconds, hottest[i].second.calls);
 	}
 
 	this->Abort();
@@ -18,7 +18,7 @@
 SpriteGroupPool _spritegroup_pool("SpriteGroup");
 INSTANTIATE_POOL_METHODS(SpriteGroup)
 
-TemporaryStorageArray<int32, 0x110> _temp_store;
+thread_local TemporaryStorageArray<int32, 0x110> _temp_store;
 
 
 /**
@@ -62,7 +62,10 @@ static inline uint32 GetVariable(const ResolverObject &object, ScopeResolver *sc
 		case 0x18: return object.callback_param2;
 		case 0x1C: return object.last_value;
 
-		case 0x5F: return (scope->GetRandomBits() << 8) | scope->GetTriggers();
+		case 0x5F:
+			/* Random bits stored outside the map can be rerolled without any cache being invalidated. */
+			if (!scope->HasStableRandomBits()) object.stable_result = false;
+			return (scope->GetRandomBits() << 8) | scope->GetTriggers();
 
 		case 0x7D: return _temp_store.GetValue(parameter);
 
@@ -72,7 +75,11 @@ static inline uint32 GetVariable(const ResolverObject &object, ScopeResolver *sc
 
 		default:
 			/* First handle variables common with Action7/9/D */
-			if (variable < 0x40 && GetGlobalVariable(variable, &value, object.grffile)) return value;
+			if (variable < 0x40 && GetGlobalVariable(variable, &value, object.grffile)) {
+				/* Global state like the date is not tied to any cache invalidation. */
+				object.stable_result = false;
+				return value;
+			}
 			/* Not a common variable, so evaluate the feature specific variables */
 			return scope->GetVariable(variable, parameter, available);
 	}
@@ -96,6 +103,18 @@ static inline uint32 GetVariable(const ResolverObject &object, ScopeResolver *sc
 	return 0;
 }
 
+/**
+ * Whether the random bits and triggers live in storage that is covered by the
+ * caches memoising resolutions for this scope, e.g. the map array for tile
+ * based features. If not, reading them makes the resolution unsuitable for
+ * memoisation, as a retrigger rerolls them without invalidating anything.
+ * @return True when rerolling the random bits also invalidates the caches.
+ */
+/* virtual */ bool ScopeResolver::HasStableRandomBits() const
+{
+	return false;
+}
+
 /**
  * Get a variable value. Default implementation has no available variables.
  * @param variable Variable to read
@@ -142,20 +161,22 @@ static inline uint32 GetVariable(const ResolverObject &object, ScopeResolver *sc
 }
 
 /* Evaluate an adjustment for a variable of the given size.
- * U is the unsigned type and S is the signed type to use. */
-template <typename U, typename S>
+ * U is the unsigned type and S is the signed type to use. The adjust type
+ * and operation are template parameters, so the compiler folds both
+ * switches away and each instantiation is a branch-free evaluator. */
+template <typename U, typename S, DeterministicSpriteGroupAdjustType Ttype, DeterministicSpriteGroupAdjustOperation Top>
 static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, U last_value, uint32 value)
 {
 	value >>= adjust.shift_num;
 	value  &= adjust.and_mask;
 
-	switch (adjust.type) {
+	switch (Ttype) {
 		case DSGA_TYPE_DIV:  value = ((S)value + (S)adjust.add_val) / (S)adjust.divmod_val; break;
 		case DSGA_TYPE_MOD:  value = ((S)value + (S)adjust.add_val) % (S)adjust.divmod_val; break;
 		case DSGA_TYPE_NONE: break;
 	}
 
-	switch (adjust.operation) {
+	switch (Top) {
 		case DSGA_OP_ADD:  return last_value + value;
 		case DSGA_OP_SUB:  return last_value - value;
 		case DSGA_OP_SMIN: return std::min<S>(last_value, value);
@@ -183,6 +204,76 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 	}
 }
 
+/** Thunk with the #EvalAdjustProc signature around the specialised evaluator. */
+template <typename U, typename S, DeterministicSpriteGroupAdjustType Ttype, DeterministicSpriteGroupAdjustOperation Top>
+static uint32 EvalAdjustThunk(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, uint32 last_value, uint32 value)
+{
+	return EvalAdjustT<U, S, Ttype, Top>(adjust, scope, (U)last_value, value);
+}
+
+/** Select the evaluator instantiation for the given operation. */
+template <typename U, typename S, DeterministicSpriteGroupAdjustType Ttype>
+static EvalAdjustProc *SelectEvalAdjustProc(DeterministicSpriteGroupAdjustOperation operation)
+{
+	switch (operation) {
+		case DSGA_OP_ADD:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_ADD>;
+		case DSGA_OP_SUB:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_SUB>;
+		case DSGA_OP_SMIN: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_SMIN>;
+		case DSGA_OP_SMAX: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_SMAX>;
+		case DSGA_OP_UMIN: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_UMIN>;
+		case DSGA_OP_UMAX: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_UMAX>;
+		case DSGA_OP_SDIV: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_SDIV>;
+		case DSGA_OP_SMOD: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_SMOD>;
+		case DSGA_OP_UDIV: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_UDIV>;
+		case DSGA_OP_UMOD: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_UMOD>;
+		case DSGA_OP_MUL:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_MUL>;
+		case DSGA_OP_AND:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_AND>;
+		case DSGA_OP_OR:   return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_OR>;
+		case DSGA_OP_XOR:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_XOR>;
+		case DSGA_OP_STO:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_STO>;
+		case DSGA_OP_RST:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_RST>;
+		case DSGA_OP_STOP: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_STOP>;
+		case DSGA_OP_ROR:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_ROR>;
+		case DSGA_OP_SCMP: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_SCMP>;
+		case DSGA_OP_UCMP: return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_UCMP>;
+		case DSGA_OP_SHL:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_SHL>;
+		case DSGA_OP_SHR:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_SHR>;
+		case DSGA_OP_SAR:  return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_SAR>;
+		/* Unknown operations return the value unmodified, same as DSGA_OP_RST. */
+		default:           return &EvalAdjustThunk<U, S, Ttype, DSGA_OP_RST>;
+	}
+}
+
+/** Select the evaluator instantiation for the given adjust type and operation. */
+template <typename U, typename S>
+static EvalAdjustProc *SelectEvalAdjustProc(DeterministicSpriteGroupAdjustType type, DeterministicSpriteGroupAdjustOperation operation)
+{
+	switch (type) {
+		case DSGA_TYPE_DIV: return SelectEvalAdjustProc<U, S, DSGA_TYPE_DIV>(operation);
+		case DSGA_TYPE_MOD: return SelectEvalAdjustProc<U, S, DSGA_TYPE_MOD>(operation);
+		default:            return SelectEvalAdjustProc<U, S, DSGA_TYPE_NONE>(operation);
+	}
+}
+
+/**
+ * Pre-select the evaluator of every adjustment of this group, specialised
+ * for the group's operand size and the adjustment's type and operation.
+ * Resolve() then runs the chain as threaded code: one indirect call per
+ * adjustment instead of three switch dispatches.
+ * To be called once the adjustments are completely loaded.
+ */
+void DeterministicSpriteGroup::CompileAdjusts()
+{
+	for (auto &adjust : this->adjusts) {
+		switch (this->size) {
+			case DSG_SIZE_BYTE:  adjust.eval_proc = SelectEvalAdjustProc<uint8,  int8> (adjust.type, adjust.operation); break;
+			case DSG_SIZE_WORD:  adjust.eval_proc = SelectEvalAdjustProc<uint16, int16>(adjust.type, adjust.operation); break;
+			case DSG_SIZE_DWORD: adjust.eval_proc = SelectEvalAdjustProc<uint32, int32>(adjust.type, adjust.operation); break;
+			default: NOT_REACHED();
+		}
+	}
+}
+
 
 static bool RangeHighComparator(const DeterministicSpriteGroupRange& range, uint32 value)
 {
@@ -220,12 +311,7 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 			return SpriteGroup::Resolve(this->error_group, object, false);
 		}
 
-		switch (this->size) {
-			case DSG_SIZE_BYTE:  value = EvalAdjustT<uint8,  int8> (adjust, scope, last_value, value); break;
-			case DSG_SIZE_WORD:  value = EvalAdjustT<uint16, int16>(adjust, scope, last_value, value); break;
-			case DSG_SIZE_DWORD: value = EvalAdjustT<uint32, int32>(adjust, scope, last_value, value); break;
-			default: NOT_REACHED();
-		}
+		value = adjust.eval_proc(adjust, scope, last_value, value);
 		last_value = value;
 	}
 
@@ -271,6 +357,10 @@ const SpriteGroup *RandomizedSpriteGroup::Resolve(ResolverObject &object) const
 		}
 	}
 
+	/* The selected group changes whenever the randomisation is retriggered;
+	 * only scopes whose random bits are covered by the caches may memoise it. */
+	if (!scope->HasStableRandomBits()) object.stable_result = false;
+
 	uint32 mask = ((uint)this->groups.size() - 1) << this->lowest_randbit;
 	byte index = (scope->GetRandomBits() & mask) >> this->lowest_randbit;
 
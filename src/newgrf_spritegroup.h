@@ -28,7 +28,7 @@
  */
 static inline uint32 GetRegister(uint i)
 {
-	extern TemporaryStorageArray<int32, 0x110> _temp_store;
+	extern thread_local TemporaryStorageArray<int32, 0x110> _temp_store;
 	return _temp_store.GetValue(i);
 }
 
@@ -46,6 +46,7 @@ enum SpriteGroupType {
 struct SpriteGroup;
 typedef uint32 SpriteGroupID;
 struct ResolverObject;
+struct ScopeResolver;
 
 /* SPRITE_WIDTH is 24. ECS has roughly 30 sprite groups per real sprite.
  * Adding an 'extra' margin would be assuming 64 sprite groups per real
@@ -144,6 +145,16 @@ enum DeterministicSpriteGroupAdjustOperation {
 };
 
 
+struct DeterministicSpriteGroupAdjust;
+
+/**
+ * Evaluator for a single adjustment, specialised at GRF load for the
+ * operand size, adjust type and operation of the adjustment, so the
+ * interpreter loop in DeterministicSpriteGroup::Resolve() is free of
+ * per-adjustment switches.
+ */
+typedef uint32 EvalAdjustProc(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, uint32 last_value, uint32 value);
+
 struct DeterministicSpriteGroupAdjust {
 	DeterministicSpriteGroupAdjustOperation operation;
 	DeterministicSpriteGroupAdjustType type;
@@ -154,6 +165,7 @@ struct DeterministicSpriteGroupAdjust {
 	uint32 add_val;
 	uint32 divmod_val;
 	const SpriteGroup *subroutine;
+	EvalAdjustProc *eval_proc; ///< Specialised evaluator; set by DeterministicSpriteGroup::CompileAdjusts().
 };
 
 
@@ -178,6 +190,8 @@ struct DeterministicSpriteGroup : SpriteGroup {
 
 	const SpriteGroup *error_group; // was first range, before sorting ranges
 
+	void CompileAdjusts();
+
 protected:
 	const SpriteGroup *Resolve(ResolverObject &object) const;
 };
@@ -293,6 +307,7 @@ struct ScopeResolver {
 
 	virtual uint32 GetRandomBits() const;
 	virtual uint32 GetTriggers() const;
+	virtual bool HasStableRandomBits() const;
 
 	virtual uint32 GetVariable(byte variable, uint32 parameter, bool *available) const;
 	virtual void StorePSA(uint reg, int32 value);
@@ -335,6 +350,8 @@ struct ResolverObject {
 	const GRFFile *grffile;     ///< GRFFile the resolved SpriteGroup belongs to
 	const SpriteGroup *root_spritegroup; ///< Root SpriteGroup to use for resolving
 
+	mutable bool stable_result; ///< Whether the resolution only read inputs that are stable between invalidations of the NewGRF caches; allows callers to memoise the result.
+
 	/**
 	 * Resolve SpriteGroup.
 	 * @return Result spritegroup.
@@ -389,6 +406,7 @@ struct ResolverObject {
 		this->last_value = 0;
 		this->waiting_triggers = 0;
 		this->used_triggers = 0;
+		this->stable_result = true;
 		memset(this->reseed, 0, sizeof(this->reseed));
 	}
 
@@ -270,6 +270,13 @@ TownScopeResolver *StationResolverObject::GetTown()
 
 /* virtual */ uint32 StationScopeResolver::GetVariable(byte variable, uint32 parameter, bool *available) const
 {
+	/* Only the PBS state (0x44) and the animation frame (0x4A) are read purely
+	 * from this station tile's own map data; the platform layout, cargo state,
+	 * owner colours, terrain type and nearby-tile queries can all change
+	 * without this tile changing, so they are not covered by the map snapshot
+	 * validating memoised resolutions (see GetCustomStationRelocation). */
+	if (this->st == nullptr || (variable != 0x44 && variable != 0x4A)) this->ro.stable_result = false;
+
 	if (this->st == nullptr) {
 		/* Station does not exist, so we're in a purchase list or the land slope check callback. */
 		switch (variable) {
@@ -498,6 +505,10 @@ uint32 Waypoint::GetNewGRFVariable(const ResolverObject &object, byte variable,
 		return group->loading[0];
 	}
 
+	/* The choice below depends on the amount of cargo at the station, which
+	 * changes without any cache being invalidated. */
+	this->stable_result = false;
+
 	uint cargo = 0;
 	const Station *st = Station::From(this->station_scope.st);
 
@@ -573,8 +584,13 @@ StationResolverObject::StationResolverObject(const StationSpec *statspec, BaseSt
 		const Station *st = Station::From(this->station_scope.st);
 		/* Pick the first cargo that we have waiting */
 		for (const CargoSpec *cs : CargoSpec::Iterate()) {
-			if (this->station_scope.statspec->grf_prop.spritegroup[cs->Index()] != nullptr &&
-					st->goods[cs->Index()].cargo.TotalCount() > 0) {
+			if (this->station_scope.statspec->grf_prop.spritegroup[cs->Index()] == nullptr) continue;
+
+			/* The root group choice varies with the cargo waiting at the station,
+			 * so the result cannot be memoised. */
+			this->stable_result = false;
+
+			if (st->goods[cs->Index()].cargo.TotalCount() > 0) {
 				ctype = cs->Index();
 				break;
 			}
@@ -603,11 +619,35 @@ StationResolverObject::~StationResolverObject()
  * @param var10 Value to put in variable 10; normally 0; 1 when resolving the groundsprite and SSF_SEPARATE_GROUND is set.
  * @return First sprite of the Action 1 spriteset to use, minus an offset of 0x42D to accommodate for weird NewGRF specs.
  */
+/** Memoised resolutions of the station drawing chains; see #TileResolutionCache. */
+static TileResolutionCache _station_resolution_cache;
+
 SpriteID GetCustomStationRelocation(const StationSpec *statspec, BaseStation *st, TileIndex tile, uint32 var10)
 {
+	/* The result may only be memoised when drawing skips the register
+	 * preprocessing step; specs with layouts that consume registers stored
+	 * during the resolution must be resolved anew every time (see DrawTile_Station). */
+	bool cacheable = st != nullptr && tile != INVALID_TILE;
+	if (cacheable) {
+		for (const NewGRFSpriteLayout &layout : statspec->renderdata) {
+			if (layout.NeedsPreprocessing()) {
+				cacheable = false;
+				break;
+			}
+		}
+	}
+
+	if (cacheable) {
+		const SpriteGroup *cached = _station_resolution_cache.Get(tile, (uint8)var10);
+		if (cached != nullptr) return cached->GetResult() - 0x42D;
+	}
+
 	StationResolverObject object(statspec, st, tile, CBID_NO_CALLBACK, var10);
 	const SpriteGroup *group = object.Resolve();
 	if (group == nullptr || group->type != SGT_RESULT) return 0;
+
+	if (cacheable && object.stable_result) _station_resolution_cache.Set(tile, (uint8)var10, group);
+
 	return group->GetResult() - 0x42D;
 }
 
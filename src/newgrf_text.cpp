@@ -72,6 +72,7 @@ struct GRFTextEntry {
 	uint16 stringid;
 	StringID def_string;
 	GRFTextList textholder;
+	const char *cached_text; ///< The text resolved for the current language, or nullptr if not resolved yet.
 };
 
 
@@ -589,6 +590,9 @@ StringID AddGRFString(uint32 grfid, uint16 stringid, byte langid_to_add, bool ne
 		_grf_text[id].def_string = def_string;
 	}
 	AddGRFTextToList(_grf_text[id].textholder, langid_to_add, newtext);
+	/* Appending to the list may reallocate it and move the strings it holds,
+	 * so a previously resolved pointer into it is no longer valid. */
+	_grf_text[id].cached_text = nullptr;
 
 	grfmsg(3, "Added 0x%X: grfid %08X string 0x%X lang 0x%X string '%s' (%X)", id, grfid, stringid, langid_to_add, newtext.c_str(), MakeStringID(TEXT_TAB_NEWGRF_START, id));
 
@@ -654,11 +658,19 @@ const char *GetGRFStringPtr(uint16 stringid)
 {
 	assert(_grf_text[stringid].grfid != 0);
 
-	const char *str = GetGRFStringFromGRFText(_grf_text[stringid].textholder);
+	/* The language selection does not change between draws, so resolve it
+	 * once and reuse the result until the language or the texts change. */
+	const char *str = _grf_text[stringid].cached_text;
 	if (str != nullptr) return str;
 
-	/* Use the default string ID if the fallback string isn't available */
-	return GetStringPtr(_grf_text[stringid].def_string);
+	str = GetGRFStringFromGRFText(_grf_text[stringid].textholder);
+	if (str == nullptr) {
+		/* Use the default string ID if the fallback string isn't available */
+		str = GetStringPtr(_grf_text[stringid].def_string);
+	}
+
+	_grf_text[stringid].cached_text = str;
+	return str;
 }
 
 /**
@@ -672,6 +684,12 @@ const char *GetGRFStringPtr(uint16 stringid)
 void SetCurrentGrfLangID(byte language_id)
 {
 	_currentLangID = language_id;
+
+	/* The language (or the language pack backing the default strings) changed,
+	 * so the resolved strings have to be looked up again. */
+	for (uint id = 0; id < _num_grf_texts; id++) {
+		_grf_text[id].cached_text = nullptr;
+	}
 }
 
 bool CheckGrfLangID(byte lang_id, byte grf_version)
@@ -697,8 +715,9 @@ void CleanUpStrings()
 	uint id;
 
 	for (id = 0; id < _num_grf_texts; id++) {
-		_grf_text[id].grfid      = 0;
-		_grf_text[id].stringid   = 0;
+		_grf_text[id].grfid       = 0;
+		_grf_text[id].stringid    = 0;
+		_grf_text[id].cached_text = nullptr;
 		_grf_text[id].textholder.clear();
 	}
 
@@ -820,7 +839,7 @@ void RestoreTextRefStackBackup(struct TextRefStack *backup)
  */
 void StartTextRefStackUsage(const GRFFile *grffile, byte numEntries, const uint32 *values)
 {
-	extern TemporaryStorageArray<int32, 0x110> _temp_store;
+	extern thread_local TemporaryStorageArray<int32, 0x110> _temp_store;
 
 	_newgrf_textrefstack.ResetStack(grffile);
 
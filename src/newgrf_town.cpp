@@ -16,6 +16,10 @@
 
 /* virtual */ uint32 TownScopeResolver::GetVariable(byte variable, uint32 parameter, bool *available) const
 {
+	/* Town state changes without invalidating any of the caches memoising
+	 * resolutions of the child features (houses, stations, objects). */
+	this->ro.stable_result = false;
+
 	switch (variable) {
 		/* Larger towns */
 		case 0x40:
@@ -39,6 +39,8 @@
 
 #include "widgets/news_widget.h"
 
+#include <map>
+
 #include "table/strings.h"
 
 #include "safeguards.h"
@@ -62,6 +64,61 @@ static const NewsItem *_forced_news = nullptr;
 /** Current news item (last item shown regularly). */
 static const NewsItem *_current_news = nullptr;
 
+/**
+ * Index of the news items by referenced object, over both references of each
+ * item. Deleting the news about a removed vehicle, station or industry would
+ * otherwise walk the whole queue for every removed object.
+ */
+static std::multimap<std::pair<NewsReferenceType, uint32>, NewsItem *> _news_by_reference;
+
+/** Whether the message history window still has to be invalidated for queue changes of this tick. */
+static bool _news_history_dirty = false;
+
+/** Add the references of a news item to the reference index. */
+static void IndexNewsReferences(NewsItem *ni)
+{
+	if (ni->reftype1 != NR_NONE) _news_by_reference.emplace(std::make_pair(ni->reftype1, ni->ref1), ni);
+	if (ni->reftype2 != NR_NONE) _news_by_reference.emplace(std::make_pair(ni->reftype2, ni->ref2), ni);
+}
+
+/** Remove one reference of a news item from the reference index. */
+static void UnindexNewsReference(NewsReferenceType reftype, uint32 ref, const NewsItem *ni)
+{
+	if (reftype == NR_NONE) return;
+	auto range = _news_by_reference.equal_range({reftype, ref});
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second == ni) {
+			_news_by_reference.erase(it);
+			return;
+		}
+	}
+}
+
+/**
+ * Collect the news items referencing an object.
+ * @param reftype The type of the referenced object.
+ * @param ref     The referenced object.
+ * @return The news items with a matching reference, in queue order.
+ */
+static std::vector<NewsItem *> FindNewsByReference(NewsReferenceType reftype, uint32 ref)
+{
+	std::vector<NewsItem *> result;
+	auto range = _news_by_reference.equal_range({reftype, ref});
+	for (auto it = range.first; it != range.second; ++it) result.push_back(it->second);
+	/* An item referencing the same object twice is indexed twice; its two
+	 * entries are adjacent, as they were inserted together. */
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+	return result;
+}
+
+/** Invalidate the message history window, at most once per tick. */
+static void FlushNewsHistoryInvalidation()
+{
+	if (!_news_history_dirty) return;
+	_news_history_dirty = false;
+	SetWindowDirty(WC_MESSAGE_HISTORY, 0);
+}
+
 
 /**
  * Get the position a news-reference is referencing.
@@ -645,6 +702,8 @@ void InitNewsItemStructs()
 	_forced_news = nullptr;
 	_current_news = nullptr;
 	_statusbar_news_item = nullptr;
+	_news_by_reference.clear();
+	_news_history_dirty = false;
 	NewsWindow::duration = 0;
 }
 
@@ -763,6 +822,9 @@ static void DeleteNewsItem(NewsItem *ni)
 		_latest_news = ni->prev;
 	}
 
+	UnindexNewsReference(ni->reftype1, ni->ref1, ni);
+	UnindexNewsReference(ni->reftype2, ni->ref2, ni);
+
 	_total_news--;
 
 	if (_forced_news == ni || _current_news == ni) {
@@ -787,7 +849,7 @@ static void DeleteNewsItem(NewsItem *ni)
 
 	delete ni;
 
-	SetWindowDirty(WC_MESSAGE_HISTORY, 0);
+	_news_history_dirty = true;
 }
 
 /**
@@ -844,12 +906,14 @@ void AddNewsItem(StringID string, NewsType type, NewsFlag flags, NewsReferenceTy
 	ni->next = nullptr;
 	_latest_news = ni;
 
+	IndexNewsReferences(ni);
+
 	/* Keep the number of stored news items to a managable number */
 	if (_total_news > MAX_NEWS_AMOUNT) {
 		DeleteNewsItem(_oldest_news);
 	}
 
-	SetWindowDirty(WC_MESSAGE_HISTORY, 0);
+	_news_history_dirty = true;
 }
 
 /**
@@ -918,15 +982,8 @@ CommandCost CmdCustomNewsItem(DoCommandFlag flags, NewsType type, NewsReferenceT
  */
 void DeleteVehicleNews(VehicleID vid, StringID news)
 {
-	NewsItem *ni = _oldest_news;
-
-	while (ni != nullptr) {
-		NewsItem *next = ni->next;
-		if (((ni->reftype1 == NR_VEHICLE && ni->ref1 == vid) || (ni->reftype2 == NR_VEHICLE && ni->ref2 == vid)) &&
-				(news == INVALID_STRING_ID || ni->string_id == news)) {
-			DeleteNewsItem(ni);
-		}
-		ni = next;
+	for (NewsItem *ni : FindNewsByReference(NR_VEHICLE, vid)) {
+		if (news == INVALID_STRING_ID || ni->string_id == news) DeleteNewsItem(ni);
 	}
 }
 
@@ -937,15 +994,7 @@ void DeleteVehicleNews(VehicleID vid, StringID news)
  */
 void DeleteStationNews(StationID sid)
 {
-	NewsItem *ni = _oldest_news;
-
-	while (ni != nullptr) {
-		NewsItem *next = ni->next;
-		if ((ni->reftype1 == NR_STATION && ni->ref1 == sid) || (ni->reftype2 == NR_STATION && ni->ref2 == sid)) {
-			DeleteNewsItem(ni);
-		}
-		ni = next;
-	}
+	for (NewsItem *ni : FindNewsByReference(NR_STATION, sid)) DeleteNewsItem(ni);
 }
 
 /**
@@ -954,15 +1003,7 @@ void DeleteStationNews(StationID sid)
  */
 void DeleteIndustryNews(IndustryID iid)
 {
-	NewsItem *ni = _oldest_news;
-
-	while (ni != nullptr) {
-		NewsItem *next = ni->next;
-		if ((ni->reftype1 == NR_INDUSTRY && ni->ref1 == iid) || (ni->reftype2 == NR_INDUSTRY && ni->ref2 == iid)) {
-			DeleteNewsItem(ni);
-		}
-		ni = next;
-	}
+	for (NewsItem *ni : FindNewsByReference(NR_INDUSTRY, iid)) DeleteNewsItem(ni);
 }
 
 /**
@@ -999,15 +1040,29 @@ static void RemoveOldNewsItems()
  */
 void ChangeVehicleNews(VehicleID from_index, VehicleID to_index)
 {
+	for (NewsItem *ni : FindNewsByReference(NR_VEHICLE, from_index)) {
+		if (ni->reftype1 == NR_VEHICLE && ni->ref1 == from_index) {
+			UnindexNewsReference(NR_VEHICLE, from_index, ni);
+			ni->ref1 = to_index;
+			_news_by_reference.emplace(std::make_pair(NR_VEHICLE, to_index), ni);
+		}
+		if (ni->reftype2 == NR_VEHICLE && ni->ref2 == from_index) {
+			UnindexNewsReference(NR_VEHICLE, from_index, ni);
+			ni->ref2 = to_index;
+			_news_by_reference.emplace(std::make_pair(NR_VEHICLE, to_index), ni);
+		}
+	}
+
 	for (NewsItem *ni = _oldest_news; ni != nullptr; ni = ni->next) {
-		if (ni->reftype1 == NR_VEHICLE && ni->ref1 == from_index) ni->ref1 = to_index;
-		if (ni->reftype2 == NR_VEHICLE && ni->ref2 == from_index) ni->ref2 = to_index;
 		if (ni->flags & NF_VEHICLE_PARAM0 && ni->params[0] == from_index) ni->params[0] = to_index;
 	}
 }
 
 void NewsLoop()
 {
+	/* Queue changes of this tick are pushed to the history window in one go. */
+	FlushNewsHistoryInvalidation();
+
 	/* no news item yet */
 	if (_total_news == 0) return;
 
@@ -132,6 +132,9 @@ void BuildObject(ObjectType type, TileIndex tile, CompanyID owner, Town *town, u
 
 	Object::IncTypeCount(type);
 	if (spec->flags & OBJECT_FLAG_ANIMATION) TriggerObjectAnimation(o, OAT_BUILT, spec);
+
+	/* The company headquarters is the only object accepting cargo. */
+	if (type == OBJECT_HQ) MarkStationAcceptanceDirtyAround(ta);
 }
 
 /**
@@ -167,9 +170,14 @@ void UpdateCompanyHQ(TileIndex tile, uint score)
 	if (score >= 520) val++;
 	if (score >= 720) val++;
 
+	if (GetCompanyHQSize(tile) >= val) return;
+
 	while (GetCompanyHQSize(tile) < val) {
 		IncreaseCompanyHQSize(tile);
 	}
+
+	/* The headquarters' acceptance depends on its size. */
+	MarkStationAcceptanceDirtyAround(Object::GetByTile(tile)->location);
 }
 
 /**
@@ -509,6 +517,8 @@ static Foundation GetFoundation_Object(TileIndex tile, Slope tileh)
  */
 static void ReallyClearObjectTile(Object *o)
 {
+	if (o->type == OBJECT_HQ) MarkStationAcceptanceDirtyAround(o->location);
+
 	Object::DecTypeCount(o->type);
 	for (TileIndex tile_cur : o->location) {
 		DeleteNewGRFInspectWindow(GSF_OBJECTS, tile_cur);
@@ -14,6 +14,7 @@
 #include "music/music_driver.hpp"
 #include "video/video_driver.hpp"
 #include "mixer.h"
+#include "jobpool.h"
 
 #include "fontcache.h"
 #include "error.h"
@@ -65,6 +66,7 @@
 #include "viewport_func.h"
 #include "viewport_sprite_sorter.h"
 #include "framerate_type.h"
+#include "state_checksum.h"
 #include "industry.h"
 #include "network/network_gui.h"
 #include "misc_cmd.h"
@@ -330,12 +332,16 @@ static void ShutdownGame()
 	GamelogReset();
 
 	LinkGraphSchedule::Clear();
+	StopJobPool();
 	PoolBase::Clean(PT_ALL);
 
 	/* No NewGRFs were loaded when it was still bootstrapping. */
 	if (_game_mode != GM_BOOTSTRAP) ResetNewGRFData();
 
 	UninitFontCache();
+
+	/* Drain the pending debug output; anything printed later is written synchronously. */
+	DebugStopWriterThread();
 }
 
 /**
@@ -693,6 +699,10 @@ int openttd_main(int argc, char *argv[])
 
 	LoadFromConfig(true);
 
+	/* From here on debug output is written by a background thread, so the
+	 * (game) threads do not stall on terminal or log file writes. */
+	DebugStartWriterThread();
+
 	if (resolution.width != 0) _cur_resolution = resolution;
 
 	/* Limit width times height times bytes per pixel to fit a 32 bit
@@ -819,6 +829,7 @@ int openttd_main(int argc, char *argv[])
 	VideoDriver::GetInstance()->MainLoop();
 
 	WaitTillSaved();
+	WaitTillScreenshotTaken();
 
 	/* only save config if we have to */
 	if (_save_config) {
@@ -1004,6 +1015,9 @@ bool SafeLoad(const std::string &filename, SaveLoadOperation fop, DetailedFileTy
 
 void SwitchToMode(SwitchMode new_mode)
 {
+	/* Finish a pending world screenshot before the map it renders goes away. */
+	WaitTillScreenshotTaken();
+
 	/* If we are saving something, the network stays in its current state */
 	if (new_mode != SM_SAVE_GAME) {
 		/* If the network is active, make it not-active */
@@ -1393,11 +1407,13 @@ void StateGameLoop()
 		Backup<CompanyID> cur_company(_current_company, OWNER_NONE, FILE_LINE);
 
 		BasePersistentStorageArray::SwitchMode(PSM_ENTER_GAMELOOP);
+		_state_checksums.active = true;
 		AnimateAnimatedTiles();
 		IncreaseDate();
 		RunTileLoop();
 		CallVehicleTicks();
 		CallLandscapeTick();
+		_state_checksums.active = false;
 		BasePersistentStorageArray::SwitchMode(PSM_LEAVE_GAMELOOP);
 
 #ifndef DEBUG_DUMP_COMMANDS
@@ -1461,6 +1477,7 @@ void GameLoop()
 	}
 
 	ProcessAsyncSaveFinish();
+	ProcessAsyncScreenshot();
 
 	/* autosave game? */
 	if (_do_autosave) {
@@ -55,10 +55,13 @@ private:
 	uint16 travel_time;  ///< How long in ticks the journey to this destination should take.
 	uint16 max_speed;    ///< How fast the vehicle may go on the way to the destination.
 
+	mutable TileIndex cached_location;         ///< NOSAVE: Resolved destination tile, shared by all vehicles of the order list.
+	mutable uint64 cached_location_generation; ///< NOSAVE: Generation #cached_location was resolved at; 0 if never resolved.
+
 public:
 	Order *next;          ///< Pointer to next order. If nullptr, end of list
 
-	Order() : flags(0), refit_cargo(CT_NO_REFIT), wait_time(0), travel_time(0), max_speed(UINT16_MAX) {}
+	Order() : flags(0), refit_cargo(CT_NO_REFIT), wait_time(0), travel_time(0), max_speed(UINT16_MAX), cached_location_generation(0) {}
 	~Order();
 
 	Order(uint32 packed);
@@ -108,7 +111,7 @@ public:
 	 * @param destination the new destination of the order.
 	 * @pre IsType(OT_GOTO_WAYPOINT) || IsType(OT_GOTO_DEPOT) || IsType(OT_GOTO_STATION).
 	 */
-	inline void SetDestination(DestinationID destination) { this->dest = destination; }
+	inline void SetDestination(DestinationID destination) { this->dest = destination; this->cached_location_generation = 0; }
 
 	/**
 	 * Is this order a refit order.
@@ -273,11 +276,24 @@ private:
 	Ticks timetable_duration;         ///< NOSAVE: Total timetabled duration of the order list.
 	Ticks total_duration;             ///< NOSAVE: Total (timetabled or not) duration of the order list.
 
+	mutable Order *cached_order;                ///< NOSAVE: Cursor into the order chain to speed up successive #GetOrderAt calls.
+	mutable VehicleOrderID cached_order_index;  ///< NOSAVE: Index of #cached_order within the chain.
+	mutable VehicleOrderID first_manual_order;  ///< NOSAVE: Index of the first manual order; INVALID_VEH_ORDER_ID if not yet computed.
+
+	/** Invalidate the cached positions within the order chain after the chain has changed. */
+	inline void InvalidateOrderCache()
+	{
+		this->cached_order = nullptr;
+		this->cached_order_index = INVALID_VEH_ORDER_ID;
+		this->first_manual_order = INVALID_VEH_ORDER_ID;
+	}
+
 public:
 	/** Default constructor producing an invalid order list. */
 	OrderList(VehicleOrderID num_orders = INVALID_VEH_ORDER_ID)
 		: first(nullptr), num_orders(num_orders), num_manual_orders(0), num_vehicles(0), first_shared(nullptr),
-		  timetable_duration(0), total_duration(0) { }
+		  timetable_duration(0), total_duration(0), cached_order(nullptr),
+		  cached_order_index(INVALID_VEH_ORDER_ID), first_manual_order(INVALID_VEH_ORDER_ID) { }
 
 	/**
 	 * Create an order list with the given order chain for the given vehicle.
@@ -327,6 +343,8 @@ public:
 	 */
 	inline VehicleOrderID GetNumManualOrders() const { return this->num_manual_orders; }
 
+	VehicleOrderID GetFirstManualOrderIndex() const;
+
 	StationIDStack GetNextStoppingStation(const Vehicle *v, const Order *first = nullptr, uint hops = 0) const;
 	const Order *GetNextDecisionNode(const Order *next, uint hops) const;
 
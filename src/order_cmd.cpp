@@ -27,6 +27,7 @@
 #include "cheat_type.h"
 #include "order_cmd.h"
 #include "train_cmd.h"
+#include "linkgraph/refresh.h"
 
 #include "table/strings.h"
 
@@ -43,6 +44,18 @@ INSTANTIATE_POOL_METHODS(Order)
 OrderListPool _orderlist_pool("OrderList");
 INSTANTIATE_POOL_METHODS(OrderList)
 
+/** Current generation of the per-order destination cache; compared against Order::cached_location_generation. */
+static uint64 _order_destination_generation = 1;
+
+/**
+ * Invalidate the cached resolved destination location of all orders, e.g.
+ * because a station sign moved to another tile.
+ */
+void InvalidateOrderDestinationCache()
+{
+	_order_destination_generation++;
+}
+
 /** Clean everything up. */
 Order::~Order()
 {
@@ -66,6 +79,7 @@ void Order::Free()
 	this->flags = 0;
 	this->dest  = 0;
 	this->next  = nullptr;
+	this->cached_location_generation = 0;
 }
 
 /**
@@ -77,6 +91,7 @@ void Order::MakeGoToStation(StationID destination)
 	this->type = OT_GOTO_STATION;
 	this->flags = 0;
 	this->dest = destination;
+	this->cached_location_generation = 0;
 }
 
 /**
@@ -94,6 +109,7 @@ void Order::MakeGoToDepot(DepotID destination, OrderDepotTypeFlags order, OrderN
 	this->SetDepotActionType(action);
 	this->SetNonStopType(non_stop_type);
 	this->dest = destination;
+	this->cached_location_generation = 0;
 	this->SetRefit(cargo);
 }
 
@@ -106,6 +122,7 @@ void Order::MakeGoToWaypoint(StationID destination)
 	this->type = OT_GOTO_WAYPOINT;
 	this->flags = 0;
 	this->dest = destination;
+	this->cached_location_generation = 0;
 }
 
 /**
@@ -155,6 +172,7 @@ void Order::MakeImplicit(StationID destination)
 {
 	this->type = OT_IMPLICIT;
 	this->dest = destination;
+	this->cached_location_generation = 0;
 }
 
 /**
@@ -241,6 +259,20 @@ Order::Order(uint32 packed)
 	this->wait_time     = 0;
 	this->travel_time   = 0;
 	this->max_speed     = UINT16_MAX;
+	this->cached_location_generation = 0;
+}
+
+/** Generation of the order reviews; compared against Vehicle::order_review_stamp. */
+static uint32 _order_review_generation = 1;
+
+/**
+ * Invalidate the memoized order reviews, e.g. because orders changed or a
+ * station gained or lost facilities. The next scheduled #CheckOrders() of
+ * each vehicle walks its order list again instead of being skipped.
+ */
+void InvalidateOrderReviews()
+{
+	_order_review_generation++;
 }
 
 /**
@@ -250,6 +282,10 @@ Order::Order(uint32 packed)
  */
 void InvalidateVehicleOrder(const Vehicle *v, int data)
 {
+	/* The orders changed, so memoized link refreshes are no longer valid. */
+	InvalidateLinkRefreshMemo();
+	InvalidateOrderReviews();
+
 	SetWindowDirty(WC_VEHICLE_VIEW, v->index);
 
 	if (data != 0) {
@@ -281,6 +317,8 @@ void Order::AssignOrder(const Order &other)
 	this->wait_time   = other.wait_time;
 	this->travel_time = other.travel_time;
 	this->max_speed   = other.max_speed;
+
+	this->cached_location_generation = 0;
 }
 
 /**
@@ -297,6 +335,7 @@ void OrderList::Initialize(Order *chain, Vehicle *v)
 	this->num_manual_orders = 0;
 	this->num_vehicles = 1;
 	this->timetable_duration = 0;
+	this->InvalidateOrderCache();
 
 	for (Order *o = this->first; o != nullptr; o = o->next) {
 		++this->num_orders;
@@ -344,6 +383,7 @@ void OrderList::FreeChain(bool keep_orderlist)
 		this->num_orders = 0;
 		this->num_manual_orders = 0;
 		this->timetable_duration = 0;
+		this->InvalidateOrderCache();
 	} else {
 		delete this;
 	}
@@ -358,14 +398,44 @@ Order *OrderList::GetOrderAt(int index) const
 {
 	if (index < 0) return nullptr;
 
-	Order *order = this->first;
+	Order *order;
+	int skip;
+
+	if (this->cached_order != nullptr && index >= this->cached_order_index) {
+		/* Start at the cached cursor; most lookups are at or just after it. */
+		order = this->cached_order;
+		skip = index - this->cached_order_index;
+	} else {
+		order = this->first;
+		skip = index;
+	}
 
-	while (order != nullptr && index-- > 0) {
+	while (order != nullptr && skip-- > 0) {
 		order = order->next;
 	}
+
+	if (order != nullptr) {
+		this->cached_order = order;
+		this->cached_order_index = index;
+	}
 	return order;
 }
 
+/**
+ * Get the index of the first manually added order of the order chain.
+ * @return the index of the first order that is not an implicit order, or
+ *         the number of orders if the whole chain is implicit.
+ */
+VehicleOrderID OrderList::GetFirstManualOrderIndex() const
+{
+	if (this->first_manual_order == INVALID_VEH_ORDER_ID) {
+		VehicleOrderID index = 0;
+		for (const Order *o = this->first; o != nullptr && o->IsType(OT_IMPLICIT); o = o->next) ++index;
+		this->first_manual_order = index;
+	}
+	return this->first_manual_order;
+}
+
 /**
  * Get the next order which will make the given vehicle stop at a station
  * or refit at a depot or evaluate a non-trivial condition.
@@ -492,6 +562,7 @@ void OrderList::InsertOrderAt(Order *new_order, int index)
 	if (!new_order->IsType(OT_IMPLICIT)) ++this->num_manual_orders;
 	this->timetable_duration += new_order->GetTimetabledWait() + new_order->GetTimetabledTravel();
 	this->total_duration += new_order->GetWaitTime() + new_order->GetTravelTime();
+	this->InvalidateOrderCache();
 
 	/* We can visit oil rigs and buoys that are not our own. They will be shown in
 	 * the list of stations. So, we need to invalidate that window if needed. */
@@ -525,6 +596,7 @@ void OrderList::DeleteOrderAt(int index)
 	if (!to_remove->IsType(OT_IMPLICIT)) --this->num_manual_orders;
 	this->timetable_duration -= (to_remove->GetTimetabledWait() + to_remove->GetTimetabledTravel());
 	this->total_duration -= (to_remove->GetWaitTime() + to_remove->GetTravelTime());
+	this->InvalidateOrderCache();
 	delete to_remove;
 }
 
@@ -549,6 +621,10 @@ void OrderList::MoveOrder(int from, int to)
 		one_before->next = moving_one->next;
 	}
 
+	/* The cursor may point at or beyond the removed order; don't use it for
+	 * the lookup on the shortened chain below. */
+	this->InvalidateOrderCache();
+
 	/* Insert the moving_order again in the pointer-chain */
 	if (to == 0) {
 		moving_one->next = this->first;
@@ -558,6 +634,8 @@ void OrderList::MoveOrder(int from, int to)
 		moving_one->next = one_before->next;
 		one_before->next = moving_one;
 	}
+
+	this->InvalidateOrderCache();
 }
 
 /**
@@ -687,11 +765,20 @@ TileIndex Order::GetLocation(const Vehicle *v, bool airport) const
 		case OT_GOTO_STATION:
 		case OT_IMPLICIT:
 			if (airport && v->type == VEH_AIRCRAFT) return Station::Get(this->GetDestination())->airport.tile;
-			return BaseStation::Get(this->GetDestination())->xy;
+			if (this->cached_location_generation != _order_destination_generation) {
+				this->cached_location = BaseStation::Get(this->GetDestination())->xy;
+				this->cached_location_generation = _order_destination_generation;
+			}
+			return this->cached_location;
 
 		case OT_GOTO_DEPOT:
 			if (this->GetDestination() == INVALID_DEPOT) return INVALID_TILE;
-			return (v->type == VEH_AIRCRAFT) ? Station::Get(this->GetDestination())->xy : Depot::Get(this->GetDestination())->xy;
+			if (v->type == VEH_AIRCRAFT) return Station::Get(this->GetDestination())->xy;
+			if (this->cached_location_generation != _order_destination_generation) {
+				this->cached_location = Depot::Get(this->GetDestination())->xy;
+				this->cached_location_generation = _order_destination_generation;
+			}
+			return this->cached_location;
 
 		default:
 			return INVALID_TILE;
@@ -1703,6 +1790,11 @@ void CheckOrders(const Vehicle *v)
 
 	/* Only check every 20 days, so that we don't flood the message log */
 	if (v->owner == _local_company && v->day_counter % 20 == 0) {
+		/* Neither the orders nor the stations they reference changed since
+		 * the last review that came out clean, so it still stands. Reviews
+		 * that found a problem are not memoized; they repeat their advice. */
+		if (v->order_review_stamp == _order_review_generation) return;
+
 		StringID message = INVALID_STRING_ID;
 
 		/* Check the order list */
@@ -1748,7 +1840,10 @@ void CheckOrders(const Vehicle *v)
 #endif
 
 		/* We don't have a problem */
-		if (message == INVALID_STRING_ID) return;
+		if (message == INVALID_STRING_ID) {
+			v->order_review_stamp = _order_review_generation;
+			return;
+		}
 
 		SetDParam(0, v->index);
 		AddVehicleAdviceNewsItem(message, v->index);
@@ -1849,6 +1944,9 @@ void DeleteVehicleOrders(Vehicle *v, bool keep_orderlist, bool reset_order_indic
 {
 	DeleteOrderWarnings(v);
 
+	/* A freed order list index may be reused, so its memoized refreshes have to go. */
+	InvalidateLinkRefreshMemo();
+
 	if (v->IsOrderListShared()) {
 		/* Remove ourself from the shared order list. */
 		v->RemoveFromShared();
@@ -2009,7 +2107,7 @@ bool UpdateOrderDest(Vehicle *v, const Order *order, int conditional_depth, bool
 				v->IncrementRealOrderIndex();
 			} else {
 				if (v->type != VEH_AIRCRAFT) {
-					v->SetDestTile(Depot::Get(order->GetDestination())->xy);
+					v->SetDestTile(order->GetLocation(v));
 				} else {
 					Aircraft *a = Aircraft::From(v);
 					DestinationID destination = a->current_order.GetDestination();
@@ -2023,7 +2121,7 @@ bool UpdateOrderDest(Vehicle *v, const Order *order, int conditional_depth, bool
 			break;
 
 		case OT_GOTO_WAYPOINT:
-			v->SetDestTile(Waypoint::Get(order->GetDestination())->xy);
+			v->SetDestTile(order->GetLocation(v));
 			return true;
 
 		case OT_CONDITIONAL: {
@@ -23,6 +23,7 @@
 
 #include "../../table/control_codes.h"
 
+#include <map>
 #include <windows.h>
 #include <shlobj.h> /* SHGetFolderPath */
 #include "os/windows/win32.h"
@@ -65,6 +66,39 @@ static const char *GetShortPath(const wchar_t *long_path)
  * an additional memory usage of 30MB (just for fonts!) when using an eastern
  * font for all font sizes */
 static const wchar_t *FONT_DIR_NT = L"SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion\\Fonts";
+
+/** Cache of the font file each face name resolved to, to skip the registry enumeration on repeated lookups. */
+static std::map<std::string, std::string> _font_file_cache;
+
+/**
+ * Load the font face with the given name from a font file.
+ * The file may be a TrueType Collection containing multiple fonts; try each
+ * face in it until one matches the wanted name.
+ * @param font_name The name of the font face to load, with the English name
+ *                  concatenated after its terminating '\0'.
+ * @param font_path Path of the font file, in a format FreeType understands.
+ * @param face The face that has been found.
+ * @return The error we encountered.
+ */
+static FT_Error LoadFontFromFile(const char *font_name, const char *font_path, FT_Face *face)
+{
+	FT_Error err = FT_Err_Cannot_Open_Resource;
+
+	uint index = 0;
+	do {
+		err = FT_New_Face(_library, font_path, index, face);
+		if (err != FT_Err_Ok) break;
+
+		if (strncasecmp(font_name, (*face)->family_name, strlen((*face)->family_name)) == 0) break;
+		/* Try english name if font name failed */
+		if (strncasecmp(font_name + strlen(font_name) + 1, (*face)->family_name, strlen((*face)->family_name)) == 0) break;
+		err = FT_Err_Cannot_Open_Resource;
+
+	} while ((FT_Long)++index != (*face)->num_faces);
+
+	return err;
+}
+
 FT_Error GetFontByFaceName(const char *font_name, FT_Face *face)
 {
 	FT_Error err = FT_Err_Cannot_Open_Resource;
@@ -76,6 +110,12 @@ FT_Error GetFontByFaceName(const char *font_name, FT_Face *face)
 	uint index;
 	size_t path_len;
 
+	/* The same face is looked up for every font size, and the fallback font
+	 * search probes many faces in a row; skip the registry enumeration for
+	 * faces that have already been resolved to their font file. */
+	auto cached = _font_file_cache.find(font_name);
+	if (cached != _font_file_cache.end()) return LoadFontFromFile(font_name, cached->second.c_str(), face);
+
 	ret = RegOpenKeyEx(HKEY_LOCAL_MACHINE, FONT_DIR_NT, 0, KEY_READ, &hKey);
 
 	if (ret != ERROR_SUCCESS) {
@@ -129,18 +169,8 @@ FT_Error GetFontByFaceName(const char *font_name, FT_Face *face)
 	/* Convert the path into something that FreeType understands. */
 	font_path = GetShortPath(pathbuf);
 
-	index = 0;
-	do {
-		err = FT_New_Face(_library, font_path, index, face);
-		if (err != FT_Err_Ok) break;
-
-		if (strncasecmp(font_name, (*face)->family_name, strlen((*face)->family_name)) == 0) break;
-		/* Try english name if font name failed */
-		if (strncasecmp(font_name + strlen(font_name) + 1, (*face)->family_name, strlen((*face)->family_name)) == 0) break;
-		err = FT_Err_Cannot_Open_Resource;
-
-	} while ((FT_Long)++index != (*face)->num_faces);
-
+	err = LoadFontFromFile(font_name, font_path, face);
+	if (err == FT_Err_Ok) _font_file_cache[font_name] = font_path;
 
 folder_error:
 registry_no_font_found:
@@ -233,10 +263,17 @@ err1:
 }
 #endif /* WITH_FREETYPE */
 
+/** A fallback font decision: the full font name (with the English name after its '\0') and the font description. */
+typedef std::pair<std::string, LOGFONT> FallbackFontChoice;
+
+/** Fallback fonts that were chosen before, so switching back to a language skips the font enumeration. */
+static std::map<std::pair<int, bool>, FallbackFontChoice> _fallback_font_cache;
+
 struct EFCParam {
 	FontCacheSettings *settings;
 	LOCALESIGNATURE  locale;
 	MissingGlyphSearcher *callback;
+	int winlangid;
 	std::vector<std::wstring> fonts;
 
 	bool Add(const std::wstring_view &font) {
@@ -311,11 +348,33 @@ static int CALLBACK EnumFontCallback(const ENUMLOGFONTEX *logfont, const NEWTEXT
 	info->callback->SetFontNames(info->settings, font_name, &logfont->elfLogFont);
 	if (info->callback->FindMissingGlyphs()) return 1;
 	Debug(fontcache, 1, "Fallback font: {} ({})", font_name, english_name);
+
+	/* Remember the choice, so switching back to this language later does not
+	 * enumerate all fonts again. */
+	size_t name_len = strlen(font_name);
+#ifdef WITH_FREETYPE
+	/* Include the English name concatenated after the '\0'. */
+	name_len += strlen(font_name + name_len + 1) + 1;
+#endif /* WITH_FREETYPE */
+	_fallback_font_cache[std::make_pair(info->winlangid, info->callback->Monospace())] = FallbackFontChoice(std::string(font_name, name_len), logfont->elfLogFont);
+
 	return 0; // stop enumerating
 }
 
 bool SetFallbackFont(FontCacheSettings *settings, const char *language_isocode, int winlangid, MissingGlyphSearcher *callback)
 {
+	/* Try the font that was chosen for this language before; only accept it
+	 * after verifying it still covers all glyphs, so a changed font
+	 * installation cannot make us reuse a stale decision. */
+	auto cached = _fallback_font_cache.find(std::make_pair(winlangid, callback->Monospace()));
+	if (cached != _fallback_font_cache.end()) {
+		callback->SetFontNames(settings, cached->second.first.c_str(), &cached->second.second);
+		if (!callback->FindMissingGlyphs()) {
+			Debug(fontcache, 1, "Reusing fallback font: {}", cached->second.first.c_str());
+			return true;
+		}
+	}
+
 	Debug(fontcache, 1, "Trying fallback fonts");
 	EFCParam langInfo;
 	if (GetLocaleInfo(MAKELCID(winlangid, SORT_DEFAULT), LOCALE_FONTSIGNATURE, (LPTSTR)&langInfo.locale, sizeof(langInfo.locale) / sizeof(wchar_t)) == 0) {
@@ -325,6 +384,7 @@ bool SetFallbackFont(FontCacheSettings *settings, const char *language_isocode,
 	}
 	langInfo.settings = settings;
 	langInfo.callback = callback;
+	langInfo.winlangid = winlangid;
 
 	LOGFONT font;
 	/* Enumerate all fonts. */
@@ -493,7 +553,7 @@ void Win32FontCache::ClearFontCache()
 	}
 
 	GlyphEntry new_glyph;
-	new_glyph.sprite = BlitterFactory::GetCurrentBlitter()->Encode(&sprite, SimpleSpriteAlloc);
+	new_glyph.sprite = this->EncodeGlyphSprite(sprite);
 	new_glyph.width = gm.gmCellIncX;
 
 	this->SetGlyphPtr(key, &new_glyph);
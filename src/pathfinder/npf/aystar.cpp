@@ -45,7 +45,7 @@ PathNode *AyStar::ClosedListIsInList(const AyStarNode *node)
 void AyStar::ClosedListAdd(const PathNode *node)
 {
 	/* Add a node to the ClosedList */
-	PathNode *new_node = MallocT<PathNode>(1);
+	PathNode *new_node = (PathNode *)this->arena.Allocate(sizeof(PathNode));
 	*new_node = *node;
 	this->closedlist_hash.Set(node->node.tile, node->node.direction, new_node);
 }
@@ -83,7 +83,7 @@ OpenListNode *AyStar::OpenListPop()
 void AyStar::OpenListAdd(PathNode *parent, const AyStarNode *node, int f, int g)
 {
 	/* Add a new Node to the OpenList */
-	OpenListNode *new_node = MallocT<OpenListNode>(1);
+	OpenListNode *new_node = (OpenListNode *)this->arena.Allocate(sizeof(OpenListNode));
 	new_node->g = g;
 	new_node->path.parent = parent;
 	new_node->path.node = *node;
@@ -172,7 +172,7 @@ int AyStar::Loop()
 		if (this->FoundEndNode != nullptr) {
 			this->FoundEndNode(this, current);
 		}
-		free(current);
+		/* The node is owned by the arena; it is given back in bulk by Clear() */
 		return AYSTAR_FOUND_END_NODE;
 	}
 
@@ -188,9 +188,6 @@ int AyStar::Loop()
 		this->CheckTile(&this->neighbours[i], current);
 	}
 
-	/* Free the node */
-	free(current);
-
 	if (this->max_search_nodes != 0 && this->closedlist_hash.GetSize() >= this->max_search_nodes) {
 		/* We've expanded enough nodes */
 		return AYSTAR_LIMIT_REACHED;
@@ -206,10 +203,10 @@ int AyStar::Loop()
 void AyStar::Free()
 {
 	this->openlist_queue.Free(false);
-	/* 2nd argument above is false, below is true, to free the values only
-	 * once */
-	this->openlist_hash.Delete(true);
-	this->closedlist_hash.Delete(true);
+	/* The hashes only reference the nodes, the arena owns them */
+	this->openlist_hash.Delete(false);
+	this->closedlist_hash.Delete(false);
+	this->arena.Free();
 #ifdef AYSTAR_DEBUG
 	printf("[AyStar] Memory free'd\n");
 #endif
@@ -221,12 +218,15 @@ void AyStar::Free()
  */
 void AyStar::Clear()
 {
-	/* Clean the Queue, but not the elements within. That will be done by
-	 * the hash. */
+	/* Clean the Queue, but not the elements within. Those are owned by
+	 * the arena. */
 	this->openlist_queue.Clear(false);
 	/* Clean the hashes */
-	this->openlist_hash.Clear(true);
-	this->closedlist_hash.Clear(true);
+	this->openlist_hash.Clear(false);
+	this->closedlist_hash.Clear(false);
+	/* Give all nodes back to the arena; it keeps its blocks for the next
+	 * search. */
+	this->arena.Reset();
 
 #ifdef AYSTAR_DEBUG
 	printf("[AyStar] Cleared AyStar\n");
@@ -292,9 +292,10 @@ void AyStar::AddStartNode(AyStarNode *start_node, uint g)
  */
 void AyStar::Init(Hash_HashProc hash, uint num_buckets)
 {
-	/* Allocated the Hash for the OpenList and ClosedList */
-	this->openlist_hash.Init(hash, num_buckets);
-	this->closedlist_hash.Init(hash, num_buckets);
+	/* Allocated the Hash for the OpenList and ClosedList; their chain
+	 * nodes come from the arena as well */
+	this->openlist_hash.Init(hash, num_buckets, &this->arena);
+	this->closedlist_hash.Init(hash, num_buckets, &this->arena);
 
 	/* Set up our sorting queue
 	 *  BinaryHeap allocates a block of 1024 nodes
@@ -157,6 +157,7 @@ protected:
 	Hash       closedlist_hash; ///< The actual closed list.
 	BinaryHeap openlist_queue;  ///< The open queue.
 	Hash       openlist_hash;   ///< An extra hash to speed up the process of looking up an element in the open list.
+	NodeArena  arena;           ///< Arena all nodes of a search are allocated from; bulk-reset by #Clear().
 
 	void OpenListAdd(PathNode *parent, const AyStarNode *node, int f, int g);
 	OpenListNode *OpenListIsInList(const AyStarNode *node);
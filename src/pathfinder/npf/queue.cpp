@@ -5,14 +5,80 @@
  * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
  */
 
-/** @file queue.cpp Implementation of the #BinaryHeap/#Hash. */
+/** @file queue.cpp Implementation of the #BinaryHeap/#Hash/#NodeArena. */
 
 #include "../../stdafx.h"
 #include "../../core/alloc_func.hpp"
+#include "../../core/math_func.hpp"
 #include "queue.h"
 
 #include "../../safeguards.h"
 
+/*
+ * Node arena
+ */
+
+const size_t NodeArena::ARENA_BLOCK_SIZE = 8192; ///< The number of bytes that will be malloc'd at a time.
+
+/**
+ * Allocates the given number of bytes from the arena. The memory stays
+ * valid until Reset() or Free() is called.
+ */
+void *NodeArena::Allocate(size_t size)
+{
+	/* Round up so subsequent allocations stay properly aligned */
+	size = Align(size, sizeof(void *));
+	assert(size <= ARENA_BLOCK_SIZE);
+
+	if (this->num_blocks == 0) {
+		/* First allocation ever; get the initial block */
+		this->blocks = MallocT<byte *>(1);
+		this->blocks[0] = MallocT<byte>(ARENA_BLOCK_SIZE);
+		this->num_blocks = 1;
+		this->current_block = 0;
+		this->used = 0;
+	} else if (this->used + size > ARENA_BLOCK_SIZE) {
+		/* Current block is full; move on to the next one, allocating it
+		 * unless it is left over from an earlier search */
+		if (++this->current_block == this->num_blocks) {
+			this->blocks = ReallocT<byte *>(this->blocks, this->num_blocks + 1);
+			this->blocks[this->num_blocks] = MallocT<byte>(ARENA_BLOCK_SIZE);
+			this->num_blocks++;
+		}
+		this->used = 0;
+	}
+
+	void *result = this->blocks[this->current_block] + this->used;
+	this->used += size;
+	return result;
+}
+
+/**
+ * Forgets all allocations at once. The blocks are kept, so the next
+ * search allocates from the same memory again.
+ */
+void NodeArena::Reset()
+{
+	this->current_block = 0;
+	this->used = 0;
+}
+
+/**
+ * Frees all memory allocated by the arena. After this the arena is
+ * empty, but still usable.
+ */
+void NodeArena::Free()
+{
+	for (uint i = 0; i < this->num_blocks; i++) {
+		free(this->blocks[i]);
+	}
+	free(this->blocks);
+	this->blocks = nullptr;
+	this->num_blocks = 0;
+	this->current_block = 0;
+	this->used = 0;
+}
+
 
 /*
  * Binary Heap
@@ -227,9 +293,11 @@ void BinaryHeap::Init(uint max_size)
 
 /**
  * Builds a new hash in an existing struct. Make sure that hash() always
- * returns a hash less than num_buckets! Call delete_hash after use
+ * returns a hash less than num_buckets! Call delete_hash after use.
+ * When node_arena is given the chain nodes are allocated from it and
+ * never freed individually; resetting the arena is the caller's job.
  */
-void Hash::Init(Hash_HashProc *hash, uint num_buckets)
+void Hash::Init(Hash_HashProc *hash, uint num_buckets, NodeArena *node_arena)
 {
 	/* Allocate space for the Hash, the buckets and the bucket flags */
 	uint i;
@@ -240,6 +308,7 @@ void Hash::Init(Hash_HashProc *hash, uint num_buckets)
 	this->hash = hash;
 	this->size = 0;
 	this->num_buckets = num_buckets;
+	this->node_arena = node_arena;
 	this->buckets = (HashNode*)MallocT<byte>(num_buckets * (sizeof(*this->buckets) + sizeof(*this->buckets_in_use)));
 	this->buckets_in_use = (bool*)(this->buckets + num_buckets);
 	for (i = 0; i < num_buckets; i++) this->buckets_in_use[i] = false;
@@ -269,7 +338,7 @@ void Hash::Delete(bool free_values)
 				/* Free the value */
 				if (free_values) free(prev->value);
 				/* Free the node */
-				free(prev);
+				if (this->node_arena == nullptr) free(prev);
 			}
 		}
 	}
@@ -354,7 +423,7 @@ void Hash::Clear(bool free_values)
 
 				node = node->next;
 				if (free_values) free(prev->value);
-				free(prev);
+				if (this->node_arena == nullptr) free(prev);
 			}
 		}
 	}
@@ -425,7 +494,7 @@ void *Hash::DeleteValue(uint key1, uint key2)
 			/* Copy the second to the first */
 			*node = *next;
 			/* Free the second */
-			free(next);
+			if (this->node_arena == nullptr) free(next);
 		} else {
 			/* This was the last in this bucket
 			 * Mark it as empty */
@@ -439,7 +508,7 @@ void *Hash::DeleteValue(uint key1, uint key2)
 		/* Link previous and next nodes */
 		prev->next = node->next;
 		/* Free the node */
-		free(node);
+		if (this->node_arena == nullptr) free(node);
 	}
 	if (result != nullptr) this->size--;
 	return result;
@@ -469,7 +538,7 @@ void *Hash::Set(uint key1, uint key2, void *value)
 		node = this->buckets + hash;
 	} else {
 		/* Add it after prev */
-		node = MallocT<HashNode>(1);
+		node = (this->node_arena != nullptr) ? (HashNode *)this->node_arena->Allocate(sizeof(HashNode)) : MallocT<HashNode>(1);
 		prev->next = node;
 	}
 	node->next = nullptr;
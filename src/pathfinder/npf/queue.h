@@ -5,7 +5,7 @@
  * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
  */
 
-/** @file queue.h Binary heap implementation, hash implementation. */
+/** @file queue.h Binary heap implementation, hash implementation, node arena. */
 
 #ifndef QUEUE_H
 #define QUEUE_H
@@ -13,6 +13,27 @@
 //#define HASH_STATS
 
 
+/**
+ * Bump allocator for the temporary nodes of a search. Memory is handed out
+ * from fixed size blocks and cannot be freed item by item; Reset() forgets
+ * all allocations at once while keeping the blocks around, so consecutive
+ * searches reuse the same memory instead of doing a malloc/free per node.
+ * A zeroed arena (static storage or \c = {}) is valid and empty.
+ */
+struct NodeArena {
+	static const size_t ARENA_BLOCK_SIZE;
+
+	void *Allocate(size_t size);
+	void Reset();
+	void Free();
+
+	byte **blocks;      ///< The allocated blocks.
+	uint num_blocks;    ///< Number of allocated blocks.
+	uint current_block; ///< Index of the block currently being filled.
+	size_t used;        ///< Number of bytes used in the current block.
+};
+
+
 struct BinaryHeapNode {
 	void *item;
 	int priority;
@@ -80,8 +101,11 @@ struct Hash {
 	/* A pointer to an array of numbuckets booleans, which will be true if
 	 * there are any Nodes in the bucket */
 	bool *buckets_in_use;
+	/* Arena the chain nodes are allocated from, or nullptr to malloc/free
+	 * them individually */
+	NodeArena *node_arena;
 
-	void Init(Hash_HashProc *hash, uint num_buckets);
+	void Init(Hash_HashProc *hash, uint num_buckets, NodeArena *node_arena = nullptr);
 
 	void *Get(uint key1, uint key2) const;
 	void *Set(uint key1, uint key2, void *value);
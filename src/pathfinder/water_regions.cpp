@@ -0,0 +1,185 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file water_regions.cpp Coarse water region grid for hierarchical ship pathfinding. */
+
+#include "../stdafx.h"
+#include "../map_func.h"
+#include "../tile_cmd.h"
+#include "../track_func.h"
+#include "water_regions.h"
+#include <queue>
+#include <vector>
+
+#include "../safeguards.h"
+
+/** State of a single water region. */
+enum WaterRegionState : byte {
+	WRS_DIRTY, ///< Unknown, needs rescanning.
+	WRS_LAND,  ///< No navigable water in the region.
+	WRS_WATER, ///< At least one tile of the region is navigable.
+};
+
+/** Extra region-level distance a tile-level path may detour from the shortest region route. */
+static const uint CORRIDOR_SLACK = 4;
+
+/** Maximum number of regions visited by the region-level search before giving up. */
+static const uint MAX_CORRIDOR_REGIONS = 4096;
+
+static std::vector<byte> _water_region_state; ///< Per region navigability, lazily computed.
+static uint _water_region_grid_x;             ///< Width of the region grid the state was built for.
+static uint _water_region_grid_y;             ///< Height of the region grid the state was built for.
+
+static std::vector<bool> _ship_corridor;      ///< Regions the current tile-level search may visit.
+static bool _ship_corridor_active = false;    ///< Whether a corridor restriction is in place.
+
+/**
+ * Make sure the region grid matches the current map size. All regions start
+ * out dirty and are scanned on first use.
+ */
+static void EnsureWaterRegionGrid()
+{
+	uint grid_x = Map::SizeX() / WATER_REGION_EDGE_LENGTH;
+	uint grid_y = Map::SizeY() / WATER_REGION_EDGE_LENGTH;
+	if (grid_x != _water_region_grid_x || grid_y != _water_region_grid_y) {
+		_water_region_grid_x = grid_x;
+		_water_region_grid_y = grid_y;
+		_water_region_state.clear();
+		_water_region_state.resize(grid_x * grid_y, WRS_DIRTY);
+	}
+}
+
+/**
+ * Get the region index a tile belongs to.
+ * @param tile Tile to get the region of.
+ * @return Region index.
+ */
+static inline uint GetWaterRegionIndex(TileIndex tile)
+{
+	return TileY(tile) / WATER_REGION_EDGE_LENGTH * _water_region_grid_x + TileX(tile) / WATER_REGION_EDGE_LENGTH;
+}
+
+/**
+ * Check if a region contains any navigable water, rescanning it if needed.
+ * @param region Region index.
+ * @return True if a ship can travel somewhere inside the region.
+ */
+static bool IsWaterRegionNavigable(uint region)
+{
+	byte &state = _water_region_state[region];
+	if (state == WRS_DIRTY) {
+		state = WRS_LAND;
+		uint base_x = region % _water_region_grid_x * WATER_REGION_EDGE_LENGTH;
+		uint base_y = region / _water_region_grid_x * WATER_REGION_EDGE_LENGTH;
+		for (uint y = 0; y < WATER_REGION_EDGE_LENGTH && state == WRS_LAND; ++y) {
+			for (uint x = 0; x < WATER_REGION_EDGE_LENGTH; ++x) {
+				TileIndex tile = TileXY(base_x + x, base_y + y);
+				if (TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_WATER, 0)) != TRACK_BIT_NONE) {
+					state = WRS_WATER;
+					break;
+				}
+			}
+		}
+	}
+	return state == WRS_WATER;
+}
+
+/**
+ * Mark the region containing the given tile as dirty. Called whenever the
+ * water state of a tile may have changed (terraforming, canal or lock
+ * construction, flooding, ...).
+ * @param tile Tile that changed.
+ */
+void InvalidateWaterRegion(TileIndex tile)
+{
+	if (_water_region_state.empty() || tile >= Map::Size()) return;
+	EnsureWaterRegionGrid();
+	_water_region_state[GetWaterRegionIndex(tile)] = WRS_DIRTY;
+}
+
+/**
+ * Compute a corridor of water regions around the shortest region-level route
+ * between two tiles. While the corridor is active, IsTileInShipPathCorridor()
+ * restricts the tile-level search to it. The region graph treats any two
+ * adjacent navigable regions as connected, so the corridor can overestimate
+ * connectivity; a failed tile-level search should fall back to an
+ * unrestricted one.
+ * @param from Origin tile of the planned path.
+ * @param to Destination tile of the planned path.
+ * @return True if a corridor was set up, false if the search should run
+ *         unrestricted.
+ */
+bool ComputeShipPathCorridor(TileIndex from, TileIndex to)
+{
+	_ship_corridor_active = false;
+	if (to >= Map::Size()) return false;
+	EnsureWaterRegionGrid();
+
+	uint from_region = GetWaterRegionIndex(from);
+	uint to_region = GetWaterRegionIndex(to);
+	if (from_region == to_region) return false;
+
+	/* Breadth-first search over navigable regions, starting at the
+	 * destination so the resulting distances can bound the detour of the
+	 * tile-level path. */
+	std::vector<uint16> dist(_water_region_state.size(), UINT16_MAX);
+	std::queue<uint> queue;
+	dist[to_region] = 0;
+	queue.push(to_region);
+	uint visited = 0;
+	while (!queue.empty() && dist[from_region] == UINT16_MAX) {
+		uint region = queue.front();
+		queue.pop();
+		if (++visited > MAX_CORRIDOR_REGIONS) return false;
+
+		uint x = region % _water_region_grid_x;
+		uint y = region / _water_region_grid_x;
+		uint neighbours[4];
+		uint count = 0;
+		if (x > 0) neighbours[count++] = region - 1;
+		if (x + 1 < _water_region_grid_x) neighbours[count++] = region + 1;
+		if (y > 0) neighbours[count++] = region - _water_region_grid_x;
+		if (y + 1 < _water_region_grid_y) neighbours[count++] = region + _water_region_grid_x;
+		for (uint i = 0; i < count; ++i) {
+			uint next = neighbours[i];
+			if (dist[next] != UINT16_MAX) continue;
+			if (next != from_region && !IsWaterRegionNavigable(next)) continue;
+			dist[next] = dist[region] + 1;
+			queue.push(next);
+		}
+	}
+	if (dist[from_region] == UINT16_MAX) return false;
+
+	/* Allow all regions not much further from the destination than the
+	 * origin region itself; that leaves room for detours around headlands
+	 * without opening up the whole map. */
+	uint16 max_dist = dist[from_region] + CORRIDOR_SLACK;
+	_ship_corridor.assign(_water_region_state.size(), false);
+	for (uint region = 0; region < dist.size(); ++region) {
+		_ship_corridor[region] = dist[region] <= max_dist;
+	}
+	_ship_corridor[from_region] = true;
+	_ship_corridor_active = true;
+	return true;
+}
+
+/**
+ * Check if the tile-level ship path search may visit the given tile.
+ * @param tile Tile to check.
+ * @return True if the tile is inside the active corridor, or no corridor is active.
+ */
+bool IsTileInShipPathCorridor(TileIndex tile)
+{
+	if (!_ship_corridor_active) return true;
+	return _ship_corridor[GetWaterRegionIndex(tile)];
+}
+
+/** Remove the corridor restriction. */
+void ClearShipPathCorridor()
+{
+	_ship_corridor_active = false;
+}
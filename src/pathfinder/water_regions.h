@@ -0,0 +1,24 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file water_regions.h Coarse water region grid for hierarchical ship pathfinding. */
+
+#ifndef WATER_REGIONS_H
+#define WATER_REGIONS_H
+
+#include "../tile_type.h"
+
+/** Edge length of a water region, in tiles. */
+static const uint WATER_REGION_EDGE_LENGTH = 16;
+
+void InvalidateWaterRegion(TileIndex tile);
+
+bool ComputeShipPathCorridor(TileIndex from, TileIndex to);
+bool IsTileInShipPathCorridor(TileIndex tile);
+void ClearShipPathCorridor();
+
+#endif /* WATER_REGIONS_H */
@@ -13,21 +13,24 @@
 #include "../../misc/array.hpp"
 #include "../../misc/hashtable.hpp"
 #include "../../misc/binaryheap.hpp"
+#include "../../misc/bucketqueue.hpp"
 
 /**
  * Hash table based node list multi-container class.
  *  Implements open list, closed list and priority queue for A-star
- *  path finder.
+ *  path finder. The hash table flavour is a policy parameter; the default
+ *  open addressing table (COpenHashTableT) probes a flat array and so
+ *  avoids chasing next pointers through the node heap.
  */
-template <class Titem_, int Thash_bits_open_, int Thash_bits_closed_>
+template <class Titem_, int Thash_bits_open_, int Thash_bits_closed_, class Tpriority_queue_ = CBinaryHeapT<Titem_>, template <class, int> class Thash_table_ = COpenHashTableT>
 class CNodeList_HashTableT {
 public:
-	typedef Titem_ Titem;                                        ///< Make #Titem_ visible from outside of class.
-	typedef typename Titem_::Key Key;                            ///< Make Titem_::Key a property of this class.
-	typedef SmallArray<Titem_, 65536, 256> CItemArray;           ///< Type that we will use as item container.
-	typedef CHashTableT<Titem_, Thash_bits_open_  > COpenList;   ///< How pointers to open nodes will be stored.
-	typedef CHashTableT<Titem_, Thash_bits_closed_> CClosedList; ///< How pointers to closed nodes will be stored.
-	typedef CBinaryHeapT<Titem_> CPriorityQueue;                 ///< How the priority queue will be managed.
+	typedef Titem_ Titem;                                            ///< Make #Titem_ visible from outside of class.
+	typedef typename Titem_::Key Key;                                ///< Make Titem_::Key a property of this class.
+	typedef SmallArray<Titem_, 65536, 256> CItemArray;               ///< Type that we will use as item container.
+	typedef Thash_table_<Titem_, Thash_bits_open_  > COpenList;      ///< How pointers to open nodes will be stored.
+	typedef Thash_table_<Titem_, Thash_bits_closed_> CClosedList;    ///< How pointers to closed nodes will be stored.
+	typedef Tpriority_queue_ CPriorityQueue;                         ///< How the priority queue will be managed.
 
 protected:
 	CItemArray      m_arr;        ///< Here we store full item data (Titem_).
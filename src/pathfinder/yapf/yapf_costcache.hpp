@@ -11,6 +11,7 @@
 #define YAPF_COSTCACHE_HPP
 
 #include "../../date_func.h"
+#include "../../map_func.h"
 
 /**
  * CYapfSegmentCostCacheNoneT - the formal only yapf cost cache provider that implements
@@ -91,19 +92,56 @@ public:
 
 
 /**
- * Base class for segment cost cache providers. Contains global counter
+ * Base class for segment cost cache providers. Contains global counters
  *  of track layout changes and static notification function called whenever
  *  the track layout changes. It is implemented as base class because it needs
  *  to be shared between all rail YAPF types (one shared counter, one notification
  *  function.
+ *
+ * Track layout changes are tracked per map region of #REGION_SIZE x #REGION_SIZE
+ *  tiles, so that a change only invalidates the cached segments whose bounding
+ *  box intersects the changed region instead of the whole cache.
  */
 struct CSegmentCostCacheBase
 {
-	static int   s_rail_change_counter;
+	static const uint REGION_SIZE_LOG = 5;                                  ///< Invalidation regions are 32 x 32 tiles.
+	static const uint REGION_GRID_LOG = MAX_MAP_SIZE_BITS - REGION_SIZE_LOG; ///< Log2 of the region grid dimension for the largest possible map.
+
+	static int   s_rail_change_counter;                                     ///< Monotonic counter of track layout changes.
+	static int   s_rail_flush_counter;                                      ///< Bumped when the whole cache has to go (new game, rail type conversion, ...).
+	static int   s_region_change_counter[1 << (2 * REGION_GRID_LOG)];       ///< Value of #s_rail_change_counter at the last change inside each region.
+
+	/** Get the index of the invalidation region the given tile belongs to. */
+	static uint RegionIndex(TileIndex tile)
+	{
+		return ((TileY(tile) >> REGION_SIZE_LOG) << REGION_GRID_LOG) | (TileX(tile) >> REGION_SIZE_LOG);
+	}
 
 	static void NotifyTrackLayoutChange(TileIndex tile, Track track)
 	{
 		s_rail_change_counter++;
+		if (tile == INVALID_TILE) {
+			/* No tile given; everything might have changed. */
+			s_rail_flush_counter = s_rail_change_counter;
+		} else {
+			s_region_change_counter[RegionIndex(tile)] = s_rail_change_counter;
+		}
+	}
+
+	/**
+	 * Did the track layout inside the given tile area change after the given moment?
+	 * @param min_x, min_y, max_x, max_y Tile coordinate bounds of the area (inclusive).
+	 * @param counter Value of #s_rail_change_counter to compare against.
+	 * @return True when some region intersecting the area changed since \a counter.
+	 */
+	static bool HasRegionChangeAfter(uint min_x, uint min_y, uint max_x, uint max_y, int counter)
+	{
+		for (uint y = min_y >> REGION_SIZE_LOG; y <= max_y >> REGION_SIZE_LOG; y++) {
+			for (uint x = min_x >> REGION_SIZE_LOG; x <= max_x >> REGION_SIZE_LOG; x++) {
+				if (s_region_change_counter[(y << REGION_GRID_LOG) | x] > counter) return true;
+			}
+		}
+		return false;
 	}
 };
 
@@ -138,13 +176,34 @@ struct CSegmentCostCacheT : public CSegmentCostCacheBase {
 		m_heap.Clear();
 	}
 
+	/**
+	 * Did the track layout within (or next to) the segment's bounding box change
+	 *  after the segment was cached? End-of-segment reasons depend on the tile
+	 *  following the segment, hence the one tile margin around the box.
+	 */
+	inline bool IsOutOfDate(const Tsegment &segment) const
+	{
+		if (segment.m_min_x > segment.m_max_x) return false; // no tiles were recorded yet
+		uint min_x = segment.m_min_x > 0 ? segment.m_min_x - 1 : 0;
+		uint min_y = segment.m_min_y > 0 ? segment.m_min_y - 1 : 0;
+		uint max_x = std::min<uint>(segment.m_max_x + 1, MAX_MAP_SIZE - 1);
+		uint max_y = std::min<uint>(segment.m_max_y + 1, MAX_MAP_SIZE - 1);
+		return HasRegionChangeAfter(min_x, min_y, max_x, max_y, segment.m_version);
+	}
+
 	inline Tsegment& Get(Key &key, bool *found)
 	{
 		Tsegment *item = m_map.Find(key);
 		if (item == nullptr) {
 			*found = false;
 			item = new (m_heap.Append()) Tsegment(key);
+			item->m_version = s_rail_change_counter;
 			m_map.Push(*item);
+		} else if (this->IsOutOfDate(*item)) {
+			/* The track layout around the segment changed; recalculate it. */
+			*found = false;
+			item->Invalidate();
+			item->m_version = s_rail_change_counter;
 		} else {
 			*found = true;
 		}
@@ -181,12 +240,13 @@ protected:
 
 	inline static Cache& stGetGlobalCache()
 	{
-		static int last_rail_change_counter = 0;
+		static int last_rail_flush_counter = 0;
 		static Cache C;
 
-		/* delete the cache sometimes... */
-		if (last_rail_change_counter != Cache::s_rail_change_counter) {
-			last_rail_change_counter = Cache::s_rail_change_counter;
+		/* Regular track layout changes invalidate affected segments lazily in
+		 * Cache::Get(); only wholesale invalidations delete the cache. */
+		if (last_rail_flush_counter != Cache::s_rail_flush_counter) {
+			last_rail_flush_counter = Cache::s_rail_flush_counter;
 			C.Flush();
 		}
 		return C;
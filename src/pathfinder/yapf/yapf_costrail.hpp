@@ -370,6 +370,10 @@ public:
 
 no_entry_cost: // jump here at the beginning if the node has no parent (it is the first node)
 
+			/* Track the tiles the segment consists of, so the cache can
+			 * invalidate it when the track layout near them changes. */
+			if (!is_cached_segment) segment.IncludeTile(cur.tile);
+
 			/* All other tile costs will be calculated here. */
 			segment_cost += Yapf().OneTileCost(cur.tile, cur.td);
 
@@ -497,6 +501,10 @@ no_entry_cost: // jump here at the beginning if the node has no parent (it is th
 				break;
 			}
 
+			/* The segment data also depends on the tile the segment ends on
+			 * (choice, rail type change, ...), so count it into the bounding box. */
+			if (!is_cached_segment) segment.IncludeTile(tf_local.m_new_tile);
+
 			/* Check if the next tile is not a choice. */
 			if (KillFirstBit(tf_local.m_new_td_bits) != TRACKDIR_BIT_NONE) {
 				/* More than one segment will follow. Close this one. */
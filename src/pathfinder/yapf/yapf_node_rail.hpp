@@ -70,6 +70,11 @@ struct CYapfRailSegment
 	Trackdir               m_last_signal_td;
 	EndSegmentReasonBits   m_end_segment_reason;
 	CYapfRailSegment      *m_hash_next;
+	int                    m_version;  ///< Track layout change counter value the segment was calculated for.
+	uint16                 m_min_x;    ///< Bounding box (in tile coordinates) of the tiles the segment consists of.
+	uint16                 m_min_y;    ///< Bounding box of the segment.
+	uint16                 m_max_x;    ///< Bounding box of the segment.
+	uint16                 m_max_y;    ///< Bounding box of the segment.
 
 	inline CYapfRailSegment(const CYapfRailSegmentKey &key)
 		: m_key(key)
@@ -80,8 +85,39 @@ struct CYapfRailSegment
 		, m_last_signal_td(INVALID_TRACKDIR)
 		, m_end_segment_reason(ESRB_NONE)
 		, m_hash_next(nullptr)
+		, m_version(0)
+		, m_min_x(UINT16_MAX)
+		, m_min_y(UINT16_MAX)
+		, m_max_x(0)
+		, m_max_y(0)
 	{}
 
+	/** Extend the bounding box of the segment with the given tile. */
+	inline void IncludeTile(TileIndex tile)
+	{
+		uint x = TileX(tile);
+		uint y = TileY(tile);
+		if (x < this->m_min_x) this->m_min_x = (uint16)x;
+		if (y < this->m_min_y) this->m_min_y = (uint16)y;
+		if (x > this->m_max_x) this->m_max_x = (uint16)x;
+		if (y > this->m_max_y) this->m_max_y = (uint16)y;
+	}
+
+	/** Forget the cached cost data so the segment gets calculated again. */
+	inline void Invalidate()
+	{
+		this->m_last_tile = INVALID_TILE;
+		this->m_last_td = INVALID_TRACKDIR;
+		this->m_cost = -1;
+		this->m_last_signal_tile = INVALID_TILE;
+		this->m_last_signal_td = INVALID_TRACKDIR;
+		this->m_end_segment_reason = ESRB_NONE;
+		this->m_min_x = UINT16_MAX;
+		this->m_min_y = UINT16_MAX;
+		this->m_max_x = 0;
+		this->m_max_y = 0;
+	}
+
 	inline const Key& GetKey() const
 	{
 		return m_key;
@@ -217,8 +253,10 @@ struct CYapfRailNodeT
 typedef CYapfRailNodeT<CYapfNodeKeyExitDir>  CYapfRailNodeExitDir;
 typedef CYapfRailNodeT<CYapfNodeKeyTrackDir> CYapfRailNodeTrackDir;
 
-/* Default NodeList types */
-typedef CNodeList_HashTableT<CYapfRailNodeExitDir , 8, 10> CRailNodeListExitDir;
-typedef CNodeList_HashTableT<CYapfRailNodeTrackDir, 8, 10> CRailNodeListTrackDir;
+/* Default NodeList types. Rail costs are bounded integers, so the open list
+ * uses a monotone bucket queue instead of the binary heap; bucket granularity
+ * stays well below a tile worth of cost, so path choice is unaffected. */
+typedef CNodeList_HashTableT<CYapfRailNodeExitDir , 8, 10, CBucketQueueT<CYapfRailNodeExitDir , 4>> CRailNodeListExitDir;
+typedef CNodeList_HashTableT<CYapfRailNodeTrackDir, 8, 10, CBucketQueueT<CYapfRailNodeTrackDir, 4>> CRailNodeListTrackDir;
 
 #endif /* YAPF_NODE_RAIL_HPP */
@@ -106,6 +106,13 @@ private:
 		return tile != m_res_dest || td != m_res_dest_td;
 	}
 
+	/** Notify the segment cost cache of a tile of the now reserved path. */
+	bool NotifyReservedTile(TileIndex tile, Trackdir td)
+	{
+		YapfNotifyTrackLayoutChange(tile, TrackdirToTrack(td));
+		return true;
+	}
+
 	/** Unreserve a single track/platform. Stops when the previous failer is reached. */
 	bool UnreserveSingleTrack(TileIndex tile, Trackdir td)
 	{
@@ -178,7 +185,11 @@ public:
 		if (target != nullptr) target->okay = true;
 
 		if (Yapf().CanUseGlobalCache(*m_res_node)) {
-			YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+			/* The reservation changed the state of the tiles along the path;
+			 * invalidate the cache regions it crosses instead of the whole cache. */
+			for (Node *node = m_res_node; node->m_parent != nullptr; node = node->m_parent) {
+				node->IterateTiles(Yapf().GetVehicle(), Yapf(), *this, &CYapfReserveTrack<Types>::NotifyReservedTile);
+			}
 		}
 
 		return true;
@@ -395,19 +406,19 @@ public:
 		return 't';
 	}
 
-	static Trackdir stChooseRailTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
+	static Trackdir stChooseRailTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest, TrainPathCache *path_cache)
 	{
 		/* create pathfinder instance */
 		Tpf pf1;
 		Trackdir result1;
 
 		if (_debug_desync_level < 2) {
-			result1 = pf1.ChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest);
+			result1 = pf1.ChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest, path_cache);
 		} else {
-			result1 = pf1.ChooseRailTrack(v, tile, enterdir, tracks, path_found, false, nullptr, nullptr);
+			result1 = pf1.ChooseRailTrack(v, tile, enterdir, tracks, path_found, false, nullptr, nullptr, nullptr);
 			Tpf pf2;
 			pf2.DisableCache(true);
-			Trackdir result2 = pf2.ChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest);
+			Trackdir result2 = pf2.ChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest, path_cache);
 			if (result1 != result2) {
 				Debug(desync, 2, "CACHE ERROR: ChooseRailTrack() = [{}, {}]", result1, result2);
 				DumpState(pf1, pf2);
@@ -417,7 +428,7 @@ public:
 		return result1;
 	}
 
-	inline Trackdir ChooseRailTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
+	inline Trackdir ChooseRailTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest, TrainPathCache *path_cache)
 	{
 		if (target != nullptr) target->tile = INVALID_TILE;
 		if (dest != nullptr) *dest = INVALID_TILE;
@@ -439,13 +450,31 @@ public:
 
 			/* path was found or at least suggested
 			 * walk through the path back to the origin */
+			uint steps = 0;
+			if (path_cache != nullptr && path_found) {
+				path_cache->clear();
+				for (Node *n = pNode; n->m_parent != nullptr; n = n->m_parent) steps++;
+			}
 			Node *pPrev = nullptr;
 			while (pNode->m_parent != nullptr) {
+				if (path_cache != nullptr && path_found) {
+					steps--;
+					/* Store the part of the path near the origin, skipping the
+					 * first node which is returned as next_trackdir below. The
+					 * path is built walking backwards, so push to the front.
+					 * A node may span a whole segment of tiles; only its first
+					 * tile is a choice point, which is all the cache needs. */
+					if (steps > 0 && steps < (uint)YAPF_TRAIN_PATH_CACHE_LENGTH) {
+						path_cache->td.push_front(pNode->GetTrackdir());
+						path_cache->tile.push_front(pNode->GetTile());
+					}
+				}
 				pPrev = pNode;
 				pNode = pNode->m_parent;
 
 				this->FindSafePositionOnNode(pPrev);
 			}
+			if (path_cache != nullptr && path_found) path_cache->dest_tile = v->dest_tile;
 			/* return trackdir from the best origin node (one of start nodes) */
 			Node &best_next_node = *pPrev;
 			next_trackdir = best_next_node.GetTrackdir();
@@ -532,10 +561,10 @@ struct CYapfAnySafeTileRail1 : CYapfT<CYapfRail_TypesT<CYapfAnySafeTileRail1, CF
 struct CYapfAnySafeTileRail2 : CYapfT<CYapfRail_TypesT<CYapfAnySafeTileRail2, CFollowTrackFreeRailNo90, CRailNodeListTrackDir, CYapfDestinationAnySafeTileRailT , CYapfFollowAnySafeTileRailT> > {};
 
 
-Track YapfTrainChooseTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
+Track YapfTrainChooseTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest, TrainPathCache *path_cache)
 {
 	/* default is YAPF type 2 */
-	typedef Trackdir (*PfnChooseRailTrack)(const Train*, TileIndex, DiagDirection, TrackBits, bool&, bool, PBSTileInfo*, TileIndex*);
+	typedef Trackdir (*PfnChooseRailTrack)(const Train*, TileIndex, DiagDirection, TrackBits, bool&, bool, PBSTileInfo*, TileIndex*, TrainPathCache*);
 	PfnChooseRailTrack pfnChooseRailTrack = &CYapfRail1::stChooseRailTrack;
 
 	/* check if non-default YAPF type needed */
@@ -543,7 +572,7 @@ Track YapfTrainChooseTrack(const Train *v, TileIndex tile, DiagDirection enterdi
 		pfnChooseRailTrack = &CYapfRail2::stChooseRailTrack; // Trackdir, forbid 90-deg
 	}
 
-	Trackdir td_ret = pfnChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest);
+	Trackdir td_ret = pfnChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest, path_cache);
 	return (td_ret != INVALID_TRACKDIR) ? TrackdirToTrack(td_ret) : FindFirstTrack(tracks);
 }
 
@@ -640,8 +669,15 @@ bool YapfTrainFindNearestSafeTile(const Train *v, TileIndex tile, Trackdir td, b
 
 /** if any track changes, this counter is incremented - that will invalidate segment cost cache */
 int CSegmentCostCacheBase::s_rail_change_counter = 0;
+int CSegmentCostCacheBase::s_rail_flush_counter = 0;
+int CSegmentCostCacheBase::s_region_change_counter[1 << (2 * CSegmentCostCacheBase::REGION_GRID_LOG)] = {};
 
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track)
 {
 	CSegmentCostCacheBase::NotifyTrackLayoutChange(tile, track);
+
+	/* Cached train paths may run through the changed track, drop them. */
+	for (Train *t : Train::Iterate()) {
+		if (t->IsFrontEngine()) t->path.clear();
+	}
 }
@@ -11,6 +11,10 @@
 #include "yapf.hpp"
 #include "yapf_node_road.hpp"
 #include "../../roadstop_base.h"
+#include "../../date_func.h"
+
+#include <map>
+#include <tuple>
 
 #include "../../safeguards.h"
 
@@ -529,8 +533,77 @@ struct CYapfRoadAnyDepot1 : CYapfT<CYapfRoad_TypesT<CYapfRoadAnyDepot1, CRoadNod
 struct CYapfRoadAnyDepot2 : CYapfT<CYapfRoad_TypesT<CYapfRoadAnyDepot2, CRoadNodeListExitDir , CYapfDestinationAnyDepotRoadT> > {};
 
 
+/**
+ * Shared route-choice cache for road vehicles. Vehicles of the same 'line'
+ * keep making the same choice at the same junction; remember the outcome of
+ * a full pathfinder run for a short while and serve followers from the
+ * cache instead of searching again. The cache is filled and consulted only
+ * by the deterministic simulation, so it stays identical on all clients.
+ */
+struct RoadRouteCacheEntry {
+	Trackdir td;          ///< The trackdir chosen by the full pathfinder run.
+	uint64 expiry;        ///< Tick from which this entry is no longer valid.
+	uint layout_counter;  ///< Value of #_road_layout_change_counter when this entry was stored.
+};
+
+/** Key: where the vehicle is, where it wants to go, and the vehicle properties the choice depends on. */
+typedef std::tuple<TileIndex, uint32, DiagDirection, RoadType, byte> RoadRouteCacheKey;
+
+static std::map<RoadRouteCacheKey, RoadRouteCacheEntry> _road_route_cache;
+
+/** Incremented on every road layout change; invalidates all older cache entries. */
+static uint _road_layout_change_counter = 0;
+
+static const uint ROAD_ROUTE_CACHE_TTL = 128;            ///< Lifetime of a cached route choice, in ticks.
+static const size_t ROAD_ROUTE_CACHE_MAX_SIZE = 1 << 14; ///< Flush the cache entirely when it grows beyond this many entries.
+
+/**
+ * Build the route cache key for a route choice of a vehicle at a junction.
+ * Occupancy and speed penalties are deliberately not part of the key; they
+ * only drift within the lifetime of an entry.
+ */
+static RoadRouteCacheKey MakeRoadRouteCacheKey(const RoadVehicle *v, TileIndex tile, DiagDirection enterdir)
+{
+	uint32 dest;
+	if (v->current_order.IsType(OT_GOTO_STATION)) {
+		/* Tiles never reach bit 31; use it to separate stations from tiles. */
+		dest = 1U << 31 | v->current_order.GetDestination();
+	} else {
+		dest = v->dest_tile;
+	}
+	byte veh_flags = (v->IsBus() ? 1 : 0) | (v->HasArticulatedPart() ? 2 : 0);
+	return RoadRouteCacheKey(tile, dest, enterdir, v->roadtype, veh_flags);
+}
+
+/**
+ * Use this function to notify YAPF that the road layout has changed.
+ * All cached road vehicle route choices may run through the changed
+ * tile, so they are all dropped.
+ * @param tile the tile that is changed
+ */
+void YapfNotifyRoadLayoutChange(TileIndex tile)
+{
+	_road_layout_change_counter++;
+	if (_road_route_cache.size() >= ROAD_ROUTE_CACHE_MAX_SIZE) _road_route_cache.clear();
+}
+
 Trackdir YapfRoadVehicleChooseTrack(const RoadVehicle *v, TileIndex tile, DiagDirection enterdir, TrackdirBits trackdirs, bool &path_found, RoadVehPathCache &path_cache)
 {
+	/* Consult the shared route cache before running a full search. Entries
+	 * are validated against the currently reachable trackdirs, so a stale
+	 * entry can never send a vehicle onto road that is no longer there. */
+	RoadRouteCacheKey key = MakeRoadRouteCacheKey(v, tile, enterdir);
+	auto it = _road_route_cache.find(key);
+	if (it != _road_route_cache.end()) {
+		if (it->second.layout_counter == _road_layout_change_counter &&
+				it->second.expiry > _tick_counter &&
+				HasTrackdir(trackdirs, it->second.td)) {
+			path_found = true;
+			return it->second.td;
+		}
+		_road_route_cache.erase(it);
+	}
+
 	/* default is YAPF type 2 */
 	typedef Trackdir (*PfnChooseRoadTrack)(const RoadVehicle*, TileIndex, DiagDirection, bool &path_found, RoadVehPathCache &path_cache);
 	PfnChooseRoadTrack pfnChooseRoadTrack = &CYapfRoad2::stChooseRoadTrack; // default: ExitDir, allow 90-deg
@@ -541,6 +614,14 @@ Trackdir YapfRoadVehicleChooseTrack(const RoadVehicle *v, TileIndex tile, DiagDi
 	}
 
 	Trackdir td_ret = pfnChooseRoadTrack(v, tile, enterdir, path_found, path_cache);
+
+	/* Only remember full successes; failed searches must keep the usual
+	 * lost-vehicle handling and are rare enough not to need caching. */
+	if (path_found && td_ret != INVALID_TRACKDIR) {
+		if (_road_route_cache.size() >= ROAD_ROUTE_CACHE_MAX_SIZE) _road_route_cache.clear();
+		_road_route_cache[key] = {td_ret, _tick_counter + ROAD_ROUTE_CACHE_TTL, _road_layout_change_counter};
+	}
+
 	return (td_ret != INVALID_TRACKDIR) ? td_ret : (Trackdir)FindFirstBit2x64(trackdirs);
 }
 
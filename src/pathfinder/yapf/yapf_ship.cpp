@@ -14,6 +14,7 @@
 
 #include "yapf.hpp"
 #include "yapf_node_ship.hpp"
+#include "../water_regions.h"
 
 #include "../../safeguards.h"
 
@@ -125,7 +126,7 @@ public:
 	inline void PfFollowNode(Node &old_node)
 	{
 		TrackFollower F(Yapf().GetVehicle());
-		if (F.Follow(old_node.m_key.m_tile, old_node.m_key.m_td)) {
+		if (F.Follow(old_node.m_key.m_tile, old_node.m_key.m_td) && IsTileInShipPathCorridor(F.m_new_tile)) {
 			Yapf().AddMultipleNodes(&old_node, F);
 		}
 	}
@@ -158,42 +159,57 @@ public:
 		/* convert origin trackdir to TrackdirBits */
 		TrackdirBits trackdirs = TrackdirToTrackdirBits(trackdir);
 
-		/* create pathfinder instance */
-		Tpf pf;
-		/* set origin and destination nodes */
-		pf.SetOrigin(src_tile, trackdirs);
-		pf.SetDestination(v);
-		/* find best path */
-		path_found = pf.FindPath(v);
-
 		Trackdir next_trackdir = INVALID_TRACKDIR; // this would mean "path not found"
 
-		Node *pNode = pf.GetBestNode();
-		if (pNode != nullptr) {
-			uint steps = 0;
-			for (Node *n = pNode; n->m_parent != nullptr; n = n->m_parent) steps++;
-			uint skip = 0;
-			if (path_found) skip = YAPF_SHIP_PATH_CACHE_LENGTH / 2;
-
-			/* walk through the path back to the origin */
-			Node *pPrevNode = nullptr;
-			while (pNode->m_parent != nullptr) {
-				steps--;
-				/* Skip tiles at end of path near destination. */
-				if (skip > 0) skip--;
-				if (skip == 0 && steps > 0 && steps < YAPF_SHIP_PATH_CACHE_LENGTH) {
-					path_cache.push_front(pNode->GetTrackdir());
+		/* Region-level pre-search: restrict the tile-level search to a corridor
+		 * of water regions around the coarse route to the destination. The
+		 * region graph overestimates connectivity, so a failed restricted
+		 * search is retried without the corridor. */
+		bool restricted = ComputeShipPathCorridor(src_tile, v->dest_tile);
+		for (;;) {
+			/* create pathfinder instance */
+			Tpf pf;
+			/* set origin and destination nodes */
+			pf.SetOrigin(src_tile, trackdirs);
+			pf.SetDestination(v);
+			/* find best path */
+			path_found = pf.FindPath(v);
+
+			if (!path_found && restricted) {
+				ClearShipPathCorridor();
+				restricted = false;
+				continue;
+			}
+
+			Node *pNode = pf.GetBestNode();
+			if (pNode != nullptr) {
+				uint steps = 0;
+				for (Node *n = pNode; n->m_parent != nullptr; n = n->m_parent) steps++;
+				uint skip = 0;
+				if (path_found) skip = YAPF_SHIP_PATH_CACHE_LENGTH / 2;
+
+				/* walk through the path back to the origin */
+				Node *pPrevNode = nullptr;
+				while (pNode->m_parent != nullptr) {
+					steps--;
+					/* Skip tiles at end of path near destination. */
+					if (skip > 0) skip--;
+					if (skip == 0 && steps > 0 && steps < YAPF_SHIP_PATH_CACHE_LENGTH) {
+						path_cache.push_front(pNode->GetTrackdir());
+					}
+					pPrevNode = pNode;
+					pNode = pNode->m_parent;
 				}
-				pPrevNode = pNode;
-				pNode = pNode->m_parent;
+				/* return trackdir from the best next node (direct child of origin) */
+				Node &best_next_node = *pPrevNode;
+				assert(best_next_node.GetTile() == tile);
+				next_trackdir = best_next_node.GetTrackdir();
+				/* remove last element for the special case when tile == dest_tile */
+				if (path_found && !path_cache.empty()) path_cache.pop_back();
 			}
-			/* return trackdir from the best next node (direct child of origin) */
-			Node &best_next_node = *pPrevNode;
-			assert(best_next_node.GetTile() == tile);
-			next_trackdir = best_next_node.GetTrackdir();
-			/* remove last element for the special case when tile == dest_tile */
-			if (path_found && !path_cache.empty()) path_cache.pop_back();
+			break;
 		}
+		ClearShipPathCorridor();
 		return next_trackdir;
 	}
 
@@ -10,18 +10,28 @@
 #include "stdafx.h"
 #include "random_access_file_type.h"
 
+#include "core/alloc_func.hpp"
 #include "debug.h"
 #include "fileio_func.h"
 #include "string_func.h"
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 #include "safeguards.h"
 
 /**
  * Create the RandomAccesFile.
  * @param filename Name of the file at the disk.
  * @param subdir   The sub directory to search this file in.
+ * @param resident Whether to map the whole file into memory; reads are then
+ *                 served straight from the page cache instead of through the
+ *                 small read buffer. Meant for files that are read a lot and
+ *                 in random order, like the GRFs of the sprite cache.
  */
-RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory subdir) : filename(filename)
+RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory subdir, bool resident) :
+		filename(filename), mapped(nullptr), mapped_size(0), mapped_by_os(false)
 {
 	this->file_handle = FioFOpenFile(filename, "rb", subdir);
 	if (this->file_handle == nullptr) usererror("Cannot open file '%s'", filename.c_str());
@@ -36,14 +46,56 @@ RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory sub
 	this->simplified_filename = name_without_path.substr(0, name_without_path.rfind('.'));
 	strtolower(this->simplified_filename);
 
+	if (resident) this->MapResident();
+
 	this->SeekTo((size_t)pos, SEEK_SET);
 }
 
+/**
+ * Try to map the whole file into memory. Uses the OS mapping facility where
+ * available and falls back to reading the file into an allocated buffer.
+ * On failure the file simply stays in buffered mode.
+ */
+void RandomAccessFile::MapResident()
+{
+	if (fseek(this->file_handle, 0, SEEK_END) != 0) return;
+	long size = ftell(this->file_handle);
+	if (size <= 0) return;
+	this->mapped_size = (size_t)size;
+
+#ifndef _WIN32
+	void *map = mmap(nullptr, this->mapped_size, PROT_READ, MAP_SHARED, fileno(this->file_handle), 0);
+	if (map != MAP_FAILED) {
+		this->mapped = static_cast<const byte *>(map);
+		this->mapped_by_os = true;
+		return;
+	}
+#endif
+
+	byte *mem = MallocT<byte>(this->mapped_size);
+	if (fseek(this->file_handle, 0, SEEK_SET) != 0 || fread(mem, 1, this->mapped_size, this->file_handle) != this->mapped_size) {
+		free(mem);
+		this->mapped_size = 0;
+		return;
+	}
+	this->mapped = mem;
+}
+
 /**
  * Close the file's file handle.
  */
 RandomAccessFile::~RandomAccessFile()
 {
+	if (this->mapped != nullptr) {
+#ifndef _WIN32
+		if (this->mapped_by_os) {
+			munmap(const_cast<byte *>(this->mapped), this->mapped_size);
+		} else
+#endif
+		{
+			free(const_cast<byte *>(this->mapped));
+		}
+	}
 	fclose(this->file_handle);
 }
 
@@ -84,6 +136,16 @@ void RandomAccessFile::SeekTo(size_t pos, int mode)
 {
 	if (mode == SEEK_CUR) pos += this->GetPos();
 
+	if (this->mapped != nullptr) {
+		/* Make the whole mapping the read buffer; GetPos() keeps working as
+		 * it is defined relative to the end of the buffer. */
+		pos = std::min(pos, this->mapped_size);
+		this->buffer = const_cast<byte *>(this->mapped) + pos;
+		this->buffer_end = const_cast<byte *>(this->mapped) + this->mapped_size;
+		this->pos = this->mapped_size;
+		return;
+	}
+
 	this->pos = pos;
 	if (fseek(this->file_handle, this->pos, SEEK_SET) < 0) {
 		Debug(misc, 0, "Seeking in {} failed", this->filename);
@@ -100,6 +162,8 @@ void RandomAccessFile::SeekTo(size_t pos, int mode)
 byte RandomAccessFile::ReadByte()
 {
 	if (this->buffer == this->buffer_end) {
+		if (this->mapped != nullptr) return 0; // End of the mapped file.
+
 		this->buffer = this->buffer_start;
 		size_t size = fread(this->buffer, 1, RandomAccessFile::BUFFER_SIZE, this->file_handle);
 		this->pos += size;
@@ -137,6 +201,13 @@ uint32 RandomAccessFile::ReadDword()
  */
 void RandomAccessFile::ReadBlock(void *ptr, size_t size)
 {
+	if (this->mapped != nullptr) {
+		size = std::min<size_t>(size, this->buffer_end - this->buffer);
+		memcpy(ptr, this->buffer, size);
+		this->buffer += size;
+		return;
+	}
+
 	this->SeekTo(this->GetPos(), SEEK_SET);
 	this->pos += fread(ptr, 1, size, this->file_handle);
 }
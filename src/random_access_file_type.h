@@ -30,12 +30,18 @@ class RandomAccessFile {
 	FILE *file_handle;               ///< File handle of the open file.
 	size_t pos;                      ///< Position in the file of the end of the read buffer.
 
+	const byte *mapped;              ///< Start of the memory mapped (or memory resident) file content, or \c nullptr when reading buffered.
+	size_t mapped_size;              ///< Size of the mapped/resident file content.
+	bool mapped_by_os;               ///< Whether #mapped was created by the OS mapping facility rather than allocated.
+
 	byte *buffer;                    ///< Current position within the local buffer.
 	byte *buffer_end;                ///< Last valid byte of buffer.
 	byte buffer_start[BUFFER_SIZE];  ///< Local buffer when read from file.
 
+	void MapResident();
+
 public:
-	RandomAccessFile(const std::string &filename, Subdirectory subdir);
+	RandomAccessFile(const std::string &filename, Subdirectory subdir, bool resident = false);
 	RandomAccessFile(const RandomAccessFile&) = delete;
 	void operator=(const RandomAccessFile&) = delete;
 
@@ -14,6 +14,7 @@
 #include "command_func.h"
 #include "pathfinder/yapf/yapf_cache.h"
 #include "depot_base.h"
+#include "depot_func.h"
 #include "newgrf.h"
 #include "autoslope.h"
 #include "tunnelbridge_map.h"
@@ -401,6 +402,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 					MarkTileDirtyByTile(tile);
 					MarkTileDirtyByTile(other_end);
 				}
+				YapfNotifyRoadLayoutChange(tile);
 			}
 		} else {
 			assert(IsDriveThroughStopTile(tile));
@@ -410,6 +412,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 				UpdateCompanyRoadInfrastructure(existing_rt, GetRoadOwner(tile, rtt), -2);
 				SetRoadType(tile, rtt, INVALID_ROADTYPE);
 				MarkTileDirtyByTile(tile);
+				YapfNotifyRoadLayoutChange(tile);
 			}
 		}
 		return cost;
@@ -487,6 +490,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 					SetRoadBits(tile, present, rtt);
 					MarkTileDirtyByTile(tile);
 				}
+				YapfNotifyRoadLayoutChange(tile);
 			}
 
 			CommandCost cost(EXPENSES_CONSTRUCTION, CountBits(pieces) * RoadClearCost(existing_rt));
@@ -526,6 +530,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 				}
 				MarkTileDirtyByTile(tile);
 				YapfNotifyTrackLayoutChange(tile, railtrack);
+				YapfNotifyRoadLayoutChange(tile);
 			}
 			return CommandCost(EXPENSES_CONSTRUCTION, RoadClearCost(existing_rt) * 2);
 		}
@@ -688,6 +693,7 @@ CommandCost CmdBuildRoad(DoCommandFlag flags, TileIndex tile, RoadBits pieces, R
 							if ((flags & DC_EXEC) && IsStraightRoad(existing)) {
 								SetDisallowedRoadDirections(tile, dis_new);
 								MarkTileDirtyByTile(tile);
+								YapfNotifyRoadLayoutChange(tile);
 							}
 							return CommandCost();
 						}
@@ -766,6 +772,7 @@ CommandCost CmdBuildRoad(DoCommandFlag flags, TileIndex tile, RoadBits pieces, R
 			if (flags & DC_EXEC) {
 				Track railtrack = AxisToTrack(OtherAxis(roaddir));
 				YapfNotifyTrackLayoutChange(tile, railtrack);
+				YapfNotifyRoadLayoutChange(tile);
 				/* Update company infrastructure counts. A level crossing has two road bits. */
 				UpdateCompanyRoadInfrastructure(rt, company, 2);
 
@@ -937,6 +944,7 @@ do_clear:;
 		}
 
 		MarkTileDirtyByTile(tile);
+		YapfNotifyRoadLayoutChange(tile);
 	}
 	return cost;
 }
@@ -1171,12 +1179,14 @@ CommandCost CmdBuildRoadDepot(DoCommandFlag flags, TileIndex tile, RoadType rt,
 	if (flags & DC_EXEC) {
 		Depot *dep = new Depot(tile);
 		dep->build_date = _date;
+		InvalidateDepotKdtrees();
 
 		/* A road depot has two road bits. */
 		UpdateCompanyRoadInfrastructure(rt, _current_company, ROAD_DEPOT_TRACKBIT_FACTOR);
 
 		MakeRoadDepot(tile, _current_company, dep->index, dir, rt);
 		MarkTileDirtyByTile(tile);
+		YapfNotifyRoadLayoutChange(tile);
 		MakeDefaultName(dep);
 	}
 	cost.AddCost(_price[PR_BUILD_DEPOT_ROAD]);
@@ -1205,6 +1215,7 @@ static CommandCost RemoveRoadDepot(TileIndex tile, DoCommandFlag flags)
 
 		delete Depot::GetByTile(tile);
 		DoClearSquare(tile);
+		YapfNotifyRoadLayoutChange(tile);
 	}
 
 	return CommandCost(EXPENSES_CONSTRUCTION, _price[PR_CLEAR_DEPOT_ROAD]);
@@ -117,6 +117,10 @@ struct RoadVehicle FINAL : public GroundVehicle<RoadVehicle, VEH_ROAD> {
 	RoadType roadtype;              //!< Roadtype of this vehicle.
 	RoadTypes compatible_roadtypes; //!< Roadtypes this consist is powered on.
 
+	RoadVehicle *hash_road_next;     ///< NOSAVE: Next road vehicle in the road vehicle tile hash.
+	RoadVehicle **hash_road_prev;    ///< NOSAVE: Previous road vehicle in the road vehicle tile hash.
+	RoadVehicle **hash_road_current; ///< NOSAVE: Cache of the current road vehicle hash chain.
+
 	/** We don't want GCC to zero our struct! It already is zeroed and has an index! */
 	RoadVehicle() : GroundVehicleBase() {}
 	/** We want to 'destruct' the right class. */
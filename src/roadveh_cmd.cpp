@@ -25,6 +25,7 @@
 #include "ai/ai.hpp"
 #include "game/game.hpp"
 #include "depot_map.h"
+#include "depot_func.h"
 #include "effectvehicle_func.h"
 #include "roadstop_base.h"
 #include "spritecache.h"
@@ -338,6 +339,16 @@ static FindDepotData FindClosestRoadDepot(const RoadVehicle *v, int max_distance
 {
 	if (IsRoadDepotTile(v->tile)) return FindDepotData(v->tile, 0);
 
+	/* Ask the k-d tree for the closest depot candidate first. The pathfinders
+	 * measure along roads, which is never shorter than the Manhattan distance
+	 * to the closest depot of the right owner, so without a candidate close
+	 * enough there is no point in running the expensive search at all. */
+	TileIndex candidate = FindClosestDepotCandidate(v->tile, v->owner, VEH_ROAD);
+	if (candidate == INVALID_TILE) return FindDepotData();
+	/* Curved road pieces cost half a tile, hence the conservative half tile
+	 * of penalty per tile of distance. */
+	if (max_distance > 0 && DistanceManhattan(v->tile, candidate) * (YAPF_TILE_LENGTH / 2) > (uint)max_distance) return FindDepotData();
+
 	switch (_settings_game.pf.pathfinder_for_roadvehs) {
 		case VPF_NPF: return NPFRoadVehicleFindNearestDepot(v, max_distance);
 		case VPF_YAPF: return YapfRoadVehicleFindNearestDepot(v, max_distance);
@@ -655,10 +666,10 @@ static RoadVehicle *RoadVehFindCloseTo(RoadVehicle *v, int x, int y, Direction d
 	rvf.best_diff = UINT_MAX;
 
 	if (front->state == RVSB_WORMHOLE) {
-		FindVehicleOnPos(v->tile, &rvf, EnumCheckRoadVehClose);
-		FindVehicleOnPos(GetOtherTunnelBridgeEnd(v->tile), &rvf, EnumCheckRoadVehClose);
+		FindRoadVehicleOnPos(v->tile, &rvf, EnumCheckRoadVehClose);
+		FindRoadVehicleOnPos(GetOtherTunnelBridgeEnd(v->tile), &rvf, EnumCheckRoadVehClose);
 	} else {
-		FindVehicleOnPosXY(x, y, &rvf, EnumCheckRoadVehClose);
+		FindRoadVehicleOnPosXY(x, y, &rvf, EnumCheckRoadVehClose);
 	}
 
 	/* This code protects a roadvehicle from being blocked for ever
@@ -790,7 +801,7 @@ static bool CheckRoadBlockedForOvertaking(OvertakeData *od)
 	if (!HasBit(trackdirbits, od->trackdir) || (trackbits & ~TRACK_BIT_CROSS) || (red_signals != TRACKDIR_BIT_NONE)) return true;
 
 	/* Are there more vehicles on the tile except the two vehicles involved in overtaking */
-	return HasVehicleOnPos(od->tile, od, EnumFindVehBlockingOvertake);
+	return HasRoadVehicleOnPos(od->tile, od, EnumFindVehBlockingOvertake);
 }
 
 static void RoadVehCheckOvertake(RoadVehicle *v, RoadVehicle *u)
@@ -581,6 +581,10 @@ bool AfterLoadGame()
 	 * that otherwise won't exist in the tree. */
 	RebuildViewportKdtree();
 
+	/* The vehicle tile hash is sized from the map, which was not yet
+	 * allocated when InitializeVehicles() ran. */
+	ResetVehicleHash();
+
 	if (IsSavegameVersionBefore(SLV_98)) GamelogGRFAddList(_grfconfig);
 
 	if (IsSavegameVersionBefore(SLV_119)) {
@@ -630,18 +634,22 @@ bool AfterLoadGame()
 
 		/* In old savegame versions, the heightlevel was coded in bits 0..3 of the type field */
 		for (TileIndex t = 0; t < map_size; t++) {
-			_m[t].height = GB(_m[t].type, 0, 4);
-			SB(_m[t].type, 0, 2, GB(_me[t].m6, 0, 2));
+			_mb[t].height = GB(_mb[t].type, 0, 4);
+			SB(_mb[t].type, 0, 2, GB(_me[t].m6, 0, 2));
 			SB(_me[t].m6, 0, 2, 0);
 			if (MayHaveBridgeAbove(t)) {
-				SB(_m[t].type, 2, 2, GB(_me[t].m6, 6, 2));
+				SB(_mb[t].type, 2, 2, GB(_me[t].m6, 6, 2));
 				SB(_me[t].m6, 6, 2, 0);
 			} else {
-				SB(_m[t].type, 2, 2, 0);
+				SB(_mb[t].type, 2, 2, 0);
 			}
 		}
 	}
 
+	/* The heights were loaded directly into the map array, so the slope
+	 * cache does not know about them yet. */
+	InitializeTileSlopeCache();
+
 	/* in version 2.1 of the savegame, town owner was unified. */
 	if (IsSavegameVersionBefore(SLV_2, 1)) ConvertTownOwner();
 
@@ -730,6 +738,10 @@ bool AfterLoadGame()
 	/* The value of _date_fract got divided, so make sure that old games are converted correctly. */
 	if (IsSavegameVersionBefore(SLV_11, 1) || (IsSavegameVersionBefore(SLV_147) && _date_fract > DAY_TICKS)) _date_fract /= 885;
 
+	/* Older versions ran the daily/monthly loops at the day boundary itself;
+	 * skip the deferred slots so those loops do not run a second time. */
+	if (IsSavegameVersionBefore(SLV_DEFERRED_DATE_EVENTS) && _date_fract >= 1 && _date_fract <= 5) _date_fract = 6;
+
 	/* Update current year
 	 * must be done before loading sprites as some newgrfs check it */
 	SetDate(_date, _date_fract);
@@ -1402,6 +1414,7 @@ bool AfterLoadGame()
 	}
 
 	YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+	YapfNotifyRoadLayoutChange(INVALID_TILE);
 
 	if (IsSavegameVersionBefore(SLV_34)) {
 		for (Company *c : Company::Iterate()) ResetCompanyLivery(c);
@@ -2678,6 +2691,27 @@ bool AfterLoadGame()
 			assert(v->tile != TileVirtXY(v->x_pos, v->y_pos) || v->z_pos == GetSlopePixelZ(v->x_pos, v->y_pos));
 		}
 
+		/* The loop above changed inclination flags directly, so the cached
+		 * total slope resistance of the consists has to be refreshed. */
+		for (Vehicle *v : Vehicle::Iterate()) {
+			switch (v->type) {
+				case VEH_TRAIN: {
+					Train *t = Train::From(v);
+					if (t->IsFrontEngine() || t->IsFreeWagon()) t->gcache.cached_total_slope_resistance = t->CalcTotalSlopeResistance();
+					break;
+				}
+
+				case VEH_ROAD: {
+					RoadVehicle *rv = RoadVehicle::From(v);
+					if (rv->IsFrontEngine()) rv->gcache.cached_total_slope_resistance = rv->CalcTotalSlopeResistance();
+					break;
+				}
+
+				default:
+					break;
+			}
+		}
+
 		/* Fill Vehicle::cur_real_order_index */
 		for (Vehicle *v : Vehicle::Iterate()) {
 			if (!v->IsPrimaryVehicle()) continue;
@@ -3194,6 +3228,13 @@ bool AfterLoadGame()
 		}
 	}
 
+	if (IsSavegameVersionBefore(SLV_WATER_TILE_NON_FLOODING)) {
+		/* Ensure that the previously unused non-flooding state bit is clear. */
+		for (TileIndex t = 0; t < Map::Size(); t++) {
+			if (IsTileType(t, MP_WATER)) SetNonFloodingWaterTile(t, false);
+		}
+	}
+
 	/* Compute station catchment areas. This is needed here in case UpdateStationAcceptance is called below. */
 	Station::RecomputeCatchmentForAll();
 
@@ -3247,6 +3288,8 @@ void ReloadNewGRFData()
 	GfxLoadSprites();
 	LoadStringWidthTable();
 	RecomputePrices();
+	/* the wire and pylon sprites may have changed */
+	ClearRailCatenaryCache();
 	/* reload vehicles */
 	ResetVehicleHash();
 	AfterLoadVehicles(false);
@@ -96,6 +96,7 @@ SaveLoadTable GetCargoPacketDesc()
 		     SLE_VAR(CargoPacket, feeder_share,    SLE_INT64),
 		 SLE_CONDVAR(CargoPacket, source_type,     SLE_UINT8,  SLV_125, SL_MAX_VERSION),
 		 SLE_CONDVAR(CargoPacket, source_id,       SLE_UINT16, SLV_125, SL_MAX_VERSION),
+	 SLE_CONDVAR(CargoPacket, age_epoch,       SLE_UINT32, SLV_LAZY_CARGO_AGING, SL_MAX_VERSION),
 	};
 	return _cargopacket_desc;
 }
@@ -42,41 +42,71 @@ public:
 
 	void Save(Node *bn) const override
 	{
-		uint16 size = 0;
-		for (NodeID to = _linkgraph_from; to != INVALID_NODE; to = _linkgraph->edges[_linkgraph_from][to].next_edge) {
-			size++;
-		}
-
-		SlSetStructListLength(size);
-		for (NodeID to = _linkgraph_from; to != INVALID_NODE; to = _linkgraph->edges[_linkgraph_from][to].next_edge) {
-			SlObject(&_linkgraph->edges[_linkgraph_from][to], this->GetDescription());
+		const std::vector<Edge> &edges = _linkgraph->edges[_linkgraph_from];
+
+		SlSetStructListLength(edges.size() + 1);
+
+		/* The savegame format is a chain of edges: a dummy edge for the source
+		 * node is saved first and each edge's next_edge names the destination
+		 * of the edge that follows it. Synthesize that chain from the sorted
+		 * edge vector; the destinations themselves are not saved. */
+		Edge first;
+		first.Init();
+		first.next_edge = edges.empty() ? INVALID_NODE : edges.front().dest_node;
+		SlObject(&first, this->GetDescription());
+
+		for (size_t i = 0; i < edges.size(); ++i) {
+			Edge edge = edges[i];
+			edge.next_edge = i + 1 < edges.size() ? edges[i + 1].dest_node : INVALID_NODE;
+			SlObject(&edge, this->GetDescription());
 		}
 	}
 
 	void Load(Node *bn) const override
 	{
 		uint16 max_size = _linkgraph->Size();
+		std::vector<Edge> &edges = _linkgraph->edges[_linkgraph_from];
 
 		if (IsSavegameVersionBefore(SLV_191)) {
-			/* We used to save the full matrix ... */
+			/* We used to save the full matrix; read it into a temporary row and
+			 * keep only the edges the chain starting at the diagonal visits. */
+			std::vector<Edge> matrix_row(max_size);
 			for (NodeID to = 0; to < max_size; ++to) {
-				SlObject(&_linkgraph->edges[_linkgraph_from][to], this->GetLoadDescription());
+				matrix_row[to].Init();
+				SlObject(&matrix_row[to], this->GetLoadDescription());
 			}
+			for (NodeID to = matrix_row[_linkgraph_from].next_edge; to != INVALID_NODE; to = matrix_row[to].next_edge) {
+				matrix_row[to].dest_node = to;
+				edges.push_back(matrix_row[to]);
+			}
+			std::sort(edges.begin(), edges.end());
 			return;
 		}
 
 		size_t used_size = IsSavegameVersionBefore(SLV_SAVELOAD_LIST_LENGTH) ? max_size : SlGetStructListLength(UINT16_MAX);
 
-		/* ... but as that wasted a lot of space we save a sparse matrix now. */
-		for (NodeID to = _linkgraph_from; to != INVALID_NODE; to = _linkgraph->edges[_linkgraph_from][to].next_edge) {
+		/* ... but as that wasted a lot of space we save a chain of edges now,
+		 * starting with a dummy edge for the source node. Each edge's
+		 * destination is named by the next_edge of its predecessor. */
+		Edge edge;
+		edge.Init();
+		if (used_size == 0) SlErrorCorrupt("Link graph structure overflow");
+		used_size--;
+		SlObject(&edge, this->GetLoadDescription());
+
+		for (NodeID to = edge.next_edge; to != INVALID_NODE; to = edge.next_edge) {
 			if (used_size == 0) SlErrorCorrupt("Link graph structure overflow");
 			used_size--;
 
 			if (to >= max_size) SlErrorCorrupt("Link graph structure overflow");
-			SlObject(&_linkgraph->edges[_linkgraph_from][to], this->GetLoadDescription());
+			edge.Init();
+			SlObject(&edge, this->GetLoadDescription());
+			edge.dest_node = to;
+			edges.push_back(edge);
 		}
 
 		if (!IsSavegameVersionBefore(SLV_SAVELOAD_LIST_LENGTH) && used_size > 0) SlErrorCorrupt("Corrupted link graph");
+		std::sort(edges.begin(), edges.end());
 	}
 };
 
@@ -126,6 +156,8 @@ SaveLoadTable GetLinkGraphDesc()
 		 SLE_VAR(LinkGraph, last_compression, SLE_INT32),
 		SLEG_CONDVAR("num_nodes", _num_nodes, SLE_UINT16, SL_MIN_VERSION, SLV_SAVELOAD_LIST_LENGTH),
 		 SLE_VAR(LinkGraph, cargo,            SLE_UINT8),
+		SLE_CONDVAR(LinkGraph, last_change,    SLE_INT32, SLV_LINKGRAPH_CHANGE_TRACKING, SL_MAX_VERSION),
+		SLE_CONDVAR(LinkGraph, last_job_spawn, SLE_INT32, SLV_LINKGRAPH_CHANGE_TRACKING, SL_MAX_VERSION),
 		SLEG_STRUCTLIST("nodes", SlLinkgraphNode),
 	};
 	return link_graph_desc;
@@ -19,6 +19,7 @@
 #include "../viewport_func.h"
 #include "../gfx_func.h"
 #include "../core/random_func.hpp"
+#include "../state_checksum.h"
 #include "../fios.h"
 
 #include "../safeguards.h"
@@ -85,6 +86,9 @@ static const SaveLoad _date_desc[] = {
 	SLEG_CONDVAR("next_competitor_start",  _next_competitor_start,  SLE_UINT32,                SLV_109, SL_MAX_VERSION),
 	    SLEG_VAR("trees_tick_counter",     _trees_tick_ctr,         SLE_UINT8),
 	SLEG_CONDVAR("pause_mode",             _pause_mode,             SLE_UINT8,                   SLV_4, SL_MAX_VERSION),
+	SLEG_CONDVAR("checksum_vehicle",       _state_checksums.vehicle, SLE_UINT32,                 SLV_STATE_CHECKSUMS, SL_MAX_VERSION),
+	SLEG_CONDVAR("checksum_cargo",         _state_checksums.cargo,  SLE_UINT32,                  SLV_STATE_CHECKSUMS, SL_MAX_VERSION),
+	SLEG_CONDVAR("checksum_town",          _state_checksums.town,   SLE_UINT32,                  SLV_STATE_CHECKSUMS, SL_MAX_VERSION),
 };
 
 static const SaveLoad _date_check_desc[] = {
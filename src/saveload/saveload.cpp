@@ -15,7 +15,7 @@
  * <li>use their description array (#SaveLoad) to know what elements to save and in what version
  *    of the game it was active (used when loading)
  * <li>write all data byte-by-byte to the temporary buffer so it is endian-safe
- * <li>when the buffer is full; flush it to the output (eg save to file) (_sl.buf, _sl.bufp, _sl.bufe)
+ * <li>when the buffer is full; flush it to the output (eg save to file) (_sl->buf, _sl->bufp, _sl->bufe)
  * <li>repeat this until everything is done, and flush any remaining output to file
  * </ol>
  */
@@ -24,6 +24,7 @@
 #include "../debug.h"
 #include "../station_base.h"
 #include "../thread.h"
+#include "../jobpool.h"
 #include "../town.h"
 #include "../network/network.h"
 #include "../window_func.h"
@@ -43,7 +44,10 @@
 #include "../fios.h"
 #include "../error.h"
 #include <atomic>
+#include <condition_variable>
 #include <deque>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #ifdef __EMSCRIPTEN__
@@ -129,19 +133,26 @@ struct ReadBuffer {
 
 /** Container for dumping the savegame (quickly) to memory. */
 struct MemoryDumper {
-	std::vector<byte *> blocks; ///< Buffer with blocks of allocated memory.
-	byte *buf;                  ///< Buffer we're going to write to.
-	byte *bufe;                 ///< End of the buffer we write to.
+	/** A block of memory the savegame is dumped into. */
+	struct Block {
+		byte *data;  ///< The data of the block.
+		size_t size; ///< Number of used bytes in the block.
+	};
+
+	std::vector<Block> blocks; ///< Blocks of dumped savegame data; only the last one may be written to.
+	byte *buf;                 ///< Buffer we're going to write to.
+	byte *bufe;                ///< End of the buffer we write to.
+	size_t completed_size;     ///< Total number of bytes dumped so far, except those in the block being written to.
 
 	/** Initialise our variables. */
-	MemoryDumper() : buf(nullptr), bufe(nullptr)
+	MemoryDumper() : buf(nullptr), bufe(nullptr), completed_size(0)
 	{
 	}
 
 	~MemoryDumper()
 	{
-		for (auto p : this->blocks) {
-			free(p);
+		for (auto &block : this->blocks) {
+			free(block.data);
 		}
 	}
 
@@ -153,43 +164,124 @@ struct MemoryDumper {
 	{
 		/* Are we at the end of this chunk? */
 		if (this->buf == this->bufe) {
+			if (this->buf != nullptr) this->completed_size += MEMORY_CHUNK_SIZE;
 			this->buf = CallocT<byte>(MEMORY_CHUNK_SIZE);
-			this->blocks.push_back(this->buf);
+			this->blocks.push_back({this->buf, MEMORY_CHUNK_SIZE});
 			this->bufe = this->buf + MEMORY_CHUNK_SIZE;
 		}
 
 		*this->buf++ = b;
 	}
 
+	/** Close the block currently being written to, recording its used size. */
+	void Seal()
+	{
+		if (this->buf == nullptr) return;
+
+		this->blocks.back().size = MEMORY_CHUNK_SIZE - (this->bufe - this->buf);
+		this->completed_size += this->blocks.back().size;
+		this->buf = this->bufe = nullptr;
+	}
+
 	/**
 	 * Flush this dumper into a writer.
 	 * @param writer The filter we want to use.
 	 */
 	void Flush(SaveFilter *writer)
 	{
-		uint i = 0;
-		size_t t = this->GetSize();
+		this->Seal();
 
-		while (t > 0) {
-			size_t to_write = std::min(MEMORY_CHUNK_SIZE, t);
-
-			writer->Write(this->blocks[i++], to_write);
-			t -= to_write;
+		for (const Block &block : this->blocks) {
+			writer->Write(block.data, block.size);
 		}
 
 		writer->Finish();
 	}
 
+	/**
+	 * Append the contents of another dumper to this one by taking
+	 * ownership of its blocks, without copying the data itself.
+	 * @param other The dumper to take the data from; it is left empty.
+	 */
+	void MoveFrom(MemoryDumper &other)
+	{
+		other.Seal();
+		this->Seal();
+
+		for (const Block &block : other.blocks) {
+			this->blocks.push_back(block);
+			this->completed_size += block.size;
+		}
+		other.blocks.clear();
+	}
+
+	/**
+	 * Take the finished blocks out of this dumper, transferring their
+	 * ownership to the given container. The total size (GetSize()) keeps
+	 * counting the extracted data, so it remains usable as stream offset.
+	 * @param into The container to append the blocks to.
+	 * @param seal Whether to also close and extract the block currently being written to.
+	 */
+	void ExtractBlocks(std::deque<Block> &into, bool seal)
+	{
+		if (seal) this->Seal();
+
+		size_t keep = this->buf != nullptr ? 1 : 0;
+		for (size_t i = 0; i + keep < this->blocks.size(); i++) {
+			into.push_back(this->blocks[i]);
+		}
+		this->blocks.erase(this->blocks.begin(), this->blocks.end() - keep);
+	}
+
 	/**
 	 * Get the size of the memory dump made so far.
 	 * @return The size.
 	 */
 	size_t GetSize() const
 	{
-		return this->blocks.size() * MEMORY_CHUNK_SIZE - (this->bufe - this->buf);
+		if (this->buf == nullptr) return this->completed_size;
+		return this->completed_size + MEMORY_CHUNK_SIZE - (this->bufe - this->buf);
+	}
+
+	/**
+	 * Compute a hash over all dumped data, so two dumps of the same game
+	 * state can be recognised without keeping the data of both around.
+	 * Closes the block currently being written to.
+	 * @return Hash of all bytes dumped so far.
+	 */
+	uint64 CalcHash()
+	{
+		this->Seal();
+
+		uint64 hash = 0xCBF29CE484222325ULL; // FNV-1a offset basis.
+		for (const Block &block : this->blocks) {
+			size_t i = 0;
+			for (; i + 8 <= block.size; i += 8) {
+				uint64 value;
+				memcpy(&value, block.data + i, sizeof(value));
+				hash = (hash ^ value) * 0x100000001B3ULL; // FNV-1a, a word at a time.
+			}
+			for (; i < block.size; i++) {
+				hash = (hash ^ block.data[i]) * 0x100000001B3ULL;
+			}
+		}
+		return hash;
 	}
 };
 
+/**
+ * Hand-off of finished memory blocks from the game thread to the writer
+ * thread during a streamed save, so compressing and sending the data can
+ * start before the serialisation has finished.
+ */
+struct SaveBlockQueue {
+	std::mutex mutex;                       ///< Mutex protecting all members below.
+	std::condition_variable signal;         ///< Signalled when blocks arrive or a flag is raised.
+	std::deque<MemoryDumper::Block> blocks; ///< Blocks ready to be written, in stream order.
+	bool completed = false;                 ///< Whether the game thread has produced the last block.
+	bool aborted = false;                   ///< Whether either side gave up; further blocks are discarded.
+};
+
 /** The saveload struct, containing reader-writer functions, buffer, version, etc. */
 struct SaveLoadParams {
 	SaveLoadAction action;               ///< are we doing a save or a load atm.
@@ -202,6 +294,7 @@ struct SaveLoadParams {
 	bool expect_table_header;            ///< In the case of a table, if the header is saved/loaded.
 
 	MemoryDumper *dumper;                ///< Memory dumper to write the savegame to.
+	SaveBlockQueue *block_queue;         ///< Block hand-off to the writer thread of a streamed save; \c nullptr for buffered saves.
 	SaveFilter *sf;                      ///< Filter to write the savegame to.
 
 	ReadBuffer *reader;                  ///< Savegame reading buffer.
@@ -213,7 +306,37 @@ struct SaveLoadParams {
 	bool saveinprogress;                 ///< Whether there is currently a save in progress.
 };
 
-static SaveLoadParams _sl; ///< Parameters used for/at saveload.
+static SaveLoadParams _sl_main; ///< Parameters used for/at saveload.
+
+/**
+ * Saveload state of the current thread. Normally every thread works on the
+ * shared main state; worker threads serializing independent chunks in
+ * parallel point this at a private state of their own (see SlSaveChunks()).
+ */
+static thread_local SaveLoadParams *_sl = &_sl_main;
+
+/**
+ * Hand the blocks serialized so far to the writer thread of a streamed save.
+ * When the writer gave up, e.g. because the receiving client disconnected,
+ * the blocks are discarded instead.
+ * @param completed Whether this is the last hand-off of the save.
+ */
+static void SlFlushBlockQueue(bool completed)
+{
+	SaveBlockQueue *queue = _sl->block_queue;
+
+	std::deque<MemoryDumper::Block> blocks;
+	_sl->dumper->ExtractBlocks(blocks, completed);
+
+	std::lock_guard<std::mutex> lock(queue->mutex);
+	if (queue->aborted) {
+		for (MemoryDumper::Block &block : blocks) free(block.data);
+	} else {
+		for (const MemoryDumper::Block &block : blocks) queue->blocks.push_back(block);
+	}
+	if (completed) queue->completed = true;
+	queue->signal.notify_one();
+}
 
 static const std::vector<ChunkHandlerRef> &ChunkHandlers()
 {
@@ -307,7 +430,7 @@ static const std::vector<ChunkHandlerRef> &ChunkHandlers()
 /** Null all pointers (convert index -> nullptr) */
 static void SlNullPointers()
 {
-	_sl.action = SLA_NULL;
+	_sl->action = SLA_NULL;
 
 	/* We don't want any savegame conversion code to run
 	 * during NULLing; especially those that try to get
@@ -319,7 +442,7 @@ static void SlNullPointers()
 		ch.FixPointers();
 	}
 
-	assert(_sl.action == SLA_NULL);
+	assert(_sl->action == SLA_NULL);
 }
 
 /**
@@ -333,21 +456,21 @@ static void SlNullPointers()
 void NORETURN SlError(StringID string, const char *extra_msg)
 {
 	/* Distinguish between loading into _load_check_data vs. normal save/load. */
-	if (_sl.action == SLA_LOAD_CHECK) {
+	if (_sl->action == SLA_LOAD_CHECK) {
 		_load_check_data.error = string;
 		free(_load_check_data.error_data);
 		_load_check_data.error_data = (extra_msg == nullptr) ? nullptr : stredup(extra_msg);
 	} else {
-		_sl.error_str = string;
-		free(_sl.extra_msg);
-		_sl.extra_msg = (extra_msg == nullptr) ? nullptr : stredup(extra_msg);
+		_sl->error_str = string;
+		free(_sl->extra_msg);
+		_sl->extra_msg = (extra_msg == nullptr) ? nullptr : stredup(extra_msg);
 	}
 
 	/* We have to nullptr all pointers here; we might be in a state where
 	 * the pointers are actually filled with indices, which means that
 	 * when we access them during cleaning the pool dereferences of
 	 * those indices will be made with segmentation faults as result. */
-	if (_sl.action == SLA_LOAD || _sl.action == SLA_PTRS) SlNullPointers();
+	if (_sl->action == SLA_LOAD || _sl->action == SLA_PTRS) SlNullPointers();
 
 	/* Logging could be active. */
 	GamelogStopAnyAction();
@@ -391,7 +514,8 @@ void NORETURN SlErrorCorruptFmt(const char *format, ...)
 
 typedef void (*AsyncSaveFinishProc)();                      ///< Callback for when the savegame loading is finished.
 static std::atomic<AsyncSaveFinishProc> _async_save_finish; ///< Callback to call when the savegame loading is finished.
-static std::thread _save_thread;                            ///< The thread we're using to compress and write a savegame
+static std::thread _save_thread;                            ///< The dedicated thread used when streaming a savegame to the writer.
+static JobHandle _save_job;                                 ///< The pool job compressing and writing a non-streamed savegame.
 
 /**
  * Called by save thread to tell we finished saving.
@@ -418,6 +542,7 @@ void ProcessAsyncSaveFinish()
 	if (_save_thread.joinable()) {
 		_save_thread.join();
 	}
+	_save_job.Join();
 }
 
 /**
@@ -426,7 +551,7 @@ void ProcessAsyncSaveFinish()
  */
 byte SlReadByte()
 {
-	return _sl.reader->ReadByte();
+	return _sl->reader->ReadByte();
 }
 
 /**
@@ -435,7 +560,7 @@ byte SlReadByte()
  */
 void SlWriteByte(byte b)
 {
-	_sl.dumper->WriteByte(b);
+	_sl->dumper->WriteByte(b);
 }
 
 static inline int SlReadUint16()
@@ -660,8 +785,8 @@ static inline size_t SlCalcRefLen()
 
 void SlSetArrayIndex(uint index)
 {
-	_sl.need_length = NL_WANTLENGTH;
-	_sl.array_index = index;
+	_sl->need_length = NL_WANTLENGTH;
+	_sl->array_index = index;
 }
 
 static size_t _next_offs;
@@ -676,29 +801,29 @@ int SlIterateArray()
 
 	/* After reading in the whole array inside the loop
 	 * we must have read in all the data, so we must be at end of current block. */
-	if (_next_offs != 0 && _sl.reader->GetSize() != _next_offs) SlErrorCorrupt("Invalid chunk size");
+	if (_next_offs != 0 && _sl->reader->GetSize() != _next_offs) SlErrorCorrupt("Invalid chunk size");
 
 	for (;;) {
 		uint length = SlReadArrayLength();
 		if (length == 0) {
-			assert(!_sl.expect_table_header);
+			assert(!_sl->expect_table_header);
 			_next_offs = 0;
 			return -1;
 		}
 
-		_sl.obj_len = --length;
-		_next_offs = _sl.reader->GetSize() + length;
+		_sl->obj_len = --length;
+		_next_offs = _sl->reader->GetSize() + length;
 
-		if (_sl.expect_table_header) {
-			_sl.expect_table_header = false;
+		if (_sl->expect_table_header) {
+			_sl->expect_table_header = false;
 			return INT32_MAX;
 		}
 
-		switch (_sl.block_mode) {
+		switch (_sl->block_mode) {
 			case CH_SPARSE_TABLE:
 			case CH_SPARSE_ARRAY: index = (int)SlReadSparseIndex(); break;
 			case CH_TABLE:
-			case CH_ARRAY:        index = _sl.array_index++; break;
+			case CH_ARRAY:        index = _sl->array_index++; break;
 			default:
 				Debug(sl, 0, "SlIterateArray error");
 				return -1; // error
@@ -714,7 +839,7 @@ int SlIterateArray()
 void SlSkipArray()
 {
 	while (SlIterateArray() != -1) {
-		SlSkipBytes(_next_offs - _sl.reader->GetSize());
+		SlSkipBytes(_next_offs - _sl->reader->GetSize());
 	}
 }
 
@@ -725,18 +850,18 @@ void SlSkipArray()
  */
 void SlSetLength(size_t length)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
-	switch (_sl.need_length) {
+	switch (_sl->need_length) {
 		case NL_WANTLENGTH:
-			_sl.need_length = NL_NONE;
-			if ((_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE) && _sl.expect_table_header) {
-				_sl.expect_table_header = false;
+			_sl->need_length = NL_NONE;
+			if ((_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE) && _sl->expect_table_header) {
+				_sl->expect_table_header = false;
 				SlWriteArrayLength(length + 1);
 				break;
 			}
 
-			switch (_sl.block_mode) {
+			switch (_sl->block_mode) {
 				case CH_RIFF:
 					/* Ugly encoding of >16M RIFF chunks
 					 * The lower 24 bits are normal
@@ -746,23 +871,23 @@ void SlSetLength(size_t length)
 					break;
 				case CH_TABLE:
 				case CH_ARRAY:
-					assert(_sl.last_array_index <= _sl.array_index);
-					while (++_sl.last_array_index <= _sl.array_index) {
+					assert(_sl->last_array_index <= _sl->array_index);
+					while (++_sl->last_array_index <= _sl->array_index) {
 						SlWriteArrayLength(1);
 					}
 					SlWriteArrayLength(length + 1);
 					break;
 				case CH_SPARSE_TABLE:
 				case CH_SPARSE_ARRAY:
-					SlWriteArrayLength(length + 1 + SlGetArrayLength(_sl.array_index)); // Also include length of sparse index.
-					SlWriteSparseIndex(_sl.array_index);
+					SlWriteArrayLength(length + 1 + SlGetArrayLength(_sl->array_index)); // Also include length of sparse index.
+					SlWriteSparseIndex(_sl->array_index);
 					break;
 				default: NOT_REACHED();
 			}
 			break;
 
 		case NL_CALCLENGTH:
-			_sl.obj_len += (int)length;
+			_sl->obj_len += (int)length;
 			break;
 
 		default: NOT_REACHED();
@@ -779,7 +904,7 @@ static void SlCopyBytes(void *ptr, size_t length)
 {
 	byte *p = (byte *)ptr;
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD:
 			for (; length != 0; length--) *p++ = SlReadByte();
@@ -794,7 +919,7 @@ static void SlCopyBytes(void *ptr, size_t length)
 /** Get the length of the current object */
 size_t SlGetFieldLength()
 {
-	return _sl.obj_len;
+	return _sl->obj_len;
 }
 
 /**
@@ -856,7 +981,7 @@ void WriteValue(void *ptr, VarType conv, int64 val)
  */
 static void SlSaveLoadConv(void *ptr, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE: {
 			int64 x = ReadValue(ptr, conv);
 
@@ -971,7 +1096,7 @@ static inline size_t SlCalcStdStringLen(const void *ptr)
  */
 static void SlString(void *ptr, size_t length, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE: {
 			size_t len;
 			switch (GetVarMemType(conv)) {
@@ -1052,7 +1177,7 @@ static void SlStdString(void *ptr, VarType conv)
 {
 	std::string *str = reinterpret_cast<std::string *>(ptr);
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE: {
 			size_t len = str->length();
 			SlWriteArrayLength(len);
@@ -1105,14 +1230,14 @@ static void SlStdString(void *ptr, VarType conv)
 static void SlCopyInternal(void *object, size_t length, VarType conv)
 {
 	if (GetVarMemType(conv) == SLE_VAR_NULL) {
-		assert(_sl.action != SLA_SAVE); // Use SL_NULL if you want to write null-bytes
+		assert(_sl->action != SLA_SAVE); // Use SL_NULL if you want to write null-bytes
 		SlSkipBytes(length * SlCalcConvFileLen(conv));
 		return;
 	}
 
 	/* NOTICE - handle some buggy stuff, in really old versions everything was saved
 	 * as a byte-type. So detect this, and adjust object size accordingly */
-	if (_sl.action != SLA_SAVE && _sl_version == 0) {
+	if (_sl->action != SLA_SAVE && _sl_version == 0) {
 		/* all objects except difficulty settings */
 		if (conv == SLE_INT16 || conv == SLE_UINT16 || conv == SLE_STRINGID ||
 				conv == SLE_INT32 || conv == SLE_UINT32) {
@@ -1153,13 +1278,13 @@ static void SlCopyInternal(void *object, size_t length, VarType conv)
  */
 void SlCopy(void *object, size_t length, VarType conv)
 {
-	if (_sl.action == SLA_PTRS || _sl.action == SLA_NULL) return;
+	if (_sl->action == SLA_PTRS || _sl->action == SLA_NULL) return;
 
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(length * SlCalcConvFileLen(conv));
 		/* Determine length only? */
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlCopyInternal(object, length, conv);
@@ -1183,7 +1308,7 @@ static inline size_t SlCalcArrayLen(size_t length, VarType conv)
  */
 static void SlArray(void *array, size_t length, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE:
 			SlWriteArrayLength(length);
 			SlCopyInternal(array, length, conv);
@@ -1229,7 +1354,7 @@ static void SlArray(void *array, size_t length, VarType conv)
  */
 static size_t ReferenceToInt(const void *obj, SLRefType rt)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	if (obj == nullptr) return 0;
 
@@ -1264,7 +1389,7 @@ static void *IntToReference(size_t index, SLRefType rt)
 {
 	static_assert(sizeof(size_t) <= sizeof(void *));
 
-	assert(_sl.action == SLA_PTRS);
+	assert(_sl->action == SLA_PTRS);
 
 	/* After version 4.3 REF_VEHICLE_OLD is saved as REF_VEHICLE,
 	 * and should be loaded like that */
@@ -1338,7 +1463,7 @@ static void *IntToReference(size_t index, SLRefType rt)
  */
 void SlSaveLoadRef(void *ptr, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE:
 			SlWriteUint32((uint32)ReferenceToInt(*(void **)ptr, (SLRefType)conv));
 			break;
@@ -1402,7 +1527,7 @@ public:
 
 		SlStorageT *list = static_cast<SlStorageT *>(storage);
 
-		switch (_sl.action) {
+		switch (_sl->action) {
 			case SLA_SAVE:
 				SlWriteArrayLength(list->size());
 
@@ -1461,10 +1586,10 @@ static inline size_t SlCalcRefListLen(const void *list, VarType conv)
 static void SlRefList(void *list, VarType conv)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlCalcRefListLen(list, conv));
 		/* Determine length only? */
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlStorageHelper<std::list, void *>::SlSaveLoad(list, conv, SL_REF);
@@ -1607,7 +1732,7 @@ size_t SlCalcObjLength(const void *object, const SaveLoadTable &slt)
 
 size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	if (!SlIsObjectValidInSavegame(sld)) return 0;
 
@@ -1625,20 +1750,20 @@ size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 
 		case SL_STRUCT:
 		case SL_STRUCTLIST: {
-			NeedLength old_need_length = _sl.need_length;
-			size_t old_obj_len = _sl.obj_len;
+			NeedLength old_need_length = _sl->need_length;
+			size_t old_obj_len = _sl->obj_len;
 
-			_sl.need_length = NL_CALCLENGTH;
-			_sl.obj_len = 0;
+			_sl->need_length = NL_CALCLENGTH;
+			_sl->obj_len = 0;
 
 			/* Pretend that we are saving to collect the object size. Other
 			 * means are difficult, as we don't know the length of the list we
 			 * are about to store. */
 			sld.handler->Save(const_cast<void *>(object));
-			size_t length = _sl.obj_len;
+			size_t length = _sl->obj_len;
 
-			_sl.obj_len = old_obj_len;
-			_sl.need_length = old_need_length;
+			_sl->obj_len = old_obj_len;
+			_sl->need_length = old_need_length;
 
 			if (sld.cmd == SL_STRUCT) {
 				length += SlGetArrayLength(1);
@@ -1738,7 +1863,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 		case SL_SAVEBYTE: {
 			void *ptr = GetVariableAddress(object, sld);
 
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_SAVE: SlWriteByte(*(uint8 *)ptr); break;
 				case SLA_LOAD_CHECK:
 				case SLA_LOAD:
@@ -1752,7 +1877,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 		case SL_NULL: {
 			assert(GetVarMemType(sld.conv) == SLE_VAR_NULL);
 
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_LOAD_CHECK:
 				case SLA_LOAD: SlSkipBytes(SlCalcConvFileLen(sld.conv) * sld.length); break;
 				case SLA_SAVE: for (int i = 0; i < SlCalcConvFileLen(sld.conv) * sld.length; i++) SlWriteByte(0); break;
@@ -1765,7 +1890,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 
 		case SL_STRUCT:
 		case SL_STRUCTLIST:
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_SAVE: {
 					if (sld.cmd == SL_STRUCT) {
 						/* Store in the savegame if this struct was written or not. */
@@ -1812,9 +1937,9 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 void SlSetStructListLength(size_t length)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlGetArrayLength(length));
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlWriteArrayLength(length);
@@ -1841,9 +1966,9 @@ size_t SlGetStructListLength(size_t limit)
 void SlObject(void *object, const SaveLoadTable &slt)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlCalcObjLength(object, slt));
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	for (auto &sld : slt) {
@@ -1894,9 +2019,9 @@ class SlSkipHandler : public SaveLoadHandler {
 std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 {
 	/* You can only use SlTableHeader if you are a CH_TABLE. */
-	assert(_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	assert(_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD: {
 			std::vector<SaveLoad> saveloads;
@@ -1922,7 +2047,7 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 				auto sld_it = key_lookup.find(key);
 				if (sld_it == key_lookup.end()) {
 					/* SLA_LOADCHECK triggers this debug statement a lot and is perfectly normal. */
-					Debug(sl, _sl.action == SLA_LOAD ? 2 : 6, "Field '{}' of type 0x{:02x} not found, skipping", key, type);
+					Debug(sl, _sl->action == SLA_LOAD ? 2 : 6, "Field '{}' of type 0x{:02x} not found, skipping", key, type);
 
 					std::shared_ptr<SaveLoadHandler> handler = nullptr;
 					SaveLoadType saveload_type;
@@ -1972,9 +2097,9 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 
 		case SLA_SAVE: {
 			/* Automatically calculate the length? */
-			if (_sl.need_length != NL_NONE) {
+			if (_sl->need_length != NL_NONE) {
 				SlSetLength(SlCalcTableHeader(slt));
-				if (_sl.need_length == NL_CALCLENGTH) break;
+				if (_sl->need_length == NL_CALCLENGTH) break;
 			}
 
 			for (auto &sld : slt) {
@@ -1998,12 +2123,12 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 				if (!SlIsObjectValidInSavegame(sld)) continue;
 				if (sld.cmd == SL_STRUCTLIST || sld.cmd == SL_STRUCT) {
 					/* SlCalcTableHeader already looks in sub-lists, so avoid the length being added twice. */
-					NeedLength old_need_length = _sl.need_length;
-					_sl.need_length = NL_NONE;
+					NeedLength old_need_length = _sl->need_length;
+					_sl->need_length = NL_NONE;
 
 					SlTableHeader(sld.handler->GetDescription());
 
-					_sl.need_length = old_need_length;
+					_sl->need_length = old_need_length;
 				}
 			}
 
@@ -2031,9 +2156,9 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
  */
 std::vector<SaveLoad> SlCompatTableHeader(const SaveLoadTable &slt, const SaveLoadCompatTable &slct)
 {
-	assert(_sl.action == SLA_LOAD || _sl.action == SLA_LOAD_CHECK);
+	assert(_sl->action == SLA_LOAD || _sl->action == SLA_LOAD_CHECK);
 	/* CH_TABLE / CH_SPARSE_TABLE always have a header. */
-	if (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE) return SlTableHeader(slt);
+	if (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE) return SlTableHeader(slt);
 
 	std::vector<SaveLoad> saveloads;
 
@@ -2097,28 +2222,28 @@ void SlAutolength(AutolengthProc *proc, void *arg)
 {
 	size_t offs;
 
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	/* Tell it to calculate the length */
-	_sl.need_length = NL_CALCLENGTH;
-	_sl.obj_len = 0;
+	_sl->need_length = NL_CALCLENGTH;
+	_sl->obj_len = 0;
 	proc(arg);
 
 	/* Setup length */
-	_sl.need_length = NL_WANTLENGTH;
-	SlSetLength(_sl.obj_len);
+	_sl->need_length = NL_WANTLENGTH;
+	SlSetLength(_sl->obj_len);
 
-	offs = _sl.dumper->GetSize() + _sl.obj_len;
+	offs = _sl->dumper->GetSize() + _sl->obj_len;
 
 	/* And write the stuff */
 	proc(arg);
 
-	if (offs != _sl.dumper->GetSize()) SlErrorCorrupt("Invalid chunk size");
+	if (offs != _sl->dumper->GetSize()) SlErrorCorrupt("Invalid chunk size");
 }
 
 void ChunkHandler::LoadCheck(size_t len) const
 {
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_SPARSE_TABLE:
 			SlTableHeader({});
@@ -2145,20 +2270,20 @@ static void SlLoadChunk(const ChunkHandler &ch)
 	size_t len;
 	size_t endoffs;
 
-	_sl.block_mode = m & CH_TYPE_MASK;
-	_sl.obj_len = 0;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = m & CH_TYPE_MASK;
+	_sl->obj_len = 0;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
 	/* The header should always be at the start. Read the length; the
 	 * Load() should as first action process the header. */
-	if (_sl.expect_table_header) {
+	if (_sl->expect_table_header) {
 		SlIterateArray();
 	}
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.array_index = 0;
+			_sl->array_index = 0;
 			ch.Load();
 			if (_next_offs != 0) SlErrorCorrupt("Invalid array length");
 			break;
@@ -2171,17 +2296,17 @@ static void SlLoadChunk(const ChunkHandler &ch)
 			/* Read length */
 			len = (SlReadByte() << 16) | ((m >> 4) << 24);
 			len += SlReadUint16();
-			_sl.obj_len = len;
-			endoffs = _sl.reader->GetSize() + len;
+			_sl->obj_len = len;
+			endoffs = _sl->reader->GetSize() + len;
 			ch.Load();
-			if (_sl.reader->GetSize() != endoffs) SlErrorCorrupt("Invalid chunk size");
+			if (_sl->reader->GetSize() != endoffs) SlErrorCorrupt("Invalid chunk size");
 			break;
 		default:
 			SlErrorCorrupt("Invalid chunk type");
 			break;
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
 /**
@@ -2195,20 +2320,20 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 	size_t len;
 	size_t endoffs;
 
-	_sl.block_mode = m & CH_TYPE_MASK;
-	_sl.obj_len = 0;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = m & CH_TYPE_MASK;
+	_sl->obj_len = 0;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
 	/* The header should always be at the start. Read the length; the
 	 * LoadCheck() should as first action process the header. */
-	if (_sl.expect_table_header) {
+	if (_sl->expect_table_header) {
 		SlIterateArray();
 	}
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.array_index = 0;
+			_sl->array_index = 0;
 			ch.LoadCheck();
 			break;
 		case CH_SPARSE_TABLE:
@@ -2219,17 +2344,17 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 			/* Read length */
 			len = (SlReadByte() << 16) | ((m >> 4) << 24);
 			len += SlReadUint16();
-			_sl.obj_len = len;
-			endoffs = _sl.reader->GetSize() + len;
+			_sl->obj_len = len;
+			endoffs = _sl->reader->GetSize() + len;
 			ch.LoadCheck(len);
-			if (_sl.reader->GetSize() != endoffs) SlErrorCorrupt("Invalid chunk size");
+			if (_sl->reader->GetSize() != endoffs) SlErrorCorrupt("Invalid chunk size");
 			break;
 		default:
 			SlErrorCorrupt("Invalid chunk type");
 			break;
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
 /**
@@ -2244,39 +2369,126 @@ static void SlSaveChunk(const ChunkHandler &ch)
 	SlWriteUint32(ch.id);
 	Debug(sl, 2, "Saving chunk {:c}{:c}{:c}{:c}", ch.id >> 24, ch.id >> 16, ch.id >> 8, ch.id);
 
-	_sl.block_mode = ch.type;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = ch.type;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
-	_sl.need_length = (_sl.expect_table_header || _sl.block_mode == CH_RIFF) ? NL_WANTLENGTH : NL_NONE;
+	_sl->need_length = (_sl->expect_table_header || _sl->block_mode == CH_RIFF) ? NL_WANTLENGTH : NL_NONE;
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_RIFF:
 			ch.Save();
 			break;
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.last_array_index = 0;
-			SlWriteByte(_sl.block_mode);
+			_sl->last_array_index = 0;
+			SlWriteByte(_sl->block_mode);
 			ch.Save();
 			SlWriteArrayLength(0); // Terminate arrays
 			break;
 		case CH_SPARSE_TABLE:
 		case CH_SPARSE_ARRAY:
-			SlWriteByte(_sl.block_mode);
+			SlWriteByte(_sl->block_mode);
 			ch.Save();
 			SlWriteArrayLength(0); // Terminate arrays
 			break;
 		default: NOT_REACHED();
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
+}
+
+/**
+ * Check whether a chunk may be serialized on a worker thread.
+ * Such chunks only read the data they serialize and use no scratch buffers
+ * shared with other chunks, so several of them can be written at the same
+ * time, each into its own #MemoryDumper.
+ * @param id Identifier of the chunk.
+ * @return True if the chunk can be saved in parallel with other chunks.
+ */
+static bool IsParallelSaveableChunk(uint32 id)
+{
+	switch (id) {
+		case 'MAPT': case 'MAPH': case 'MAPO': case 'MAP2':
+		case 'M3LO': case 'M3HI': case 'MAP5': case 'MAPE':
+		case 'MAP7': case 'MAP8':
+		case 'VEHS':
+		case 'STNN':
+		case 'CITY':
+			return true;
+
+		default:
+			return false;
+	}
 }
 
 /** Save all chunks */
 static void SlSaveChunks()
 {
-	for (auto &ch : ChunkHandlers()) {
-		SlSaveChunk(ch);
+	const std::vector<ChunkHandlerRef> &handlers = ChunkHandlers();
+
+	/* Serialize the large, self-contained chunks on worker threads, each
+	 * into its own buffer. The buffers are concatenated in chunk order
+	 * below, so the result is identical to a single-threaded save. Chunks
+	 * that got no buffer are saved in order on this thread. */
+	std::vector<std::unique_ptr<MemoryDumper>> buffers(handlers.size());
+	std::vector<size_t> pending;
+	for (size_t i = 0; i < handlers.size(); i++) {
+		if (IsParallelSaveableChunk(handlers[i].get().id)) pending.push_back(i);
+	}
+
+	uint threads = std::min<uint>(std::thread::hardware_concurrency(), (uint)pending.size());
+	if (threads > 1) {
+		std::atomic<size_t> next(0);
+		std::mutex error_lock;
+		std::exception_ptr error = nullptr;
+
+		auto serialize_chunks = [&]() {
+			/* Give this thread its own saveload state; the chunk savers
+			 * all operate on the state of the calling thread. */
+			SaveLoadParams sl{};
+			sl.action = SLA_SAVE;
+			_sl = &sl;
+			for (;;) {
+				size_t index = next.fetch_add(1);
+				if (index >= pending.size()) break;
+				size_t slot = pending[index];
+				try {
+					sl.dumper = new MemoryDumper();
+					buffers[slot].reset(sl.dumper);
+					SlSaveChunk(handlers[slot]);
+				} catch (...) {
+					std::lock_guard<std::mutex> lock(error_lock);
+					if (error == nullptr) {
+						error = std::current_exception();
+						_sl_main.error_str = sl.error_str;
+						_sl_main.extra_msg = sl.extra_msg;
+					}
+					break;
+				}
+			}
+		};
+
+		std::vector<std::thread> pool(threads);
+		uint started = 0;
+		for (std::thread &t : pool) {
+			if (!StartNewThread(&t, "ottd:savechunks", decltype(serialize_chunks)(serialize_chunks))) break;
+			started++;
+		}
+		for (uint i = 0; i < started; i++) pool[i].join();
+
+		if (error != nullptr) std::rethrow_exception(error);
+	}
+
+	for (size_t i = 0; i < handlers.size(); i++) {
+		if (buffers[i] != nullptr) {
+			_sl->dumper->MoveFrom(*buffers[i]);
+			buffers[i].reset();
+		} else {
+			SlSaveChunk(handlers[i]);
+		}
+
+		/* In a streamed save, let the writer thread start on the data we have. */
+		if (_sl->block_queue != nullptr) SlFlushBlockQueue(false);
 	}
 
 	/* Terminator */
@@ -2328,14 +2540,14 @@ static void SlLoadCheckChunks()
 /** Fix all pointers (convert index -> pointer) */
 static void SlFixPointers()
 {
-	_sl.action = SLA_PTRS;
+	_sl->action = SLA_PTRS;
 
 	for (const ChunkHandler &ch : ChunkHandlers()) {
 		Debug(sl, 3, "Fixing pointers for {:c}{:c}{:c}{:c}", ch.id >> 24, ch.id >> 16, ch.id >> 8, ch.id);
 		ch.FixPointers();
 	}
 
-	assert(_sl.action == SLA_PTRS);
+	assert(_sl->action == SLA_PTRS);
 }
 
 
@@ -2359,7 +2571,7 @@ struct FileReader : LoadFilter {
 		this->file = nullptr;
 
 		/* Make sure we don't double free. */
-		_sl.sf = nullptr;
+		_sl->sf = nullptr;
 	}
 
 	size_t Read(byte *buf, size_t size) override
@@ -2381,13 +2593,19 @@ struct FileReader : LoadFilter {
 
 /** Yes, simply writing to a file. */
 struct FileWriter : SaveFilter {
-	FILE *file; ///< The file to write to.
+	std::string filename; ///< The name of the file to write to.
+	Subdirectory subdir;  ///< The subdirectory to create the file in.
+	FILE *file;           ///< The file to write to, once the first data arrives.
+	bool opened;          ///< Whether opening the file has been attempted.
 
 	/**
 	 * Create the file writer, so it writes to a specific file.
-	 * @param file The file to write to.
+	 * The file itself is only opened on the first write, so a save that is
+	 * abandoned before producing any data does not truncate its target.
+	 * @param filename The name of the file to write to.
+	 * @param subdir The subdirectory to create the file in.
 	 */
-	FileWriter(FILE *file) : SaveFilter(nullptr), file(file)
+	FileWriter(const std::string &filename, Subdirectory subdir) : SaveFilter(nullptr), filename(filename), subdir(subdir), file(nullptr), opened(false)
 	{
 	}
 
@@ -2397,11 +2615,17 @@ struct FileWriter : SaveFilter {
 		this->Finish();
 
 		/* Make sure we don't double free. */
-		_sl.sf = nullptr;
+		_sl->sf = nullptr;
 	}
 
 	void Write(byte *buf, size_t size) override
 	{
+		if (!this->opened) {
+			this->opened = true;
+			this->file = FioFOpenFile(this->filename, "wb", this->subdir);
+			if (this->file == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE);
+		}
+
 		/* We're in the process of shutting down, i.e. in "failure" mode. */
 		if (this->file == nullptr) return;
 
@@ -2415,6 +2639,129 @@ struct FileWriter : SaveFilter {
 	}
 };
 
+/**
+ * Filter that reads the rest of its chain on a thread of its own, staying
+ * a bounded number of blocks ahead of the consuming thread. Placed above
+ * the decompressor it overlaps decompression with deserialisation; placed
+ * below it overlaps disk reads with decompression. The mirror image of the
+ * streamed save path.
+ */
+struct PrefetchLoadFilter : LoadFilter {
+	/** A block of data read ahead of the consumer. */
+	struct Block {
+		byte *data;  ///< The data of the block.
+		size_t size; ///< Number of bytes in the block.
+	};
+
+	static const size_t MAX_PREFETCH_BLOCKS = 32; ///< Read at most this many blocks (4 MiB) ahead.
+
+	std::mutex mutex;               ///< Mutex protecting all members below.
+	std::condition_variable signal; ///< Signalled when blocks, room for blocks, or the flags change.
+	std::deque<Block> blocks;       ///< Blocks read ahead, in stream order.
+	bool completed = false;         ///< Whether the reader has delivered the last block.
+	bool failed = false;            ///< Whether the reader stopped with an error.
+	bool aborted = false;           ///< Whether the consumer has no more use for the data.
+	size_t offset = 0;              ///< Read position within the front block.
+
+	StringID error_str = INVALID_STRING_ID; ///< Error raised by the reader, to be re-raised by the consumer.
+	char *extra_msg = nullptr;              ///< Extra error details from the reader.
+
+	std::thread thread; ///< Thread the reading happens on.
+	bool threaded;      ///< Whether the reader thread could be started.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	PrefetchLoadFilter(LoadFilter *chain) : LoadFilter(chain)
+	{
+		this->threaded = StartNewThread(&this->thread, "ottd:loadgame", [this]() { this->ReadAhead(); });
+		if (!this->threaded) Debug(sl, 1, "Cannot create savegame reading thread, reverting to single-threaded mode...");
+	}
+
+	/** Make sure the reader has stopped before the chain is torn down. */
+	~PrefetchLoadFilter()
+	{
+		if (this->threaded) {
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				this->aborted = true;
+				this->signal.notify_all();
+			}
+			this->thread.join();
+		}
+		for (Block &block : this->blocks) free(block.data);
+		free(this->extra_msg);
+	}
+
+	/** Read the rest of the chain until its end, keeping at most #MAX_PREFETCH_BLOCKS blocks queued. */
+	void ReadAhead()
+	{
+		/* Give this thread its own saveload state; SlError on the consuming
+		 * thread nulls the loaded pointers, which must not happen here. */
+		SaveLoadParams sl{};
+		sl.action = SLA_NULL;
+		sl.error_str = INVALID_STRING_ID;
+		_sl = &sl;
+
+		try {
+			for (;;) {
+				byte *data = MallocT<byte>(MEMORY_CHUNK_SIZE);
+				size_t size = this->chain->Read(data, MEMORY_CHUNK_SIZE);
+
+				std::unique_lock<std::mutex> lock(this->mutex);
+				if (size == 0 || this->aborted) {
+					free(data);
+					this->completed = true;
+					this->signal.notify_all();
+					return;
+				}
+				this->blocks.push_back({data, size});
+				this->signal.notify_all();
+				this->signal.wait(lock, [this]() { return this->aborted || this->blocks.size() < MAX_PREFETCH_BLOCKS; });
+			}
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->error_str = sl.error_str != INVALID_STRING_ID ? sl.error_str : STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR;
+			this->extra_msg = sl.extra_msg;
+			this->failed = true;
+			this->completed = true;
+			this->signal.notify_all();
+		}
+	}
+
+	size_t Read(byte *buf, size_t size) override
+	{
+		if (!this->threaded) return this->chain->Read(buf, size);
+
+		size_t result = 0;
+		std::unique_lock<std::mutex> lock(this->mutex);
+		while (result < size) {
+			this->signal.wait(lock, [this]() { return this->completed || !this->blocks.empty(); });
+			if (this->blocks.empty()) {
+				/* Re-raise a reader error from the consuming thread, where
+				 * SlError performs the usual load-error handling. */
+				if (this->failed) SlError(this->error_str, this->extra_msg);
+				break;
+			}
+
+			Block &block = this->blocks.front();
+			size_t n = std::min(size - result, block.size - this->offset);
+			memcpy(buf + result, block.data + this->offset, n);
+			result += n;
+			this->offset += n;
+
+			if (this->offset == block.size) {
+				free(block.data);
+				this->blocks.pop_front();
+				this->offset = 0;
+				this->signal.notify_all();
+			}
+		}
+		return result;
+	}
+};
+
 /*******************************************
  ********** START OF LZO CODE **************
  *******************************************/
@@ -2786,6 +3133,120 @@ struct LZMASaveFilter : SaveFilter {
 
 #endif /* WITH_LIBLZMA */
 
+/********************************************
+ ********** START OF ZSTD CODE **************
+ ********************************************/
+
+#if defined(WITH_ZSTD)
+#include <zstd.h>
+
+/** Filter using Zstandard compression. */
+struct ZSTDLoadFilter : LoadFilter {
+	ZSTD_DStream *zstd;                ///< Stream state we are reading from.
+	byte fread_buf[MEMORY_CHUNK_SIZE]; ///< Buffer for reading from the file.
+	ZSTD_inBuffer input;               ///< Unprocessed part of #fread_buf.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	ZSTDLoadFilter(LoadFilter *chain) : LoadFilter(chain), input({this->fread_buf, 0, 0})
+	{
+		this->zstd = ZSTD_createDStream();
+		if (this->zstd == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize decompressor");
+	}
+
+	/** Clean everything up. */
+	~ZSTDLoadFilter()
+	{
+		ZSTD_freeDStream(this->zstd);
+	}
+
+	size_t Read(byte *buf, size_t size) override
+	{
+		ZSTD_outBuffer output = {buf, size, 0};
+
+		do {
+			/* read more bytes from the file? */
+			if (this->input.pos == this->input.size) {
+				this->input.size = this->chain->Read(this->fread_buf, sizeof(this->fread_buf));
+				this->input.pos = 0;
+				if (this->input.size == 0) break;
+			}
+
+			/* decompress the data */
+			size_t r = ZSTD_decompressStream(this->zstd, &output, &this->input);
+			if (ZSTD_isError(r)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "libzstd returned error code");
+			if (r == 0) break;
+		} while (output.pos != output.size);
+
+		return output.pos;
+	}
+};
+
+/** Filter using Zstandard compression. */
+struct ZSTDSaveFilter : SaveFilter {
+	ZSTD_CStream *zstd; ///< Stream state we are writing to.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain             The next filter in this chain.
+	 * @param compression_level The requested level of compression.
+	 */
+	ZSTDSaveFilter(SaveFilter *chain, byte compression_level) : SaveFilter(chain)
+	{
+		this->zstd = ZSTD_createCStream();
+		if (this->zstd == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize compressor");
+		ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_compressionLevel, compression_level);
+		/* Spread the compression over the cores; this parameter is silently
+		 * ignored when libzstd was built without multithreading support. */
+		ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_nbWorkers, std::thread::hardware_concurrency());
+	}
+
+	/** Clean up what we allocated. */
+	~ZSTDSaveFilter()
+	{
+		ZSTD_freeCStream(this->zstd);
+	}
+
+	/**
+	 * Helper loop for writing the data.
+	 * @param p    The bytes to write.
+	 * @param len  Amount of bytes to write.
+	 * @param mode Directive for the compressor.
+	 */
+	void WriteLoop(byte *p, size_t len, ZSTD_EndDirective mode)
+	{
+		byte buf[MEMORY_CHUNK_SIZE]; // output buffer
+		ZSTD_inBuffer input = {p, len, 0};
+
+		for (;;) {
+			ZSTD_outBuffer output = {buf, sizeof(buf), 0};
+
+			size_t remaining = ZSTD_compressStream2(this->zstd, &output, &input, mode);
+			if (ZSTD_isError(remaining)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "libzstd returned error code");
+
+			/* bytes were emitted? */
+			if (output.pos != 0) this->chain->Write(buf, output.pos);
+
+			if (mode == ZSTD_e_end ? remaining == 0 : input.pos == input.size) break;
+		}
+	}
+
+	void Write(byte *buf, size_t size) override
+	{
+		this->WriteLoop(buf, size, ZSTD_e_continue);
+	}
+
+	void Finish() override
+	{
+		this->WriteLoop(nullptr, 0, ZSTD_e_end);
+		this->chain->Finish();
+	}
+};
+
+#endif /* WITH_ZSTD */
+
 /*******************************************
  ************* END OF CODE *****************
  *******************************************/
@@ -2821,6 +3282,15 @@ static const SaveLoadFormat _saveload_formats[] = {
 #else
 	{"zlib",   TO_BE32X('OTTZ'), nullptr,                            nullptr,                            0, 0, 0},
 #endif
+#if defined(WITH_ZSTD)
+	/* Zstandard compresses several times faster than zlib level 6 while producing smaller files, and decompresses
+	 * faster than any of the formats above, which also speeds up map transfer to joining network clients. Level 3
+	 * is the sweet spot for the write-often autosave/network case; the higher levels approach lzma output sizes at
+	 * a fraction of its CPU cost but are not worth it for files that are written far more often than transferred. */
+	{"zstd",   TO_BE32X('OTTS'), CreateLoadFilter<ZSTDLoadFilter>,   CreateSaveFilter<ZSTDSaveFilter>,   1, 3, 22},
+#else
+	{"zstd",   TO_BE32X('OTTS'), nullptr,                            nullptr,                            0, 0, 0},
+#endif
 #if defined(WITH_LIBLZMA)
 	/* Level 2 compression is speed wise as fast as zlib level 6 compression (old default), but results in ~10% smaller saves.
 	 * Higher compression levels are possible, and might improve savegame size by up to 25%, but are also up to 10 times slower.
@@ -2886,6 +3356,10 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 extern bool AfterLoadGame();
 extern bool LoadOldSaveGame(const std::string &file);
 
+static uint64 _last_autosave_hash;      ///< Hash of the serialized game state of the previous autosave.
+static size_t _last_autosave_size;      ///< Size of the serialized game state of the previous autosave.
+static bool _last_autosave_hash_valid;  ///< Whether the previous autosave belongs to the currently loaded game.
+
 /**
  * Clear temporary data that is passed between various saveload phases.
  */
@@ -2894,6 +3368,9 @@ static void ResetSaveloadData()
 	ResetTempEngineData();
 	ResetLabelMaps();
 	ResetOldWaypoints();
+
+	/* The game being loaded has no previous autosave to compare against. */
+	_last_autosave_hash_valid = false;
 }
 
 /**
@@ -2901,17 +3378,20 @@ static void ResetSaveloadData()
  */
 static inline void ClearSaveLoadState()
 {
-	delete _sl.dumper;
-	_sl.dumper = nullptr;
+	delete _sl->dumper;
+	_sl->dumper = nullptr;
 
-	delete _sl.sf;
-	_sl.sf = nullptr;
+	delete _sl->block_queue;
+	_sl->block_queue = nullptr;
 
-	delete _sl.reader;
-	_sl.reader = nullptr;
+	delete _sl->sf;
+	_sl->sf = nullptr;
 
-	delete _sl.lf;
-	_sl.lf = nullptr;
+	delete _sl->reader;
+	_sl->reader = nullptr;
+
+	delete _sl->lf;
+	_sl->lf = nullptr;
 }
 
 /** Update the gui accordingly when starting saving and set locks on saveload. */
@@ -2920,7 +3400,7 @@ static void SaveFileStart()
 	SetMouseCursorBusy(true);
 
 	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_START);
-	_sl.saveinprogress = true;
+	_sl->saveinprogress = true;
 }
 
 /** Update the gui accordingly when saving is done and release locks on saveload. */
@@ -2929,7 +3409,7 @@ static void SaveFileDone()
 	SetMouseCursorBusy(false);
 
 	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_FINISH);
-	_sl.saveinprogress = false;
+	_sl->saveinprogress = false;
 
 #ifdef __EMSCRIPTEN__
 	EM_ASM(if (window["openttd_syncfs"]) openttd_syncfs());
@@ -2939,17 +3419,17 @@ static void SaveFileDone()
 /** Set the error message from outside of the actual loading/saving of the game (AfterLoadGame and friends) */
 void SetSaveLoadError(StringID str)
 {
-	_sl.error_str = str;
+	_sl->error_str = str;
 }
 
 /** Get the string representation of the error message */
 const char *GetSaveLoadErrorString()
 {
-	SetDParam(0, _sl.error_str);
-	SetDParamStr(1, _sl.extra_msg);
+	SetDParam(0, _sl->error_str);
+	SetDParamStr(1, _sl->extra_msg);
 
 	static char err_str[512];
-	GetString(err_str, _sl.action == SLA_SAVE ? STR_ERROR_GAME_SAVE_FAILED : STR_ERROR_GAME_LOAD_FAILED, lastof(err_str));
+	GetString(err_str, _sl->action == SLA_SAVE ? STR_ERROR_GAME_SAVE_FAILED : STR_ERROR_GAME_LOAD_FAILED, lastof(err_str));
 	return err_str;
 }
 
@@ -2961,6 +3441,51 @@ static void SaveFileError()
 	SaveFileDone();
 }
 
+/**
+ * Write the blocks of a streamed save to the given writer as the game
+ * thread produces them, until the last block has been handled.
+ * @param writer The filter to write the savegame to.
+ */
+static void WriteBlockQueue(SaveFilter *writer)
+{
+	SaveBlockQueue *queue = _sl->block_queue;
+
+	for (;;) {
+		MemoryDumper::Block block;
+		{
+			std::unique_lock<std::mutex> lock(queue->mutex);
+			queue->signal.wait(lock, [queue]() { return queue->aborted || queue->completed || !queue->blocks.empty(); });
+			if (queue->aborted) throw std::exception();
+			if (queue->blocks.empty()) break;
+			block = queue->blocks.front();
+			queue->blocks.pop_front();
+		}
+
+		writer->Write(block.data, block.size);
+		free(block.data);
+	}
+
+	writer->Finish();
+}
+
+/**
+ * Stop accepting blocks from the game thread of a streamed save and wait
+ * until it has stopped producing them, discarding everything queued.
+ */
+static void DrainBlockQueue()
+{
+	SaveBlockQueue *queue = _sl->block_queue;
+
+	std::unique_lock<std::mutex> lock(queue->mutex);
+	queue->aborted = true;
+	for (;;) {
+		for (MemoryDumper::Block &block : queue->blocks) free(block.data);
+		queue->blocks.clear();
+		if (queue->completed) break;
+		queue->signal.wait(lock);
+	}
+}
+
 /**
  * We have written the whole game into memory, _memory_savegame, now find
  * and appropriate compressor and start writing to file.
@@ -2973,10 +3498,14 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 
 		/* We have written our stuff to memory, now write it to file! */
 		uint32 hdr[2] = { fmt->tag, TO_BE32(SAVEGAME_VERSION << 16) };
-		_sl.sf->Write((byte*)hdr, sizeof(hdr));
+		_sl->sf->Write((byte*)hdr, sizeof(hdr));
 
-		_sl.sf = fmt->init_write(_sl.sf, compression);
-		_sl.dumper->Flush(_sl.sf);
+		_sl->sf = fmt->init_write(_sl->sf, compression);
+		if (_sl->block_queue != nullptr) {
+			WriteBlockQueue(_sl->sf);
+		} else {
+			_sl->dumper->Flush(_sl->sf);
+		}
 
 		ClearSaveLoadState();
 
@@ -2984,13 +3513,17 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 
 		return SL_OK;
 	} catch (...) {
+		/* In a streamed save the game thread may still be serializing;
+		 * wait for it to stop before tearing down the shared state. */
+		if (_sl->block_queue != nullptr) DrainBlockQueue();
+
 		ClearSaveLoadState();
 
 		AsyncSaveFinishProc asfp = SaveFileDone;
 
 		/* We don't want to shout when saving is just
 		 * cancelled due to a client disconnecting. */
-		if (_sl.error_str != STR_NETWORK_ERROR_LOSTCONNECTION) {
+		if (_sl->error_str != STR_NETWORK_ERROR_LOSTCONNECTION) {
 			/* Skip the "colour" character */
 			Debug(sl, 0, "{}", GetSaveLoadErrorString() + 3);
 			asfp = SaveFileError;
@@ -3007,9 +3540,10 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 
 void WaitTillSaved()
 {
-	if (!_save_thread.joinable()) return;
+	if (!_save_thread.joinable() && !_save_job.IsValid()) return;
 
-	_save_thread.join();
+	if (_save_thread.joinable()) _save_thread.join();
+	_save_job.Join();
 
 	/* Make sure every other state is handled properly as well. */
 	ProcessAsyncSaveFinish();
@@ -3019,26 +3553,83 @@ void WaitTillSaved()
  * Actually perform the saving of the savegame.
  * General tactics is to first save the game to memory, then write it to file
  * using the writer, either in threaded mode if possible, or single-threaded.
+ * In streamed mode the writer thread is started first and gets the
+ * serialized data handed over block by block, so compressing and writing
+ * begin before the serialisation has finished; on errors this may leave a
+ * truncated stream behind, which is why it is only used for writers that
+ * can cope with that, like the network map transfer.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
+ * @param streamed Whether to stream the data to a threaded writer as it is produced.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
  */
-static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded)
+static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded, bool streamed = false)
 {
-	assert(!_sl.saveinprogress);
+	assert(!_sl->saveinprogress);
 
-	_sl.dumper = new MemoryDumper();
-	_sl.sf = writer;
+	_sl->dumper = new MemoryDumper();
+	_sl->sf = writer;
 
 	_sl_version = SAVEGAME_VERSION;
 
 	SaveViewportBeforeSaveGame();
+
+	if (threaded && streamed) {
+		_sl->block_queue = new SaveBlockQueue();
+		SaveFileStart();
+
+		if (StartNewThread(&_save_thread, "ottd:savegame", &SaveFileToDisk, true)) {
+			try {
+				SlSaveChunks();
+				SlFlushBlockQueue(true);
+			} catch (...) {
+				/* Tell the writer thread we cannot deliver the rest of the
+				 * save; it owns the cleanup and the error reporting. */
+				std::lock_guard<std::mutex> lock(_sl->block_queue->mutex);
+				_sl->block_queue->aborted = true;
+				_sl->block_queue->completed = true;
+				_sl->block_queue->signal.notify_one();
+				return SL_ERROR;
+			}
+			return SL_OK;
+		}
+
+		Debug(sl, 1, "Cannot create savegame thread, reverting to single-threaded mode...");
+		delete _sl->block_queue;
+		_sl->block_queue = nullptr;
+
+		SlSaveChunks();
+
+		SaveOrLoadResult result = SaveFileToDisk(false);
+		SaveFileDone();
+
+		return result;
+	}
+
 	SlSaveChunks();
 
+	/* Consecutive autosaves of a game nobody plays in, e.g. on a paused
+	 * dedicated server, serialize to exactly the same data. Recognise that
+	 * by hash and skip the compression and the disk write altogether. */
+	if (_do_autosave) {
+		uint64 hash = _sl->dumper->CalcHash();
+		size_t size = _sl->dumper->GetSize();
+		if (_last_autosave_hash_valid && hash == _last_autosave_hash && size == _last_autosave_size) {
+			Debug(sl, 1, "Autosave skipped; game state unchanged since the previous autosave");
+			ClearSaveLoadState();
+			return SL_OK;
+		}
+		_last_autosave_hash = hash;
+		_last_autosave_size = size;
+		_last_autosave_hash_valid = true;
+	}
+
 	SaveFileStart();
 
-	if (!threaded || !StartNewThread(&_save_thread, "ottd:savegame", &SaveFileToDisk, true)) {
-		if (threaded) Debug(sl, 1, "Cannot create savegame thread, reverting to single-threaded mode...");
+	if (threaded) _save_job = SubmitJob([]() { SaveFileToDisk(true); }, "ottd:savegame");
+
+	if (!threaded || !_save_job.IsValid()) {
+		if (threaded) Debug(sl, 1, "Cannot submit savegame job, reverting to single-threaded mode...");
 
 		SaveOrLoadResult result = SaveFileToDisk(false);
 		SaveFileDone();
@@ -3051,6 +3642,8 @@ static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded)
 
 /**
  * Save the game using a (writer) filter.
+ * In threaded mode the data is streamed to the writer as it is produced,
+ * so the writer must be able to cope with a truncated stream on errors.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
@@ -3058,8 +3651,8 @@ static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded)
 SaveOrLoadResult SaveWithFilter(SaveFilter *writer, bool threaded)
 {
 	try {
-		_sl.action = SLA_SAVE;
-		return DoSave(writer, threaded);
+		_sl->action = SLA_SAVE;
+		return DoSave(writer, threaded, threaded);
 	} catch (...) {
 		ClearSaveLoadState();
 		return SL_ERROR;
@@ -3074,7 +3667,7 @@ SaveOrLoadResult SaveWithFilter(SaveFilter *writer, bool threaded)
  */
 static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 {
-	_sl.lf = reader;
+	_sl->lf = reader;
 
 	if (load_check) {
 		/* Clear previous check data */
@@ -3084,7 +3677,7 @@ static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 	}
 
 	uint32 hdr[2];
-	if (_sl.lf->Read((byte*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+	if (_sl->lf->Read((byte*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
 
 	/* see if we have any loader for this type. */
 	const SaveLoadFormat *fmt = _saveload_formats;
@@ -3092,7 +3685,7 @@ static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 		/* No loader found, treat as version 0 and use LZO format */
 		if (fmt == endof(_saveload_formats)) {
 			Debug(sl, 0, "Unknown savegame type, trying to load it as the buggy format");
-			_sl.lf->Reset();
+			_sl->lf->Reset();
 			_sl_version = SL_MIN_VERSION;
 			_sl_minor_version = 0;
 
@@ -3135,8 +3728,20 @@ static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 		SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, err_str);
 	}
 
-	_sl.lf = fmt->init_load(_sl.lf);
-	_sl.reader = new ReadBuffer(_sl.lf);
+	if (!load_check) {
+		/* Read the raw file ahead of the decompressor on a thread of its
+		 * own, so disk I/O does not stall decompression. */
+		_sl->lf = new PrefetchLoadFilter(_sl->lf);
+	}
+	_sl->lf = fmt->init_load(_sl->lf);
+	if (!load_check) {
+		/* Decompress ahead of the deserialisation on a thread of its own,
+		 * making disk read, decompression and deserialisation a three-stage
+		 * pipeline. A load check only touches a few chunks; reading ahead
+		 * would mostly decompress data that is thrown away again. */
+		_sl->lf = new PrefetchLoadFilter(_sl->lf);
+	}
+	_sl->reader = new ReadBuffer(_sl->lf);
 	_next_offs = 0;
 
 	if (!load_check) {
@@ -3216,7 +3821,7 @@ static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 SaveOrLoadResult LoadWithFilter(LoadFilter *reader)
 {
 	try {
-		_sl.action = SLA_LOAD;
+		_sl->action = SLA_LOAD;
 		return DoLoad(reader, false);
 	} catch (...) {
 		ClearSaveLoadState();
@@ -3236,7 +3841,7 @@ SaveOrLoadResult LoadWithFilter(LoadFilter *reader)
 SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop, DetailedFileType dft, Subdirectory sb, bool threaded)
 {
 	/* An instance of saving is already active, so don't go saving again */
-	if (_sl.saveinprogress && fop == SLO_SAVE && dft == DFT_GAME_FILE && threaded) {
+	if (_sl->saveinprogress && fop == SLO_SAVE && dft == DFT_GAME_FILE && threaded) {
 		/* if not an autosave, but a user action, show error message */
 		if (!_do_autosave) ShowErrorMessage(STR_ERROR_SAVE_STILL_IN_PROGRESS, INVALID_STRING_ID, WL_ERROR);
 		return SL_OK;
@@ -3271,36 +3876,38 @@ SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop,
 		assert(dft == DFT_GAME_FILE);
 		switch (fop) {
 			case SLO_CHECK:
-				_sl.action = SLA_LOAD_CHECK;
+				_sl->action = SLA_LOAD_CHECK;
 				break;
 
 			case SLO_LOAD:
-				_sl.action = SLA_LOAD;
+				_sl->action = SLA_LOAD;
 				break;
 
 			case SLO_SAVE:
-				_sl.action = SLA_SAVE;
+				_sl->action = SLA_SAVE;
 				break;
 
 			default: NOT_REACHED();
 		}
 
-		FILE *fh = (fop == SLO_SAVE) ? FioFOpenFile(filename, "wb", sb) : FioFOpenFile(filename, "rb", sb);
-
-		/* Make it a little easier to load savegames from the console */
-		if (fh == nullptr && fop != SLO_SAVE) fh = FioFOpenFile(filename, "rb", SAVE_DIR);
-		if (fh == nullptr && fop != SLO_SAVE) fh = FioFOpenFile(filename, "rb", BASE_DIR);
-		if (fh == nullptr && fop != SLO_SAVE) fh = FioFOpenFile(filename, "rb", SCENARIO_DIR);
-
-		if (fh == nullptr) {
-			SlError(fop == SLO_SAVE ? STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE : STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
-		}
-
 		if (fop == SLO_SAVE) { // SAVE game
 			Debug(desync, 1, "save: {:08x}; {:02x}; {}", _date, _date_fract, filename);
 			if (_network_server || !_settings_client.gui.threaded_saves) threaded = false;
 
-			return DoSave(new FileWriter(fh), threaded);
+			/* The file is opened on the first write, so a save that turns
+			 * out to be skippable does not truncate its target. */
+			return DoSave(new FileWriter(filename, sb), threaded);
+		}
+
+		FILE *fh = FioFOpenFile(filename, "rb", sb);
+
+		/* Make it a little easier to load savegames from the console */
+		if (fh == nullptr) fh = FioFOpenFile(filename, "rb", SAVE_DIR);
+		if (fh == nullptr) fh = FioFOpenFile(filename, "rb", BASE_DIR);
+		if (fh == nullptr) fh = FioFOpenFile(filename, "rb", SCENARIO_DIR);
+
+		if (fh == nullptr) {
+			SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
 		}
 
 		/* LOAD game */
@@ -343,6 +343,12 @@ enum SaveLoadVersion : uint16 {
 	SLV_U64_TICK_COUNTER,                   ///< 300  PR#10035 Make _tick_counter 64bit to avoid wrapping.
 	SLV_LAST_LOADING_TICK,                  ///< 301  PR#9693 Store tick of last loading for vehicles.
 	SLV_MULTITRACK_LEVEL_CROSSINGS,         ///< 302  PR#9931 v13.0  Multi-track level crossings.
+	SLV_LINKGRAPH_CHANGE_TRACKING,          ///< 303  Track link graph changes to skip recalculating unchanged graphs.
+	SLV_TRAIN_PATH_CACHE,                   ///< 304  Add path cache for trains.
+	SLV_WATER_TILE_NON_FLOODING,            ///< 305  Store water tile non-flooding state.
+	SLV_DEFERRED_DATE_EVENTS,               ///< 306  Spread daily/monthly pool sweeps over the ticks after the day boundary.
+	SLV_STATE_CHECKSUMS,                    ///< 307  Rolling per-subsystem state hashes for desync detection.
+	SLV_LAZY_CARGO_AGING,                   ///< 308  Age vehicle cargo through per-list aging epochs instead of per-packet sweeps.
 
 	SL_MAX_VERSION,                         ///< Highest possible saveload version
 };
@@ -249,6 +249,9 @@ void AfterLoadVehicles(bool part_of_load)
 		if (part_of_load) v->fill_percent_te_id = INVALID_TE_ID;
 		v->first = nullptr;
 		if (v->IsGroundVehicle()) v->GetGroundVehicleCache()->first_engine = INVALID_ENGINE;
+
+		/* The NewGRFs or their sprite blocks may have changed, so cached resolver results are stale. */
+		v->InvalidateNewGRFCache();
 	}
 
 	/* AfterLoadVehicles may also be called in case of NewGRF reload, in this
@@ -637,6 +640,7 @@ public:
 		SLEG_CONDVAR("cargo_count", _cargo_count,   SLE_UINT16,                   SL_MIN_VERSION,  SLV_68),
 		SLE_CONDREFLIST(Vehicle, cargo.packets,     REF_CARGO_PACKET,            SLV_68, SL_MAX_VERSION),
 		SLE_CONDARR(Vehicle, cargo.action_counts,   SLE_UINT, VehicleCargoList::NUM_MOVE_TO_ACTION, SLV_181, SL_MAX_VERSION),
+		SLE_CONDVAR(Vehicle, cargo.age_epoch,       SLE_UINT32,                 SLV_LAZY_CARGO_AGING, SL_MAX_VERSION),
 		SLE_CONDVAR(Vehicle, cargo_age_counter,     SLE_UINT16,                 SLV_162, SL_MAX_VERSION),
 
 		    SLE_VAR(Vehicle, day_counter,           SLE_UINT8),
@@ -747,6 +751,9 @@ public:
 		 SLE_CONDVAR(Train, flags,               SLE_UINT16,                 SLV_100, SL_MAX_VERSION),
 		 SLE_CONDVAR(Train, wait_counter,        SLE_UINT16,                 SLV_136, SL_MAX_VERSION),
 		 SLE_CONDVAR(Train, gv_flags,            SLE_UINT16,                 SLV_139, SL_MAX_VERSION),
+	SLE_CONDDEQUE(Train, path.td,                SLE_UINT8,                  SLV_TRAIN_PATH_CACHE, SL_MAX_VERSION),
+	SLE_CONDDEQUE(Train, path.tile,              SLE_UINT32,                 SLV_TRAIN_PATH_CACHE, SL_MAX_VERSION),
+	 SLE_CONDVAR(Train, path.dest_tile,          SLE_UINT32,                 SLV_TRAIN_PATH_CACHE, SL_MAX_VERSION),
 	};
 	inline const static SaveLoadCompatTable compat_description = _vehicle_train_sl_compat;
 
@@ -29,6 +29,9 @@
 #include "landscape.h"
 #include "video/video_driver.hpp"
 #include "smallmap_gui.h"
+#include "thread.h"
+
+#include <condition_variable>
 
 #include "table/strings.h"
 
@@ -814,6 +817,144 @@ static bool MakeLargeWorldScreenshot(ScreenshotType t, uint32 width = 0, uint32
 			BlitterFactory::GetCurrentBlitter()->GetScreenDepth(), _cur_palette.palette);
 }
 
+/** State shared between the game thread and the thread writing an asynchronous world screenshot. */
+struct AsyncScreenshotState {
+	std::thread thread;                   ///< Thread running the format writer.
+	std::mutex mutex;                     ///< Protects all fields below.
+	std::condition_variable request_made; ///< Signalled by the writer when it requests a strip or finishes.
+	std::condition_variable strip_done;   ///< Signalled by the game thread when the requested strip is rendered.
+
+	Viewport vp;                ///< Viewport to render, set up before the writer starts.
+	const ScreenshotFormat *sf; ///< Format writer in use.
+	std::string filename;       ///< Full path of the screenshot file.
+	std::string display_name;   ///< Name to show in the completion message.
+	int pixelformat;            ///< Bits per pixel to render with.
+	Colour palette[256];        ///< Copy of the palette at the start of the screenshot.
+
+	void *buf = nullptr;  ///< Writer buffer to render the requested strip into.
+	uint y = 0;           ///< First line of the requested strip.
+	uint pitch = 0;       ///< Pitch of the requested strip.
+	uint n = 0;           ///< Number of lines of the requested strip.
+	bool pending = false; ///< Whether a strip request is waiting for the game thread.
+	bool finished = false; ///< Whether the writer is done with the file.
+	bool success = false;  ///< Result of the format writer.
+};
+
+static std::unique_ptr<AsyncScreenshotState> _async_screenshot; ///< World screenshot currently being written, if any.
+
+/**
+ * Callback of the asynchronous world screenshot writer. Runs on the writer
+ * thread; it hands the strip request over to the game thread and blocks
+ * until ProcessAsyncScreenshot() has rendered the strip.
+ * @see ScreenshotCallback
+ */
+static void AsyncLargeWorldCallback(void *userdata, void *buf, uint y, uint pitch, uint n)
+{
+	AsyncScreenshotState *as = (AsyncScreenshotState *)userdata;
+
+	std::unique_lock<std::mutex> lock(as->mutex);
+	as->buf = buf;
+	as->y = y;
+	as->pitch = pitch;
+	as->n = n;
+	as->pending = true;
+	as->request_made.notify_one();
+	as->strip_done.wait(lock, [as]() { return !as->pending; });
+}
+
+/** Entry point of the world screenshot writer thread. */
+static void AsyncScreenshotThread()
+{
+	AsyncScreenshotState *as = _async_screenshot.get();
+
+	bool success = as->sf->proc(as->filename.c_str(), AsyncLargeWorldCallback, as, as->vp.width, as->vp.height, as->pixelformat, as->palette);
+
+	std::lock_guard<std::mutex> lock(as->mutex);
+	as->success = success;
+	as->finished = true;
+	as->request_made.notify_one();
+}
+
+/**
+ * Start writing a world screenshot without blocking the game. The map is
+ * rendered in strips from the game loop, while the compression and the file
+ * writing are done on a separate thread.
+ * @return true iff the screenshot thread was successfully started.
+ */
+static bool StartAsyncWorldScreenshot()
+{
+	auto as = std::make_unique<AsyncScreenshotState>();
+	SetupScreenshotViewport(SC_WORLD, &as->vp);
+
+	as->sf = _screenshot_formats + _cur_screenshot_format;
+	as->filename = MakeScreenshotName(SCREENSHOT_NAME, as->sf->extension);
+	as->display_name = _screenshot_name;
+	as->pixelformat = BlitterFactory::GetCurrentBlitter()->GetScreenDepth();
+	memcpy(as->palette, _cur_palette.palette, sizeof(as->palette));
+
+	_async_screenshot = std::move(as);
+	AsyncScreenshotState *state = _async_screenshot.get();
+	if (!StartNewThread(&state->thread, "ottd:screenshot", &AsyncScreenshotThread)) {
+		Debug(misc, 1, "Cannot create world screenshot thread, reverting to single-threaded mode...");
+		_async_screenshot.reset();
+		return false;
+	}
+
+	/* Block until the writer asks for its first strip. Until then it is
+	 * writing the file header, which for PNG reads the company list and the
+	 * NewGRF configuration for the image metadata; by waiting here the game
+	 * state cannot change under it. */
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->request_made.wait(lock, [state]() { return state->pending || state->finished; });
+	return true;
+}
+
+/**
+ * Render a strip requested by the world screenshot writer, and finalize the
+ * screenshot once the writer is done. Called from the game loop; the writer
+ * thread only ever touches the game state while the game thread waits here.
+ */
+void ProcessAsyncScreenshot()
+{
+	AsyncScreenshotState *as = _async_screenshot.get();
+	if (as == nullptr) return;
+
+	bool finished;
+	{
+		std::lock_guard<std::mutex> lock(as->mutex);
+		if (as->pending) {
+			LargeWorldCallback(&as->vp, as->buf, as->y, as->pitch, as->n);
+			as->pending = false;
+			as->strip_done.notify_one();
+		}
+		finished = as->finished;
+	}
+	if (!finished) return;
+
+	as->thread.join();
+
+	if (as->success) {
+		SetDParamStr(0, as->display_name);
+		ShowErrorMessage(STR_MESSAGE_SCREENSHOT_SUCCESSFULLY, INVALID_STRING_ID, WL_WARNING);
+	} else {
+		ShowErrorMessage(STR_ERROR_SCREENSHOT_FAILED, INVALID_STRING_ID, WL_ERROR);
+	}
+	_async_screenshot.reset();
+}
+
+/** Render all outstanding strips till the world screenshot being written, if any, is finished. */
+void WaitTillScreenshotTaken()
+{
+	while (_async_screenshot != nullptr) {
+		{
+			AsyncScreenshotState *as = _async_screenshot.get();
+			std::unique_lock<std::mutex> lock(as->mutex);
+			as->request_made.wait(lock, [as]() { return as->pending || as->finished; });
+		}
+		ProcessAsyncScreenshot();
+	}
+}
+
 /**
  * Callback for generating a heightmap. Supports 8bpp grayscale only.
  * @param userdata Pointer to user data.
@@ -942,6 +1083,16 @@ static bool RealMakeScreenshot(ScreenshotType t, std::string name, uint32 width,
 			break;
 
 		case SC_WORLD:
+			/* Don't start a second world screenshot while one is still being written. */
+			if (_async_screenshot != nullptr) {
+				ret = false;
+				break;
+			}
+			if (StartAsyncWorldScreenshot()) {
+				/* The completion message is shown from ProcessAsyncScreenshot(). */
+				return true;
+			}
+			/* No thread support; fall back to the blocking renderer. */
 			ret = MakeLargeWorldScreenshot(t);
 			break;
 
@@ -30,6 +30,8 @@ bool MakeHeightmapScreenshot(const char *filename);
 void MakeScreenshotWithConfirm(ScreenshotType t);
 bool MakeScreenshot(ScreenshotType t, std::string name, uint32 width = 0, uint32 height = 0);
 bool MakeMinimapWorldScreenshot();
+void ProcessAsyncScreenshot();
+void WaitTillScreenshotTaken();
 
 extern std::string _screenshot_format_name;
 extern uint _num_screenshot_formats;
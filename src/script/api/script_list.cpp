@@ -521,6 +521,15 @@ bool ScriptList::SetValue(int64 item, int64 value)
 	return true;
 }
 
+void ScriptList::RebuildBuckets()
+{
+	this->buckets.clear();
+	for (ScriptListMap::const_iterator iter = this->items.begin(); iter != this->items.end(); iter++) {
+		this->buckets[(*iter).second].insert((*iter).first);
+	}
+	this->sorter->End();
+}
+
 void ScriptList::Sort(SorterType sorter, bool ascending)
 {
 	this->modifications++;
@@ -869,6 +878,11 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	/* Push the function to call */
 	sq_push(vm, 2);
 
+	/* The values are assigned into the item map directly; updating the value
+	 * buckets per item would cost two tree operations for every item, so they
+	 * are rebuilt in one sweep once all new values are known. */
+	bool value_changed = false;
+
 	for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter++) {
 		/* Check for changing of items. */
 		int previous_modification_count = this->modifications;
@@ -883,6 +897,7 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 
 		/* Call the function. Squirrel pops all parameters and pushes the return value. */
 		if (SQ_FAILED(sq_call(vm, nparam + 1, SQTrue, SQTrue))) {
+			if (value_changed) this->RebuildBuckets();
 			ScriptObject::SetAllowDoCommand(backup_allow);
 			return SQ_ERROR;
 		}
@@ -906,6 +921,7 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 				/* See below for explanation. The extra pop is the return value. */
 				sq_pop(vm, nparam + 4);
 
+				if (value_changed) this->RebuildBuckets();
 				ScriptObject::SetAllowDoCommand(backup_allow);
 				return sq_throwerror(vm, "return value of valuator is not valid (not integer/bool)");
 			}
@@ -917,6 +933,7 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 			/* See below for explanation. The extra pop is the return value. */
 			sq_pop(vm, nparam + 4);
 
+			if (value_changed) this->RebuildBuckets();
 			ScriptObject::SetAllowDoCommand(backup_allow);
 			return sq_throwerror(vm, "excessive CPU usage in valuator function");
 		}
@@ -926,11 +943,15 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 			/* See below for explanation. The extra pop is the return value. */
 			sq_pop(vm, nparam + 4);
 
+			if (value_changed) this->RebuildBuckets();
 			ScriptObject::SetAllowDoCommand(backup_allow);
 			return sq_throwerror(vm, "modifying valuated list outside of valuator function");
 		}
 
-		this->SetValue((*iter).first, value);
+		if ((*iter).second != value) {
+			(*iter).second = value;
+			value_changed = true;
+		}
 
 		/* Pop the return value. */
 		sq_poptop(vm);
@@ -944,6 +965,7 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	 * 4. The ScriptList instance object. */
 	sq_pop(vm, nparam + 3);
 
+	if (value_changed) this->RebuildBuckets();
 	ScriptObject::SetAllowDoCommand(backup_allow);
 	return 0;
 }
@@ -41,6 +41,12 @@ private:
 	bool initialized;             ///< Whether an iteration has been started
 	int modifications;            ///< Number of modification that has been done. To prevent changing data while valuating.
 
+	/**
+	 * Rebuild the value buckets from the item map in one sweep, for use
+	 * after a bulk update of the values.
+	 */
+	void RebuildBuckets();
+
 public:
 	typedef std::set<int64> ScriptItemList;                   ///< The list of items inside the bucket
 	typedef std::map<int64, ScriptItemList> ScriptListBucket; ///< The bucket list per value
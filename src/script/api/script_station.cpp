@@ -61,6 +61,9 @@ template<bool Tfrom, bool Tvia>
 	const StationCargoList &cargo_list = ::Station::Get(station_id)->goods[cargo_id].cargo;
 	if (!Tfrom && !Tvia) return cargo_list.TotalCount();
 
+	/* The cargo list maintains the totals per next hop; no need to walk the packets. */
+	if (!Tfrom && Tvia) return static_cast<uint16>(cargo_list.AvailableViaCount(via_station_id));
+
 	uint16 cargo_count = 0;
 	std::pair<StationCargoList::ConstIterator, StationCargoList::ConstIterator> range = Tvia ?
 				cargo_list.Packets()->equal_range(via_station_id) :
@@ -225,7 +225,13 @@ ScriptStationList_CargoWaitingViaByFrom::ScriptStationList_CargoWaitingViaByFrom
 ScriptStationList_CargoWaitingByVia::ScriptStationList_CargoWaitingByVia(StationID station_id,
 		CargoID cargo)
 {
-	this->Add<CS_BY_VIA>(station_id, cargo);
+	CargoCollector collector(this, station_id, cargo, INVALID_STATION);
+	if (collector.GE() == nullptr) return;
+
+	/* The cargo list maintains the totals per next hop; no need to walk the packets. */
+	for (const auto &bucket : collector.GE()->cargo.AvailableCounts()) {
+		collector.Update<CS_BY_VIA>(INVALID_STATION, bucket.first, bucket.second);
+	}
 }
 
 ScriptStationList_CargoWaitingFromByVia::ScriptStationList_CargoWaitingFromByVia(
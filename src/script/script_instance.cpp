@@ -167,22 +167,22 @@ void ScriptInstance::Died()
 	this->engine = nullptr;
 }
 
-void ScriptInstance::GameLoop()
+SQInteger ScriptInstance::GameLoop(SQInteger opcodes)
 {
 	ScriptObject::ActiveInstance active(this);
 
-	if (this->IsDead()) return;
+	if (this->IsDead()) return opcodes;
 	if (this->engine->HasScriptCrashed()) {
 		/* The script crashed during saving, kill it here. */
 		this->Died();
-		return;
+		return opcodes;
 	}
-	if (this->is_paused) return;
+	if (this->is_paused) return opcodes;
 	this->controller->ticks++;
 
-	if (this->suspend   < -1) this->suspend++; // Multiplayer suspend, increase up to -1.
-	if (this->suspend   < 0)  return;          // Multiplayer suspend, wait for Continue().
-	if (--this->suspend > 0)  return;          // Singleplayer suspend, decrease to 0.
+	if (this->suspend   < -1) this->suspend++;         // Multiplayer suspend, increase up to -1.
+	if (this->suspend   < 0)  return opcodes;          // Multiplayer suspend, wait for Continue().
+	if (--this->suspend > 0)  return opcodes;          // Singleplayer suspend, decrease to 0.
 
 	_current_company = ScriptObject::GetCompany();
 
@@ -198,7 +198,7 @@ void ScriptInstance::GameLoop()
 			this->suspend  = e.GetSuspendTime();
 			this->callback = e.GetSuspendCallback();
 
-			return;
+			return 0;
 		}
 	}
 
@@ -213,17 +213,22 @@ void ScriptInstance::GameLoop()
 				if (!this->engine->CallMethod(*this->instance, "constructor", MAX_CONSTRUCTOR_OPS) || this->engine->IsSuspended()) {
 					if (this->engine->IsSuspended()) ScriptLog::Error("This script took too long to initialize. Script is not started.");
 					this->Died();
-					return;
+					return 0;
 				}
 			}
 			if (!this->CallLoad() || this->engine->IsSuspended()) {
 				if (this->engine->IsSuspended()) ScriptLog::Error("This script took too long in the Load function. Script is not started.");
 				this->Died();
-				return;
+				return 0;
 			}
 			ScriptObject::SetAllowDoCommand(true);
 			/* Start the script by calling Start() */
-			if (!this->engine->CallMethod(*this->instance, "Start",  _settings_game.script.script_max_opcode_till_suspend) || !this->engine->IsSuspended()) this->Died();
+			if (!this->engine->CallMethod(*this->instance, "Start", opcodes) || !this->engine->IsSuspended()) {
+				this->Died();
+			} else {
+				/* Pick up a suspension the API recorded instead of throwing. */
+				this->engine->GetPendingSuspend(this->suspend, this->callback);
+			}
 		} catch (Script_Suspend &e) {
 			this->suspend  = e.GetSuspendTime();
 			this->callback = e.GetSuspendCallback();
@@ -235,7 +240,7 @@ void ScriptInstance::GameLoop()
 		}
 
 		this->is_started = true;
-		return;
+		return 0;
 	}
 	if (this->is_save_data_on_stack) {
 		sq_poptop(this->engine->GetVM());
@@ -244,7 +249,12 @@ void ScriptInstance::GameLoop()
 
 	/* Continue the VM */
 	try {
-		if (!this->engine->Resume(_settings_game.script.script_max_opcode_till_suspend)) this->Died();
+		if (!this->engine->Resume(opcodes)) {
+			this->Died();
+			return 0;
+		}
+		/* Pick up a suspension the API recorded instead of throwing. */
+		this->engine->GetPendingSuspend(this->suspend, this->callback);
 	} catch (Script_Suspend &e) {
 		this->suspend  = e.GetSuspendTime();
 		this->callback = e.GetSuspendCallback();
@@ -253,7 +263,14 @@ void ScriptInstance::GameLoop()
 		this->engine->ThrowError(e.GetErrorMessage().c_str());
 		this->engine->ResumeError();
 		this->Died();
+		return 0;
 	}
+
+	/* A script that suspended voluntarily, e.g. by sleeping, leaves part of
+	 * its budget unexecuted; report that so the caller can hand it out to
+	 * another script. A script stopped by running out of opcodes leaves a
+	 * zero or negative balance behind. */
+	return std::max<SQInteger>(0, this->engine->GetOpsTillSuspend());
 }
 
 void ScriptInstance::CollectGarbage()
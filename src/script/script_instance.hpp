@@ -79,8 +79,10 @@ public:
 
 	/**
 	 * Run the GameLoop of a script.
+	 * @param opcodes The number of opcodes the script may execute this tick.
+	 * @return The unused part of the opcode budget, available for handing out to another script.
 	 */
-	void GameLoop();
+	SQInteger GameLoop(SQInteger opcodes);
 
 	/**
 	 * Let the VM collect any garbage.
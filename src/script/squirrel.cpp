@@ -18,6 +18,7 @@
 #include <../squirrel/sqpcheader.h>
 #include <../squirrel/sqvm.h>
 #include "../core/alloc_func.hpp"
+#include "../3rdparty/md5/md5.h"
 
 #include <stdarg.h>
 #include <map>
@@ -49,10 +50,75 @@ struct ScriptAllocator {
 
 	static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almost any situation
 
+	static const size_t MAX_POOLED_SIZE = 256;       ///< Allocations of at most this size are served from pooled chunks.
+	static const size_t POOL_GRANULARITY = 16;       ///< Size granularity of the pooled size classes; also the alignment of pooled blocks.
+	static const size_t POOL_CHUNK_SIZE = 64 * 1024; ///< Size of the chunks the pooled blocks are carved from.
+
+	std::vector<void *> pool_chunks; ///< Chunks backing the pooled blocks; freed in one go when the script dies.
+	void *pool_free_list[MAX_POOLED_SIZE / POOL_GRANULARITY]; ///< Head of the free block list of each size class.
+	char *pool_bump;  ///< First unused byte of the newest chunk.
+	size_t pool_left; ///< Number of unused bytes left in the newest chunk.
+
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 	std::map<void *, size_t> allocations;
 #endif
 
+	/**
+	 * Allocate memory, either from the pooled chunks for the small
+	 * Squirrel objects or directly from the OS for anything bigger.
+	 * Keeping a script's many small objects together in chunks keeps its
+	 * working set page-local and avoids fragmenting the heap between the
+	 * running script instances.
+	 * @param size The requested size.
+	 * @return The allocated memory, or \c nullptr when the OS is out of memory.
+	 */
+	void *DoMalloc(size_t size)
+	{
+		if (size > MAX_POOLED_SIZE) return malloc(size);
+
+		size_t cls = std::max<size_t>(1, (size + POOL_GRANULARITY - 1) / POOL_GRANULARITY);
+		void *&head = this->pool_free_list[cls - 1];
+		if (head != nullptr) {
+			void *p = head;
+			head = *(void **)p;
+			return p;
+		}
+
+		size_t block = cls * POOL_GRANULARITY;
+		if (this->pool_left < block) {
+			char *chunk = (char *)malloc(POOL_CHUNK_SIZE);
+			if (chunk == nullptr) return nullptr;
+			this->pool_chunks.push_back(chunk);
+			this->pool_bump = chunk;
+			this->pool_left = POOL_CHUNK_SIZE;
+		}
+
+		void *p = this->pool_bump;
+		this->pool_bump += block;
+		this->pool_left -= block;
+		return p;
+	}
+
+	/**
+	 * Give memory allocated by DoMalloc() back, to the free list of its
+	 * size class for pooled blocks or to the OS for anything bigger.
+	 * @param p    The memory to free.
+	 * @param size The size the memory was allocated with.
+	 */
+	void DoFree(void *p, size_t size)
+	{
+		if (p == nullptr) return;
+
+		if (size > MAX_POOLED_SIZE) {
+			free(p);
+			return;
+		}
+
+		size_t cls = std::max<size_t>(1, (size + POOL_GRANULARITY - 1) / POOL_GRANULARITY);
+		*(void **)p = this->pool_free_list[cls - 1];
+		this->pool_free_list[cls - 1] = p;
+	}
+
 	void CheckLimit() const
 	{
 		if (this->allocated_size > this->allocation_limit) throw Script_FatalError("Maximum memory allocation exceeded");
@@ -66,8 +132,9 @@ struct ScriptAllocator {
 	 * clean everything up.
 	 * @param requested_size The requested size that was requested to be allocated.
 	 * @param p              The pointer to the allocated object, or null if allocation failed.
+	 * @param alloc_size     The size \a p was allocated with, needed to return it to the right pool.
 	 */
-	void CheckAllocation(size_t requested_size, void *p)
+	void CheckAllocation(size_t requested_size, void *p, size_t alloc_size)
 	{
 		if (this->allocated_size + requested_size > this->allocation_limit && !this->error_thrown) {
 			/* Do not allow allocating more than the allocation limit, except when an error is
@@ -78,7 +145,7 @@ struct ScriptAllocator {
 			seprintf(buff, lastof(buff), "Maximum memory allocation exceeded by " PRINTF_SIZE " bytes when allocating " PRINTF_SIZE " bytes",
 				this->allocated_size + requested_size - this->allocation_limit, requested_size);
 			/* Don't leak the rejected allocation. */
-			free(p);
+			this->DoFree(p, alloc_size);
 			throw Script_FatalError(buff);
 		}
 
@@ -101,9 +168,9 @@ struct ScriptAllocator {
 
 	void *Malloc(SQUnsignedInteger size)
 	{
-		void *p = malloc(size);
+		void *p = this->DoMalloc(size);
 
-		this->CheckAllocation(size, p);
+		this->CheckAllocation(size, p, size);
 
 		this->allocated_size += size;
 
@@ -134,13 +201,13 @@ struct ScriptAllocator {
 		 * If memory exception is thrown, the old pointer is expected
 		 * to be valid for engine cleanup.
 		 */
-		void *new_p = malloc(size);
+		void *new_p = this->DoMalloc(size);
 
-		this->CheckAllocation(size - oldsize, new_p);
+		this->CheckAllocation(size - oldsize, new_p, size);
 
 		/* Memory limit test passed, we can copy data and free old pointer. */
 		memcpy(new_p, p, std::min(oldsize, size));
-		free(p);
+		this->DoFree(p, oldsize);
 
 		this->allocated_size -= oldsize;
 		this->allocated_size += size;
@@ -157,7 +224,7 @@ struct ScriptAllocator {
 	void Free(void *p, SQUnsignedInteger size)
 	{
 		if (p == nullptr) return;
-		free(p);
+		this->DoFree(p, size);
 		this->allocated_size -= size;
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
@@ -172,6 +239,9 @@ struct ScriptAllocator {
 		this->allocation_limit = static_cast<size_t>(_settings_game.script.script_max_memory_megabytes) << 20;
 		if (this->allocation_limit == 0) this->allocation_limit = SAFE_LIMIT; // in case the setting is somehow zero
 		this->error_thrown = false;
+		memset(this->pool_free_list, 0, sizeof(this->pool_free_list));
+		this->pool_bump = nullptr;
+		this->pool_left = 0;
 	}
 
 	~ScriptAllocator()
@@ -179,6 +249,9 @@ struct ScriptAllocator {
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations.size() == 0);
 #endif
+		/* All pooled blocks of the script die with the allocator; their
+		 * backing chunks can simply be given back in one go. */
+		for (void *chunk : this->pool_chunks) free(chunk);
 	}
 };
 
@@ -365,6 +438,29 @@ void Squirrel::AddClassEnd()
 	sq_pop(vm, 1);
 }
 
+bool Squirrel::FindClass(const char *class_name, HSQOBJECT *obj)
+{
+	auto it = this->class_cache.find(class_name);
+	if (it != this->class_cache.end()) {
+		*obj = it->second;
+		return true;
+	}
+
+	ScriptAllocatorScope alloc_scope(this);
+
+	sq_pushroottable(this->vm);
+	sq_pushstring(this->vm, class_name, -1);
+	if (SQ_FAILED(sq_get(this->vm, -2))) {
+		sq_pop(this->vm, 1);
+		return false;
+	}
+	sq_getstackobj(this->vm, -1, obj);
+	sq_pop(this->vm, 2);
+
+	this->class_cache[class_name] = *obj;
+	return true;
+}
+
 bool Squirrel::MethodExists(HSQOBJECT instance, const char *method_name)
 {
 	assert(!this->crashed);
@@ -387,6 +483,7 @@ bool Squirrel::Resume(int suspend)
 {
 	assert(!this->crashed);
 	ScriptAllocatorScope alloc_scope(this);
+	this->has_pending_suspend = false;
 
 	/* Did we use more operations than we should have in the
 	 * previous tick? If so, subtract that from the current run. */
@@ -423,6 +520,7 @@ bool Squirrel::CallMethod(HSQOBJECT instance, const char *method_name, HSQOBJECT
 	assert(!this->crashed);
 	ScriptAllocatorScope alloc_scope(this);
 	this->allocator->CheckLimit();
+	this->has_pending_suspend = false;
 
 	/* Store the stack-location for the return value. We need to
 	 * restore this after saving or the stack will be corrupted
@@ -537,11 +635,35 @@ bool Squirrel::CreateClassInstance(const char *class_name, void *real_instance,
 }
 
 Squirrel::Squirrel(const char *APIName) :
-	APIName(APIName), allocator(new ScriptAllocator())
+	APIName(APIName), allocator(new ScriptAllocator()),
+	has_pending_suspend(false), suspend_time(0), suspend_callback(nullptr)
 {
 	this->Initialize();
 }
 
+/* static */ SQInteger Squirrel::SuspendClosure(HSQUIRRELVM vm, Script_Suspend &e)
+{
+	/* Mirror the guards of SQVM::Suspend: with nested native calls or an
+	 * already suspended VM the callers do not expect a suspension, so let
+	 * the request unwind the whole call stack as before. */
+	if (vm->_suspended || vm->_nnativecalls != 2) throw;
+
+	Squirrel *engine = (Squirrel *)sq_getforeignptr(vm);
+	engine->has_pending_suspend = true;
+	engine->suspend_time = e.GetSuspendTime();
+	engine->suspend_callback = e.GetSuspendCallback();
+	return SQ_SUSPEND_FLAG;
+}
+
+bool Squirrel::GetPendingSuspend(int &time, Script_SuspendCallbackProc *&callback)
+{
+	if (!this->has_pending_suspend) return false;
+	this->has_pending_suspend = false;
+	time = this->suspend_time;
+	callback = this->suspend_callback;
+	return true;
+}
+
 void Squirrel::Initialize()
 {
 	ScriptAllocatorScope alloc_scope(this);
@@ -570,23 +692,23 @@ void Squirrel::Initialize()
 
 class SQFile {
 private:
-	FILE *file;
+	const char *buf;
 	size_t size;
 	size_t pos;
 
 public:
-	SQFile(FILE *file, size_t size) : file(file), size(size), pos(0) {}
+	SQFile(const char *buf, size_t size) : buf(buf), size(size), pos(0) {}
 
-	size_t Read(void *buf, size_t elemsize, size_t count)
+	size_t Read(void *dest, size_t elemsize, size_t count)
 	{
 		assert(elemsize != 0);
 		if (this->pos + (elemsize * count) > this->size) {
 			count = (this->size - this->pos) / elemsize;
 		}
 		if (count == 0) return 0;
-		size_t ret = fread(buf, elemsize, count, this->file);
-		this->pos += ret * elemsize;
-		return ret;
+		memcpy(dest, this->buf + this->pos, elemsize * count);
+		this->pos += elemsize * count;
+		return count;
 	}
 };
 
@@ -640,6 +762,42 @@ static SQInteger _io_file_read(SQUserPointer file, SQUserPointer buf, SQInteger
 	return ret;
 }
 
+/** Compiled bytecode of a script file. */
+struct ScriptBytecodeCacheEntry {
+	std::array<uint8, 16> checksum; ///< Checksum of the source the bytecode was compiled from.
+	std::vector<char> bytecode;     ///< Serialized closure as written by sq_writeclosure.
+};
+
+/**
+ * Compiled bytecode of script files, keyed by filename. Scripts are restarted
+ * on every new game; serving the closures from here avoids recompiling them.
+ */
+static std::map<std::string, ScriptBytecodeCacheEntry> _bytecode_cache;
+
+/** Memory buffer for serializing and deserializing closures. */
+struct SQBytecodeBuffer {
+	std::vector<char> &data; ///< Buffer with the serialized closure.
+	size_t pos;              ///< Read position within the buffer.
+
+	SQBytecodeBuffer(std::vector<char> &data) : data(data), pos(0) {}
+};
+
+static SQInteger _bytecode_write(SQUserPointer up, SQUserPointer src, SQInteger size)
+{
+	SQBytecodeBuffer *buf = (SQBytecodeBuffer *)up;
+	buf->data.insert(buf->data.end(), (const char *)src, (const char *)src + size);
+	return size;
+}
+
+static SQInteger _bytecode_read(SQUserPointer up, SQUserPointer dest, SQInteger size)
+{
+	SQBytecodeBuffer *buf = (SQBytecodeBuffer *)up;
+	if (buf->pos + size > buf->data.size()) return -1;
+	memcpy(dest, buf->data.data() + buf->pos, size);
+	buf->pos += size;
+	return size;
+}
+
 SQRESULT Squirrel::LoadFile(HSQUIRRELVM vm, const char *filename, SQBool printerror)
 {
 	ScriptAllocatorScope alloc_scope(this);
@@ -659,25 +817,26 @@ SQRESULT Squirrel::LoadFile(HSQUIRRELVM vm, const char *filename, SQBool printer
 	if (file == nullptr) {
 		return sq_throwerror(vm, "cannot open the file");
 	}
-	unsigned short bom = 0;
-	if (size >= 2) {
-		[[maybe_unused]] size_t sr = fread(&bom, 1, sizeof(bom), file);
+
+	/* Read the whole file up front, so it can be hashed for the bytecode cache
+	 * and compiled from memory. */
+	std::vector<char> source(size);
+	if (size != 0 && fread(source.data(), 1, size, file) != size) {
+		FioFCloseFile(file);
+		return sq_throwerror(vm, "I/O error");
 	}
+	FioFCloseFile(file);
 
+	unsigned short bom = 0;
+	if (size >= 2) memcpy(&bom, source.data(), sizeof(bom));
+
+	size_t offset = 0;
 	SQLEXREADFUNC func;
 	switch (bom) {
 		case SQ_BYTECODE_STREAM_TAG: { // BYTECODE
-			if (fseek(file, -2, SEEK_CUR) < 0) {
-				FioFCloseFile(file);
-				return sq_throwerror(vm, "cannot seek the file");
-			}
-
-			SQFile f(file, size);
-			if (SQ_SUCCEEDED(sq_readclosure(vm, _io_file_read, &f))) {
-				FioFCloseFile(file);
-				return SQ_OK;
-			}
-			FioFCloseFile(file);
+			/* Precompiled bytecode needs no compilation, and thus no caching. */
+			SQFile f(source.data(), size);
+			if (SQ_SUCCEEDED(sq_readclosure(vm, _io_file_read, &f))) return SQ_OK;
 			return sq_throwerror(vm, "Couldn't read bytecode");
 		}
 		case 0xFFFE:
@@ -685,44 +844,52 @@ SQRESULT Squirrel::LoadFile(HSQUIRRELVM vm, const char *filename, SQBool printer
 			 * machine, or this file is encoded as little-endian and we're on a big-endian
 			 * machine. Either way, swap the bytes of every word we read. */
 			func = _io_file_lexfeed_UCS2_swap;
-			size -= 2; // Skip BOM
+			offset = 2; // Skip BOM
 			break;
 		case 0xFEFF:
 			func = _io_file_lexfeed_UCS2_no_swap;
-			size -= 2; // Skip BOM
+			offset = 2; // Skip BOM
 			break;
 		case 0xBBEF:   // UTF-8
 		case 0xEFBB: { // UTF-8 on big-endian machine
 			/* Similarly, check the file is actually big enough to finish checking BOM */
-			if (size < 3) {
-				FioFCloseFile(file);
-				return sq_throwerror(vm, "I/O error");
-			}
-			unsigned char uc;
-			if (fread(&uc, 1, sizeof(uc), file) != sizeof(uc) || uc != 0xBF) {
-				FioFCloseFile(file);
+			if (size < 3 || (unsigned char)source[2] != 0xBF) {
 				return sq_throwerror(vm, "Unrecognized encoding");
 			}
 			func = _io_file_lexfeed_UTF8;
-			size -= 3; // Skip BOM
+			offset = 3; // Skip BOM
 			break;
 		}
 		default: // ASCII
 			func = _io_file_lexfeed_ASCII;
-			/* Account for when we might not have fread'd earlier */
-			if (size >= 2 && fseek(file, -2, SEEK_CUR) < 0) {
-				FioFCloseFile(file);
-				return sq_throwerror(vm, "cannot seek the file");
-			}
 			break;
 	}
 
-	SQFile f(file, size);
+	/* Serve the compiled closure from the cache when the source is unchanged,
+	 * so a script (re)start does not recompile every file. */
+	std::array<uint8, 16> checksum;
+	{
+		Md5 md5;
+		md5.Append(source.data(), size);
+		md5.Finish(checksum.data());
+	}
+	auto it = _bytecode_cache.find(filename);
+	if (it != _bytecode_cache.end() && it->second.checksum == checksum) {
+		SQBytecodeBuffer buf(it->second.bytecode);
+		if (SQ_SUCCEEDED(sq_readclosure(vm, _bytecode_read, &buf))) return SQ_OK;
+		_bytecode_cache.erase(it);
+	}
+
+	SQFile f(source.data() + offset, size - offset);
 	if (SQ_SUCCEEDED(sq_compile(vm, func, &f, filename, printerror))) {
-		FioFCloseFile(file);
+		/* Remember the compiled closure for the next load of this file. */
+		ScriptBytecodeCacheEntry &entry = _bytecode_cache[filename];
+		entry.checksum = checksum;
+		entry.bytecode.clear();
+		SQBytecodeBuffer buf(entry.bytecode);
+		if (SQ_FAILED(sq_writeclosure(vm, _bytecode_write, &buf))) _bytecode_cache.erase(filename);
 		return SQ_OK;
 	}
-	FioFCloseFile(file);
 	return SQ_ERROR;
 }
 
@@ -764,6 +931,9 @@ void Squirrel::Uninitialize()
 {
 	ScriptAllocatorScope alloc_scope(this);
 
+	/* The cached class objects die with the VM. */
+	this->class_cache.clear();
+
 	/* Clean up the stuff */
 	sq_pop(this->vm, 1);
 	sq_close(this->vm);
@@ -11,6 +11,8 @@
 #define SQUIRREL_HPP
 
 #include <squirrel.h>
+#include <map>
+#include "script_suspend.hpp"
 
 /** The type of script we're working with, i.e. for who is it? */
 enum ScriptType {
@@ -34,6 +36,12 @@ private:
 	const char *APIName;     ///< Name of the API used for this squirrel.
 	std::unique_ptr<ScriptAllocator> allocator; ///< Allocator object used by this script.
 
+	bool has_pending_suspend; ///< Whether an API call recorded a suspension request, see SuspendClosure.
+	int suspend_time;         ///< Suspension time of the recorded request.
+	Script_SuspendCallbackProc *suspend_callback; ///< Callback of the recorded request.
+
+	std::map<const char *, HSQOBJECT> class_cache; ///< Resolved global classes, so API calls do not look them up by name every time.
+
 	/**
 	 * The internal RunError handler. It looks up the real error and calls RunError with it.
 	 */
@@ -79,6 +87,15 @@ public:
 	 */
 	HSQUIRRELVM GetVM() { return this->vm; }
 
+	/**
+	 * Find a class in the global scope. The resolved class object is cached,
+	 *  so repeated calls do not probe the root table by name again.
+	 * @param class_name The name of the class in the global scope.
+	 * @param obj Storage for the found class object.
+	 * @return Whether the class was found.
+	 */
+	bool FindClass(const char *class_name, HSQOBJECT *obj);
+
 	/**
 	 * Load a script.
 	 * @param script The full script-name to load.
@@ -139,6 +156,24 @@ public:
 	 */
 	bool Resume(int suspend = -1);
 
+	/**
+	 * Convert a Script_Suspend thrown by an API method into a native closure
+	 * suspension where possible, so the request does not have to unwind
+	 * through the VM. The request is picked up through GetPendingSuspend().
+	 * @param vm The VM the API method was called from.
+	 * @param e  The suspension request; rethrown when conversion is not possible.
+	 * @return SQ_SUSPEND_FLAG, to return from the native closure.
+	 */
+	static SQInteger SuspendClosure(HSQUIRRELVM vm, Script_Suspend &e);
+
+	/**
+	 * Get and clear the suspension request recorded by an API call, if any.
+	 * @param[out] time     Ticks to suspend; only written when there was a request.
+	 * @param[out] callback Callback to run when the script resumes; only written when there was a request.
+	 * @return Whether a request was recorded since the last resumption.
+	 */
+	bool GetPendingSuspend(int &time, Script_SuspendCallbackProc *&callback);
+
 	/**
 	 * Resume the VM with an error so it prints a stack trace.
 	 */
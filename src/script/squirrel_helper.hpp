@@ -223,14 +223,15 @@ namespace SQConvert {
 		/* Get the 'SQ' instance of this class */
 		Squirrel::GetInstance(vm, &instance);
 
-		/* Protect against calls to a non-static method in a static way */
-		sq_pushroottable(vm);
-		const char *className = GetClassName<Tcls, Ttype>();
-		sq_pushstring(vm, className, -1);
-		sq_get(vm, -2);
+		/* Protect against calls to a non-static method in a static way. The
+		 * class object is cached by the engine, so this does not look it up
+		 * in the root table by name on every call. */
+		HSQOBJECT class_obj;
+		if (!((Squirrel *)sq_getforeignptr(vm))->FindClass(GetClassName<Tcls, Ttype>(), &class_obj)) return sq_throwerror(vm, "class method is non-static");
+		sq_pushobject(vm, class_obj);
 		sq_pushobject(vm, instance);
 		if (sq_instanceof(vm) != SQTrue) return sq_throwerror(vm, "class method is non-static");
-		sq_pop(vm, 3);
+		sq_pop(vm, 2);
 
 		/* Get the 'real' instance of this class */
 		sq_getinstanceup(vm, 1, &real_instance, nullptr);
@@ -245,6 +246,8 @@ namespace SQConvert {
 			return HelperT<Tmethod>::SQCall((Tcls *)real_instance, *(Tmethod *)ptr, vm);
 		} catch (SQInteger &e) {
 			return e;
+		} catch (Script_Suspend &e) {
+			return Squirrel::SuspendClosure(vm, e);
 		}
 	}
 
@@ -265,14 +268,15 @@ namespace SQConvert {
 		/* Get the 'SQ' instance of this class */
 		Squirrel::GetInstance(vm, &instance);
 
-		/* Protect against calls to a non-static method in a static way */
-		sq_pushroottable(vm);
-		const char *className = GetClassName<Tcls, Ttype>();
-		sq_pushstring(vm, className, -1);
-		sq_get(vm, -2);
+		/* Protect against calls to a non-static method in a static way. The
+		 * class object is cached by the engine, so this does not look it up
+		 * in the root table by name on every call. */
+		HSQOBJECT class_obj;
+		if (!((Squirrel *)sq_getforeignptr(vm))->FindClass(GetClassName<Tcls, Ttype>(), &class_obj)) return sq_throwerror(vm, "class method is non-static");
+		sq_pushobject(vm, class_obj);
 		sq_pushobject(vm, instance);
 		if (sq_instanceof(vm) != SQTrue) return sq_throwerror(vm, "class method is non-static");
-		sq_pop(vm, 3);
+		sq_pop(vm, 2);
 
 		/* Get the 'real' instance of this class */
 		sq_getinstanceup(vm, 1, &real_instance, nullptr);
@@ -306,6 +310,8 @@ namespace SQConvert {
 			return HelperT<Tmethod>::SQCall((Tcls *)nullptr, *(Tmethod *)ptr, vm);
 		} catch (SQInteger &e) {
 			return e;
+		} catch (Script_Suspend &e) {
+			return Squirrel::SuspendClosure(vm, e);
 		}
 	}
 
@@ -102,7 +102,7 @@ static void RedrawSmallmap(int32 new_value)
 {
 	BuildLandLegend();
 	BuildOwnerLegend();
-	SetWindowClassesDirty(WC_SMALLMAP);
+	InvalidateWindowClassesData(WC_SMALLMAP, 2);
 }
 
 /** Redraw linkgraph links after a colour scheme change. */
@@ -15,6 +15,7 @@
 #include "company_func.h"
 #include "pathfinder/npf/npf_func.h"
 #include "depot_base.h"
+#include "depot_func.h"
 #include "station_base.h"
 #include "newgrf_engine.h"
 #include "pathfinder/yapf/yapf.h"
@@ -144,27 +145,17 @@ void Ship::GetImage(Direction direction, EngineImageType image_type, VehicleSpri
 
 static const Depot *FindClosestShipDepot(const Vehicle *v, uint max_distance)
 {
-	/* Find the closest depot */
-	const Depot *best_depot = nullptr;
+	/* The k-d tree finds the depot closest in Manhattan distance, breaking
+	 * ties on the lowest depot index just like a scan over the pool would. */
+	TileIndex tile = FindClosestDepotCandidate(v->tile, v->owner, VEH_SHIP);
+	if (tile == INVALID_TILE) return nullptr;
+
 	/* If we don't have a maximum distance, i.e. distance = 0,
-	 * we want to find any depot so the best distance of no
-	 * depot must be more than any correct distance. On the
-	 * other hand if we have set a maximum distance, any depot
-	 * further away than max_distance can safely be ignored. */
-	uint best_dist = max_distance == 0 ? UINT_MAX : max_distance + 1;
-
-	for (const Depot *depot : Depot::Iterate()) {
-		TileIndex tile = depot->xy;
-		if (IsShipDepotTile(tile) && IsTileOwner(tile, v->owner)) {
-			uint dist = DistanceManhattan(tile, v->tile);
-			if (dist < best_dist) {
-				best_dist = dist;
-				best_depot = depot;
-			}
-		}
-	}
+	 * we want to find any depot; otherwise any depot further
+	 * away than max_distance can safely be ignored. */
+	if (max_distance != 0 && DistanceManhattan(tile, v->tile) > max_distance) return nullptr;
 
-	return best_depot;
+	return Depot::GetByTile(tile);
 }
 
 static void CheckIfShipNeedsService(Vehicle *v)
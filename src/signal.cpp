@@ -45,12 +45,17 @@ static const TrackdirBits _enterdir_to_trackdirbits[DIAGDIR_END] = {
 
 /**
  * Set containing 'items' items of 'tile and Tdir'
- * No tree structure is used because it would cause
- * slowdowns in most usual cases
+ * A hash index over the elements keeps membership tests and removal O(1);
+ * exploring a big signal block tests the sets once per explored tile edge,
+ * which made plain linear scans quadratic on busy junctions.
  */
 template <typename Tdir, uint items>
 struct SmallSet {
 private:
+	static_assert((items & (items - 1)) == 0);
+
+	static const uint16 INVALID_INDEX = UINT16_MAX; ///< End marker of a hash bucket chain.
+
 	uint n;           // actual number of units
 	bool overflowed;  // did we try to overflow the set?
 	const char *name; // name, used for debugging purposes...
@@ -61,15 +66,57 @@ private:
 		Tdir dir;
 	} data[items];
 
+	uint16 buckets[items * 2]; // head element index per hash bucket
+	uint16 next[items];        // next element index within the same hash bucket
+
+	/** Get the hash bucket the given element belongs into */
+	static inline uint Hash(TileIndex tile, Tdir dir)
+	{
+		return (tile * 0x9E3779B1 ^ (uint)dir) & (items * 2 - 1);
+	}
+
+	/** Link the element at the given index into its hash bucket */
+	inline void Link(uint index)
+	{
+		uint bucket = Hash(this->data[index].tile, this->data[index].dir);
+		this->next[index] = this->buckets[bucket];
+		this->buckets[bucket] = index;
+	}
+
+	/** Unlink the element at the given index from its hash bucket */
+	inline void Unlink(uint index)
+	{
+		uint16 *idx = &this->buckets[Hash(this->data[index].tile, this->data[index].dir)];
+		while (*idx != index) idx = &this->next[*idx];
+		*idx = this->next[index];
+	}
+
+	/**
+	 * Find the index of the given element
+	 * @return index of the element, or #INVALID_INDEX when not present
+	 */
+	inline uint Find(TileIndex tile, Tdir dir)
+	{
+		for (uint16 i = this->buckets[Hash(tile, dir)]; i != INVALID_INDEX; i = this->next[i]) {
+			if (this->data[i].tile == tile && this->data[i].dir == dir) return i;
+		}
+
+		return INVALID_INDEX;
+	}
+
 public:
 	/** Constructor - just set default values and 'name' */
-	SmallSet(const char *name) : n(0), overflowed(false), name(name) { }
+	SmallSet(const char *name) : n(0), overflowed(false), name(name)
+	{
+		std::fill(std::begin(this->buckets), std::end(this->buckets), INVALID_INDEX);
+	}
 
 	/** Reset variables to default values */
 	void Reset()
 	{
 		this->n = 0;
 		this->overflowed = false;
+		std::fill(std::begin(this->buckets), std::end(this->buckets), INVALID_INDEX);
 	}
 
 	/**
@@ -117,14 +164,19 @@ public:
 	 */
 	bool Remove(TileIndex tile, Tdir dir)
 	{
-		for (uint i = 0; i < this->n; i++) {
-			if (this->data[i].tile == tile && this->data[i].dir == dir) {
-				this->data[i] = this->data[--this->n];
-				return true;
-			}
+		uint i = this->Find(tile, dir);
+		if (i == INVALID_INDEX) return false;
+
+		this->Unlink(i);
+		this->n--;
+		if (i != this->n) {
+			/* Move the last element into the freed slot and rehome its hash link. */
+			this->Unlink(this->n);
+			this->data[i] = this->data[this->n];
+			this->Link(i);
 		}
 
-		return false;
+		return true;
 	}
 
 	/**
@@ -135,11 +187,7 @@ public:
 	 */
 	bool IsIn(TileIndex tile, Tdir dir)
 	{
-		for (uint i = 0; i < this->n; i++) {
-			if (this->data[i].tile == tile && this->data[i].dir == dir) return true;
-		}
-
-		return false;
+		return this->Find(tile, dir) != INVALID_INDEX;
 	}
 
 	/**
@@ -159,6 +207,7 @@ public:
 
 		this->data[this->n].tile = tile;
 		this->data[this->n].dir = dir;
+		this->Link(this->n);
 		this->n++;
 
 		return true;
@@ -175,6 +224,7 @@ public:
 		if (this->n == 0) return false;
 
 		this->n--;
+		this->Unlink(this->n);
 		*tile = this->data[this->n].tile;
 		*dir = this->data[this->n].dir;
 
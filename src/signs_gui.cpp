@@ -177,11 +177,22 @@ struct SignListWindow : Window, SignList {
 	 */
 	void SetFilterString(const char *new_filter_string)
 	{
+		/* When the new term only appends to the old one it can only narrow the
+		 * matches, so the signs already shown can be filtered directly instead
+		 * of rebuilding and resorting the whole list. */
+		bool narrowing = !this->signs.NeedRebuild() && this->string_filter.IsNarrowing(new_filter_string);
+
 		/* check if there is a new filter string */
 		this->string_filter.SetFilterTerm(new_filter_string);
 
-		/* Rebuild the list of signs */
-		this->InvalidateData();
+		if (narrowing) {
+			this->signs.Filter(&SignNameFilter, this->string_filter);
+			this->vscroll->SetCount((uint)this->signs.size());
+			this->SetDirty();
+		} else {
+			/* Rebuild the list of signs */
+			this->InvalidateData();
+		}
 	}
 
 	void OnPaint() override
@@ -37,6 +37,25 @@ static int _smallmap_industry_count; ///< Number of used industries
 static int _smallmap_company_count;  ///< Number of entries in the owner legend.
 static int _smallmap_cargo_count;    ///< Number of cargos in the link stats legend.
 
+static const uint SMALLMAP_BLOCK_BITS = 6; ///< The tile change generations are tracked per 2**6 by 2**6 block of tiles.
+
+static std::vector<uint64> _smallmap_block_generation; ///< Per block of tiles, the generation of the last change to a tile in it.
+static uint64 _smallmap_generation = 1;                ///< Generation counter for tile changes; bumped for every changed tile.
+
+/**
+ * Record that a tile changed in a way that may change its colour on the smallmap,
+ * so cached smallmap colours for it get recomputed.
+ * @param tile The tile that changed.
+ */
+void NotifySmallMapTileChange(TileIndex tile)
+{
+	size_t blocks = (size_t)(Map::SizeX() >> SMALLMAP_BLOCK_BITS) * (Map::SizeY() >> SMALLMAP_BLOCK_BITS);
+	if (_smallmap_block_generation.size() != blocks) _smallmap_block_generation.assign(blocks, 0);
+
+	size_t block = (TileY(tile) >> SMALLMAP_BLOCK_BITS) * (Map::SizeX() >> SMALLMAP_BLOCK_BITS) + (TileX(tile) >> SMALLMAP_BLOCK_BITS);
+	_smallmap_block_generation[block] = ++_smallmap_generation;
+}
+
 /** Link stat colours shown in legenda. */
 static uint8 _linkstat_colours_in_legenda[] = {0, 1, 3, 5, 7, 9, 11};
 
@@ -735,11 +754,10 @@ void SmallMapWindow::SetZoomLevel(ZoomLevelChange change, const Point *zoom_pt)
 			Point new_tile = this->PixelToTile(zoom_pt->x, zoom_pt->y, &sub);
 			this->SetNewScroll(this->scroll_x + (tile.x - new_tile.x) * TILE_SIZE,
 					this->scroll_y + (tile.y - new_tile.y) * TILE_SIZE, sub);
-		} else if (this->map_type == SMT_LINKSTATS) {
-			this->overlay->SetDirty();
 		}
 		this->SetWidgetDisabledState(WID_SM_ZOOM_IN,  this->zoom == zoomlevels[MIN_ZOOM_INDEX]);
 		this->SetWidgetDisabledState(WID_SM_ZOOM_OUT, this->zoom == zoomlevels[MAX_ZOOM_INDEX]);
+		this->InvalidateColumnCache();
 		this->SetDirty();
 	}
 }
@@ -838,11 +856,82 @@ inline uint32 SmallMapWindow::GetTileColours(const TileArea &ta) const
  * @param blitter current blitter
  * @note If pixel position is below \c 0, skip drawing.
  */
+/**
+ * Get the cached colours of the column of tile areas starting at tile (\a xc, \a yc),
+ * recomputing them when a tile along the column changed since they were computed.
+ * @param xc The X coordinate of the first tile in the column.
+ * @param yc The Y coordinate of the first tile in the column.
+ * @param reps Number of tile areas along the column.
+ * @return The colours of the column's tile areas, as computed by #GetTileColours.
+ */
+const std::vector<uint32> &SmallMapWindow::GetColumnCacheEntry(uint xc, uint yc, int reps) const
+{
+	/* Put a limit on the cache; scrolling over a big map leaves columns behind. */
+	if (this->column_cache.size() > COLUMN_CACHE_LIMIT) this->column_cache.clear();
+
+	ColumnCache &cache = this->column_cache[(uint64)xc << 32 | yc];
+
+	/* Determine the newest change generation of the blocks of tiles the column crosses. */
+	uint64 generation = 0;
+	if (!_smallmap_block_generation.empty()) {
+		uint pitch = Map::SizeX() >> SMALLMAP_BLOCK_BITS;
+		for (int i = 0; i < reps; i++) {
+			uint x = xc + i * this->zoom;
+			uint y = yc + i * this->zoom;
+			if (x >= Map::MaxX() || y >= Map::MaxY()) continue;
+
+			uint bx_end = std::min<uint>(x + this->zoom - 1, Map::MaxX() - 1) >> SMALLMAP_BLOCK_BITS;
+			uint by_end = std::min<uint>(y + this->zoom - 1, Map::MaxY() - 1) >> SMALLMAP_BLOCK_BITS;
+			for (uint by = y >> SMALLMAP_BLOCK_BITS; by <= by_end; by++) {
+				for (uint bx = x >> SMALLMAP_BLOCK_BITS; bx <= bx_end; bx++) {
+					generation = std::max(generation, _smallmap_block_generation[by * pitch + bx]);
+				}
+			}
+		}
+	}
+
+	if (cache.colours.size() >= (uint)reps && cache.generation >= generation) return cache.colours;
+
+	cache.colours.assign(reps, 0);
+	cache.generation = generation;
+
+	uint min_xy = _settings_game.construction.freeform_edges ? 1 : 0;
+	for (int i = 0; i < reps; i++) {
+		uint x = xc + i * this->zoom;
+		uint y = yc + i * this->zoom;
+		if (x >= Map::MaxX() || y >= Map::MaxY()) continue;
+
+		/* Construct tilearea covered by (x, y, x + this->zoom, y + this->zoom) such that it is within min_xy limits. */
+		TileArea ta;
+		if (min_xy == 1 && (x == 0 || y == 0)) {
+			if (this->zoom == 1) continue; // The tile area is empty, don't draw anything.
+
+			ta = TileArea(TileXY(std::max(min_xy, x), std::max(min_xy, y)), this->zoom - (x == 0), this->zoom - (y == 0));
+		} else {
+			ta = TileArea(TileXY(x, y), this->zoom, this->zoom);
+		}
+		ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
+
+		cache.colours[i] = this->GetTileColours(ta);
+	}
+
+	return cache.colours;
+}
+
+/** Throw away all cached column colours, e.g. because the display mode changed. */
+void SmallMapWindow::InvalidateColumnCache()
+{
+	this->column_cache.clear();
+}
+
 void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch, int reps, int start_pos, int end_pos, Blitter *blitter) const
 {
 	void *dst_ptr_abs_end = blitter->MoveTo(_screen.dst_ptr, 0, _screen.height);
 	uint min_xy = _settings_game.construction.freeform_edges ? 1 : 0;
 
+	const std::vector<uint32> &colours = this->GetColumnCacheEntry(xc, yc, reps);
+	int i = 0;
+
 	do {
 		/* Check if the tile (xc,yc) is within the map range */
 		if (xc >= Map::MaxX() || yc >= Map::MaxY()) continue;
@@ -851,18 +940,10 @@ void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch,
 		if (dst < _screen.dst_ptr) continue;
 		if (dst >= dst_ptr_abs_end) continue;
 
-		/* Construct tilearea covered by (xc, yc, xc + this->zoom, yc + this->zoom) such that it is within min_xy limits. */
-		TileArea ta;
-		if (min_xy == 1 && (xc == 0 || yc == 0)) {
-			if (this->zoom == 1) continue; // The tile area is empty, don't draw anything.
-
-			ta = TileArea(TileXY(std::max(min_xy, xc), std::max(min_xy, yc)), this->zoom - (xc == 0), this->zoom - (yc == 0));
-		} else {
-			ta = TileArea(TileXY(xc, yc), this->zoom, this->zoom);
-		}
-		ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
+		/* The tile area is empty, don't draw anything. */
+		if (min_xy == 1 && (xc == 0 || yc == 0) && this->zoom == 1) continue;
 
-		uint32 val = this->GetTileColours(ta);
+		uint32 val = colours[i];
 		uint8 *val8 = (uint8 *)&val;
 		int idx = std::max(0, -start_pos);
 		for (int pos = std::max(0, start_pos); pos < end_pos; pos++) {
@@ -870,7 +951,7 @@ void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch,
 			idx++;
 		}
 	/* Switch to next tile in the column */
-	} while (xc += this->zoom, yc += this->zoom, dst = blitter->MoveTo(dst, pitch, 0), --reps != 0);
+	} while (xc += this->zoom, yc += this->zoom, dst = blitter->MoveTo(dst, pitch, 0), i++, --reps != 0);
 }
 
 /**
@@ -1317,6 +1398,7 @@ void SmallMapWindow::SwitchMapType(SmallMapType map_type)
 
 	if (map_type == SMT_LINKSTATS) this->overlay->SetDirty();
 	if (map_type != SMT_INDUSTRY) this->BreakIndustryChainLink();
+	this->InvalidateColumnCache();
 	this->SetDirty();
 }
 
@@ -1418,6 +1500,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 		_smallmap_industry_highlight = new_highlight;
 		this->refresh.SetInterval(_smallmap_industry_highlight != INVALID_INDUSTRYTYPE ? BLINK_PERIOD : FORCE_REFRESH_PERIOD);
 		_smallmap_industry_highlight_state = true;
+		this->InvalidateColumnCache();
 		this->SetDirty();
 	}
 }
@@ -1493,6 +1576,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 						this->SelectLegendItem(click_pos, _legend_land_owners, _smallmap_company_count, NUM_NO_COMPANY_ENTRIES);
 					}
 				}
+				this->InvalidateColumnCache();
 				this->SetDirty();
 			}
 			break;
@@ -1518,6 +1602,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 				tbl->show_on_map = (widget == WID_SM_ENABLE_ALL);
 			}
 			if (this->map_type == SMT_LINKSTATS) this->SetOverlayCargoMask();
+			this->InvalidateColumnCache();
 			this->SetDirty();
 			break;
 		}
@@ -1525,6 +1610,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 		case WID_SM_SHOW_HEIGHT: // Enable/disable showing of heightmap.
 			_smallmap_show_heightmap = !_smallmap_show_heightmap;
 			this->SetWidgetLoweredState(WID_SM_SHOW_HEIGHT, _smallmap_show_heightmap);
+			this->InvalidateColumnCache();
 			this->SetDirty();
 			break;
 	}
@@ -1564,6 +1650,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 
 		default: NOT_REACHED();
 	}
+	this->InvalidateColumnCache();
 	this->SetDirty();
 }
 
@@ -1602,6 +1689,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 		}
 	}
 	_smallmap_industry_highlight_state = !_smallmap_industry_highlight_state;
+	if (_smallmap_industry_highlight != INVALID_INDUSTRYTYPE) this->InvalidateColumnCache();
 
 	this->refresh.SetInterval(_smallmap_industry_highlight != INVALID_INDUSTRYTYPE ? BLINK_PERIOD : FORCE_REFRESH_PERIOD);
 	this->SetDirty();
@@ -1641,7 +1729,6 @@ void SmallMapWindow::SetNewScroll(int sx, int sy, int sub)
 	this->scroll_x = sx;
 	this->scroll_y = sy;
 	this->subscroll = sub;
-	if (this->map_type == SMT_LINKSTATS) this->overlay->SetDirty();
 }
 
 /* virtual */ void SmallMapWindow::OnScroll(Point delta)
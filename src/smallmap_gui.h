@@ -19,6 +19,8 @@
 #include "widgets/smallmap_widget.h"
 #include "guitimer_func.h"
 
+#include <unordered_map>
+
 /* set up the cargos to be displayed in the smallmap's route legend */
 void BuildLinkStatsLegend();
 
@@ -36,6 +38,8 @@ enum class IncludeHeightmap {
 
 uint32 GetSmallMapOwnerPixels(TileIndex tile, TileType t, IncludeHeightmap include_heightmap);
 
+void NotifySmallMapTileChange(TileIndex tile);
+
 /** Structure for holding relevant data for legends in small map */
 struct LegendAndColour {
 	uint8 colour;              ///< Colour of the item on the map.
@@ -90,6 +94,16 @@ protected:
 	GUITimer refresh; ///< Refresh timer.
 	LinkGraphOverlay *overlay;
 
+	/** Cached colours of one column of the smallmap, i.e. a diagonal run of tile areas. */
+	struct ColumnCache {
+		std::vector<uint32> colours; ///< Colours as computed by #GetTileColours for each tile area along the column.
+		uint64 generation;           ///< Tile change generation the colours were computed against.
+	};
+
+	static const size_t COLUMN_CACHE_LIMIT = 8192; ///< Maximum number of cached columns before the cache is flushed.
+
+	mutable std::unordered_map<uint64, ColumnCache> column_cache; ///< Cached column colours, keyed by the column's starting tile coordinates.
+
 	static void BreakIndustryChainLink();
 	Point SmallmapRemapCoords(int x, int y) const;
 
@@ -162,6 +176,9 @@ protected:
 	void SwitchMapType(SmallMapType map_type);
 	void SetNewScroll(int sx, int sy, int sub);
 
+	const std::vector<uint32> &GetColumnCacheEntry(uint xc, uint yc, int reps) const;
+	void InvalidateColumnCache();
+
 	void DrawMapIndicators() const;
 	void DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch, int reps, int start_pos, int end_pos, Blitter *blitter) const;
 	void DrawVehicles(const DrawPixelInfo *dpi, Blitter *blitter) const;
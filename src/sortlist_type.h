@@ -262,6 +262,53 @@ public:
 		return true;
 	}
 
+	/**
+	 * Sort the list on precomputed sort keys.
+	 *
+	 * For criteria that derive an expensive key from each item, like the
+	 * collation key of a name, sorting on extracted keys performs that
+	 * derivation once per item instead of once per comparison. The keys are
+	 * extracted anew on every resort, so they can never go stale; between
+	 * resorts the list order itself is the cache.
+	 *
+	 * The sort is not stable; embed a tie breaker in the key.
+	 *
+	 * @param extract Functor mapping a list item to its sort key; keys are
+	 *                compared with operator<.
+	 * @return true if the list sequence has been altered
+	 */
+	template <typename KeyExtract>
+	bool SortByKey(KeyExtract extract)
+	{
+		/* Do not sort if the resort bit is not set */
+		if (!(this->flags & VL_RESORT)) return false;
+
+		CLRBITS(this->flags, VL_RESORT);
+
+		this->ResetResortTimer();
+
+		/* Do not sort when the list is not sortable */
+		if (!this->IsSortable()) return false;
+
+		const bool desc = (this->flags & VL_DESC) != 0;
+
+		using Key = decltype(extract(std::declval<const T &>()));
+		std::vector<std::pair<Key, T>> keyed;
+		keyed.reserve(std::vector<T>::size());
+		for (const T &item : *this) {
+			keyed.emplace_back(extract(item), item);
+		}
+
+		std::sort(keyed.begin(), keyed.end(), [desc](const std::pair<Key, T> &a, const std::pair<Key, T> &b) {
+			return desc ? b.first < a.first : a.first < b.first;
+		});
+
+		for (size_t i = 0; i < keyed.size(); i++) {
+			(*this)[i] = std::move(keyed[i].second);
+		}
+		return true;
+	}
+
 	/**
 	 * Hand the array of sort function pointers to the sort list
 	 *
@@ -31,7 +31,7 @@ static void OpenBankFile(const char *filename)
 	 */
 	static std::unique_ptr<RandomAccessFile> original_sound_file;
 
-	memset(_original_sounds, 0, sizeof(_original_sounds));
+	for (SoundEntry &sound : _original_sounds) sound = {};
 
 	/* If there is no sound file (nosound set), don't load anything */
 	if (filename == nullptr) return;
@@ -112,18 +112,22 @@ static void OpenBankFile(const char *filename)
 	}
 }
 
-static bool SetBankSource(MixerChannel *mc, const SoundEntry *sound)
+/**
+ * Load the sample data of a sound into a cached buffer and resample it to the
+ * play rate of the mixer, so neither has to be done again when the same sound
+ * effect is played later on.
+ * @param sound The sound to load the sample data of.
+ * @return True if the sample data was loaded successfully.
+ */
+static bool LoadSoundData(SoundEntry *sound)
 {
-	assert(sound != nullptr);
-
 	/* Check for valid sound size. */
 	if (sound->file_size == 0 || sound->file_size > ((size_t)-1) - 2) return false;
 
-	int8 *mem = MallocT<int8>(sound->file_size + 2);
 	/* Add two extra bytes so rate conversion can read these
 	 * without reading out of its input buffer. */
-	mem[sound->file_size    ] = 0;
-	mem[sound->file_size + 1] = 0;
+	auto data = std::make_shared<std::vector<byte>>(sound->file_size + 2);
+	byte *mem = data->data();
 
 	RandomAccessFile *file = sound->file;
 	file->SeekTo(sound->file_offset, SEEK_SET);
@@ -150,7 +154,29 @@ static bool SetBankSource(MixerChannel *mc, const SoundEntry *sound)
 	assert(sound->channels == 1);
 	assert(sound->file_size != 0 && sound->rate != 0);
 
-	MxSetChannelRawSrc(mc, mem, sound->file_size, sound->rate, sound->bits_per_sample == 16);
+	/* Resample to the play rate of the mixer up front, so mixing does not
+	 * have to convert the rate on every playback. */
+	uint32 play_rate = MxGetPlayRate();
+	if (play_rate <= UINT16_MAX && play_rate != sound->rate) {
+		std::shared_ptr<std::vector<byte>> resampled = MxResampleSoundData(mem, sound->file_size, sound->rate, sound->bits_per_sample == 16);
+		if (resampled != nullptr) {
+			data = std::move(resampled);
+			sound->rate = (uint16)play_rate;
+		}
+	}
+
+	sound->data = std::move(data);
+	return true;
+}
+
+static bool SetBankSource(MixerChannel *mc, SoundEntry *sound)
+{
+	assert(sound != nullptr);
+
+	/* Load the sample data on the first playback of the sound. */
+	if (sound->data == nullptr && !LoadSoundData(sound)) return false;
+
+	MxSetChannelRawSrc(mc, sound->data, sound->data->size() - 2, sound->rate, sound->bits_per_sample == 16);
 
 	return true;
 }
@@ -10,6 +10,9 @@
 #ifndef SOUND_TYPE_H
 #define SOUND_TYPE_H
 
+#include <memory>
+#include <vector>
+
 struct SoundEntry {
 	class RandomAccessFile *file;
 	size_t file_offset;
@@ -20,6 +23,7 @@ struct SoundEntry {
 	uint8 volume;
 	uint8 priority;
 	byte grf_container_ver; ///< NewGRF container version if the sound is from a NewGRF.
+	std::shared_ptr<std::vector<byte>> data; ///< Sample data, resampled to the play rate of the mixer; shared with the channels playing it.
 };
 
 /**
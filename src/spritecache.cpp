@@ -18,11 +18,18 @@
 #include "core/math_func.hpp"
 #include "core/mem_func.hpp"
 #include "video/video_driver.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 #include "table/sprites.h"
 #include "table/strings.h"
 #include "table/palette_convert.h"
 
+#if defined(WITH_ZLIB)
+#include <zlib.h>
+#endif
+
 #include "safeguards.h"
 
 /* Default of 4MB spritecache */
@@ -44,6 +51,18 @@ static uint _spritecache_items = 0;
 static SpriteCache *_spritecache = nullptr;
 static std::vector<std::unique_ptr<SpriteFile>> _sprite_files;
 
+/**
+ * Memo of sprite pixel dimensions, indexed like #_spritecache, with the
+ * width in the upper and the height in the lower half of each word.
+ * UINT32_MAX means the dimensions have not been determined yet. Each entry
+ * is written once per load of its sprite table entry, so a plain atomic
+ * suffices for the viewport collection threads that read it.
+ */
+static std::unique_ptr<std::atomic<uint32>[]> _sprite_dims;
+
+/** Value of a #_sprite_dims entry whose sprite has not been measured yet. */
+static const uint32 SPRITE_DIM_UNKNOWN = UINT32_MAX;
+
 static inline SpriteCache *GetSpriteCache(uint index)
 {
 	return &_spritecache[index];
@@ -67,6 +86,10 @@ static SpriteCache *AllocateSpriteCache(uint index)
 		/* Reset the new items and update the count */
 		memset(_spritecache + _spritecache_items, 0, (items - _spritecache_items) * sizeof(*_spritecache));
 		_spritecache_items = items;
+
+		/* Start the dimension memo over at the new size; it refills lazily. */
+		_sprite_dims = std::make_unique<std::atomic<uint32>[]>(items);
+		for (uint i = 0; i != items; i++) _sprite_dims[i].store(SPRITE_DIM_UNKNOWN, std::memory_order_relaxed);
 	}
 
 	return GetSpriteCache(index);
@@ -104,6 +127,32 @@ SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdi
 	return *file;
 }
 
+/** Mutex protecting #_sprite_files while sprite files are preloaded in parallel. */
+static std::mutex _sprite_files_mutex;
+
+/**
+ * Open and read a sprite file so a later OpenCachedSpriteFile() finds it cached.
+ * Unlike the rest of the sprite cache this function may be called from several
+ * threads at once; only the registration of the opened file is serialised.
+ * @param filename      Name of the file at the disk.
+ * @param subdir        The sub directory to search this file in.
+ * @param palette_remap Whether a palette remap needs to be performed for this file.
+ */
+void PreloadCachedSpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap)
+{
+	{
+		std::lock_guard<std::mutex> lock(_sprite_files_mutex);
+		if (GetCachedSpriteFileByName(filename) != nullptr) return;
+	}
+
+	/* Opening reads the whole file into memory; do that outside the lock. */
+	auto file = std::make_unique<SpriteFile>(filename, subdir, palette_remap);
+
+	std::lock_guard<std::mutex> lock(_sprite_files_mutex);
+	if (GetCachedSpriteFileByName(filename) != nullptr) return; // Another worker beat us to it.
+	_sprite_files.push_back(std::move(file));
+}
+
 struct MemBlock {
 	size_t size;
 	byte data[];
@@ -114,6 +163,31 @@ static MemBlock *_spritecache_ptr;
 static uint _allocated_sprite_cache_size = 0;
 static int _compact_cache_counter;
 
+/**
+ * Protects the sprite cache heap and LRU administration. Viewport sprite
+ * collection runs on several threads and may fault sprites in while it
+ * measures them; loading and the evictions it can trigger reshape the
+ * shared MemBlock heap and must not run concurrently.
+ */
+static std::mutex _sprite_cache_mutex;
+
+/**
+ * Second tier of the sprite cache: a sprite evicted from the uncompressed
+ * heap above is kept here in compressed form. Rehydrating it only costs an
+ * inflate and a memcpy, which is orders of magnitude cheaper than reloading
+ * the sprite from disk and decoding, resizing and encoding it again.
+ */
+struct RetainedSprite {
+	uint stamp;                 ///< Insertion stamp; lowest is evicted first.
+	size_t mem_req;             ///< Size to request from AllocSprite() upon rehydration.
+	SpriteType type;            ///< Type the sprite was encoded as.
+	std::vector<byte> data;     ///< Sprite data, compressed when zlib is available.
+};
+
+static std::map<uint32, RetainedSprite> _retained_sprites; ///< Evicted sprites by SpriteID.
+static size_t _retained_sprites_size = 0;                  ///< Total bytes used by #_retained_sprites.
+static uint _retained_sprite_stamp = 0;                    ///< Stamp source for #RetainedSprite::stamp.
+
 static void CompactSpriteCache();
 static void *AllocSprite(size_t mem_req);
 
@@ -450,9 +524,10 @@ static void *ReadRecolourSprite(SpriteFile &file, uint num)
  * @param sprite_type Type of sprite.
  * @param allocator   Allocator function to use.
  * @param encoder     Sprite encoder to use.
+ * @param remap       Optional recolour table to apply to the colour mapping channel before encoding.
  * @return Read sprite data.
  */
-static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_type, AllocatorProc *allocator, SpriteEncoder *encoder)
+static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_type, AllocatorProc *allocator, SpriteEncoder *encoder, const byte *remap = nullptr)
 {
 	/* Use current blitter if no other sprite encoder is given. */
 	if (encoder == nullptr) encoder = BlitterFactory::GetCurrentBlitter();
@@ -485,6 +560,28 @@ static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_ty
 		return (void*)GetRawSprite(SPR_IMG_QUERY, ST_NORMAL, allocator, encoder);
 	}
 
+	if (remap != nullptr) {
+		/* Apply the recolour table to the colour mapping channel, so the
+		 * encoded sprite draws via the plain path what the original sprite
+		 * would draw via the remap path. The missing zoom levels created
+		 * by ResizeSprites() inherit the remapped values. */
+		for (ZoomLevel z = ZOOM_LVL_BEGIN; z < ZOOM_LVL_END; z++) {
+			if (!HasBit(sprite_avail, z)) continue;
+			SpriteLoader::CommonPixel *p = sprite[z].data;
+			for (uint i = sprite[z].width * sprite[z].height; i > 0; i--, p++) {
+				if (p->m == 0) continue;
+				byte r = remap[p->m];
+				if (r == 0) {
+					/* The table maps this index to "do not draw". */
+					p->r = p->g = p->b = p->a = 0;
+					p->m = 0;
+				} else {
+					p->m = r;
+				}
+			}
+		}
+	}
+
 	if (sprite_type == ST_MAPGEN) {
 		/* Ugly hack to work around the problem that the old landscape
 		 *  generator assumes that those sprites are stored uncompressed in
@@ -675,6 +772,9 @@ bool LoadNextSprite(int load_index, SpriteFile &file, uint file_sprite_id)
 	sc->warned = false;
 	sc->control_flags = control_flags;
 
+	/* The entry may overwrite a sprite that was already measured. */
+	_sprite_dims[load_index].store(SPRITE_DIM_UNKNOWN, std::memory_order_relaxed);
+
 	return true;
 }
 
@@ -690,6 +790,7 @@ void DupSprite(SpriteID old_spr, SpriteID new_spr)
 	scnew->id = scold->id;
 	scnew->type = scold->type;
 	scnew->warned = false;
+	_sprite_dims[new_spr].store(SPRITE_DIM_UNKNOWN, std::memory_order_relaxed);
 }
 
 /**
@@ -795,15 +896,64 @@ static void CompactSpriteCache()
 	}
 }
 
+/**
+ * Keep an evicted sprite in the second tier of the cache.
+ * @param item Sprite being evicted.
+ * @param data Decoded sprite data.
+ * @param size Size of the decoded sprite data.
+ */
+static void RetainEvictedSprite(uint item, const byte *data, size_t size)
+{
+	RetainedSprite &rs = _retained_sprites[item];
+	_retained_sprites_size -= rs.data.size(); // In case the sprite was already retained once.
+	rs.stamp = ++_retained_sprite_stamp;
+	rs.mem_req = size;
+	rs.type = GetSpriteCache(item)->type;
+
+#if defined(WITH_ZLIB)
+	uLongf compressed_size = compressBound((uLong)size);
+	rs.data.resize(compressed_size);
+	/* Level 1 as we favour speed over ratio; an evicted sprite may well be needed again soon. */
+	if (compress2(rs.data.data(), &compressed_size, data, (uLong)size, 1) != Z_OK) {
+		_retained_sprites.erase(item);
+		return;
+	}
+	rs.data.resize(compressed_size);
+	rs.data.shrink_to_fit();
+#else
+	rs.data.assign(data, data + size);
+#endif
+	_retained_sprites_size += rs.data.size();
+
+	/* Keep the second tier within the same budget as the uncompressed heap. */
+	while (_retained_sprites_size > _allocated_sprite_cache_size) {
+		auto oldest = _retained_sprites.begin();
+		for (auto it = _retained_sprites.begin(); it != _retained_sprites.end(); ++it) {
+			if (it->second.stamp < oldest->second.stamp) oldest = it;
+		}
+		_retained_sprites_size -= oldest->second.data.size();
+		_retained_sprites.erase(oldest);
+	}
+}
+
 /**
  * Delete a single entry from the sprite cache.
- * @param item Entry to delete.
+ * @param item   Entry to delete.
+ * @param retain Whether to keep the sprite in the second tier of the cache.
  */
-static void DeleteEntryFromSpriteCache(uint item)
+static void DeleteEntryFromSpriteCache(uint item, bool retain = true)
 {
+	/* Deferred sprite draws may still point into the block we are about to
+	 * free. Batches are only active during the sequential blitting phase, so
+	 * an eviction from a viewport collection thread finds the batch empty. */
+	GfxFlushSpriteBatch();
+
 	/* Mark the block as free (the block must be in use) */
 	MemBlock *s = (MemBlock*)GetSpriteCache(item)->ptr - 1;
 	assert(!(s->size & S_FREE_MASK));
+
+	if (retain) RetainEvictedSprite(item, s->data, (s->size & ~S_FREE_MASK) - sizeof(MemBlock));
+
 	s->size |= S_FREE_MASK;
 	GetSpriteCache(item)->ptr = nullptr;
 
@@ -877,6 +1027,45 @@ static void *AllocSprite(size_t mem_req)
 	}
 }
 
+/**
+ * Try to reload a sprite from the second tier of the cache.
+ * @param sc     Sprite cache entry to rehydrate.
+ * @param sprite Sprite to rehydrate.
+ * @return True iff the sprite was restored from the second tier.
+ */
+static bool RehydrateSprite(SpriteCache *sc, SpriteID sprite)
+{
+	auto it = _retained_sprites.find(sprite);
+	if (it == _retained_sprites.end()) return false;
+
+	/* The type may have been changed since eviction, e.g. ST_NORMAL -> ST_FONT;
+	 * the retained encoding is then the wrong one. */
+	if (it->second.type != sc->type) {
+		_retained_sprites_size -= it->second.data.size();
+		_retained_sprites.erase(it);
+		return false;
+	}
+
+	/* Take the data out first; AllocSprite() may evict sprites into the pool. */
+	RetainedSprite rs = std::move(it->second);
+	_retained_sprites_size -= rs.data.size();
+	_retained_sprites.erase(it);
+
+	sc->ptr = AllocSprite(rs.mem_req);
+
+#if defined(WITH_ZLIB)
+	uLongf size = (uLongf)rs.mem_req;
+	if (uncompress((byte *)sc->ptr, &size, rs.data.data(), (uLong)rs.data.size()) != Z_OK || size != rs.mem_req) {
+		/* Corrupt entry; drop it and reload from disk. */
+		DeleteEntryFromSpriteCache(sprite, false);
+		return false;
+	}
+#else
+	memcpy(sc->ptr, rs.data.data(), rs.data.size());
+#endif
+	return true;
+}
+
 /**
  * Sprite allocator simply using malloc.
  */
@@ -957,13 +1146,17 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, AllocatorProc *allocator, S
 
 	if (allocator == nullptr && encoder == nullptr) {
 		/* Load sprite into/from spritecache */
+		std::lock_guard<std::mutex> lock(_sprite_cache_mutex);
 
 		/* Update LRU */
 		sc->lru = ++_sprite_lru_counter;
 
 		/* Load the sprite, if it is not loaded, yet */
-		if (sc->ptr == nullptr) sc->ptr = ReadSprite(sc, sprite, type, AllocSprite, nullptr);
+		if (sc->ptr == nullptr && !RehydrateSprite(sc, sprite)) sc->ptr = ReadSprite(sc, sprite, type, AllocSprite, nullptr);
 
+		/* Eviction picks the entry with the lowest lru, so the sprite
+		 * returned here, which has the highest, is not freed by a fault
+		 * on another thread while the caller still reads it. */
 		return sc->ptr;
 	} else {
 		/* Do not use the spritecache, but a different allocator. */
@@ -971,6 +1164,78 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, AllocatorProc *allocator, S
 	}
 }
 
+/**
+ * Get the pixel dimensions of a normal sprite.
+ * Answered from #_sprite_dims when the sprite was measured before, making
+ * repeated queries safe and cheap on the viewport collection threads; only
+ * the first query of a sprite faults it into the sprite cache.
+ * @param sprite The sprite to get the dimensions of.
+ * @return The width and height of the sprite in pixels.
+ */
+Dimension GetSpriteDimension(SpriteID sprite)
+{
+	if (!SpriteExists(sprite)) sprite = SPR_IMG_QUERY;
+
+	uint32 packed = _sprite_dims[sprite].load(std::memory_order_relaxed);
+	if (packed == SPRITE_DIM_UNKNOWN) {
+		const Sprite *spr = GetSprite(sprite, ST_NORMAL);
+		packed = (uint32)spr->width << 16 | spr->height;
+		_sprite_dims[sprite].store(packed, std::memory_order_relaxed);
+	}
+
+	return { GB(packed, 16, 16), GB(packed, 0, 16) };
+}
+
+/** Encoded sprite variants with a recolour table pre-applied, keyed by (palette, sprite); see GetRemappedSprite(). */
+static std::map<uint64, std::unique_ptr<byte[]>> _remapped_sprites;
+static size_t _remapped_sprites_size = 0;  ///< Total number of bytes allocated to entries of #_remapped_sprites.
+static size_t _remapped_sprite_alloc_size; ///< Number of bytes allocated while reading the current remapped sprite.
+
+/** Sprite allocator for remapped sprite variants; tallies the allocation size for the memory accounting. */
+static void *RemappedSpriteAlloc(size_t size)
+{
+	_remapped_sprite_alloc_size += size;
+	return MallocT<byte>(size);
+}
+
+/**
+ * Gets a sprite with a recolour table already applied to it, so it can be
+ * drawn with the plain blit path instead of the per-pixel remapping path.
+ * The variants are cached; keep the set of palettes passed here small, like
+ * the company colour maps, so frequently drawn sprites stay in the cache.
+ * @param sprite Sprite to get.
+ * @param pal Recolour palette to apply.
+ * @return Encoded sprite with the recolouring baked in.
+ */
+const Sprite *GetRemappedSprite(SpriteID sprite, PaletteID pal)
+{
+	if (!SpriteExists(sprite)) sprite = SPR_IMG_QUERY;
+
+	SpriteCache *sc = GetSpriteCache(sprite);
+	if (sc->type != ST_NORMAL) return GetSprite(sprite, ST_NORMAL);
+
+	uint64 key = (uint64)pal << 32 | sprite;
+	auto it = _remapped_sprites.find(key);
+	if (it == _remapped_sprites.end()) {
+		/* Bound the memory spent on variants to a share of the sprite cache;
+		 * simply start over when the budget is exceeded. */
+		if (_remapped_sprites_size > _allocated_sprite_cache_size / 4) {
+			Debug(sprite, 3, "Resetting remapped sprite cache, inuse={}", _remapped_sprites_size);
+			GfxFlushSpriteBatch();
+			_remapped_sprites.clear();
+			_remapped_sprites_size = 0;
+		}
+
+		const byte *remap = GetNonSprite(GB(pal, 0, PALETTE_WIDTH), ST_RECOLOUR) + 1;
+		_remapped_sprite_alloc_size = 0;
+		byte *data = (byte *)ReadSprite(sc, sprite, ST_NORMAL, RemappedSpriteAlloc, nullptr, remap);
+		_remapped_sprites_size += _remapped_sprite_alloc_size;
+		it = _remapped_sprites.emplace(key, std::unique_ptr<byte[]>(data)).first;
+	}
+
+	return (const Sprite *)it->second.get();
+}
+
 
 static void GfxInitSpriteCache()
 {
@@ -1027,9 +1292,16 @@ void GfxInitSpriteMem()
 	free(_spritecache);
 	_spritecache_items = 0;
 	_spritecache = nullptr;
+	_sprite_dims.reset();
 
 	_compact_cache_counter = 0;
 	_sprite_files.clear();
+
+	_retained_sprites.clear();
+	_retained_sprites_size = 0;
+
+	_remapped_sprites.clear();
+	_remapped_sprites_size = 0;
 }
 
 /**
@@ -1038,10 +1310,17 @@ void GfxInitSpriteMem()
  */
 void GfxClearSpriteCache()
 {
+	/* Sprites in the second tier are encoded for the old blitter as well. */
+	_retained_sprites.clear();
+	_retained_sprites_size = 0;
+
+	_remapped_sprites.clear();
+	_remapped_sprites_size = 0;
+
 	/* Clear sprite ptr for all cached items */
 	for (uint i = 0; i != _spritecache_items; i++) {
 		SpriteCache *sc = GetSpriteCache(i);
-		if (sc->type != ST_RECOLOUR && sc->ptr != nullptr) DeleteEntryFromSpriteCache(i);
+		if (sc->type != ST_RECOLOUR && sc->ptr != nullptr) DeleteEntryFromSpriteCache(i, false);
 	}
 
 	VideoDriver::GetInstance()->ClearSystemSprites();
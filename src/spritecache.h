@@ -35,6 +35,7 @@ typedef void *AllocatorProc(size_t size);
 
 void *SimpleSpriteAlloc(size_t size);
 void *GetRawSprite(SpriteID sprite, SpriteType type, AllocatorProc *allocator = nullptr, SpriteEncoder *encoder = nullptr);
+const struct Sprite *GetRemappedSprite(SpriteID sprite, PaletteID pal);
 bool SpriteExists(SpriteID sprite);
 
 SpriteType GetSpriteType(SpriteID sprite);
@@ -42,6 +43,7 @@ SpriteFile *GetOriginFile(SpriteID sprite);
 uint32 GetSpriteLocalID(SpriteID sprite);
 uint GetSpriteCountForFile(const std::string &filename, SpriteID begin, SpriteID end);
 uint GetMaxSpriteID();
+Dimension GetSpriteDimension(SpriteID sprite);
 
 
 static inline const Sprite *GetSprite(SpriteID sprite, SpriteType type)
@@ -61,6 +63,7 @@ void GfxClearSpriteCache();
 void IncreaseSpriteLRU();
 
 SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap);
+void PreloadCachedSpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap);
 
 void ReadGRFSpriteOffsets(SpriteFile &file);
 size_t GetGRFSpriteOffset(uint32 id);
@@ -0,0 +1,60 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file state_checksum.h Rolling hashes over the mutable game state, for cheap desync detection. */
+
+#ifndef STATE_CHECKSUM_H
+#define STATE_CHECKSUM_H
+
+#include "core/bitmath_func.hpp"
+
+/**
+ * Rolling hashes over the mutable game state, one per subsystem. They are
+ * updated incrementally at the mutation sites and compared through the
+ * network sync packets, so a desync can be attributed to a subsystem
+ * without the cost of full state validation.
+ *
+ * Updates only accumulate while the state game loop runs; loading a game or
+ * generating a world leaves the hashes untouched. As the hashes are part of
+ * the savegame, a joining client continues exactly where the server is.
+ */
+struct StateChecksums {
+	uint32 vehicle; ///< Hash over vehicle position changes.
+	uint32 cargo;   ///< Hash over cargo movements.
+	uint32 town;    ///< Hash over town growth changes.
+	bool active;    ///< Whether updates are currently being accumulated.
+
+	/** Mix \a value into the vehicle position hash. */
+	inline void UpdateVehicle(uint32 value)
+	{
+		if (this->active) this->vehicle = ROL(this->vehicle, 1) ^ value;
+	}
+
+	/** Mix \a value into the cargo movement hash. */
+	inline void UpdateCargo(uint32 value)
+	{
+		if (this->active) this->cargo = ROL(this->cargo, 1) ^ value;
+	}
+
+	/** Mix \a value into the town growth hash. */
+	inline void UpdateTown(uint32 value)
+	{
+		if (this->active) this->town = ROL(this->town, 1) ^ value;
+	}
+
+	/** Forget all accumulated state, for when a new game starts. */
+	void Reset()
+	{
+		this->vehicle = 0;
+		this->cargo = 0;
+		this->town = 0;
+	}
+};
+
+extern StateChecksums _state_checksums;
+
+#endif /* STATE_CHECKSUM_H */
@@ -20,6 +20,7 @@
 #include "vehiclelist.h"
 #include "core/pool_func.hpp"
 #include "station_base.h"
+#include "station_func.h"
 #include "station_kdtree.h"
 #include "roadstop_base.h"
 #include "industry.h"
@@ -67,6 +68,7 @@ Station::Station(TileIndex tile) :
 	truck_station(INVALID_TILE, 0, 0),
 	ship_station(INVALID_TILE, 0, 0),
 	indtype(IT_INVALID),
+	acceptance_dirty(true),
 	time_since_load(255),
 	time_since_unload(255),
 	last_vehicle_type(VEH_INVALID)
@@ -106,7 +108,9 @@ Station::~Station()
 		for (NodeID node = 0; node < lg->Size(); ++node) {
 			Station *st = Station::Get((*lg)[node].Station());
 			st->goods[c].flows.erase(this->index);
-			if ((*lg)[node][this->goods[c].node].LastUpdate() != INVALID_DATE) {
+			/* Use a const node so a missing edge resolves to the empty edge
+			 * instead of being an error. */
+			if (LinkGraph::ConstNode(lg, node)[this->goods[c].node].LastUpdate() != INVALID_DATE) {
 				st->goods[c].flows.DeleteFlows(this->index);
 				RerouteCargo(st, c, this->index, st->index);
 			}
@@ -397,6 +401,29 @@ void Station::RemoveIndustryToDeliver(Industry *ind) {
 }
 
 
+/**
+ * Register the town or industry of a catchment tile with this station.
+ * @param tile Tile within the catchment.
+ */
+void Station::RegisterCatchmentTile(TileIndex tile)
+{
+	if (IsTileType(tile, MP_HOUSE)) {
+		Town *t = Town::GetByTile(tile);
+		t->stations_near.insert(this);
+	}
+	if (IsTileType(tile, MP_INDUSTRY)) {
+		Industry *i = Industry::GetByTile(tile);
+
+		/* Ignore industry if it has a neutral station. It already can't be this station. */
+		if (!_settings_game.station.serve_neutral_industries && i->neutral_station != nullptr) return;
+
+		i->stations_near.insert(this);
+
+		/* Add if we can deliver to this industry as well */
+		this->AddIndustryToDeliver(i, tile);
+	}
+}
+
 /**
  * Remove this station from the nearby stations lists of all towns and industries.
  */
@@ -404,6 +431,7 @@ void Station::RemoveFromAllNearbyLists()
 {
 	for (Town *t : Town::Iterate()) { t->stations_near.erase(this); }
 	for (Industry *i : Industry::Iterate()) { i->stations_near.erase(this); }
+	InvalidateStationsAroundCache();
 }
 
 /**
@@ -428,6 +456,7 @@ bool Station::CatchmentCoversTown(TownID t) const
  */
 void Station::RecomputeCatchment()
 {
+	this->acceptance_dirty = true;
 	this->industries_near.clear();
 	this->RemoveFromAllNearbyLists();
 
@@ -472,20 +501,58 @@ void Station::RecomputeCatchment()
 	/* Search catchment tiles for towns and industries */
 	BitmapTileIterator it(this->catchment_tiles);
 	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
-		if (IsTileType(tile, MP_HOUSE)) {
-			Town *t = Town::GetByTile(tile);
-			t->stations_near.insert(this);
+		this->RegisterCatchmentTile(tile);
+	}
+}
+
+/**
+ * Extend the catchment to cover newly added station tiles.
+ * Adding tiles can only grow the catchment, so only the marginal ring of each
+ * new tile needs to be added and registered; the result is identical to a full
+ * #RecomputeCatchment. Cases that cannot grow incrementally fall back to it.
+ * @param added Station tiles that were just added.
+ */
+void Station::ExtendCatchment(const TileArea &added)
+{
+	this->acceptance_dirty = true;
+
+	/* The catchment of a station with a neutral industry is tied to the industry, not to the station tiles. */
+	if (!_settings_game.station.serve_neutral_industries && this->industry != nullptr) {
+		this->RecomputeCatchment();
+		return;
+	}
+
+	/* Nothing to extend yet. */
+	if (this->rect.IsEmpty() || this->catchment_tiles.tile == INVALID_TILE) {
+		this->RecomputeCatchment();
+		return;
+	}
+
+	/* Re-anchor the bitmap when the catchment rectangle grew, keeping the bits already set. */
+	Rect r = this->GetCatchmentRect();
+	if (TileXY(r.left, r.top) != this->catchment_tiles.tile || r.Width() != (int)this->catchment_tiles.w || r.Height() != (int)this->catchment_tiles.h) {
+		BitmapTileArea old = this->catchment_tiles;
+		this->catchment_tiles.Initialize(r);
+		BitmapTileIterator it(old);
+		for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
+			this->catchment_tiles.SetTile(tile);
 		}
-		if (IsTileType(tile, MP_INDUSTRY)) {
-			Industry *i = Industry::GetByTile(tile);
+	}
+
+	InvalidateStationsAroundCache();
 
-			/* Ignore industry if it has a neutral station. It already can't be this station. */
-			if (!_settings_game.station.serve_neutral_industries && i->neutral_station != nullptr) continue;
+	/* Add the catchment of each new tile and register what becomes newly covered. */
+	for (TileIndex tile : added) {
+		if (!IsTileType(tile, MP_STATION) || GetStationIndex(tile) != this->index) continue;
 
-			i->stations_near.insert(this);
+		uint radius = GetTileCatchmentRadius(tile, this);
+		if (radius == CA_NONE) continue;
 
-			/* Add if we can deliver to this industry as well */
-			this->AddIndustryToDeliver(i, tile);
+		TileArea ta = TileArea(tile, 1, 1).Expand(radius);
+		for (TileIndex tile2 : ta) {
+			if (this->catchment_tiles.HasTile(tile2)) continue;
+			this->catchment_tiles.SetTile(tile2);
+			this->RegisterCatchmentTile(tile2);
 		}
 	}
 }
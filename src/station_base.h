@@ -147,7 +147,75 @@ private:
 
 /** Flow descriptions by origin stations. */
 class FlowStatMap : public std::map<StationID, FlowStat> {
+	typedef std::map<StationID, FlowStat> Parent;
+
+	mutable StationID last_origin = INVALID_STATION; ///< Origin the last lookup was done for.
+	mutable const FlowStat *last_flow = nullptr;     ///< Result of the last lookup; nullptr if there were no flows for the origin.
+
 public:
+	FlowStatMap() = default;
+	FlowStatMap(const FlowStatMap &other) : Parent(other) {}
+	FlowStatMap(FlowStatMap &&other) : Parent(std::move(other)) { other.ResetLookupCache(); }
+
+	FlowStatMap &operator=(const FlowStatMap &other)
+	{
+		this->Parent::operator=(other);
+		this->ResetLookupCache();
+		return *this;
+	}
+
+	FlowStatMap &operator=(FlowStatMap &&other)
+	{
+		this->Parent::operator=(std::move(other));
+		this->ResetLookupCache();
+		other.ResetLookupCache();
+		return *this;
+	}
+
+	/** Forget the last looked up flow, e.g. because it may have been erased. */
+	inline void ResetLookupCache()
+	{
+		this->last_origin = INVALID_STATION;
+		this->last_flow = nullptr;
+	}
+
+	/**
+	 * Look up the flows from the given origin. Consecutive cargo packets in
+	 * the unload and reroute loops overwhelmingly share their origin, so
+	 * remember the last result to skip the map search for those.
+	 * @param origin Origin station to get the flows for.
+	 * @return Flows for the origin, or nullptr if there are none.
+	 */
+	inline const FlowStat *FindFlows(StationID origin) const
+	{
+		if (this->last_origin != origin) {
+			const_iterator it(this->find(origin));
+			this->last_origin = origin;
+			this->last_flow = it != this->end() ? &it->second : nullptr;
+		}
+		return this->last_flow;
+	}
+
+	/* Hide the erasing methods of std::map; the lookup cache must not dangle. */
+
+	void erase(iterator it)
+	{
+		this->ResetLookupCache();
+		this->Parent::erase(it);
+	}
+
+	size_type erase(const StationID &origin)
+	{
+		this->ResetLookupCache();
+		return this->Parent::erase(origin);
+	}
+
+	void clear()
+	{
+		this->ResetLookupCache();
+		this->Parent::clear();
+	}
+
 	uint GetFlow() const;
 	uint GetFlowVia(StationID via) const;
 	uint GetFlowFrom(StationID from) const;
@@ -279,8 +347,8 @@ struct GoodsEntry {
 	 */
 	inline StationID GetVia(StationID source) const
 	{
-		FlowStatMap::const_iterator flow_it(this->flows.find(source));
-		return flow_it != this->flows.end() ? flow_it->second.GetVia() : INVALID_STATION;
+		const FlowStat *flow = this->flows.FindFlows(source);
+		return flow != nullptr ? flow->GetVia() : INVALID_STATION;
 	}
 
 	/**
@@ -293,8 +361,8 @@ struct GoodsEntry {
 	 */
 	inline StationID GetVia(StationID source, StationID excluded, StationID excluded2 = INVALID_STATION) const
 	{
-		FlowStatMap::const_iterator flow_it(this->flows.find(source));
-		return flow_it != this->flows.end() ? flow_it->second.GetVia(excluded, excluded2) : INVALID_STATION;
+		const FlowStat *flow = this->flows.FindFlows(source);
+		return flow != nullptr ? flow->GetVia(excluded, excluded2) : INVALID_STATION;
 	}
 };
 
@@ -472,6 +540,7 @@ public:
 	IndustryType indtype;   ///< Industry type to get the name from
 
 	BitmapTileArea catchment_tiles; ///< NOSAVE: Set of individual tiles covered by catchment area
+	bool acceptance_dirty;          ///< NOSAVE: Whether the acceptance totals have to be recomputed from the catchment.
 
 	StationHadVehicleOfType had_vehicle_of_type;
 
@@ -497,16 +566,18 @@ public:
 
 	void MoveSign(TileIndex new_xy) override;
 
-	void AfterStationTileSetChange(bool adding, StationType type);
+	void AfterStationTileSetChange(bool adding, StationType type, const TileArea *added = nullptr);
 
 	uint GetPlatformLength(TileIndex tile, DiagDirection dir) const override;
 	uint GetPlatformLength(TileIndex tile) const override;
 	void RecomputeCatchment();
+	void ExtendCatchment(const TileArea &added);
 	static void RecomputeCatchmentForAll();
 
 	uint GetCatchmentRadius() const;
 	Rect GetCatchmentRect() const;
 	bool CatchmentCoversTown(TownID t) const;
+	void RegisterCatchmentTile(TileIndex tile);
 	void AddIndustryToDeliver(Industry *ind, TileIndex tile);
 	void RemoveIndustryToDeliver(Industry *ind);
 	void RemoveFromAllNearbyLists();
@@ -49,12 +49,14 @@
 #include "table/airporttile_ids.h"
 #include "newgrf_airporttiles.h"
 #include "order_backup.h"
+#include "order_func.h"
 #include "newgrf_house.h"
 #include "company_gui.h"
 #include "linkgraph/linkgraph_base.h"
 #include "linkgraph/refresh.h"
 #include "widgets/station_widget.h"
 #include "tunnelbridge_map.h"
+#include "state_checksum.h"
 #include "station_cmd.h"
 #include "waypoint_cmd.h"
 #include "landscape_cmd.h"
@@ -259,14 +261,6 @@ static StringID GenerateStationName(Station *st, TileIndex tile, StationNaming n
 		if (s != st && s->town == t) {
 			if (s->indtype != IT_INVALID) {
 				indtypes[s->indtype] = true;
-				StringID name = GetIndustrySpec(s->indtype)->station_name;
-				if (name != STR_UNDEFINED) {
-					/* Filter for other industrytypes with the same name */
-					for (IndustryType it = 0; it < NUM_INDUSTRYTYPES; it++) {
-						const IndustrySpec *indsp = GetIndustrySpec(it);
-						if (indsp->enabled && indsp->station_name == name) indtypes[it] = true;
-					}
-				}
 				continue;
 			}
 			uint str = M(s->string_id);
@@ -279,6 +273,19 @@ static StringID GenerateStationName(Station *st, TileIndex tile, StationNaming n
 		}
 	}
 
+	/* Filter for other industrytypes with the same name as a used one; doing
+	 * this once per used type instead of once per station keeps the loop over
+	 * the stations linear. */
+	for (IndustryType it = 0; it < NUM_INDUSTRYTYPES; it++) {
+		if (!indtypes[it]) continue;
+		StringID name = GetIndustrySpec(it)->station_name;
+		if (name == STR_UNDEFINED) continue;
+		for (IndustryType other = 0; other < NUM_INDUSTRYTYPES; other++) {
+			const IndustrySpec *indsp = GetIndustrySpec(other);
+			if (indsp->enabled && indsp->station_name == name) indtypes[other] = true;
+		}
+	}
+
 	TileIndex indtile = tile;
 	StationNameInformation sni = { free_names, indtypes };
 	if (CircularTileSearch(&indtile, 7, FindNearIndustryName, &sni)) {
@@ -444,6 +451,9 @@ void Station::MoveSign(TileIndex new_xy)
 	this->BaseStation::MoveSign(new_xy);
 
 	_station_kdtree.Insert(this->index);
+
+	/* Orders going to this station resolve their destination to the sign tile. */
+	InvalidateOrderDestinationCache();
 }
 
 /** Update the virtual coords needed to draw the station sign for all stations. */
@@ -580,6 +590,43 @@ static CargoArray GetAcceptanceAroundStation(const Station *st, CargoTypes *alwa
 	return acceptance;
 }
 
+/**
+ * Check whether any house or industry tile resolves its cargo acceptance
+ * through a callback. Such acceptance can change without any tile changing,
+ * so stations cannot rely on their dirty flag and have to rescan
+ * periodically.
+ * @return Whether acceptance callbacks are in use.
+ */
+static bool AcceptanceCallbacksActive()
+{
+	for (HouseID i = 0; i < NUM_HOUSES; i++) {
+		const HouseSpec *hs = HouseSpec::Get(i);
+		if (!hs->enabled) continue;
+		if (HasBit(hs->callback_mask, CBM_HOUSE_CARGO_ACCEPTANCE) || HasBit(hs->callback_mask, CBM_HOUSE_ACCEPT_CARGO)) return true;
+	}
+
+	for (IndustryGfx i = 0; i < NUM_INDUSTRYTILES; i++) {
+		const IndustryTileSpec *its = GetIndustryTileSpec(i);
+		if (!its->enabled) continue;
+		if (HasBit(its->callback_mask, CBM_INDT_CARGO_ACCEPTANCE) || HasBit(its->callback_mask, CBM_INDT_ACCEPT_CARGO)) return true;
+	}
+
+	return false;
+}
+
+/**
+ * Mark the acceptance of all stations covering the area as in need of
+ * recomputation, e.g. because an accepting tile appeared or disappeared.
+ * @param ta Area of the changed tiles.
+ */
+void MarkStationAcceptanceDirtyAround(const TileArea &ta)
+{
+	ForAllStationsAroundTiles(ta, [](Station *st, TileIndex tile) {
+		st->acceptance_dirty = true;
+		return true;
+	});
+}
+
 /**
  * Update the acceptance for a station.
  * @param st Station to update
@@ -587,6 +634,8 @@ static CargoArray GetAcceptanceAroundStation(const Station *st, CargoTypes *alwa
  */
 void UpdateStationAcceptance(Station *st, bool show_msg)
 {
+	st->acceptance_dirty = false;
+
 	/* old accepted goods types */
 	CargoTypes old_acc = GetAcceptanceMask(st);
 
@@ -741,13 +790,26 @@ static void DeleteStationIfEmpty(BaseStation *st)
  * @param adding True if adding tiles, false if removing them.
  * @param type StationType being modified.
  */
-void Station::AfterStationTileSetChange(bool adding, StationType type)
+/**
+ * Update the station after its tile set changed.
+ * @param adding Whether tiles were added.
+ * @param type   Type of the station part that changed.
+ * @param added  The tiles that were added, to update the catchment incrementally; \c nullptr for a full recompute.
+ */
+void Station::AfterStationTileSetChange(bool adding, StationType type, const TileArea *added)
 {
 	this->UpdateVirtCoord();
 	DirtyCompanyInfrastructureWindows(this->owner);
 
+	/* Orders referencing this station may have become (in)valid. */
+	InvalidateOrderReviews();
+
 	if (adding) {
-		this->RecomputeCatchment();
+		if (added != nullptr) {
+			this->ExtendCatchment(*added);
+		} else {
+			this->RecomputeCatchment();
+		}
 		MarkCatchmentTilesDirty();
 		InvalidateWindowData(WC_STATION_LIST, this->owner, 0);
 	} else {
@@ -1460,7 +1522,7 @@ CommandCost CmdBuildRailStation(DoCommandFlag flags, TileIndex tile_org, RailTyp
 		}
 
 		st->MarkTilesDirty(false);
-		st->AfterStationTileSetChange(true, STATION_RAIL);
+		st->AfterStationTileSetChange(true, STATION_RAIL, &new_location);
 	}
 
 	return cost;
@@ -1634,6 +1696,7 @@ CommandCost RemoveFromRailBaseStation(TileArea ta, std::vector<T *> &affected_st
 		/* if we deleted the whole station, delete the train facility. */
 		if (st->train_station.tile == INVALID_TILE) {
 			st->facilities &= ~FACIL_TRAIN;
+			InvalidateOrderReviews();
 			SetWindowWidgetDirty(WC_STATION_VIEW, st->index, WID_SV_TRAINS);
 			MarkCatchmentTilesDirty();
 			st->UpdateVirtCoord();
@@ -1922,10 +1985,11 @@ CommandCost CmdBuildRoadStop(DoCommandFlag flags, TileIndex tile, uint8 width, u
 			Company::Get(st->owner)->infrastructure.station++;
 
 			MarkTileDirtyByTile(cur_tile);
+			YapfNotifyRoadLayoutChange(cur_tile);
 		}
 
 		if (st != nullptr) {
-			st->AfterStationTileSetChange(true, is_truck_stop ? STATION_TRUCK: STATION_BUS);
+			st->AfterStationTileSetChange(true, is_truck_stop ? STATION_TRUCK: STATION_BUS, &roadstop_area);
 		}
 	}
 	return cost;
@@ -2020,6 +2084,8 @@ static CommandCost RemoveRoadStop(TileIndex tile, DoCommandFlag flags)
 
 		delete cur_stop;
 
+		YapfNotifyRoadLayoutChange(tile);
+
 		/* Make sure no vehicle is going to the old roadstop */
 		for (RoadVehicle *v : RoadVehicle::Iterate()) {
 			if (v->First() == v && v->current_order.IsType(OT_GOTO_STATION) &&
@@ -2319,7 +2385,7 @@ CommandCost CmdBuildAirport(DoCommandFlag flags, TileIndex tile, byte airport_ty
 
 		Company::Get(st->owner)->infrastructure.airport++;
 
-		st->AfterStationTileSetChange(true, STATION_AIRPORT);
+		st->AfterStationTileSetChange(true, STATION_AIRPORT, &airport_area);
 		InvalidateWindowData(WC_STATION_VIEW, st->index, -1);
 
 		if (_settings_game.economy.station_noise_level) {
@@ -2553,7 +2619,7 @@ CommandCost CmdBuildDock(DoCommandFlag flags, TileIndex tile, StationID station_
 		MakeDock(tile, st->owner, st->index, direction, wc);
 		UpdateStationDockingTiles(st);
 
-		st->AfterStationTileSetChange(true, STATION_DOCK);
+		st->AfterStationTileSetChange(true, STATION_DOCK, &dock_area);
 	}
 
 	return cost;
@@ -3381,11 +3447,15 @@ static bool StationHandleBigTick(BaseStation *st)
 
 		for (CargoID i = 0; i < NUM_CARGO; i++) {
 			ClrBit(Station::From(st)->goods[i].status, GoodsEntry::GES_ACCEPTED_BIGTICK);
+			Station::From(st)->goods[i].cargo.MergePackets();
 		}
 	}
 
 
-	if ((st->facilities & FACIL_WAYPOINT) == 0) UpdateStationAcceptance(Station::From(st), true);
+	/* Without acceptance callbacks the acceptance only changes when a tile in
+	 * the catchment does, which sets the dirty flag; the full catchment scan
+	 * can be skipped otherwise. */
+	if ((st->facilities & FACIL_WAYPOINT) == 0 && (Station::From(st)->acceptance_dirty || AcceptanceCallbacksActive())) UpdateStationAcceptance(Station::From(st), true);
 
 	return true;
 }
@@ -3425,6 +3495,9 @@ static void UpdateStationRating(Station *st)
 	byte_inc_sat(&st->time_since_load);
 	byte_inc_sat(&st->time_since_unload);
 
+	/* The statue bonus is the same for every cargo type. */
+	int statue_rating = (Company::IsValidID(st->owner) && HasBit(st->town->statues, st->owner)) ? 26 : 0;
+
 	for (const CargoSpec *cs : CargoSpec::Iterate()) {
 		GoodsEntry *ge = &st->goods[cs->Index()];
 		/* Slowly increase the rating back to its original level in the case we
@@ -3503,7 +3576,7 @@ static void UpdateStationRating(Station *st)
 				if (ge->max_waiting_cargo <= 100) rating += 10;
 			}
 
-			if (Company::IsValidID(st->owner) && HasBit(st->town->statues, st->owner)) rating += 26;
+			rating += statue_rating;
 
 			byte age = ge->last_age;
 			if (age < 3) rating += 10;
@@ -3614,11 +3687,15 @@ void DeleteStaleLinks(Station *from)
 		LinkGraph *lg = LinkGraph::GetIfValid(ge.link_graph);
 		if (lg == nullptr) continue;
 		Node node = (*lg)[ge.node];
-		for (EdgeIterator it(node.Begin()); it != node.End();) {
-			Edge edge = it->second;
-			Station *to = Station::Get((*lg)[it->first].Station());
-			assert(to->goods[c].node == it->first);
-			++it; // Do that before removing the edge. Anything else may crash.
+		/* Refreshing vehicles or removing the edge below modifies the node's
+		 * edge vector, so collect the destinations first and don't hold on to
+		 * any edge wrappers across those calls. */
+		std::vector<NodeID> to_ids;
+		for (EdgeIterator it(node.Begin()); it != node.End(); ++it) to_ids.push_back(it->first);
+		for (NodeID to_id : to_ids) {
+			Edge edge = (*lg)[ge.node][to_id];
+			Station *to = Station::Get((*lg)[to_id].Station());
+			assert(to->goods[c].node == to_id);
 			assert(_date >= edge.LastUpdate());
 			uint timeout = LinkGraph::MIN_TIMEOUT_DISTANCE + (DistanceManhattan(from->xy, to->xy) >> 3);
 			if ((uint)(_date - edge.LastUpdate()) > timeout) {
@@ -3653,7 +3730,8 @@ void DeleteStaleLinks(Station *from)
 								LinkGraph::STALE_LINK_DEPOT_TIMEOUT) {
 							LinkRefresher::Run(v, false); // Don't allow merging. Otherwise lg might get deleted.
 						}
-						if (edge.LastUpdate() == _date) {
+						/* The refresher may have moved the edge vector around; look the edge up again. */
+						if ((*lg)[ge.node][to_id].LastUpdate() == _date) {
 							updated = true;
 							break;
 						}
@@ -3672,7 +3750,7 @@ void DeleteStaleLinks(Station *from)
 
 				if (!updated) {
 					/* If it's still considered dead remove it. */
-					node.RemoveEdge(to->goods[c].node);
+					(*lg)[ge.node].RemoveEdge(to_id);
 					ge.flows.DeleteFlows(to->index);
 					RerouteCargo(from, c, to->index, from->index);
 				}
@@ -3773,17 +3851,19 @@ static void StationHandleSmallTick(BaseStation *st)
 {
 	if ((st->facilities & FACIL_WAYPOINT) != 0 || !st->IsInUse()) return;
 
-	byte b = st->delete_ctr + 1;
-	if (b >= STATION_RATING_TICKS) b = 0;
-	st->delete_ctr = b;
-
-	if (b == 0) UpdateStationRating(Station::From(st));
+	/* Station index is included so that the updates are spread over the
+	 * whole cycle, even when many stations were created on the same tick. */
+	if ((_tick_counter + st->index) % STATION_RATING_TICKS == 0) UpdateStationRating(Station::From(st));
 }
 
+static void MarkCargoArrivalStationsDirty();
+
 void OnTick_Station()
 {
 	if (_game_mode == GM_EDITOR) return;
 
+	MarkCargoArrivalStationsDirty();
+
 	for (BaseStation *st : BaseStation::Iterate()) {
 		StationHandleSmallTick(st);
 
@@ -3832,6 +3912,26 @@ void ModifyStationRatingAround(TileIndex tile, Owner owner, int amount, uint rad
 	});
 }
 
+/** Stations that received cargo since the last tick, for batched redraws. */
+static std::set<StationID> _cargo_arrival_stations;
+
+/**
+ * Redraw the stations that received cargo since the last tick. A station
+ * receiving from many sources in one tick (e.g. all the houses in its
+ * catchment) is marked dirty once instead of once per delivery.
+ */
+static void MarkCargoArrivalStationsDirty()
+{
+	for (StationID index : _cargo_arrival_stations) {
+		Station *st = Station::GetIfValid(index);
+		if (st == nullptr) continue;
+
+		SetWindowDirty(WC_STATION_VIEW, index);
+		st->MarkTilesDirty(true);
+	}
+	_cargo_arrival_stations.clear();
+}
+
 static uint UpdateStationWaiting(Station *st, CargoID type, uint amount, SourceType source_type, SourceID source_id)
 {
 	/* We can't allocate a CargoPacket? Then don't do anything
@@ -3846,6 +3946,8 @@ static uint UpdateStationWaiting(Station *st, CargoID type, uint amount, SourceT
 	/* No new "real" cargo item yet. */
 	if (amount == 0) return 0;
 
+	_state_checksums.UpdateCargo(st->index ^ (uint32)type << 16 ^ amount);
+
 	StationID next = ge.GetVia(st->index);
 	ge.cargo.Append(new CargoPacket(st->index, st->xy, amount, source_type, source_id), next);
 	LinkGraph *lg = nullptr;
@@ -3872,8 +3974,7 @@ static uint UpdateStationWaiting(Station *st, CargoID type, uint amount, SourceT
 	TriggerStationAnimation(st, st->xy, SAT_NEW_CARGO, type);
 	AirportAnimationTrigger(st, AAT_STATION_NEW_CARGO, type);
 
-	SetWindowDirty(WC_STATION_VIEW, st->index);
-	st->MarkTilesDirty(true);
+	_cargo_arrival_stations.insert(st->index);
 	return amount;
 }
 
@@ -3930,6 +4031,48 @@ static void AddNearbyStationsByCatchment(TileIndex tile, StationList *stations,
 	}
 }
 
+/** Stations covering a house tile, valid while the generation matches. */
+struct StationsAroundCacheEntry {
+	StationList stations; ///< Stations covering the tile.
+	uint64 generation;    ///< Catchment generation the list was computed for.
+};
+
+/** Cached stations around house tiles, indexed by tile. */
+static std::unordered_map<uint32, StationsAroundCacheEntry> _stations_around_cache;
+static uint64 _station_catchment_generation = 1; ///< Generation, incremented when any station catchment changes.
+
+/** Number of cached house tiles above which the cache is flushed. */
+static const size_t STATIONS_AROUND_CACHE_LIMIT = 0x10000;
+
+/**
+ * Invalidate all cached stations-around-tile lookups.
+ * Called whenever the catchment area of any station changes.
+ */
+void InvalidateStationsAroundCache()
+{
+	_station_catchment_generation++;
+}
+
+/**
+ * Get the stations covering a house tile, through the per-tile cache.
+ * Houses generate cargo far more often than catchments change, so the town's
+ * nearby stations only need to be filtered per tile when the cache misses.
+ * @param tile House tile to find stations for.
+ * @return List of stations covering the tile; valid until the next catchment change or house lookup.
+ */
+static const StationList *FindStationsAroundHouseTile(TileIndex tile)
+{
+	if (_stations_around_cache.size() >= STATIONS_AROUND_CACHE_LIMIT) _stations_around_cache.clear();
+
+	StationsAroundCacheEntry &entry = _stations_around_cache[(uint32)tile];
+	if (entry.generation != _station_catchment_generation) {
+		entry.stations.clear();
+		AddNearbyStationsByCatchment(tile, &entry.stations, Town::GetByTile(tile)->stations_near);
+		entry.generation = _station_catchment_generation;
+	}
+	return &entry.stations;
+}
+
 /**
  * Run a tile loop to find stations around a tile, on demand. Cache the result for further requests
  * @return pointer to a StationList containing all stations found
@@ -3940,7 +4083,7 @@ const StationList *StationFinder::GetStations()
 		if (IsTileType(this->tile, MP_HOUSE)) {
 			/* Town nearby stations need to be filtered per tile. */
 			assert(this->w == 1 && this->h == 1);
-			AddNearbyStationsByCatchment(this->tile, &this->stations, Town::GetByTile(this->tile)->stations_near);
+			return FindStationsAroundHouseTile(this->tile);
 		} else {
 			ForAllStationsAroundTiles(*this, [this](Station *st, TileIndex tile) {
 				this->stations.insert(st);
@@ -22,6 +22,7 @@
 #include "viewport_func.h"
 #include "widgets/dropdown_func.h"
 #include "station_base.h"
+#include "vehicle_base.h"
 #include "waypoint_base.h"
 #include "tilehighlight_func.h"
 #include "company_base.h"
@@ -38,6 +39,7 @@
 #include "table/strings.h"
 
 #include <set>
+#include <unordered_set>
 #include <vector>
 
 #include "safeguards.h"
@@ -228,8 +230,25 @@ protected:
 
 		this->stations.clear();
 
+		/* The stations the company's vehicles have orders to, collected in a
+		 * single pass over the orders when the first "neutral" station shows
+		 * up, instead of scanning all orders for each such station. */
+		std::unordered_set<StationID> in_use;
+		bool in_use_valid = false;
+
 		for (const Station *st : Station::Iterate()) {
-			if (st->owner == owner || (st->owner == OWNER_NONE && HasStationInUse(st->index, true, owner))) {
+			if (st->owner == OWNER_NONE && !in_use_valid) {
+				for (const Vehicle *v : Vehicle::Iterate()) {
+					if (v->owner != owner) continue;
+					for (const Order *order : v->Orders()) {
+						if (order->IsType(OT_GOTO_STATION) || order->IsType(OT_GOTO_WAYPOINT)) {
+							in_use.insert(order->GetDestination());
+						}
+					}
+				}
+				in_use_valid = true;
+			}
+			if (st->owner == owner || (st->owner == OWNER_NONE && in_use.find(st->index) != in_use.end())) {
 				if (this->facilities & st->facilities) { // only stations with selected facilities
 					int num_waiting_cargo = 0;
 					for (CargoID j = 0; j < NUM_CARGO; j++) {
@@ -325,7 +344,63 @@ protected:
 	/** Sort the stations list */
 	void SortStationsList()
 	{
-		if (!this->stations.Sort()) return;
+		/* The waiting and rating sorters aggregate over all filtered cargoes;
+		 * compute each station's aggregate once per resort instead of once
+		 * per comparison. */
+		bool changed;
+		switch (this->stations.SortType()) {
+			case 0: // sort by name
+				if (StrNatSortKeysSupported()) {
+					/* Sorting by name collates per comparison; extract each station's collation key once instead. */
+					changed = this->stations.SortByKey([](const Station * const &st) {
+						return std::make_pair(StrNatSortKey(st->GetCachedName()), st->index);
+					});
+				} else {
+					changed = this->stations.Sort();
+				}
+				break;
+
+			case 2: // sort by total waiting cargo
+				changed = this->stations.SortByKey([](const Station * const &st) {
+					int sum = 0;
+					for (CargoID j : SetCargoBitIterator(cargo_filter)) sum += st->goods[j].cargo.TotalCount();
+					return sum;
+				});
+				break;
+
+			case 3: // sort by available waiting cargo
+				changed = this->stations.SortByKey([](const Station * const &st) {
+					int sum = 0;
+					for (CargoID j : SetCargoBitIterator(cargo_filter)) sum += st->goods[j].cargo.AvailableCount();
+					return sum;
+				});
+				break;
+
+			case 4: // sort by highest rating
+				changed = this->stations.SortByKey([](const Station * const &st) {
+					byte maxr = 0;
+					for (CargoID j : SetCargoBitIterator(cargo_filter)) {
+						if (st->goods[j].HasRating()) maxr = std::max(maxr, st->goods[j].rating);
+					}
+					return maxr;
+				});
+				break;
+
+			case 5: // sort by lowest rating
+				changed = this->stations.SortByKey([](const Station * const &st) {
+					byte minr = 255;
+					for (CargoID j : SetCargoBitIterator(cargo_filter)) {
+						if (st->goods[j].HasRating()) minr = std::min(minr, st->goods[j].rating);
+					}
+					return -minr;
+				});
+				break;
+
+			default:
+				changed = this->stations.Sort();
+				break;
+		}
+		if (!changed) return;
 
 		/* Set the modified widget dirty */
 		this->SetWidgetDirty(WID_STL_LIST);
@@ -132,7 +132,7 @@ struct LanguageWriter {
 	/** Especially destroy the subclasses. */
 	virtual ~LanguageWriter() {}
 
-	virtual void WriteLength(uint length);
+	virtual void WriteIndex(const uint32 *offsets, uint count);
 	virtual void WriteLang(const StringData &data);
 };
 
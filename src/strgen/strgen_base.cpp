@@ -174,7 +174,10 @@ uint StringData::VersionHashStr(uint hash, const char *s) const
  */
 uint StringData::Version() const
 {
-	uint hash = 0;
+	/* Seed the hash with the revision of the file format, so language packs
+	 * written in the old length-prefixed layout are rejected even when the
+	 * set of strings itself has not changed. */
+	uint hash = 1;
 
 	for (size_t i = 0; i < this->max_strings; i++) {
 		const LangString *ls = this->strings[i];
@@ -934,22 +937,13 @@ static void PutCommandString(Buffer *buffer, const char *str)
 }
 
 /**
- * Write the length as a simple gamma.
- * @param length The number to write.
+ * Write the offset table of the strings.
+ * @param offsets The offsets, already converted to little endian.
+ * @param count The number of offsets.
  */
-void LanguageWriter::WriteLength(uint length)
+void LanguageWriter::WriteIndex(const uint32 *offsets, uint count)
 {
-	char buffer[2];
-	int offs = 0;
-	if (length >= 0x4000) {
-		strgen_fatal("string too long");
-	}
-
-	if (length >= 0xC0) {
-		buffer[offs++] = (length >> 8) | 0xC0;
-	}
-	buffer[offs++] = length & 0xFF;
-	this->Write((byte*)buffer, offs);
+	this->Write((const byte *)offsets, count * sizeof(*offsets));
 }
 
 /**
@@ -977,6 +971,11 @@ void LanguageWriter::WriteLang(const StringData &data)
 	_lang.winlangid = TO_LE16(_lang.winlangid);
 
 	this->WriteHeader(&_lang);
+
+	/* Encode every string into its own buffer first; the offset table that
+	 * precedes the strings in the file can only be written once the size of
+	 * each encoded string is known. */
+	std::vector<Buffer> strings;
 	Buffer buffer;
 
 	for (size_t tab = 0; tab < data.tabs; tab++) {
@@ -987,7 +986,9 @@ void LanguageWriter::WriteLang(const StringData &data)
 
 			/* For undefined strings, just set that it's an empty string */
 			if (ls == nullptr) {
-				this->WriteLength(0);
+				buffer.AppendByte(0);
+				strings.push_back(std::move(buffer));
+				buffer.clear();
 				continue;
 			}
 
@@ -1050,9 +1051,23 @@ void LanguageWriter::WriteLang(const StringData &data)
 
 			if (cmdp != nullptr) PutCommandString(&buffer, cmdp);
 
-			this->WriteLength((uint)buffer.size());
-			this->Write(buffer.data(), buffer.size());
+			buffer.AppendByte(0); // terminate with a zero
+			strings.push_back(std::move(buffer));
 			buffer.clear();
 		}
 	}
+
+	/* Write the offset of each string, relative to the start of the string data. */
+	std::vector<uint32> offsets;
+	offsets.reserve(strings.size());
+	uint32 offset = 0;
+	for (const Buffer &str : strings) {
+		offsets.push_back(TO_LE32(offset));
+		offset += (uint32)str.size();
+	}
+	this->WriteIndex(offsets.data(), (uint)offsets.size());
+
+	for (const Buffer &str : strings) {
+		this->Write(str.data(), str.size());
+	}
 }
@@ -761,6 +761,48 @@ int strnatcmp(const char *s1, const char *s2, bool ignore_garbage_at_front)
 	return strcasecmp(s1, s2);
 }
 
+/**
+ * Check whether #StrNatSortKey can produce sort keys.
+ * Without a collator the platform compare functions have to be called per
+ * comparison and no equivalent key form exists.
+ * @return True when sort keys matching the strnatcmp order can be made.
+ */
+bool StrNatSortKeysSupported()
+{
+#ifdef WITH_ICU_I18N
+	return _current_collator != nullptr;
+#else
+	return false;
+#endif
+}
+
+/**
+ * Get a sort key for a string: a byte string that, compared bytewise, orders
+ * the same way strnatcmp orders the source strings. Extracting the key once
+ * per item turns the repeated collations of a sort into plain byte compares.
+ * @param s String to derive the sort key from.
+ * @param ignore_garbage_at_front Skip punctuation at the front of the string.
+ * @return The sort key.
+ * @pre StrNatSortKeysSupported()
+ */
+std::string StrNatSortKey(const char *s, bool ignore_garbage_at_front)
+{
+	assert(StrNatSortKeysSupported());
+#ifdef WITH_ICU_I18N
+	if (ignore_garbage_at_front) s = SkipGarbage(s);
+
+	icu::UnicodeString ustr = icu::UnicodeString::fromUTF8(s);
+	int32_t length = _current_collator->getSortKey(ustr, nullptr, 0);
+	std::string key(length, '\0');
+	_current_collator->getSortKey(ustr, reinterpret_cast<uint8_t *>(key.data()), length);
+	/* The sort key is NUL-terminated; the terminator is not part of the key. */
+	if (length > 0) key.pop_back();
+	return key;
+#else
+	return std::string();
+#endif
+}
+
 #ifdef WITH_UNISCRIBE
 
 /* static */ std::unique_ptr<StringIterator> StringIterator::Create()
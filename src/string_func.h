@@ -277,4 +277,7 @@ char *strcasestr(const char *haystack, const char *needle);
 
 int strnatcmp(const char *s1, const char *s2, bool ignore_garbage_at_front = false);
 
+bool StrNatSortKeysSupported();
+std::string StrNatSortKey(const char *s, bool ignore_garbage_at_front = false);
+
 #endif /* STRING_FUNC_H */
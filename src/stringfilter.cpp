@@ -33,6 +33,8 @@ void StringFilter::SetFilterTerm(const char *str)
 
 	assert(str != nullptr);
 
+	this->filter_term = str;
+
 	char *dest = MallocT<char>(strlen(str) + 1);
 	this->filter_buffer = dest;
 
@@ -82,6 +84,25 @@ void StringFilter::SetFilterTerm(const char *str)
 	}
 }
 
+/**
+ * Check whether changing the filter term to the given string can only narrow
+ * the set of matching items, i.e. whether everything matching the new term
+ * also matches the current term.
+ *
+ * This is the case when the current term is a prefix of the new term: the
+ * appended characters either extend the last word or add further words, and
+ * both only add constraints. Callers can use this to filter their current
+ * matches instead of refiltering all candidates, e.g. on every keystroke in
+ * a filter edit box.
+ *
+ * @param str Filter term that is about to be set.
+ * @return true if the new term cannot match anything the current term rejects.
+ */
+bool StringFilter::IsNarrowing(const char *str) const
+{
+	return strncmp(this->filter_term.c_str(), str, this->filter_term.size()) == 0;
+}
+
 /**
  * Reset the matching state to process a new item.
  */
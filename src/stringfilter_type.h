@@ -37,6 +37,7 @@ private:
 	};
 
 	const char *filter_buffer;                     ///< Parsed filter string. Words separated by 0.
+	std::string filter_term;                       ///< Unparsed filter term, used to detect narrowing term changes.
 	std::vector<WordState> word_index;             ///< Word index and filter state.
 	uint word_matches;                             ///< Summary of filter state: Number of words matched.
 
@@ -51,6 +52,7 @@ public:
 	~StringFilter() { free(this->filter_buffer); }
 
 	void SetFilterTerm(const char *str);
+	bool IsNarrowing(const char *str) const;
 
 	/**
 	 * Check whether any filter words were entered.
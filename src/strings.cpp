@@ -1814,23 +1814,24 @@ bool ReadLanguagePack(const LanguageMetadata *lang)
 		count += num;
 	}
 
+	/* The data starts with the offset table; the zero terminated strings
+	 * follow it. The header is a multiple of four bytes, so the table is
+	 * properly aligned within the read buffer. */
+	const uint32 *offset_table = reinterpret_cast<const uint32 *>(lang_pack->data);
+	char *string_data = lang_pack->data + count * sizeof(*offset_table);
+	if (string_data >= end) return false;
+
 	/* Allocate offsets */
 	std::vector<char *> offs(count);
 
-	/* Fill offsets */
-	char *s = lang_pack->data;
-	len = (byte)*s++;
+	/* Fill offsets; each string is terminated within the buffer, if only by
+	 * the zero that ReadFileToMem() appended after the file contents. */
+	size_t string_data_len = end - string_data;
 	for (uint i = 0; i < count; i++) {
-		if (s + len >= end) return false;
+		uint32 offset = FROM_LE32(offset_table[i]);
+		if (offset >= string_data_len) return false;
 
-		if (len >= 0xC0) {
-			len = ((len & 0x3F) << 8) + (byte)*s++;
-			if (s + len >= end) return false;
-		}
-		offs[i] = s;
-		s += len;
-		len = (byte)*s;
-		*s++ = '\0'; // zero terminate the string
+		offs[i] = string_data + offset;
 	}
 
 	_langpack.langpack = std::move(lang_pack);
@@ -11,6 +11,7 @@
 #include "company_func.h"
 #include "industry.h"
 #include "town.h"
+#include "town_kdtree.h"
 #include "news_func.h"
 #include "ai/ai.hpp"
 #include "station_base.h"
@@ -200,6 +201,34 @@ static bool CheckSubsidyDistance(SourceType src_type, SourceID src, SourceType d
 	return (DistanceManhattan(tile_src, tile_dst) <= SUBSIDY_MAX_DISTANCE);
 }
 
+/**
+ * Pick a random town within the subsidy distance limit of a tile.
+ * The town k-d tree is queried for the candidates instead of sampling random
+ * towns, as on a large map nearly all towns are beyond the distance limit and
+ * random sampling mostly produces rejected pairs.
+ * @param tile Tile to search around.
+ * @return A town within #SUBSIDY_MAX_DISTANCE of \a tile, or \c nullptr if there is none.
+ */
+static const Town *FindRandomTownNearby(TileIndex tile)
+{
+	uint x = TileX(tile);
+	uint y = TileY(tile);
+
+	std::vector<TownID> candidates;
+	_town_kdtree.FindContained(
+		(uint16)(x > SUBSIDY_MAX_DISTANCE ? x - SUBSIDY_MAX_DISTANCE : 0),
+		(uint16)(y > SUBSIDY_MAX_DISTANCE ? y - SUBSIDY_MAX_DISTANCE : 0),
+		(uint16)std::min<uint>(x + SUBSIDY_MAX_DISTANCE + 1, Map::SizeX()),
+		(uint16)std::min<uint>(y + SUBSIDY_MAX_DISTANCE + 1, Map::SizeY()),
+		[&](TownID t) {
+			/* The square box around the tile also contains towns beyond the Manhattan distance limit. */
+			if (DistanceManhattan(tile, Town::Get(t)->xy) <= SUBSIDY_MAX_DISTANCE) candidates.push_back(t);
+		});
+
+	if (candidates.empty()) return nullptr;
+	return Town::Get(candidates[RandomRange((uint32)candidates.size())]);
+}
+
 /**
  * Creates a subsidy with the given parameters.
  * @param cid      Subsidised cargo.
@@ -289,12 +318,11 @@ bool FindSubsidyPassengerRoute()
 		return false;
 	}
 
-	const Town *dst = Town::GetRandom();
-	if (dst->cache.population < SUBSIDY_PAX_MIN_POPULATION || src == dst) {
+	const Town *dst = FindRandomTownNearby(src->xy);
+	if (dst == nullptr || dst->cache.population < SUBSIDY_PAX_MIN_POPULATION || src == dst) {
 		return false;
 	}
 
-	if (DistanceManhattan(src->xy, dst->xy) > SUBSIDY_MAX_DISTANCE) return false;
 	if (CheckSubsidyDuplicate(CT_PASSENGERS, ST_TOWN, src->index, ST_TOWN, dst->index)) return false;
 
 	CreateSubsidy(CT_PASSENGERS, ST_TOWN, src->index, ST_TOWN, dst->index);
@@ -427,8 +455,10 @@ bool FindSubsidyCargoDestination(CargoID cid, SourceType src_type, SourceID src)
 	SourceID dst;
 	switch (dst_type) {
 		case ST_TOWN: {
-			/* Select a random town. */
-			const Town *dst_town = Town::GetRandom();
+			/* Select a random town within the distance limit of the source. */
+			TileIndex tile_src = (src_type == ST_TOWN) ? Town::Get(src)->xy : Industry::Get(src)->location.tile;
+			const Town *dst_town = FindRandomTownNearby(tile_src);
+			if (dst_town == nullptr) return false;
 
 			/* Calculate cargo acceptance of houses around town center. */
 			CargoArray town_cargo_accepted;
@@ -46,7 +46,7 @@
 #define MK(bt, label, colour, weight, mult, ip, td1, td2, freight, te, str_plural, str_singular, str_volume, classes) \
 		{bt, label, colour, colour, weight, mult, ip, {td1, td2}, freight, te, 0, \
 		MK_STR_CARGO_PLURAL(str_plural), MK_STR_CARGO_SINGULAR(str_singular), str_volume, MK_STR_QUANTITY(str_plural), MK_STR_ABBREV(str_plural), \
-		MK_SPRITE(str_plural), classes, nullptr, nullptr, 0}
+		MK_SPRITE(str_plural), classes, nullptr, nullptr, 0, {}}
 
 /** Cargo types available by default. */
 static const CargoSpec _default_cargo[] = {
@@ -16,7 +16,10 @@
 #include "object_base.h"
 #include "company_base.h"
 #include "company_func.h"
+#include "town.h"
 #include "core/backup_type.hpp"
+#include "pathfinder/water_regions.h"
+#include "water.h"
 #include "terraform_cmd.h"
 #include "landscape_cmd.h"
 
@@ -176,53 +179,69 @@ static std::tuple<CommandCost, TileIndex> TerraformTileHeight(TerraformerState *
 }
 
 /**
- * Terraform land
- * @param flags for this command type
+ * Build the heightmap model of a terraforming operation.
+ * Performs the constraint propagation over the affected area, without
+ * validating the result against the tiles' contents.
+ * @param ts TerraformerState to fill with the resulting heights.
  * @param tile tile to terraform
  * @param slope corners to terraform (SLOPE_xxx)
- * @param dir_up direction; eg up (true) or down (false)
- * @return the cost of this operation or an error
+ * @param direction direction; eg up (+1) or down (-1)
+ * @return the cost of the height changes or an error, and the tile to highlight on error
  */
-std::tuple<CommandCost, Money, TileIndex> CmdTerraformLand(DoCommandFlag flags, TileIndex tile, Slope slope, bool dir_up)
+static std::tuple<CommandCost, TileIndex> TerraformBuildModel(TerraformerState *ts, TileIndex tile, Slope slope, int direction)
 {
 	CommandCost total_cost(EXPENSES_CONSTRUCTION);
-	int direction = (dir_up ? 1 : -1);
-	TerraformerState ts;
 
 	/* Compute the costs and the terraforming result in a model of the landscape */
 	if ((slope & SLOPE_W) != 0 && tile + TileDiffXY(1, 0) < Map::Size()) {
 		TileIndex t = tile + TileDiffXY(1, 0);
-		auto [cost, err_tile] = TerraformTileHeight(&ts, t, TileHeight(t) + direction);
-		if (cost.Failed()) return { cost, 0, err_tile };
+		auto [cost, err_tile] = TerraformTileHeight(ts, t, TileHeight(t) + direction);
+		if (cost.Failed()) return { cost, err_tile };
 		total_cost.AddCost(cost);
 	}
 
 	if ((slope & SLOPE_S) != 0 && tile + TileDiffXY(1, 1) < Map::Size()) {
 		TileIndex t = tile + TileDiffXY(1, 1);
-		auto [cost, err_tile] = TerraformTileHeight(&ts, t, TileHeight(t) + direction);
-		if (cost.Failed()) return { cost, 0, err_tile };
+		auto [cost, err_tile] = TerraformTileHeight(ts, t, TileHeight(t) + direction);
+		if (cost.Failed()) return { cost, err_tile };
 		total_cost.AddCost(cost);
 	}
 
 	if ((slope & SLOPE_E) != 0 && tile + TileDiffXY(0, 1) < Map::Size()) {
 		TileIndex t = tile + TileDiffXY(0, 1);
-		auto [cost, err_tile] = TerraformTileHeight(&ts, t, TileHeight(t) + direction);
-		if (cost.Failed()) return { cost, 0, err_tile };
+		auto [cost, err_tile] = TerraformTileHeight(ts, t, TileHeight(t) + direction);
+		if (cost.Failed()) return { cost, err_tile };
 		total_cost.AddCost(cost);
 	}
 
 	if ((slope & SLOPE_N) != 0) {
 		TileIndex t = tile + TileDiffXY(0, 0);
-		auto [cost, err_tile] = TerraformTileHeight(&ts, t, TileHeight(t) + direction);
-		if (cost.Failed()) return { cost, 0, err_tile };
+		auto [cost, err_tile] = TerraformTileHeight(ts, t, TileHeight(t) + direction);
+		if (cost.Failed()) return { cost, err_tile };
 		total_cost.AddCost(cost);
 	}
 
+	return { total_cost, INVALID_TILE };
+}
+
+/**
+ * Validate and apply the heightmap model of a terraforming operation.
+ * The model is only read, so the same model can serve a test run and the
+ * following execution run.
+ * @param ts TerraformerState with the resulting heights.
+ * @param flags for this command type
+ * @param tile tile to terraform
+ * @param direction direction; eg up (+1) or down (-1)
+ * @param total_cost cost of the height changes of the model
+ * @return the cost of this operation or an error
+ */
+static std::tuple<CommandCost, Money, TileIndex> TerraformApplyModel(const TerraformerState *ts, DoCommandFlag flags, TileIndex tile, int direction, CommandCost total_cost)
+{
 	/* Check if the terraforming is valid wrt. tunnels, bridges and objects on the surface
 	 * Pass == 0: Collect tileareas which are caused to be auto-cleared.
 	 * Pass == 1: Collect the actual cost. */
 	for (int pass = 0; pass < 2; pass++) {
-		for (TileIndexSet::const_iterator it = ts.dirty_tiles.begin(); it != ts.dirty_tiles.end(); it++) {
+		for (TileIndexSet::const_iterator it = ts->dirty_tiles.begin(); it != ts->dirty_tiles.end(); it++) {
 			TileIndex t = *it;
 
 			assert(t < Map::Size());
@@ -231,10 +250,10 @@ std::tuple<CommandCost, Money, TileIndex> CmdTerraformLand(DoCommandFlag flags,
 			if (IsTileType(t, MP_VOID)) continue;
 
 			/* Find new heights of tile corners */
-			int z_N = TerraformGetHeightOfTile(&ts, t + TileDiffXY(0, 0));
-			int z_W = TerraformGetHeightOfTile(&ts, t + TileDiffXY(1, 0));
-			int z_S = TerraformGetHeightOfTile(&ts, t + TileDiffXY(1, 1));
-			int z_E = TerraformGetHeightOfTile(&ts, t + TileDiffXY(0, 1));
+			int z_N = TerraformGetHeightOfTile(ts, t + TileDiffXY(0, 0));
+			int z_W = TerraformGetHeightOfTile(ts, t + TileDiffXY(1, 0));
+			int z_S = TerraformGetHeightOfTile(ts, t + TileDiffXY(1, 1));
+			int z_E = TerraformGetHeightOfTile(ts, t + TileDiffXY(0, 1));
 
 			/* Find min and max height of tile */
 			int z_min = std::min({z_N, z_W, z_S, z_E});
@@ -295,33 +314,54 @@ std::tuple<CommandCost, Money, TileIndex> CmdTerraformLand(DoCommandFlag flags,
 	}
 
 	Company *c = Company::GetIfValid(_current_company);
-	if (c != nullptr && GB(c->terraform_limit, 16, 16) < ts.tile_to_new_height.size()) {
+	if (c != nullptr && GB(c->terraform_limit, 16, 16) < ts->tile_to_new_height.size()) {
 		return { CommandCost(STR_ERROR_TERRAFORM_LIMIT_REACHED), 0, INVALID_TILE };
 	}
 
 	if (flags & DC_EXEC) {
 		/* Mark affected areas dirty. */
-		for (TileIndexSet::const_iterator it = ts.dirty_tiles.begin(); it != ts.dirty_tiles.end(); it++) {
+		for (TileIndexSet::const_iterator it = ts->dirty_tiles.begin(); it != ts->dirty_tiles.end(); it++) {
 			MarkTileDirtyByTile(*it);
-			TileIndexToHeightMap::const_iterator new_height = ts.tile_to_new_height.find(*it);
-			if (new_height == ts.tile_to_new_height.end()) continue;
+			TileIndexToHeightMap::const_iterator new_height = ts->tile_to_new_height.find(*it);
+			if (new_height == ts->tile_to_new_height.end()) continue;
 			MarkTileDirtyByTile(*it, 0, new_height->second);
 		}
 
 		/* change the height */
-		for (TileIndexToHeightMap::const_iterator it = ts.tile_to_new_height.begin();
-				it != ts.tile_to_new_height.end(); it++) {
+		for (TileIndexToHeightMap::const_iterator it = ts->tile_to_new_height.begin();
+				it != ts->tile_to_new_height.end(); it++) {
 			TileIndex t = it->first;
 			int height = it->second;
 
 			SetTileHeight(t, (uint)height);
+			InvalidateWaterRegion(t);
+			ClearNeighbourNonFloodingStates(t);
 		}
 
-		if (c != nullptr) c->terraform_limit -= (uint32)ts.tile_to_new_height.size() << 16;
+		if (c != nullptr) c->terraform_limit -= (uint32)ts->tile_to_new_height.size() << 16;
 	}
 	return { total_cost, 0, total_cost.Succeeded() ? tile : INVALID_TILE };
 }
 
+/**
+ * Terraform land
+ * @param flags for this command type
+ * @param tile tile to terraform
+ * @param slope corners to terraform (SLOPE_xxx)
+ * @param dir_up direction; eg up (true) or down (false)
+ * @return the cost of this operation or an error
+ */
+std::tuple<CommandCost, Money, TileIndex> CmdTerraformLand(DoCommandFlag flags, TileIndex tile, Slope slope, bool dir_up)
+{
+	int direction = (dir_up ? 1 : -1);
+	TerraformerState ts;
+
+	auto [total_cost, err_tile] = TerraformBuildModel(&ts, tile, slope, direction);
+	if (total_cost.Failed()) return { total_cost, 0, err_tile };
+
+	return TerraformApplyModel(&ts, flags, tile, direction, total_cost);
+}
+
 
 /**
  * Levels a selected (rectangle) area of land
@@ -366,8 +406,23 @@ std::tuple<CommandCost, Money, TileIndex> CmdLevelLand(DoCommandFlag flags, Tile
 		TileIndex t = *iter;
 		uint curh = TileHeight(t);
 		while (curh != h) {
+			int direction = curh <= h ? 1 : -1;
+
+			/* Propagate the height constraints of this step only once; the model
+			 * is read-only afterwards, so it serves both the test run and the
+			 * following execution run. */
+			TerraformerState ts;
+			auto [model_cost, model_err] = TerraformBuildModel(&ts, t, SLOPE_N, direction);
+
 			CommandCost ret;
-			std::tie(ret, std::ignore, error_tile) = Command<CMD_TERRAFORM_LAND>::Do(flags & ~DC_EXEC, t, SLOPE_N, curh <= h);
+			if (model_cost.Failed()) {
+				ret = model_cost;
+				error_tile = model_err;
+			} else {
+				SetTownRatingTestMode(true);
+				std::tie(ret, std::ignore, error_tile) = TerraformApplyModel(&ts, flags & ~DC_EXEC, t, direction, model_cost);
+				SetTownRatingTestMode(false);
+			}
 			if (ret.Failed()) {
 				last_error = ret;
 
@@ -381,7 +436,7 @@ std::tuple<CommandCost, Money, TileIndex> CmdLevelLand(DoCommandFlag flags, Tile
 				if (money < 0) {
 					return { cost, ret.GetCost(), error_tile };
 				}
-				Command<CMD_TERRAFORM_LAND>::Do(flags, t, SLOPE_N, curh <= h);
+				TerraformApplyModel(&ts, flags, t, direction, model_cost);
 			} else {
 				/* When we're at the terraform limit we better bail (unneeded) testing as well.
 				 * This will probably cause the terraforming cost to be underestimated, but only
@@ -35,7 +35,9 @@ struct TextEffect : public ViewportSign {
 	}
 };
 
-static std::vector<struct TextEffect> _text_effects; ///< Text effects are stored there
+static std::vector<struct TextEffect> _text_effects;    ///< Text effects are stored there
+static std::vector<TextEffectID> _free_text_effects;    ///< Slots in #_text_effects whose effect has expired
+static std::vector<TextEffectID> _active_text_effects;  ///< Slots in #_text_effects with a live effect, compacted during the bulk move pass
 
 /* Text Effects */
 TextEffectID AddTextEffect(StringID msg, int center, int y, uint8 duration, TextEffectMode mode)
@@ -43,10 +45,14 @@ TextEffectID AddTextEffect(StringID msg, int center, int y, uint8 duration, Text
 	if (_game_mode == GM_MENU) return INVALID_TE_ID;
 
 	TextEffectID i;
-	for (i = 0; i < _text_effects.size(); i++) {
-		if (_text_effects[i].string_id == INVALID_STRING_ID) break;
+	if (!_free_text_effects.empty()) {
+		i = _free_text_effects.back();
+		_free_text_effects.pop_back();
+	} else {
+		i = (TextEffectID)_text_effects.size();
+		_text_effects.emplace_back();
 	}
-	if (i == _text_effects.size()) _text_effects.emplace_back();
+	_active_text_effects.push_back(i);
 
 	TextEffect &te = _text_effects[i];
 
@@ -78,7 +84,8 @@ void UpdateTextEffect(TextEffectID te_id, StringID msg)
 
 void UpdateAllTextEffectVirtCoords()
 {
-	for (auto &te : _text_effects) {
+	for (TextEffectID te_id : _active_text_effects) {
+		TextEffect &te = _text_effects[te_id];
 		if (te.string_id == INVALID_STRING_ID) continue;
 		SetDParam(0, te.params_1);
 		SetDParam(1, te.params_2);
@@ -88,7 +95,12 @@ void UpdateAllTextEffectVirtCoords()
 
 void RemoveTextEffect(TextEffectID te_id)
 {
-	_text_effects[te_id].Reset();
+	TextEffect &te = _text_effects[te_id];
+	if (te.string_id == INVALID_STRING_ID) return;
+	te.Reset();
+	_free_text_effects.push_back(te_id);
+	/* Remove from the active list right away, so the slot can't end up in it twice when reused. */
+	_active_text_effects.erase(std::find(_active_text_effects.begin(), _active_text_effects.end(), te_id));
 }
 
 void MoveAllTextEffects(uint delta_ms)
@@ -97,12 +109,14 @@ void MoveAllTextEffects(uint delta_ms)
 	uint count = texteffecttimer.CountElapsed(delta_ms);
 	if (count == 0) return;
 
-	for (TextEffect &te : _text_effects) {
+	for (TextEffectID te_id : _active_text_effects) {
+		TextEffect &te = _text_effects[te_id];
 		if (te.string_id == INVALID_STRING_ID) continue;
 		if (te.mode != TE_RISING) continue;
 
 		if (te.duration < count) {
 			te.Reset();
+			_free_text_effects.push_back(te_id);
 			continue;
 		}
 
@@ -111,12 +125,20 @@ void MoveAllTextEffects(uint delta_ms)
 		te.top -= count * ZOOM_LVL_BASE;
 		te.MarkDirty(ZOOM_LVL_OUT_8X);
 	}
+
+	/* Compact the active list; expired slots were already added to the free list. */
+	_active_text_effects.erase(std::remove_if(_active_text_effects.begin(), _active_text_effects.end(),
+			[](TextEffectID te_id) { return _text_effects[te_id].string_id == INVALID_STRING_ID; }), _active_text_effects.end());
 }
 
 void InitTextEffects()
 {
 	_text_effects.clear();
 	_text_effects.shrink_to_fit();
+	_free_text_effects.clear();
+	_free_text_effects.shrink_to_fit();
+	_active_text_effects.clear();
+	_active_text_effects.shrink_to_fit();
 }
 
 void DrawTextEffects(DrawPixelInfo *dpi)
@@ -124,7 +146,8 @@ void DrawTextEffects(DrawPixelInfo *dpi)
 	/* Don't draw the text effects when zoomed out a lot */
 	if (dpi->zoom > ZOOM_LVL_OUT_8X) return;
 
-	for (TextEffect &te : _text_effects) {
+	for (TextEffectID te_id : _active_text_effects) {
+		TextEffect &te = _text_effects[te_id];
 		if (te.string_id == INVALID_STRING_ID) continue;
 		if (te.mode == TE_RISING || (_settings_client.gui.loading_indicators && !IsTransparencySet(TO_LOADING))) {
 			ViewportAddString(dpi, ZOOM_LVL_OUT_8X, &te, te.string_id, te.string_id - 1, STR_NULL, te.params_1, te.params_2);
@@ -14,6 +14,10 @@
 #include "genworld.h"
 #include "core/random_func.hpp"
 #include "landscape_type.h"
+#include "thread.h"
+
+#include <functional>
+#include <vector>
 
 #include "safeguards.h"
 
@@ -350,6 +354,41 @@ static inline height_t RandomHeight(amplitude_t rMax)
 	return A2H(RandomRange(2 * rMax + 1) - rMax);
 }
 
+/**
+ * Run a height map pass with the work divided into roughly equal slices that
+ * are processed concurrently.
+ *
+ * Only passes that do not draw random numbers and do not read data written by
+ * another slice may be run this way, so that the generated map stays identical
+ * to a sequential run of the same pass for a given seed.
+ * @param size      Total number of work items of the pass.
+ * @param min_slice Number of work items per slice below which spreading the pass over threads is not worth it.
+ * @param pass      The pass to run; called with the first (inclusive) and last (exclusive) work item to process.
+ */
+static void RunHeightMapPassInParallel(int size, int min_slice, const std::function<void(int, int)> &pass)
+{
+	uint slices = size >= 2 * min_slice ? std::min<uint>(std::thread::hardware_concurrency(), size / min_slice) : 1;
+
+	if (slices <= 1) {
+		pass(0, size);
+		return;
+	}
+
+	std::vector<std::thread> workers(slices - 1);
+	for (uint i = 1; i < slices; i++) {
+		int begin = (int)((int64)size * i / slices);
+		int end = (int)((int64)size * (i + 1) / slices);
+		if (!StartNewThread(&workers[i - 1], "ottd:tgp", [&pass, begin, end]() { pass(begin, end); })) pass(begin, end);
+	}
+
+	/* The first slice is ours to do. */
+	pass(0, (int)((int64)size / slices));
+
+	for (std::thread &worker : workers) {
+		if (worker.joinable()) worker.join();
+	}
+}
+
 /**
  * Base Perlin noise generator - fills height map with raw Perlin noise.
  *
@@ -387,25 +426,33 @@ static void HeightMapGenerate()
 		}
 
 		/* It is regular iteration round.
-		 * Interpolate height values at odd x, even y tiles */
-		for (int y = 0; y <= _height_map.size_y; y += 2 * step) {
-			for (int x = 0; x <= _height_map.size_x - 2 * step; x += 2 * step) {
-				height_t h00 = _height_map.height(x + 0 * step, y);
-				height_t h02 = _height_map.height(x + 2 * step, y);
-				height_t h01 = (h00 + h02) / 2;
-				_height_map.height(x + 1 * step, y) = h01;
+		 * Interpolate height values at odd x, even y tiles; each row only
+		 * touches its own heights, so the rows can be done concurrently. */
+		RunHeightMapPassInParallel(_height_map.size_y / (2 * step) + 1, 64, [step](int begin, int end) {
+			for (int i = begin; i < end; i++) {
+				int y = i * 2 * step;
+				for (int x = 0; x <= _height_map.size_x - 2 * step; x += 2 * step) {
+					height_t h00 = _height_map.height(x + 0 * step, y);
+					height_t h02 = _height_map.height(x + 2 * step, y);
+					height_t h01 = (h00 + h02) / 2;
+					_height_map.height(x + 1 * step, y) = h01;
+				}
 			}
-		}
+		});
 
-		/* Interpolate height values at odd y tiles */
-		for (int y = 0; y <= _height_map.size_y - 2 * step; y += 2 * step) {
-			for (int x = 0; x <= _height_map.size_x; x += step) {
-				height_t h00 = _height_map.height(x, y + 0 * step);
-				height_t h20 = _height_map.height(x, y + 2 * step);
-				height_t h10 = (h00 + h20) / 2;
-				_height_map.height(x, y + 1 * step) = h10;
+		/* Interpolate height values at odd y tiles; each row pair only reads
+		 * the even y rows completed above and writes its own odd y row. */
+		RunHeightMapPassInParallel(_height_map.size_y / (2 * step), 64, [step](int begin, int end) {
+			for (int i = begin; i < end; i++) {
+				int y = i * 2 * step;
+				for (int x = 0; x <= _height_map.size_x; x += step) {
+					height_t h00 = _height_map.height(x, y + 0 * step);
+					height_t h20 = _height_map.height(x, y + 2 * step);
+					height_t h10 = (h00 + h20) / 2;
+					_height_map.height(x, y + 1 * step) = h10;
+				}
 			}
-		}
+		});
 
 		/* Add noise for next higher frequency (smaller steps) */
 		for (int y = 0; y <= _height_map.size_y; y += step) {
@@ -456,76 +503,79 @@ static int *HeightMapMakeHistogram(height_t h_min, height_t h_max, int *hist_buf
 /** Applies sine wave redistribution onto height map */
 static void HeightMapSineTransform(height_t h_min, height_t h_max)
 {
-	for (height_t &h : _height_map.h) {
-		double fheight;
-
-		if (h < h_min) continue;
-
-		/* Transform height into 0..1 space */
-		fheight = (double)(h - h_min) / (double)(h_max - h_min);
-		/* Apply sine transform depending on landscape type */
-		switch (_settings_game.game_creation.landscape) {
-			case LT_TOYLAND:
-			case LT_TEMPERATE:
-				/* Move and scale 0..1 into -1..+1 */
-				fheight = 2 * fheight - 1;
-				/* Sine transform */
-				fheight = sin(fheight * M_PI_2);
-				/* Transform it back from -1..1 into 0..1 space */
-				fheight = 0.5 * (fheight + 1);
-				break;
-
-			case LT_ARCTIC:
-				{
-					/* Arctic terrain needs special height distribution.
-					 * Redistribute heights to have more tiles at highest (75%..100%) range */
-					double sine_upper_limit = 0.75;
-					double linear_compression = 2;
-					if (fheight >= sine_upper_limit) {
-						/* Over the limit we do linear compression up */
-						fheight = 1.0 - (1.0 - fheight) / linear_compression;
-					} else {
-						double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
-						/* Get 0..sine_upper_limit into -1..1 */
-						fheight = 2.0 * fheight / sine_upper_limit - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
-						fheight = 0.5 * (fheight + 1.0) * m;
+	RunHeightMapPassInParallel((int)_height_map.h.size(), 0x10000, [h_min, h_max](int begin, int end) {
+		for (auto it = _height_map.h.begin() + begin; it != _height_map.h.begin() + end; ++it) {
+			height_t &h = *it;
+			double fheight;
+
+			if (h < h_min) continue;
+
+			/* Transform height into 0..1 space */
+			fheight = (double)(h - h_min) / (double)(h_max - h_min);
+			/* Apply sine transform depending on landscape type */
+			switch (_settings_game.game_creation.landscape) {
+				case LT_TOYLAND:
+				case LT_TEMPERATE:
+					/* Move and scale 0..1 into -1..+1 */
+					fheight = 2 * fheight - 1;
+					/* Sine transform */
+					fheight = sin(fheight * M_PI_2);
+					/* Transform it back from -1..1 into 0..1 space */
+					fheight = 0.5 * (fheight + 1);
+					break;
+
+				case LT_ARCTIC:
+					{
+						/* Arctic terrain needs special height distribution.
+						 * Redistribute heights to have more tiles at highest (75%..100%) range */
+						double sine_upper_limit = 0.75;
+						double linear_compression = 2;
+						if (fheight >= sine_upper_limit) {
+							/* Over the limit we do linear compression up */
+							fheight = 1.0 - (1.0 - fheight) / linear_compression;
+						} else {
+							double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
+							/* Get 0..sine_upper_limit into -1..1 */
+							fheight = 2.0 * fheight / sine_upper_limit - 1.0;
+							/* Sine wave transform */
+							fheight = sin(fheight * M_PI_2);
+							/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
+							fheight = 0.5 * (fheight + 1.0) * m;
+						}
 					}
-				}
-				break;
-
-			case LT_TROPIC:
-				{
-					/* Desert terrain needs special height distribution.
-					 * Half of tiles should be at lowest (0..25%) heights */
-					double sine_lower_limit = 0.5;
-					double linear_compression = 2;
-					if (fheight <= sine_lower_limit) {
-						/* Under the limit we do linear compression down */
-						fheight = fheight / linear_compression;
-					} else {
-						double m = sine_lower_limit / linear_compression;
-						/* Get sine_lower_limit..1 into -1..1 */
-						fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
-						fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
+					break;
+
+				case LT_TROPIC:
+					{
+						/* Desert terrain needs special height distribution.
+						 * Half of tiles should be at lowest (0..25%) heights */
+						double sine_lower_limit = 0.5;
+						double linear_compression = 2;
+						if (fheight <= sine_lower_limit) {
+							/* Under the limit we do linear compression down */
+							fheight = fheight / linear_compression;
+						} else {
+							double m = sine_lower_limit / linear_compression;
+							/* Get sine_lower_limit..1 into -1..1 */
+							fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
+							/* Sine wave transform */
+							fheight = sin(fheight * M_PI_2);
+							/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
+							fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
+						}
 					}
-				}
-				break;
+					break;
 
-			default:
-				NOT_REACHED();
-				break;
+				default:
+					NOT_REACHED();
+					break;
+			}
+			/* Transform it back into h_min..h_max space */
+			h = (height_t)(fheight * (h_max - h_min) + h_min);
+			if (h < 0) h = I2H(0);
+			if (h >= h_max) h = h_max - 1;
 		}
-		/* Transform it back into h_min..h_max space */
-		h = (height_t)(fheight * (h_max - h_min) + h_min);
-		if (h < 0) h = I2H(0);
-		if (h >= h_max) h = h_max - 1;
-	}
+	});
 }
 
 /**
@@ -573,9 +623,6 @@ static void HeightMapCurves(uint level)
 		{ lengthof(curve_map_4), curve_map_4 },
 	};
 
-	height_t ht[lengthof(curve_maps)];
-	MemSetT(ht, 0, lengthof(ht));
-
 	/* Set up a grid to choose curve maps based on location; attempt to get a somewhat square grid */
 	float factor = sqrt((float)_height_map.size_x / (float)_height_map.size_y);
 	uint sx = Clamp((int)(((1 << level) * factor) + 0.5), 1, 128);
@@ -586,90 +633,96 @@ static void HeightMapCurves(uint level)
 		c[i] = Random() % lengthof(curve_maps);
 	}
 
-	/* Apply curves */
-	for (int x = 0; x < _height_map.size_x; x++) {
-
-		/* Get our X grid positions and bi-linear ratio */
-		float fx = (float)(sx * x) / _height_map.size_x + 1.0f;
-		uint x1 = (uint)fx;
-		uint x2 = x1;
-		float xr = 2.0f * (fx - x1) - 1.0f;
-		xr = sin(xr * M_PI_2);
-		xr = sin(xr * M_PI_2);
-		xr = 0.5f * (xr + 1.0f);
-		float xri = 1.0f - xr;
-
-		if (x1 > 0) {
-			x1--;
-			if (x2 >= sx) x2--;
-		}
-
-		for (int y = 0; y < _height_map.size_y; y++) {
-
-			/* Get our Y grid position and bi-linear ratio */
-			float fy = (float)(sy * y) / _height_map.size_y + 1.0f;
-			uint y1 = (uint)fy;
-			uint y2 = y1;
-			float yr = 2.0f * (fy - y1) - 1.0f;
-			yr = sin(yr * M_PI_2);
-			yr = sin(yr * M_PI_2);
-			yr = 0.5f * (yr + 1.0f);
-			float yri = 1.0f - yr;
-
-			if (y1 > 0) {
-				y1--;
-				if (y2 >= sy) y2--;
+	/* Apply curves; the per-tile work only reads the grid set up above and
+	 * writes the tile's own height, so the columns can be done concurrently. */
+	RunHeightMapPassInParallel(_height_map.size_x, 64, [&](int x_begin, int x_end) {
+		height_t ht[lengthof(curve_maps)];
+		MemSetT(ht, 0, lengthof(ht));
+
+		for (int x = x_begin; x < x_end; x++) {
+
+			/* Get our X grid positions and bi-linear ratio */
+			float fx = (float)(sx * x) / _height_map.size_x + 1.0f;
+			uint x1 = (uint)fx;
+			uint x2 = x1;
+			float xr = 2.0f * (fx - x1) - 1.0f;
+			xr = sin(xr * M_PI_2);
+			xr = sin(xr * M_PI_2);
+			xr = 0.5f * (xr + 1.0f);
+			float xri = 1.0f - xr;
+
+			if (x1 > 0) {
+				x1--;
+				if (x2 >= sx) x2--;
 			}
 
-			uint corner_a = c[x1 + sx * y1];
-			uint corner_b = c[x1 + sx * y2];
-			uint corner_c = c[x2 + sx * y1];
-			uint corner_d = c[x2 + sx * y2];
-
-			/* Bitmask of which curve maps are chosen, so that we do not bother
-			 * calculating a curve which won't be used. */
-			uint corner_bits = 0;
-			corner_bits |= 1 << corner_a;
-			corner_bits |= 1 << corner_b;
-			corner_bits |= 1 << corner_c;
-			corner_bits |= 1 << corner_d;
-
-			height_t *h = &_height_map.height(x, y);
-
-			/* Do not touch sea level */
-			if (*h < I2H(1)) continue;
-
-			/* Only scale above sea level */
-			*h -= I2H(1);
-
-			/* Apply all curve maps that are used on this tile. */
-			for (uint t = 0; t < lengthof(curve_maps); t++) {
-				if (!HasBit(corner_bits, t)) continue;
-
-				[[maybe_unused]] bool found = false;
-				const control_point_t *cm = curve_maps[t].list;
-				for (uint i = 0; i < curve_maps[t].length - 1; i++) {
-					const control_point_t &p1 = cm[i];
-					const control_point_t &p2 = cm[i + 1];
-
-					if (*h >= p1.x && *h < p2.x) {
-						ht[t] = p1.y + (*h - p1.x) * (p2.y - p1.y) / (p2.x - p1.x);
-#ifdef WITH_ASSERT
-						found = true;
-#endif
-						break;
+			for (int y = 0; y < _height_map.size_y; y++) {
+
+				/* Get our Y grid position and bi-linear ratio */
+				float fy = (float)(sy * y) / _height_map.size_y + 1.0f;
+				uint y1 = (uint)fy;
+				uint y2 = y1;
+				float yr = 2.0f * (fy - y1) - 1.0f;
+				yr = sin(yr * M_PI_2);
+				yr = sin(yr * M_PI_2);
+				yr = 0.5f * (yr + 1.0f);
+				float yri = 1.0f - yr;
+
+				if (y1 > 0) {
+					y1--;
+					if (y2 >= sy) y2--;
+				}
+
+				uint corner_a = c[x1 + sx * y1];
+				uint corner_b = c[x1 + sx * y2];
+				uint corner_c = c[x2 + sx * y1];
+				uint corner_d = c[x2 + sx * y2];
+
+				/* Bitmask of which curve maps are chosen, so that we do not bother
+				 * calculating a curve which won't be used. */
+				uint corner_bits = 0;
+				corner_bits |= 1 << corner_a;
+				corner_bits |= 1 << corner_b;
+				corner_bits |= 1 << corner_c;
+				corner_bits |= 1 << corner_d;
+
+				height_t *h = &_height_map.height(x, y);
+
+				/* Do not touch sea level */
+				if (*h < I2H(1)) continue;
+
+				/* Only scale above sea level */
+				*h -= I2H(1);
+
+				/* Apply all curve maps that are used on this tile. */
+				for (uint t = 0; t < lengthof(curve_maps); t++) {
+					if (!HasBit(corner_bits, t)) continue;
+
+					[[maybe_unused]] bool found = false;
+					const control_point_t *cm = curve_maps[t].list;
+					for (uint i = 0; i < curve_maps[t].length - 1; i++) {
+						const control_point_t &p1 = cm[i];
+						const control_point_t &p2 = cm[i + 1];
+
+						if (*h >= p1.x && *h < p2.x) {
+							ht[t] = p1.y + (*h - p1.x) * (p2.y - p1.y) / (p2.x - p1.x);
+	#ifdef WITH_ASSERT
+							found = true;
+	#endif
+							break;
+						}
 					}
+					assert(found);
 				}
-				assert(found);
-			}
 
-			/* Apply interpolation of curve map results. */
-			*h = (height_t)((ht[corner_a] * yri + ht[corner_b] * yr) * xri + (ht[corner_c] * yri + ht[corner_d] * yr) * xr);
+				/* Apply interpolation of curve map results. */
+				*h = (height_t)((ht[corner_a] * yri + ht[corner_b] * yr) * xri + (ht[corner_c] * yri + ht[corner_d] * yr) * xr);
 
-			/* Readd sea level */
-			*h += I2H(1);
+				/* Readd sea level */
+				*h += I2H(1);
+			}
 		}
-	}
+	});
 }
 
 /** Adjusts heights in height map to contain required amount of water tiles */
@@ -701,13 +754,16 @@ static void HeightMapAdjustWaterLevel(amplitude_t water_percent, height_t h_max_
 	 *   values from range: h_water_level..h_max are transformed into 0..h_max_new
 	 *   where h_max_new is depending on terrain type and map size.
 	 */
-	for (height_t &h : _height_map.h) {
-		/* Transform height from range h_water_level..h_max into 0..h_max_new range */
-		h = (height_t)(((int)h_max_new) * (h - h_water_level) / (h_max - h_water_level)) + I2H(1);
-		/* Make sure all values are in the proper range (0..h_max_new) */
-		if (h < 0) h = I2H(0);
-		if (h >= h_max_new) h = h_max_new - 1;
-	}
+	RunHeightMapPassInParallel((int)_height_map.h.size(), 0x10000, [h_water_level, h_max, h_max_new](int begin, int end) {
+		for (auto it = _height_map.h.begin() + begin; it != _height_map.h.begin() + end; ++it) {
+			height_t &h = *it;
+			/* Transform height from range h_water_level..h_max into 0..h_max_new range */
+			h = (height_t)(((int)h_max_new) * (h - h_water_level) / (h_max - h_water_level)) + I2H(1);
+			/* Make sure all values are in the proper range (0..h_max_new) */
+			if (h < 0) h = I2H(0);
+			if (h >= h_max_new) h = h_max_new - 1;
+		}
+	});
 
 	free(hist_buf);
 }
@@ -51,12 +51,11 @@ static Slope GetTileSlopeGivenHeight(int hnorth, int hwest, int heast, int hsout
 }
 
 /**
- * Return the slope of a given tile inside the map.
- * @param tile Tile to compute slope of
- * @param h    If not \c nullptr, pointer to storage of z height
- * @return Slope of the tile, except for the HALFTILE part
+ * Recompute the cached slope and extreme heights of the given tile from
+ * the heights of its four corners.
+ * @param tile Tile to update the cache entry of.
  */
-Slope GetTileSlope(TileIndex tile, int *h)
+static void UpdateTileSlopeCacheEntry(TileIndex tile)
 {
 	uint x1 = TileX(tile);
 	uint y1 = TileY(tile);
@@ -68,7 +67,43 @@ Slope GetTileSlope(TileIndex tile, int *h)
 	int heast  = TileHeight(TileXY(x1, y2)); // Height of the East corner.
 	int hsouth = TileHeight(TileXY(x2, y2)); // Height of the South corner.
 
-	return GetTileSlopeGivenHeight(hnorth, hwest, heast, hsouth, h);
+	int h;
+	Slope s = GetTileSlopeGivenHeight(hnorth, hwest, heast, hsouth, &h);
+
+	TileSlopeCache &tsc = _ts[tile];
+	tsc.slope = s;
+	tsc.min_z = h;
+	tsc.max_z = std::max({hnorth, hwest, heast, hsouth});
+}
+
+/**
+ * Update the slope cache of all tiles that share the given corner.
+ * Called by SetTileHeight() after a corner height changed.
+ * @param tile Tile whose northern corner changed height.
+ */
+void UpdateTileSlopeCacheAround(TileIndex tile)
+{
+	uint x = TileX(tile);
+	uint y = TileY(tile);
+
+	/* The northern corner of a tile is also the western, eastern or
+	 * southern corner of its up to three northern neighbours. */
+	UpdateTileSlopeCacheEntry(tile);
+	if (x > 0) UpdateTileSlopeCacheEntry(TileXY(x - 1, y));
+	if (y > 0) UpdateTileSlopeCacheEntry(TileXY(x, y - 1));
+	if (x > 0 && y > 0) UpdateTileSlopeCacheEntry(TileXY(x - 1, y - 1));
+}
+
+/**
+ * Rebuild the slope cache of the whole map. Needed after the tile heights
+ * were written directly, i.e. without going through SetTileHeight(), as
+ * happens when loading a savegame.
+ */
+void InitializeTileSlopeCache()
+{
+	for (TileIndex tile = 0; tile < Map::Size(); tile++) {
+		UpdateTileSlopeCacheEntry(tile);
+	}
 }
 
 /**
@@ -90,65 +125,3 @@ Slope GetTilePixelSlopeOutsideMap(int x, int y, int *h)
 	if (h != nullptr) *h *= TILE_HEIGHT;
 	return s;
 }
-
-/**
- * Check if a given tile is flat
- * @param tile Tile to check
- * @param h If not \c nullptr, pointer to storage of z height (only if tile is flat)
- * @return Whether the tile is flat
- */
-bool IsTileFlat(TileIndex tile, int *h)
-{
-	uint x1 = TileX(tile);
-	uint y1 = TileY(tile);
-	uint x2 = std::min(x1 + 1, Map::MaxX());
-	uint y2 = std::min(y1 + 1, Map::MaxY());
-
-	uint z = TileHeight(tile);
-	if (TileHeight(TileXY(x2, y1)) != z) return false;
-	if (TileHeight(TileXY(x1, y2)) != z) return false;
-	if (TileHeight(TileXY(x2, y2)) != z) return false;
-
-	if (h != nullptr) *h = z;
-	return true;
-}
-
-/**
- * Get bottom height of the tile
- * @param tile Tile to compute height of
- * @return Minimum height of the tile
- */
-int GetTileZ(TileIndex tile)
-{
-	uint x1 = TileX(tile);
-	uint y1 = TileY(tile);
-	uint x2 = std::min(x1 + 1, Map::MaxX());
-	uint y2 = std::min(y1 + 1, Map::MaxY());
-
-	return std::min({
-		TileHeight(tile),           // N corner
-		TileHeight(TileXY(x2, y1)), // W corner
-		TileHeight(TileXY(x1, y2)), // E corner
-		TileHeight(TileXY(x2, y2)), // S corner
-	});
-}
-
-/**
- * Get top height of the tile inside the map.
- * @param t Tile to compute height of
- * @return Maximum height of the tile
- */
-int GetTileMaxZ(TileIndex t)
-{
-	uint x1 = TileX(t);
-	uint y1 = TileY(t);
-	uint x2 = std::min(x1 + 1, Map::MaxX());
-	uint y2 = std::min(y1 + 1, Map::MaxY());
-
-	return std::max({
-		TileHeight(t),              // N corner
-		TileHeight(TileXY(x2, y1)), // W corner
-		TileHeight(TileXY(x1, y2)), // E corner
-		TileHeight(TileXY(x2, y2)), // S corner
-	});
-}
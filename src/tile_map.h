@@ -29,7 +29,7 @@
 debug_inline static uint TileHeight(TileIndex tile)
 {
 	assert(tile < Map::Size());
-	return _m[tile].height;
+	return _mb[tile].height;
 }
 
 /**
@@ -44,10 +44,14 @@ static inline uint TileHeightOutsideMap(int x, int y)
 	return TileHeight(TileXY(Clamp(x, 0, Map::MaxX()), Clamp(y, 0, Map::MaxY())));
 }
 
+void UpdateTileSlopeCacheAround(TileIndex tile);
+void InitializeTileSlopeCache();
+
 /**
  * Sets the height of a tile.
  *
- * This function sets the height of the northern corner of a tile.
+ * This function sets the height of the northern corner of a tile
+ * and updates the slope cache of the tiles sharing that corner.
  *
  * @param tile The tile to change the height
  * @param height The new height value of the tile
@@ -58,7 +62,8 @@ static inline void SetTileHeight(TileIndex tile, uint height)
 {
 	assert(tile < Map::Size());
 	assert(height <= MAX_TILE_HEIGHT);
-	_m[tile].height = height;
+	_mb[tile].height = height;
+	UpdateTileSlopeCacheAround(tile);
 }
 
 /**
@@ -96,7 +101,7 @@ static inline uint TilePixelHeightOutsideMap(int x, int y)
 debug_inline static TileType GetTileType(TileIndex tile)
 {
 	assert(tile < Map::Size());
-	return (TileType)GB(_m[tile].type, 4, 4);
+	return (TileType)GB(_mb[tile].type, 4, 4);
 }
 
 /**
@@ -135,7 +140,7 @@ static inline void SetTileType(TileIndex tile, TileType type)
 	 * edges of the map. If _settings_game.construction.freeform_edges is true,
 	 * the upper edges of the map are also VOID tiles. */
 	assert(IsInnerTile(tile) == (type != MP_VOID));
-	SB(_m[tile].type, 4, 4, type);
+	SB(_mb[tile].type, 4, 4, type);
 }
 
 /**
@@ -226,7 +231,7 @@ static inline void SetTropicZone(TileIndex tile, TropicZone type)
 {
 	assert(tile < Map::Size());
 	assert(!IsTileType(tile, MP_VOID) || type == TROPICZONE_NORMAL);
-	SB(_m[tile].type, 0, 2, type);
+	SB(_mb[tile].type, 0, 2, type);
 }
 
 /**
@@ -238,7 +243,7 @@ static inline void SetTropicZone(TileIndex tile, TropicZone type)
 static inline TropicZone GetTropicZone(TileIndex tile)
 {
 	assert(tile < Map::Size());
-	return (TropicZone)GB(_m[tile].type, 0, 2);
+	return (TropicZone)GB(_mb[tile].type, 0, 2);
 }
 
 /**
@@ -265,11 +270,54 @@ static inline void SetAnimationFrame(TileIndex t, byte frame)
 	_me[t].m7 = frame;
 }
 
-Slope GetTileSlope(TileIndex tile, int *h = nullptr);
-int GetTileZ(TileIndex tile);
-int GetTileMaxZ(TileIndex tile);
+/**
+ * Return the slope of a given tile inside the map.
+ * @param tile Tile to compute slope of
+ * @param h    If not \c nullptr, pointer to storage of z height
+ * @return Slope of the tile, except for the HALFTILE part
+ */
+static inline Slope GetTileSlope(TileIndex tile, int *h = nullptr)
+{
+	assert(tile < Map::Size());
+	if (h != nullptr) *h = _ts[tile].min_z;
+	return (Slope)_ts[tile].slope;
+}
 
-bool IsTileFlat(TileIndex tile, int *h = nullptr);
+/**
+ * Get bottom height of the tile
+ * @param tile Tile to compute height of
+ * @return Minimum height of the tile
+ */
+static inline int GetTileZ(TileIndex tile)
+{
+	assert(tile < Map::Size());
+	return _ts[tile].min_z;
+}
+
+/**
+ * Get top height of the tile inside the map.
+ * @param tile Tile to compute height of
+ * @return Maximum height of the tile
+ */
+static inline int GetTileMaxZ(TileIndex tile)
+{
+	assert(tile < Map::Size());
+	return _ts[tile].max_z;
+}
+
+/**
+ * Check if a given tile is flat
+ * @param tile Tile to check
+ * @param h If not \c nullptr, pointer to storage of z height (only if tile is flat)
+ * @return Whether the tile is flat
+ */
+static inline bool IsTileFlat(TileIndex tile, int *h = nullptr)
+{
+	assert(tile < Map::Size());
+	if (_ts[tile].slope != SLOPE_FLAT) return false;
+	if (h != nullptr) *h = _ts[tile].min_z;
+	return true;
+}
 
 /**
  * Return the slope of a given tile
@@ -65,6 +65,7 @@ static void ChangeTimetable(Vehicle *v, VehicleOrderID order_number, uint16 val,
 				case MTF_WAIT_TIME:
 					v->current_order.SetWaitTime(val);
 					v->current_order.SetWaitTimetabled(timetabled);
+					v->idle_ticks = 0;
 					break;
 
 				case MTF_TRAVEL_TIME:
@@ -223,6 +224,7 @@ CommandCost CmdSetVehicleOnTime(DoCommandFlag flags, VehicleID veh)
 
 	if (flags & DC_EXEC) {
 		v->lateness_counter = 0;
+		v->idle_ticks = 0;
 		SetWindowDirty(WC_VEHICLE_TIMETABLE, v->index);
 	}
 
@@ -314,6 +316,7 @@ CommandCost CmdSetTimetableStart(DoCommandFlag flags, VehicleID veh_id, bool tim
 		for (Vehicle *w : vehs) {
 
 			w->lateness_counter = 0;
+			w->idle_ticks = 0;
 			ClrBit(w->vehicle_flags, VF_TIMETABLE_STARTED);
 			/* Do multiplication, then division to reduce rounding errors. */
 			w->timetable_start = start_date + idx * total_duration / num_vehs / DAY_TICKS;
@@ -358,6 +361,7 @@ CommandCost CmdAutofillTimetable(DoCommandFlag flags, VehicleID veh, bool autofi
 
 			v->timetable_start = 0;
 			v->lateness_counter = 0;
+			v->idle_ticks = 0;
 		} else {
 			ClrBit(v->vehicle_flags, VF_AUTOFILL_TIMETABLE);
 			ClrBit(v->vehicle_flags, VF_AUTOFILL_PRES_WAIT_TIME);
@@ -393,10 +397,7 @@ void UpdateVehicleTimetable(Vehicle *v, bool travelling)
 	Order *real_current_order = v->GetOrder(v->cur_real_order_index);
 	assert(real_current_order != nullptr);
 
-	VehicleOrderID first_manual_order = 0;
-	for (Order *o = v->GetFirstOrder(); o != nullptr && o->IsType(OT_IMPLICIT); o = o->next) {
-		++first_manual_order;
-	}
+	VehicleOrderID first_manual_order = v->orders->GetFirstManualOrderIndex();
 
 	bool just_started = false;
 
@@ -33,6 +33,7 @@
 #include "string_func.h"
 #include "newgrf_cargo.h"
 #include "cheat_type.h"
+#include "state_checksum.h"
 #include "animated_tile_func.h"
 #include "date_func.h"
 #include "subsidy_func.h"
@@ -158,6 +159,7 @@ Town::~Town()
 void Town::PostDestructor(size_t index)
 {
 	InvalidateWindowData(WC_TOWN_DIRECTORY, 0, TDIWD_FORCE_REBUILD);
+	InvalidateTownNameIndex();
 	UpdateNearestTownForRoadTiles(false);
 
 	/* Give objects a new home! */
@@ -428,6 +430,8 @@ void ClearAllTownCachedNames()
 	for (Town *t : Town::Iterate()) {
 		t->cached_name.clear();
 	}
+
+	InvalidateTownNameIndex();
 }
 
 /**
@@ -438,6 +442,7 @@ void ClearAllTownCachedNames()
 static void ChangePopulation(Town *t, int mod)
 {
 	t->cache.population += mod;
+	_state_checksums.UpdateTown(t->index ^ t->cache.population);
 	InvalidateWindowData(WC_TOWN_VIEW, t->index); // Cargo requirements may appear/vanish for small populations
 	if (_settings_client.gui.population_in_label) t->UpdateVirtCoord();
 
@@ -466,13 +471,15 @@ uint32 GetWorldPopulation()
 static void RemoveNearbyStations(Town *t, TileIndex tile, BuildingFlags flags)
 {
 	for (StationList::iterator it = t->stations_near.begin(); it != t->stations_near.end(); /* incremented inside loop */) {
-		const Station *st = *it;
+		Station *st = *it;
 
 		bool covers_area = st->TileIsInCatchment(tile);
 		if (flags & BUILDING_2_TILES_Y)   covers_area |= st->TileIsInCatchment(tile + TileDiffXY(0, 1));
 		if (flags & BUILDING_2_TILES_X)   covers_area |= st->TileIsInCatchment(tile + TileDiffXY(1, 0));
 		if (flags & BUILDING_HAS_4_TILES) covers_area |= st->TileIsInCatchment(tile + TileDiffXY(1, 1));
 
+		if (covers_area) st->acceptance_dirty = true;
+
 		if (covers_area && !st->CatchmentCoversTown(t->index)) {
 			it = t->stations_near.erase(it);
 		} else {
@@ -824,6 +831,7 @@ static void TownTickHandler(Town *t)
 				/* If growth failed wait a bit before retrying */
 				i = std::min<uint16>(t->growth_rate, TOWN_GROWTH_TICKS - 1);
 			}
+			_state_checksums.UpdateTown(t->index ^ (uint32)i << 16);
 		}
 		t->grow_counter = i;
 	}
@@ -1883,6 +1891,7 @@ static void DoCreateTown(Town *t, TileIndex tile, uint32 townnameparts, TownSize
 		t->townnametype = tnp.type;
 	}
 	t->townnameparts = townnameparts;
+	AddTownNameToIndex(t);
 
 	t->UpdateVirtCoord();
 	InvalidateWindowData(WC_TOWN_DIRECTORY, 0, TDIWD_FORCE_REBUILD);
@@ -2034,6 +2043,7 @@ std::tuple<CommandCost, Money, TownID> CmdFoundTown(DoCommandFlag flags, TileInd
 
 		if (t != nullptr && !text.empty()) {
 			t->name = text;
+			InvalidateTownNameIndex();
 			t->UpdateVirtCoord();
 		}
 
@@ -2236,6 +2246,13 @@ bool GenerateTowns(TownLayout layout)
 	uint32 townnameparts;
 	TownNames town_names;
 
+	/* Pre-fill the list with the names of the towns already on the map, so
+	 * checking a candidate name is a lookup in the list instead of a walk
+	 * over all towns for every candidate. */
+	for (const Town *t : Town::Iterate()) {
+		town_names.insert(t->GetCachedName());
+	}
+
 	SetGeneratingWorldProgress(GWP_TOWN, total);
 
 	/* First attempt will be made at creating the suggested number of towns.
@@ -2250,8 +2267,6 @@ bool GenerateTowns(TownLayout layout)
 		if (CreateRandomTown(20, townnameparts, TSZ_RANDOM, city, layout) != nullptr) current_number++; // If creation was successful, raise a flag.
 	} while (--total);
 
-	town_names.clear();
-
 	/* Build the town k-d tree again to make sure it's well balanced */
 	RebuildTownKdtree();
 
@@ -2259,7 +2274,7 @@ bool GenerateTowns(TownLayout layout)
 
 	/* If current_number is still zero at this point, it means that not a single town has been created.
 	 * So give it a last try, but now more aggressive */
-	if (GenerateTownName(_random, &townnameparts) &&
+	if (GenerateTownName(_random, &townnameparts, &town_names) &&
 			CreateRandomTown(10000, townnameparts, TSZ_RANDOM, _settings_game.economy.larger_towns != 0, layout) != nullptr) {
 		return true;
 	}
@@ -2337,6 +2352,7 @@ static void MakeTownHouse(TileIndex t, Town *town, byte counter, byte stage, Hou
 
 	ForAllStationsAroundTiles(TileArea(t, (size & BUILDING_2_TILES_X) ? 2 : 1, (size & BUILDING_2_TILES_Y) ? 2 : 1), [town](Station *st, TileIndex tile) {
 		town->stations_near.insert(st);
+		st->acceptance_dirty = true;
 		return true;
 	});
 }
@@ -2530,6 +2546,23 @@ static bool CheckTownBuild2x2House(TileIndex *tile, Town *t, int maxz, bool nosl
  * @param tile where the house will be built
  * @return false iff no house can be built at this tile
  */
+/** Cached list of house specs matching a town zone/landscape bitmask, see BuildTownHouse. */
+struct HouseCandidateList {
+	bool valid = false;          ///< Whether the entry has been computed.
+	std::vector<HouseID> houses; ///< House specs matching the bitmask.
+};
+
+/** House candidates per town zone and landscape; arctic above the snow line uses the first slot. */
+static HouseCandidateList _house_candidates[HZB_END][5];
+
+/** Invalidate the cached house candidate lists, e.g. when the house specs are reloaded. */
+static void InvalidateHouseCandidateCache()
+{
+	for (auto &zone : _house_candidates) {
+		for (HouseCandidateList &list : zone) list.valid = false;
+	}
+}
+
 static bool BuildTownHouse(Town *t, TileIndex tile)
 {
 	/* forbidden building here by town layout */
@@ -2554,17 +2587,31 @@ static bool BuildTownHouse(Town *t, TileIndex tile)
 	/* bits 0-4 are used
 	 * bits 11-15 are used
 	 * bits 5-10 are not used. */
+	/* The houses matching the bitmask only change when the specs are reloaded,
+	 * so they are kept cached rather than filtered out of all specs anew on
+	 * every house build attempt. */
+	HouseCandidateList &cand = _house_candidates[rad][land + 1];
+	if (!cand.valid) {
+		cand.houses.clear();
+		for (uint i = 0; i < NUM_HOUSES; i++) {
+			const HouseSpec *hs = HouseSpec::Get(i);
+
+			/* Verify that the candidate house spec matches the current tile status */
+			if ((~hs->building_availability & bitmask) != 0 || !hs->enabled || hs->grf_prop.override != INVALID_HOUSE_ID) continue;
+
+			cand.houses.push_back((HouseID)i);
+		}
+		cand.valid = true;
+	}
+
 	HouseID houses[NUM_HOUSES];
 	uint num = 0;
 	uint probs[NUM_HOUSES];
 	uint probability_max = 0;
 
 	/* Generate a list of all possible houses that can be built. */
-	for (uint i = 0; i < NUM_HOUSES; i++) {
-		const HouseSpec *hs = HouseSpec::Get(i);
-
-		/* Verify that the candidate house spec matches the current tile status */
-		if ((~hs->building_availability & bitmask) != 0 || !hs->enabled || hs->grf_prop.override != INVALID_HOUSE_ID) continue;
+	for (HouseID house : cand.houses) {
+		const HouseSpec *hs = HouseSpec::Get(house);
 
 		/* Don't let these counters overflow. Global counters are 32bit, there will never be that many houses. */
 		if (hs->class_id != HOUSE_NO_CLASS) {
@@ -2572,13 +2619,13 @@ static bool BuildTownHouse(Town *t, TileIndex tile)
 			if (t->cache.building_counts.class_count[hs->class_id] == UINT16_MAX) continue;
 		} else {
 			/* If the house has no class, check id_count instead */
-			if (t->cache.building_counts.id_count[i] == UINT16_MAX) continue;
+			if (t->cache.building_counts.id_count[house] == UINT16_MAX) continue;
 		}
 
 		uint cur_prob = hs->probability;
 		probability_max += cur_prob;
 		probs[num] = cur_prob;
-		houses[num++] = (HouseID)i;
+		houses[num++] = house;
 	}
 
 	TileIndex baseTile = tile;
@@ -2778,6 +2825,7 @@ CommandCost CmdRenameTown(DoCommandFlag flags, TownID town_id, const std::string
 
 	if (flags & DC_EXEC) {
 		t->cached_name.clear();
+		InvalidateTownNameIndex();
 		if (reset) {
 			t->name.clear();
 		} else {
@@ -2786,6 +2834,7 @@ CommandCost CmdRenameTown(DoCommandFlag flags, TownID town_id, const std::string
 
 		t->UpdateVirtCoord();
 		InvalidateWindowData(WC_TOWN_DIRECTORY, 0, TDIWD_FORCE_RESORT);
+		InvalidateWindowData(WC_INDUSTRY_DIRECTORY, 0, IDIWD_FORCE_RESORT);
 		ClearAllStationCachedNames();
 		ClearAllIndustryCachedNames();
 		UpdateAllStationVirtCoords();
@@ -3367,11 +3416,9 @@ CommandCost CmdDoTownAction(DoCommandFlag flags, TownID town_id, uint8 action)
 template <typename Func>
 static void ForAllStationsNearTown(Town *t, Func func)
 {
-	/* Ideally the search radius should be close to the actual town zone 0 radius.
-	 * The true radius is not stored or calculated anywhere, only the squared radius. */
-	/* The efficiency of this search might be improved for large towns and many stations on the map,
-	 * by using an integer square root approximation giving a value not less than the true square root. */
-	uint search_radius = t->cache.squared_town_zone_radius[0] / 2;
+	/* Only the squared town zone radius is stored; search within a radius that
+	 * is never less than the true square root of it, so no stations are missed. */
+	uint search_radius = IntSqrt(t->cache.squared_town_zone_radius[0]) + 1;
 	ForAllStationsRadius(t->xy, search_radius, [&](const Station * st) {
 		if (DistanceSquare(st->xy, t->xy) <= t->cache.squared_town_zone_radius[0]) {
 			func(st);
@@ -3818,6 +3865,8 @@ void ResetHouses()
 	memset(&_house_specs, 0, sizeof(_house_specs));
 	memcpy(&_house_specs, &_original_house_specs, sizeof(_original_house_specs));
 
+	InvalidateHouseCandidateCache();
+
 	/* Reset any overrides that have been set. */
 	_house_mngr.ResetOverride();
 }
@@ -731,7 +731,14 @@ private:
 			this->vscroll->SetCount((uint)this->towns.size()); // Update scrollbar as well.
 		}
 		/* Always sort the towns. */
-		this->towns.Sort();
+		if (this->towns.SortType() == 0 && StrNatSortKeysSupported()) {
+			/* Sorting by name collates per comparison; extract each town's collation key once instead. */
+			this->towns.SortByKey([](const Town * const &t) {
+				return std::make_pair(StrNatSortKey(t->GetCachedName()), t->index);
+			});
+		} else {
+			this->towns.Sort();
+		}
 		this->SetWidgetDirty(WID_TD_LIST); // Force repaint of the displayed towns.
 	}
 
@@ -980,8 +987,28 @@ public:
 	void OnEditboxChanged(int wid) override
 	{
 		if (wid == WID_TD_FILTER) {
+			/* When the new term only appends to the old one it can only narrow
+			 * the matches, so the towns already shown can be filtered directly
+			 * instead of rebuilding and resorting the whole directory. */
+			bool narrowing = !this->towns.NeedRebuild() && this->string_filter.IsNarrowing(this->townname_editbox.text.buf);
+
 			this->string_filter.SetFilterTerm(this->townname_editbox.text.buf);
-			this->InvalidateData(TDIWD_FORCE_REBUILD);
+
+			if (narrowing) {
+				for (auto it = this->towns.begin(); it != this->towns.end(); /* nothing */) {
+					this->string_filter.ResetState();
+					this->string_filter.AddLine((*it)->GetCachedName());
+					if (this->string_filter.GetState()) {
+						++it;
+					} else {
+						it = this->towns.erase(it);
+					}
+				}
+				this->vscroll->SetCount((uint)this->towns.size());
+				this->SetDirty();
+			} else {
+				this->InvalidateData(TDIWD_FORCE_REBUILD);
+			}
 		}
 	}
 
@@ -72,6 +72,45 @@ char *GetTownName(char *buff, const Town *t, const char *last)
 }
 
 
+static TownNames _town_name_index;          ///< Resolved names of all existing towns.
+static bool _town_name_index_valid = false; ///< Whether #_town_name_index is in sync with the town pool.
+
+/**
+ * Invalidate the index of existing town names, e.g. because a town was
+ * removed or renamed. The index is rebuilt on its next use.
+ */
+void InvalidateTownNameIndex()
+{
+	_town_name_index_valid = false;
+}
+
+/**
+ * Insert the name of a newly created town into the index of existing names.
+ * @param t the new town
+ */
+void AddTownNameToIndex(const Town *t)
+{
+	if (_town_name_index_valid) _town_name_index.insert(t->GetCachedName());
+}
+
+/**
+ * Get the set with the resolved name of every existing town, rebuilding it
+ * first when it is out of date.
+ * @return the set of used town names
+ */
+static const TownNames &GetTownNameIndex()
+{
+	if (!_town_name_index_valid) {
+		_town_name_index.clear();
+		for (const Town *t : Town::Iterate()) {
+			_town_name_index.insert(t->GetCachedName());
+		}
+		_town_name_index_valid = true;
+	}
+
+	return _town_name_index;
+}
+
 /**
  * Verifies the town name is valid and unique.
  * @param r random bits
@@ -83,7 +122,6 @@ bool VerifyTownName(uint32 r, const TownNameParams *par, TownNames *town_names)
 {
 	/* reserve space for extra unicode character and terminating '\0' */
 	char buf1[(MAX_LENGTH_TOWN_NAME_CHARS + 1) * MAX_CHAR_LENGTH];
-	char buf2[(MAX_LENGTH_TOWN_NAME_CHARS + 1) * MAX_CHAR_LENGTH];
 
 	GetTownName(buf1, par, r, lastof(buf1));
 
@@ -94,16 +132,10 @@ bool VerifyTownName(uint32 r, const TownNameParams *par, TownNames *town_names)
 		if (town_names->find(buf1) != town_names->end()) return false;
 		town_names->insert(buf1);
 	} else {
-		for (const Town *t : Town::Iterate()) {
-			/* We can't just compare the numbers since
-			 * several numbers may map to a single name. */
-			const char *buf = t->name.empty() ? nullptr : t->name.c_str();
-			if (buf == nullptr) {
-				GetTownName(buf2, t, lastof(buf2));
-				buf = buf2;
-			}
-			if (strcmp(buf1, buf) == 0) return false;
-		}
+		/* We can't just compare the numbers since several numbers may map
+		 * to a single name, so compare against the names of all towns. */
+		const TownNames &used_names = GetTownNameIndex();
+		if (used_names.find(buf1) != used_names.end()) return false;
 	}
 
 	return true;
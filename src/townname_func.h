@@ -18,5 +18,7 @@ char *GetTownName(char *buff, const TownNameParams *par, uint32 townnameparts, c
 char *GetTownName(char *buff, const Town *t, const char *last);
 bool VerifyTownName(uint32 r, const TownNameParams *par, TownNames *town_names = nullptr);
 bool GenerateTownName(Randomizer &randomizer, uint32 *townnameparts, TownNames *town_names = nullptr);
+void InvalidateTownNameIndex();
+void AddTownNameToIndex(const Town *t);
 
 #endif /* TOWNNAME_FUNC_H */
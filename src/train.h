@@ -10,6 +10,8 @@
 #ifndef TRAIN_H
 #define TRAIN_H
 
+#include <deque>
+
 #include "core/enum_type.hpp"
 
 #include "newgrf_engine.h"
@@ -65,6 +67,33 @@ int GetTrainStopLocation(StationID station_id, TileIndex tile, const Train *v, i
 
 void GetTrainSpriteSize(EngineID engine, uint &width, uint &height, int &xoffs, int &yoffs, EngineImageType image_type);
 
+/** Cached path of a train, recorded by the last pathfinder run. */
+struct TrainPathCache {
+	std::deque<Trackdir> td;    ///< Track directions of the cached path.
+	std::deque<TileIndex> tile; ///< Tiles of the cached path.
+	TileIndex dest_tile;        ///< Destination tile the path was computed for.
+
+	inline bool empty() const { return this->td.empty(); }
+
+	inline size_t size() const
+	{
+		assert(this->td.size() == this->tile.size());
+		return this->td.size();
+	}
+
+	inline void clear()
+	{
+		this->td.clear();
+		this->tile.clear();
+	}
+
+	inline void pop_front()
+	{
+		this->td.pop_front();
+		this->tile.pop_front();
+	}
+};
+
 /** Variables that are cached to improve performance and such */
 struct TrainCache {
 	/* Cached wagon override spritegroup */
@@ -86,6 +115,8 @@ struct TrainCache {
 struct Train FINAL : public GroundVehicle<Train, VEH_TRAIN> {
 	TrainCache tcache;
 
+	TrainPathCache path; ///< Cached path from the last pathfinder run.
+
 	/* Link between the two ends of a multiheaded engine */
 	Train *other_multiheaded_part;
 
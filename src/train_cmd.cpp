@@ -31,6 +31,7 @@
 #include "company_base.h"
 #include "newgrf.h"
 #include "order_backup.h"
+#include "depot_func.h"
 #include "zoom_func.h"
 #include "newgrf_debug.h"
 #include "framerate_type.h"
@@ -42,7 +43,7 @@
 
 #include "safeguards.h"
 
-static Track ChooseTrainTrack(Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool force_res, bool *got_reservation, bool mark_stuck);
+static Track ChooseTrainTrack(Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool force_res, bool *got_reservation, bool mark_stuck, const PBSTileInfo *res_origin = nullptr);
 static bool TrainCheckIfLineEnds(Train *v, bool reverse = true);
 bool TrainController(Train *v, Vehicle *nomove, bool reverse = true); // Also used in vehicle_sl.cpp.
 static TileIndex TrainApproachingCrossingTile(const Train *v);
@@ -1634,7 +1635,11 @@ void ReverseTrainSwapVeh(Train *v, int l, int r)
 		Swap(a->tile,  b->tile);
 		Swap(a->z_pos, b->z_pos);
 
+		/* SwapTrainFlags() modifies the inclination flags directly, so keep
+		 * the cached total slope resistance of the consist in sync by hand. */
+		v->gcache.cached_total_slope_resistance -= a->GetPartSlopeResistance() + b->GetPartSlopeResistance();
 		SwapTrainFlags(&a->gv_flags, &b->gv_flags);
+		v->gcache.cached_total_slope_resistance += a->GetPartSlopeResistance() + b->GetPartSlopeResistance();
 
 		UpdateStatusAfterSwap(a);
 		UpdateStatusAfterSwap(b);
@@ -1642,7 +1647,9 @@ void ReverseTrainSwapVeh(Train *v, int l, int r)
 		/* Swap GVF_GOINGUP_BIT/GVF_GOINGDOWN_BIT.
 		 * This is a little bit redundant way, a->gv_flags will
 		 * be (re)set twice, but it reduces code duplication */
+		v->gcache.cached_total_slope_resistance -= a->GetPartSlopeResistance();
 		SwapTrainFlags(&a->gv_flags, &a->gv_flags);
+		v->gcache.cached_total_slope_resistance += a->GetPartSlopeResistance();
 		UpdateStatusAfterSwap(a);
 	}
 }
@@ -1906,6 +1913,9 @@ void ReverseTrainDirection(Train *v)
 	/* Clear path reservation in front if train is not stuck. */
 	if (!HasBit(v->flags, VRF_TRAIN_STUCK)) FreeTrainTrackReservation(v);
 
+	/* The cached path leads the old direction, drop it. */
+	v->path.clear();
+
 	/* Check if we were approaching a rail/road-crossing */
 	TileIndex crossing = TrainApproachingCrossingTile(v);
 
@@ -1967,6 +1977,12 @@ void ReverseTrainDirection(Train *v)
 		if (IsRailDepotTile(v->tile) && TrackdirToExitdir(v->GetVehicleTrackdir()) == GetRailDepotDirection(v->tile)) first_tile_okay = false;
 
 		if (IsRailStationTile(v->tile)) SetRailStationPlatformReservation(v->tile, TrackdirToExitdir(v->GetVehicleTrackdir()), true);
+
+		/* A loading train can't leave before its stop is over anyway and the
+		 * platform ahead of it has just been re-reserved, so put off running
+		 * the pathfinder until it actually departs. */
+		if (v->current_order.IsType(OT_LOADING) && IsRailStationTile(v->tile) && !HasBit(v->flags, VRF_TRAIN_STUCK)) return;
+
 		if (TryPathReserve(v, false, first_tile_okay)) {
 			/* Do a look-ahead now in case our current tile was already a safe tile. */
 			CheckNextTrainTile(v);
@@ -2098,6 +2114,20 @@ static FindDepotData FindClosestTrainDepot(Train *v, int max_distance)
 	PBSTileInfo origin = FollowTrainReservation(v);
 	if (IsRailDepotTile(origin.tile)) return FindDepotData(origin.tile, 0);
 
+	/* Ask the k-d tree for the closest depot candidate first. The pathfinders
+	 * measure along track, which is never shorter than the Manhattan distance
+	 * to the closest depot of the right owner, so without a candidate close
+	 * enough there is no point in running the expensive search at all. */
+	TileIndex candidate = FindClosestDepotCandidate(origin.tile, v->owner, VEH_TRAIN);
+	if (candidate == INVALID_TILE) return FindDepotData();
+	if (max_distance > 0) {
+		/* The search may also start from the rear of the train, so the bound
+		 * has to hold for both ends. Diagonal track pieces cost half a tile,
+		 * hence the conservative half tile of penalty per tile of distance. */
+		uint dist = std::min(DistanceManhattan(origin.tile, candidate), DistanceManhattan(v->Last()->tile, candidate));
+		if (dist * (YAPF_TILE_LENGTH / 2) > (uint)max_distance) return FindDepotData();
+	}
+
 	switch (_settings_game.pf.pathfinder_for_trains) {
 		case VPF_NPF: return NPFTrainFindNearestDepot(v, max_distance);
 		case VPF_YAPF: return YapfTrainFindNearestDepot(v, max_distance);
@@ -2393,13 +2423,13 @@ static const byte _initial_tile_subcoord[6][4][3] = {
  * @param[out] final_dest Final tile of the best path found
  * @return The best track the train should follow
  */
-static Track DoTrainPathfind(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool do_track_reservation, PBSTileInfo *dest, TileIndex *final_dest)
+static Track DoTrainPathfind(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool do_track_reservation, PBSTileInfo *dest, TileIndex *final_dest, TrainPathCache *path_cache = nullptr)
 {
 	if (final_dest != nullptr) *final_dest = INVALID_TILE;
 
 	switch (_settings_game.pf.pathfinder_for_trains) {
 		case VPF_NPF: return NPFTrainChooseTrack(v, path_found, do_track_reservation, dest);
-		case VPF_YAPF: return YapfTrainChooseTrack(v, tile, enterdir, tracks, path_found, do_track_reservation, dest, final_dest);
+		case VPF_YAPF: return YapfTrainChooseTrack(v, tile, enterdir, tracks, path_found, do_track_reservation, dest, final_dest, path_cache);
 
 		default: NOT_REACHED();
 	}
@@ -2408,12 +2438,11 @@ static Track DoTrainPathfind(const Train *v, TileIndex tile, DiagDirection enter
 /**
  * Extend a train path as far as possible. Stops on encountering a safe tile,
  * another reservation or a track choice.
+ * @param origin End of the train's current reservation, as returned by FollowTrainReservation().
  * @return INVALID_TILE indicates that the reservation failed.
  */
-static PBSTileInfo ExtendTrainReservation(const Train *v, TrackBits *new_tracks, DiagDirection *enterdir)
+static PBSTileInfo ExtendTrainReservation(const Train *v, const PBSTileInfo &origin, TrackBits *new_tracks, DiagDirection *enterdir)
 {
-	PBSTileInfo origin = FollowTrainReservation(v);
-
 	CFollowTrackRail ft(v);
 
 	TileIndex tile = origin.tile;
@@ -2608,7 +2637,7 @@ public:
 };
 
 /* choose a track */
-static Track ChooseTrainTrack(Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool force_res, bool *got_reservation, bool mark_stuck)
+static Track ChooseTrainTrack(Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool force_res, bool *got_reservation, bool mark_stuck, const PBSTileInfo *res_origin)
 {
 	Track best_track = INVALID_TRACK;
 	bool do_track_reservation = _settings_game.pf.reserve_paths || force_res;
@@ -2641,7 +2670,10 @@ static Track ChooseTrainTrack(Train *v, TileIndex tile, DiagDirection enterdir,
 	PBSTileInfo   res_dest(tile, INVALID_TRACKDIR, false);
 	DiagDirection dest_enterdir = enterdir;
 	if (do_track_reservation) {
-		res_dest = ExtendTrainReservation(v, &tracks, &dest_enterdir);
+		/* TryPathReserve has just walked the reservation to find its end;
+		 * reuse that result instead of walking the whole path a second time. */
+		PBSTileInfo origin = res_origin != nullptr ? *res_origin : FollowTrainReservation(v);
+		res_dest = ExtendTrainReservation(v, origin, &tracks, &dest_enterdir);
 		if (res_dest.tile == INVALID_TILE) {
 			/* Reservation failed? */
 			if (mark_stuck) MarkTrainAsStuck(v);
@@ -2686,9 +2718,29 @@ static Track ChooseTrainTrack(Train *v, TileIndex tile, DiagDirection enterdir,
 		bool      path_found = true;
 		TileIndex new_tile = res_dest.tile;
 
-		Track next_track = DoTrainPathfind(v, new_tile, dest_enterdir, tracks, path_found, do_track_reservation, &res_dest, &final_dest);
+		Track next_track = INVALID_TRACK;
+		bool cache_hit = false;
+		if (!do_track_reservation) {
+			/* Without track reservation the pathfinder is only consulted at
+			 * choice points, so try the path recorded by the last full search
+			 * first. Tiles before the current one have been travelled already. */
+			while (!v->path.empty() && v->path.tile.front() != new_tile) v->path.pop_front();
+			if (!v->path.empty() && v->path.dest_tile == v->dest_tile) {
+				Trackdir cached_td = v->path.td.front();
+				if (HasBit(tracks, TrackdirToTrack(cached_td)) && HasTrackdir(DiagdirReachesTrackdirs(dest_enterdir), cached_td)) {
+					v->path.pop_front();
+					next_track = TrackdirToTrack(cached_td);
+					cache_hit = true;
+					/* HandlePathfindingResult() is not called here because this is not a new pathfinder result. */
+				}
+			}
+			if (!cache_hit) v->path.clear();
+		}
+		if (!cache_hit) {
+			next_track = DoTrainPathfind(v, new_tile, dest_enterdir, tracks, path_found, do_track_reservation, &res_dest, &final_dest, do_track_reservation ? nullptr : &v->path);
+			v->HandlePathfindingResult(path_found);
+		}
 		if (new_tile == tile) best_track = next_track;
-		v->HandlePathfindingResult(path_found);
 	}
 
 	/* No track reservation requested -> finished. */
@@ -2830,7 +2882,7 @@ bool TryPathReserve(Train *v, bool mark_as_stuck, bool first_tile_okay)
 	if (Rail90DegTurnDisallowed(GetTileRailType(origin.tile), GetTileRailType(new_tile))) reachable &= ~TrackCrossesTracks(TrackdirToTrack(origin.trackdir));
 
 	bool res_made = false;
-	ChooseTrainTrack(v, new_tile, exitdir, reachable, true, &res_made, mark_as_stuck);
+	ChooseTrainTrack(v, new_tile, exitdir, reachable, true, &res_made, mark_as_stuck, &origin);
 
 	if (!res_made) {
 		/* Free the depot reservation as well. */
@@ -57,6 +57,7 @@ byte _trees_tick_ctr;
 static const uint16 DEFAULT_TREE_STEPS = 1000;             ///< Default number of attempts for placing trees.
 static const uint16 DEFAULT_RAINFOREST_TREE_STEPS = 15000; ///< Default number of attempts for placing extra trees at rainforest in tropic.
 static const uint16 EDITOR_TREE_DIV = 5;                   ///< Game editor tree generation divisor factor.
+static const uint FOREST_REGION_SIZE = 64;                 ///< Edge length of the square regions used for bulk tree generation.
 
 /**
  * Tests if a tile can be converted to MP_TREES
@@ -216,11 +217,12 @@ static void PlaceTreeGroups(uint num_groups)
  *
  * @param tile The base tile to add a new tree somewhere around
  * @param height The height (like the one from the tile)
+ * @param randomizer The randomizer to draw the tree position and looks from
  */
-static void PlaceTreeAtSameHeight(TileIndex tile, int height)
+static void PlaceTreeAtSameHeight(TileIndex tile, int height, Randomizer &randomizer)
 {
 	for (uint i = 0; i < DEFAULT_TREE_STEPS; i++) {
-		uint32 r = Random();
+		uint32 r = randomizer.Next();
 		int x = GB(r, 0, 5) - 16;
 		int y = GB(r, 8, 5) - 16;
 		TileIndex cur_tile = TileAddWrap(tile, x, y);
@@ -242,55 +244,110 @@ static void PlaceTreeAtSameHeight(TileIndex tile, int height)
 }
 
 /**
- * Place some trees randomly
- *
- * This function just place some trees randomly on the map.
+ * Get the number of regions the map is split into for bulk tree generation.
+ * @return Number of #FOREST_REGION_SIZE sized regions covering the map.
  */
-void PlaceTreesRandomly()
+static uint GetTreeRegionCount()
 {
-	int i, j, ht;
-
-	i = Map::ScaleBySize(DEFAULT_TREE_STEPS);
-	if (_game_mode == GM_EDITOR) i /= EDITOR_TREE_DIV;
-	do {
-		uint32 r = Random();
-		TileIndex tile = RandomTileSeed(r);
+	return CeilDiv(Map::SizeX(), FOREST_REGION_SIZE) * CeilDiv(Map::SizeY(), FOREST_REGION_SIZE);
+}
 
-		IncreaseGeneratingWorldProgress(GWP_TREE);
+/**
+ * Fill a single region with trees by scanning its rows sequentially.
+ *
+ * The target number of trees is spread over the region with a sequential
+ * sampling scheme, so the tiles are visited in map storage order and all
+ * randomness comes from the given region randomizer.
+ *
+ * @param rx              X coordinate of the top corner of the region.
+ * @param ry              Y coordinate of the top corner of the region.
+ * @param target          Number of trees to try to place in the region.
+ * @param rainforest_only Only fill rainforest tiles, as done for the extra tropic pass.
+ * @param randomizer      Randomizer seeded for this region.
+ */
+static void PlaceTreesInRegion(uint rx, uint ry, uint target, bool rainforest_only, Randomizer &randomizer)
+{
+	uint w = std::min<uint>(FOREST_REGION_SIZE, Map::SizeX() - rx);
+	uint h = std::min<uint>(FOREST_REGION_SIZE, Map::SizeY() - ry);
+	uint tiles_left = w * h;
+
+	for (uint y = ry; y < ry + h && target > 0; y++) {
+		for (uint x = rx; x < rx + w && target > 0; x++, tiles_left--) {
+			/* Select 'target' of the remaining tiles uniformly, in row order. */
+			if (randomizer.Next(tiles_left) >= target) continue;
+			target--;
+
+			TileIndex tile = TileXY(x, y);
+			if (rainforest_only) {
+				if (GetTropicZone(tile) != TROPICZONE_RAINFOREST || !CanPlantTreesOnTile(tile, false)) continue;
+			} else if (!CanPlantTreesOnTile(tile, true)) {
+				continue;
+			}
 
-		if (CanPlantTreesOnTile(tile, true)) {
-			PlaceTree(tile, r);
-			if (_settings_game.game_creation.tree_placer != TP_IMPROVED) continue;
+			PlaceTree(tile, randomizer.Next());
+			if (rainforest_only || _settings_game.game_creation.tree_placer != TP_IMPROVED) continue;
 
 			/* Place a number of trees based on the tile height.
 			 *  This gives a cool effect of multiple trees close together.
 			 *  It is almost real life ;) */
-			ht = GetTileZ(tile);
+			int ht = GetTileZ(tile);
 			/* The higher we get, the more trees we plant */
-			j = GetTileZ(tile) * 2;
+			int j = ht * 2;
 			/* Above snowline more trees! */
 			if (_settings_game.game_creation.landscape == LT_ARCTIC && ht > GetSnowLine()) j *= 3;
 			while (j--) {
-				PlaceTreeAtSameHeight(tile, ht);
+				PlaceTreeAtSameHeight(tile, ht, randomizer);
 			}
 		}
-	} while (--i);
+	}
+}
 
-	/* place extra trees at rainforest area */
-	if (_settings_game.game_creation.landscape == LT_TROPIC) {
-		i = Map::ScaleBySize(DEFAULT_RAINFOREST_TREE_STEPS);
-		if (_game_mode == GM_EDITOR) i /= EDITOR_TREE_DIV;
+/**
+ * Spread a map wide tree budget over all regions and fill them one by one.
+ *
+ * Each region gets its proportional share of the budget and a seed drawn
+ * from the game randomizer, making the fill reproducible per region while
+ * the map is written in cache friendly row order.
+ *
+ * @param total_target    Number of trees to try to place on the whole map.
+ * @param rainforest_only Only fill rainforest tiles, as done for the extra tropic pass.
+ */
+static void PlaceTreesByRegion(uint total_target, bool rainforest_only)
+{
+	for (uint ry = 0; ry < Map::SizeY(); ry += FOREST_REGION_SIZE) {
+		for (uint rx = 0; rx < Map::SizeX(); rx += FOREST_REGION_SIZE) {
+			Randomizer randomizer;
+			randomizer.SetSeed(Random());
 
-		do {
-			uint32 r = Random();
-			TileIndex tile = RandomTileSeed(r);
+			/* Proportional share of the budget, with the fractional part
+			 * resolved by a random draw so the total is unbiased. */
+			uint64 scaled = (uint64)total_target * FOREST_REGION_SIZE * FOREST_REGION_SIZE;
+			uint target = (uint)(scaled / Map::Size());
+			if (randomizer.Next((uint32)Map::Size()) < (uint32)(scaled % Map::Size())) target++;
+
+			PlaceTreesInRegion(rx, ry, target, rainforest_only, randomizer);
 
 			IncreaseGeneratingWorldProgress(GWP_TREE);
+		}
+	}
+}
 
-			if (GetTropicZone(tile) == TROPICZONE_RAINFOREST && CanPlantTreesOnTile(tile, false)) {
-				PlaceTree(tile, r);
-			}
-		} while (--i);
+/**
+ * Place some trees randomly
+ *
+ * This function just place some trees randomly on the map.
+ */
+void PlaceTreesRandomly()
+{
+	uint target = Map::ScaleBySize(DEFAULT_TREE_STEPS);
+	if (_game_mode == GM_EDITOR) target /= EDITOR_TREE_DIV;
+	PlaceTreesByRegion(target, false);
+
+	/* place extra trees at rainforest area */
+	if (_settings_game.game_creation.landscape == LT_TROPIC) {
+		target = Map::ScaleBySize(DEFAULT_RAINFOREST_TREE_STEPS);
+		if (_game_mode == GM_EDITOR) target /= EDITOR_TREE_DIV;
+		PlaceTreesByRegion(target, true);
 	}
 }
 
@@ -365,8 +422,9 @@ void GenerateTrees()
 		default: NOT_REACHED();
 	}
 
-	total = Map::ScaleBySize(DEFAULT_TREE_STEPS);
-	if (_settings_game.game_creation.landscape == LT_TROPIC) total += Map::ScaleBySize(DEFAULT_RAINFOREST_TREE_STEPS);
+	/* Each call of PlaceTreesRandomly() reports one progress step per region and pass. */
+	total = GetTreeRegionCount();
+	if (_settings_game.game_creation.landscape == LT_TROPIC) total *= 2;
 	total *= i;
 	uint num_groups = (_settings_game.game_creation.landscape != LT_TOYLAND) ? Map::ScaleBySize(GB(Random(), 0, 5) + 25) : 0;
 	total += num_groups * DEFAULT_TREE_STEPS;
@@ -662,9 +720,10 @@ static void TileLoopTreesDesert(TileIndex tile)
 static void TileLoopTreesAlps(TileIndex tile)
 {
 	int k = GetTileZ(tile) - GetSnowLine() + 1;
+	TreeGround ground = GetTreeGround(tile);
 
 	if (k < 0) {
-		switch (GetTreeGround(tile)) {
+		switch (ground) {
 			case TREE_GROUND_SNOW_DESERT: SetTreeGroundDensity(tile, TREE_GROUND_GRASS, 3); break;
 			case TREE_GROUND_ROUGH_SNOW:  SetTreeGroundDensity(tile, TREE_GROUND_ROUGH, 3); break;
 			default: return;
@@ -672,13 +731,13 @@ static void TileLoopTreesAlps(TileIndex tile)
 	} else {
 		uint density = std::min<uint>(k, 3);
 
-		if (GetTreeGround(tile) != TREE_GROUND_SNOW_DESERT && GetTreeGround(tile) != TREE_GROUND_ROUGH_SNOW) {
-			TreeGround tg = GetTreeGround(tile) == TREE_GROUND_ROUGH ? TREE_GROUND_ROUGH_SNOW : TREE_GROUND_SNOW_DESERT;
+		if (ground != TREE_GROUND_SNOW_DESERT && ground != TREE_GROUND_ROUGH_SNOW) {
+			TreeGround tg = ground == TREE_GROUND_ROUGH ? TREE_GROUND_ROUGH_SNOW : TREE_GROUND_SNOW_DESERT;
 			SetTreeGroundDensity(tile, tg, density);
 		} else if (GetTreeDensity(tile) != density) {
-			SetTreeGroundDensity(tile, GetTreeGround(tile), density);
+			SetTreeGroundDensity(tile, ground, density);
 		} else {
-			if (GetTreeDensity(tile) == 3) {
+			if (density == 3) {
 				uint32 r = Random();
 				if (Chance16I(1, 200, r) && _settings_client.sound.ambient) {
 					SndPlayTileFx((r & 0x80000000) ? SND_39_ARCTIC_SNOW_2 : SND_34_ARCTIC_SNOW_1, tile);
@@ -723,7 +782,7 @@ static void TileLoop_Trees(TileIndex tile)
 
 	if (_settings_game.construction.extra_tree_placement == ETP_NO_GROWTH_NO_SPREAD) return;
 
-	if (GetTreeCounter(tile) < 15) {
+	if (treeCounter < 15) {
 		AddTreeCounter(tile, 1);
 		return;
 	}
@@ -15,6 +15,8 @@
 
 void MarkBridgeDirty(TileIndex begin, TileIndex end, DiagDirection direction, uint bridge_height);
 void MarkBridgeDirty(TileIndex tile);
+void NotifyBridgeTileChange(TileIndex tile);
+void ClearBridgeMiddleCache();
 
 /**
  * Calculates the length of a tunnel or a bridge (without end tiles)
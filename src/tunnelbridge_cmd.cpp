@@ -43,6 +43,9 @@
 #include "landscape_cmd.h"
 #include "terraform_cmd.h"
 
+#include <mutex>
+#include <unordered_map>
+
 #include "table/strings.h"
 #include "table/bridge_land.h"
 
@@ -552,6 +555,7 @@ CommandCost CmdBuildBridge(DoCommandFlag flags, TileIndex tile_end, TileIndex ti
 				Owner owner_tram = hastram ? GetRoadOwner(tile_start, RTT_TRAM) : company;
 				MakeRoadBridgeRamp(tile_start, owner, owner_road, owner_tram, bridge_type, dir, road_rt, tram_rt);
 				MakeRoadBridgeRamp(tile_end,   owner, owner_road, owner_tram, bridge_type, ReverseDiagDir(dir), road_rt, tram_rt);
+				YapfNotifyRoadLayoutChange(tile_start);
 				break;
 			}
 
@@ -783,6 +787,7 @@ CommandCost CmdBuildTunnel(DoCommandFlag flags, TileIndex start_tile, TransportT
 			RoadType tram_rt = RoadTypeIsTram(roadtype) ? roadtype : INVALID_ROADTYPE;
 			MakeRoadTunnel(start_tile, company, direction,                 road_rt, tram_rt);
 			MakeRoadTunnel(end_tile,   company, ReverseDiagDir(direction), road_rt, tram_rt);
+			YapfNotifyRoadLayoutChange(start_tile);
 		}
 		DirtyCompanyInfrastructureWindows(company);
 	}
@@ -911,6 +916,7 @@ static CommandCost DoClearTunnel(TileIndex tile, DoCommandFlag flags)
 
 			DoClearSquare(tile);
 			DoClearSquare(endtile);
+			YapfNotifyRoadLayoutChange(tile);
 		}
 	}
 
@@ -975,6 +981,7 @@ static CommandCost DoClearBridge(TileIndex tile, DoCommandFlag flags)
 			/* A full diagonal road tile has two road bits. */
 			UpdateCompanyRoadInfrastructure(GetRoadTypeRoad(tile), GetRoadOwner(tile, RTT_ROAD), -(int)(len * 2 * TUNNELBRIDGE_TRACKBIT_FACTOR));
 			UpdateCompanyRoadInfrastructure(GetRoadTypeTram(tile), GetRoadOwner(tile, RTT_TRAM), -(int)(len * 2 * TUNNELBRIDGE_TRACKBIT_FACTOR));
+			YapfNotifyRoadLayoutChange(tile);
 		} else { // Aqueduct
 			if (Company::IsValidID(owner)) Company::Get(owner)->infrastructure.water -= len * TUNNELBRIDGE_TRACKBIT_FACTOR;
 		}
@@ -1536,6 +1543,48 @@ static BridgePieces CalcBridgePiece(uint north, uint south)
 	}
 }
 
+/** Cached draw data of a bridge middle tile, derived from the bridge heads. */
+struct BridgeMiddleDrawData {
+	TileIndex rampnorth;          ///< Northern bridge head.
+	TileIndex rampsouth;          ///< Southern bridge head.
+	TransportType transport_type; ///< Transport type of the bridge.
+	Axis axis;                    ///< Axis of the bridge.
+	BridgePieces piece;           ///< Bridge piece to draw on this tile.
+	uint bridge_z;                ///< Pixel height of the bridge deck.
+};
+
+/**
+ * Cached draw data of bridge middle tiles. Finding the bridge heads walks the
+ * map in both directions for every drawn tile below a bridge, while the result
+ * only changes when the bridge is rebuilt; that marks all tiles below it
+ * dirty, which drops the entries via NotifyBridgeTileChange().
+ */
+static std::unordered_map<uint32, BridgeMiddleDrawData> _bridge_middle_cache;
+
+/** Protects #_bridge_middle_cache; viewport sprite collection draws tiles from several threads at once. */
+static std::mutex _bridge_middle_cache_mutex;
+
+/** Number of cached tiles above which the bridge middle cache is flushed. */
+static const size_t BRIDGE_MIDDLE_CACHE_MAX_SIZE = 1 << 16;
+
+/**
+ * Forget the cached bridge draw data of a changed tile.
+ * @param tile The tile that changed.
+ */
+void NotifyBridgeTileChange(TileIndex tile)
+{
+	std::lock_guard<std::mutex> lock(_bridge_middle_cache_mutex);
+	if (_bridge_middle_cache.empty()) return;
+	_bridge_middle_cache.erase(tile);
+}
+
+/** Forget all cached bridge middle draw data. */
+void ClearBridgeMiddleCache()
+{
+	std::lock_guard<std::mutex> lock(_bridge_middle_cache_mutex);
+	_bridge_middle_cache.clear();
+}
+
 /**
  * Draw the middle bits of a bridge.
  * @param ti Tile information of the tile to draw it on.
@@ -1560,15 +1609,41 @@ void DrawBridgeMiddle(const TileInfo *ti)
 
 	if (!IsBridgeAbove(ti->tile)) return;
 
-	TileIndex rampnorth = GetNorthernBridgeEnd(ti->tile);
-	TileIndex rampsouth = GetSouthernBridgeEnd(ti->tile);
-	TransportType transport_type = GetTunnelBridgeTransportType(rampsouth);
+	/* Work on a local copy; holding a reference into the map while other
+	 * threads insert into or flush it would not be safe. */
+	BridgeMiddleDrawData bmdd;
+	bool cached;
+	{
+		std::lock_guard<std::mutex> lock(_bridge_middle_cache_mutex);
+		if (_bridge_middle_cache.size() >= BRIDGE_MIDDLE_CACHE_MAX_SIZE) _bridge_middle_cache.clear();
+
+		auto it = _bridge_middle_cache.find(ti->tile);
+		cached = it != _bridge_middle_cache.end();
+		if (cached) bmdd = it->second;
+	}
+
+	if (!cached) {
+		/* Deriving the draw data only reads the map, so it runs outside the
+		 * lock; at worst two threads derive the same tile and one copy wins. */
+		bmdd.rampnorth = GetNorthernBridgeEnd(ti->tile);
+		bmdd.rampsouth = GetSouthernBridgeEnd(ti->tile);
+		bmdd.transport_type = GetTunnelBridgeTransportType(bmdd.rampsouth);
+		bmdd.axis = GetBridgeAxis(ti->tile);
+		bmdd.piece = CalcBridgePiece(
+			GetTunnelBridgeLength(ti->tile, bmdd.rampnorth) + 1,
+			GetTunnelBridgeLength(ti->tile, bmdd.rampsouth) + 1
+		);
+		bmdd.bridge_z = GetBridgePixelHeight(bmdd.rampsouth);
+
+		std::lock_guard<std::mutex> lock(_bridge_middle_cache_mutex);
+		_bridge_middle_cache.emplace(ti->tile, bmdd);
+	}
 
-	Axis axis = GetBridgeAxis(ti->tile);
-	BridgePieces piece = CalcBridgePiece(
-		GetTunnelBridgeLength(ti->tile, rampnorth) + 1,
-		GetTunnelBridgeLength(ti->tile, rampsouth) + 1
-	);
+	TileIndex rampnorth = bmdd.rampnorth;
+	TileIndex rampsouth = bmdd.rampsouth;
+	TransportType transport_type = bmdd.transport_type;
+	Axis axis = bmdd.axis;
+	BridgePieces piece = bmdd.piece;
 
 	const PalSpriteID *psid;
 	bool drawfarpillar;
@@ -1593,7 +1668,7 @@ void DrawBridgeMiddle(const TileInfo *ti)
 
 	int x = ti->x;
 	int y = ti->y;
-	uint bridge_z = GetBridgePixelHeight(rampsouth);
+	uint bridge_z = bmdd.bridge_z;
 	int z = bridge_z - BRIDGE_Z_START;
 
 	/* Add a bounding box that separates the bridge from things below it. */
@@ -1881,9 +1956,6 @@ extern const byte _tunnel_visibility_frame[DIAGDIR_END] = {12, 8, 8, 12};
 
 static VehicleEnterTileStatus VehicleEnter_TunnelBridge(Vehicle *v, TileIndex tile, int x, int y)
 {
-	int z = GetSlopePixelZ(x, y) - v->z_pos;
-
-	if (abs(z) > 2) return VETSB_CANNOT_ENTER;
 	/* Direction into the wormhole */
 	const DiagDirection dir = GetTunnelBridgeDirection(tile);
 	/* Direction of the vehicle */
@@ -1898,6 +1970,7 @@ static VehicleEnterTileStatus VehicleEnter_TunnelBridge(Vehicle *v, TileIndex ti
 			Train *t = Train::From(v);
 
 			if (t->track != TRACK_BIT_WORMHOLE && dir == vdir) {
+				if (abs(GetSlopePixelZ(x, y) - v->z_pos) > 2) return VETSB_CANNOT_ENTER;
 				if (t->IsFrontEngine() && frame == TUNNEL_SOUND_FRAME) {
 					if (!PlayVehicleSound(t, VSE_TUNNEL) && RailVehInfo(t->engine_type)->engclass == 0) {
 						SndPlayVehicleFx(SND_05_TRAIN_THROUGH_TUNNEL, v);
@@ -1912,7 +1985,7 @@ static VehicleEnterTileStatus VehicleEnter_TunnelBridge(Vehicle *v, TileIndex ti
 				}
 			}
 
-			if (dir == ReverseDiagDir(vdir) && frame == TILE_SIZE - _tunnel_visibility_frame[dir] && z == 0) {
+			if (dir == ReverseDiagDir(vdir) && frame == TILE_SIZE - _tunnel_visibility_frame[dir] && GetSlopePixelZ(x, y) == v->z_pos) {
 				/* We're at the tunnel exit ?? */
 				t->tile = tile;
 				t->track = DiagDirToDiagTrackBits(vdir);
@@ -1925,6 +1998,7 @@ static VehicleEnterTileStatus VehicleEnter_TunnelBridge(Vehicle *v, TileIndex ti
 
 			/* Enter tunnel? */
 			if (rv->state != RVSB_WORMHOLE && dir == vdir) {
+				if (abs(GetSlopePixelZ(x, y) - v->z_pos) > 2) return VETSB_CANNOT_ENTER;
 				if (frame == _tunnel_visibility_frame[dir]) {
 					/* Frame should be equal to the next frame number in the RV's movement */
 					assert(frame == rv->frame + 1);
@@ -1938,7 +2012,7 @@ static VehicleEnterTileStatus VehicleEnter_TunnelBridge(Vehicle *v, TileIndex ti
 			}
 
 			/* We're at the tunnel exit ?? */
-			if (dir == ReverseDiagDir(vdir) && frame == TILE_SIZE - _tunnel_visibility_frame[dir] && z == 0) {
+			if (dir == ReverseDiagDir(vdir) && frame == TILE_SIZE - _tunnel_visibility_frame[dir] && GetSlopePixelZ(x, y) == v->z_pos) {
 				rv->tile = tile;
 				rv->state = DiagDirToDiagTrackdir(vdir);
 				rv->frame = frame;
@@ -1947,6 +2021,10 @@ static VehicleEnterTileStatus VehicleEnter_TunnelBridge(Vehicle *v, TileIndex ti
 			}
 		}
 	} else { // IsBridge(tile)
+		/* Without this check a vehicle above the ramp, e.g. on a crossing
+		 * bridge, would have its speed clamped to this bridge's limit. */
+		if (abs(GetSlopePixelZ(x, y) - v->z_pos) > 2) return VETSB_CANNOT_ENTER;
+
 		if (v->type != VEH_SHIP) {
 			/* modify speed of vehicle */
 			uint16 spd = GetBridgeSpec(GetBridgeType(tile))->speed;
@@ -1963,8 +2041,7 @@ static VehicleEnterTileStatus VehicleEnter_TunnelBridge(Vehicle *v, TileIndex ti
 				case VEH_TRAIN: {
 					Train *t = Train::From(v);
 					t->track = TRACK_BIT_WORMHOLE;
-					ClrBit(t->gv_flags, GVF_GOINGUP_BIT);
-					ClrBit(t->gv_flags, GVF_GOINGDOWN_BIT);
+					t->ClearInclination();
 					break;
 				}
 
@@ -1972,8 +2049,7 @@ static VehicleEnterTileStatus VehicleEnter_TunnelBridge(Vehicle *v, TileIndex ti
 					RoadVehicle *rv = RoadVehicle::From(v);
 					rv->state = RVSB_WORMHOLE;
 					/* There are no slopes inside bridges / tunnels. */
-					ClrBit(rv->gv_flags, GVF_GOINGUP_BIT);
-					ClrBit(rv->gv_flags, GVF_GOINGDOWN_BIT);
+					rv->ClearInclination();
 					break;
 				}
 
@@ -14,6 +14,7 @@
 #include "spritecache.h"
 #include "timetable.h"
 #include "viewport_func.h"
+#include "state_checksum.h"
 #include "news_func.h"
 #include "command_func.h"
 #include "company_func.h"
@@ -265,6 +266,7 @@ uint Vehicle::Crash(bool flooded)
 	uint pass = 0;
 	/* Stop the vehicle. */
 	if (this->IsPrimaryVehicle()) this->vehstatus |= VS_STOPPED;
+	this->idle_ticks = 0;
 	/* crash all wagons, and count passengers */
 	for (Vehicle *v = this; v != nullptr; v = v->Next()) {
 		/* We do not transfer reserver cargo back, so TotalCount() instead of StoredCount() */
@@ -365,32 +367,41 @@ byte VehicleRandomBits()
 	return GB(Random(), 0, 8);
 }
 
-/* Size of the hash, 6 = 64 x 64, 7 = 128 x 128. Larger sizes will (in theory) reduce hash
- * lookup times at the expense of memory usage. */
-const int HASH_BITS = 7;
-const int HASH_SIZE = 1 << HASH_BITS;
-const int HASH_MASK = HASH_SIZE - 1;
-const int TOTAL_HASH_SIZE = 1 << (HASH_BITS * 2);
-const int TOTAL_HASH_MASK = TOTAL_HASH_SIZE - 1;
+/* Maximum size of the tile hash per axis, 9 = 512 x 512 cells. Larger sizes will (in theory)
+ * reduce hash lookup times at the expense of memory usage. */
+const int MAX_HASH_BITS = 9;
 
-/* Resolution of the hash, 0 = 1*1 tile, 1 = 2*2 tiles, 2 = 4*4 tiles, etc.
- * Profiling results show that 0 is fastest. */
-const int HASH_RES = 0;
+/* Dimensions of the tile hash, set from the map size by ResetVehicleHash(). Each axis is
+ * split into 2^_hash_bits_<axis> cells of 2^_hash_res_<axis> tiles. The grid covers the
+ * whole map, so unlike a wrapping hash distant tiles never share a chain. */
+static int _hash_bits_x;
+static int _hash_bits_y;
+static int _hash_res_x;
+static int _hash_res_y;
 
-static Vehicle *_vehicle_tile_hash[TOTAL_HASH_SIZE];
+static std::vector<Vehicle *> _vehicle_tile_hash;
+
+/**
+ * Get the tile hash cell of the given tile coordinates.
+ * @param x X coordinate of the tile.
+ * @param y Y coordinate of the tile.
+ * @return Head of the cell's vehicle chain.
+ */
+static Vehicle **VehicleTileHashCell(uint x, uint y)
+{
+	return &_vehicle_tile_hash[GB(x, _hash_res_x, _hash_bits_x) + (GB(y, _hash_res_y, _hash_bits_y) << _hash_bits_x)];
+}
 
 static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, void *data, VehicleFromPosProc *proc, bool find_first)
 {
-	for (int y = yl; ; y = (y + (1 << HASH_BITS)) & (HASH_MASK << HASH_BITS)) {
-		for (int x = xl; ; x = (x + 1) & HASH_MASK) {
-			Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+	for (int y = yl; y <= yu; y++) {
+		for (int x = xl; x <= xu; x++) {
+			Vehicle *v = _vehicle_tile_hash[x + (y << _hash_bits_x)];
 			for (; v != nullptr; v = v->hash_tile_next) {
 				Vehicle *a = proc(v, data);
 				if (find_first && a != nullptr) return a;
 			}
-			if (x == xu) break;
 		}
-		if (y == yu) break;
 	}
 
 	return nullptr;
@@ -412,11 +423,11 @@ static Vehicle *VehicleFromPosXY(int x, int y, void *data, VehicleFromPosProc *p
 {
 	const int COLL_DIST = 6;
 
-	/* Hash area to scan is from xl,yl to xu,yu */
-	int xl = GB((x - COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS);
-	int xu = GB((x + COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS);
-	int yl = GB((y - COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
-	int yu = GB((y + COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
+	/* Hash cell area to scan is from xl,yl to xu,yu; the grid does not wrap, so clamp to the map. */
+	int xl = Clamp((x - COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxX()) >> _hash_res_x;
+	int xu = Clamp((x + COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxX()) >> _hash_res_x;
+	int yl = Clamp((y - COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxY()) >> _hash_res_y;
+	int yu = Clamp((y + COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxY()) >> _hash_res_y;
 
 	return VehicleFromTileHash(xl, yl, xu, yu, data, proc, find_first);
 }
@@ -468,10 +479,7 @@ bool HasVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
  */
 static Vehicle *VehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *proc, bool find_first)
 {
-	int x = GB(TileX(tile), HASH_RES, HASH_BITS);
-	int y = GB(TileY(tile), HASH_RES, HASH_BITS) << HASH_BITS;
-
-	Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+	Vehicle *v = *VehicleTileHashCell(TileX(tile), TileY(tile));
 	for (; v != nullptr; v = v->hash_tile_next) {
 		if (v->tile != tile) continue;
 
@@ -515,6 +523,110 @@ bool HasVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
 	return VehicleFromPos(tile, data, proc, true) != nullptr;
 }
 
+/* Road vehicles keep an own tile hash next to the generic one, so that the
+ * frequent road vehicle proximity checks (following distance, overtaking) do
+ * not have to walk past trains and other vehicle types sharing the cells. */
+static std::vector<RoadVehicle *> _road_vehicle_tile_hash;
+
+/**
+ * Get the road vehicle tile hash cell of the given tile coordinates.
+ * @param x X coordinate of the tile.
+ * @param y Y coordinate of the tile.
+ * @return Head of the cell's road vehicle chain.
+ */
+static RoadVehicle **RoadVehicleTileHashCell(uint x, uint y)
+{
+	return &_road_vehicle_tile_hash[GB(x, _hash_res_x, _hash_bits_x) + (GB(y, _hash_res_y, _hash_bits_y) << _hash_bits_x)];
+}
+
+static Vehicle *RoadVehicleFromTileHash(int xl, int yl, int xu, int yu, void *data, VehicleFromPosProc *proc, bool find_first)
+{
+	for (int y = yl; y <= yu; y++) {
+		for (int x = xl; x <= xu; x++) {
+			RoadVehicle *v = _road_vehicle_tile_hash[x + (y << _hash_bits_x)];
+			for (; v != nullptr; v = v->hash_road_next) {
+				Vehicle *a = proc(v, data);
+				if (find_first && a != nullptr) return a;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * Find a road vehicle close to a specific location. Iterates the same cells as
+ * #FindVehicleOnPosXY, but only over the road vehicles in them.
+ * @note The same ordering requirements as for #FindVehicleOnPosXY apply.
+ * @param x    The X location on the map
+ * @param y    The Y location on the map
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The proc that determines whether a vehicle will be "found".
+ */
+void FindRoadVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
+{
+	const int COLL_DIST = 6;
+
+	/* Hash cell area to scan is from xl,yl to xu,yu; the grid does not wrap, so clamp to the map. */
+	int xl = Clamp((x - COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxX()) >> _hash_res_x;
+	int xu = Clamp((x + COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxX()) >> _hash_res_x;
+	int yl = Clamp((y - COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxY()) >> _hash_res_y;
+	int yu = Clamp((y + COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxY()) >> _hash_res_y;
+
+	RoadVehicleFromTileHash(xl, yl, xu, yu, data, proc, false);
+}
+
+/**
+ * Helper function for FindRoadVehicleOnPos/HasRoadVehicleOnPos.
+ * @note Do not call this function directly!
+ * @param tile The location on the map
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The proc that determines whether a vehicle will be "found".
+ * @param find_first Whether to return on the first found or iterate over
+ *                   all vehicles
+ * @return the best matching or first vehicle (depending on find_first).
+ */
+static Vehicle *RoadVehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *proc, bool find_first)
+{
+	RoadVehicle *v = *RoadVehicleTileHashCell(TileX(tile), TileY(tile));
+	for (; v != nullptr; v = v->hash_road_next) {
+		if (v->tile != tile) continue;
+
+		Vehicle *a = proc(v, data);
+		if (find_first && a != nullptr) return a;
+	}
+
+	return nullptr;
+}
+
+/**
+ * Find a road vehicle from a specific location. Iterates the road vehicles on
+ * the tile only; otherwise behaves like #FindVehicleOnPos.
+ * @note The same ordering requirements as for #FindVehicleOnPos apply.
+ * @param tile The location on the map
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The proc that determines whether a vehicle will be "found".
+ */
+void FindRoadVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
+{
+	RoadVehicleFromPos(tile, data, proc, false);
+}
+
+/**
+ * Checks whether a road vehicle is on a specific location. It will call \a proc
+ * for road vehicles until it returns non-nullptr.
+ * @note Use #FindRoadVehicleOnPos when you have the intention that all road
+ *       vehicles should be iterated over.
+ * @param tile The location on the map
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The \a proc that determines whether a vehicle will be "found".
+ * @return True if proc returned non-nullptr.
+ */
+bool HasRoadVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
+{
+	return RoadVehicleFromPos(tile, data, proc, true) != nullptr;
+}
+
 /**
  * Callback that returns 'real' vehicles lower or at height \c *(int*)data .
  * @param v Vehicle to examine.
@@ -609,17 +721,49 @@ CommandCost EnsureNoTrainOnTrackBits(TileIndex tile, TrackBits track_bits)
 	return CommandCost();
 }
 
+static void UpdateRoadVehicleTileHash(RoadVehicle *v, bool remove)
+{
+	RoadVehicle **old_hash = v->hash_road_current;
+	RoadVehicle **new_hash = remove ? nullptr : RoadVehicleTileHashCell(TileX(v->tile), TileY(v->tile));
+
+	if (old_hash == new_hash) return;
+
+	/* Remove from the old position in the hash table */
+	if (old_hash != nullptr) {
+		if (v->hash_road_next != nullptr) v->hash_road_next->hash_road_prev = v->hash_road_prev;
+		*v->hash_road_prev = v->hash_road_next;
+	}
+
+	/* Insert vehicle at beginning of the new position in the hash table */
+	if (new_hash != nullptr) {
+		v->hash_road_next = *new_hash;
+		if (v->hash_road_next != nullptr) v->hash_road_next->hash_road_prev = &v->hash_road_next;
+		v->hash_road_prev = new_hash;
+		*new_hash = v;
+	}
+
+	/* Remember current hash position */
+	v->hash_road_current = new_hash;
+}
+
 static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 {
+	if (v->type == VEH_ROAD) UpdateRoadVehicleTileHash(RoadVehicle::From(v), remove);
+
+	/* Effect vehicles are never the target of tile based queries; all the
+	 * FindVehicleOnPos() procs either ignore them or only act on the real
+	 * vehicle types. Keeping them out of the hash keeps the chains short
+	 * for collision and occupancy checks, and smoke-heavy games spawn a
+	 * lot of them. */
+	if (v->type == VEH_EFFECT) return;
+
 	Vehicle **old_hash = v->hash_tile_current;
 	Vehicle **new_hash;
 
 	if (remove) {
 		new_hash = nullptr;
 	} else {
-		int x = GB(TileX(v->tile), HASH_RES, HASH_BITS);
-		int y = GB(TileY(v->tile), HASH_RES, HASH_BITS) << HASH_BITS;
-		new_hash = &_vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+		new_hash = VehicleTileHashCell(TileX(v->tile), TileY(v->tile));
 	}
 
 	if (old_hash == new_hash) return;
@@ -644,6 +788,13 @@ static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 
 static Vehicle *_vehicle_viewport_hash[1 << (GEN_HASHX_BITS + GEN_HASHY_BITS)];
 
+/**
+ * Number of vehicles in each row of #_vehicle_viewport_hash. Kept up to date
+ * incrementally when vehicles move, so drawing a zoomed-out viewport can skip
+ * whole rows of empty buckets instead of probing every one of them.
+ */
+static uint _vehicle_viewport_hash_row_count[1 << GEN_HASHY_BITS];
+
 static void UpdateVehicleViewportHash(Vehicle *v, int x, int y, int old_x, int old_y)
 {
 	Vehicle **old_hash, **new_hash;
@@ -657,6 +808,7 @@ static void UpdateVehicleViewportHash(Vehicle *v, int x, int y, int old_x, int o
 	if (old_hash != nullptr) {
 		if (v->hash_viewport_next != nullptr) v->hash_viewport_next->hash_viewport_prev = v->hash_viewport_prev;
 		*v->hash_viewport_prev = v->hash_viewport_next;
+		_vehicle_viewport_hash_row_count[(old_hash - _vehicle_viewport_hash) >> GEN_HASHX_BITS]--;
 	}
 
 	/* insert into hash table? */
@@ -665,14 +817,27 @@ static void UpdateVehicleViewportHash(Vehicle *v, int x, int y, int old_x, int o
 		if (v->hash_viewport_next != nullptr) v->hash_viewport_next->hash_viewport_prev = &v->hash_viewport_next;
 		v->hash_viewport_prev = new_hash;
 		*new_hash = v;
+		_vehicle_viewport_hash_row_count[(new_hash - _vehicle_viewport_hash) >> GEN_HASHX_BITS]++;
 	}
 }
 
 void ResetVehicleHash()
 {
-	for (Vehicle *v : Vehicle::Iterate()) { v->hash_tile_current = nullptr; }
+	for (Vehicle *v : Vehicle::Iterate()) {
+		v->hash_tile_current = nullptr;
+		if (v->type == VEH_ROAD) RoadVehicle::From(v)->hash_road_current = nullptr;
+	}
 	memset(_vehicle_viewport_hash, 0, sizeof(_vehicle_viewport_hash));
-	memset(_vehicle_tile_hash, 0, sizeof(_vehicle_tile_hash));
+	memset(_vehicle_viewport_hash_row_count, 0, sizeof(_vehicle_viewport_hash_row_count));
+
+	/* Size the tile hash from the map so it covers the whole map; large maps get
+	 * coarser cells instead of longer chains once MAX_HASH_BITS bits per axis are spent. */
+	_hash_bits_x = std::min<int>(Map::LogX(), MAX_HASH_BITS);
+	_hash_bits_y = std::min<int>(Map::LogY(), MAX_HASH_BITS);
+	_hash_res_x = Map::LogX() - _hash_bits_x;
+	_hash_res_y = Map::LogY() - _hash_bits_y;
+	_vehicle_tile_hash.assign(1 << (_hash_bits_x + _hash_bits_y), nullptr);
+	_road_vehicle_tile_hash.assign(1 << (_hash_bits_x + _hash_bits_y), nullptr);
 }
 
 void ResetVehicleColourMap()
@@ -965,11 +1130,40 @@ void CallVehicleTicks()
 	PerformanceAccumulator::Reset(PFE_GL_SHIPS);
 	PerformanceAccumulator::Reset(PFE_GL_AIRCRAFT);
 
+	/* Collect the dirty areas of all vehicles moved this tick and flush them
+	 * in coalesced form after the loop, instead of walking all windows for
+	 * every single vehicle. */
+	BeginVehicleViewportDirtyBatch();
+
 	for (Vehicle *v : Vehicle::Iterate()) {
 		[[maybe_unused]] size_t vehicle_index = v->index;
 
+		/* Dispatch on the vehicle type directly instead of through the
+		 * vtable; this loop is hot enough for that to be measurable. */
+		bool alive;
+		switch (v->type) {
+			case VEH_TRAIN:
+				if (v->idle_ticks > 0) {
+					/* Held by the timetable at a station; only the counters the
+					 * full handler would have bumped need to advance. */
+					v->idle_ticks--;
+					v->tick_counter++;
+					v->running_ticks++;
+					v->current_order_time++;
+					alive = true;
+					break;
+				}
+				alive = Train::From(v)->Train::Tick();
+				break;
+			case VEH_ROAD:     alive = RoadVehicle::From(v)->RoadVehicle::Tick(); break;
+			case VEH_SHIP:     alive = Ship::From(v)->Ship::Tick(); break;
+			case VEH_AIRCRAFT: alive = Aircraft::From(v)->Aircraft::Tick(); break;
+			case VEH_EFFECT:   alive = EffectVehicle::From(v)->EffectVehicle::Tick(); break;
+			default:           alive = v->Tick(); break;
+		}
+
 		/* Vehicle could be deleted in this tick */
-		if (!v->Tick()) {
+		if (!alive) {
 			assert(Vehicle::Get(vehicle_index) == nullptr);
 			continue;
 		}
@@ -1036,6 +1230,8 @@ void CallVehicleTicks()
 		}
 	}
 
+	FlushVehicleViewportDirtyBatch();
+
 	Backup<CompanyID> cur_company(_current_company, FILE_LINE);
 	for (auto &it : _vehicles_to_autoreplace) {
 		Vehicle *v = it.first;
@@ -1114,6 +1310,101 @@ static void DoDrawVehicle(const Vehicle *v)
 	EndSpriteCombine();
 }
 
+/**
+ * Ensure the cached sprite of a vehicle is up to date before it is drawn.
+ * @param v Vehicle to revalidate the sprite of.
+ */
+static void RevalidateVehicleSprite(const Vehicle *v)
+{
+	VehicleSpriteSeq seq;
+	v->GetImage(v->direction, EIT_ON_MAP, &seq);
+
+	if (seq.IsValid() && v->sprite_cache.sprite_seq != seq) {
+		v->sprite_cache.sprite_seq = seq;
+		/*
+		 * A sprite change may also result in a bounding box change,
+		 * so we need to update the bounding box again before we
+		 * check to see if the vehicle should be drawn. Note that
+		 * we can't interfere with the viewport hash at this point,
+		 * so we keep the original hash on the assumption there will
+		 * not be a significant change in the top and left coordinates
+		 * of the vehicle.
+		 */
+		v->UpdateBoundingBoxCoordinates(false);
+	}
+
+	v->sprite_cache.revalidate_before_draw = false;
+}
+
+/**
+ * Bring the cached sprites of all vehicles overlapping the given rectangle up
+ * to date. Collecting the sprites of a viewport may be spread over several
+ * threads, which must not modify any vehicle; revalidating the whole area up
+ * front keeps the collection itself free of writes to shared state.
+ * @param dpi Rectangle that is about to be drawn.
+ */
+void ViewportRevalidateVehicleSprites(DrawPixelInfo *dpi)
+{
+	/* The bounding rectangle */
+	const int l = dpi->left;
+	const int r = dpi->left + dpi->width;
+	const int t = dpi->top;
+	const int b = dpi->top + dpi->height;
+
+	/* Border size of MAX_VEHICLE_PIXEL_xy */
+	const int xb = MAX_VEHICLE_PIXEL_X * ZOOM_LVL_BASE;
+	const int yb = MAX_VEHICLE_PIXEL_Y * ZOOM_LVL_BASE;
+
+	/* The hash area to scan */
+	int xl, xu, yl, yu;
+
+	if (dpi->width + xb < GEN_HASHX_SIZE) {
+		xl = GEN_HASHX(l - xb);
+		xu = GEN_HASHX(r);
+	} else {
+		/* scan whole hash row */
+		xl = 0;
+		xu = GEN_HASHX_MASK;
+	}
+
+	if (dpi->height + yb < GEN_HASHY_SIZE) {
+		yl = GEN_HASHY(t - yb);
+		yu = GEN_HASHY(b);
+	} else {
+		/* scan whole column */
+		yl = 0;
+		yu = GEN_HASHY_MASK;
+	}
+
+	for (int y = yl;; y = (y + GEN_HASHY_INC) & GEN_HASHY_MASK) {
+		if (_vehicle_viewport_hash_row_count[y >> GEN_HASHX_BITS] == 0) {
+			if (y == yu) break;
+			continue;
+		}
+
+		for (int x = xl;; x = (x + GEN_HASHX_INC) & GEN_HASHX_MASK) {
+			const Vehicle *v = _vehicle_viewport_hash[x + y]; // already masked & 0xFFF
+
+			while (v != nullptr) {
+				if (v->sprite_cache.revalidate_before_draw &&
+						!(v->vehstatus & VS_HIDDEN) &&
+						l <= v->coord.right + xb &&
+						t <= v->coord.bottom + yb &&
+						r >= v->coord.left - xb &&
+						b >= v->coord.top - yb) {
+					RevalidateVehicleSprite(v);
+				}
+
+				v = v->hash_viewport_next;
+			}
+
+			if (x == xu) break;
+		}
+
+		if (y == yu) break;
+	}
+}
+
 /**
  * Add the vehicle sprites that should be drawn at a part of the screen.
  * @param dpi Rectangle being drawn.
@@ -1152,6 +1443,13 @@ void ViewportAddVehicles(DrawPixelInfo *dpi)
 	}
 
 	for (int y = yl;; y = (y + GEN_HASHY_INC) & GEN_HASHY_MASK) {
+		/* Skip rows without any vehicles; at far zoom levels most of the hash
+		 * is in range and this avoids probing thousands of empty buckets. */
+		if (_vehicle_viewport_hash_row_count[y >> GEN_HASHX_BITS] == 0) {
+			if (y == yu) break;
+			continue;
+		}
+
 		for (int x = xl;; x = (x + GEN_HASHX_INC) & GEN_HASHX_MASK) {
 			const Vehicle *v = _vehicle_viewport_hash[x + y]; // already masked & 0xFFF
 
@@ -1166,28 +1464,10 @@ void ViewportAddVehicles(DrawPixelInfo *dpi)
 					/*
 					 * This vehicle can potentially be drawn as part of this viewport and
 					 * needs to be revalidated, as the sprite may not be correct.
+					 * When collection runs on several threads this has already been done
+					 * by ViewportRevalidateVehicleSprites before the threads were started.
 					 */
-					if (v->sprite_cache.revalidate_before_draw) {
-						VehicleSpriteSeq seq;
-						v->GetImage(v->direction, EIT_ON_MAP, &seq);
-
-						if (seq.IsValid() && v->sprite_cache.sprite_seq != seq) {
-							v->sprite_cache.sprite_seq = seq;
-							/*
-							 * A sprite change may also result in a bounding box change,
-							 * so we need to update the bounding box again before we
-							 * check to see if the vehicle should be drawn. Note that
-							 * we can't interfere with the viewport hash at this point,
-							 * so we keep the original hash on the assumption there will
-							 * not be a significant change in the top and left coordinates
-							 * of the vehicle.
-							 */
-							v->UpdateBoundingBoxCoordinates(false);
-
-						}
-
-						v->sprite_cache.revalidate_before_draw = false;
-					}
+					if (v->sprite_cache.revalidate_before_draw) RevalidateVehicleSprite(v);
 
 					if (l <= v->coord.right &&
 						t <= v->coord.bottom &&
@@ -1609,6 +1889,7 @@ void VehicleEnterDepot(Vehicle *v)
 void Vehicle::UpdatePosition()
 {
 	UpdateVehicleTileHash(this, false);
+	_state_checksums.UpdateVehicle(this->index ^ this->x_pos ^ ROL<uint32>(this->y_pos, 16) ^ this->z_pos);
 }
 
 /**
@@ -1663,9 +1944,9 @@ void Vehicle::UpdateViewport(bool dirty)
 
 	if (dirty) {
 		if (ignore_cached_coords) {
-			this->sprite_cache.is_viewport_candidate = this->MarkAllViewportsDirty();
+			this->sprite_cache.is_viewport_candidate = ::MarkVehicleViewportDirty(this->coord.left, this->coord.top, this->coord.right, this->coord.bottom);
 		} else {
-			this->sprite_cache.is_viewport_candidate = ::MarkAllViewportsDirty(
+			this->sprite_cache.is_viewport_candidate = ::MarkVehicleViewportDirty(
 				std::min(this->sprite_cache.old_coord.left, this->coord.left),
 				std::min(this->sprite_cache.old_coord.top, this->coord.top),
 				std::max(this->sprite_cache.old_coord.right, this->coord.right),
@@ -2261,6 +2542,8 @@ void Vehicle::LeaveStation()
 {
 	assert(this->current_order.IsType(OT_LOADING));
 
+	this->idle_ticks = 0;
+
 	delete this->cargo_payment;
 	assert(this->cargo_payment == nullptr); // cleared by ~CargoPayment
 
@@ -2327,7 +2610,18 @@ void Vehicle::HandleLoading(bool mode)
 			uint wait_time = std::max(this->current_order.GetTimetabledWait() - this->lateness_counter, 0);
 
 			/* Not the first call for this tick, or still loading */
-			if (mode || !HasBit(this->vehicle_flags, VF_LOADING_FINISHED) || this->current_order_time < wait_time) return;
+			if (mode || !HasBit(this->vehicle_flags, VF_LOADING_FINISHED) || this->current_order_time < wait_time) {
+				/* When the vehicle is merely waiting out its timetabled stop, its tick
+				 * handler does nothing until the wait is over; skip it until then. The
+				 * tick the wait expires on must be handled normally again. Any event
+				 * that can end the wait early resets #idle_ticks. */
+				if (!mode && this->type == VEH_TRAIN && HasBit(this->vehicle_flags, VF_LOADING_FINISHED) &&
+						this->breakdown_ctr == 0 && !(this->vehstatus & VS_STOPPED) &&
+						this->current_order_time + 1 < wait_time) {
+					this->idle_ticks = wait_time - this->current_order_time - 1;
+				}
+				return;
+			}
 
 			this->PlayLeaveStationSound();
 
@@ -195,6 +195,10 @@ struct MutableSpriteCache {
 	Rect old_coord;               ///< Co-ordinates from the last valid bounding box
 	bool is_viewport_candidate;   ///< This vehicle can potentially be drawn on a viewport
 	VehicleSpriteSeq sprite_seq;  ///< Vehicle appearance.
+	VehicleSpriteSeq resolved_seq; ///< Memoised result of the last NewGRF sprite resolution, see #GetCustomEngineSprite.
+	Direction resolved_direction; ///< Direction #resolved_seq was resolved for.
+	EngineImageType resolved_image_type; ///< Visualisation context #resolved_seq was resolved for.
+	bool resolved_seq_valid;      ///< Whether #resolved_seq may be reused; cleared by Vehicle::InvalidateNewGRFCache().
 };
 
 /** A vehicle pool for a little over 1 million vehicles. */
@@ -285,6 +289,8 @@ public:
 
 	SpriteID colourmap;                 ///< NOSAVE: cached colour mapping
 
+	mutable uint32 order_review_stamp;  ///< NOSAVE: Order review generation for which #CheckOrders() last found no problem.
+
 	/* Related to age and service time */
 	Year build_year;                    ///< Year the vehicle has been built.
 	Date age;                           ///< Age in days
@@ -345,6 +351,7 @@ public:
 	byte day_counter;                   ///< Increased by one for each day
 	byte tick_counter;                  ///< Increased by one for each tick
 	byte running_ticks;                 ///< Number of ticks this vehicle was not stopped this day
+	uint16 idle_ticks;                  ///< NOSAVE: Remaining ticks the vehicle is held by its timetable and its tick handler may be skipped.
 
 	byte vehstatus;                     ///< Status
 	Order current_order;                ///< The current order (+ status, like: loading)
@@ -495,6 +502,7 @@ public:
 	inline void InvalidateNewGRFCache()
 	{
 		this->grf_cache.cache_valid = 0;
+		this->sprite_cache.resolved_seq_valid = false;
 	}
 
 	/**
@@ -43,6 +43,8 @@
 #include "train_cmd.h"
 #include "hotkeys.h"
 
+#include <unordered_map>
+
 #include "safeguards.h"
 
 
@@ -389,15 +391,15 @@ DropDownList BaseVehicleListWindow::BuildActionDropdownList(bool show_autoreplac
 	return list;
 }
 
-/* cached values for VehicleNameSorter to spare many GetString() calls */
-static const Vehicle *_last_vehicle[2] = { nullptr, nullptr };
+/* cached names for VehicleNameSorter to spare many GetString() calls */
+static std::unordered_map<VehicleID, std::string> _vehicle_name_cache;
 
 void BaseVehicleListWindow::SortVehicleList()
 {
-	if (this->vehgroups.Sort()) return;
+	this->vehgroups.Sort();
 
 	/* invalidate cached values for name sorter - vehicle names could change */
-	_last_vehicle[0] = _last_vehicle[1] = nullptr;
+	_vehicle_name_cache.clear();
 }
 
 void DepotSortList(VehicleList *list)
@@ -1328,24 +1330,30 @@ static bool VehicleNumberSorter(const Vehicle * const &a, const Vehicle * const
 	return a->unitnumber < b->unitnumber;
 }
 
-/** Sort vehicles by their name */
-static bool VehicleNameSorter(const Vehicle * const &a, const Vehicle * const &b)
+/**
+ * Get the name of a vehicle, resolving it at most once per sort.
+ * A sort compares each vehicle O(log n) times, and resolving the name is by
+ * far the most expensive part of the comparison, so it is cached for the
+ * duration of the sort.
+ * @param v The vehicle to get the name of.
+ * @return The name of the vehicle.
+ */
+static const std::string &GetCachedVehicleName(const Vehicle *v)
 {
-	static char last_name[2][64];
-
-	if (a != _last_vehicle[0]) {
-		_last_vehicle[0] = a;
-		SetDParam(0, a->index);
-		GetString(last_name[0], STR_VEHICLE_NAME, lastof(last_name[0]));
-	}
-
-	if (b != _last_vehicle[1]) {
-		_last_vehicle[1] = b;
-		SetDParam(0, b->index);
-		GetString(last_name[1], STR_VEHICLE_NAME, lastof(last_name[1]));
+	auto [it, inserted] = _vehicle_name_cache.emplace(v->index, std::string{});
+	if (inserted) {
+		char buf[64];
+		SetDParam(0, v->index);
+		GetString(buf, STR_VEHICLE_NAME, lastof(buf));
+		it->second = buf;
 	}
+	return it->second;
+}
 
-	int r = strnatcmp(last_name[0], last_name[1]); // Sort by name (natural sorting).
+/** Sort vehicles by their name */
+static bool VehicleNameSorter(const Vehicle * const &a, const Vehicle * const &b)
+{
+	int r = strnatcmp(GetCachedVehicleName(a).c_str(), GetCachedVehicleName(b).c_str()); // Sort by name (natural sorting).
 	return (r != 0) ? r < 0: VehicleNumberSorter(a, b);
 }
 
@@ -13,6 +13,7 @@
 #include "../network/network.h"
 #include "../network/network_internal.h"
 #include "../console_func.h"
+#include "../game/game.hpp"
 #include "../genworld.h"
 #include "../fileio_type.h"
 #include "../fios.h"
@@ -164,6 +165,10 @@ const char *VideoDriver_Dedicated::Start(const StringList &parm)
 	OS2_SwitchToConsoleMode();
 #endif
 
+	/* Write console output from its own thread, so a stalled terminal
+	 * cannot backpressure the simulation. */
+	IConsoleStartAsyncOutput();
+
 	Debug(driver, 1, "Loading dedicated server");
 	return nullptr;
 }
@@ -173,6 +178,7 @@ void VideoDriver_Dedicated::Stop()
 #ifdef _WIN32
 	CloseWindowsConsoleThread();
 #endif
+	IConsoleStopAsyncOutput();
 	free(_dedicated_video_mem);
 }
 
@@ -272,6 +278,18 @@ void VideoDriver_Dedicated::MainLoop()
 		if (!_dedicated_forks) DedicatedHandleKeyInput();
 		this->DrainCommandQueue();
 
+		if (_settings_client.network.hibernate_on_empty && _game_mode == GM_NORMAL &&
+				_switch_mode == SM_NONE && Game::GetInstance() == nullptr &&
+				NetworkServerWithoutClients()) {
+			/* Nobody can see the simulation run, so don't simulate. Service
+			 * the network at a low rate so incoming connections, the admin
+			 * port and the coordinator keep working, and resume the normal
+			 * loop as soon as something connects. */
+			NetworkHibernateLoop();
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			continue;
+		}
+
 		ChangeGameSpeed(_ddc_fastforward);
 		this->Tick();
 		this->SleepTillNextTick();
@@ -12,7 +12,9 @@
 #include "../blitter/factory.hpp"
 #include "../saveload/saveload.h"
 #include "../window_func.h"
+#include "../framerate_type.h"
 #include "null_v.h"
+#include <chrono>
 
 #include "../safeguards.h"
 
@@ -29,6 +31,7 @@ const char *VideoDriver_Null::Start(const StringList &parm)
 	this->UpdateAutoResolution();
 
 	this->ticks = GetDriverParamInt(parm, "ticks", 1000);
+	this->bench = GetDriverParamBool(parm, "bench");
 	_screen.width  = _screen.pitch = _cur_resolution.width;
 	_screen.height = _cur_resolution.height;
 	_screen.dst_ptr = nullptr;
@@ -48,12 +51,25 @@ void VideoDriver_Null::MainLoop()
 {
 	uint i;
 
+	auto start = std::chrono::steady_clock::now();
+
 	for (i = 0; i < this->ticks; i++) {
 		::GameLoop();
 		::InputLoop();
 		::UpdateWindows();
 	}
 
+	if (this->bench) {
+		/* The ticks ran as fast as possible; report how fast that was and
+		 * where the time went. When the run started from a savegame the
+		 * simulation is fully deterministic, as the random state is part
+		 * of the save, so runs on the same save can be compared directly. */
+		double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+		fprintf(stdout, "benchmark ticks=%u seconds=%.3f ticks_per_second=%.1f\n", this->ticks, seconds, seconds > 0 ? this->ticks / seconds : 0.0);
+		DumpFramerate(stdout);
+		fflush(stdout);
+	}
+
 	/* If requested, make a save just before exit. The normal exit-flow is
 	 * not triggered from this driver, so we have to do this manually. */
 	if (_settings_client.gui.autosave_on_exit) {
@@ -16,6 +16,7 @@
 class VideoDriver_Null : public VideoDriver {
 private:
 	uint ticks; ///< Amount of ticks to run.
+	bool bench; ///< Whether to report simulation throughput and subsystem timings after the run.
 
 public:
 	const char *Start(const StringList &param) override;
@@ -1203,6 +1203,15 @@ uint8 *OpenGLBackend::GetAnimBuffer()
  * @param update_rect Rectangle encompassing the dirty region of the video buffer.
  */
 void OpenGLBackend::ReleaseVideoBuffer(const Rect &update_rect)
+{
+	this->ReleaseVideoBuffer(span<const Rect>(&update_rect, 1));
+}
+
+/**
+ * Update video buffer texture after the video buffer was filled.
+ * @param update_rects Rectangles covering the dirty regions of the video buffer.
+ */
+void OpenGLBackend::ReleaseVideoBuffer(span<const Rect> update_rects)
 {
 	assert(this->vid_pbo != 0);
 
@@ -1219,11 +1228,17 @@ void OpenGLBackend::ReleaseVideoBuffer(const Rect &update_rect)
 	}
 #endif
 
-	/* Update changed rect of the video buffer texture. */
-	if (!IsEmptyRect(update_rect)) {
-		_glActiveTexture(GL_TEXTURE0);
-		_glBindTexture(GL_TEXTURE_2D, this->vid_texture);
-		_glPixelStorei(GL_UNPACK_ROW_LENGTH, _screen.pitch);
+	/* Update the changed rects of the video buffer texture. */
+	bool uploaded = false;
+	for (const Rect &update_rect : update_rects) {
+		if (IsEmptyRect(update_rect)) continue;
+
+		if (!uploaded) {
+			_glActiveTexture(GL_TEXTURE0);
+			_glBindTexture(GL_TEXTURE_2D, this->vid_texture);
+			_glPixelStorei(GL_UNPACK_ROW_LENGTH, _screen.pitch);
+			uploaded = true;
+		}
 		switch (BlitterFactory::GetCurrentBlitter()->GetScreenDepth()) {
 			case 8:
 				_glTexSubImage2D(GL_TEXTURE_2D, 0, update_rect.left, update_rect.top, update_rect.right - update_rect.left, update_rect.bottom - update_rect.top, GL_RED, GL_UNSIGNED_BYTE, (GLvoid *)(size_t)(update_rect.top * _screen.pitch + update_rect.left));
@@ -1233,11 +1248,11 @@ void OpenGLBackend::ReleaseVideoBuffer(const Rect &update_rect)
 				_glTexSubImage2D(GL_TEXTURE_2D, 0, update_rect.left, update_rect.top, update_rect.right - update_rect.left, update_rect.bottom - update_rect.top, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, (GLvoid *)(size_t)(update_rect.top * _screen.pitch * 4 + update_rect.left * 4));
 				break;
 		}
+	}
 
 #ifndef NO_GL_BUFFER_SYNC
-		if (this->persistent_mapping_supported) this->sync_vid_mapping = _glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	if (uploaded && this->persistent_mapping_supported) this->sync_vid_mapping = _glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 #endif
-	}
 }
 
 /**
@@ -1245,6 +1260,15 @@ void OpenGLBackend::ReleaseVideoBuffer(const Rect &update_rect)
  * @param update_rect Rectangle encompassing the dirty region of the animation buffer.
  */
 void OpenGLBackend::ReleaseAnimBuffer(const Rect &update_rect)
+{
+	this->ReleaseAnimBuffer(span<const Rect>(&update_rect, 1));
+}
+
+/**
+ * Update animation buffer texture after the animation buffer was filled.
+ * @param update_rects Rectangles covering the dirty regions of the animation buffer.
+ */
+void OpenGLBackend::ReleaseAnimBuffer(span<const Rect> update_rects)
 {
 	if (this->anim_pbo == 0) return;
 
@@ -1261,17 +1285,23 @@ void OpenGLBackend::ReleaseAnimBuffer(const Rect &update_rect)
 	}
 #endif
 
-	/* Update changed rect of the video buffer texture. */
-	if (update_rect.left != update_rect.right) {
-		_glActiveTexture(GL_TEXTURE0);
-		_glBindTexture(GL_TEXTURE_2D, this->anim_texture);
-		_glPixelStorei(GL_UNPACK_ROW_LENGTH, _screen.pitch);
+	/* Update the changed rects of the video buffer texture. */
+	bool uploaded = false;
+	for (const Rect &update_rect : update_rects) {
+		if (update_rect.left == update_rect.right) continue;
+
+		if (!uploaded) {
+			_glActiveTexture(GL_TEXTURE0);
+			_glBindTexture(GL_TEXTURE_2D, this->anim_texture);
+			_glPixelStorei(GL_UNPACK_ROW_LENGTH, _screen.pitch);
+			uploaded = true;
+		}
 		_glTexSubImage2D(GL_TEXTURE_2D, 0, update_rect.left, update_rect.top, update_rect.right - update_rect.left, update_rect.bottom - update_rect.top, GL_RED, GL_UNSIGNED_BYTE, (GLvoid *)(size_t)(update_rect.top * _screen.pitch + update_rect.left));
+	}
 
 #ifndef NO_GL_BUFFER_SYNC
-		if (this->persistent_mapping_supported) this->sync_anim_mapping = _glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	if (uploaded && this->persistent_mapping_supported) this->sync_anim_mapping = _glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 #endif
-	}
 }
 
 /* virtual */ Sprite *OpenGLBackend::Encode(const SpriteLoader::Sprite *sprite, AllocatorProc *allocator)
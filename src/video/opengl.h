@@ -12,6 +12,7 @@
 
 #include "../core/alloc_type.hpp"
 #include "../core/geometry_type.hpp"
+#include "../core/span_type.hpp"
 #include "../gfx_type.h"
 #include "../spriteloader/spriteloader.hpp"
 #include "../misc/lrucache.hpp"
@@ -103,7 +104,9 @@ public:
 	void *GetVideoBuffer();
 	uint8 *GetAnimBuffer();
 	void ReleaseVideoBuffer(const Rect &update_rect);
+	void ReleaseVideoBuffer(span<const Rect> update_rects);
 	void ReleaseAnimBuffer(const Rect &update_rect);
+	void ReleaseAnimBuffer(span<const Rect> update_rects);
 
 	/* SpriteEncoder */
 
@@ -136,6 +136,24 @@ void VideoDriver_SDL_OpenGL::ClearSystemSprites()
 	OpenGLBackend::Get()->ClearCursorCache();
 }
 
+/** Maximum number of dirty rectangles tracked for partial texture uploads. */
+static const size_t MAX_DIRTY_RECTS = 100;
+
+void VideoDriver_SDL_OpenGL::MakeDirty(int left, int top, int width, int height)
+{
+	/* Keep the bounding rectangle of the base class updated as fallback. */
+	this->VideoDriver_SDL_Base::MakeDirty(left, top, width, height);
+
+	if (this->dirty_rects.size() < MAX_DIRTY_RECTS) {
+		this->dirty_rects.push_back({left, top, left + width, top + height});
+	} else {
+		/* Too many regions to track them separately; collapse everything
+		 * into the bounding rectangle of all dirty regions. */
+		this->dirty_rects.clear();
+		this->dirty_rects.push_back(this->dirty_rect);
+	}
+}
+
 bool VideoDriver_SDL_OpenGL::AllocateBackingStore(int w, int h, bool force)
 {
 	if (this->gl_context == nullptr) return false;
@@ -145,6 +163,7 @@ bool VideoDriver_SDL_OpenGL::AllocateBackingStore(int w, int h, bool force)
 	w = std::max(w, 64);
 	h = std::max(h, 64);
 	MemSetT(&this->dirty_rect, 0);
+	this->dirty_rects.clear();
 
 	bool res = OpenGLBackend::Get()->Resize(w, h, force);
 	SDL_GL_SwapWindow(this->sdl_window);
@@ -165,9 +184,10 @@ void *VideoDriver_SDL_OpenGL::GetVideoPointer()
 
 void VideoDriver_SDL_OpenGL::ReleaseVideoPointer()
 {
-	if (this->anim_buffer != nullptr) OpenGLBackend::Get()->ReleaseAnimBuffer(this->dirty_rect);
-	OpenGLBackend::Get()->ReleaseVideoBuffer(this->dirty_rect);
+	if (this->anim_buffer != nullptr) OpenGLBackend::Get()->ReleaseAnimBuffer(span<const Rect>(this->dirty_rects));
+	OpenGLBackend::Get()->ReleaseVideoBuffer(span<const Rect>(this->dirty_rects));
 	MemSetT(&this->dirty_rect, 0);
+	this->dirty_rects.clear();
 	this->anim_buffer = nullptr;
 }
 
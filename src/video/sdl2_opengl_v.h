@@ -29,6 +29,8 @@ public:
 	bool HasAnimBuffer() override { return true; }
 	uint8 *GetAnimBuffer() override { return this->anim_buffer; }
 
+	void MakeDirty(int left, int top, int width, int height) override;
+
 	void ToggleVsync(bool vsync) override;
 
 	const char *GetName() const override { return "sdl-opengl"; }
@@ -43,6 +45,7 @@ protected:
 private:
 	void  *gl_context;  ///< OpenGL context.
 	uint8 *anim_buffer; ///< Animation buffer from OpenGL back-end.
+	std::vector<Rect> dirty_rects; ///< Dirty rectangles of the video buffer, kept separate for partial texture uploads.
 
 	const char *AllocateContext();
 	void DestroyContext();
@@ -90,6 +90,10 @@
 #include "network/network_func.h"
 #include "framerate_type.h"
 #include "viewport_cmd.h"
+#include "thread.h"
+#include "smallmap_gui.h"
+#include "elrail_func.h"
+#include "tunnelbridge.h"
 
 #include <forward_list>
 #include <map>
@@ -106,6 +110,21 @@ Point _tile_fract_coords;
 ViewportSignKdtree _viewport_sign_kdtree(&Kdtree_ViewportSignXYFunc);
 static int _viewport_sign_maxwidth = 0;
 
+/** Cached result of the sign kdtree query for one viewport's visible area. */
+struct ViewportSignCache {
+	Rect rect{};                   ///< Expanded virtual rectangle the items were collected for
+	ZoomLevel zoom{};              ///< Zoom level #rect was expanded for
+	size_t generation = 0;         ///< Generation of #_viewport_sign_kdtree the items were collected at
+	bool valid = false;            ///< Whether the cache holds a previous query result
+	std::vector<ViewportSignKdtreeItem> items; ///< All sign items within #rect
+};
+
+/** Visible-sign caches of all live viewports. */
+static std::map<const Viewport *, ViewportSignCache> _viewport_sign_caches;
+
+/** Sign cache of the viewport currently being drawn, for the collecting strips to read. */
+static const ViewportSignCache *_viewport_sign_cache_cur = nullptr;
+
 
 static const int MAX_TILE_EXTENT_LEFT   = ZOOM_LVL_BASE * TILE_PIXELS;                     ///< Maximum left   extent of tile relative to north corner.
 static const int MAX_TILE_EXTENT_RIGHT  = ZOOM_LVL_BASE * TILE_PIXELS;                     ///< Maximum right  extent of tile relative to north corner.
@@ -184,10 +203,15 @@ struct ViewportDrawer {
 
 static bool MarkViewportDirty(const Viewport *vp, int left, int top, int right, int bottom);
 
-static ViewportDrawer _vd;
+/**
+ * The drawer the current thread collects sprites into. The viewport area is
+ * split into column strips which are collected concurrently, each strip into
+ * its own drawer (see ViewportDoDraw()).
+ */
+static thread_local ViewportDrawer *_vd = nullptr;
 
 TileHighlightData _thd;
-static TileInfo _cur_ti;
+static thread_local TileInfo _cur_ti;
 bool _draw_bounding_boxes = false;
 bool _draw_dirty_blocks = false;
 uint _dirty_block_colour = 0;
@@ -206,6 +230,7 @@ void DeleteWindowViewport(Window *w)
 	if (w->viewport == nullptr) return;
 
 	delete w->viewport->overlay;
+	_viewport_sign_caches.erase(w->viewport);
 	free(w->viewport);
 	w->viewport = nullptr;
 }
@@ -508,7 +533,7 @@ static void AddTileSpriteToDraw(SpriteID image, PaletteID pal, int32 x, int32 y,
 {
 	assert((image & SPRITE_MASK) < MAX_SPRITES);
 
-	TileSpriteToDraw &ts = _vd.tile_sprites_to_draw.emplace_back();
+	TileSpriteToDraw &ts = _vd->tile_sprites_to_draw.emplace_back();
 	ts.image = image;
 	ts.pal = pal;
 	ts.sub = sub;
@@ -532,17 +557,17 @@ static void AddTileSpriteToDraw(SpriteID image, PaletteID pal, int32 x, int32 y,
 static void AddChildSpriteToFoundation(SpriteID image, PaletteID pal, const SubSprite *sub, FoundationPart foundation_part, int extra_offs_x, int extra_offs_y)
 {
 	assert(IsInsideMM(foundation_part, 0, FOUNDATION_PART_END));
-	assert(_vd.foundation[foundation_part] != -1);
-	Point offs = _vd.foundation_offset[foundation_part];
+	assert(_vd->foundation[foundation_part] != -1);
+	Point offs = _vd->foundation_offset[foundation_part];
 
 	/* Change the active ChildSprite list to the one of the foundation */
-	int *old_child = _vd.last_child;
-	_vd.last_child = _vd.last_foundation_child[foundation_part];
+	int *old_child = _vd->last_child;
+	_vd->last_child = _vd->last_foundation_child[foundation_part];
 
 	AddChildSpriteScreen(image, pal, offs.x + extra_offs_x, offs.y + extra_offs_y, false, sub, false, false);
 
 	/* Switch back to last ChildSprite list */
-	_vd.last_child = old_child;
+	_vd->last_child = old_child;
 }
 
 /**
@@ -561,11 +586,11 @@ static void AddChildSpriteToFoundation(SpriteID image, PaletteID pal, const SubS
 void DrawGroundSpriteAt(SpriteID image, PaletteID pal, int32 x, int32 y, int z, const SubSprite *sub, int extra_offs_x, int extra_offs_y)
 {
 	/* Switch to first foundation part, if no foundation was drawn */
-	if (_vd.foundation_part == FOUNDATION_PART_NONE) _vd.foundation_part = FOUNDATION_PART_NORMAL;
+	if (_vd->foundation_part == FOUNDATION_PART_NONE) _vd->foundation_part = FOUNDATION_PART_NORMAL;
 
-	if (_vd.foundation[_vd.foundation_part] != -1) {
+	if (_vd->foundation[_vd->foundation_part] != -1) {
 		Point pt = RemapCoords(x, y, z);
-		AddChildSpriteToFoundation(image, pal, sub, _vd.foundation_part, pt.x + extra_offs_x * ZOOM_LVL_BASE, pt.y + extra_offs_y * ZOOM_LVL_BASE);
+		AddChildSpriteToFoundation(image, pal, sub, _vd->foundation_part, pt.x + extra_offs_x * ZOOM_LVL_BASE, pt.y + extra_offs_y * ZOOM_LVL_BASE);
 	} else {
 		AddTileSpriteToDraw(image, pal, _cur_ti.x + x, _cur_ti.y + y, _cur_ti.z + z, sub, extra_offs_x * ZOOM_LVL_BASE, extra_offs_y * ZOOM_LVL_BASE);
 	}
@@ -596,22 +621,22 @@ void DrawGroundSprite(SpriteID image, PaletteID pal, const SubSprite *sub, int e
 void OffsetGroundSprite(int x, int y)
 {
 	/* Switch to next foundation part */
-	switch (_vd.foundation_part) {
+	switch (_vd->foundation_part) {
 		case FOUNDATION_PART_NONE:
-			_vd.foundation_part = FOUNDATION_PART_NORMAL;
+			_vd->foundation_part = FOUNDATION_PART_NORMAL;
 			break;
 		case FOUNDATION_PART_NORMAL:
-			_vd.foundation_part = FOUNDATION_PART_HALFTILE;
+			_vd->foundation_part = FOUNDATION_PART_HALFTILE;
 			break;
 		default: NOT_REACHED();
 	}
 
-	/* _vd.last_child == nullptr if foundation sprite was clipped by the viewport bounds */
-	if (_vd.last_child != nullptr) _vd.foundation[_vd.foundation_part] = (uint)_vd.parent_sprites_to_draw.size() - 1;
+	/* _vd->last_child == nullptr if foundation sprite was clipped by the viewport bounds */
+	if (_vd->last_child != nullptr) _vd->foundation[_vd->foundation_part] = (uint)_vd->parent_sprites_to_draw.size() - 1;
 
-	_vd.foundation_offset[_vd.foundation_part].x = x * ZOOM_LVL_BASE;
-	_vd.foundation_offset[_vd.foundation_part].y = y * ZOOM_LVL_BASE;
-	_vd.last_foundation_child[_vd.foundation_part] = _vd.last_child;
+	_vd->foundation_offset[_vd->foundation_part].x = x * ZOOM_LVL_BASE;
+	_vd->foundation_offset[_vd->foundation_part].y = y * ZOOM_LVL_BASE;
+	_vd->last_foundation_child[_vd->foundation_part] = _vd->last_child;
 }
 
 /**
@@ -630,13 +655,13 @@ static void AddCombinedSprite(SpriteID image, PaletteID pal, int x, int y, int z
 	Point pt = RemapCoords(x, y, z);
 	const Sprite *spr = GetSprite(image & SPRITE_MASK, ST_NORMAL);
 
-	if (pt.x + spr->x_offs >= _vd.dpi.left + _vd.dpi.width ||
-			pt.x + spr->x_offs + spr->width <= _vd.dpi.left ||
-			pt.y + spr->y_offs >= _vd.dpi.top + _vd.dpi.height ||
-			pt.y + spr->y_offs + spr->height <= _vd.dpi.top)
+	if (pt.x + spr->x_offs >= _vd->dpi.left + _vd->dpi.width ||
+			pt.x + spr->x_offs + spr->width <= _vd->dpi.left ||
+			pt.y + spr->y_offs >= _vd->dpi.top + _vd->dpi.height ||
+			pt.y + spr->y_offs + spr->height <= _vd->dpi.top)
 		return;
 
-	const ParentSpriteToDraw &pstd = _vd.parent_sprites_to_draw.back();
+	const ParentSpriteToDraw &pstd = _vd->parent_sprites_to_draw.back();
 	AddChildSpriteScreen(image, pal, pt.x - pstd.left, pt.y - pstd.top, false, sub, false);
 }
 
@@ -677,12 +702,12 @@ void AddSortableSpriteToDraw(SpriteID image, PaletteID pal, int x, int y, int w,
 		pal = PALETTE_TO_TRANSPARENT;
 	}
 
-	if (_vd.combine_sprites == SPRITE_COMBINE_ACTIVE) {
+	if (_vd->combine_sprites == SPRITE_COMBINE_ACTIVE) {
 		AddCombinedSprite(image, pal, x, y, z, sub);
 		return;
 	}
 
-	_vd.last_child = nullptr;
+	_vd->last_child = nullptr;
 
 	Point pt = RemapCoords(x, y, z);
 	int tmp_left, tmp_top, tmp_x = pt.x, tmp_y = pt.y;
@@ -710,14 +735,23 @@ void AddSortableSpriteToDraw(SpriteID image, PaletteID pal, int x, int y, int w,
 	}
 
 	/* Do not add the sprite to the viewport, if it is outside */
-	if (left   >= _vd.dpi.left + _vd.dpi.width ||
-	    right  <= _vd.dpi.left                 ||
-	    top    >= _vd.dpi.top + _vd.dpi.height ||
-	    bottom <= _vd.dpi.top) {
+	if (left   >= _vd->dpi.left + _vd->dpi.width ||
+	    right  <= _vd->dpi.left                 ||
+	    top    >= _vd->dpi.top + _vd->dpi.height ||
+	    bottom <= _vd->dpi.top) {
 		return;
 	}
 
-	ParentSpriteToDraw &ps = _vd.parent_sprites_to_draw.emplace_back();
+	/* Level-of-detail culling: beyond the detail zoom level, a sprite whose screen
+	 * extent collapses to a single pixel is not worth sorting and blitting.
+	 * Empty bounding boxes are kept, as they only anchor child sprites. */
+	if (_vd->dpi.zoom > ZOOM_LVL_DETAIL && image != SPR_EMPTY_BOUNDING_BOX &&
+			UnScaleByZoom(right - left, _vd->dpi.zoom) <= 1 &&
+			UnScaleByZoom(bottom - top, _vd->dpi.zoom) <= 1) {
+		return;
+	}
+
+	ParentSpriteToDraw &ps = _vd->parent_sprites_to_draw.emplace_back();
 	ps.x = tmp_x;
 	ps.y = tmp_y;
 
@@ -738,9 +772,9 @@ void AddSortableSpriteToDraw(SpriteID image, PaletteID pal, int x, int y, int w,
 
 	ps.first_child = -1;
 
-	_vd.last_child = &ps.first_child;
+	_vd->last_child = &ps.first_child;
 
-	if (_vd.combine_sprites == SPRITE_COMBINE_PENDING) _vd.combine_sprites = SPRITE_COMBINE_ACTIVE;
+	if (_vd->combine_sprites == SPRITE_COMBINE_PENDING) _vd->combine_sprites = SPRITE_COMBINE_ACTIVE;
 }
 
 /**
@@ -763,8 +797,8 @@ void AddSortableSpriteToDraw(SpriteID image, PaletteID pal, int x, int y, int w,
  */
 void StartSpriteCombine()
 {
-	assert(_vd.combine_sprites == SPRITE_COMBINE_NONE);
-	_vd.combine_sprites = SPRITE_COMBINE_PENDING;
+	assert(_vd->combine_sprites == SPRITE_COMBINE_NONE);
+	_vd->combine_sprites = SPRITE_COMBINE_PENDING;
 }
 
 /**
@@ -773,8 +807,8 @@ void StartSpriteCombine()
  */
 void EndSpriteCombine()
 {
-	assert(_vd.combine_sprites != SPRITE_COMBINE_NONE);
-	_vd.combine_sprites = SPRITE_COMBINE_NONE;
+	assert(_vd->combine_sprites != SPRITE_COMBINE_NONE);
+	_vd->combine_sprites = SPRITE_COMBINE_NONE;
 }
 
 /**
@@ -826,7 +860,16 @@ void AddChildSpriteScreen(SpriteID image, PaletteID pal, int x, int y, bool tran
 	assert((image & SPRITE_MASK) < MAX_SPRITES);
 
 	/* If the ParentSprite was clipped by the viewport bounds, do not draw the ChildSprites either */
-	if (_vd.last_child == nullptr) return;
+	if (_vd->last_child == nullptr) return;
+
+	/* Level-of-detail culling: beyond the detail zoom level, child sprites that
+	 * would shrink to a single pixel (cargo overlays, fences, ...) are skipped.
+	 * The dimension memo keeps this check from taking the sprite cache lock
+	 * for every child sprite on the concurrent collection paths. */
+	if (_vd->dpi.zoom > ZOOM_LVL_DETAIL) {
+		Dimension dim = GetSpriteDimension(image & SPRITE_MASK);
+		if (UnScaleByZoom(dim.width, _vd->dpi.zoom) <= 1 && UnScaleByZoom(dim.height, _vd->dpi.zoom) <= 1) return;
+	}
 
 	/* make the sprites transparent with the right palette */
 	if (transparent) {
@@ -834,9 +877,9 @@ void AddChildSpriteScreen(SpriteID image, PaletteID pal, int x, int y, bool tran
 		pal = PALETTE_TO_TRANSPARENT;
 	}
 
-	*_vd.last_child = (uint)_vd.child_screen_sprites_to_draw.size();
+	*_vd->last_child = (uint)_vd->child_screen_sprites_to_draw.size();
 
-	ChildScreenSpriteToDraw &cs = _vd.child_screen_sprites_to_draw.emplace_back();
+	ChildScreenSpriteToDraw &cs = _vd->child_screen_sprites_to_draw.emplace_back();
 	cs.image = image;
 	cs.pal = pal;
 	cs.sub = sub;
@@ -848,15 +891,15 @@ void AddChildSpriteScreen(SpriteID image, PaletteID pal, int x, int y, bool tran
 	/* Append the sprite to the active ChildSprite list.
 	 * If the active ParentSprite is a foundation, update last_foundation_child as well.
 	 * Note: ChildSprites of foundations are NOT sequential in the vector, as selection sprites are added at last. */
-	if (_vd.last_foundation_child[0] == _vd.last_child) _vd.last_foundation_child[0] = &cs.next;
-	if (_vd.last_foundation_child[1] == _vd.last_child) _vd.last_foundation_child[1] = &cs.next;
-	_vd.last_child = &cs.next;
+	if (_vd->last_foundation_child[0] == _vd->last_child) _vd->last_foundation_child[0] = &cs.next;
+	if (_vd->last_foundation_child[1] == _vd->last_child) _vd->last_foundation_child[1] = &cs.next;
+	_vd->last_child = &cs.next;
 }
 
 static void AddStringToDraw(int x, int y, StringID string, uint64 params_1, uint64 params_2, Colours colour, uint16 width)
 {
 	assert(width != 0);
-	StringSpriteToDraw &ss = _vd.string_sprites_to_draw.emplace_back();
+	StringSpriteToDraw &ss = _vd->string_sprites_to_draw.emplace_back();
 	ss.string = string;
 	ss.x = x;
 	ss.y = y;
@@ -883,7 +926,7 @@ static void AddStringToDraw(int x, int y, StringID string, uint64 params_1, uint
 static void DrawSelectionSprite(SpriteID image, PaletteID pal, const TileInfo *ti, int z_offset, FoundationPart foundation_part, int extra_offs_x = 0, int extra_offs_y = 0)
 {
 	/* FIXME: This is not totally valid for some autorail highlights that extend over the edges of the tile. */
-	if (_vd.foundation[foundation_part] == -1) {
+	if (_vd->foundation[foundation_part] == -1) {
 		/* draw on real ground */
 		AddTileSpriteToDraw(image, pal, ti->x, ti->y, ti->z + z_offset, nullptr, extra_offs_x, extra_offs_y);
 	} else {
@@ -1177,11 +1220,11 @@ static int GetViewportY(Point tile)
  */
 static void ViewportAddLandscape()
 {
-	assert(_vd.dpi.top <= _vd.dpi.top + _vd.dpi.height);
-	assert(_vd.dpi.left <= _vd.dpi.left + _vd.dpi.width);
+	assert(_vd->dpi.top <= _vd->dpi.top + _vd->dpi.height);
+	assert(_vd->dpi.left <= _vd->dpi.left + _vd->dpi.width);
 
-	Point upper_left = InverseRemapCoords(_vd.dpi.left, _vd.dpi.top);
-	Point upper_right = InverseRemapCoords(_vd.dpi.left + _vd.dpi.width, _vd.dpi.top);
+	Point upper_left = InverseRemapCoords(_vd->dpi.left, _vd->dpi.top);
+	Point upper_right = InverseRemapCoords(_vd->dpi.left + _vd->dpi.width, _vd->dpi.top);
 
 	/* Transformations between tile coordinates and viewport rows/columns: See vp_column_row
 	 *   column = y - x
@@ -1242,14 +1285,14 @@ static void ViewportAddLandscape()
 
 			int viewport_y = GetViewportY(tilecoord);
 
-			if (viewport_y + MAX_TILE_EXTENT_BOTTOM < _vd.dpi.top) {
+			if (viewport_y + MAX_TILE_EXTENT_BOTTOM < _vd->dpi.top) {
 				/* The tile in this column is not visible yet.
 				 * Tiles in other columns may be visible, but we need more rows in any case. */
 				last_row = false;
 				continue;
 			}
 
-			int min_visible_height = viewport_y - (_vd.dpi.top + _vd.dpi.height);
+			int min_visible_height = viewport_y - (_vd->dpi.top + _vd->dpi.height);
 			bool tile_visible = min_visible_height <= 0;
 
 			if (tile_type != MP_VOID) {
@@ -1274,11 +1317,11 @@ static void ViewportAddLandscape()
 
 			if (tile_visible) {
 				last_row = false;
-				_vd.foundation_part = FOUNDATION_PART_NONE;
-				_vd.foundation[0] = -1;
-				_vd.foundation[1] = -1;
-				_vd.last_foundation_child[0] = nullptr;
-				_vd.last_foundation_child[1] = nullptr;
+				_vd->foundation_part = FOUNDATION_PART_NONE;
+				_vd->foundation[0] = -1;
+				_vd->foundation[1] = -1;
+				_vd->last_foundation_child[0] = nullptr;
+				_vd->last_foundation_child[1] = nullptr;
 
 				_tile_type_procs[tile_type]->draw_tile_proc(&_cur_ti);
 				if (_cur_ti.tile != INVALID_TILE) DrawTileSelection(&_cur_ti);
@@ -1345,6 +1388,62 @@ static Rect ExpandRectWithViewportSignMargins(Rect r, ZoomLevel zoom)
 	return r;
 }
 
+/** Add all signs within the given virtual rectangle to the items of a sign cache. */
+static void AddSignsInBand(std::vector<ViewportSignKdtreeItem> &items, int left, int top, int right, int bottom)
+{
+	if (left >= right || top >= bottom) return;
+	_viewport_sign_kdtree.FindContained(left, top, right, bottom, [&](const ViewportSignKdtreeItem &item) { items.push_back(item); });
+}
+
+/**
+ * Bring the visible-sign cache of a viewport up to date.
+ * On a scroll the kdtree is only queried for the newly exposed bands instead
+ * of the whole visible rectangle; sign additions, removals and moves are
+ * detected via the kdtree's generation and cause a full refresh.
+ * @param vp Viewport about to be drawn.
+ * @return Up-to-date cache for the viewport.
+ */
+static const ViewportSignCache *UpdateViewportSignCache(const Viewport *vp)
+{
+	ViewportSignCache &cache = _viewport_sign_caches[vp];
+
+	Rect rect{ vp->virtual_left, vp->virtual_top, vp->virtual_left + vp->virtual_width, vp->virtual_top + vp->virtual_height };
+	rect = ExpandRectWithViewportSignMargins(rect, vp->zoom);
+
+	size_t generation = _viewport_sign_kdtree.Generation();
+	bool unchanged = cache.valid && cache.generation == generation && cache.zoom == vp->zoom;
+	if (unchanged && cache.rect.left == rect.left && cache.rect.top == rect.top && cache.rect.right == rect.right && cache.rect.bottom == rect.bottom) {
+		return &cache;
+	}
+
+	Rect old_rect = cache.rect;
+	bool overlap = unchanged && rect.left < old_rect.right && old_rect.left < rect.right && rect.top < old_rect.bottom && old_rect.top < rect.bottom;
+	if (overlap) {
+		/* Drop the items that scrolled out of view ... */
+		cache.items.erase(std::remove_if(cache.items.begin(), cache.items.end(), [&](const ViewportSignKdtreeItem &item) {
+			return item.center < rect.left || item.center >= rect.right || item.top < rect.top || item.top >= rect.bottom;
+		}), cache.items.end());
+
+		/* ... and query only the newly exposed bands. The four bands are
+		 * disjoint, so no item can be collected twice. */
+		AddSignsInBand(cache.items, rect.left, rect.top, std::min(old_rect.left, rect.right), rect.bottom);
+		AddSignsInBand(cache.items, std::max(old_rect.right, rect.left), rect.top, rect.right, rect.bottom);
+		int mid_left = std::max(rect.left, old_rect.left);
+		int mid_right = std::min(rect.right, old_rect.right);
+		AddSignsInBand(cache.items, mid_left, rect.top, mid_right, std::min(old_rect.top, rect.bottom));
+		AddSignsInBand(cache.items, mid_left, std::max(old_rect.bottom, rect.top), mid_right, rect.bottom);
+	} else {
+		cache.items.clear();
+		AddSignsInBand(cache.items, rect.left, rect.top, rect.right, rect.bottom);
+	}
+
+	cache.rect = rect;
+	cache.zoom = vp->zoom;
+	cache.generation = generation;
+	cache.valid = true;
+	return &cache;
+}
+
 static void ViewportAddKdtreeSigns(DrawPixelInfo *dpi)
 {
 	Rect search_rect{ dpi->left, dpi->top, dpi->left + dpi->width, dpi->top + dpi->height };
@@ -1361,7 +1460,7 @@ static void ViewportAddKdtreeSigns(DrawPixelInfo *dpi)
 	std::vector<const Town *> towns;
 	std::vector<const Sign *> signs;
 
-	_viewport_sign_kdtree.FindContained(search_rect.left, search_rect.top, search_rect.right, search_rect.bottom, [&](const ViewportSignKdtreeItem & item) {
+	auto add_item = [&](const ViewportSignKdtreeItem & item) {
 		switch (item.type) {
 			case ViewportSignKdtreeItem::VKI_STATION: {
 				if (!show_stations) break;
@@ -1406,7 +1505,19 @@ static void ViewportAddKdtreeSigns(DrawPixelInfo *dpi)
 			default:
 				NOT_REACHED();
 		}
-	});
+	};
+
+	if (_viewport_sign_cache_cur != nullptr) {
+		/* Filter the viewport's cached visible signs instead of querying the kdtree. */
+		for (const ViewportSignKdtreeItem &item : _viewport_sign_cache_cur->items) {
+			if (item.center >= search_rect.left && item.center < search_rect.right &&
+					item.top >= search_rect.top && item.top < search_rect.bottom) {
+				add_item(item);
+			}
+		}
+	} else {
+		_viewport_sign_kdtree.FindContained(search_rect.left, search_rect.top, search_rect.right, search_rect.bottom, add_item);
+	}
 
 	/* Layering order (bottom to top): Town names, signs, stations */
 
@@ -1725,71 +1836,168 @@ static void ViewportDrawStrings(ZoomLevel zoom, const StringSpriteToDrawVector *
 	}
 }
 
+/** Minimum width in pixels of a column strip that is collected by its own thread. */
+static const int MIN_VIEWPORT_STRIP_WIDTH = 160;
+
+/**
+ * Whether viewport sprite collection currently runs on multiple threads.
+ * Only set and cleared by the drawing thread while no collection thread is
+ * running, so a plain bool is sufficient. Code on the collection path that
+ * would write to shared state, like memoisation of resolved vehicle sprites,
+ * checks this to stay read-only while the collection threads are active.
+ */
+bool _viewport_collecting_concurrently = false;
+
+/**
+ * Collect all sprites to draw for one column strip of a viewport area.
+ * Runs on a worker thread for all but the first strip, so it must not touch
+ * anything but the given drawer, thread-local state and read-only game state.
+ * @param vd Drawer, with an initialised dpi, to collect the sprites into.
+ */
+static void ViewportCollectStrip(ViewportDrawer *vd)
+{
+	_vd = vd;
+	AutoRestoreBackup dpi_backup(_cur_dpi, &vd->dpi);
+
+	ViewportAddLandscape();
+	ViewportAddVehicles(&vd->dpi);
+
+	ViewportAddKdtreeSigns(&vd->dpi);
+
+	DrawTextEffects(&vd->dpi);
+}
+
 void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom)
 {
-	_vd.dpi.zoom = vp->zoom;
 	int mask = ScaleByZoom(-1, vp->zoom);
 
-	_vd.combine_sprites = SPRITE_COMBINE_NONE;
+	int draw_left = left & mask;
+	int draw_top = top & mask;
+	int draw_width = (right - left) & mask;
+	int draw_height = (bottom - top) & mask;
+
+	/* Split the area into column strips, collected concurrently. Each strip
+	 * is equivalent to an independently drawn dirty rectangle: it contains
+	 * every sprite overlapping it and the blitter clips at its borders, so
+	 * the result is the same as drawing the strips one by one. */
+	uint strips = 1;
+	uint max_threads = std::thread::hardware_concurrency();
+	if (max_threads > 1) {
+		strips = Clamp(UnScaleByZoom(draw_width, vp->zoom) / MIN_VIEWPORT_STRIP_WIDTH, 1, max_threads);
+	}
+
+	/* Keep the drawers around to reuse the allocations of their sprite lists. */
+	static std::vector<ViewportDrawer> drawers;
+	if (drawers.size() < strips) drawers.resize(strips);
+
+	/* Refresh the visible-sign cache once; the strips then only filter it. */
+	_viewport_sign_cache_cur = UpdateViewportSignCache(vp);
+
+	for (uint i = 0; i < strips; i++) {
+		ViewportDrawer &vd = drawers[i];
+		int strip_left = (draw_left + draw_width * i / strips) & mask;
+		int strip_right = (i + 1 == strips) ? draw_left + draw_width : (draw_left + draw_width * (i + 1) / strips) & mask;
+
+		vd.dpi.zoom = vp->zoom;
+		vd.dpi.left = strip_left;
+		vd.dpi.top = draw_top;
+		vd.dpi.width = strip_right - strip_left;
+		vd.dpi.height = draw_height;
+		vd.dpi.pitch = _cur_dpi->pitch;
+		vd.combine_sprites = SPRITE_COMBINE_NONE;
+		vd.last_child = nullptr;
+
+		int x = UnScaleByZoom(vd.dpi.left - (vp->virtual_left & mask), vp->zoom) + vp->left;
+		int y = UnScaleByZoom(vd.dpi.top - (vp->virtual_top & mask), vp->zoom) + vp->top;
+		vd.dpi.dst_ptr = BlitterFactory::GetCurrentBlitter()->MoveTo(_cur_dpi->dst_ptr, x - _cur_dpi->left, y - _cur_dpi->top);
+	}
+
+	if (strips > 1) {
+		/* Revalidating a vehicle sprite writes to the vehicle, which the worker
+		 * threads must not do; bring the caches of all vehicles in the whole
+		 * area up to date before the collection threads are started. */
+		DrawPixelInfo veh_dpi;
+		veh_dpi.left = draw_left;
+		veh_dpi.top = draw_top;
+		veh_dpi.width = draw_width;
+		veh_dpi.height = draw_height;
+		ViewportRevalidateVehicleSprites(&veh_dpi);
+
+		_viewport_collecting_concurrently = true;
+
+		std::vector<std::thread> threads(strips - 1);
+		uint started = 0;
+		for (uint i = 1; i < strips; i++) {
+			auto collect = [vd = &drawers[i]]() { ViewportCollectStrip(vd); };
+			if (!StartNewThread(&threads[started], "ottd:viewport", decltype(collect)(collect))) break;
+			started++;
+		}
 
-	_vd.dpi.width = (right - left) & mask;
-	_vd.dpi.height = (bottom - top) & mask;
-	_vd.dpi.left = left & mask;
-	_vd.dpi.top = top & mask;
-	_vd.dpi.pitch = _cur_dpi->pitch;
-	_vd.last_child = nullptr;
+		ViewportCollectStrip(&drawers[0]);
 
-	int x = UnScaleByZoom(_vd.dpi.left - (vp->virtual_left & mask), vp->zoom) + vp->left;
-	int y = UnScaleByZoom(_vd.dpi.top - (vp->virtual_top & mask), vp->zoom) + vp->top;
+		/* Collect the strips the workers didn't take on this thread. */
+		for (uint i = started + 1; i < strips; i++) ViewportCollectStrip(&drawers[i]);
+		for (uint i = 0; i < started; i++) threads[i].join();
 
-	_vd.dpi.dst_ptr = BlitterFactory::GetCurrentBlitter()->MoveTo(_cur_dpi->dst_ptr, x - _cur_dpi->left, y - _cur_dpi->top);
-	AutoRestoreBackup dpi_backup(_cur_dpi, &_vd.dpi);
+		_viewport_collecting_concurrently = false;
+	} else {
+		ViewportCollectStrip(&drawers[0]);
+	}
 
-	ViewportAddLandscape();
-	ViewportAddVehicles(&_vd.dpi);
+	_viewport_sign_cache_cur = nullptr;
 
-	ViewportAddKdtreeSigns(&_vd.dpi);
+	for (uint i = 0; i < strips; i++) {
+		ViewportDrawer *vd = &drawers[i];
+		_vd = vd;
+		AutoRestoreBackup dpi_backup(_cur_dpi, &vd->dpi);
 
-	DrawTextEffects(&_vd.dpi);
+		int x = UnScaleByZoom(vd->dpi.left - (vp->virtual_left & mask), vp->zoom) + vp->left;
+		int y = UnScaleByZoom(vd->dpi.top - (vp->virtual_top & mask), vp->zoom) + vp->top;
 
-	if (_vd.tile_sprites_to_draw.size() != 0) ViewportDrawTileSprites(&_vd.tile_sprites_to_draw);
+		/* Hand runs of sprites drawn in the same blitter mode to the blitter at once. */
+		GfxStartSpriteBatch();
 
-	for (auto &psd : _vd.parent_sprites_to_draw) {
-		_vd.parent_sprites_to_sort.push_back(&psd);
-	}
+		if (vd->tile_sprites_to_draw.size() != 0) ViewportDrawTileSprites(&vd->tile_sprites_to_draw);
 
-	_vp_sprite_sorter(&_vd.parent_sprites_to_sort);
-	ViewportDrawParentSprites(&_vd.parent_sprites_to_sort, &_vd.child_screen_sprites_to_draw);
+		for (auto &psd : vd->parent_sprites_to_draw) {
+			vd->parent_sprites_to_sort.push_back(&psd);
+		}
 
-	if (_draw_bounding_boxes) ViewportDrawBoundingBoxes(&_vd.parent_sprites_to_sort);
-	if (_draw_dirty_blocks) ViewportDrawDirtyBlocks();
+		_vp_sprite_sorter(&vd->parent_sprites_to_sort);
+		ViewportDrawParentSprites(&vd->parent_sprites_to_sort, &vd->child_screen_sprites_to_draw);
 
-	DrawPixelInfo dp = _vd.dpi;
-	ZoomLevel zoom = _vd.dpi.zoom;
-	dp.zoom = ZOOM_LVL_NORMAL;
-	dp.width = UnScaleByZoom(dp.width, zoom);
-	dp.height = UnScaleByZoom(dp.height, zoom);
-	_cur_dpi = &dp;
+		GfxEndSpriteBatch();
 
-	if (vp->overlay != nullptr && vp->overlay->GetCargoMask() != 0 && vp->overlay->GetCompanyMask() != 0) {
-		/* translate to window coordinates */
-		dp.left = x;
-		dp.top = y;
-		vp->overlay->Draw(&dp);
-	}
+		if (_draw_bounding_boxes) ViewportDrawBoundingBoxes(&vd->parent_sprites_to_sort);
+		if (_draw_dirty_blocks) ViewportDrawDirtyBlocks();
 
-	if (_vd.string_sprites_to_draw.size() != 0) {
-		/* translate to world coordinates */
-		dp.left = UnScaleByZoom(_vd.dpi.left, zoom);
-		dp.top = UnScaleByZoom(_vd.dpi.top, zoom);
-		ViewportDrawStrings(zoom, &_vd.string_sprites_to_draw);
-	}
+		DrawPixelInfo dp = vd->dpi;
+		ZoomLevel zoom = vd->dpi.zoom;
+		dp.zoom = ZOOM_LVL_NORMAL;
+		dp.width = UnScaleByZoom(dp.width, zoom);
+		dp.height = UnScaleByZoom(dp.height, zoom);
+		_cur_dpi = &dp;
+
+		if (vp->overlay != nullptr && vp->overlay->GetCargoMask() != 0 && vp->overlay->GetCompanyMask() != 0) {
+			/* translate to window coordinates */
+			dp.left = x;
+			dp.top = y;
+			vp->overlay->Draw(&dp);
+		}
+
+		if (vd->string_sprites_to_draw.size() != 0) {
+			/* translate to world coordinates */
+			dp.left = UnScaleByZoom(vd->dpi.left, zoom);
+			dp.top = UnScaleByZoom(vd->dpi.top, zoom);
+			ViewportDrawStrings(zoom, &vd->string_sprites_to_draw);
+		}
 
-	_vd.string_sprites_to_draw.clear();
-	_vd.tile_sprites_to_draw.clear();
-	_vd.parent_sprites_to_draw.clear();
-	_vd.parent_sprites_to_sort.clear();
-	_vd.child_screen_sprites_to_draw.clear();
+		vd->string_sprites_to_draw.clear();
+		vd->tile_sprites_to_draw.clear();
+		vd->parent_sprites_to_draw.clear();
+		vd->parent_sprites_to_sort.clear();
+		vd->child_screen_sprites_to_draw.clear();
+	}
 }
 
 static inline void ViewportDraw(const Viewport *vp, int left, int top, int right, int bottom)
@@ -1970,6 +2178,93 @@ bool MarkAllViewportsDirty(int left, int top, int right, int bottom)
 	return dirty;
 }
 
+/** Virtual rectangles of the active viewports, captured at the start of a vehicle dirty batch. */
+static std::vector<Rect> _vehicle_dirty_viewport_rects;
+/** Dirty rectangles collected during a vehicle dirty batch, waiting to be flushed. */
+static std::vector<Rect> _pending_vehicle_dirty_rects;
+/** Whether vehicle dirty marking is currently being batched. */
+static bool _vehicle_dirty_batching = false;
+
+/**
+ * Start batching the dirty rectangles of moving vehicles.
+ * Until the matching #FlushVehicleViewportDirtyBatch, calls to
+ * #MarkVehicleViewportDirty collect their rectangles instead of walking all
+ * windows, so consecutive vehicles (e.g. the wagons of a train) coalesce
+ * into a few dirty blocks and off-screen movement is culled early.
+ */
+void BeginVehicleViewportDirtyBatch()
+{
+	assert(!_vehicle_dirty_batching);
+	_vehicle_dirty_batching = true;
+
+	for (const Window *w : Window::Iterate()) {
+		const Viewport *vp = w->viewport;
+		if (vp == nullptr) continue;
+		/* Pre-grow by the zoom rounding margin of MarkViewportDirty, so the
+		 * batched visibility test rejects exactly what that function would. */
+		int margin = (1 << vp->zoom) - 1;
+		_vehicle_dirty_viewport_rects.push_back({
+			vp->virtual_left - margin,
+			vp->virtual_top - margin,
+			vp->virtual_left + vp->virtual_width,
+			vp->virtual_top + vp->virtual_height
+		});
+	}
+}
+
+/** Flush a batch started with #BeginVehicleViewportDirtyBatch to the viewports. */
+void FlushVehicleViewportDirtyBatch()
+{
+	assert(_vehicle_dirty_batching);
+	_vehicle_dirty_batching = false;
+
+	for (const Rect &r : _pending_vehicle_dirty_rects) {
+		MarkAllViewportsDirty(r.left, r.top, r.right, r.bottom);
+	}
+	_pending_vehicle_dirty_rects.clear();
+	_vehicle_dirty_viewport_rects.clear();
+}
+
+/**
+ * Mark the area covered by a vehicle as dirty, batched when inside a
+ * #BeginVehicleViewportDirtyBatch / #FlushVehicleViewportDirtyBatch pair.
+ * @param left   Left   edge of area to repaint. (viewport coordinates, that is wrt. #ZOOM_LVL_NORMAL)
+ * @param top    Top    edge of area to repaint. (viewport coordinates, that is wrt. #ZOOM_LVL_NORMAL)
+ * @param right  Right  edge of area to repaint. (viewport coordinates, that is wrt. #ZOOM_LVL_NORMAL)
+ * @param bottom Bottom edge of area to repaint. (viewport coordinates, that is wrt. #ZOOM_LVL_NORMAL)
+ * @return true if the area is visible in at least one viewport
+ * @ingroup dirty
+ */
+bool MarkVehicleViewportDirty(int left, int top, int right, int bottom)
+{
+	if (!_vehicle_dirty_batching) return MarkAllViewportsDirty(left, top, right, bottom);
+
+	bool visible = false;
+	for (const Rect &r : _vehicle_dirty_viewport_rects) {
+		if (right > r.left && left < r.right && bottom > r.top && top < r.bottom) {
+			visible = true;
+			break;
+		}
+	}
+	if (!visible) return false;
+
+	/* Vehicles are ticked in chains; the area of the previous vehicle usually
+	 * touches ours, so merging with just the last pending rectangle already
+	 * coalesces most of a train into a single dirty block. */
+	if (!_pending_vehicle_dirty_rects.empty()) {
+		Rect &last = _pending_vehicle_dirty_rects.back();
+		if (right >= last.left && left <= last.right && bottom >= last.top && top <= last.bottom) {
+			last.left = std::min(last.left, left);
+			last.top = std::min(last.top, top);
+			last.right = std::max(last.right, right);
+			last.bottom = std::max(last.bottom, bottom);
+			return true;
+		}
+	}
+	_pending_vehicle_dirty_rects.push_back({left, top, right, bottom});
+	return true;
+}
+
 void ConstrainAllViewportsZoom()
 {
 	for (Window *w : Window::Iterate()) {
@@ -1992,6 +2287,10 @@ void ConstrainAllViewportsZoom()
  */
 void MarkTileDirtyByTile(TileIndex tile, int bridge_level_offset, int tile_height_override)
 {
+	NotifySmallMapTileChange(tile);
+	NotifyRailCatenaryTileChange(tile);
+	NotifyBridgeTileChange(tile);
+
 	Point pt = RemapCoords(TileX(tile) * TILE_SIZE, TileY(tile) * TILE_SIZE, tile_height_override * TILE_HEIGHT);
 	MarkAllViewportsDirty(
 			pt.x - MAX_TILE_EXTENT_LEFT,
@@ -2388,7 +2687,8 @@ void RebuildViewportOverlay(Window *w)
 	if (w->viewport->overlay != nullptr &&
 			w->viewport->overlay->GetCompanyMask() != 0 &&
 			w->viewport->overlay->GetCargoMask() != 0) {
-		w->viewport->overlay->SetDirty();
+		/* The overlay cache is not bound to the visible area, so scrolling
+		 * only requires a repaint with the new clipping area. */
 		w->SetDirty();
 	}
 }
@@ -28,6 +28,9 @@ Point GetTileBelowCursor();
 void UpdateViewportPosition(Window *w);
 
 bool MarkAllViewportsDirty(int left, int top, int right, int bottom);
+void BeginVehicleViewportDirtyBatch();
+void FlushVehicleViewportDirtyBatch();
+bool MarkVehicleViewportDirty(int left, int top, int right, int bottom);
 
 bool DoZoomInOutWindow(ZoomStateChange how, Window *w);
 void ZoomInOrOutToCursorWindow(bool in, Window * w);
@@ -65,6 +68,7 @@ void SetTileSelectSize(int w, int h);
 void SetTileSelectBigSize(int ox, int oy, int sx, int sy);
 
 void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom);
+extern bool _viewport_collecting_concurrently;
 
 bool ScrollWindowToTile(TileIndex tile, Window *w, bool instant = false);
 bool ScrollWindowTo(int x, int y, int z, Window *w, bool instant = false);
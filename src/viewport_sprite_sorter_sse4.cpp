@@ -13,9 +13,8 @@
 #include "cpu.h"
 #include "smmintrin.h"
 #include "viewport_sprite_sorter.h"
-#include <forward_list>
-#include <map>
 #include <stack>
+#include <vector>
 
 #include "safeguards.h"
 
@@ -45,19 +44,30 @@ void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv)
 	std::stack<ParentSpriteToDraw *> sprite_order;
 	uint32 next_order = 0;
 
-	std::forward_list<std::pair<int64, ParentSpriteToDraw *>> sprite_list;  // We store sprites in a list sorted by xmin+ymin
+	/* Sprites that still await comparison are binned into a spatial grid over
+	 * their xmin+ymin sum. Candidate scans then only touch the buckets whose
+	 * key range can contain a preceding sprite, and each bucket is a flat
+	 * array so the scan is cache friendly. */
+	const int BUCKET_SHIFT = 8; ///< Each bucket covers 256 world units of xmin+ymin.
+	int64 min_key = INT64_MAX;
+	int64 max_key = INT64_MIN;
+	for (auto p : *psdv) {
+		int64 key = p->xmin + p->ymin;
+		min_key = std::min(min_key, key);
+		max_key = std::max(max_key, key);
+	}
+	std::vector<std::vector<ParentSpriteToDraw *>> buckets(((max_key - min_key) >> BUCKET_SHIFT) + 1);
 
-	/* Initialize sprite list and order. */
+	/* Initialize sprite grid and order. */
 	for (auto p = psdv->rbegin(); p != psdv->rend(); p++) {
-		sprite_list.push_front(std::make_pair((*p)->xmin + (*p)->ymin, *p));
+		buckets[((*p)->xmin + (*p)->ymin - min_key) >> BUCKET_SHIFT].push_back(*p);
 		sprite_order.push(*p);
 		(*p)->order = next_order++;
 	}
 
-	sprite_list.sort();
+	size_t first_bucket = 0; ///< Lowest bucket that may still contain unsorted sprites.
 
-	std::vector<ParentSpriteToDraw *> preceding;  // Temporarily stores sprites that precede current and their position in the list
-	auto preceding_prev = sprite_list.begin(); // Store iterator in case we need to delete a single preciding sprite
+	std::vector<ParentSpriteToDraw *> preceding;  // Temporarily stores sprites that precede current
 	auto out = psdv->begin();  // Iterator to output sorted sprites
 
 	while (!sprite_order.empty()) {
@@ -82,51 +92,69 @@ void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv)
 		 * we get all we need and some more that we filter out later.
 		 * We don't include zmin into the sum as there are usually more neighbors on x and y than z
 		 * so including it will actually increase the amount of false positives.
-		 * Also min coordinates can be > max so using max(xmin, xmax) + max(ymin, ymax)
-		 * to ensure that we iterate the current sprite as we need to remove it from the list.
+		 * Min coordinates can be > max so use max(xmin, xmax) + max(ymin, ymax)
+		 * to make sure the candidate window covers the current sprite's own bucket.
 		 */
 		auto ssum = std::max(s->xmax, s->xmin) + std::max(s->ymax, s->ymin);
-		auto prev = sprite_list.before_begin();
-		auto x = sprite_list.begin();
-		while (x != sprite_list.end() && ((*x).first <= ssum)) {
-			auto p = (*x).second;
-			if (p == s) {
-				/* We found the current sprite, remove it and move on. */
-				x = sprite_list.erase_after(prev);
-				continue;
+
+		/* Remove the current sprite from its bucket; it must not show up as a candidate again. */
+		{
+			auto &b = buckets[(s->xmin + s->ymin - min_key) >> BUCKET_SHIFT];
+			for (size_t i = 0; i < b.size(); i++) {
+				if (b[i] == s) {
+					b[i] = b.back();
+					b.pop_back();
+					break;
+				}
 			}
+		}
 
-			auto p_prev = prev;
-			prev = x++;
+		while (first_bucket < buckets.size() && buckets[first_bucket].empty()) first_bucket++;
 
-			/* Check that p->xmin <= s->xmax && p->ymin <= s->ymax && p->zmin <= s->zmax */
-			__m128i s_max = LOAD_128((__m128i*) &s->xmax);
-			__m128i p_min = LOAD_128((__m128i*) &p->xmin);
-			__m128i r1 = _mm_cmplt_epi32(s_max, p_min);
-			if (!_mm_testz_si128(mask_ptest, r1))
-				continue;
+		size_t last_bucket = std::min<size_t>(buckets.size() - 1, static_cast<size_t>(std::max<int64>(0, (ssum - min_key) >> BUCKET_SHIFT)));
+		for (size_t bi = first_bucket; bi <= last_bucket; bi++) {
+			auto &b = buckets[bi];
+			for (size_t i = 0; i < b.size();) {
+				auto p = b[i];
 
-			/* Check if sprites overlap, i.e.
-			 * s->xmin <= p->xmax && s->ymin <= p->ymax && s->zmin <= p->zmax
-			 */
-			__m128i s_min = LOAD_128((__m128i*) &s->xmin);
-			__m128i p_max = LOAD_128((__m128i*) &p->xmax);
-			__m128i r2 = _mm_cmplt_epi32(p_max, s_min);
-			if (_mm_testz_si128(mask_ptest, r2)) {
-				/* Use X+Y+Z as the sorting order, so sprites closer to the bottom of
-				 * the screen and with higher Z elevation, are drawn in front.
-				 * Here X,Y,Z are the coordinates of the "center of mass" of the sprite,
-				 * i.e. X=(left+right)/2, etc.
-				 * However, since we only care about order, don't actually divide / 2
-				 */
-				if (s->xmin + s->xmax + s->ymin + s->ymax + s->zmin + s->zmax <=
-						p->xmin + p->xmax + p->ymin + p->ymax + p->zmin + p->zmax) {
+				/* Sprites sorted via the single-preceding-sprite shortcut are removed lazily. */
+				if (p->order == ORDER_RETURNED) {
+					b[i] = b.back();
+					b.pop_back();
 					continue;
 				}
-			}
 
-			preceding.push_back(p);
-			preceding_prev = p_prev;
+				i++;
+				if (p->xmin + p->ymin > ssum) continue;
+
+				/* Check that p->xmin <= s->xmax && p->ymin <= s->ymax && p->zmin <= s->zmax */
+				__m128i s_max = LOAD_128((__m128i*) &s->xmax);
+				__m128i p_min = LOAD_128((__m128i*) &p->xmin);
+				__m128i r1 = _mm_cmplt_epi32(s_max, p_min);
+				if (!_mm_testz_si128(mask_ptest, r1))
+					continue;
+
+				/* Check if sprites overlap, i.e.
+				 * s->xmin <= p->xmax && s->ymin <= p->ymax && s->zmin <= p->zmax
+				 */
+				__m128i s_min = LOAD_128((__m128i*) &s->xmin);
+				__m128i p_max = LOAD_128((__m128i*) &p->xmax);
+				__m128i r2 = _mm_cmplt_epi32(p_max, s_min);
+				if (_mm_testz_si128(mask_ptest, r2)) {
+					/* Use X+Y+Z as the sorting order, so sprites closer to the bottom of
+					 * the screen and with higher Z elevation, are drawn in front.
+					 * Here X,Y,Z are the coordinates of the "center of mass" of the sprite,
+					 * i.e. X=(left+right)/2, etc.
+					 * However, since we only care about order, don't actually divide / 2
+					 */
+					if (s->xmin + s->xmax + s->ymin + s->ymax + s->zmin + s->zmax <=
+							p->xmin + p->xmax + p->ymin + p->ymax + p->zmin + p->zmax) {
+						continue;
+					}
+				}
+
+				preceding.push_back(p);
+			}
 		}
 
 		if (preceding.empty()) {
@@ -141,9 +169,9 @@ void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv)
 			auto p = preceding[0];
 			/* We can only output the preceding sprite if there can't be any other sprites preceding it. */
 			if (p->xmax <= s->xmax && p->ymax <= s->ymax && p->zmax <= s->zmax) {
+				/* p stays in its bucket for now; it is removed lazily during a later scan. */
 				p->order = ORDER_RETURNED;
 				s->order = ORDER_RETURNED;
-				sprite_list.erase_after(preceding_prev);
 				*(out++) = p;
 				*(out++) = s;
 				continue;
@@ -172,7 +200,7 @@ void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv)
  */
 bool ViewportSortParentSpritesSSE41Checker()
 {
-	return HasCPUIDFlag(1, 2, 19);
+	return HasCPUFeature(CPUF_SSE41);
 }
 
 #endif /* WITH_SSE */
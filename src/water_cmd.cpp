@@ -37,6 +37,7 @@
 #include "company_gui.h"
 #include "newgrf_generic.h"
 #include "industry.h"
+#include "pathfinder/water_regions.h"
 #include "water_cmd.h"
 #include "landscape_cmd.h"
 
@@ -135,6 +136,7 @@ CommandCost CmdBuildShipDepot(DoCommandFlag flags, TileIndex tile, Axis axis)
 	if (flags & DC_EXEC) {
 		Depot *depot = new Depot(tile);
 		depot->build_date = _date;
+		InvalidateDepotKdtrees();
 
 		uint new_water_infra = 2 * LOCK_DEPOT_TILE_FACTOR;
 		/* Update infrastructure counts after the tile clears earlier.
@@ -148,6 +150,8 @@ CommandCost CmdBuildShipDepot(DoCommandFlag flags, TileIndex tile, Axis axis)
 
 		MakeShipDepot(tile,  _current_company, depot->index, DEPOT_PART_NORTH, axis, wc1);
 		MakeShipDepot(tile2, _current_company, depot->index, DEPOT_PART_SOUTH, axis, wc2);
+		InvalidateWaterRegion(tile);
+		InvalidateWaterRegion(tile2);
 		CheckForDockingTile(tile);
 		CheckForDockingTile(tile2);
 		MarkTileDirtyByTile(tile);
@@ -252,6 +256,7 @@ void MakeWaterKeepingClass(TileIndex tile, Owner o)
 		default: break;
 	}
 
+	InvalidateWaterRegion(tile);
 	if (wc != WATER_CLASS_INVALID) CheckForDockingTile(tile);
 	MarkTileDirtyByTile(tile);
 }
@@ -352,6 +357,9 @@ static CommandCost DoBuildLock(TileIndex tile, DiagDirection dir, DoCommandFlag
 		}
 
 		MakeLock(tile, _current_company, dir, wc_lower, wc_upper, wc_middle);
+		InvalidateWaterRegion(tile);
+		InvalidateWaterRegion(tile - delta);
+		InvalidateWaterRegion(tile + delta);
 		CheckForDockingTile(tile - delta);
 		CheckForDockingTile(tile + delta);
 		MarkTileDirtyByTile(tile);
@@ -399,6 +407,7 @@ static CommandCost RemoveLock(TileIndex tile, DoCommandFlag flags)
 		} else {
 			DoClearSquare(tile);
 		}
+		InvalidateWaterRegion(tile);
 		MakeWaterKeepingClass(tile + delta, GetTileOwner(tile + delta));
 		MakeWaterKeepingClass(tile - delta, GetTileOwner(tile - delta));
 		MarkCanalsAndRiversAroundDirty(tile);
@@ -508,6 +517,7 @@ CommandCost CmdBuildCanal(DoCommandFlag flags, TileIndex tile, TileIndex start_t
 					MakeCanal(current_tile, _current_company, Random());
 					break;
 			}
+			InvalidateWaterRegion(current_tile);
 			MarkTileDirtyByTile(current_tile);
 			MarkCanalsAndRiversAroundDirty(current_tile);
 			CheckForDockingTile(current_tile);
@@ -552,6 +562,7 @@ static CommandCost ClearTile_Water(TileIndex tile, DoCommandFlag flags)
 					DirtyCompanyInfrastructureWindows(owner);
 				}
 				DoClearSquare(tile);
+				InvalidateWaterRegion(tile);
 				MarkCanalsAndRiversAroundDirty(tile);
 			}
 
@@ -567,6 +578,7 @@ static CommandCost ClearTile_Water(TileIndex tile, DoCommandFlag flags)
 
 			if (flags & DC_EXEC) {
 				DoClearSquare(tile);
+				InvalidateWaterRegion(tile);
 				MarkCanalsAndRiversAroundDirty(tile);
 			}
 			if (IsSlopeWithOneCornerRaised(slope)) {
@@ -1155,6 +1167,9 @@ void DoFloodTile(TileIndex target)
 	}
 
 	if (flooded) {
+		InvalidateWaterRegion(target);
+		ClearNeighbourNonFloodingStates(target);
+
 		/* Mark surrounding canal tiles dirty too to avoid glitches */
 		MarkCanalsAndRiversAroundDirty(target);
 
@@ -1208,9 +1223,25 @@ static void DoDryUp(TileIndex tile)
 		default: NOT_REACHED();
 	}
 
+	InvalidateWaterRegion(tile);
+	ClearNeighbourNonFloodingStates(tile);
+
 	cur_company.Restore();
 }
 
+/**
+ * Clears the non-flooding state of the tiles around a tile, so the flooding
+ * checks are performed again after the terrain changed.
+ * @param tile Tile around which the non-flooding state is cleared.
+ */
+void ClearNeighbourNonFloodingStates(TileIndex tile)
+{
+	for (Direction dir = DIR_BEGIN; dir < DIR_END; dir++) {
+		TileIndex dest = tile + TileOffsByDir(dir);
+		if (IsValidTile(dest) && IsTileType(dest, MP_WATER)) SetNonFloodingWaterTile(dest, false);
+	}
+}
+
 /**
  * Let a water tile floods its diagonal adjoining tiles
  * called from tunnelbridge_cmd, and by TileLoop_Industry() and TileLoop_Track()
@@ -1219,10 +1250,17 @@ static void DoDryUp(TileIndex tile)
  */
 void TileLoop_Water(TileIndex tile)
 {
-	if (IsTileType(tile, MP_WATER)) AmbientSoundEffect(tile);
+	if (IsTileType(tile, MP_WATER)) {
+		AmbientSoundEffect(tile);
+
+		/* A previous scan marked this tile; nothing to flood until the
+		 * terrain around it changes. */
+		if (IsNonFloodingWaterTile(tile)) return;
+	}
 
 	switch (GetFloodingBehaviour(tile)) {
-		case FLOOD_ACTIVE:
+		case FLOOD_ACTIVE: {
+			bool continue_flooding = false;
 			for (Direction dir = DIR_BEGIN; dir < DIR_END; dir++) {
 				TileIndex dest = tile + TileOffsByDir(dir);
 				if (!IsValidTile(dest)) continue;
@@ -1232,6 +1270,10 @@ void TileLoop_Water(TileIndex tile)
 				/* TREE_GROUND_SHORE is the sign of a previous flood. */
 				if (IsTileType(dest, MP_TREES) && GetTreeGround(dest) == TREE_GROUND_SHORE) continue;
 
+				/* This neighbour might become floodable when the terrain
+				 * changes, so keep checking the tile. */
+				continue_flooding = true;
+
 				int z_dest;
 				Slope slope_dest = GetFoundationSlope(dest, &z_dest) & ~SLOPE_HALFTILE_MASK & ~SLOPE_STEEP;
 				if (z_dest > 0) continue;
@@ -1240,7 +1282,9 @@ void TileLoop_Water(TileIndex tile)
 
 				DoFloodTile(dest);
 			}
+			if (!continue_flooding && IsTileType(tile, MP_WATER)) SetNonFloodingWaterTile(tile, true);
 			break;
+		}
 
 		case FLOOD_DRYUP: {
 			Slope slope_here = GetFoundationSlope(tile) & ~SLOPE_HALFTILE_MASK & ~SLOPE_STEEP;
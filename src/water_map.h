@@ -378,6 +378,32 @@ static inline bool IsDockingTile(TileIndex t)
 	return (IsTileType(t, MP_WATER) || IsTileType(t, MP_RAILWAY) || IsTileType(t, MP_STATION) || IsTileType(t, MP_TUNNELBRIDGE)) && HasBit(_m[t].m1, 7);
 }
 
+/**
+ * Checks whether the tile is marked as a non-flooding water tile.
+ * The active flooding checks are skipped for these tiles, until the terrain
+ * around them changes; see TileLoop_Water().
+ * @param t the tile
+ * @return true iff the tile is marked as a non-flooding water tile.
+ * @pre IsTileType(t, MP_WATER)
+ */
+static inline bool IsNonFloodingWaterTile(TileIndex t)
+{
+	assert(IsTileType(t, MP_WATER));
+	return HasBit(_m[t].m3, 0);
+}
+
+/**
+ * Set the non-flooding water tile state of a tile.
+ * @param t the tile
+ * @param b the non-flooding water tile state
+ * @pre IsTileType(t, MP_WATER)
+ */
+static inline void SetNonFloodingWaterTile(TileIndex t, bool b)
+{
+	assert(IsTileType(t, MP_WATER));
+	SB(_m[t].m3, 0, 1, b ? 1 : 0);
+}
+
 
 /**
  * Helper function to make a coast tile.
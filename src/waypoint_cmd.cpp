@@ -21,6 +21,7 @@
 #include "window_func.h"
 #include "date_func.h"
 #include "vehicle_func.h"
+#include "order_func.h"
 #include "string_func.h"
 #include "company_func.h"
 #include "newgrf_station.h"
@@ -60,6 +61,9 @@ void Waypoint::MoveSign(TileIndex new_xy)
 	if (this->xy == new_xy) return;
 
 	this->BaseStation::MoveSign(new_xy);
+
+	/* Orders going to this waypoint resolve their destination to the sign tile. */
+	InvalidateOrderDestinationCache();
 }
 
 /**
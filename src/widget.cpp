@@ -1378,6 +1378,11 @@ void NWidgetStacked::Draw(const Window *w)
 {
 	if (this->shown_plane >= SZSP_BEGIN) return;
 
+	/* Skip the whole subtree when it is fully outside the area being repainted. */
+	Rect r = this->GetCurrentRect();
+	const DrawPixelInfo *dpi = _cur_dpi;
+	if (dpi->left > r.right || dpi->left + dpi->width <= r.left || dpi->top > r.bottom || dpi->top + dpi->height <= r.top) return;
+
 	int plane = 0;
 	for (NWidgetBase *child_wid = this->head; child_wid != nullptr; plane++, child_wid = child_wid->next) {
 		if (plane == this->shown_plane) {
@@ -1447,6 +1452,11 @@ void NWidgetPIPContainer::SetPIP(uint8 pip_pre, uint8 pip_inter, uint8 pip_post)
 
 void NWidgetPIPContainer::Draw(const Window *w)
 {
+	/* Skip the whole subtree when it is fully outside the area being repainted. */
+	Rect r = this->GetCurrentRect();
+	const DrawPixelInfo *dpi = _cur_dpi;
+	if (dpi->left > r.right || dpi->left + dpi->width <= r.left || dpi->top > r.bottom || dpi->top + dpi->height <= r.top) return;
+
 	for (NWidgetBase *child_wid = this->head; child_wid != nullptr; child_wid = child_wid->next) {
 		child_wid->Draw(w);
 	}
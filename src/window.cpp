@@ -3055,6 +3055,9 @@ void InputLoop()
 	/* Process scheduled window deletion. */
 	Window::DeleteClosedWindows();
 
+	/* On a dedicated server there is no user input to handle. */
+	if (_network_dedicated) return;
+
 	if (_input_events_this_tick != 0) {
 		/* The input loop is called only once per GameLoop() - so we can clear the counter here */
 		_input_events_this_tick = 0;
@@ -3088,6 +3091,19 @@ void UpdateWindows()
 
 	last_time = std::chrono::steady_clock::now();
 
+	if (_network_dedicated) {
+		/* Nothing is drawn on a dedicated server and no input arrives, so the
+		 * cursor, scrolling, chat and animation handling below is all dead
+		 * weight; especially in fast-forward it runs for every game tick.
+		 * Only the invalidations have to be processed, as their handlers may
+		 * have side effects the game state relies upon. */
+		for (Window *w : Window::Iterate()) {
+			w->ProcessScheduledInvalidations();
+			w->ProcessHighlightedInvalidations();
+		}
+		return;
+	}
+
 	PerformanceMeasurer framerate(PFE_DRAWING);
 	PerformanceAccumulator::Reset(PFE_DRAWWORLD);
 
@@ -3109,8 +3125,6 @@ void UpdateWindows()
 
 	static GUITimer window_timer = GUITimer(1);
 	if (window_timer.Elapsed(delta_ms)) {
-		if (_network_dedicated) window_timer.SetInterval(MILLISECONDS_PER_TICK);
-
 		extern int _caret_timer;
 		_caret_timer += 3;
 		CursorTick();
@@ -3128,10 +3142,6 @@ void UpdateWindows()
 
 	if (!_pause_mode || _game_mode == GM_EDITOR || _settings_game.construction.command_pause_level > CMDPL_NO_CONSTRUCTION) MoveAllTextEffects(delta_ms);
 
-	/* Skip the actual drawing on dedicated servers without screen.
-	 * But still empty the invalidation queues above. */
-	if (_network_dedicated) return;
-
 	if (window_timer.HasElapsed()) {
 		window_timer.SetInterval(MILLISECONDS_PER_TICK);
 
@@ -3199,11 +3209,19 @@ void SetWindowClassesDirty(WindowClass cls)
  */
 void Window::InvalidateData(int data, bool gui_scope)
 {
-	this->SetDirty();
 	if (!gui_scope) {
-		/* Schedule GUI-scope invalidation for next redraw. */
+		/* Schedule GUI-scope invalidation for next redraw. Multiple invalidations
+		 * with the same data before that redraw are collapsed into one; the
+		 * scheduled call only observes the game state at the time of execution,
+		 * so the duplicates would find nothing new. The command-scope call below
+		 * still happens for every invalidation. */
+		if (std::find(this->scheduled_invalidation_data.begin(), this->scheduled_invalidation_data.end(), data) != this->scheduled_invalidation_data.end()) {
+			this->OnInvalidateData(data, gui_scope);
+			return;
+		}
 		this->scheduled_invalidation_data.push_back(data);
 	}
+	this->SetDirty();
 	this->OnInvalidateData(data, gui_scope);
 }
 